@@ -1,7 +1,7 @@
 /******************************************************************************
  *
  * Project:  GDAL Utilities
- * Purpose:  bench_ogr_bach
+ * Purpose:  bench_ogr_batch
  * Author:   Even Rouault, <even dot rouault at spatialys.com>
  *
  ******************************************************************************
@@ -26,6 +26,7 @@
  * DEALINGS IN THE SOFTWARE.
  ****************************************************************************/
 
+#include "commonutils.h"
 #include "gdal_priv.h"
 #include "ogr_api.h"
 #include "ogrsf_frmts.h"
@@ -37,8 +38,12 @@
 
 static void Usage()
 {
-    printf("Usage: bench_ogr_bach [-where filter] [-spat xmin ymin xmax ymax]\n");
-    printf("                      filename [layer_name]\n");
+    printf("Usage: bench_ogr_batch [-where filter] [-spat xmin ymin xmax ymax]\n");
+    printf("                       [-o out_filename [-f format]]\n");
+    printf("                       filename [layer_name]\n");
+    printf("\n");
+    printf("When -o is specified, batches are written with WriteArrowBatch()\n");
+    printf("into a new layer of out_filename.\n");
     exit(1);
 }
 
@@ -59,6 +64,8 @@ int main(int argc, char* argv[])
     const char* pszDataset = nullptr;
     std::unique_ptr<OGRPolygon> poSpatialFilter;
     const char* pszLayerName = nullptr;
+    const char* pszOutFilename = nullptr;
+    const char* pszOutFormat = nullptr;
     for( int iArg = 1; iArg < argc; ++iArg )
     {
         if( iArg + 1 < argc && strcmp(argv[iArg], "-where") == 0 )
@@ -66,6 +73,16 @@ int main(int argc, char* argv[])
             pszWhere = argv[iArg+1];
             ++iArg;
         }
+        else if( iArg + 1 < argc && strcmp(argv[iArg], "-o") == 0 )
+        {
+            pszOutFilename = argv[iArg+1];
+            ++iArg;
+        }
+        else if( iArg + 1 < argc && strcmp(argv[iArg], "-f") == 0 )
+        {
+            pszOutFormat = argv[iArg+1];
+            ++iArg;
+        }
         else if( iArg + 4 < argc && strcmp(argv[iArg], "-spat") == 0 )
         {
             OGRLinearRing oRing;
@@ -136,22 +153,95 @@ int main(int argc, char* argv[])
     if( poSpatialFilter )
         poLayer->SetSpatialFilter(poSpatialFilter.get());
 
+    std::unique_ptr<GDALDataset> poOutDS;
+    OGRLayer* poOutLayer = nullptr;
+    CPLStringList aosStreamOptions;
+    CPLStringList aosWriteOptions;
+    if( pszOutFilename )
+    {
+        if( pszOutFormat == nullptr )
+        {
+            const auto aosDrivers =
+                GetOutputDriversFor(pszOutFilename, GDAL_OF_VECTOR);
+            if( aosDrivers.size() != 1 )
+            {
+                fprintf(stderr, "Cannot guess output driver. Use -f\n");
+                CSLDestroy(argv);
+                exit(1);
+            }
+            pszOutFormat = aosDrivers[0];
+        }
+        auto poDriver = GetGDALDriverManager()->GetDriverByName(pszOutFormat);
+        if( poDriver == nullptr )
+        {
+            fprintf(stderr, "Cannot find driver %s\n", pszOutFormat);
+            CSLDestroy(argv);
+            exit(1);
+        }
+        poOutDS.reset(poDriver->Create(pszOutFilename, 0, 0, 0, GDT_Unknown,
+                                       nullptr));
+        if( poOutDS == nullptr )
+        {
+            CSLDestroy(argv);
+            exit(1);
+        }
+
+        const auto poSrcFDefn = poLayer->GetLayerDefn();
+        const int nGeomFieldCount = poSrcFDefn->GetGeomFieldCount();
+        poOutLayer = poOutDS->CreateLayer(
+            poLayer->GetName(),
+            nGeomFieldCount ? poSrcFDefn->GetGeomFieldDefn(0)->GetSpatialRef() : nullptr,
+            nGeomFieldCount ? poSrcFDefn->GetGeomFieldDefn(0)->GetType() : wkbNone,
+            nullptr);
+        if( poOutLayer == nullptr )
+        {
+            CSLDestroy(argv);
+            exit(1);
+        }
+        for( int i = 0; i < poSrcFDefn->GetFieldCount(); ++i )
+        {
+            if( poOutLayer->CreateField(poSrcFDefn->GetFieldDefn(i)) != OGRERR_NONE )
+            {
+                CSLDestroy(argv);
+                exit(1);
+            }
+        }
+        for( int i = 1; i < nGeomFieldCount; ++i )
+        {
+            if( poOutLayer->CreateGeomField(poSrcFDefn->GetGeomFieldDefn(i)) != OGRERR_NONE )
+            {
+                CSLDestroy(argv);
+                exit(1);
+            }
+        }
+
+        aosStreamOptions.SetNameValue("INCLUDE_FID", "NO");
+        aosStreamOptions.SetNameValue("GEOMETRY_ENCODING", "WKB");
+        if( nGeomFieldCount == 1 )
+        {
+            const char* pszGeomName = poSrcFDefn->GetGeomFieldDefn(0)->GetNameRef();
+            aosWriteOptions.SetNameValue("GEOMETRY_NAME",
+                                         pszGeomName[0] ? pszGeomName : "wkb_geometry");
+        }
+    }
+
     OGRLayerH hLayer = OGRLayer::ToHandle(poLayer);
     struct ArrowArrayStream stream;
-    if( !OGR_L_GetArrowStream(hLayer, &stream, nullptr))
+    if( !OGR_L_GetArrowStream(hLayer, &stream, aosStreamOptions.List()))
     {
         CPLError(CE_Failure, CPLE_AppDefined, "OGR_L_GetArrowStream() failed\n");
         CSLDestroy(argv);
         exit(1);
     }
-#if 0
     struct ArrowSchema schema;
-    if( stream.get_schema(&stream, &schema) == 0 )
+    if( poOutLayer && stream.get_schema(&stream, &schema) != 0 )
     {
-        // Do something useful
-        schema.release(&schema);
+        CPLError(CE_Failure, CPLE_AppDefined, "get_schema() failed\n");
+        stream.release(&stream);
+        CSLDestroy(argv);
+        exit(1);
     }
-#endif
+    int nRet = 0;
     while( true )
     {
         struct ArrowArray array;
@@ -160,15 +250,29 @@ int main(int argc, char* argv[])
         {
             break;
         }
-        array.release(&array);
+        if( poOutLayer &&
+            !OGR_L_WriteArrowBatch(OGRLayer::ToHandle(poOutLayer), &schema,
+                                   &array, aosWriteOptions.List()) )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "OGR_L_WriteArrowBatch() failed\n");
+            nRet = 1;
+        }
+        if( array.release )
+            array.release(&array);
+        if( nRet != 0 )
+            break;
     }
+    if( poOutLayer )
+        schema.release(&schema);
     stream.release(&stream);
 
+    poOutDS.reset();
     poDS.reset();
 
     CSLDestroy(argv);
 
     GDALDestroyDriverManager();
 
-    return 0;
+    return nRet;
 }
@@ -50,19 +50,24 @@
 #include "commonutils.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
+#include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
 #include "gdal_priv.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
 #include "ogr_featurestyle.h"
 #include "ogr_geometry.h"
 #include "ogr_p.h"
+#include "ogr_recordbatch.h"
 #include "ogr_spatialref.h"
 #include "ogrlayerdecorator.h"
 #include "ogrsf_frmts.h"
@@ -367,6 +372,11 @@ struct GDALVectorTranslateOptions
 
     /*! Maximum number of features, or -1 if no limit. */
     GIntBig nLimit;
+
+    /*! Number of threads used to translate features (geometry operations and
+        reprojection). Features are still read and written by a single thread,
+        and in their original order. */
+    int nNumThreads;
 };
 
 struct TargetLayerInfo
@@ -462,6 +472,7 @@ public:
     bool                          m_bExplodeCollections;
     bool                          m_bNativeData;
     GIntBig                       m_nLimit;
+    int                           m_nNumThreads;
     OGRGeometryFactory::TransformWithOptionsCache m_transformWithOptionsCache;
 
     int                 Translate(OGRFeature* poFeatureIn,
@@ -472,6 +483,67 @@ public:
                                   GDALProgressFunc pfnProgress,
                                   void *pProgressArg,
                                   GDALVectorTranslateOptions *psOptions);
+
+private:
+    enum class TranslateStatus
+    {
+        OK,
+        SKIPPED,
+        SET_FROM_ERROR,
+        REPROJECTION_ERROR
+    };
+
+    struct TranslateItem;
+    struct TranslateThreadContext;
+    struct TranslateJob;
+
+    TranslateStatus     TranslateFeature(std::unique_ptr<OGRFeature>& poFeature,
+                                         std::unique_ptr<OGRFeature>& poDstFeature,
+                                         TargetLayerInfo* psInfo,
+                                         OGRFeatureDefn* poDstFDefn,
+                                         OGRGeometryCollection* poCollToExplode,
+                                         int iGeomCollToExplode,
+                                         GIntBig nDesiredFID,
+                                         OGRSpatialReference* poOutputSRS,
+                                         const std::vector<std::unique_ptr<OGRCoordinateTransformation>>& apoCT,
+                                         const OGRGeometryFactory::TransformWithOptionsCache& oTransformCache,
+                                         const GDALVectorTranslateOptions* psOptions,
+                                         int& nReprojectionFailures);
+    bool                CommitTransactionIfNeeded(TargetLayerInfo* psInfo,
+                                                  int& nFeaturesInTransaction,
+                                                  GIntBig& nTotalEventsDone,
+                                                  const GDALVectorTranslateOptions *psOptions);
+    bool                WriteTranslatedFeature(TranslateStatus eStatus,
+                                               int nReprojectionFailures,
+                                               OGRFeature* poDstFeature,
+                                               GIntBig nSrcFID,
+                                               GIntBig nDesiredFID,
+                                               TargetLayerInfo* psInfo,
+                                               GIntBig& nFeaturesWritten,
+                                               const GDALVectorTranslateOptions *psOptions);
+    bool                TranslateMultiThreaded(std::unique_ptr<OGRFeature> poFirstFeature,
+                                               TargetLayerInfo* psInfo,
+                                               OGRSpatialReference* poOutputSRS,
+                                               GIntBig nCountLayerFeatures,
+                                               GIntBig* pnReadFeatureCount,
+                                               GIntBig& nCount,
+                                               GIntBig& nFeaturesWritten,
+                                               int& nFeaturesInTransaction,
+                                               GIntBig& nTotalEventsDone,
+                                               GDALProgressFunc pfnProgress,
+                                               void *pProgressArg,
+                                               const GDALVectorTranslateOptions *psOptions,
+                                               bool& bRet);
+    static void         TranslateJobFunc(void* pData);
+    bool                CanTranslateArrow(TargetLayerInfo* psInfo,
+                                          const GDALVectorTranslateOptions *psOptions) const;
+    bool                TranslateArrow(TargetLayerInfo* psInfo,
+                                       GIntBig nCountLayerFeatures,
+                                       GIntBig* pnReadFeatureCount,
+                                       GIntBig& nTotalEventsDone,
+                                       GDALProgressFunc pfnProgress,
+                                       void *pProgressArg,
+                                       const GDALVectorTranslateOptions *psOptions);
 };
 
 static OGRLayer* GetLayerAndOverwriteIfNecessary(GDALDataset *poDstDS,
@@ -2635,6 +2707,7 @@ GDALDatasetH GDALVectorTranslate( const char *pszDest, GDALDatasetH hDstDS, int
     oTranslator.m_bExplodeCollections = psOptions->bExplodeCollections;
     oTranslator.m_bNativeData = psOptions->bNativeData;
     oTranslator.m_nLimit = psOptions->nLimit;
+    oTranslator.m_nNumThreads = psOptions->nNumThreads;
 
     if( psOptions->nGroupTransactions )
     {
@@ -4696,495 +4769,1103 @@ static bool SetupCT( TargetLayerInfo* psInfo,
 }
 
 /************************************************************************/
-/*                     LayerTranslator::Translate()                     */
+/*                 LayerTranslator::TranslateFeature()                  */
 /************************************************************************/
 
-int LayerTranslator::Translate( OGRFeature* poFeatureIn,
-                                TargetLayerInfo* psInfo,
-                                GIntBig nCountLayerFeatures,
-                                GIntBig* pnReadFeatureCount,
-                                GIntBig& nTotalEventsDone,
-                                GDALProgressFunc pfnProgress,
-                                void *pProgressArg,
-                                GDALVectorTranslateOptions *psOptions )
+// Builds the target feature from the source feature and applies the
+// geometry operations to it. Neither the source nor the target layer is
+// accessed, so this can be run from a worker thread, provided that it is
+// given its own coordinate transformations and transformation cache.
+// nReprojectionFailures is incremented for each geometry that could not be
+// reprojected, which, in -skipfailures mode, is then left empty.
+LayerTranslator::TranslateStatus LayerTranslator::TranslateFeature(
+    std::unique_ptr<OGRFeature>& poFeature,
+    std::unique_ptr<OGRFeature>& poDstFeature,
+    TargetLayerInfo* psInfo,
+    OGRFeatureDefn* poDstFDefn,
+    OGRGeometryCollection* poCollToExplode,
+    int iGeomCollToExplode,
+    GIntBig nDesiredFID,
+    OGRSpatialReference* poOutputSRS,
+    const std::vector<std::unique_ptr<OGRCoordinateTransformation>>& apoCT,
+    const OGRGeometryFactory::TransformWithOptionsCache& oTransformCache,
+    const GDALVectorTranslateOptions* psOptions,
+    int& nReprojectionFailures )
 {
     const int eGType = m_eGType;
-    OGRSpatialReference* poOutputSRS = m_poOutputSRS;
-
-    OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
-    OGRLayer *poDstLayer = psInfo->m_poDstLayer;
     const int* const panMap = psInfo->m_anMap.data();
     const int iSrcZField = psInfo->m_iSrcZField;
-    const bool bPreserveFID = psInfo->m_bPreserveFID;
-    const auto poSrcFDefn = poSrcLayer->GetLayerDefn();
-    const auto poDstFDefn = poDstLayer->GetLayerDefn();
-    const int nSrcGeomFieldCount = poSrcFDefn->GetGeomFieldCount();
+    const int nSrcGeomFieldCount = poFeature->GetGeomFieldCount();
     const int nDstGeomFieldCount = poDstFDefn->GetGeomFieldCount();
     const bool bExplodeCollections = m_bExplodeCollections && nDstGeomFieldCount <= 1;
     const int iRequestedSrcGeomField = psInfo->m_iRequestedSrcGeomField;
 
-    if( poOutputSRS == nullptr && !m_bNullifyOutputSRS )
+    if( psInfo->m_bCanAvoidSetFrom )
     {
-        if( nSrcGeomFieldCount == 1 )
+        poDstFeature = std::move(poFeature);
+        // From now on, poFeature is null !
+        poDstFeature->SetFDefnUnsafe(poDstFDefn);
+        poDstFeature->SetFID(nDesiredFID);
+    }
+    else
+    {
+        /* Optimization to avoid duplicating the source geometry in the */
+        /* target feature : we steal it from the source feature for now... */
+        OGRGeometry* poStolenGeometry = nullptr;
+        if( !bExplodeCollections && nSrcGeomFieldCount == 1 &&
+            (nDstGeomFieldCount == 1 ||
+             (nDstGeomFieldCount == 0 && m_poClipSrc)) )
         {
-            poOutputSRS = poSrcLayer->GetSpatialRef();
+            poStolenGeometry = poFeature->StealGeometry();
         }
-        else if( iRequestedSrcGeomField > 0 )
+        else if( !bExplodeCollections &&
+                 iRequestedSrcGeomField >= 0 )
         {
-            poOutputSRS = poSrcLayer->GetLayerDefn()->GetGeomFieldDefn(
-                iRequestedSrcGeomField)->GetSpatialRef();
+            poStolenGeometry = poFeature->StealGeometry(
+                iRequestedSrcGeomField);
         }
-    }
 
-/* -------------------------------------------------------------------- */
-/*      Transfer features.                                              */
-/* -------------------------------------------------------------------- */
-    if( psOptions->nGroupTransactions )
-    {
-        if( psOptions->nLayerTransaction )
+        if( nDstGeomFieldCount == 0 && poStolenGeometry && m_poClipSrc )
         {
-            if( poDstLayer->StartTransaction() == OGRERR_FAILURE )
+            OGRGeometry* poClipped = poStolenGeometry->Intersection(m_poClipSrc);
+            delete poStolenGeometry;
+            poStolenGeometry = nullptr;
+            if (poClipped == nullptr || poClipped->IsEmpty())
             {
-                delete poFeatureIn;
-                return false;
+                delete poClipped;
+                return TranslateStatus::SKIPPED;
+            }
+            delete poClipped;
+        }
+
+        if( poDstFeature == nullptr )
+            poDstFeature.reset(new OGRFeature(poDstFDefn));
+        else
+            poDstFeature->Reset();
+        if( poDstFeature->SetFrom( poFeature.get(), panMap, TRUE ) != OGRERR_NONE )
+        {
+            OGRGeometryFactory::destroyGeometry( poStolenGeometry );
+            return TranslateStatus::SET_FROM_ERROR;
+        }
+
+        /* ... and now we can attach the stolen geometry */
+        if( poStolenGeometry )
+        {
+            poDstFeature->SetGeometryDirectly(poStolenGeometry);
+        }
+
+        if( !psInfo->m_oMapResolved.empty() )
+        {
+            for( const auto& kv: psInfo->m_oMapResolved )
+            {
+                const int nDstField = kv.first;
+                const int nSrcField = kv.second.nSrcField;
+                if( poFeature->IsFieldSetAndNotNull(nSrcField) )
+                {
+                    const auto poDomain = kv.second.poDomain;
+                    const auto oIterDomain =
+                        psInfo->m_oMapDomainToKV.find(poDomain);
+                    if( oIterDomain == psInfo->m_oMapDomainToKV.end() )
+                        continue;
+                    const auto& oMapKV = oIterDomain->second;
+                    const auto iter = oMapKV.find(
+                        poFeature->GetFieldAsString(nSrcField));
+                    if( iter != oMapKV.end() )
+                    {
+                        poDstFeature->SetField(nDstField, iter->second.c_str());
+                    }
+                }
             }
         }
+
+        if( nDesiredFID != OGRNullFID )
+            poDstFeature->SetFID( nDesiredFID );
     }
 
-    std::unique_ptr<OGRFeature> poFeature;
-    std::unique_ptr<OGRFeature> poDstFeature(new OGRFeature(poDstFDefn));
-    int         nFeaturesInTransaction = 0;
-    GIntBig      nCount = 0; /* written + failed */
-    GIntBig      nFeaturesWritten = 0;
+    if (psOptions->bEmptyStrAsNull) {
+        for( int i=0; i < poDstFeature->GetFieldCount(); i++ )
+        {
+            if (!poDstFeature->IsFieldSetAndNotNull(i))
+                continue;
+            auto fieldDef = poDstFeature->GetFieldDefnRef(i);
+            if (fieldDef->GetType() != OGRFieldType::OFTString)
+                continue;
+            auto str = poDstFeature->GetFieldAsString(i);
+            if (strcmp(str, "") == 0)
+                poDstFeature->SetFieldNull(i);
+        }
+    }
 
-    bool bRet = true;
-    CPLErrorReset();
-    while( true )
+    /* Erase native data if asked explicitly */
+    if( !m_bNativeData )
     {
-        if( m_nLimit >= 0 && psInfo->m_nFeaturesRead >= m_nLimit )
+        poDstFeature->SetNativeData(nullptr);
+        poDstFeature->SetNativeMediaType(nullptr);
+    }
+
+    for( int iGeom = 0; iGeom < nDstGeomFieldCount; iGeom ++ )
+    {
+        OGRGeometry* poDstGeometry;
+
+        if( poCollToExplode && iGeom == iGeomCollToExplode )
         {
-            break;
+            OGRGeometry* poPart = poCollToExplode->getGeometryRef(0);
+            poCollToExplode->removeGeometry(0, FALSE);
+            poDstGeometry = poPart;
+            assert(poDstGeometry);
         }
-
-        if( poFeatureIn != nullptr )
-            poFeature.reset(poFeatureIn);
-        else if( psOptions->nFIDToFetch != OGRNullFID )
-            poFeature.reset(poSrcLayer->GetFeature(psOptions->nFIDToFetch));
         else
-            poFeature.reset(poSrcLayer->GetNextFeature());
+        {
+            poDstGeometry = poDstFeature->StealGeometry(iGeom);
+            if (poDstGeometry == nullptr)
+                continue;
+        }
 
-        if( poFeature == nullptr )
+        // poFeature hasn't been moved if iSrcZField != -1
+        // cppcheck-suppress accessMoved
+        if (iSrcZField != -1 && poFeature != nullptr)
         {
-            if( CPLGetLastErrorType() == CE_Failure )
+            SetZ(poDstGeometry, poFeature->GetFieldAsDouble(iSrcZField));
+            /* This will correct the coordinate dimension to 3 */
+            OGRGeometry* poDupGeometry = poDstGeometry->clone();
+            delete poDstGeometry;
+            poDstGeometry = poDupGeometry;
+        }
+
+        if (m_nCoordDim == 2 || m_nCoordDim == 3)
+        {
+            poDstGeometry->setCoordinateDimension( m_nCoordDim );
+        }
+        else if (m_nCoordDim == 4)
+        {
+            poDstGeometry->set3D( TRUE );
+            poDstGeometry->setMeasured( TRUE );
+        }
+        else if (m_nCoordDim == COORD_DIM_XYM)
+        {
+            poDstGeometry->set3D( FALSE );
+            poDstGeometry->setMeasured( TRUE );
+        }
+        else if ( m_nCoordDim == COORD_DIM_LAYER_DIM )
+        {
+            const OGRwkbGeometryType eDstLayerGeomType =
+              poDstFDefn->GetGeomFieldDefn(iGeom)->GetType();
+            poDstGeometry->set3D( wkbHasZ(eDstLayerGeomType) );
+            poDstGeometry->setMeasured( wkbHasM(eDstLayerGeomType) );
+        }
+
+        if (m_eGeomOp == GEOMOP_SEGMENTIZE)
+        {
+            if (m_dfGeomOpParam > 0)
+                poDstGeometry->segmentize(m_dfGeomOpParam);
+        }
+        else if (m_eGeomOp == GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY)
+        {
+            if (m_dfGeomOpParam > 0)
             {
-                bRet = false;
+                OGRGeometry* poNewGeom = poDstGeometry->SimplifyPreserveTopology(m_dfGeomOpParam);
+                if (poNewGeom)
+                {
+                    delete poDstGeometry;
+                    poDstGeometry = poNewGeom;
+                }
             }
-            break;
         }
 
-        if( psInfo->m_nFeaturesRead == 0 || psInfo->m_bPerFeatureCT )
+        if (m_poClipSrc)
         {
-            if( !SetupCT( psInfo, poSrcLayer, m_bTransform, m_bWrapDateline,
-                          m_osDateLineOffset, m_poUserSourceSRS,
-                          poFeature.get(), poOutputSRS, m_poGCPCoordTrans) )
+            OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipSrc);
+            delete poDstGeometry;
+            if (poClipped == nullptr || poClipped->IsEmpty())
             {
-                return false;
+                delete poClipped;
+                return TranslateStatus::SKIPPED;
             }
+            poDstGeometry = poClipped;
         }
 
-        psInfo->m_nFeaturesRead ++;
+        OGRCoordinateTransformation* const poCT = apoCT[iGeom].get();
+        char** const papszTransformOptions = psInfo->m_aosTransformOptions[iGeom].List();
 
-        int nIters = 1;
-        std::unique_ptr<OGRGeometryCollection> poCollToExplode;
-        int iGeomCollToExplode = -1;
-        if (bExplodeCollections)
+        if( poCT != nullptr || papszTransformOptions != nullptr)
         {
-            OGRGeometry* poSrcGeometry;
-            if( iRequestedSrcGeomField >= 0 )
-                poSrcGeometry = poFeature->GetGeomFieldRef(
-                                        iRequestedSrcGeomField);
-            else
-                poSrcGeometry = poFeature->GetGeometryRef();
-            if (poSrcGeometry &&
-                OGR_GT_IsSubClassOf(poSrcGeometry->getGeometryType(), wkbGeometryCollection) )
+            OGRGeometry* poReprojectedGeom =
+                OGRGeometryFactory::transformWithOptions(
+                    poDstGeometry, poCT, papszTransformOptions, oTransformCache);
+            delete poDstGeometry;
+            poDstGeometry = poReprojectedGeom;
+            if( poReprojectedGeom == nullptr )
             {
-                const int nParts = poSrcGeometry->toGeometryCollection()->getNumGeometries();
-                if( nParts > 0 )
-                {
-                    iGeomCollToExplode = iRequestedSrcGeomField >= 0 ?
-                        iRequestedSrcGeomField : 0;
-                    poCollToExplode.reset(
-                        poFeature->StealGeometry(iGeomCollToExplode)->toGeometryCollection());
-                    nIters = nParts;
-                }
+                nReprojectionFailures ++;
+                if( !psOptions->bSkipFailures )
+                    return TranslateStatus::REPROJECTION_ERROR;
             }
         }
+        else if (poOutputSRS != nullptr)
+        {
+            poDstGeometry->assignSpatialReference(poOutputSRS);
+        }
 
-        const GIntBig nSrcFID = poFeature->GetFID();
-        GIntBig nDesiredFID = OGRNullFID;
-        if( bPreserveFID )
-            nDesiredFID = nSrcFID;
-        else if( psInfo->m_iSrcFIDField >= 0 &&
-                 poFeature->IsFieldSetAndNotNull(psInfo->m_iSrcFIDField))
-            nDesiredFID = poFeature->GetFieldAsInteger64(psInfo->m_iSrcFIDField);
-
-        for(int iPart = 0; iPart < nIters; iPart++)
+        if( poDstGeometry != nullptr )
         {
-            if( psOptions->nLayerTransaction &&
-                ++nFeaturesInTransaction == psOptions->nGroupTransactions )
+            if (m_poClipDst)
             {
-                if( poDstLayer->CommitTransaction() == OGRERR_FAILURE ||
-                    poDstLayer->StartTransaction() == OGRERR_FAILURE )
+                OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipDst);
+                delete poDstGeometry;
+                if (poClipped == nullptr || poClipped->IsEmpty())
                 {
-                    return false;
+                    delete poClipped;
+                    return TranslateStatus::SKIPPED;
                 }
-                nFeaturesInTransaction = 0;
+
+                poDstGeometry = poClipped;
             }
-            else if( !psOptions->nLayerTransaction &&
-                     psOptions->nGroupTransactions >= 0 &&
-                     ++nTotalEventsDone >= psOptions->nGroupTransactions )
+
+            if( m_bMakeValid )
             {
-                if( m_poODS->CommitTransaction() == OGRERR_FAILURE ||
-                        m_poODS->StartTransaction(psOptions->bForceTransaction) == OGRERR_FAILURE )
+                const bool bIsGeomCollection =
+                    wkbFlatten(poDstGeometry->getGeometryType()) == wkbGeometryCollection;
+                OGRGeometry* poValidGeom = poDstGeometry->MakeValid();
+                delete poDstGeometry;
+                poDstGeometry = poValidGeom;
+                if( poDstGeometry == nullptr )
+                    return TranslateStatus::SKIPPED;
+                if( !bIsGeomCollection )
                 {
-                    return false;
+                    OGRGeometry* poCleanedGeom =
+                        OGRGeometryFactory::removeLowerDimensionSubGeoms(poDstGeometry);
+                    delete poDstGeometry;
+                    poDstGeometry = poCleanedGeom;
                 }
-                nTotalEventsDone = 0;
             }
 
-            CPLErrorReset();
-            if( psInfo->m_bCanAvoidSetFrom )
+            if( eGType != GEOMTYPE_UNCHANGED )
             {
-                poDstFeature = std::move(poFeature);
-                // From now on, poFeature is null !
-                poDstFeature->SetFDefnUnsafe(poDstFDefn);
-                poDstFeature->SetFID(nDesiredFID);
+                poDstGeometry = OGRGeometryFactory::forceTo(
+                        poDstGeometry, static_cast<OGRwkbGeometryType>(eGType));
             }
-            else
+            else if( m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI ||
+                    m_eGeomTypeConversion == GTC_CONVERT_TO_LINEAR ||
+                    m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI_AND_CONVERT_TO_LINEAR ||
+                    m_eGeomTypeConversion == GTC_CONVERT_TO_CURVE )
             {
-                /* Optimization to avoid duplicating the source geometry in the */
-                /* target feature : we steal it from the source feature for now... */
-                OGRGeometry* poStolenGeometry = nullptr;
-                if( !bExplodeCollections && nSrcGeomFieldCount == 1 &&
-                    (nDstGeomFieldCount == 1 ||
-                     (nDstGeomFieldCount == 0 && m_poClipSrc)) )
-                {
-                    poStolenGeometry = poFeature->StealGeometry();
-                }
-                else if( !bExplodeCollections &&
-                         iRequestedSrcGeomField >= 0 )
-                {
-                    poStolenGeometry = poFeature->StealGeometry(
-                        iRequestedSrcGeomField);
-                }
-
-                if( nDstGeomFieldCount == 0 && poStolenGeometry && m_poClipSrc )
-                {
-                    OGRGeometry* poClipped = poStolenGeometry->Intersection(m_poClipSrc);
-                    delete poStolenGeometry;
-                    poStolenGeometry = nullptr;
-                    if (poClipped == nullptr || poClipped->IsEmpty())
-                    {
-                        delete poClipped;
-                        goto end_loop;
-                    }
-                    delete poClipped;
-                }
+                OGRwkbGeometryType eTargetType = poDstGeometry->getGeometryType();
+                eTargetType = ConvertType(m_eGeomTypeConversion, eTargetType);
+                poDstGeometry = OGRGeometryFactory::forceTo(poDstGeometry, eTargetType);
+            }
+        }
 
-                poDstFeature->Reset();
-                if( poDstFeature->SetFrom( poFeature.get(), panMap, TRUE ) != OGRERR_NONE )
-                {
-                    if( psOptions->nGroupTransactions )
-                    {
-                        if( psOptions->nLayerTransaction )
-                        {
-                            if( poDstLayer->CommitTransaction() != OGRERR_NONE )
-                            {
-                                OGRGeometryFactory::destroyGeometry( poStolenGeometry );
-                                return false;
-                            }
-                        }
-                    }
+        poDstFeature->SetGeomFieldDirectly(iGeom, poDstGeometry);
+    }
 
-                    CPLError( CE_Failure, CPLE_AppDefined,
-                            "Unable to translate feature " CPL_FRMT_GIB " from layer %s.",
-                            nSrcFID, poSrcLayer->GetName() );
+    return TranslateStatus::OK;
+}
 
-                    OGRGeometryFactory::destroyGeometry( poStolenGeometry );
-                    return false;
-                }
+/************************************************************************/
+/*              LayerTranslator::CommitTransactionIfNeeded()            */
+/************************************************************************/
 
-                /* ... and now we can attach the stolen geometry */
-                if( poStolenGeometry )
-                {
-                    poDstFeature->SetGeometryDirectly(poStolenGeometry);
-                }
+// Commits and restarts the current transaction every
+// GDALVectorTranslateOptions::nGroupTransactions features.
+bool LayerTranslator::CommitTransactionIfNeeded( TargetLayerInfo* psInfo,
+                                                 int& nFeaturesInTransaction,
+                                                 GIntBig& nTotalEventsDone,
+                                                 const GDALVectorTranslateOptions *psOptions )
+{
+    OGRLayer *poDstLayer = psInfo->m_poDstLayer;
+    if( psOptions->nLayerTransaction &&
+        ++nFeaturesInTransaction == psOptions->nGroupTransactions )
+    {
+        if( poDstLayer->CommitTransaction() == OGRERR_FAILURE ||
+            poDstLayer->StartTransaction() == OGRERR_FAILURE )
+        {
+            return false;
+        }
+        nFeaturesInTransaction = 0;
+    }
+    else if( !psOptions->nLayerTransaction &&
+             psOptions->nGroupTransactions >= 0 &&
+             ++nTotalEventsDone >= psOptions->nGroupTransactions )
+    {
+        if( m_poODS->CommitTransaction() == OGRERR_FAILURE ||
+                m_poODS->StartTransaction(psOptions->bForceTransaction) == OGRERR_FAILURE )
+        {
+            return false;
+        }
+        nTotalEventsDone = 0;
+    }
+    return true;
+}
 
-                if( !psInfo->m_oMapResolved.empty() )
-                {
-                    for( const auto& kv: psInfo->m_oMapResolved )
-                    {
-                        const int nDstField = kv.first;
-                        const int nSrcField = kv.second.nSrcField;
-                        if( poFeature->IsFieldSetAndNotNull(nSrcField) )
-                        {
-                            const auto poDomain = kv.second.poDomain;
-                            const auto& oMapKV = psInfo->m_oMapDomainToKV[poDomain];
-                            const auto iter = oMapKV.find(
-                                poFeature->GetFieldAsString(nSrcField));
-                            if( iter != oMapKV.end() )
-                            {
-                                poDstFeature->SetField(nDstField, iter->second.c_str());
-                            }
-                        }
-                    }
-                }
+/************************************************************************/
+/*               LayerTranslator::WriteTranslatedFeature()              */
+/************************************************************************/
 
-                if( nDesiredFID != OGRNullFID )
-                    poDstFeature->SetFID( nDesiredFID );
-            }
+// Reports the errors of TranslateFeature() and writes the target feature
+// if it has not been skipped. Returns false if the translation of the
+// layer must be aborted.
+bool LayerTranslator::WriteTranslatedFeature( TranslateStatus eStatus,
+                                              int nReprojectionFailures,
+                                              OGRFeature* poDstFeature,
+                                              GIntBig nSrcFID,
+                                              GIntBig nDesiredFID,
+                                              TargetLayerInfo* psInfo,
+                                              GIntBig& nFeaturesWritten,
+                                              const GDALVectorTranslateOptions *psOptions )
+{
+    OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
+    OGRLayer *poDstLayer = psInfo->m_poDstLayer;
 
-            if (psOptions->bEmptyStrAsNull) {
-                for( int i=0; i < poDstFeature->GetFieldCount(); i++ )
+    if( eStatus == TranslateStatus::SET_FROM_ERROR )
+    {
+        if( psOptions->nGroupTransactions )
+        {
+            if( psOptions->nLayerTransaction )
+            {
+                if( poDstLayer->CommitTransaction() != OGRERR_NONE )
                 {
-                    if (!poDstFeature->IsFieldSetAndNotNull(i))
-                        continue;
-                    auto fieldDef = poDstFeature->GetFieldDefnRef(i);
-                    if (fieldDef->GetType() != OGRFieldType::OFTString)
-                        continue;
-                    auto str = poDstFeature->GetFieldAsString(i);
-                    if (strcmp(str, "") == 0)
-                        poDstFeature->SetFieldNull(i);
+                    return false;
                 }
             }
+        }
 
-            /* Erase native data if asked explicitly */
-            if( !m_bNativeData )
-            {
-                poDstFeature->SetNativeData(nullptr);
-                poDstFeature->SetNativeMediaType(nullptr);
-            }
+        CPLError( CE_Failure, CPLE_AppDefined,
+                "Unable to translate feature " CPL_FRMT_GIB " from layer %s.",
+                nSrcFID, poSrcLayer->GetName() );
+        return false;
+    }
 
-            for( int iGeom = 0; iGeom < nDstGeomFieldCount; iGeom ++ )
+    for( int i = 0; i < nReprojectionFailures; ++i )
+    {
+        if( psOptions->nGroupTransactions )
+        {
+            if( psOptions->nLayerTransaction )
             {
-                OGRGeometry* poDstGeometry;
-
-                if( poCollToExplode && iGeom == iGeomCollToExplode )
-                {
-                    OGRGeometry* poPart = poCollToExplode->getGeometryRef(0);
-                    poCollToExplode->removeGeometry(0, FALSE);
-                    poDstGeometry = poPart;
-                    assert(poDstGeometry);
-                }
-                else
+                if( poDstLayer->CommitTransaction() != OGRERR_NONE &&
+                    !psOptions->bSkipFailures )
                 {
-                    poDstGeometry = poDstFeature->StealGeometry(iGeom);
-                    if (poDstGeometry == nullptr)
-                        continue;
+                    return false;
                 }
+            }
+        }
 
-                // poFeature hasn't been moved if iSrcZField != -1
-                // cppcheck-suppress accessMoved
-                if (iSrcZField != -1 && poFeature != nullptr)
-                {
-                    SetZ(poDstGeometry, poFeature->GetFieldAsDouble(iSrcZField));
-                    /* This will correct the coordinate dimension to 3 */
-                    OGRGeometry* poDupGeometry = poDstGeometry->clone();
-                    delete poDstGeometry;
-                    poDstGeometry = poDupGeometry;
-                }
+        CPLError( CE_Failure, CPLE_AppDefined, "Failed to reproject feature " CPL_FRMT_GIB " (geometry probably out of source or destination SRS).",
+                  nSrcFID );
+        if( !psOptions->bSkipFailures )
+        {
+            return false;
+        }
+    }
 
-                if (m_nCoordDim == 2 || m_nCoordDim == 3)
-                {
-                    poDstGeometry->setCoordinateDimension( m_nCoordDim );
-                }
-                else if (m_nCoordDim == 4)
-                {
-                    poDstGeometry->set3D( TRUE );
-                    poDstGeometry->setMeasured( TRUE );
-                }
-                else if (m_nCoordDim == COORD_DIM_XYM)
-                {
-                    poDstGeometry->set3D( FALSE );
-                    poDstGeometry->setMeasured( TRUE );
-                }
-                else if ( m_nCoordDim == COORD_DIM_LAYER_DIM )
-                {
-                    const OGRwkbGeometryType eDstLayerGeomType =
-                      poDstLayer->GetLayerDefn()->GetGeomFieldDefn(iGeom)->GetType();
-                    poDstGeometry->set3D( wkbHasZ(eDstLayerGeomType) );
-                    poDstGeometry->setMeasured( wkbHasM(eDstLayerGeomType) );
-                }
+    if( eStatus != TranslateStatus::OK )
+        return true;
 
-                if (m_eGeomOp == GEOMOP_SEGMENTIZE)
-                {
-                    if (m_dfGeomOpParam > 0)
-                        poDstGeometry->segmentize(m_dfGeomOpParam);
-                }
-                else if (m_eGeomOp == GEOMOP_SIMPLIFY_PRESERVE_TOPOLOGY)
-                {
-                    if (m_dfGeomOpParam > 0)
-                    {
-                        OGRGeometry* poNewGeom = poDstGeometry->SimplifyPreserveTopology(m_dfGeomOpParam);
-                        if (poNewGeom)
-                        {
-                            delete poDstGeometry;
-                            poDstGeometry = poNewGeom;
-                        }
-                    }
-                }
+    CPLErrorReset();
+    if( (psOptions->bUpsert ?
+            poDstLayer->UpsertFeature( poDstFeature ) :
+            poDstLayer->CreateFeature( poDstFeature )) == OGRERR_NONE )
+    {
+        nFeaturesWritten ++;
+        if( nDesiredFID != OGRNullFID  && poDstFeature->GetFID() != nDesiredFID )
+        {
+            CPLError( CE_Warning, CPLE_AppDefined,
+                      "Feature id not preserved");
+        }
+    }
+    else if( !psOptions->bSkipFailures )
+    {
+        if( psOptions->nGroupTransactions )
+        {
+            if( psOptions->nLayerTransaction )
+                poDstLayer->RollbackTransaction();
+        }
 
-                if (m_poClipSrc)
-                {
-                    OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipSrc);
-                    delete poDstGeometry;
-                    if (poClipped == nullptr || poClipped->IsEmpty())
-                    {
-                        delete poClipped;
-                        goto end_loop;
-                    }
-                    poDstGeometry = poClipped;
-                }
+        CPLError( CE_Failure, CPLE_AppDefined,
+                "Unable to write feature " CPL_FRMT_GIB " from layer %s.",
+                nSrcFID, poSrcLayer->GetName() );
 
-                OGRCoordinateTransformation* const poCT = psInfo->m_apoCT[iGeom].get();
-                char** const papszTransformOptions = psInfo->m_aosTransformOptions[iGeom].List();
+        return false;
+    }
+    else
+    {
+        CPLDebug( "GDALVectorTranslate", "Unable to write feature " CPL_FRMT_GIB " into layer %s.",
+                   nSrcFID, poSrcLayer->GetName() );
+        if( psOptions->nGroupTransactions )
+        {
+            if( psOptions->nLayerTransaction )
+            {
+                poDstLayer->RollbackTransaction();
+                CPL_IGNORE_RET_VAL(poDstLayer->StartTransaction());
+            }
+            else
+            {
+                m_poODS->RollbackTransaction();
+                m_poODS->StartTransaction(psOptions->bForceTransaction);
+            }
+        }
+    }
+    return true;
+}
 
-                if( poCT != nullptr || papszTransformOptions != nullptr)
-                {
-                    OGRGeometry* poReprojectedGeom =
-                        OGRGeometryFactory::transformWithOptions(
-                            poDstGeometry, poCT, papszTransformOptions, m_transformWithOptionsCache);
-                    if( poReprojectedGeom == nullptr )
-                    {
-                        if( psOptions->nGroupTransactions )
-                        {
-                            if( psOptions->nLayerTransaction )
-                            {
-                                if( poDstLayer->CommitTransaction() != OGRERR_NONE &&
-                                    !psOptions->bSkipFailures )
-                                {
-                                    delete poDstGeometry;
-                                    return false;
-                                }
-                            }
-                        }
+/************************************************************************/
+/*                    LayerTranslator::TranslateJob                     */
+/************************************************************************/
 
-                        CPLError( CE_Failure, CPLE_AppDefined, "Failed to reproject feature " CPL_FRMT_GIB " (geometry probably out of source or destination SRS).",
-                                  nSrcFID );
-                        if( !psOptions->bSkipFailures )
-                        {
-                            delete poDstGeometry;
-                            return false;
-                        }
-                    }
+struct LayerTranslator::TranslateItem
+{
+    std::unique_ptr<OGRFeature> poFeature{};
+    std::unique_ptr<OGRFeature> poDstFeature{};
+    GIntBig nSrcFID = OGRNullFID;
+    GIntBig nDesiredFID = OGRNullFID;
+    TranslateStatus eStatus = TranslateStatus::OK;
+    int nReprojectionFailures = 0;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
 
-                    delete poDstGeometry;
-                    poDstGeometry = poReprojectedGeom;
+// Coordinate transformations are not thread-safe, so each job works with
+// its own clones.
+struct LayerTranslator::TranslateThreadContext
+{
+    std::vector<std::unique_ptr<OGRCoordinateTransformation>> apoCT{};
+    OGRGeometryFactory::TransformWithOptionsCache oTransformCache{};
+};
+
+struct LayerTranslator::TranslateJob
+{
+    LayerTranslator* poTranslator = nullptr;
+    TargetLayerInfo* psInfo = nullptr;
+    OGRFeatureDefn* poDstFDefn = nullptr;
+    OGRSpatialReference* poOutputSRS = nullptr;
+    const GDALVectorTranslateOptions* psOptions = nullptr;
+    TranslateThreadContext* psContext = nullptr;
+    std::vector<TranslateItem>* paoItems = nullptr;
+    size_t nBegin = 0;
+    size_t nEnd = 0;
+};
+
+/************************************************************************/
+/*                  LayerTranslator::TranslateJobFunc()                 */
+/************************************************************************/
+
+void LayerTranslator::TranslateJobFunc( void* pData )
+{
+    TranslateJob* psJob = static_cast<TranslateJob*>(pData);
+    for( size_t i = psJob->nBegin; i < psJob->nEnd; ++i )
+    {
+        TranslateItem& oItem = (*psJob->paoItems)[i];
+
+        // Errors are emitted again by the writing thread, in feature order.
+        CPLInstallErrorHandlerAccumulator(oItem.aoErrors);
+        CPLSetCurrentErrorHandlerCatchDebug( FALSE );
+        oItem.eStatus = psJob->poTranslator->TranslateFeature(
+            oItem.poFeature, oItem.poDstFeature, psJob->psInfo,
+            psJob->poDstFDefn, nullptr, -1, oItem.nDesiredFID,
+            psJob->poOutputSRS, psJob->psContext->apoCT,
+            psJob->psContext->oTransformCache, psJob->psOptions,
+            oItem.nReprojectionFailures);
+        oItem.poFeature.reset();
+        CPLUninstallErrorHandlerAccumulator();
+    }
+}
+
+/************************************************************************/
+/*               LayerTranslator::TranslateMultiThreaded()              */
+/************************************************************************/
+
+// Translates the remaining features of the source layer, starting with
+// poFirstFeature. Features are read and written in their original order by
+// the calling thread, while TranslateFeature() is run on the global thread
+// pool. At most two batches of features are in memory: the one being
+// translated, and the one being written and then read.
+// Returns false if the translation must be aborted without committing the
+// pending transaction, as in the sequential code path.
+bool LayerTranslator::TranslateMultiThreaded(
+                                std::unique_ptr<OGRFeature> poFirstFeature,
+                                TargetLayerInfo* psInfo,
+                                OGRSpatialReference* poOutputSRS,
+                                GIntBig nCountLayerFeatures,
+                                GIntBig* pnReadFeatureCount,
+                                GIntBig& nCount,
+                                GIntBig& nFeaturesWritten,
+                                int& nFeaturesInTransaction,
+                                GIntBig& nTotalEventsDone,
+                                GDALProgressFunc pfnProgress,
+                                void *pProgressArg,
+                                const GDALVectorTranslateOptions *psOptions,
+                                bool& bRet )
+{
+    OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
+    OGRFeatureDefn* poDstFDefn = psInfo->m_poDstLayer->GetLayerDefn();
+    const int nThreads = m_nNumThreads;
+
+    std::vector<std::unique_ptr<TranslateThreadContext>> apoContexts;
+    for( int i = 0; i < nThreads; ++i )
+    {
+        std::unique_ptr<TranslateThreadContext> psContext(
+            new TranslateThreadContext());
+        for( const auto& poCT: psInfo->m_apoCT )
+        {
+            psContext->apoCT.emplace_back(poCT ? poCT->Clone() : nullptr);
+            if( poCT && !psContext->apoCT.back() )
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Cannot clone coordinate transformation. "
+                         "Try without -num_threads");
+                return false;
+            }
+        }
+        apoContexts.emplace_back(std::move(psContext));
+    }
+
+    CPLWorkerThreadPool* poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if( !poQueue )
+        return false;
+
+    const size_t nBatchSize = static_cast<size_t>(nThreads) * 256;
+    std::unique_ptr<OGRFeature> poNextFeature = std::move(poFirstFeature);
+    bool bEOF = false;
+
+    const auto ReadBatch = [&](std::vector<TranslateItem>& aoBatch)
+    {
+        aoBatch.clear();
+        while( !bEOF && aoBatch.size() < nBatchSize )
+        {
+            if( poNextFeature == nullptr )
+            {
+                if( m_nLimit >= 0 && psInfo->m_nFeaturesRead >= m_nLimit )
+                {
+                    bEOF = true;
+                    break;
                 }
-                else if (poOutputSRS != nullptr)
+                CPLErrorReset();
+                poNextFeature.reset(poSrcLayer->GetNextFeature());
+                if( poNextFeature == nullptr )
                 {
-                    poDstGeometry->assignSpatialReference(poOutputSRS);
+                    if( CPLGetLastErrorType() == CE_Failure )
+                        bRet = false;
+                    bEOF = true;
+                    break;
                 }
+                psInfo->m_nFeaturesRead ++;
+            }
 
-                if( poDstGeometry != nullptr )
-                {
-                    if (m_poClipDst)
-                    {
-                        OGRGeometry* poClipped = poDstGeometry->Intersection(m_poClipDst);
-                        delete poDstGeometry;
-                        if (poClipped == nullptr || poClipped->IsEmpty())
-                        {
-                            delete poClipped;
-                            goto end_loop;
-                        }
+            TranslateItem oItem;
+            oItem.nSrcFID = poNextFeature->GetFID();
+            if( psInfo->m_bPreserveFID )
+                oItem.nDesiredFID = oItem.nSrcFID;
+            else if( psInfo->m_iSrcFIDField >= 0 &&
+                     poNextFeature->IsFieldSetAndNotNull(psInfo->m_iSrcFIDField))
+                oItem.nDesiredFID = poNextFeature->GetFieldAsInteger64(psInfo->m_iSrcFIDField);
+            oItem.poFeature = std::move(poNextFeature);
+            aoBatch.emplace_back(std::move(oItem));
+        }
+    };
 
-                        poDstGeometry = poClipped;
-                    }
+    std::vector<TranslateJob> asJobs(nThreads);
+    const auto SubmitBatch = [&](std::vector<TranslateItem>& aoBatch)
+    {
+        const size_t nPerJob = (aoBatch.size() + nThreads - 1) / nThreads;
+        for( int i = 0; i < nThreads; ++i )
+        {
+            TranslateJob& sJob = asJobs[i];
+            sJob.poTranslator = this;
+            sJob.psInfo = psInfo;
+            sJob.poDstFDefn = poDstFDefn;
+            sJob.poOutputSRS = poOutputSRS;
+            sJob.psOptions = psOptions;
+            sJob.psContext = apoContexts[i].get();
+            sJob.paoItems = &aoBatch;
+            sJob.nBegin = std::min(aoBatch.size(), i * nPerJob);
+            sJob.nEnd = std::min(aoBatch.size(), sJob.nBegin + nPerJob);
+            if( sJob.nBegin == sJob.nEnd )
+                break;
+            poQueue->SubmitJob(TranslateJobFunc, &sJob);
+        }
+    };
 
-                    if( m_bMakeValid )
-                    {
-                        const bool bIsGeomCollection =
-                            wkbFlatten(poDstGeometry->getGeometryType()) == wkbGeometryCollection;
-                        OGRGeometry* poValidGeom = poDstGeometry->MakeValid();
-                        delete poDstGeometry;
-                        poDstGeometry = poValidGeom;
-                        if( poDstGeometry == nullptr )
-                            goto end_loop;
-                        if( !bIsGeomCollection )
-                        {
-                            OGRGeometry* poCleanedGeom =
-                                OGRGeometryFactory::removeLowerDimensionSubGeoms(poDstGeometry);
-                            delete poDstGeometry;
-                            poDstGeometry = poCleanedGeom;
-                        }
-                    }
+    std::vector<TranslateItem> aoCurBatch;
+    std::vector<TranslateItem> aoNextBatch;
+    ReadBatch(aoCurBatch);
+    SubmitBatch(aoCurBatch);
+    while( !aoCurBatch.empty() )
+    {
+        ReadBatch(aoNextBatch);
+        poQueue->WaitCompletion();
+        SubmitBatch(aoNextBatch);
 
-                    if( eGType != GEOMTYPE_UNCHANGED )
-                    {
-                        poDstGeometry = OGRGeometryFactory::forceTo(
-                                poDstGeometry, static_cast<OGRwkbGeometryType>(eGType));
-                    }
-                    else if( m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI ||
-                            m_eGeomTypeConversion == GTC_CONVERT_TO_LINEAR ||
-                            m_eGeomTypeConversion == GTC_PROMOTE_TO_MULTI_AND_CONVERT_TO_LINEAR ||
-                            m_eGeomTypeConversion == GTC_CONVERT_TO_CURVE )
-                    {
-                        OGRwkbGeometryType eTargetType = poDstGeometry->getGeometryType();
-                        eTargetType = ConvertType(m_eGeomTypeConversion, eTargetType);
-                        poDstGeometry = OGRGeometryFactory::forceTo(poDstGeometry, eTargetType);
-                    }
-                }
+        for( auto& oItem: aoCurBatch )
+        {
+            if( !CommitTransactionIfNeeded(psInfo, nFeaturesInTransaction,
+                                           nTotalEventsDone, psOptions) )
+            {
+                poQueue->WaitCompletion();
+                return false;
+            }
 
-                poDstFeature->SetGeomFieldDirectly(iGeom, poDstGeometry);
+            for( const auto& oError: oItem.aoErrors )
+            {
+                CPLError( oError.type, oError.no, "%s", oError.msg.c_str() );
+            }
+            if( !WriteTranslatedFeature(oItem.eStatus,
+                                        oItem.nReprojectionFailures,
+                                        oItem.poDstFeature.get(),
+                                        oItem.nSrcFID, oItem.nDesiredFID,
+                                        psInfo, nFeaturesWritten, psOptions) )
+            {
+                poQueue->WaitCompletion();
+                return false;
             }
+            oItem.poDstFeature.reset();
 
-            CPLErrorReset();
-            if( (psOptions->bUpsert ?
-                    poDstLayer->UpsertFeature( poDstFeature.get() ) :
-                    poDstLayer->CreateFeature( poDstFeature.get() )) == OGRERR_NONE )
+            /* Report progress */
+            nCount ++;
+            bool bGoOn = true;
+            if (pfnProgress)
+            {
+                bGoOn = pfnProgress(nCountLayerFeatures ? nCount * 1.0 / nCountLayerFeatures: 1.0, "", pProgressArg) != FALSE;
+            }
+            if( !bGoOn )
+            {
+                poQueue->WaitCompletion();
+                bRet = false;
+                return true;
+            }
+
+            if (pnReadFeatureCount)
+                *pnReadFeatureCount = nCount;
+        }
+
+        std::swap(aoCurBatch, aoNextBatch);
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                 LayerTranslator::CanTranslateArrow()                 */
+/************************************************************************/
+
+// Whether the layer can be translated by passing Arrow batches from the
+// source layer to the target layer, that is when no per-feature processing
+// is requested and the source fields map, by name and type, to the target
+// ones (-mapFieldType, -fieldTypeToString, etc. change the target types).
+bool LayerTranslator::CanTranslateArrow( TargetLayerInfo* psInfo,
+                                         const GDALVectorTranslateOptions *psOptions ) const
+{
+    OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
+    OGRLayer *poDstLayer = psInfo->m_poDstLayer;
+
+    const char* pszUseArrow = CPLGetConfigOption("OGR2OGR_USE_ARROW_API", nullptr);
+    if( pszUseArrow != nullptr && !CPLTestBool(pszUseArrow) )
+        return false;
+    if( pszUseArrow == nullptr &&
+        (!poSrcLayer->TestCapability(OLCFastGetArrowStream) ||
+         !poDstLayer->TestCapability(OLCFastWriteArrowBatch)) )
+        return false;
+
+    if( m_bTransform || m_poGCPCoordTrans != nullptr || m_bWrapDateline ||
+        m_eGType != GEOMTYPE_UNCHANGED ||
+        m_eGeomTypeConversion != GTC_DEFAULT || m_bMakeValid ||
+        m_nCoordDim != COORD_DIM_UNCHANGED || m_eGeomOp != GEOMOP_NONE ||
+        m_poClipSrc != nullptr || m_poClipDst != nullptr ||
+        m_poUserSourceSRS != nullptr ||
+        m_bExplodeCollections || m_nLimit >= 0 )
+        return false;
+
+    if( psOptions->bSkipFailures || psOptions->bUpsert ||
+        psOptions->nFIDToFetch != OGRNullFID ||
+        psOptions->pszSQLStatement != nullptr ||
+        psOptions->bSplitListFields || psOptions->bEmptyStrAsNull )
+        return false;
+
+    if( psInfo->m_iSrcZField >= 0 || psInfo->m_iSrcFIDField >= 0 ||
+        psInfo->m_iRequestedSrcGeomField >= 0 ||
+        !psInfo->m_oMapResolved.empty() )
+        return false;
+
+    if( m_bNativeData &&
+        poSrcLayer->GetMetadataItem("NATIVE_DATA", "NATIVE_DATA") != nullptr )
+        return false;
+
+    if( psInfo->m_bPreserveFID && poSrcLayer->GetFIDColumn()[0] == '\0' )
+        return false;
+
+    const auto poSrcFDefn = poSrcLayer->GetLayerDefn();
+    const auto poDstFDefn = poDstLayer->GetLayerDefn();
+    for( int i = 0; i < poSrcFDefn->GetFieldCount(); ++i )
+    {
+        const auto poSrcFieldDefn = poSrcFDefn->GetFieldDefn(i);
+        if( psInfo->m_anMap[i] < 0 )
+        {
+            if( !poSrcFieldDefn->IsIgnored() )
+                return false;
+        }
+        else
+        {
+            const auto poDstFieldDefn = poDstFDefn->GetFieldDefn(psInfo->m_anMap[i]);
+            if( !EQUAL(poSrcFieldDefn->GetNameRef(), poDstFieldDefn->GetNameRef()) ||
+                poSrcFieldDefn->GetType() != poDstFieldDefn->GetType() ||
+                poSrcFieldDefn->GetSubType() != poDstFieldDefn->GetSubType() )
+            {
+                return false;
+            }
+        }
+    }
+
+    const int nSrcGeomFieldCount = poSrcFDefn->GetGeomFieldCount();
+    const int nDstGeomFieldCount = poDstFDefn->GetGeomFieldCount();
+    if( nSrcGeomFieldCount != nDstGeomFieldCount )
+        return false;
+    if( nSrcGeomFieldCount > 1 )
+    {
+        for( int i = 0; i < nSrcGeomFieldCount; ++i )
+        {
+            if( !EQUAL(poSrcFDefn->GetGeomFieldDefn(i)->GetNameRef(),
+                       poDstFDefn->GetGeomFieldDefn(i)->GetNameRef()) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                   LayerTranslator::TranslateArrow()                  */
+/************************************************************************/
+
+// Translates the source layer by reading it with GetArrowStream(), and
+// writing each batch with WriteArrowBatch() on the target layer.
+bool LayerTranslator::TranslateArrow( TargetLayerInfo* psInfo,
+                                      GIntBig nCountLayerFeatures,
+                                      GIntBig* pnReadFeatureCount,
+                                      GIntBig& nTotalEventsDone,
+                                      GDALProgressFunc pfnProgress,
+                                      void *pProgressArg,
+                                      const GDALVectorTranslateOptions *psOptions )
+{
+    OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
+    OGRLayer *poDstLayer = psInfo->m_poDstLayer;
+    const auto poSrcFDefn = poSrcLayer->GetLayerDefn();
+
+    CPLDebug("GDALVectorTranslate", "Using GetArrowStream() / WriteArrowBatch() "
+             "for layer '%s'", poSrcLayer->GetName());
+
+    CPLStringList aosStreamOptions;
+    aosStreamOptions.SetNameValue("INCLUDE_FID",
+                                  psInfo->m_bPreserveFID ? "YES" : "NO");
+    aosStreamOptions.SetNameValue("GEOMETRY_ENCODING", "WKB");
+
+    CPLStringList aosWriteOptions;
+    if( psInfo->m_bPreserveFID )
+        aosWriteOptions.SetNameValue("FID", poSrcLayer->GetFIDColumn());
+    if( poSrcFDefn->GetGeomFieldCount() == 1 )
+    {
+        const char* pszGeomName = poSrcFDefn->GetGeomFieldDefn(0)->GetNameRef();
+        aosWriteOptions.SetNameValue("GEOMETRY_NAME",
+                                     pszGeomName[0] ? pszGeomName : "wkb_geometry");
+    }
+
+    struct ArrowArrayStream stream;
+    if( !poSrcLayer->GetArrowStream(&stream, aosStreamOptions.List()) )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "GetArrowStream() failed");
+        return false;
+    }
+
+    struct ArrowSchema schema;
+    if( stream.get_schema(&stream, &schema) != 0 )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "get_schema() failed");
+        stream.release(&stream);
+        return false;
+    }
+
+    if( psOptions->nGroupTransactions )
+    {
+        if( psOptions->nLayerTransaction )
+        {
+            if( poDstLayer->StartTransaction() == OGRERR_FAILURE )
+            {
+                schema.release(&schema);
+                stream.release(&stream);
+                return false;
+            }
+        }
+    }
+
+    GIntBig nCount = 0;
+    GIntBig nFeaturesInTransaction = 0;
+    bool bRet = true;
+    while( true )
+    {
+        struct ArrowArray array;
+        if( stream.get_next(&stream, &array) != 0 )
+        {
+            const char* pszErrMsg = stream.get_last_error(&stream);
+            CPLError(CE_Failure, CPLE_AppDefined, "get_next() failed: %s",
+                     pszErrMsg ? pszErrMsg : "unknown error");
+            bRet = false;
+            break;
+        }
+        if( array.release == nullptr )
+            break;
+
+        const GIntBig nBatchSize = static_cast<GIntBig>(array.length);
+        const bool bWritten = poDstLayer->WriteArrowBatch(&schema, &array,
+                                                          aosWriteOptions.List());
+        if( array.release )
+            array.release(&array);
+        if( !bWritten )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unable to write batch of features from layer %s.",
+                     poSrcLayer->GetName());
+            bRet = false;
+            break;
+        }
+
+        psInfo->m_nFeaturesRead += nBatchSize;
+        nCount += nBatchSize;
+
+        if( psOptions->nLayerTransaction )
+        {
+            nFeaturesInTransaction += nBatchSize;
+            if( psOptions->nGroupTransactions > 0 &&
+                nFeaturesInTransaction >= psOptions->nGroupTransactions )
             {
-                nFeaturesWritten ++;
-                if( nDesiredFID != OGRNullFID  && poDstFeature->GetFID() != nDesiredFID )
+                if( poDstLayer->CommitTransaction() == OGRERR_FAILURE ||
+                    poDstLayer->StartTransaction() == OGRERR_FAILURE )
                 {
-                    CPLError( CE_Warning, CPLE_AppDefined,
-                              "Feature id not preserved");
+                    bRet = false;
+                    break;
                 }
+                nFeaturesInTransaction = 0;
             }
-            else if( !psOptions->bSkipFailures )
+        }
+        else if( psOptions->nGroupTransactions >= 0 )
+        {
+            nTotalEventsDone += nBatchSize;
+            if( nTotalEventsDone >= psOptions->nGroupTransactions )
             {
-                if( psOptions->nGroupTransactions )
+                if( m_poODS->CommitTransaction() == OGRERR_FAILURE ||
+                    m_poODS->StartTransaction(psOptions->bForceTransaction) == OGRERR_FAILURE )
                 {
-                    if( psOptions->nLayerTransaction )
-                        poDstLayer->RollbackTransaction();
+                    bRet = false;
+                    break;
                 }
+                nTotalEventsDone = 0;
+            }
+        }
 
-                CPLError( CE_Failure, CPLE_AppDefined,
-                        "Unable to write feature " CPL_FRMT_GIB " from layer %s.",
-                        nSrcFID, poSrcLayer->GetName() );
+        if( pnReadFeatureCount )
+            *pnReadFeatureCount = nCount;
+
+        if( pfnProgress &&
+            !pfnProgress(nCountLayerFeatures ? nCount * 1.0 / nCountLayerFeatures: 1.0, "", pProgressArg) )
+        {
+            bRet = false;
+            break;
+        }
+    }
+
+    schema.release(&schema);
+    stream.release(&stream);
+
+    if( psOptions->nGroupTransactions )
+    {
+        if( psOptions->nLayerTransaction )
+        {
+            if( poDstLayer->CommitTransaction() != OGRERR_NONE )
+                bRet = false;
+        }
+    }
+
+    CPLDebug("GDALVectorTranslate", CPL_FRMT_GIB " features written in layer '%s'",
+             nCount, poDstLayer->GetName());
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                     LayerTranslator::Translate()                     */
+/************************************************************************/
+
+int LayerTranslator::Translate( OGRFeature* poFeatureIn,
+                                TargetLayerInfo* psInfo,
+                                GIntBig nCountLayerFeatures,
+                                GIntBig* pnReadFeatureCount,
+                                GIntBig& nTotalEventsDone,
+                                GDALProgressFunc pfnProgress,
+                                void *pProgressArg,
+                                GDALVectorTranslateOptions *psOptions )
+{
+    OGRSpatialReference* poOutputSRS = m_poOutputSRS;
+
+    OGRLayer *poSrcLayer = psInfo->m_poSrcLayer;
+    OGRLayer *poDstLayer = psInfo->m_poDstLayer;
+    const bool bPreserveFID = psInfo->m_bPreserveFID;
+    const auto poSrcFDefn = poSrcLayer->GetLayerDefn();
+    const auto poDstFDefn = poDstLayer->GetLayerDefn();
+    const int nSrcGeomFieldCount = poSrcFDefn->GetGeomFieldCount();
+    const int nDstGeomFieldCount = poDstFDefn->GetGeomFieldCount();
+    const bool bExplodeCollections = m_bExplodeCollections && nDstGeomFieldCount <= 1;
+    const int iRequestedSrcGeomField = psInfo->m_iRequestedSrcGeomField;
+    const bool bMultiThreaded = m_nNumThreads > 1 && poFeatureIn == nullptr &&
+                                psOptions->nFIDToFetch == OGRNullFID &&
+                                !bExplodeCollections;
+
+    if( poOutputSRS == nullptr && !m_bNullifyOutputSRS )
+    {
+        if( nSrcGeomFieldCount == 1 )
+        {
+            poOutputSRS = poSrcLayer->GetSpatialRef();
+        }
+        else if( iRequestedSrcGeomField > 0 )
+        {
+            poOutputSRS = poSrcLayer->GetLayerDefn()->GetGeomFieldDefn(
+                iRequestedSrcGeomField)->GetSpatialRef();
+        }
+    }
+
+    if( poFeatureIn == nullptr && CanTranslateArrow(psInfo, psOptions) )
+    {
+        return TranslateArrow(psInfo, nCountLayerFeatures, pnReadFeatureCount,
+                              nTotalEventsDone, pfnProgress, pProgressArg,
+                              psOptions);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Transfer features.                                              */
+/* -------------------------------------------------------------------- */
+    if( psOptions->nGroupTransactions )
+    {
+        if( psOptions->nLayerTransaction )
+        {
+            if( poDstLayer->StartTransaction() == OGRERR_FAILURE )
+            {
+                delete poFeatureIn;
+                return false;
+            }
+        }
+    }
+
+    std::unique_ptr<OGRFeature> poFeature;
+    std::unique_ptr<OGRFeature> poDstFeature(new OGRFeature(poDstFDefn));
+    int         nFeaturesInTransaction = 0;
+    GIntBig      nCount = 0; /* written + failed */
+    GIntBig      nFeaturesWritten = 0;
 
+    bool bRet = true;
+    CPLErrorReset();
+    while( true )
+    {
+        if( m_nLimit >= 0 && psInfo->m_nFeaturesRead >= m_nLimit )
+        {
+            break;
+        }
+
+        if( poFeatureIn != nullptr )
+            poFeature.reset(poFeatureIn);
+        else if( psOptions->nFIDToFetch != OGRNullFID )
+            poFeature.reset(poSrcLayer->GetFeature(psOptions->nFIDToFetch));
+        else
+            poFeature.reset(poSrcLayer->GetNextFeature());
+
+        if( poFeature == nullptr )
+        {
+            if( CPLGetLastErrorType() == CE_Failure )
+            {
+                bRet = false;
+            }
+            break;
+        }
+
+        if( psInfo->m_nFeaturesRead == 0 || psInfo->m_bPerFeatureCT )
+        {
+            if( !SetupCT( psInfo, poSrcLayer, m_bTransform, m_bWrapDateline,
+                          m_osDateLineOffset, m_poUserSourceSRS,
+                          poFeature.get(), poOutputSRS, m_poGCPCoordTrans) )
+            {
                 return false;
             }
+        }
+
+        psInfo->m_nFeaturesRead ++;
+
+        // Once the coordinate transformations are known not to depend on
+        // the features, hand over the rest of the layer to worker threads.
+        if( bMultiThreaded && !psInfo->m_bPerFeatureCT )
+        {
+            if( !TranslateMultiThreaded(std::move(poFeature), psInfo,
+                                        poOutputSRS, nCountLayerFeatures,
+                                        pnReadFeatureCount, nCount,
+                                        nFeaturesWritten,
+                                        nFeaturesInTransaction,
+                                        nTotalEventsDone, pfnProgress,
+                                        pProgressArg, psOptions, bRet) )
+            {
+                return false;
+            }
+            break;
+        }
+
+        int nIters = 1;
+        std::unique_ptr<OGRGeometryCollection> poCollToExplode;
+        int iGeomCollToExplode = -1;
+        if (bExplodeCollections)
+        {
+            OGRGeometry* poSrcGeometry;
+            if( iRequestedSrcGeomField >= 0 )
+                poSrcGeometry = poFeature->GetGeomFieldRef(
+                                        iRequestedSrcGeomField);
             else
+                poSrcGeometry = poFeature->GetGeometryRef();
+            if (poSrcGeometry &&
+                OGR_GT_IsSubClassOf(poSrcGeometry->getGeometryType(), wkbGeometryCollection) )
             {
-                CPLDebug( "GDALVectorTranslate", "Unable to write feature " CPL_FRMT_GIB " into layer %s.",
-                           nSrcFID, poSrcLayer->GetName() );
-                if( psOptions->nGroupTransactions )
+                const int nParts = poSrcGeometry->toGeometryCollection()->getNumGeometries();
+                if( nParts > 0 )
                 {
-                    if( psOptions->nLayerTransaction )
-                    {
-                        poDstLayer->RollbackTransaction();
-                        CPL_IGNORE_RET_VAL(poDstLayer->StartTransaction());
-                    }
-                    else
-                    {
-                        m_poODS->RollbackTransaction();
-                        m_poODS->StartTransaction(psOptions->bForceTransaction);
-                    }
+                    iGeomCollToExplode = iRequestedSrcGeomField >= 0 ?
+                        iRequestedSrcGeomField : 0;
+                    poCollToExplode.reset(
+                        poFeature->StealGeometry(iGeomCollToExplode)->toGeometryCollection());
+                    nIters = nParts;
                 }
             }
+        }
+
+        const GIntBig nSrcFID = poFeature->GetFID();
+        GIntBig nDesiredFID = OGRNullFID;
+        if( bPreserveFID )
+            nDesiredFID = nSrcFID;
+        else if( psInfo->m_iSrcFIDField >= 0 &&
+                 poFeature->IsFieldSetAndNotNull(psInfo->m_iSrcFIDField))
+            nDesiredFID = poFeature->GetFieldAsInteger64(psInfo->m_iSrcFIDField);
 
-end_loop:
-            ; // nothing
+        for(int iPart = 0; iPart < nIters; iPart++)
+        {
+            if( !CommitTransactionIfNeeded(psInfo, nFeaturesInTransaction,
+                                           nTotalEventsDone, psOptions) )
+            {
+                return false;
+            }
+
+            CPLErrorReset();
+            int nReprojectionFailures = 0;
+            const TranslateStatus eStatus = TranslateFeature(
+                poFeature, poDstFeature, psInfo, poDstFDefn,
+                poCollToExplode.get(), iGeomCollToExplode, nDesiredFID,
+                poOutputSRS, psInfo->m_apoCT, m_transformWithOptionsCache,
+                psOptions, nReprojectionFailures);
+            if( !WriteTranslatedFeature(eStatus, nReprojectionFailures,
+                                        poDstFeature.get(), nSrcFID,
+                                        nDesiredFID, psInfo,
+                                        nFeaturesWritten, psOptions) )
+            {
+                return false;
+            }
         }
 
         /* Report progress */
@@ -5376,6 +6057,7 @@ GDALVectorTranslateOptions *GDALVectorTranslateOptionsNew(char** papszArgv,
     psOptions->hSpatialFilter = nullptr;
     psOptions->bNativeData = true;
     psOptions->nLimit = -1;
+    psOptions->nNumThreads = 1;
 
     int nArgc = CSLCount(papszArgv);
     for( int i = 0; papszArgv != nullptr && i < nArgc; i++ )
@@ -6019,6 +6701,12 @@ GDALVectorTranslateOptions *GDALVectorTranslateOptionsNew(char** papszArgv,
         {
             psOptions->nLimit = CPLAtoGIntBig( papszArgv[++i] );
         }
+        else if( i+1 < nArgc && EQUAL(papszArgv[i],"-num_threads") )
+        {
+            CPLStringList aosNumThreads;
+            aosNumThreads.SetNameValue("NUM_THREADS", papszArgv[++i]);
+            psOptions->nNumThreads = GDALGetNumThreads(aosNumThreads.List());
+        }
         else if( papszArgv[i][0] == '-' )
         {
             CPLError(CE_Failure, CPLE_NotSupported,
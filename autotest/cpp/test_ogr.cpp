@@ -32,8 +32,11 @@
 #include "ogrsf_frmts.h"
 #include "../../ogr/ogrsf_frmts/osm/gpb.h"
 #include "ogr_recordbatch.h"
+#include "ogr_wkb.h"
 
+#include <cmath>
 #include <string>
+#include <thread>
 
 namespace tut
 {
@@ -2198,4 +2201,177 @@ namespace tut
         ensure_equals(poClonedCoded->GetMergePolicy(), oCoded.GetMergePolicy());
     }
 
+    // Test OGRWKBGeometryView
+    template<>
+    template<>
+    void object::test<26>()
+    {
+        const auto GetWKB = [](const char* pszWKT)
+        {
+            OGRGeometry* poGeom = nullptr;
+            OGRGeometryFactory::createFromWkt(pszWKT, nullptr, &poGeom);
+            std::vector<GByte> abyWKB(poGeom ? poGeom->WkbSize() : 0);
+            if( poGeom )
+                poGeom->exportToWkb(wkbNDR, abyWKB.data(), wkbVariantIso);
+            delete poGeom;
+            return abyWKB;
+        };
+
+        {
+            const auto abyWKB = GetWKB("POLYGON Z ((0 0 1,0 10 1,10 10 1,10 0 1,0 0 1),"
+                                       "(1 1 1,1 9 1,9 9 1,9 1 1,1 1 1))");
+            OGRWKBGeometryView oView(abyWKB.data(), abyWKB.size());
+            ensure(oView.IsValid());
+            ensure_equals(oView.GetGeometryType(), wkbPolygon25D);
+            ensure(!oView.IsEmpty());
+            ensure(!oView.HasCurve());
+            OGREnvelope sEnvelope;
+            ensure(oView.GetEnvelope(sEnvelope));
+            ensure_equals(sEnvelope.MinX, 0.0);
+            ensure_equals(sEnvelope.MinY, 0.0);
+            ensure_equals(sEnvelope.MaxX, 10.0);
+            ensure_equals(sEnvelope.MaxY, 10.0);
+            int nPoints = 0;
+            ensure(oView.ForEachPoint([&nPoints](double, double) { ++nPoints; return true; }));
+            ensure_equals(nPoints, 10);
+            ensure(oView.ContainsPoint(0.5, 0.5));
+            ensure(!oView.ContainsPoint(5, 5));
+            ensure(!oView.ContainsPoint(15, 5));
+
+            OGREnvelope sFilter;
+            sFilter.MinX = 2;
+            sFilter.MinY = 2;
+            sFilter.MaxX = 3;
+            sFilter.MaxY = 3;
+            ensure(!oView.IntersectsEnvelope(sFilter));
+            sFilter.MinX = -1;
+            ensure(oView.IntersectsEnvelope(sFilter));
+            sFilter.MinX = 0.2;
+            sFilter.MinY = 0.2;
+            sFilter.MaxX = 0.3;
+            sFilter.MaxY = 0.3;
+            ensure(oView.IntersectsEnvelope(sFilter));
+
+            ensure(oView.IsValidISO());
+
+            // Truncated WKB
+            OGRWKBGeometryView oTruncatedView(abyWKB.data(), abyWKB.size() - 1);
+            ensure(oTruncatedView.IsValid());
+            ensure(!oTruncatedView.IsValidISO());
+            ensure(!oTruncatedView.GetEnvelope(sEnvelope));
+
+            // Trailing bytes
+            auto abyWKBTrailing(abyWKB);
+            abyWKBTrailing.push_back(0);
+            OGRWKBGeometryView oTrailingView(abyWKBTrailing.data(),
+                                             abyWKBTrailing.size());
+            ensure(!oTrailingView.IsValidISO());
+
+            // OGC SFSQL 1.2 2.5D type code
+            auto abyWKB25D(abyWKB);
+            uint32_t nType25D = static_cast<uint32_t>(wkbPolygon) | 0x80000000U;
+            CPL_LSBPTR32(&nType25D);
+            memcpy(abyWKB25D.data() + 1, &nType25D, sizeof(nType25D));
+            OGRWKBGeometryView o25DView(abyWKB25D.data(), abyWKB25D.size());
+            ensure(o25DView.IsValid());
+            ensure(!o25DView.IsValidISO());
+        }
+
+        {
+            const auto abyWKB = GetWKB("LINESTRING (0 10,10 0)");
+            OGRWKBGeometryView oView(abyWKB.data(), abyWKB.size());
+            OGREnvelope sFilter;
+            sFilter.MinX = 1;
+            sFilter.MinY = 1;
+            sFilter.MaxX = 2;
+            sFilter.MaxY = 2;
+            ensure(!oView.IntersectsEnvelope(sFilter));
+            ensure(!oView.ContainsPoint(5, 5));
+            sFilter.MaxX = 9;
+            sFilter.MaxY = 9;
+            ensure(oView.IntersectsEnvelope(sFilter));
+        }
+
+        {
+            const auto abyWKB = GetWKB("GEOMETRYCOLLECTION (POINT EMPTY)");
+            OGRWKBGeometryView oView(abyWKB.data(), abyWKB.size());
+            ensure(oView.IsEmpty());
+            OGREnvelope sEnvelope;
+            ensure(oView.GetEnvelope(sEnvelope));
+            ensure(!sEnvelope.IsInit());
+        }
+
+        {
+            const auto abyWKB = GetWKB("CIRCULARSTRING (0 0,1 1,2 0)");
+            OGRWKBGeometryView oView(abyWKB.data(), abyWKB.size());
+            ensure(oView.HasCurve());
+            OGREnvelope sEnvelope;
+            ensure(!oView.GetEnvelope(sEnvelope));
+        }
+    }
+
+
+    // Test OGRGeometryGEOSCache
+    template<>
+    template<>
+    void object::test<27>()
+    {
+        if( !OGRGeometryFactory::haveGEOS() )
+            return;
+
+        OGRGeometry* poGeom = nullptr;
+        OGRGeometryFactory::createFromWkt(
+            "POLYGON ((0 0,0 10,10 10,10 0,0 0))", nullptr, &poGeom);
+        ensure(poGeom != nullptr);
+        OGRGeometry* poOther = nullptr;
+        OGRGeometryFactory::createFromWkt(
+            "POLYGON ((5 5,5 15,15 15,15 5,5 5))", nullptr, &poOther);
+        ensure(poOther != nullptr);
+
+        OGRPoint oInside(5, 5);
+        OGRPoint oOutside(20, 20);
+        {
+            OGRGeometryGEOSCache oCache(poGeom);
+            ensure(poGeom->Intersects(&oInside));
+            ensure(!poGeom->Intersects(&oOutside));
+            ensure(poGeom->Contains(&oInside));
+            ensure_equals(poGeom->Distance(&oOutside), sqrt(200.0));
+
+            OGRGeometry* poInter = poGeom->Intersection(poOther);
+            ensure(poInter != nullptr);
+            ensure_equals(poInter->toPolygon()->get_Area(), 25.0);
+            delete poInter;
+
+            // The cache only applies to the thread that created it.
+            bool bIntersectsFromThread = false;
+            std::thread t([poGeom, &oInside, &bIntersectsFromThread]()
+                { bIntersectsFromThread =
+                      CPL_TO_BOOL(poGeom->Intersects(&oInside)); });
+            t.join();
+            ensure(bIntersectsFromThread);
+
+            // Nested caches on the same and on another geometry.
+            {
+                OGRGeometryGEOSCache oCache2(poGeom);
+                OGRGeometryGEOSCache oCacheOther(poOther);
+                ensure(poGeom->Intersects(poOther));
+                ensure(poOther->Intersects(&oInside));
+            }
+            ensure(poGeom->Intersects(&oInside));
+        }
+
+        // Once the cache is destroyed, modifications are seen.
+        poGeom->toPolygon()->getExteriorRing()->setPoint(2, 1, 1);
+        poGeom->toPolygon()->getExteriorRing()->setPoint(1, 0, 1);
+        poGeom->toPolygon()->getExteriorRing()->setPoint(3, 1, 0);
+        ensure(!poGeom->Intersects(&oInside));
+        {
+            OGRGeometryGEOSCache oCache(poGeom);
+            ensure(!poGeom->Intersects(&oInside));
+        }
+
+        delete poOther;
+        delete poGeom;
+    }
+
 } // namespace tut
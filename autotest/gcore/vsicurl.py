@@ -28,6 +28,8 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import os
+import sys
 import time
 
 import gdaltest
@@ -1093,6 +1095,151 @@ def test_vsicurl_GDAL_HTTP_HEADERS():
     assert statres.size == 3
 
 
+###############################################################################
+# Test the persistent disk cache (CPL_VSIL_CURL_DISK_CACHE_DIR)
+
+
+def test_vsicurl_disk_cache(tmp_path):
+
+    if gdaltest.webserver_port == 0:
+        pytest.skip()
+
+    gdal.VSICurlClearCache()
+
+    path = "/test_vsicurl_disk_cache.bin"
+    filename = "/vsicurl/http://localhost:%d%s" % (gdaltest.webserver_port, path)
+
+    def read():
+        f = gdal.VSIFOpenL(filename, "rb")
+        assert f is not None
+        data = gdal.VSIFReadL(1, 3, f)
+        gdal.VSIFCloseL(f)
+        return data
+
+    def get_stats():
+        md = gdal.GetFileMetadata(filename, "DISK_CACHE_STATS")
+        return {k: int(v) for k, v in md.items()}
+
+    with gdaltest.config_options(
+        {
+            "CPL_VSIL_CURL_DISK_CACHE_DIR": str(tmp_path),
+            "GDAL_DISABLE_READDIR_ON_OPEN": "EMPTY_DIR",
+        }
+    ):
+        stats_before = get_stats()
+
+        handler = webserver.SequentialHandler()
+        handler.add("HEAD", path, 200, {"Content-Length": "3", "ETag": '"first"'})
+        handler.add(
+            "GET",
+            path,
+            206,
+            {"Content-Length": "3", "Content-Range": "bytes 0-2/3"},
+            "foo",
+            expected_headers={"Range": "bytes=0-16383"},
+        )
+        with webserver.install_http_handler(handler):
+            assert read() == b"foo"
+        assert get_stats()["WRITES"] == stats_before["WRITES"] + 1
+
+        # Simulate a new process: the content is got from the disk cache
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add("HEAD", path, 200, {"Content-Length": "3", "ETag": '"first"'})
+        with webserver.install_http_handler(handler):
+            assert read() == b"foo"
+        assert get_stats()["HITS"] == stats_before["HITS"] + 1
+
+        # A modified remote file must not use the cached content
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add("HEAD", path, 200, {"Content-Length": "3", "ETag": '"second"'})
+        handler.add(
+            "GET",
+            path,
+            206,
+            {"Content-Length": "3", "Content-Range": "bytes 0-2/3"},
+            "bar",
+            expected_headers={"Range": "bytes=0-16383"},
+        )
+        with webserver.install_http_handler(handler):
+            assert read() == b"bar"
+
+        # Size-bounded eviction
+        gdal.VSICurlClearCache()
+        with gdaltest.config_option("CPL_VSIL_CURL_DISK_CACHE_SIZE", "1"):
+            handler = webserver.SequentialHandler()
+            handler.add(
+                "HEAD", path, 200, {"Content-Length": "3", "ETag": '"third"'}
+            )
+            handler.add(
+                "GET",
+                path,
+                206,
+                {"Content-Length": "3", "Content-Range": "bytes 0-2/3"},
+                "baz",
+                expected_headers={"Range": "bytes=0-16383"},
+            )
+            with webserver.install_http_handler(handler):
+                assert read() == b"baz"
+        assert get_stats()["EVICTIONS"] > stats_before["EVICTIONS"]
+
+        # Credentials in the query string are not part of the key, and are
+        # not stored in the cache files
+        def read_signed(sig):
+            f = gdal.VSIFOpenL(
+                "/vsicurl/http://localhost:%d%s?foo=bar&sig=%s"
+                % (gdaltest.webserver_port, path, sig),
+                "rb",
+            )
+            assert f is not None
+            data = gdal.VSIFReadL(1, 3, f)
+            gdal.VSIFCloseL(f)
+            return data
+
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            path + "?foo=bar&sig=secret1",
+            200,
+            {"Content-Length": "3", "ETag": '"fourth"'},
+        )
+        handler.add(
+            "GET",
+            path + "?foo=bar&sig=secret1",
+            206,
+            {"Content-Length": "3", "Content-Range": "bytes 0-2/3"},
+            "qux",
+            expected_headers={"Range": "bytes=0-16383"},
+        )
+        with webserver.install_http_handler(handler):
+            assert read_signed("secret1") == b"qux"
+
+        gdal.VSICurlClearCache()
+        handler = webserver.SequentialHandler()
+        handler.add(
+            "HEAD",
+            path + "?foo=bar&sig=secret2",
+            200,
+            {"Content-Length": "3", "ETag": '"fourth"'},
+        )
+        with webserver.install_http_handler(handler):
+            assert read_signed("secret2") == b"qux"
+
+        for dirpath, _, filenames in os.walk(str(tmp_path)):
+            for name in filenames:
+                with open(os.path.join(dirpath, name), "rb") as f:
+                    content = f.read()
+                assert b"secret" not in content
+                assert b"localhost" not in content
+                if sys.platform != "win32":
+                    mode = os.stat(os.path.join(dirpath, name)).st_mode
+                    assert (mode & 0o077) == 0
+
+    gdal.VSICurlClearCache()
+
+
 ###############################################################################
 
 
@@ -2750,3 +2750,215 @@ def test_ogr_csv_iter_and_set_feature():
     gdal.Unlink("/vsimem/ogr_csv_iter_and_set_feature.csv")
 
     assert count == 2
+
+
+###############################################################################
+# Test multi-threaded reading
+
+
+@pytest.mark.parametrize("eol", ["\n", "\r\n", "\r"])
+def test_ogr_csv_num_threads(eol):
+
+    filename = "/vsimem/test_ogr_csv_num_threads.csv"
+    lines = ['id,str,"WKT",real,int']
+    for i in range(1000):
+        if i % 7 == 0:
+            lines.append("")
+        if i % 5 == 0:
+            # Quoted value over several lines
+            str_val = '"multi%sline ""%d"", with comma"' % (eol, i)
+        else:
+            str_val = "val%d" % i
+        lines.append(
+            '%d,%s,"POINT (%d %d)",%s,%s'
+            % (
+                i,
+                str_val,
+                i,
+                -i,
+                "%d.5" % i if i != 500 else "bad",
+                "" if i % 3 == 0 else str(i),
+            )
+        )
+    gdal.FileFromMemBuffer(filename, eol.join(lines))
+
+    def read(open_options):
+        ds = gdal.OpenEx(
+            filename,
+            open_options=["AUTODETECT_TYPE=YES", "AUTODETECT_SIZE_LIMIT=100"]
+            + open_options,
+        )
+        lyr = ds.GetLayer(0)
+        gdal.ErrorReset()
+        with gdaltest.error_handler():
+            features = [f.ExportToJson() for f in lyr]
+        msg = gdal.GetLastErrorMsg()
+        with gdaltest.error_handler():
+            lyr.SetAttributeFilter("id >= 995")
+            filtered = [f.GetFID() for f in lyr]
+            lyr.SetAttributeFilter(None)
+            random = lyr.GetFeature(999).ExportToJson()
+            after_random = lyr.GetNextFeature().ExportToJson()
+        return features, msg, filtered, random, after_random
+
+    try:
+        expected = read([])
+        assert len(expected[0]) == 1000
+        assert "record 501" in expected[1]
+        with gdaltest.config_option("OGR_CSV_CHUNK_SIZE", "100"):
+            assert read(["NUM_THREADS=4"]) == expected
+        assert read(["NUM_THREADS=ALL_CPUS"]) == expected
+    finally:
+        gdal.Unlink(filename)
+
+
+###############################################################################
+# Test multi-threaded reading of a file with a too long record in a middle
+# chunk: reading must stop before it, as in single-threaded mode
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_ogr_csv_num_threads_error_in_middle_chunk(num_threads):
+
+    filename = "/vsimem/test_ogr_csv_num_threads_error_in_middle_chunk.csv"
+    lines = ["id,str"]
+    for i in range(300):
+        lines.append("%d,%s" % (i, "x" * 200 if i == 150 else "val%d" % i))
+    gdal.FileFromMemBuffer(filename, "\n".join(lines) + "\n")
+
+    try:
+        with gdaltest.config_option("OGR_CSV_CHUNK_SIZE", "256"):
+            # Repeat to give a chance to timing dependent issues to show up
+            for _ in range(10):
+                ds = gdal.OpenEx(
+                    filename,
+                    open_options=["MAX_LINE_SIZE=100", "NUM_THREADS=" + num_threads],
+                )
+                lyr = ds.GetLayer(0)
+                gdal.ErrorReset()
+                with gdaltest.error_handler():
+                    ids = [f["id"] for f in lyr]
+                assert "Maximum number of characters" in gdal.GetLastErrorMsg()
+                assert ids == [str(i) for i in range(150)]
+                ds = None
+    finally:
+        gdal.Unlink(filename)
+
+
+###############################################################################
+# Test that the GDAL_NUM_THREADS configuration option is used when the
+# NUM_THREADS open option is not set
+
+
+@pytest.mark.parametrize(
+    "open_options,gdal_num_threads,expected_threads",
+    [
+        ([], None, 1),
+        ([], "3", 3),
+        ([], "ALL_CPUS", None),
+        (["NUM_THREADS=2"], "3", 2),
+        (["NUM_THREADS=1"], "ALL_CPUS", 1),
+    ],
+)
+def test_ogr_csv_num_threads_gdal_num_threads(
+    open_options, gdal_num_threads, expected_threads
+):
+
+    if expected_threads is None:
+        expected_threads = min(gdal.GetNumCPUs(), 128)
+
+    filename = "/vsimem/test_ogr_csv_num_threads_gdal_num_threads.csv"
+    lines = ["id,name"]
+    for i in range(200):
+        lines.append('%d,"name %d\nsecond line, ""quoted"""' % (i, i))
+    gdal.FileFromMemBuffer(filename, "\n".join(lines) + "\n")
+
+    debug_msgs = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    try:
+        gdal.PushErrorHandler(handler)
+        try:
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            with gdaltest.config_options(
+                {
+                    "CPL_DEBUG": "ON",
+                    "GDAL_NUM_THREADS": gdal_num_threads,
+                    "OGR_CSV_CHUNK_SIZE": "64",
+                }
+            ):
+                ds = gdal.OpenEx(filename, open_options=open_options)
+                lyr = ds.GetLayer(0)
+                names = [f["name"] for f in lyr]
+                ds = None
+        finally:
+            gdal.PopErrorHandler()
+
+        assert names == ['name %d\nsecond line, "quoted"' % i for i in range(200)]
+        thread_msgs = [x for x in debug_msgs if "threads to read" in x]
+        if expected_threads > 1:
+            assert thread_msgs == [
+                "CSV: Using %d threads to read %s" % (expected_threads, filename)
+            ]
+        else:
+            assert not thread_msgs
+    finally:
+        gdal.Unlink(filename)
+
+
+###############################################################################
+# Test the OFFSET_INDEX open option
+
+
+def test_ogr_csv_offset_index():
+
+    filename = "/vsimem/test_ogr_csv_offset_index.csv"
+    lines = ["id,str"]
+    for i in range(1, 2501):
+        if i % 100 == 0:
+            lines.append("")
+        lines.append('%d,"line%d%s"' % (i, i, "\nsecond line" if i % 3 == 0 else ""))
+    gdal.FileFromMemBuffer(filename, "\n".join(lines) + "\n")
+
+    try:
+        ds = gdal.OpenEx(filename, open_options=["OFFSET_INDEX=YES"])
+        lyr = ds.GetLayer(0)
+        assert lyr.TestCapability(ogr.OLCFastFeatureCount) == 0
+        assert lyr.GetFeatureCount() == 2500
+        assert lyr.TestCapability(ogr.OLCFastFeatureCount) == 1
+        ds = None
+        assert gdal.VSIStatL(filename + ".fidx") is not None
+
+        ds = gdal.OpenEx(filename, open_options=["OFFSET_INDEX=YES"])
+        lyr = ds.GetLayer(0)
+        assert lyr.TestCapability(ogr.OLCFastFeatureCount) == 1
+        assert lyr.TestCapability(ogr.OLCFastSetNextByIndex) == 1
+        assert lyr.GetFeatureCount() == 2500
+        for fid in (2345, 1, 1001, 1000, 2500, 999):
+            f = lyr.GetFeature(fid)
+            assert f.GetFID() == fid
+            assert f["id"] == str(fid)
+        assert lyr.GetFeature(2501) is None
+        assert lyr.SetNextByIndex(1999) == ogr.OGRERR_NONE
+        f = lyr.GetNextFeature()
+        assert f.GetFID() == 2000
+        assert f["str"] == "line2000"
+        f = lyr.GetNextFeature()
+        assert f.GetFID() == 2001
+        assert lyr.SetNextByIndex(2500) != ogr.OGRERR_NONE
+        ds = None
+
+        # Index not matching the file anymore
+        gdal.FileFromMemBuffer(filename, "\n".join(lines[0:11]) + "\n")
+        ds = gdal.OpenEx(filename, open_options=["OFFSET_INDEX=YES"])
+        lyr = ds.GetLayer(0)
+        assert lyr.TestCapability(ogr.OLCFastFeatureCount) == 0
+        assert lyr.GetFeature(9)["id"] == "9"
+        assert lyr.GetFeatureCount() == 10
+        ds = None
+    finally:
+        gdal.Unlink(filename)
+        gdal.Unlink(filename + ".fidx")
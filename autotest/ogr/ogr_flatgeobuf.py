@@ -1133,3 +1133,126 @@ def test_ogr_flatgeobuf_arrow_stream_numpy():
     ds = None
 
     ogr.GetDriverByName("FlatGeobuf").DeleteDataSource("/vsimem/test.fgb")
+
+
+###############################################################################
+# Test that reading through a memory mapping of the file gives the same
+# results as reading with VSIFReadL()
+
+
+@pytest.mark.parametrize(
+    "filename", ["/vsimem/test_mmap.fgb", "tmp/test_ogr_flatgeobuf_mmap.fgb"]
+)
+def test_ogr_flatgeobuf_mmap(filename):
+
+    ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbLineString)
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    for i in range(1000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetField("str", "x" * (i % 7))
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                "LINESTRING (%d %d,%d %d)" % (i % 30, i // 30, i % 30 + 1, i // 30)
+            )
+        )
+        lyr.CreateFeature(f)
+    ds = None
+
+    def read(use_mmap):
+        with gdaltest.config_option("OGR_FLATGEOBUF_USE_MMAP", use_mmap):
+            ds = ogr.Open(filename)
+            lyr = ds.GetLayer(0)
+            res = [f.ExportToJson() for f in lyr]
+            lyr.SetSpatialFilterRect(10.5, 10.5, 12.5, 12.5)
+            res += [f.ExportToJson() for f in lyr]
+            lyr.SetSpatialFilter(None)
+            res.append(lyr.GetFeature(567).ExportToJson())
+            stream = lyr.GetArrowStreamAsNumPy()
+            for batch in stream:
+                res += [bytes(x) for x in batch["wkb_geometry"]]
+                res += list(batch["str"])
+            return res
+
+    try:
+        assert read("YES") == read("NO")
+    finally:
+        ogr.GetDriverByName("FlatGeobuf").DeleteDataSource(filename)
+
+
+###############################################################################
+# Test reading a truncated file through a memory mapping
+
+
+def test_ogr_flatgeobuf_mmap_truncated():
+
+    filename = "/vsimem/test_mmap_truncated.fgb"
+    ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint, options=["SPATIAL_INDEX=NO"])
+    for i in range(10):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d 0)" % i))
+        lyr.CreateFeature(f)
+    ds = None
+
+    fp = gdal.VSIFOpenL(filename, "rb+")
+    gdal.VSIFSeekL(fp, 0, 2)
+    gdal.VSIFTruncateL(fp, gdal.VSIFTellL(fp) - 10)
+    gdal.VSIFCloseL(fp)
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    with gdaltest.error_handler():
+        count = len([f for f in lyr])
+    assert count == 9
+    ds = None
+
+    gdal.Unlink(filename)
+
+
+###############################################################################
+# Test that sorting spatial index items by runs, under a small memory budget,
+# gives the same file as sorting them in memory
+
+
+def test_ogr_flatgeobuf_spatial_index_external_sort():
+    def create(filename):
+        ds = ogr.GetDriverByName("FlatGeobuf").CreateDataSource(filename)
+        lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+        lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+        for i in range(1000):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f.SetField("id", i)
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt("POINT (%d %d)" % ((i * 7) % 97, i % 89))
+            )
+            lyr.CreateFeature(f)
+        ds = None
+
+        f = gdal.VSIFOpenL(filename, "rb")
+        data = gdal.VSIFReadL(1, 1000000, f)
+        gdal.VSIFCloseL(f)
+        return data
+
+    try:
+        ref = create("/vsimem/test_external_sort_ref.fgb")
+        with gdaltest.config_options(
+            {"OGR_FLATGEOBUF_SORT_MAX_MEMORY": "10000", "GDAL_NUM_THREADS": "2"}
+        ):
+            got = create("/vsimem/test_external_sort.fgb")
+        assert got == ref
+
+        ds = ogr.Open("/vsimem/test_external_sort.fgb")
+        lyr = ds.GetLayer(0)
+        assert lyr.GetFeatureCount() == 1000
+        lyr.SetSpatialFilterRect(10.5, 10.5, 12.5, 12.5)
+        ids = sorted(f["id"] for f in lyr)
+        assert ids == sorted(
+            i
+            for i in range(1000)
+            if 10.5 <= (i * 7) % 97 <= 12.5 and 10.5 <= i % 89 <= 12.5
+        )
+        ds = None
+    finally:
+        gdal.Unlink("/vsimem/test_external_sort_ref.fgb")
+        gdal.Unlink("/vsimem/test_external_sort.fgb")
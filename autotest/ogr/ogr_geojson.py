@@ -4115,3 +4115,58 @@ def test_ogr_geojson_read_from_http():
         assert lyr.GetFeatureCount() == 1
     finally:
         webserver.server_stop(webserver_process, webserver_port)
+
+
+###############################################################################
+# Test that translating "properties" directly from the streaming parser
+# gives the same result as going through json-c objects
+
+
+@pytest.mark.parametrize(
+    "open_options",
+    [
+        [],
+        ["FLATTEN_NESTED_ATTRIBUTES=YES"],
+        ["NATIVE_DATA=YES"],
+        ["ATTRIBUTES_SKIP=YES"],
+    ],
+)
+def test_ogr_geojson_direct_properties(open_options):
+
+    filename = "/vsimem/test_ogr_geojson_direct_properties.json"
+    gdal.FileFromMemBuffer(
+        filename,
+        """{"type": "FeatureCollection", "features": [
+{"type": "Feature", "id": 1, "properties": {"int": 1, "int64": 1234567890123,
+  "real": 1.5, "str": "foo", "bool": true, "null": null,
+  "intlist": [1, 2], "strlist": ["a", "b"], "obj": {"a": 1, "b": {"c": "d"}},
+  "mixed": 1, "date": "2022-12-31"}, "geometry": {"type": "Point", "coordinates": [1, 2]}},
+{"type": "Feature", "id": 2, "geometry": null, "properties": {"str": 3, "int": 2.5,
+  "real": 2, "mixed": "bar", "int64": "12", "bool": false, "intlist": 3,
+  "unknown_in_first_features": 1, "obj": null}},
+{"type": "Feature", "properties": {"date": null, "str": "x", "int": 4,
+  "properties": {"nested": "properties"}}, "geometry": {"type": "Point", "coordinates": [3, 4]}},
+{"type": "Feature", "properties": null, "geometry": null},
+{"type": "Feature", "geometry": null}
+]}""",
+    )
+
+    def get_features():
+        ds = gdal.OpenEx(filename, open_options=open_options)
+        lyr = ds.GetLayer(0)
+        ret = [f.DumpReadableAsString() for f in lyr]
+        return ret
+
+    try:
+        with gdaltest.config_option("OGR_GEOJSON_MAX_FEATURES_FIRST_PASS", "1"):
+            with gdaltest.config_option("OGR_GEOJSON_DIRECT_PROPERTIES", "NO"):
+                ref = get_features()
+            got = get_features()
+        assert got == ref
+        with gdaltest.config_option("OGR_GEOJSON_DIRECT_PROPERTIES", "NO"):
+            ref = get_features()
+        got = get_features()
+        assert got == ref
+        assert len(got) == 5
+    finally:
+        gdal.Unlink(filename)
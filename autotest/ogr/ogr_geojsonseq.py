@@ -365,3 +365,127 @@ def test_ogr_geojsonseq_vsistdout():
     ds = None
 
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test multi-threaded reading
+
+
+@pytest.mark.parametrize("rs", [False, True])
+def test_ogr_geojsonseq_num_threads(rs):
+
+    filename = "/vsimem/test_ogr_geojsonseq_num_threads.geojsonl"
+    records = []
+    for i in range(1000):
+        if i % 7 == 0:
+            records.append("")
+        if i == 500:
+            records.append("invalid")
+        elif i % 11 == 0:
+            records.append('{"type":"Point","coordinates":[%d,%d]}' % (i, -i))
+        elif i % 13 == 0:
+            records.append('{"type":"Feature","id":%d,"properties":null}' % (i + 10000))
+        else:
+            records.append(
+                '{"type":"Feature","properties":{"id":%d,"str":"val%d"%s},'
+                '"geometry":{"type":"Point","coordinates":[%d,%d]}}'
+                % (i, i, ',"real":%d.5' % i if i > 900 else "", i, -i)
+            )
+    if rs:
+        content = "".join("\x1e" + r + "\n" for r in records)
+    else:
+        content = "\n".join(records)
+    gdal.FileFromMemBuffer(filename, content)
+
+    def read(open_options):
+        ds = gdal.OpenEx(filename, open_options=open_options)
+        lyr = ds.GetLayer(0)
+        schema = [
+            (fd.GetName(), fd.GetType())
+            for fd in [
+                lyr.GetLayerDefn().GetFieldDefn(i)
+                for i in range(lyr.GetLayerDefn().GetFieldCount())
+            ]
+        ]
+        with gdaltest.error_handler():
+            count = lyr.GetFeatureCount()
+            features = [f.ExportToJson() for f in lyr]
+            lyr.SetAttributeFilter("id >= 995")
+            filtered = [f.GetFID() for f in lyr]
+            lyr.SetAttributeFilter(None)
+            lyr.ResetReading()
+            first = lyr.GetNextFeature().ExportToJson()
+        return schema, count, features, filtered, first
+
+    try:
+        expected = read([])
+        assert len(expected[2]) == 999
+        assert ("real", ogr.OFTReal) in expected[0]
+        with gdaltest.config_option("OGR_GEOJSONSEQ_THREAD_CHUNK_SIZE", "100"):
+            assert read(["NUM_THREADS=4"]) == expected
+        assert read(["NUM_THREADS=ALL_CPUS"]) == expected
+    finally:
+        gdal.Unlink(filename)
+
+
+###############################################################################
+# Test that GDAL_NUM_THREADS is used, when NUM_THREADS is not set, for the
+# scan that establishes the layer definition, and ignored in update mode
+
+
+def test_ogr_geojsonseq_num_threads_gdal_num_threads():
+
+    filename = "/vsimem/test_ogr_geojsonseq_num_threads_gdal_num_threads.geojsonl"
+    records = [
+        '{"type":"Feature","properties":{"id":%d},"geometry":null}' % i
+        for i in range(100)
+    ]
+    # Only the last record has this field, and it is in the last chunk
+    records.append(
+        '{"type":"Feature","properties":{"id":100,"last":"yes"},"geometry":null}'
+    )
+    gdal.FileFromMemBuffer(filename, "\n".join(records) + "\n")
+
+    def open_and_read(access):
+        debug_msgs = []
+
+        def handler(eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                debug_msgs.append(msg)
+
+        gdal.PushErrorHandler(handler)
+        try:
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            with gdaltest.config_options(
+                {
+                    "CPL_DEBUG": "ON",
+                    "GDAL_NUM_THREADS": "3",
+                    "OGR_GEOJSONSEQ_THREAD_CHUNK_SIZE": "200",
+                }
+            ):
+                ds = gdal.OpenEx(filename, gdal.OF_VECTOR | access)
+                lyr = ds.GetLayer(0)
+                field_names = [
+                    lyr.GetLayerDefn().GetFieldDefn(i).GetName()
+                    for i in range(lyr.GetLayerDefn().GetFieldCount())
+                ]
+                values = [
+                    (f["id"], f["last"] if "last" in field_names else None)
+                    for f in lyr
+                ]
+                ds = None
+        finally:
+            gdal.PopErrorHandler()
+        thread_msgs = [x for x in debug_msgs if "threads to read" in x]
+        return thread_msgs, field_names, values
+
+    try:
+        thread_msgs, field_names, values = open_and_read(gdal.OF_READONLY)
+        assert thread_msgs == ["GeoJSONSeq: Using 3 threads to read %s" % filename]
+        assert field_names == ["id", "last"]
+        assert values == [(i, None) for i in range(100)] + [(100, "yes")]
+
+        thread_msgs, _, _ = open_and_read(gdal.OF_UPDATE)
+        assert not thread_msgs
+    finally:
+        gdal.Unlink(filename)
@@ -4492,3 +4492,127 @@ def test_ogr_gml_read_feature_with_gml_description():
     assert f["identifier"] == "gml_identifier"
     assert f["name"] == "gml_name"
     assert f["bar"] == 1
+
+
+###############################################################################
+# Test the NUM_THREADS open option
+
+
+def test_ogr_gml_read_num_threads():
+
+    if not gdaltest.have_gml_reader:
+        pytest.skip()
+
+    filename = "/vsimem/test_ogr_gml_read_num_threads.gml"
+    content = """<?xml version="1.0" encoding="UTF-8"?>
+<ogr:FeatureCollection xmlns:ogr="http://ogr.maptools.org/"
+                       xmlns:gml="http://www.opengis.net/gml">
+"""
+    for i in range(500):
+        content += '<gml:featureMember><ogr:test fid="test.%d">' % i
+        if i % 7 != 0:
+            content += (
+                "<ogr:geometryProperty><gml:LineString "
+                'srsName="EPSG:32631"><gml:coordinates>'
+                "%d,%d %d,%d</gml:coordinates></gml:LineString>"
+                "</ogr:geometryProperty>" % (i, i, i + 1, i + 2)
+            )
+        content += "<ogr:id>%d</ogr:id><ogr:str>val%d</ogr:str>" % (i, i)
+        content += "</ogr:test></gml:featureMember>\n"
+    content += "</ogr:FeatureCollection>\n"
+    gdal.FileFromMemBuffer(filename, content)
+
+    def read(open_options):
+        ds = gdal.OpenEx(filename, open_options=["WRITE_GFS=NO"] + open_options)
+        lyr = ds.GetLayer(0)
+        features = [f.ExportToJson() for f in lyr]
+        lyr.SetSpatialFilterRect(100, 100, 200, 200)
+        lyr.SetAttributeFilter("id >= 150")
+        filtered = [f.GetFID() for f in lyr]
+        lyr.SetSpatialFilter(None)
+        lyr.SetAttributeFilter(None)
+        lyr.ResetReading()
+        first = lyr.GetNextFeature().ExportToJson()
+        count = lyr.GetFeatureCount()
+        return features, filtered, first, count
+
+    try:
+        ref = read([])
+        assert len(ref[0]) == 500
+        assert ref[1][0:3] == [150, 151, 152]
+        assert ref[3] == 500
+        with gdaltest.config_option("OGR_GML_THREAD_CHUNK_SIZE", "3"):
+            assert read(["NUM_THREADS=4"]) == ref
+        assert read(["NUM_THREADS=ALL_CPUS"]) == ref
+    finally:
+        gdal.Unlink(filename)
+
+
+###############################################################################
+# Test that GDAL_NUM_THREADS is used when NUM_THREADS is not set, with
+# features of two layers interleaved in the document
+
+
+def test_ogr_gml_read_num_threads_gdal_num_threads_two_layers():
+
+    if not gdaltest.have_gml_reader:
+        pytest.skip()
+
+    filename = "/vsimem/test_ogr_gml_read_num_threads_gdal_num_threads.gml"
+    content = """<?xml version="1.0" encoding="UTF-8"?>
+<ogr:FeatureCollection xmlns:ogr="http://ogr.maptools.org/"
+                       xmlns:gml="http://www.opengis.net/gml">
+"""
+    for i in range(100):
+        content += (
+            '<gml:featureMember><ogr:a fid="a.%d"><ogr:geometryProperty>'
+            "<gml:Point><gml:coordinates>%d,%d</gml:coordinates></gml:Point>"
+            "</ogr:geometryProperty><ogr:id>%d</ogr:id></ogr:a>"
+            "</gml:featureMember>\n" % (i, i, -i, i)
+        )
+        if i % 3 == 0:
+            content += (
+                '<gml:featureMember><ogr:b fid="b.%d"><ogr:name>b%d</ogr:name>'
+                "</ogr:b></gml:featureMember>\n" % (i, i)
+            )
+    content += "</ogr:FeatureCollection>\n"
+    gdal.FileFromMemBuffer(filename, content)
+
+    def read(gdal_num_threads):
+        debug_msgs = []
+
+        def handler(eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                debug_msgs.append(msg)
+
+        gdal.PushErrorHandler(handler)
+        try:
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            with gdaltest.config_options(
+                {
+                    "CPL_DEBUG": "ON",
+                    "GDAL_NUM_THREADS": gdal_num_threads,
+                    "OGR_GML_THREAD_CHUNK_SIZE": "4",
+                }
+            ):
+                ds = gdal.OpenEx(filename, open_options=["WRITE_GFS=NO"])
+                layers = [
+                    [f.ExportToJson() for f in ds.GetLayer(i)]
+                    for i in range(ds.GetLayerCount())
+                ]
+                ds = None
+        finally:
+            gdal.PopErrorHandler()
+        thread_msgs = [x for x in debug_msgs if "threads to read" in x]
+        return thread_msgs, layers
+
+    try:
+        thread_msgs, ref = read(None)
+        assert not thread_msgs
+        assert [len(features) for features in ref] == [100, 34]
+
+        thread_msgs, layers = read("3")
+        assert thread_msgs == ["GML: Using 3 threads to read %s" % filename]
+        assert layers == ref
+    finally:
+        gdal.Unlink(filename)
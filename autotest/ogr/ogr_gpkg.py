@@ -6956,6 +6956,107 @@ def test_ogr_gpkg_arrow_stream_numpy():
     ogr.GetDriverByName("GPKG").DeleteDataSource("/vsimem/test.gpkg")
 
 
+###############################################################################
+# Test GetArrowStream() filling batches from several worker threads
+
+
+@pytest.mark.parametrize("num_threads", ["1", "2", "4"])
+def test_ogr_gpkg_arrow_stream_multithreaded(num_threads):
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    filename = "/vsimem/test_ogr_gpkg_arrow_stream_multithreaded.gpkg"
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.StartTransaction()
+    for i in range(1000):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["str"] = "foo%d" % i
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i, i)))
+        lyr.CreateFeature(f)
+    lyr.CommitTransaction()
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    with gdaltest.config_option("GDAL_NUM_THREADS", num_threads):
+        for i in range(2):
+            stream = lyr.GetArrowStreamAsNumPy(options=["MAX_FEATURES_IN_BATCH=7"])
+            fids = []
+            for batch in stream:
+                assert len(batch["fid"]) <= 7
+                for fid, str_val in zip(batch["fid"], batch["str"]):
+                    assert str_val == b"foo%d" % (fid - 1)
+                fids += list(batch["fid"])
+            assert fids == list(range(1, 1001))
+
+        # Interrupt the stream while workers are running
+        stream = lyr.GetArrowStreamAsNumPy(options=["MAX_FEATURES_IN_BATCH=7"])
+        batch = stream.GetNextRecordBatch()
+        assert list(batch["fid"]) == list(range(1, 8))
+        batch = stream.GetNextRecordBatch()
+        assert list(batch["fid"]) == list(range(8, 15))
+        stream = None
+        lyr.ResetReading()
+        stream = lyr.GetArrowStreamAsNumPy(options=["MAX_FEATURES_IN_BATCH=7"])
+        batch = stream.GetNextRecordBatch()
+        assert list(batch["fid"]) == list(range(1, 8))
+        stream = None
+    ds = None
+
+    gdal.Unlink(filename)
+
+
+###############################################################################
+# Test that a rectangular spatial filter is evaluated on the actual geometry,
+# and not only its bounding box, by GetNextFeature() and GetArrowStream()
+
+
+def test_ogr_gpkg_arrow_stream_spatial_filter_refined():
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    filename = "/vsimem/test_ogr_gpkg_arrow_stream_spatial_filter_refined.gpkg"
+    ds = ogr.GetDriverByName("GPKG").CreateDataSource(filename)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbUnknown)
+    for wkt in [
+        # bbox intersects the filter, but not the geometry
+        "LINESTRING (0 10,10 0)",
+        # segment crossing the filter, without vertex inside it
+        "LINESTRING (0 2.5,10 2.5)",
+        # filter in the hole of the polygon
+        "POLYGON ((0 0,0 10,10 10,10 0,0 0),(1 1,1 9,9 9,9 1,1 1))",
+        # filter completely inside the polygon
+        "MULTIPOLYGON (((-10 -10,-10 20,20 20,20 -10,-10 -10)))",
+        "POINT (5 5)",
+    ]:
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+    ds = None
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    lyr.SetSpatialFilterRect(2, 2, 3, 3)
+
+    assert [f.GetFID() for f in lyr] == [2, 4]
+
+    for i in range(2):
+        with gdaltest.config_options(
+            {"OGR_GPKG_STREAM_BASE_IMPL": "YES"} if i == 1 else {}
+        ):
+            stream = lyr.GetArrowStreamAsNumPy()
+            fids = []
+            for batch in stream:
+                fids += list(batch["fid"])
+            assert fids == [2, 4], i
+
+    ds = None
+
+    ogr.GetDriverByName("GPKG").DeleteDataSource(filename)
+
+
 ###############################################################################
 # Test opening a file in WAL mode on a read-only storage
 
@@ -7262,7 +7363,12 @@ def test_ogr_gpkg_background_rtree_build(filename):
 
     # Batch insertion only
     ds = gdaltest.gpkg_dr.CreateDataSource(filename)
-    with gdaltest.config_option("OGR_GPKG_THREADED_RTREE_AT_FIRST_FEATURE", "YES"):
+    with gdaltest.config_options(
+        {
+            "OGR_GPKG_PACKED_RTREE": "NO",
+            "OGR_GPKG_THREADED_RTREE_AT_FIRST_FEATURE": "YES",
+        }
+    ):
         lyr = ds.CreateLayer("foo")
     for i in range(1000):
         f = ogr.Feature(lyr.GetLayerDefn())
@@ -7281,7 +7387,12 @@ def test_ogr_gpkg_background_rtree_build(filename):
 
     # Test SetFeature() after batch insertion
     ds = gdaltest.gpkg_dr.CreateDataSource(filename)
-    with gdaltest.config_option("OGR_GPKG_THREADED_RTREE_AT_FIRST_FEATURE", "YES"):
+    with gdaltest.config_options(
+        {
+            "OGR_GPKG_PACKED_RTREE": "NO",
+            "OGR_GPKG_THREADED_RTREE_AT_FIRST_FEATURE": "YES",
+        }
+    ):
         lyr = ds.CreateLayer("footoooooooooooooooooooooooooooooooooooooooooolong")
     f = ogr.Feature(lyr.GetLayerDefn())
     f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT(0 0)"))
@@ -7305,7 +7416,12 @@ def test_ogr_gpkg_background_rtree_build(filename):
 
     # Test DeleteFeature() after batch insertion
     ds = gdaltest.gpkg_dr.CreateDataSource(filename)
-    with gdaltest.config_option("OGR_GPKG_THREADED_RTREE_AT_FIRST_FEATURE", "YES"):
+    with gdaltest.config_options(
+        {
+            "OGR_GPKG_PACKED_RTREE": "NO",
+            "OGR_GPKG_THREADED_RTREE_AT_FIRST_FEATURE": "YES",
+        }
+    ):
         lyr = ds.CreateLayer("foo with space")
     f = ogr.Feature(lyr.GetLayerDefn())
     f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT(0 0)"))
@@ -7322,7 +7438,12 @@ def test_ogr_gpkg_background_rtree_build(filename):
 
     # Test RollbackTransaction() after batch insertion
     ds = gdaltest.gpkg_dr.CreateDataSource(filename)
-    with gdaltest.config_option("OGR_GPKG_THREADED_RTREE_AT_FIRST_FEATURE", "YES"):
+    with gdaltest.config_options(
+        {
+            "OGR_GPKG_PACKED_RTREE": "NO",
+            "OGR_GPKG_THREADED_RTREE_AT_FIRST_FEATURE": "YES",
+        }
+    ):
         lyr = ds.CreateLayer("foo")
     f = ogr.Feature(lyr.GetLayerDefn())
     f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT(0 0)"))
@@ -7480,3 +7601,131 @@ def test_ogr_gpkg_read_generated_column():
     ds = None
 
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test WriteArrowBatch()
+
+
+def test_ogr_gpkg_write_arrow_batch():
+
+    filename = "/vsimem/test_ogr_gpkg_write_arrow_batch.gpkg"
+    ds = gdal.GetDriverByName("GPKG").Create(filename, 0, 0, 0, gdal.GDT_Unknown)
+    src_lyr = ds.CreateLayer("src", geom_type=ogr.wkbPoint)
+    dst_lyr = ds.CreateLayer("dst", geom_type=ogr.wkbPoint)
+    for lyr in (src_lyr, dst_lyr):
+        lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+        lyr.CreateField(ogr.FieldDefn("int64", ogr.OFTInteger64))
+    for i in range(250):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f.SetField("str", "foo%d" % i)
+        f.SetField("int64", i * 1000000000)
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i, -i)))
+        src_lyr.CreateFeature(f)
+
+    stream = src_lyr.GetArrowStream(["MAX_FEATURES_IN_BATCH=100"])
+    schema = stream.GetSchema()
+    while True:
+        array = stream.GetNextRecordBatch()
+        if array is None:
+            break
+        assert dst_lyr.WriteArrowBatch(schema, array)
+    del stream
+
+    assert dst_lyr.GetFeatureCount() == 250
+    extent = dst_lyr.GetExtent()
+    assert extent == (0, 249, -249, 0)
+    src_lyr.ResetReading()
+    dst_lyr.ResetReading()
+    for f_src in src_lyr:
+        f_dst = dst_lyr.GetNextFeature()
+        assert f_dst.Equal(f_src), (f_src.DumpReadableAsString(), f_dst.DumpReadableAsString())
+
+    dst_lyr.SetSpatialFilterRect(9.5, -10.5, 10.5, -9.5)
+    assert dst_lyr.GetFeatureCount() == 1
+    dst_lyr.SetSpatialFilter(None)
+    ds = None
+
+    gdal.Unlink(filename)
+
+
+
+###############################################################################
+# Test building a packed RTree at the end of a bulk load
+
+
+@pytest.mark.parametrize("packed", ["YES", "NO"])
+def test_ogr_gpkg_packed_rtree(packed):
+
+    filename = "/vsimem/test_ogr_gpkg_packed_rtree.gpkg"
+    ds = gdaltest.gpkg_dr.CreateDataSource(filename)
+    with gdaltest.config_options(
+        {"OGR_GPKG_PACKED_RTREE": packed, "OGR_GPKG_ALLOW_THREADED_RTREE": "NO"}
+    ):
+        lyr = ds.CreateLayer("test")
+        lyr.StartTransaction()
+        for i in range(5000):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            x = (i * 7919) % 1000
+            y = (i * 104729) % 1000
+            if i % 10 == 0:
+                f.SetGeometryDirectly(
+                    ogr.CreateGeometryFromWkt(
+                        "LINESTRING(%d %d,%d %d)" % (x, y, x + 5, y + 10)
+                    )
+                )
+            elif i % 100 != 1:
+                f.SetGeometryDirectly(
+                    ogr.CreateGeometryFromWkt("POINT(%d %d)" % (x, y))
+                )
+            assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+        lyr.CommitTransaction()
+        ds = None
+
+    ds = ogr.Open(filename, update=1)
+    sql_lyr = ds.ExecuteSQL("SELECT COUNT(*) FROM rtree_test_geom")
+    assert sql_lyr.GetNextFeature().GetField(0) == 4950
+    ds.ReleaseResultSet(sql_lyr)
+
+    with gdaltest.error_handler():
+        sql_lyr = ds.ExecuteSQL("SELECT rtreecheck('rtree_test_geom')")
+    if sql_lyr:
+        assert sql_lyr.GetNextFeature().GetField(0) == "ok"
+        ds.ReleaseResultSet(sql_lyr)
+
+    lyr = ds.GetLayer(0)
+    for minx, miny, maxx, maxy in [
+        (0, 0, 1000, 1000),
+        (100, 200, 150, 260),
+        (-10, -10, 3, 3),
+        (990, 990, 2000, 2000),
+    ]:
+        sql_lyr = ds.ExecuteSQL(
+            "SELECT COUNT(*) FROM rtree_test_geom WHERE "
+            "maxx >= %f AND minx <= %f AND maxy >= %f AND miny <= %f"
+            % (minx, maxx, miny, maxy)
+        )
+        count_rtree = sql_lyr.GetNextFeature().GetField(0)
+        ds.ReleaseResultSet(sql_lyr)
+
+        sql_lyr = ds.ExecuteSQL(
+            "SELECT COUNT(*) FROM test WHERE geom IS NOT NULL AND "
+            "ST_MaxX(geom) >= %f AND ST_MinX(geom) <= %f AND "
+            "ST_MaxY(geom) >= %f AND ST_MinY(geom) <= %f"
+            % (minx, maxx, miny, maxy)
+        )
+        count_ref = sql_lyr.GetNextFeature().GetField(0)
+        ds.ReleaseResultSet(sql_lyr)
+        assert count_rtree == count_ref
+
+    # Check that the RTree can still be updated
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT(5000 5000)"))
+    assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+    assert lyr.DeleteFeature(2) == ogr.OGRERR_NONE
+    lyr.SetSpatialFilterRect(4999, 4999, 5001, 5001)
+    assert lyr.GetFeatureCount() == 1
+    lyr.SetSpatialFilter(None)
+    ds = None
+
+    gdaltest.gpkg_dr.DeleteDataSource(filename)
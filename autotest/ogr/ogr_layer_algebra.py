@@ -30,6 +30,7 @@
 ###############################################################################
 
 
+import gdaltest
 import ogrtest
 import pytest
 
@@ -580,6 +581,85 @@ def test_algebra_erase():
     recreate_layer_C()
 
 
+###############################################################################
+# Check that the spatial index and multi-threaded code paths give the same
+# results as querying the method layer with a spatial filter
+
+
+@pytest.mark.parametrize(
+    "method",
+    ["Intersection", "Union", "SymDifference", "Identity", "Update", "Clip", "Erase"],
+)
+def test_algebra_spatial_index_and_threads(method):
+
+    mem_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+
+    lyr_input = mem_ds.CreateLayer("input")
+    lyr_input.CreateField(ogr.FieldDefn("in_id", ogr.OFTInteger))
+    lyr_method = mem_ds.CreateLayer("method")
+    lyr_method.CreateField(ogr.FieldDefn("method_id", ogr.OFTInteger))
+    for i in range(10):
+        for j in range(10):
+            f = ogr.Feature(lyr_input.GetLayerDefn())
+            f["in_id"] = i * 10 + j
+            f.SetGeometryDirectly(
+                ogr.CreateGeometryFromWkt(
+                    "POLYGON((%d %d,%d %d,%d %d,%d %d,%d %d))"
+                    % (i, j, i, j + 1, i + 1, j + 1, i + 1, j, i, j)
+                )
+            )
+            lyr_input.CreateFeature(f)
+    for i in range(7):
+        for j in range(7):
+            f = ogr.Feature(lyr_method.GetLayerDefn())
+            f["method_id"] = i * 7 + j
+            x = 0.5 + i * 1.3
+            y = 0.5 + j * 1.3
+            f.SetGeometryDirectly(
+                ogr.CreateGeometryFromWkt(
+                    "POLYGON((%f %f,%f %f,%f %f,%f %f,%f %f))"
+                    % (x, y, x, y + 1, x + 1, y + 1, x + 1, y, x, y)
+                )
+            )
+            lyr_method.CreateFeature(f)
+
+    # The spatial index is opt-in
+    lyr_ref = mem_ds.CreateLayer("ref")
+    assert getattr(lyr_input, method)(lyr_method, lyr_ref) == 0
+    assert lyr_ref.GetFeatureCount() > 0
+
+    lyr_index = mem_ds.CreateLayer("index")
+    assert (
+        getattr(lyr_input, method)(
+            lyr_method, lyr_index, options=["USE_SPATIAL_INDEX=YES"]
+        )
+        == 0
+    )
+    assert is_same(lyr_ref, lyr_index)
+
+    lyr_threads = mem_ds.CreateLayer("threads")
+    assert (
+        getattr(lyr_input, method)(
+            lyr_method,
+            lyr_threads,
+            options=["USE_SPATIAL_INDEX=YES", "NUM_THREADS=4"],
+        )
+        == 0
+    )
+    assert is_same(lyr_ref, lyr_threads)
+
+    # NUM_THREADS defaults to GDAL_NUM_THREADS
+    lyr_gdal_num_threads = mem_ds.CreateLayer("gdal_num_threads")
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        assert (
+            getattr(lyr_input, method)(
+                lyr_method, lyr_gdal_num_threads, options=["USE_SPATIAL_INDEX=YES"]
+            )
+            == 0
+        )
+    assert is_same(lyr_ref, lyr_gdal_num_threads)
+
+
 def test_algebra_cleanup():
 
     global ds, A, B, C, pointInB, D1, D2, empty
@@ -937,6 +937,114 @@ def test_ogr_mem_arrow_stream_pyarrow():
     assert len(arrays) == 2
 
 
+###############################################################################
+# Test WriteArrowBatch()
+
+
+def test_ogr_mem_write_arrow_batch():
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    src_lyr = ds.CreateLayer("src")
+    dst_lyr = ds.CreateLayer("dst")
+    assert dst_lyr.TestCapability(ogr.OLCFastWriteArrowBatch) == 0
+
+    for name, type, subtype in [
+        ("str", ogr.OFTString, ogr.OFSTNone),
+        ("bool", ogr.OFTInteger, ogr.OFSTBoolean),
+        ("int16", ogr.OFTInteger, ogr.OFSTInt16),
+        ("int32", ogr.OFTInteger, ogr.OFSTNone),
+        ("int64", ogr.OFTInteger64, ogr.OFSTNone),
+        ("float32", ogr.OFTReal, ogr.OFSTFloat32),
+        ("float64", ogr.OFTReal, ogr.OFSTNone),
+        ("date", ogr.OFTDate, ogr.OFSTNone),
+        ("time", ogr.OFTTime, ogr.OFSTNone),
+        ("datetime", ogr.OFTDateTime, ogr.OFSTNone),
+        ("binary", ogr.OFTBinary, ogr.OFSTNone),
+        ("strlist", ogr.OFTStringList, ogr.OFSTNone),
+        ("boollist", ogr.OFTIntegerList, ogr.OFSTBoolean),
+        ("int32list", ogr.OFTIntegerList, ogr.OFSTNone),
+        ("int64list", ogr.OFTInteger64List, ogr.OFSTNone),
+        ("float64list", ogr.OFTRealList, ogr.OFSTNone),
+    ]:
+        field = ogr.FieldDefn(name, type)
+        field.SetSubType(subtype)
+        src_lyr.CreateField(field)
+        dst_lyr.CreateField(field)
+
+    f = ogr.Feature(src_lyr.GetLayerDefn())
+    f.SetField("bool", 1)
+    f.SetField("int16", -12345)
+    f.SetField("int32", 12345678)
+    f.SetField("int64", 12345678901234)
+    f.SetField("float32", 1.25)
+    f.SetField("float64", 1.250123)
+    f.SetField("str", "abc")
+    f.SetField("date", "2022-05-31")
+    f.SetField("time", "12:34:56.789")
+    f.SetField("datetime", "2022-05-31T12:34:56.789")
+    f.SetField("boollist", "[False,True]")
+    f.SetField("int32list", "[-12345678,12345678]")
+    f.SetField("int64list", "[-12345678901234,12345678901234]")
+    f.SetField("float64list", "[-1.250123,1.250123]")
+    f.SetField("strlist", '["abc","defghi"]')
+    f.SetFieldBinaryFromHexString("binary", "DEAD")
+    f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT(1 2)"))
+    src_lyr.CreateFeature(f)
+
+    f = ogr.Feature(src_lyr.GetLayerDefn())
+    f.SetFID(10)
+    f.SetFieldNull("str")
+    src_lyr.CreateFeature(f)
+
+    stream = src_lyr.GetArrowStream(["MAX_FEATURES_IN_BATCH=1"])
+    schema = stream.GetSchema()
+    while True:
+        array = stream.GetNextRecordBatch()
+        if array is None:
+            break
+        assert dst_lyr.WriteArrowBatch(schema, array)
+    del stream
+
+    assert dst_lyr.GetFeatureCount() == 2
+    src_lyr.ResetReading()
+    for f_src in src_lyr:
+        f_dst = dst_lyr.GetFeature(f_src.GetFID())
+        assert f_dst is not None
+        assert f_dst.Equal(f_src), (f_src.DumpReadableAsString(), f_dst.DumpReadableAsString())
+
+    # Column without corresponding field
+    other_lyr = ds.CreateLayer("other")
+    stream = src_lyr.GetArrowStream()
+    schema = stream.GetSchema()
+    array = stream.GetNextRecordBatch()
+    with gdaltest.error_handler():
+        assert not other_lyr.WriteArrowBatch(schema, array)
+    del stream
+
+    # Geometry column matched through its ogc.wkb extension name, and
+    # OGC_FID column written to the regular field of that name
+    other_lyr.CreateField(ogr.FieldDefn("OGC_FID", ogr.OFTInteger64))
+    src_lyr.SetIgnoredFields(
+        [
+            src_lyr.GetLayerDefn().GetFieldDefn(i).GetName()
+            for i in range(src_lyr.GetLayerDefn().GetFieldCount())
+        ]
+    )
+    stream = src_lyr.GetArrowStream()
+    schema = stream.GetSchema()
+    array = stream.GetNextRecordBatch()
+    assert other_lyr.WriteArrowBatch(schema, array)
+    del stream
+    src_lyr.SetIgnoredFields([])
+    assert other_lyr.GetFeatureCount() == 2
+    f = other_lyr.GetNextFeature()
+    assert f["OGC_FID"] == 0
+    assert f.GetGeometryRef().ExportToWkt() == "POINT (1 2)"
+    f = other_lyr.GetNextFeature()
+    assert f["OGC_FID"] == 10
+    assert f.GetGeometryRef() is None
+
+
 ###############################################################################
 # Test upserting a feature.
 
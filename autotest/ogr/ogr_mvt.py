@@ -1962,5 +1962,54 @@ def test_ogr_mvt_write_reuse_temp_db():
     gdal.Unlink("/vsimem/out.temp.db")
 
 
+###############################################################################
+# Test TEMPORARY_STORAGE=FILES
+
+
+@pytest.mark.parametrize("spill_buffer_size", [None, "0"])
+def test_ogr_mvt_write_temporary_storage_files(spill_buffer_size):
+
+    if not ogrtest.have_geos() or ogr.GetDriverByName("SQLITE") is None:
+        pytest.skip()
+
+    src_ds = gdal.OpenEx("data/poly.shp")
+
+    gdal.VectorTranslate(
+        "/vsimem/out_sqlite",
+        src_ds,
+        format="MVT",
+        datasetCreationOptions=["COMPRESS=NO"],
+    )
+
+    # A zero buffer size causes each record to go in its own spill file
+    with gdaltest.config_option("OGR_MVT_SPILL_BUFFER_SIZE_MB", spill_buffer_size):
+        gdal.VectorTranslate(
+            "/vsimem/out_files",
+            src_ds,
+            format="MVT",
+            datasetCreationOptions=["COMPRESS=NO", "TEMPORARY_STORAGE=FILES"],
+        )
+
+    assert gdal.VSIStatL("/vsimem/out_files.temp.0.bin") is None
+
+    files_sqlite = gdal.ReadDirRecursive("/vsimem/out_sqlite")
+    files_files = gdal.ReadDirRecursive("/vsimem/out_files")
+    assert files_sqlite
+    assert files_files == files_sqlite
+    for filename in files_sqlite:
+        if filename.endswith("/"):
+            continue
+        f = gdal.VSIFOpenL("/vsimem/out_sqlite/" + filename, "rb")
+        data_sqlite = gdal.VSIFReadL(1, 10000000, f)
+        gdal.VSIFCloseL(f)
+        f = gdal.VSIFOpenL("/vsimem/out_files/" + filename, "rb")
+        data_files = gdal.VSIFReadL(1, 10000000, f)
+        gdal.VSIFCloseL(f)
+        assert data_files == data_sqlite, filename
+
+    gdal.RmdirRecursive("/vsimem/out_sqlite")
+    gdal.RmdirRecursive("/vsimem/out_files")
+
+
 ###############################################################################
 #
@@ -2433,6 +2433,119 @@ def test_ogr_openfilegdb_read_relationships():
     assert rel.GetRelatedTableType() == "media"
 
 
+###############################################################################
+# Test that the native Arrow stream returns the same content as the generic
+# implementation
+
+
+@pytest.mark.parametrize(
+    "attr_filter,spatial_filter",
+    [
+        (None, None),
+        ("id >= 50", None),
+        ("id = 10 OR id = 150 OR id = 33", None),
+        (None, (10, 10, 60, 60)),
+        ("id < 100", (10, 10, 60, 60)),
+        ("str = 'foo'", None),
+    ],
+)
+def test_ogr_openfilegdb_arrow_stream(attr_filter, spatial_filter):
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    dirname = "/vsimem/test_ogr_openfilegdb_arrow_stream.gdb"
+    ds = ogr.GetDriverByName("OpenFileGDB").CreateDataSource(dirname)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(32631)
+    lyr = ds.CreateLayer("test", srs=srs, geom_type=ogr.wkbPolygon)
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    fld_defn = ogr.FieldDefn("short", ogr.OFTInteger)
+    fld_defn.SetSubType(ogr.OFSTInt16)
+    lyr.CreateField(fld_defn)
+    fld_defn = ogr.FieldDefn("flt", ogr.OFTReal)
+    fld_defn.SetSubType(ogr.OFSTFloat32)
+    lyr.CreateField(fld_defn)
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    lyr.CreateField(ogr.FieldDefn("dt", ogr.OFTDateTime))
+    lyr.CreateField(ogr.FieldDefn("bin", ogr.OFTBinary))
+    for i in range(200):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        if i % 5 != 0:
+            f["short"] = -i
+            f["flt"] = i + 0.5
+            f["real"] = i + 0.25
+            f["str"] = "foo" if i % 2 else "bar_%d" % i
+            f["dt"] = "2022/%02d/%02d 12:34:56" % (1 + i % 12, 1 + i % 28)
+            f.SetFieldBinaryFromHexString("bin", "0102%02X" % i)
+        if i % 7 != 0:
+            f.SetGeometry(
+                ogr.CreateGeometryFromWkt(
+                    "POLYGON((%d %d,%d %d,%d %d,%d %d))"
+                    % (i, i, i, i + 1, i + 1, i + 1, i, i)
+                )
+            )
+        lyr.CreateFeature(f)
+    # Rewrite some features with a larger geometry, so that they are moved
+    # at the end of the file, and are no longer stored in FID order.
+    for fid in range(1, 200, 3):
+        f = lyr.GetFeature(fid)
+        f.SetGeometry(
+            ogr.CreateGeometryFromWkt(
+                "POLYGON((%d %d,%d %d,%d %d,%d %d,%d %d,%d %d))"
+                % (fid, fid, fid, fid + 1, fid + 1, fid + 1, fid + 2, fid + 1,
+                   fid + 2, fid, fid, fid)
+            )
+        )
+        lyr.SetFeature(f)
+    for fid in (5, 66, 123):
+        lyr.DeleteFeature(fid)
+    ds.ExecuteSQL("CREATE INDEX idx_id ON test(id)")
+    ds.ExecuteSQL("CREATE INDEX idx_str ON test(str)")
+    ds = None
+
+    def get_batches(lyr):
+        stream = lyr.GetArrowStreamAsNumPy(
+            options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=7"]
+        )
+        return [batch for batch in stream]
+
+    try:
+        ds = ogr.Open(dirname)
+        lyr = ds.GetLayer(0)
+        lyr.SetAttributeFilter(attr_filter)
+        if spatial_filter:
+            lyr.SetSpatialFilterRect(*spatial_filter)
+        if attr_filter is None or attr_filter.startswith("id "):
+            assert lyr.TestCapability(ogr.OLCFastGetArrowStream) == 1
+        batches = get_batches(lyr)
+        with gdaltest.config_option("OGR_OPENFILEGDB_STREAM_BASE_IMPL", "YES"):
+            expected_batches = get_batches(lyr)
+        assert len(expected_batches) > 0
+
+        assert len(batches) == len(expected_batches)
+        for batch, expected_batch in zip(batches, expected_batches):
+            assert batch.keys() == expected_batch.keys()
+            for key in batch:
+                assert len(batch[key]) == len(expected_batch[key])
+                for got, expected in zip(batch[key], expected_batch[key]):
+                    assert str(got) == str(expected), key
+
+        # Test ignored fields
+        lyr.SetSpatialFilter(None)
+        assert lyr.SetIgnoredFields(["SHAPE", "short", "str"]) == ogr.OGRERR_NONE
+        batches = get_batches(lyr)
+        with gdaltest.config_option("OGR_OPENFILEGDB_STREAM_BASE_IMPL", "YES"):
+            expected_batches = get_batches(lyr)
+        assert [str(b) for b in batches] == [str(b) for b in expected_batches]
+        assert "SHAPE" not in batches[0]
+        assert "str" not in batches[0]
+        ds = None
+    finally:
+        gdal.RmdirRecursive(dirname)
+
+
 ###############################################################################
 # Cleanup
 
@@ -983,3 +983,57 @@ def test_ogr_osm_18():
     ds = None
 
     assert count == 2
+
+
+###############################################################################
+# Test that multi-threaded resolution of ways and multipolygons gives the
+# same result as single-threaded one
+
+
+@pytest.mark.parametrize("filename", ["data/osm/test.pbf", "data/osm/test.osm"])
+def test_ogr_osm_num_threads(filename):
+
+    if ogrtest.osm_drv is None:
+        pytest.skip()
+    if filename.endswith(".osm") and not ogrtest.osm_drv_parse_osm:
+        pytest.skip()
+
+    def get_features(num_threads):
+        ret = []
+        debug_msgs = []
+
+        def handler(eErrClass, err_no, msg):
+            if eErrClass == gdal.CE_Debug:
+                debug_msgs.append(msg)
+
+        gdal.PushErrorHandler(handler)
+        try:
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            # Lower the number of ways per job so that the small test files
+            # are split in several jobs
+            with gdaltest.config_options(
+                {
+                    "CPL_DEBUG": "ON",
+                    "GDAL_NUM_THREADS": num_threads,
+                    "OGR_OSM_MIN_WAYS_PER_JOB": "1",
+                }
+            ):
+                ds = ogr.Open(filename)
+                for lyr_name in ("lines", "multipolygons", "multilinestrings"):
+                    lyr = ds.GetLayerByName(lyr_name)
+                    for f in lyr:
+                        ret.append(
+                            (lyr_name, f.GetFID(), f.GetGeometryRef().ExportToWkt())
+                        )
+                ds = None
+        finally:
+            gdal.PopErrorHandler()
+        multi_job = any("Resolving" in msg for msg in debug_msgs)
+        return ret, multi_job
+
+    single_threaded, multi_job = get_features("1")
+    assert single_threaded
+    assert not multi_job
+    multi_threaded, multi_job = get_features("4")
+    assert multi_job
+    assert multi_threaded == single_threaded
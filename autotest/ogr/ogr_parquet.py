@@ -31,6 +31,8 @@
 
 import json
 import math
+import os
+import struct
 
 import gdaltest
 import pytest
@@ -1244,6 +1246,167 @@ def test_ogr_parquet_attribute_filter_and_spatial_filter():
     assert lyr.GetFeatureCount() == ref_fc
 
 
+###############################################################################
+# Test that row groups are skipped using statistics
+
+
+@pytest.mark.parametrize(
+    "filter,selected_row_groups",
+    [
+        ("id = 55", 1),
+        ("id < 25", 3),
+        ("25 > id", 3),
+        ("id >= 90", 1),
+        ("id != 3", 10),
+        ("id IN (5, 99)", 2),
+        ("id BETWEEN 42 AND 47", 1),
+        ("id = 5 OR id = 95", 2),
+        ("id > 30 AND real < 40.5", 1),
+        ("real > 95.5", 1),
+        ("real != 5.5", 10),
+        ("str = 'VAL_05'", 1),
+        # As comparison is case insensitive, only row groups whose minimum
+        # is greater than the lower case form of the value can be skipped.
+        ("str = 'val_42'", 5),
+        ("str IN ('val_05', 'val_12')", 2),
+        ("str = 'val_12' OR id = 99", 3),
+        # Only the row groups where str is always null are skipped
+        ("str > 'val_45'", 5),
+        ("str IS NULL", 5),
+        ("str IS NOT NULL", 5),
+        ("NOT (str IS NULL)", 5),
+    ],
+)
+def test_ogr_parquet_row_group_statistics(filter, selected_row_groups):
+
+    outfilename = "/vsimem/test_ogr_parquet_row_group_statistics.parquet"
+    ds = gdal.GetDriverByName("Parquet").Create(
+        outfilename, 0, 0, 0, gdal.GDT_Unknown
+    )
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbPoint, options=["ROW_GROUP_SIZE=10"])
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    for i in range(100):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        f["real"] = i + 0.5
+        if i < 50:
+            f["str"] = "val_%02d" % i
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i, i)))
+        lyr.CreateFeature(f)
+    ds = None
+
+    def get_features():
+        ds = ogr.Open(outfilename)
+        lyr = ds.GetLayer(0)
+        assert lyr.GetMetadataItem("NUM_ROW_GROUPS", "_PARQUET_") == "10"
+        assert lyr.SetAttributeFilter(filter) == ogr.OGRERR_NONE
+        debug_msgs.clear()
+        gdal.PushErrorHandler(handler)
+        try:
+            gdal.SetCurrentErrorHandlerCatchDebug(True)
+            with gdaltest.config_option("CPL_DEBUG", "ON"):
+                ret = [(f.GetFID(), f["id"], f["str"]) for f in lyr]
+        finally:
+            gdal.PopErrorHandler()
+        # Test that a second pass gives the same result
+        assert [(f.GetFID(), f["id"], f["str"]) for f in lyr] == ret
+        assert lyr.GetFeatureCount() == len(ret)
+        if ret:
+            lyr.SetNextByIndex(ret[0][0])
+            f = lyr.GetNextFeature()
+            assert f.GetFID() == ret[0][0]
+        # The extent must not be affected by the filter
+        assert lyr.GetExtent(force=1) == (0, 99, 0, 99)
+        return ret
+
+    debug_msgs = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug and "selected from statistics" in msg:
+            debug_msgs.append(msg)
+
+    try:
+        with gdaltest.config_option("OGR_PARQUET_USE_STATISTICS", "NO"):
+            ref = get_features()
+        assert ref
+        assert not debug_msgs
+        assert get_features() == ref
+        assert debug_msgs == [
+            "PARQUET: %d row group(s) out of 10 selected from statistics"
+            % selected_row_groups
+        ]
+    finally:
+        gdal.Unlink(outfilename)
+
+
+###############################################################################
+# Test that row groups are skipped using a GeoParquet bounding box covering
+
+
+def test_ogr_parquet_row_group_statistics_bbox_covering():
+
+    pa = pytest.importorskip("pyarrow")
+    pq = pytest.importorskip("pyarrow.parquet")
+
+    geoms = []
+    xmin = []
+    ymin = []
+    xmax = []
+    ymax = []
+    for i in range(100):
+        g = ogr.CreateGeometryFromWkt(
+            "LINESTRING(%d %d,%d %d)" % (i, i, i + 0.5, i + 0.5)
+        )
+        geoms.append(bytes(g.ExportToWkb(ogr.wkbNDR)))
+        minx, maxx, miny, maxy = g.GetEnvelope()
+        xmin.append(minx)
+        ymin.append(miny)
+        xmax.append(maxx)
+        ymax.append(maxy)
+    bbox = pa.StructArray.from_arrays(
+        [pa.array(xmin), pa.array(ymin), pa.array(xmax), pa.array(ymax)],
+        names=["xmin", "ymin", "xmax", "ymax"],
+    )
+    table = pa.table({"geometry": pa.array(geoms), "bbox": bbox})
+    geo = {
+        "version": "1.1.0",
+        "primary_column": "geometry",
+        "columns": {
+            "geometry": {
+                "encoding": "WKB",
+                "geometry_types": ["LineString"],
+                "covering": {
+                    "bbox": {
+                        "xmin": ["bbox", "xmin"],
+                        "ymin": ["bbox", "ymin"],
+                        "xmax": ["bbox", "xmax"],
+                        "ymax": ["bbox", "ymax"],
+                    }
+                },
+            }
+        },
+    }
+    table = table.replace_schema_metadata({"geo": json.dumps(geo)})
+    outfilename = "tmp/test_ogr_parquet_row_group_statistics_bbox_covering.parquet"
+    pq.write_table(table, outfilename, row_group_size=10)
+
+    def get_fids():
+        ds = ogr.Open(outfilename)
+        lyr = ds.GetLayer(0)
+        lyr.SetSpatialFilterRect(41.75, 41.75, 62.25, 62.25)
+        return [f.GetFID() for f in lyr]
+
+    try:
+        with gdaltest.config_option("OGR_PARQUET_USE_STATISTICS", "NO"):
+            ref = get_fids()
+        assert ref == [i for i in range(42, 63)]
+        assert get_fids() == ref
+    finally:
+        gdal.Unlink(outfilename)
+
+
 ###############################################################################
 
 
@@ -1383,6 +1546,263 @@ def test_ogr_parquet_write_crs_without_id_in_datum_ensemble_members():
     gdal.Unlink(outfilename)
 
 
+###############################################################################
+# Test WriteArrowBatch()
+
+
+def test_ogr_parquet_write_arrow_batch():
+
+    src_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    src_lyr = src_ds.CreateLayer("src", geom_type=ogr.wkbPoint)
+    for name, type in [
+        ("str", ogr.OFTString),
+        ("int32", ogr.OFTInteger),
+        ("int64", ogr.OFTInteger64),
+        ("float64", ogr.OFTReal),
+    ]:
+        src_lyr.CreateField(ogr.FieldDefn(name, type))
+    for i in range(3):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f.SetField("str", "foo%d" % i)
+        f.SetField("int32", i)
+        f.SetField("int64", 1234567890123 + i)
+        f.SetField("float64", 1.5 + i)
+        if i != 1:
+            f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT(%d 2)" % i))
+        src_lyr.CreateFeature(f)
+
+    outfilename = "/vsimem/test_ogr_parquet_write_arrow_batch.parquet"
+    ds = gdal.GetDriverByName("Parquet").Create(
+        outfilename, 0, 0, 0, gdal.GDT_Unknown
+    )
+    lyr = ds.CreateLayer(
+        "out",
+        geom_type=ogr.wkbPoint,
+        options=["FID=OGC_FID", "GEOMETRY_NAME=wkb_geometry", "ROW_GROUP_SIZE=2"],
+    )
+    for i in range(src_lyr.GetLayerDefn().GetFieldCount()):
+        lyr.CreateField(src_lyr.GetLayerDefn().GetFieldDefn(i))
+    assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch) == 1
+
+    stream = src_lyr.GetArrowStream()
+    schema = stream.GetSchema()
+    array = stream.GetNextRecordBatch()
+    assert lyr.WriteArrowBatch(schema, array)
+    del array
+    del stream
+    assert lyr.GetFeatureCount() == 3
+    ds = None
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFIDColumn() == "OGC_FID"
+    assert lyr.GetMetadataItem("NUM_ROW_GROUPS", "_PARQUET_") == "2"
+    geo = lyr.GetMetadataItem("geo", "_PARQUET_METADATA_")
+    j = json.loads(geo)
+    assert j["columns"]["wkb_geometry"]["bbox"] == [0.0, 2.0, 2.0, 2.0]
+    assert j["columns"]["wkb_geometry"]["geometry_types"] == ["Point"]
+    assert lyr.GetFeatureCount() == 3
+    for f_src in src_lyr:
+        f = lyr.GetNextFeature()
+        assert f.Equal(f_src), (f_src.DumpReadableAsString(), f.DumpReadableAsString())
+    ds = None
+
+    gdal.Unlink(outfilename)
+
+
+###############################################################################
+# Test that WriteArrowBatch() does not write non-ISO WKB as it is
+
+
+def test_ogr_parquet_write_arrow_batch_non_iso_wkb():
+
+    pa = pytest.importorskip("pyarrow")
+    pq = pytest.importorskip("pyarrow.parquet")
+
+    # OGC SFSQL 1.2 2.5D WKB
+    wkb = bytes(
+        ogr.CreateGeometryFromWkt("LINESTRING Z (0 1 2,3 4 5)").ExportToWkb(
+            ogr.wkbNDR
+        )
+    )
+    assert struct.unpack("<I", wkb[1:5])[0] == 0x80000002
+    table = pa.table(
+        {"int32": pa.array([1], pa.int32()), "geometry": pa.array([wkb])}
+    )
+    srcfilename = "tmp/test_ogr_parquet_write_arrow_batch_non_iso_wkb_src.parquet"
+    pq.write_table(table, srcfilename)
+
+    outfilename = "tmp/test_ogr_parquet_write_arrow_batch_non_iso_wkb.parquet"
+    try:
+        src_ds = ogr.Open(srcfilename)
+        src_lyr = src_ds.GetLayer(0)
+
+        ds = gdal.GetDriverByName("Parquet").Create(
+            outfilename, 0, 0, 0, gdal.GDT_Unknown
+        )
+        lyr = ds.CreateLayer(
+            "out", geom_type=ogr.wkbLineString25D, options=["GEOMETRY_NAME=geometry"]
+        )
+        lyr.CreateField(ogr.FieldDefn("int32", ogr.OFTInteger))
+        assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch) == 1
+
+        stream = src_lyr.GetArrowStream(["INCLUDE_FID=NO"])
+        schema = stream.GetSchema()
+        array = stream.GetNextRecordBatch()
+        assert lyr.WriteArrowBatch(schema, array)
+        del array
+        del stream
+        ds = None
+        src_ds = None
+
+        out_wkb = pq.read_table(outfilename)["geometry"][0].as_py()
+        assert struct.unpack("<I", out_wkb[1:5])[0] == 1002
+    finally:
+        gdal.Unlink(srcfilename)
+        gdal.Unlink(outfilename)
+
+
+###############################################################################
+# Test that OLCFastWriteArrowBatch is not advertised when WriteArrowBatch()
+# has to go through the per-feature path
+
+
+def test_ogr_parquet_write_arrow_batch_fast_capability():
+
+    ds = gdal.GetDriverByName("Parquet").Create(
+        "/vsimem/test_ogr_parquet_write_arrow_batch_fast_capability.parquet",
+        0,
+        0,
+        0,
+        gdal.GDT_Unknown,
+    )
+    lyr = ds.CreateLayer(
+        "out", geom_type=ogr.wkbPoint, options=["GEOMETRY_ENCODING=GEOARROW"]
+    )
+    assert lyr.TestCapability(ogr.OLCFastWriteArrowBatch) == 0
+    ds = None
+    gdal.Unlink("/vsimem/test_ogr_parquet_write_arrow_batch_fast_capability.parquet")
+
+
+###############################################################################
+# Test WriteArrowBatch() when the batch cannot be written directly, and the
+# WKB geometries are copied by the per-feature path.
+
+
+def test_ogr_parquet_write_arrow_batch_wkb_passthrough():
+
+    src_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    src_lyr = src_ds.CreateLayer("src", geom_type=ogr.wkbLineString)
+    src_lyr.CreateField(ogr.FieldDefn("int32", ogr.OFTInteger))
+    # DateTime fields prevent the direct write before the writer is created
+    src_lyr.CreateField(ogr.FieldDefn("dt", ogr.OFTDateTime))
+    for i in range(5):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f.SetField("int32", i)
+        f.SetField("dt", "2022/01/%02d 12:34:56+00" % (i + 1))
+        if i != 1:
+            f.SetGeometryDirectly(
+                ogr.CreateGeometryFromWkt("LINESTRING(%d 2,%d 3)" % (i, i + 1))
+            )
+        src_lyr.CreateFeature(f)
+
+    outfilename = "/vsimem/test_ogr_parquet_write_arrow_batch_wkb_passthrough.parquet"
+    ds = gdal.GetDriverByName("Parquet").Create(
+        outfilename, 0, 0, 0, gdal.GDT_Unknown
+    )
+    lyr = ds.CreateLayer(
+        "out",
+        geom_type=ogr.wkbLineString,
+        options=["FID=OGC_FID", "GEOMETRY_NAME=wkb_geometry", "ROW_GROUP_SIZE=2"],
+    )
+    for i in range(src_lyr.GetLayerDefn().GetFieldCount()):
+        lyr.CreateField(src_lyr.GetLayerDefn().GetFieldDefn(i))
+
+    stream = src_lyr.GetArrowStream()
+    schema = stream.GetSchema()
+    array = stream.GetNextRecordBatch()
+    assert lyr.WriteArrowBatch(schema, array)
+    del array
+    del stream
+    assert lyr.GetFeatureCount() == 5
+    ds = None
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetMetadataItem("NUM_ROW_GROUPS", "_PARQUET_") == "3"
+    geo = lyr.GetMetadataItem("geo", "_PARQUET_METADATA_")
+    j = json.loads(geo)
+    assert j["columns"]["wkb_geometry"]["bbox"] == [0.0, 2.0, 5.0, 3.0]
+    assert j["columns"]["wkb_geometry"]["geometry_types"] == ["LineString"]
+    for f_src in src_lyr:
+        f = lyr.GetNextFeature()
+        assert f.Equal(f_src), (f_src.DumpReadableAsString(), f.DumpReadableAsString())
+    ds = None
+
+    gdal.Unlink(outfilename)
+
+
+###############################################################################
+# Test writing row groups in the background
+
+
+def test_ogr_parquet_write_row_groups_in_background():
+
+    outfilename = "/vsimem/test_ogr_parquet_write_row_groups_in_background.parquet"
+    ds = gdal.GetDriverByName("Parquet").Create(outfilename, 0, 0, 0, gdal.GDT_Unknown)
+    lyr = ds.CreateLayer(
+        "out", geom_type=ogr.wkbPoint, options=["ROW_GROUP_SIZE=10", "NUM_THREADS=2"]
+    )
+    lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i in range(95):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["id"] = i
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i, -i)))
+        assert lyr.CreateFeature(f) == ogr.OGRERR_NONE
+    ds = None
+
+    ds = ogr.Open(outfilename)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetMetadataItem("NUM_ROW_GROUPS", "_PARQUET_") == "10"
+    assert lyr.GetFeatureCount() == 95
+    for i, f in enumerate(lyr):
+        assert f["id"] == i
+        assert f.GetGeometryRef().ExportToWkt() == "POINT (%d %d)" % (i, -i)
+    ds = None
+
+    gdal.Unlink(outfilename)
+
+
+###############################################################################
+# Test that a failure to write a row group in the background is reported
+
+
+@pytest.mark.skipif(not os.path.exists("/dev/full"), reason="/dev/full not available")
+def test_ogr_parquet_write_row_groups_in_background_io_error():
+
+    ds = gdal.GetDriverByName("Parquet").Create("/dev/full", 0, 0, 0, gdal.GDT_Unknown)
+    lyr = ds.CreateLayer(
+        "out",
+        geom_type=ogr.wkbNone,
+        options=["ROW_GROUP_SIZE=10", "NUM_THREADS=2", "COMPRESSION=NONE"],
+    )
+    lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    gdal.ErrorReset()
+    with gdaltest.error_handler():
+        for i in range(100):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            f["str"] = "%d" % i + "x" * 100000
+            ret = lyr.CreateFeature(f)
+            if ret != ogr.OGRERR_NONE:
+                break
+    # Reported at the latest when the next row group is submitted
+    assert ret != ogr.OGRERR_NONE
+    assert i < 20
+    assert gdal.GetLastErrorMsg() != ""
+    with gdaltest.error_handler():
+        ds = None
+
+
 ###############################################################################
 
 
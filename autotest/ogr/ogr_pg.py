@@ -6111,6 +6111,154 @@ def test_ogr_pg_get_geometry_types():
         )
 
 
+###############################################################################
+# Test GetArrowStream() through COPY ... TO STDOUT (FORMAT binary)
+
+
+def test_ogr_pg_arrow_stream():
+
+    if gdaltest.pg_ds is None:
+        pytest.skip()
+
+    if not gdaltest.pg_has_postgis:
+        pytest.skip()
+
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    def get_batches(lyr):
+        stream = lyr.GetArrowStreamAsNumPy(
+            options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=5"]
+        )
+        return [batch for batch in stream]
+
+    def check_batches(lyr):
+        batches = get_batches(lyr)
+        with gdaltest.config_option("OGR_PG_STREAM_BASE_IMPL", "YES"):
+            expected_batches = get_batches(lyr)
+
+        assert len(batches) == len(expected_batches)
+        for batch, expected_batch in zip(batches, expected_batches):
+            assert batch.keys() == expected_batch.keys()
+            for key in batch:
+                assert len(batch[key]) == len(expected_batch[key])
+                for got, expected in zip(batch[key], expected_batch[key]):
+                    if key == "geom":
+                        if expected is None:
+                            assert got is None
+                        else:
+                            assert ogr.CreateGeometryFromWkb(
+                                got
+                            ).ExportToIsoWkt() == ogr.CreateGeometryFromWkb(
+                                expected
+                            ).ExportToIsoWkt()
+                    else:
+                        assert str(got) == str(expected), key
+        return batches
+
+    try:
+        gdaltest.pg_ds.ExecuteSQL(
+            "CREATE TABLE ogr_pg_arrow_stream(fid SERIAL PRIMARY KEY, "
+            "b BOOLEAN, i2 SMALLINT, i4 INTEGER, i8 BIGINT, "
+            "f4 REAL, f8 DOUBLE PRECISION, num NUMERIC(10,3), numint NUMERIC(5,0), "
+            "str VARCHAR, fixedstr CHAR(5), js JSON, jsb JSONB, uid UUID, "
+            "bin BYTEA, d DATE, t TIME, ts TIMESTAMP, tstz TIMESTAMP WITH TIME ZONE, "
+            "other INTERVAL, geom GEOMETRY(POINTZ, 4326))"
+        )
+        gdaltest.pg_ds.ExecuteSQL(
+            "INSERT INTO ogr_pg_arrow_stream(b, i2, i4, i8, f4, f8, num, numint, "
+            "str, fixedstr, js, jsb, uid, bin, d, t, ts, tstz, other, geom) "
+            "SELECT i % 2 = 0, i, i * 1000, i * 10000000000, i + 0.5, i + 0.25, "
+            "i + 0.125, i, 'str' || i, 'x', '{\"a\": 1}', '{\"b\": 2}', "
+            "'6f9619ff-8b86-d011-b42d-00c04fc964ff', '\\x0001FF', "
+            "'2022-01-01'::date + i, '12:34:56.789'::time, "
+            "'1969-12-31 23:59:59.999'::timestamp + i * interval '1 day', "
+            "'2022-05-31 12:34:56.5+02'::timestamptz, interval '1 day', "
+            "ST_SetSRID(ST_MakePoint(i, i, i), 4326) "
+            "FROM generate_series(1, 12) AS i"
+        )
+        gdaltest.pg_ds.ExecuteSQL(
+            "INSERT INTO ogr_pg_arrow_stream(b, d, ts) "
+            "VALUES (NULL, 'infinity', '-infinity')"
+        )
+
+        ds = ogr.Open("PG:" + gdaltest.pg_connection_string)
+        lyr = ds.GetLayer("ogr_pg_arrow_stream")
+        assert lyr.TestCapability(ogr.OLCFastGetArrowStream) == 1
+        with gdaltest.config_option("OGR_PG_STREAM_BASE_IMPL", "YES"):
+            assert lyr.TestCapability(ogr.OLCFastGetArrowStream) == 0
+
+        batches = check_batches(lyr)
+        assert len(batches) == 3
+        assert list(batches[0]["fid"]) == [1, 2, 3, 4, 5]
+
+        # Spatial and attribute filters are evaluated by the server
+        lyr.SetSpatialFilterRect(2.5, 2.5, 7.5, 7.5)
+        lyr.SetAttributeFilter("i4 > 3000")
+        assert lyr.TestCapability(ogr.OLCFastGetArrowStream) == 1
+        batches = check_batches(lyr)
+        assert list(batches[0]["fid"]) == [4, 5, 6, 7]
+        lyr.SetSpatialFilter(None)
+        lyr.SetAttributeFilter(None)
+
+        # Test ignored fields
+        assert lyr.SetIgnoredFields(["geom", "i2", "str", "tstz"]) == ogr.OGRERR_NONE
+        batches = check_batches(lyr)
+        assert "geom" not in batches[0]
+        assert "str" not in batches[0]
+        assert "i4" in batches[0]
+        lyr.SetIgnoredFields([])
+
+        # Reading another layer in the middle of the stream interrupts it
+        stream = lyr.GetArrowStreamAsNumPy(
+            options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=5"]
+        )
+        batch = stream.GetNextRecordBatch()
+        assert list(batch["fid"]) == [1, 2, 3, 4, 5]
+        sql_lyr = ds.ExecuteSQL("SELECT 1")
+        ds.ReleaseResultSet(sql_lyr)
+        with gdaltest.error_handler():
+            gdal.ErrorReset()
+            assert stream.GetNextRecordBatch() is None
+            assert "interrupted" in gdal.GetLastErrorMsg()
+        del stream
+
+        # Same when fetching from the cursor of a result layer, which does
+        # not go through OGRPGTableLayer::GetNextFeature()
+        sql_lyr = ds.ExecuteSQL(
+            "SELECT fid AS id FROM ogr_pg_arrow_stream ORDER BY fid"
+        )
+        for method in ("GetNextFeature", "SetNextByIndex"):
+            stream = lyr.GetArrowStreamAsNumPy(
+                options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=5"]
+            )
+            batch = stream.GetNextRecordBatch()
+            assert list(batch["fid"]) == [1, 2, 3, 4, 5]
+            if method == "GetNextFeature":
+                sql_lyr.ResetReading()
+                assert sql_lyr.GetNextFeature()["id"] == 1
+            else:
+                assert sql_lyr.SetNextByIndex(2) == ogr.OGRERR_NONE
+                assert sql_lyr.GetNextFeature()["id"] == 3
+            with gdaltest.error_handler():
+                gdal.ErrorReset()
+                assert stream.GetNextRecordBatch() is None
+                assert "interrupted" in gdal.GetLastErrorMsg()
+            del stream
+            lyr.ResetReading()
+        ds.ReleaseResultSet(sql_lyr)
+
+        # And the layer can be read again after ResetReading()
+        lyr.ResetReading()
+        f = lyr.GetNextFeature()
+        assert f.GetFID() == 1
+
+        ds = None
+
+    finally:
+        gdaltest.pg_ds.ExecuteSQL("DELLAYER:ogr_pg_arrow_stream")
+
+
 ###############################################################################
 #
 
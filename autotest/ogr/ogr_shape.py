@@ -5822,6 +5822,254 @@ def test_ogr_shape_alter_geom_field_defn():
     ogr.GetDriverByName("ESRI Shapefile").DeleteDataSource(outfilename)
 
 
+###############################################################################
+# Test that the native Arrow stream returns the same content as the generic
+# implementation
+
+
+@pytest.mark.parametrize(
+    "filename",
+    [
+        "data/poly.shp",
+        "data/shp/gjpoint.shp",
+        "data/shp/gjline.shp",
+        "data/shp/gjmultiline.shp",
+        "data/shp/gjmultipoint.shp",
+        "data/shp/arcm_with_m.shp",
+        "data/shp/arcm_without_m.shp",
+        "data/shp/testpointzm.shp",
+        "data/shp/pointz_without_m.shp",
+        "data/shp/multipointz_without_m.shp",
+        "data/shp/multipatch.shp",
+        "data/shp/emptymultipoint.shp",
+        "data/shp/departs.shp",
+    ],
+)
+@pytest.mark.parametrize(
+    "spatial_filter", [None, (479750, 4764000, 480500, 4765000), (0, 0, 1, 1)]
+)
+def test_ogr_shape_arrow_stream(filename, spatial_filter):
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    def get_batches(lyr):
+        stream = lyr.GetArrowStreamAsNumPy(
+            options=["USE_MASKED_ARRAYS=NO", "MAX_FEATURES_IN_BATCH=5"]
+        )
+        return [batch for batch in stream]
+
+    ds = ogr.Open(filename)
+    lyr = ds.GetLayer(0)
+    assert lyr.TestCapability(ogr.OLCFastGetArrowStream) == 1
+    if spatial_filter:
+        lyr.SetSpatialFilterRect(*spatial_filter)
+        assert lyr.TestCapability(ogr.OLCFastGetArrowStream) == 0
+    batches = get_batches(lyr)
+    with gdaltest.config_option("OGR_SHAPE_STREAM_BASE_IMPL", "YES"):
+        expected_batches = get_batches(lyr)
+
+    assert len(batches) == len(expected_batches)
+    for batch, expected_batch in zip(batches, expected_batches):
+        assert batch.keys() == expected_batch.keys()
+        for key in batch:
+            assert len(batch[key]) == len(expected_batch[key])
+            for got, expected in zip(batch[key], expected_batch[key]):
+                if key == "wkb_geometry":
+                    if expected is None:
+                        assert got is None
+                    else:
+                        assert ogr.CreateGeometryFromWkb(
+                            got
+                        ).ExportToIsoWkt() == ogr.CreateGeometryFromWkb(
+                            expected
+                        ).ExportToIsoWkt()
+                else:
+                    assert str(got) == str(expected)
+
+    # Test ignored fields
+    lyr.SetSpatialFilter(None)
+    field_names = [
+        lyr.GetLayerDefn().GetFieldDefn(i).GetName()
+        for i in range(lyr.GetLayerDefn().GetFieldCount())
+    ]
+    assert lyr.SetIgnoredFields(["OGR_GEOMETRY"] + field_names[1:]) == ogr.OGRERR_NONE
+    batches = get_batches(lyr)
+    lyr.SetIgnoredFields([])
+    expected_keys = set(["OGC_FID"] + field_names[0:1])
+    for batch in batches:
+        assert batch.keys() == expected_keys
+
+
+###############################################################################
+# Test that the Arrow stream recognizes the same null dates as GetNextFeature()
+
+
+def test_ogr_shape_arrow_stream_null_dates():
+    pytest.importorskip("osgeo.gdal_array")
+    pytest.importorskip("numpy")
+
+    dirname = "/vsimem/test_ogr_shape_arrow_stream_null_dates"
+    ds = ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(dirname)
+    lyr = ds.CreateLayer("test", geom_type=ogr.wkbNone)
+    lyr.CreateField(ogr.FieldDefn("d", ogr.OFTDate))
+    for i in range(3):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["d"] = "2023/01/02"
+        lyr.CreateFeature(f)
+    ds = None
+
+    # Replace the value of the second and third records with the "00000000"
+    # and all blanks null forms.
+    header_size = 32 + 32 + 1
+    record_size = 1 + 8
+    fp = gdal.VSIFOpenL(dirname + "/test.dbf", "rb+")
+    for i, val in ((1, b"00000000"), (2, b"        ")):
+        gdal.VSIFSeekL(fp, header_size + i * record_size + 1, 0)
+        gdal.VSIFWriteL(val, 1, len(val), fp)
+    gdal.VSIFCloseL(fp)
+
+    ds = ogr.Open(dirname)
+    lyr = ds.GetLayer(0)
+    assert [f.IsFieldNull("d") for f in lyr] == [False, True, True]
+
+    def get_batches(lyr):
+        stream = lyr.GetArrowStreamAsNumPy(options=["USE_MASKED_ARRAYS=NO"])
+        return [batch for batch in stream]
+
+    batches = get_batches(lyr)
+    with gdaltest.config_option("OGR_SHAPE_STREAM_BASE_IMPL", "YES"):
+        expected_batches = get_batches(lyr)
+    assert len(batches) == len(expected_batches)
+    for batch, expected_batch in zip(batches, expected_batches):
+        assert [str(x) for x in batch["d"]] == [str(x) for x in expected_batch["d"]]
+    ds = None
+
+    gdal.RmdirRecursive(dirname)
+
+
+###############################################################################
+# Test the packed Hilbert R-tree spatial index (.hrt)
+
+
+@pytest.mark.parametrize("create_with_lco", [True, False])
+def test_ogr_shape_hilbert_spatial_index(create_with_lco):
+
+    filename = "/vsimem/ogr_shape_hrt.shp"
+    ds = ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(filename)
+    options = ["SPATIAL_INDEX=YES", "SPATIAL_INDEX_TYPE=HILBERT"]
+    lyr = ds.CreateLayer(
+        "ogr_shape_hrt", geom_type=ogr.wkbPoint,
+        options=options if create_with_lco else []
+    )
+    for y in range(50):
+        for x in range(50):
+            f = ogr.Feature(lyr.GetLayerDefn())
+            if x == 1 and y == 1:
+                f.SetGeometry(None)
+            else:
+                f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (x, y)))
+            lyr.CreateFeature(f)
+    if not create_with_lco:
+        ds.ExecuteSQL("CREATE SPATIAL INDEX ON ogr_shape_hrt TYPE HILBERT")
+    ds = None
+
+    assert gdal.VSIStatL("/vsimem/ogr_shape_hrt.hrt") is not None
+    assert gdal.VSIStatL("/vsimem/ogr_shape_hrt.qix") is None
+
+    ds = ogr.Open(filename, update=1)
+    lyr = ds.GetLayer(0)
+    assert lyr.TestCapability(ogr.OLCFastSpatialFilter)
+
+    for minx, miny, maxx, maxy in [
+        (0, 0, 49, 49),
+        (-0.5, -0.5, 0.5, 0.5),
+        (0.5, 0.5, 1.5, 1.5),
+        (10.5, 20.5, 17.5, 22.5),
+        (100, 100, 101, 101),
+    ]:
+        lyr.SetSpatialFilterRect(minx, miny, maxx, maxy)
+        got = sorted(f.GetFID() for f in lyr)
+        expected = [
+            y * 50 + x
+            for y in range(50)
+            for x in range(50)
+            if not (x == 1 and y == 1)
+            and minx <= x <= maxx
+            and miny <= y <= maxy
+        ]
+        assert got == expected, (minx, miny, maxx, maxy)
+    lyr.SetSpatialFilter(None)
+
+    # Modifying the layer drops the index
+    f = ogr.Feature(lyr.GetLayerDefn())
+    f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (100 100)"))
+    lyr.CreateFeature(f)
+    assert gdal.VSIStatL("/vsimem/ogr_shape_hrt.hrt") is None
+
+    ds.ExecuteSQL("CREATE SPATIAL INDEX ON ogr_shape_hrt TYPE HILBERT")
+    assert gdal.VSIStatL("/vsimem/ogr_shape_hrt.hrt") is not None
+    lyr.SetSpatialFilterRect(99, 99, 101, 101)
+    assert [f.GetFID() for f in lyr] == [2500]
+    lyr.SetSpatialFilter(None)
+
+    ds.ExecuteSQL("DROP SPATIAL INDEX ON ogr_shape_hrt")
+    assert gdal.VSIStatL("/vsimem/ogr_shape_hrt.hrt") is None
+    ds = None
+
+    ogr.GetDriverByName("ESRI Shapefile").DeleteDataSource(filename)
+
+
+###############################################################################
+# Test that a corrupted packed Hilbert R-tree spatial index is not trusted
+
+
+@pytest.mark.parametrize("corruption", ["truncated", "extra_byte", "bad_leaf_id"])
+def test_ogr_shape_hilbert_spatial_index_corrupted(corruption):
+
+    filename = "/vsimem/ogr_shape_hrt_corrupted.shp"
+    hrt_filename = "/vsimem/ogr_shape_hrt_corrupted.hrt"
+    ds = ogr.GetDriverByName("ESRI Shapefile").CreateDataSource(filename)
+    lyr = ds.CreateLayer(
+        "ogr_shape_hrt_corrupted",
+        geom_type=ogr.wkbPoint,
+        options=["SPATIAL_INDEX=YES", "SPATIAL_INDEX_TYPE=HILBERT"],
+    )
+    for i in range(10):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(ogr.CreateGeometryFromWkt("POINT (%d %d)" % (i, i)))
+        lyr.CreateFeature(f)
+    ds = None
+
+    try:
+        f = gdal.VSIFOpenL(hrt_filename, "rb")
+        data = gdal.VSIFReadL(1, 100000, f)
+        gdal.VSIFCloseL(f)
+        if corruption == "truncated":
+            data = data[0:-1]
+        elif corruption == "extra_byte":
+            data += b"\0"
+        else:
+            # Id of the last leaf
+            data = data[0:-8] + struct.pack("<Q", 1000)
+        gdal.FileFromMemBuffer(hrt_filename, data)
+
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        assert lyr.TestCapability(ogr.OLCFastSpatialFilter) == (
+            corruption == "bad_leaf_id"
+        )
+        lyr.SetSpatialFilterRect(-1, -1, 100, 100)
+        gdal.ErrorReset()
+        with gdaltest.error_handler():
+            assert [f.GetFID() for f in lyr] == list(range(10))
+        if corruption == "bad_leaf_id":
+            assert gdal.GetLastErrorMsg() == "Corrupted spatial index"
+        ds = None
+    finally:
+        ogr.GetDriverByName("ESRI Shapefile").DeleteDataSource(filename)
+        gdal.Unlink(hrt_filename)
+
+
 ###############################################################################
 
 
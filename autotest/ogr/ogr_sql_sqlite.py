@@ -2307,3 +2307,80 @@ def test_ogr_sql_sqlite_attribute_and_geom_field_name_same():
     ds.ReleaseResultSet(sql_lyr)
     assert f["foo"] == "bar"
     assert f.GetGeomFieldRef(0).ExportToWkt() == "POINT (0 0)"
+
+
+###############################################################################
+# Test constraints that are pushed down to the source layer: IN lists,
+# ranges on several columns and ST_Intersects()
+
+
+def test_ogr_sql_sqlite_constraint_pushdown():
+
+    ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+    lyr = ds.CreateLayer("test")
+    lyr.CreateField(ogr.FieldDefn("int", ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    lyr.CreateField(ogr.FieldDefn("str"))
+    for i in range(10):
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["int"] = i
+        f["real"] = i + 0.5
+        f["str"] = "val%d" % i
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt("POINT(%d %d)" % (i, i)))
+        lyr.CreateFeature(f)
+
+    def get_ints(sql):
+        sql_lyr = ds.ExecuteSQL(sql, dialect="SQLite")
+        ret = [f["int"] for f in sql_lyr]
+        ds.ReleaseResultSet(sql_lyr)
+        return ret
+
+    assert get_ints("SELECT int FROM test WHERE int IN (1, 3, NULL, 5)") == [1, 3, 5]
+    assert get_ints("SELECT int FROM test WHERE str IN ('val2', 'val7')") == [2, 7]
+    assert get_ints("SELECT int FROM test WHERE int IN (SELECT 8 UNION SELECT 4)") == [
+        4,
+        8,
+    ]
+    assert get_ints("SELECT int FROM test WHERE int IN (NULL)") == []
+    assert get_ints(
+        "SELECT int FROM test WHERE int >= 2 AND int < 8 AND real > 4 AND real <= 6.5"
+    ) == [4, 5, 6]
+    assert get_ints(
+        "SELECT t1.int FROM test t1 JOIN test t2 ON t1.int = t2.int + 1 "
+        "WHERE t2.str IN ('val0', 'val4') ORDER BY t1.int"
+    ) == [1, 5]
+
+    if not ogrtest.have_geos():
+        pytest.skip("GEOS missing")
+
+    with gdaltest.error_handler():
+        sql_lyr = ds.ExecuteSQL(
+            "SELECT ST_Intersects(ST_GeomFromText('POINT(0 0)'), ST_GeomFromText('POINT(0 0)'))",
+            dialect="SQLite",
+        )
+    if sql_lyr is None:
+        pytest.skip("ST_Intersects() not available")
+    ds.ReleaseResultSet(sql_lyr)
+
+    assert get_ints(
+        "SELECT int FROM test WHERE "
+        "ST_Intersects(geometry, ST_GeomFromText('LINESTRING(1.5 1.5,4.5 4.5)'))"
+    ) == [2, 3, 4]
+    assert get_ints(
+        "SELECT int FROM test WHERE "
+        "ST_Intersects(geometry, ST_GeomFromText('LINESTRING(1.5 4.5,4.5 1.5)'))"
+    ) == [3]
+    assert get_ints(
+        "SELECT int FROM test WHERE int IN (2, 4, 6) AND "
+        "ST_Intersects(geometry, ST_GeomFromText('POLYGON((3 3,3 7,7 7,7 3,3 3))'))"
+    ) == [4, 6]
+    assert (
+        get_ints(
+            "SELECT int FROM test WHERE ST_Intersects(geometry, ST_GeomFromText('POINT EMPTY'))"
+        )
+        == []
+    )
+    assert get_ints(
+        "SELECT t2.int FROM test t1 JOIN test t2 ON ST_Intersects(t2.geometry, t1.geometry) "
+        "WHERE t1.int IN (1, 8) ORDER BY t2.int"
+    ) == [1, 8]
@@ -991,3 +991,130 @@ def test_ogr2ogr_upsert():
     assert f.GetGeometryRef().ExportToWkt() == "POINT (10 10)"
     ds = None
     gdal.Unlink(filename)
+
+
+###############################################################################
+# Test -num_threads
+
+
+@pytest.mark.parametrize("limit", [None, 600])
+def test_ogr2ogr_num_threads(limit):
+
+    if not ogrtest.have_geos():
+        pytest.skip("GEOS not available")
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(32631)
+    src_lyr = src_ds.CreateLayer("test", srs=srs)
+    src_lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    for i in range(1000):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["id"] = i
+        f.SetGeometryDirectly(
+            ogr.CreateGeometryFromWkt(
+                "POLYGON ((%d 0,%d 0,%d 100,%d 100,%d 0))"
+                % (500000 + i, 500100 + i, 500100 + i, 500000 + i, 500000 + i)
+            )
+        )
+        src_lyr.CreateFeature(f)
+
+    options = "-t_srs EPSG:4326 -clipsrc 500000 0 501000 50 -segmentize 10"
+    if limit:
+        options += " -limit %d" % limit
+    ref_ds = gdal.VectorTranslate("", src_ds, format="Memory", options=options)
+    ds = gdal.VectorTranslate(
+        "", src_ds, format="Memory", options=options + " -num_threads 4"
+    )
+
+    ref_lyr = ref_ds.GetLayer(0)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetFeatureCount() == ref_lyr.GetFeatureCount()
+    assert lyr.GetFeatureCount() == (limit if limit else 1000)
+    for ref_f, f in zip(ref_lyr, lyr):
+        assert f["id"] == ref_f["id"]
+        assert f.GetGeometryRef().Equals(ref_f.GetGeometryRef())
+
+
+###############################################################################
+# Test translating through GetArrowStream() / WriteArrowBatch()
+
+
+@pytest.mark.parametrize("options", ["", "-where id>=500", "-select str"])
+def test_ogr2ogr_arrow_api(options):
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(32631)
+    src_lyr = src_ds.CreateLayer("test", srs=srs)
+    src_lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    src_lyr.CreateField(ogr.FieldDefn("str", ogr.OFTString))
+    src_lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    for i in range(1000):
+        f = ogr.Feature(src_lyr.GetLayerDefn())
+        f["id"] = i
+        f["str"] = "foo%d" % i
+        if i % 2:
+            f["real"] = i * 0.5
+        f.SetGeometryDirectly(
+            ogr.CreateGeometryFromWkt("POINT (%d %d)" % (500000 + i, i))
+        )
+        src_lyr.CreateFeature(f)
+
+    ref_ds = gdal.VectorTranslate("", src_ds, format="Memory", options=options)
+    with gdaltest.config_option("OGR2OGR_USE_ARROW_API", "YES"):
+        ds = gdal.VectorTranslate("", src_ds, format="Memory", options=options)
+
+    ref_lyr = ref_ds.GetLayer(0)
+    lyr = ds.GetLayer(0)
+    assert lyr.GetSpatialRef().IsSame(srs)
+    assert lyr.GetFeatureCount() == ref_lyr.GetFeatureCount()
+    for ref_f, f in zip(ref_lyr, lyr):
+        assert f.Equal(ref_f)
+
+
+###############################################################################
+# Test that field type changes fall back to the per-feature path
+
+
+@pytest.mark.parametrize(
+    "options,field_name,expected",
+    [
+        ("-mapFieldType Integer=String", "id", "1"),
+        ("-fieldTypeToString Real", "real", "1.5"),
+    ],
+)
+def test_ogr2ogr_arrow_api_field_type_change(options, field_name, expected):
+
+    src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+    src_lyr = src_ds.CreateLayer("test")
+    src_lyr.CreateField(ogr.FieldDefn("id", ogr.OFTInteger))
+    src_lyr.CreateField(ogr.FieldDefn("real", ogr.OFTReal))
+    f = ogr.Feature(src_lyr.GetLayerDefn())
+    f["id"] = 1
+    f["real"] = 1.5
+    src_lyr.CreateFeature(f)
+
+    debug_msgs = []
+
+    def handler(eErrClass, err_no, msg):
+        if eErrClass == gdal.CE_Debug:
+            debug_msgs.append(msg)
+
+    gdal.PushErrorHandler(handler)
+    try:
+        gdal.SetCurrentErrorHandlerCatchDebug(True)
+        with gdaltest.config_options(
+            {"CPL_DEBUG": "ON", "OGR2OGR_USE_ARROW_API": "YES"}
+        ):
+            ds = gdal.VectorTranslate("", src_ds, format="Memory", options=options)
+    finally:
+        gdal.PopErrorHandler()
+
+    assert not [x for x in debug_msgs if "GetArrowStream()" in x]
+    lyr = ds.GetLayer(0)
+    lyr_defn = lyr.GetLayerDefn()
+    field_defn = lyr_defn.GetFieldDefn(lyr_defn.GetFieldIndex(field_name))
+    assert field_defn.GetType() == ogr.OFTString
+    f = lyr.GetNextFeature()
+    assert f[field_name] == expected
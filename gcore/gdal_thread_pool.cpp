@@ -28,6 +28,10 @@
 
 #include "gdal_thread_pool.h"
 
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
+#include <algorithm>
 #include <mutex>
 
 static std::mutex gMutexThreadPool;
@@ -58,3 +62,23 @@ void GDALDestroyGlobalThreadPool()
     delete gpoCompressThreadPool;
     gpoCompressThreadPool = nullptr;
 }
+
+/************************************************************************/
+/*                         GDALGetNumThreads()                          */
+/************************************************************************/
+
+/** Returns the number of threads requested by the pszOptionName option of
+ * papszOptions, or by the GDAL_NUM_THREADS configuration option when it is
+ * not set. The value is an integer or ALL_CPUS, and the result is clamped
+ * to [1, nMaxThreads]. Returns 1 when neither is set.
+ */
+int GDALGetNumThreads(CSLConstList papszOptions, const char* pszOptionName,
+                      int nMaxThreads)
+{
+    const char* pszValue = CSLFetchNameValue(papszOptions, pszOptionName);
+    if( pszValue == nullptr )
+        pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    return std::max(1, std::min(nThreads, nMaxThreads));
+}
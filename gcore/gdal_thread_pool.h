@@ -33,6 +33,10 @@
 
 CPLWorkerThreadPool CPL_DLL* GDALGetGlobalThreadPool(int nThreads);
 
+int CPL_DLL GDALGetNumThreads(CSLConstList papszOptions,
+                              const char* pszOptionName = "NUM_THREADS",
+                              int nMaxThreads = 128);
+
 void GDALDestroyGlobalThreadPool();
 
 #endif // GDAL_THREAD_POOL_H
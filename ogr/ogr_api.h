@@ -687,6 +687,16 @@ bool CPL_DLL OGR_L_GetArrowStream(OGRLayerH hLayer,
                                   struct ArrowArrayStream* out_stream,
                                   char** papszOptions);
 
+/** Data type for a Arrow C schema. Include ogr_recordbatch.h to get the definition. */
+struct ArrowSchema;
+/** Data type for a Arrow C array. Include ogr_recordbatch.h to get the definition. */
+struct ArrowArray;
+
+bool CPL_DLL OGR_L_WriteArrowBatch(OGRLayerH hLayer,
+                                   const struct ArrowSchema* schema,
+                                   struct ArrowArray* array,
+                                   char** papszOptions);
+
 OGRErr CPL_DLL OGR_L_SetNextByIndex( OGRLayerH, GIntBig );
 OGRFeatureH CPL_DLL OGR_L_GetFeature( OGRLayerH, GIntBig )  CPL_WARN_UNUSED_RESULT;
 OGRErr CPL_DLL OGR_L_SetFeature( OGRLayerH, OGRFeatureH ) CPL_WARN_UNUSED_RESULT;
@@ -465,8 +465,14 @@ class CPL_DLL OGRGeometry
 
     static GEOSContextHandle_t createGEOSContext();
     static void freeGEOSContext( GEOSContextHandle_t hGEOSCtxt );
+    static GEOSContextHandle_t getThreadGEOSContext();
     virtual GEOSGeom exportToGEOS( GEOSContextHandle_t hGEOSCtxt )
         const CPL_WARN_UNUSED_RESULT;
+//! @cond Doxygen_Suppress
+    GEOSGeom       acquireGEOSGeom( GEOSContextHandle_t hGEOSCtxt ) const;
+    void           releaseGEOSGeom( GEOSContextHandle_t hGEOSCtxt,
+                                    GEOSGeom hGeosGeom ) const;
+//! @endcond
     virtual OGRBoolean hasCurveGeometry(int bLookForNonLinear = FALSE) const;
     virtual OGRGeometry* getCurveGeometry(
         const char* const* papszOptions = nullptr ) const CPL_WARN_UNUSED_RESULT;
@@ -852,6 +858,37 @@ struct CPL_DLL OGRGeometryUniquePtrDeleter
  */
 typedef std::unique_ptr<OGRGeometry, OGRGeometryUniquePtrDeleter> OGRGeometryUniquePtr;
 
+/************************************************************************/
+/*                         OGRGeometryGEOSCache                         */
+/************************************************************************/
+
+/**
+ * Retains the GEOS conversion of a geometry, while this object lives.
+ *
+ * Normally each GEOS based method of OGRGeometry (Intersects(),
+ * Intersection(), Buffer(), ...) converts the geometry to GEOS and discards
+ * the result. While an OGRGeometryGEOSCache exists for a geometry, the
+ * conversion is done by the first such operation run from the calling
+ * thread, and reused by the next ones. This is useful when the same geometry
+ * is involved in many operations, such as being intersected with all
+ * features of a layer. Operations run from other threads are not affected.
+ *
+ * The geometry must not be modified or destroyed while the cache exists,
+ * and the cache must be destroyed by the thread that created it.
+ *
+ * @since GDAL 3.7
+ */
+class CPL_DLL OGRGeometryGEOSCache
+{
+    const OGRGeometry  *m_poGeom = nullptr;
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRGeometryGEOSCache)
+
+  public:
+    explicit OGRGeometryGEOSCache( const OGRGeometry* poGeom );
+    ~OGRGeometryGEOSCache();
+};
+
 
 //! @cond Doxygen_Suppress
 #define OGR_FORBID_DOWNCAST_TO(name) \
@@ -266,3 +266,540 @@ const GByte* WKBFromEWKB( GByte *pabyEWKB, size_t nEWKBSize,
 
     return pabyWKB;
 }
+
+/************************************************************************/
+/*                        OGRWKBPointSequence                           */
+/************************************************************************/
+
+namespace {
+
+/** Sequence of points of a WKB geometry, as reported by OGRWKBWalk() */
+struct OGRWKBPointSequence
+{
+    const GByte* pabyPoints = nullptr;
+    uint32_t     nPoints = 0;
+    int          nDim = 2;
+    bool         bNeedSwap = false;
+    bool         bArc = false;      // sequence of a CircularString
+    int          nPolygonIdx = -1;  // index of the enclosing (curve)polygon,
+                                    // or -1 if not part of a polygon boundary
+
+    double GetX(uint32_t i) const
+    {
+        return OGRWKBReadFloat64(pabyPoints + i * nDim * sizeof(double),
+                                 bNeedSwap);
+    }
+
+    double GetY(uint32_t i) const
+    {
+        return OGRWKBReadFloat64(pabyPoints + i * nDim * sizeof(double) +
+                                    sizeof(double), bNeedSwap);
+    }
+};
+
+constexpr int OGR_WKB_MAX_RECURSION_LEVEL = 128;
+
+} // namespace
+
+/************************************************************************/
+/*                        OGRWKBWalkInternal()                          */
+/************************************************************************/
+
+template<class Callback>
+static bool OGRWKBWalkInternal(const GByte* pabyWkb, size_t nWKBSize,
+                               size_t& iOffset, int nRec,
+                               int nPolygonIdx, int& nPolygonCounter,
+                               Callback& oCallback, bool bISOOnly = false)
+{
+    if( nRec == OGR_WKB_MAX_RECURSION_LEVEL ||
+        nWKBSize - iOffset < 1 + sizeof(uint32_t) )
+        return false;
+
+    // Reject non-ISO byte orders and type codes (OGC SFSQL 1.2 / PostGIS 1.x
+    // 2.5D flag, PostGIS EWKB flags)
+    if( bISOOnly &&
+        ((pabyWkb[iOffset] != wkbNDR && pabyWkb[iOffset] != wkbXDR) ||
+         (OGRWKBReadUInt32(pabyWkb + iOffset + 1,
+                           OGR_SWAP(static_cast<OGRwkbByteOrder>(
+                                                pabyWkb[iOffset]))) &
+          0xE0000000U) != 0) )
+    {
+        return false;
+    }
+
+    OGRwkbGeometryType eGeomType = wkbUnknown;
+    if( OGRReadWKBGeometryType(pabyWkb + iOffset, wkbVariantIso,
+                               &eGeomType) != OGRERR_NONE )
+        return false;
+    const bool bNeedSwap = OGR_SWAP(static_cast<OGRwkbByteOrder>(
+                                DB2_V72_FIX_BYTE_ORDER(pabyWkb[iOffset])));
+    iOffset += 1 + sizeof(uint32_t);
+
+    OGRWKBPointSequence oSeq;
+    oSeq.nDim = 2 + (OGR_GT_HasZ(eGeomType) ? 1 : 0) +
+                    (OGR_GT_HasM(eGeomType) ? 1 : 0);
+    oSeq.bNeedSwap = bNeedSwap;
+    oSeq.nPolygonIdx = nPolygonIdx;
+    const size_t nPointSize = oSeq.nDim * sizeof(double);
+
+    const auto eFlatType = wkbFlatten(eGeomType);
+    switch( eFlatType )
+    {
+        case wkbPoint:
+        {
+            if( nWKBSize - iOffset < nPointSize )
+                return false;
+            oSeq.pabyPoints = pabyWkb + iOffset;
+            oSeq.nPoints = 1;
+            iOffset += nPointSize;
+            return oCallback(oSeq);
+        }
+
+        case wkbLineString:
+        case wkbCircularString:
+        {
+            if( nWKBSize - iOffset < sizeof(uint32_t) )
+                return false;
+            oSeq.nPoints = OGRWKBReadUInt32(pabyWkb + iOffset, bNeedSwap);
+            iOffset += sizeof(uint32_t);
+            if( oSeq.nPoints > (nWKBSize - iOffset) / nPointSize )
+                return false;
+            oSeq.pabyPoints = pabyWkb + iOffset;
+            oSeq.bArc = eFlatType == wkbCircularString;
+            iOffset += oSeq.nPoints * nPointSize;
+            return oCallback(oSeq);
+        }
+
+        case wkbPolygon:
+        case wkbTriangle:
+        {
+            if( nWKBSize - iOffset < sizeof(uint32_t) )
+                return false;
+            const uint32_t nRings = OGRWKBReadUInt32(pabyWkb + iOffset, bNeedSwap);
+            iOffset += sizeof(uint32_t);
+            if( nRings > (nWKBSize - iOffset) / sizeof(uint32_t) )
+                return false;
+            oSeq.nPolygonIdx = nPolygonCounter++;
+            for( uint32_t iRing = 0; iRing < nRings; ++iRing )
+            {
+                if( nWKBSize - iOffset < sizeof(uint32_t) )
+                    return false;
+                oSeq.nPoints = OGRWKBReadUInt32(pabyWkb + iOffset, bNeedSwap);
+                iOffset += sizeof(uint32_t);
+                if( oSeq.nPoints > (nWKBSize - iOffset) / nPointSize )
+                    return false;
+                oSeq.pabyPoints = pabyWkb + iOffset;
+                iOffset += oSeq.nPoints * nPointSize;
+                if( !oCallback(oSeq) )
+                    return false;
+            }
+            return true;
+        }
+
+        case wkbMultiPoint:
+        case wkbMultiLineString:
+        case wkbMultiPolygon:
+        case wkbGeometryCollection:
+        case wkbCompoundCurve:
+        case wkbCurvePolygon:
+        case wkbMultiCurve:
+        case wkbMultiSurface:
+        case wkbPolyhedralSurface:
+        case wkbTIN:
+        {
+            if( nWKBSize - iOffset < sizeof(uint32_t) )
+                return false;
+            const uint32_t nParts = OGRWKBReadUInt32(pabyWkb + iOffset, bNeedSwap);
+            iOffset += sizeof(uint32_t);
+            if( nParts > (nWKBSize - iOffset) / (1 + sizeof(uint32_t)) )
+                return false;
+            // The rings of a CurvePolygon are sub-geometries on their own
+            const int nSubPolygonIdx = eFlatType == wkbCurvePolygon ?
+                                    nPolygonCounter++ : nPolygonIdx;
+            for( uint32_t i = 0; i < nParts; ++i )
+            {
+                if( !OGRWKBWalkInternal(pabyWkb, nWKBSize, iOffset, nRec + 1,
+                                        nSubPolygonIdx, nPolygonCounter,
+                                        oCallback, bISOOnly) )
+                    return false;
+            }
+            return true;
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                            OGRWKBWalk()                              */
+/************************************************************************/
+
+// Calls oCallback(const OGRWKBPointSequence&) on each point sequence of the
+// geometry, until it returns false.
+// Returns false if the WKB is corrupted or if the callback returned false.
+template<class Callback>
+static bool OGRWKBWalk(const GByte* pabyWkb, size_t nWKBSize,
+                       Callback& oCallback)
+{
+    size_t iOffset = 0;
+    int nPolygonCounter = 0;
+    return OGRWKBWalkInternal(pabyWkb, nWKBSize, iOffset, 0, -1,
+                              nPolygonCounter, oCallback);
+}
+
+/************************************************************************/
+/*                  OGRWKBSegmentIntersectsEnvelope()                   */
+/************************************************************************/
+
+// Liang-Barsky clipping of the [(x0,y0),(x1,y1)] segment against the envelope
+static bool OGRWKBSegmentIntersectsEnvelope(double x0, double y0,
+                                            double x1, double y1,
+                                            const OGREnvelope& sEnvelope)
+{
+    const double dx = x1 - x0;
+    const double dy = y1 - y0;
+    const double p[4] = { -dx, dx, -dy, dy };
+    const double q[4] = { x0 - sEnvelope.MinX, sEnvelope.MaxX - x0,
+                          y0 - sEnvelope.MinY, sEnvelope.MaxY - y0 };
+    double t0 = 0.0;
+    double t1 = 1.0;
+    for( int i = 0; i < 4; ++i )
+    {
+        if( p[i] == 0.0 )
+        {
+            if( q[i] < 0.0 )
+                return false;
+        }
+        else
+        {
+            const double t = q[i] / p[i];
+            if( p[i] < 0.0 )
+            {
+                if( t > t1 )
+                    return false;
+                if( t > t0 )
+                    t0 = t;
+            }
+            else
+            {
+                if( t < t0 )
+                    return false;
+                if( t < t1 )
+                    t1 = t;
+            }
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                       OGRWKBEnvelopeContains()                       */
+/************************************************************************/
+
+static inline bool OGRWKBEnvelopeContains(const OGREnvelope& sEnvelope,
+                                          double dfX, double dfY)
+{
+    return dfX >= sEnvelope.MinX && dfX <= sEnvelope.MaxX &&
+           dfY >= sEnvelope.MinY && dfY <= sEnvelope.MaxY;
+}
+
+/************************************************************************/
+/*                        OGRWKBRayCrossesSegment()                     */
+/************************************************************************/
+
+// Whether the horizontal ray starting at (dfX, dfY) towards +infinity
+// crosses the [(x0,y0),(x1,y1)] segment (even-odd rule)
+static inline bool OGRWKBRayCrossesSegment(double dfX, double dfY,
+                                           double x0, double y0,
+                                           double x1, double y1)
+{
+    return ((y0 > dfY) != (y1 > dfY)) &&
+           dfX < (x1 - x0) * (dfY - y0) / (y1 - y0) + x0;
+}
+
+/************************************************************************/
+/*                         OGRWKBGeometryView()                         */
+/************************************************************************/
+
+/** Constructor.
+ *
+ * @param pabyWkb WKB buffer. Must remain valid during the lifetime of the view
+ * @param nWKBSize size of pabyWkb in bytes
+ */
+OGRWKBGeometryView::OGRWKBGeometryView(const GByte* pabyWkb, size_t nWKBSize):
+    m_pabyWkb(pabyWkb), m_nWKBSize(nWKBSize)
+{
+    m_bValid = pabyWkb != nullptr && nWKBSize >= 1 + sizeof(uint32_t) &&
+               OGRReadWKBGeometryType(pabyWkb, wkbVariantIso, &m_eType) == OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                               IsEmpty()                              */
+/************************************************************************/
+
+/** Returns whether the geometry has no (non-NaN) vertex.
+ *
+ * Invalid or corrupted WKB are considered as empty.
+ */
+bool OGRWKBGeometryView::IsEmpty() const
+{
+    if( !m_bValid )
+        return true;
+    bool bHasPoint = false;
+    auto oCallback = [&bHasPoint](const OGRWKBPointSequence& oSeq)
+    {
+        for( uint32_t i = 0; i < oSeq.nPoints; ++i )
+        {
+            if( !std::isnan(oSeq.GetX(i)) )
+            {
+                bHasPoint = true;
+                return false;
+            }
+        }
+        return true;
+    };
+    OGRWKBWalk(m_pabyWkb, m_nWKBSize, oCallback);
+    return !bHasPoint;
+}
+
+/************************************************************************/
+/*                              IsValidISO()                            */
+/************************************************************************/
+
+/** Returns whether the whole buffer is a well-formed ISO WKB geometry.
+ *
+ * Contrary to IsValid(), which only parses the header, all (sub-)geometries
+ * are checked: their type codes must be ISO ones (OGC SFSQL 1.2 / PostGIS 1.x
+ * 2.5D codes and PostGIS EWKB flags are rejected), their content must not be
+ * truncated, and the buffer must not contain trailing bytes.
+ */
+bool OGRWKBGeometryView::IsValidISO() const
+{
+    if( !m_bValid )
+        return false;
+    auto oCallback = [](const OGRWKBPointSequence&) { return true; };
+    size_t iOffset = 0;
+    int nPolygonCounter = 0;
+    return OGRWKBWalkInternal(m_pabyWkb, m_nWKBSize, iOffset, 0, -1,
+                              nPolygonCounter, oCallback, true) &&
+           iOffset == m_nWKBSize;
+}
+
+/************************************************************************/
+/*                               HasCurve()                             */
+/************************************************************************/
+
+/** Returns whether the geometry contains circular arcs. */
+bool OGRWKBGeometryView::HasCurve() const
+{
+    if( !m_bValid )
+        return false;
+    bool bHasArc = false;
+    auto oCallback = [&bHasArc](const OGRWKBPointSequence& oSeq)
+    {
+        bHasArc = oSeq.bArc;
+        return !bHasArc;
+    };
+    OGRWKBWalk(m_pabyWkb, m_nWKBSize, oCallback);
+    return bHasArc;
+}
+
+/************************************************************************/
+/*                             GetEnvelope()                            */
+/************************************************************************/
+
+/** Computes the 2D envelope of the geometry.
+ *
+ * For an empty geometry, the returned envelope is not initialized
+ * (sEnvelope.IsInit() == false).
+ *
+ * @return false if the WKB is corrupted, or if the geometry contains circular
+ * arcs, whose extent cannot be derived from their vertices only.
+ */
+bool OGRWKBGeometryView::GetEnvelope(OGREnvelope& sEnvelope) const
+{
+    sEnvelope = OGREnvelope();
+    if( !m_bValid )
+        return false;
+    bool bHasArc = false;
+    auto oCallback = [&sEnvelope, &bHasArc](const OGRWKBPointSequence& oSeq)
+    {
+        if( oSeq.bArc )
+        {
+            bHasArc = true;
+            return false;
+        }
+        for( uint32_t i = 0; i < oSeq.nPoints; ++i )
+        {
+            const double dfX = oSeq.GetX(i);
+            if( !std::isnan(dfX) )
+                sEnvelope.Merge(dfX, oSeq.GetY(i));
+        }
+        return true;
+    };
+    return OGRWKBWalk(m_pabyWkb, m_nWKBSize, oCallback);
+}
+
+/************************************************************************/
+/*                            ForEachPoint()                            */
+/************************************************************************/
+
+/** Calls oFunc(dfX, dfY) on each vertex of the geometry, until it returns
+ * false.
+ *
+ * The vertices of circular arcs are their control points.
+ *
+ * @return false if the WKB is corrupted.
+ */
+bool OGRWKBGeometryView::ForEachPoint(
+            const std::function<bool(double dfX, double dfY)>& oFunc) const
+{
+    if( !m_bValid )
+        return false;
+    bool bStopped = false;
+    auto oCallback = [&oFunc, &bStopped](const OGRWKBPointSequence& oSeq)
+    {
+        for( uint32_t i = 0; i < oSeq.nPoints; ++i )
+        {
+            if( !oFunc(oSeq.GetX(i), oSeq.GetY(i)) )
+            {
+                bStopped = true;
+                return false;
+            }
+        }
+        return true;
+    };
+    return OGRWKBWalk(m_pabyWkb, m_nWKBSize, oCallback) || bStopped;
+}
+
+/************************************************************************/
+/*                         IntersectsEnvelope()                         */
+/************************************************************************/
+
+/** Returns whether the geometry intersects the passed envelope.
+ *
+ * The test is exact for geometries made of linear segments. It is pessimistic
+ * (returns true) for geometries that contain circular arcs.
+ * Returns false for corrupted WKB.
+ */
+bool OGRWKBGeometryView::IntersectsEnvelope(const OGREnvelope& sEnvelope) const
+{
+    if( !m_bValid )
+        return false;
+
+    // If no vertex is inside the envelope and no segment crosses it, the
+    // envelope is either completely inside or completely outside each
+    // polygon, so it is enough to test one of its corners.
+    const double dfRefX = sEnvelope.MinX;
+    const double dfRefY = sEnvelope.MinY;
+    bool bIntersects = false;
+    bool bHasArc = false;
+    int nCurPolygonIdx = -1;
+    bool bRefInsidePolygon = false;
+    auto oCallback = [&](const OGRWKBPointSequence& oSeq)
+    {
+        if( oSeq.bArc )
+        {
+            bHasArc = true;
+            return false;
+        }
+        if( oSeq.nPolygonIdx != nCurPolygonIdx )
+        {
+            if( bRefInsidePolygon )
+            {
+                bIntersects = true;
+                return false;
+            }
+            nCurPolygonIdx = oSeq.nPolygonIdx;
+        }
+        if( oSeq.nPoints == 0 )
+            return true;
+        double x0 = oSeq.GetX(0);
+        double y0 = oSeq.GetY(0);
+        if( OGRWKBEnvelopeContains(sEnvelope, x0, y0) )
+        {
+            bIntersects = true;
+            return false;
+        }
+        for( uint32_t i = 1; i < oSeq.nPoints; ++i )
+        {
+            const double x1 = oSeq.GetX(i);
+            const double y1 = oSeq.GetY(i);
+            if( OGRWKBSegmentIntersectsEnvelope(x0, y0, x1, y1, sEnvelope) )
+            {
+                bIntersects = true;
+                return false;
+            }
+            if( oSeq.nPolygonIdx >= 0 &&
+                OGRWKBRayCrossesSegment(dfRefX, dfRefY, x0, y0, x1, y1) )
+            {
+                bRefInsidePolygon = !bRefInsidePolygon;
+            }
+            x0 = x1;
+            y0 = y1;
+        }
+        return true;
+    };
+    if( OGRWKBWalk(m_pabyWkb, m_nWKBSize, oCallback) )
+        return bRefInsidePolygon;
+    return bIntersects || bHasArc;
+}
+
+/************************************************************************/
+/*                            ContainsPoint()                           */
+/************************************************************************/
+
+/** Returns whether the point is inside one of the polygons of the geometry.
+ *
+ * Only (multi)polygons, triangles, polyhedral surfaces and TINs, or
+ * collections of them, can contain a point. The even-odd rule is used, and
+ * points exactly on the boundary may be reported as inside or outside.
+ * Returns false for geometries that contain circular arcs and for corrupted
+ * WKB.
+ */
+bool OGRWKBGeometryView::ContainsPoint(double dfX, double dfY) const
+{
+    if( !m_bValid )
+        return false;
+
+    bool bContains = false;
+    bool bHasArc = false;
+    int nCurPolygonIdx = -1;
+    bool bInsidePolygon = false;
+    auto oCallback = [&](const OGRWKBPointSequence& oSeq)
+    {
+        if( oSeq.bArc )
+        {
+            bHasArc = true;
+            return false;
+        }
+        if( oSeq.nPolygonIdx != nCurPolygonIdx )
+        {
+            if( bInsidePolygon )
+            {
+                bContains = true;
+                return false;
+            }
+            nCurPolygonIdx = oSeq.nPolygonIdx;
+        }
+        if( oSeq.nPolygonIdx < 0 || oSeq.nPoints == 0 )
+            return true;
+        double x0 = oSeq.GetX(0);
+        double y0 = oSeq.GetY(0);
+        for( uint32_t i = 1; i < oSeq.nPoints; ++i )
+        {
+            const double x1 = oSeq.GetX(i);
+            const double y1 = oSeq.GetY(i);
+            if( OGRWKBRayCrossesSegment(dfX, dfY, x0, y0, x1, y1) )
+                bInsidePolygon = !bInsidePolygon;
+            x0 = x1;
+            y0 = y1;
+        }
+        return true;
+    };
+    if( OGRWKBWalk(m_pabyWkb, m_nWKBSize, oCallback) )
+        return bInsidePolygon;
+    return bContains && !bHasArc;
+}
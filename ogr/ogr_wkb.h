@@ -30,6 +30,9 @@
 #define OGR_WKB_H_INCLUDED
 
 #include "cpl_port.h"
+#include "ogr_core.h"
+
+#include <functional>
 
 bool OGRWKBGetGeomType(const GByte* pabyWkb, size_t nWKBSize,
                        bool& bNeedSwap, uint32_t& nType);
@@ -46,4 +49,44 @@ bool OGRWKBMultiPolygonGetArea(const GByte*& pabyWkb, size_t& nWKBSize, double&
  */
 const GByte CPL_DLL *WKBFromEWKB( GByte *pabyEWKB, size_t nEWKBSize, size_t& nWKBSizeOut, int* pnSRIDOut );
 
+/************************************************************************/
+/*                         OGRWKBGeometryView                           */
+/************************************************************************/
+
+/** Read-only view over a WKB geometry buffer.
+ *
+ * Gives access to the geometry type, envelope and vertices of a ISO WKB
+ * (or OGC SFSQL 1.2 / PostGIS 1.x 2.5D) geometry, and evaluates simple
+ * predicates, without instantiating a OGRGeometry object.
+ *
+ * The view does not copy nor take ownership of the buffer, which must
+ * remain valid for the lifetime of the view.
+ *
+ * @since GDAL 3.7
+ */
+class CPL_DLL OGRWKBGeometryView
+{
+    const GByte* m_pabyWkb = nullptr;
+    size_t m_nWKBSize = 0;
+    bool m_bValid = false;
+    OGRwkbGeometryType m_eType = wkbUnknown;
+
+  public:
+    OGRWKBGeometryView(const GByte* pabyWkb, size_t nWKBSize);
+
+    /** Whether the WKB header could be parsed */
+    bool IsValid() const { return m_bValid; }
+
+    /** Geometry type, as read from the WKB header */
+    OGRwkbGeometryType GetGeometryType() const { return m_eType; }
+
+    bool IsValidISO() const;
+    bool IsEmpty() const;
+    bool HasCurve() const;
+    bool GetEnvelope(OGREnvelope& sEnvelope) const;
+    bool ForEachPoint(const std::function<bool(double dfX, double dfY)>& oFunc) const;
+    bool IntersectsEnvelope(const OGREnvelope& sEnvelope) const;
+    bool ContainsPoint(double dfX, double dfY) const;
+};
+
 #endif // OGR_WKB_H_INCLUDED
@@ -38,6 +38,8 @@
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -527,9 +529,9 @@ OGRBoolean OGRGeometry::Intersects( const OGRGeometry *poOtherGeom ) const
 #else
 
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
-    GEOSGeom hThisGeosGeom  = exportToGEOS(hGEOSCtxt);
-    GEOSGeom hOtherGeosGeom = poOtherGeom->exportToGEOS(hGEOSCtxt);
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
+    GEOSGeom hThisGeosGeom  = acquireGEOSGeom(hGEOSCtxt);
+    GEOSGeom hOtherGeosGeom = poOtherGeom->acquireGEOSGeom(hGEOSCtxt);
 
     OGRBoolean bResult = FALSE;
     if( hThisGeosGeom != nullptr && hOtherGeosGeom != nullptr )
@@ -538,9 +540,8 @@ OGRBoolean OGRGeometry::Intersects( const OGRGeometry *poOtherGeom ) const
             GEOSIntersects_r( hGEOSCtxt, hThisGeosGeom, hOtherGeosGeom ) != 0;
     }
 
-    GEOSGeom_destroy_r( hGEOSCtxt, hThisGeosGeom );
-    GEOSGeom_destroy_r( hGEOSCtxt, hOtherGeosGeom );
-    freeGEOSContext( hGEOSCtxt );
+    releaseGEOSGeom( hGEOSCtxt, hThisGeosGeom );
+    poOtherGeom->releaseGEOSGeom( hGEOSCtxt, hOtherGeosGeom );
 
     return bResult;
 #endif  // HAVE_GEOS
@@ -2276,7 +2277,7 @@ OGRGeometry::IsSimple() const
 
     OGRBoolean bResult = FALSE;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
     GEOSGeom hThisGeosGeom = exportToGEOS(hGEOSCtxt);
 
     if( hThisGeosGeom != nullptr )
@@ -2284,7 +2285,6 @@ OGRGeometry::IsSimple() const
         bResult = GEOSisSimple_r( hGEOSCtxt, hThisGeosGeom );
         GEOSGeom_destroy_r( hGEOSCtxt, hThisGeosGeom );
     }
-    freeGEOSContext( hGEOSCtxt );
 
     return bResult;
 
@@ -2348,7 +2348,7 @@ OGRGeometry::IsRing() const
 
     OGRBoolean bResult = FALSE;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
     GEOSGeom hThisGeosGeom = exportToGEOS(hGEOSCtxt);
 
     if( hThisGeosGeom != nullptr )
@@ -2356,7 +2356,6 @@ OGRGeometry::IsRing() const
         bResult = GEOSisRing_r( hGEOSCtxt, hThisGeosGeom );
         GEOSGeom_destroy_r( hGEOSCtxt, hThisGeosGeom );
     }
-    freeGEOSContext( hGEOSCtxt );
 
     return bResult;
 
@@ -3032,6 +3031,214 @@ void OGRGeometry::freeGEOSContext(
 #endif
 }
 
+/************************************************************************/
+/*                        OGRGEOSContextHolder                          */
+/************************************************************************/
+
+#ifdef HAVE_GEOS
+namespace {
+struct OGRGEOSContextHolder
+{
+    GEOSContextHandle_t hGEOSCtxt = nullptr;
+
+    // GEOS conversions retained by the OGRGeometryGEOSCache objects of the
+    // thread. The GEOS geometry is null until first needed.
+    std::vector<std::pair<const OGRGeometry*, GEOSGeom>> aoCachedGeoms{};
+
+    OGRGEOSContextHolder():
+        hGEOSCtxt(initGEOS_r( OGRGEOSWarningHandler, OGRGEOSErrorHandler )) {}
+
+    ~OGRGEOSContextHolder()
+    {
+        if( hGEOSCtxt != nullptr )
+        {
+            for( const auto& oCached: aoCachedGeoms )
+            {
+                if( oCached.second != nullptr )
+                    GEOSGeom_destroy_r( hGEOSCtxt, oCached.second );
+            }
+            finishGEOS_r( hGEOSCtxt );
+        }
+    }
+
+    OGRGEOSContextHolder(const OGRGEOSContextHolder&) = delete;
+    OGRGEOSContextHolder& operator=(const OGRGEOSContextHolder&) = delete;
+};
+} // namespace
+
+#ifdef WIN32
+// Currently thread_local and C++ objects don't work well with DLL on Windows
+static void FreeGEOSTLSContextHolder( void* pData )
+{
+    delete static_cast<OGRGEOSContextHolder*>(pData);
+}
+
+static OGRGEOSContextHolder* GetGEOSTLSContextHolder()
+{
+    int bMemoryErrorOccurred = false;
+    void* pData = CPLGetTLSEx(CTLS_GEOSCONTEXTHOLDER, &bMemoryErrorOccurred);
+    if( bMemoryErrorOccurred )
+    {
+        return nullptr;
+    }
+    if( pData == nullptr )
+    {
+        auto pHolder = new OGRGEOSContextHolder();
+        CPLSetTLSWithFreeFuncEx( CTLS_GEOSCONTEXTHOLDER,
+                                 pHolder,
+                                 FreeGEOSTLSContextHolder, &bMemoryErrorOccurred );
+        if( bMemoryErrorOccurred )
+        {
+            delete pHolder;
+            return nullptr;
+        }
+        return pHolder;
+    }
+    return static_cast<OGRGEOSContextHolder*>(pData);
+}
+#else
+static thread_local OGRGEOSContextHolder g_tls_oGEOSContextHolder;
+
+static OGRGEOSContextHolder* GetGEOSTLSContextHolder()
+{
+    return &g_tls_oGEOSContextHolder;
+}
+#endif
+
+static GEOSContextHandle_t GetGEOSTLSContext()
+{
+    OGRGEOSContextHolder* pHolder = GetGEOSTLSContextHolder();
+    return pHolder ? pHolder->hGEOSCtxt : nullptr;
+}
+#endif // HAVE_GEOS
+
+/************************************************************************/
+/*                        getThreadGEOSContext()                        */
+/************************************************************************/
+
+/** Returns the GEOS context of the current thread.
+ *
+ * Contrary to createGEOSContext(), the returned context is owned by GDAL and
+ * reused by all GEOS based operations run from the current thread. It must
+ * not be freed with freeGEOSContext(), nor used from another thread.
+ *
+ * @return the GEOS context of the current thread, or NULL.
+ * @since GDAL 3.7
+ */
+GEOSContextHandle_t OGRGeometry::getThreadGEOSContext()
+{
+#ifndef HAVE_GEOS
+    CPLError( CE_Failure, CPLE_NotSupported,
+              "GEOS support not enabled." );
+    return nullptr;
+#else
+    return GetGEOSTLSContext();
+#endif
+}
+
+/************************************************************************/
+/*                        OGRGeometryGEOSCache()                        */
+/************************************************************************/
+
+/** Constructor.
+ *
+ * @param poGeom the geometry whose GEOS conversion must be retained. It must
+ * outlive this object, and not be modified while it exists.
+ */
+OGRGeometryGEOSCache::OGRGeometryGEOSCache(
+    UNUSED_IF_NO_GEOS const OGRGeometry* poGeom )
+{
+#ifdef HAVE_GEOS
+    OGRGEOSContextHolder* pHolder = GetGEOSTLSContextHolder();
+    if( pHolder != nullptr && pHolder->hGEOSCtxt != nullptr )
+    {
+        m_poGeom = poGeom;
+        pHolder->aoCachedGeoms.emplace_back(poGeom, nullptr);
+    }
+#endif
+}
+
+/************************************************************************/
+/*                       ~OGRGeometryGEOSCache()                        */
+/************************************************************************/
+
+/** Destructor. Destroys the retained GEOS conversion. */
+OGRGeometryGEOSCache::~OGRGeometryGEOSCache()
+{
+#ifdef HAVE_GEOS
+    if( m_poGeom == nullptr )
+        return;
+    OGRGEOSContextHolder* pHolder = GetGEOSTLSContextHolder();
+    if( pHolder == nullptr )
+        return;
+    auto& aoCachedGeoms = pHolder->aoCachedGeoms;
+    for( size_t i = aoCachedGeoms.size(); i > 0; )
+    {
+        --i;
+        if( aoCachedGeoms[i].first == m_poGeom )
+        {
+            if( aoCachedGeoms[i].second != nullptr )
+                GEOSGeom_destroy_r( pHolder->hGEOSCtxt,
+                                    aoCachedGeoms[i].second );
+            aoCachedGeoms.erase(aoCachedGeoms.begin() + i);
+            break;
+        }
+    }
+#endif
+}
+
+/************************************************************************/
+/*                          acquireGEOSGeom()                           */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/** Returns the GEOS geometry to use for a read-only GEOS operation. It must
+ * be released with releaseGEOSGeom().
+ */
+GEOSGeom OGRGeometry::acquireGEOSGeom( GEOSContextHandle_t hGEOSCtxt ) const
+{
+#ifdef HAVE_GEOS
+    OGRGEOSContextHolder* pHolder = GetGEOSTLSContextHolder();
+    if( pHolder != nullptr && pHolder->hGEOSCtxt == hGEOSCtxt )
+    {
+        for( auto& oCached: pHolder->aoCachedGeoms )
+        {
+            if( oCached.first == this )
+            {
+                if( oCached.second == nullptr )
+                    oCached.second = exportToGEOS(hGEOSCtxt);
+                return oCached.second;
+            }
+        }
+    }
+#endif
+    return exportToGEOS(hGEOSCtxt);
+}
+
+/************************************************************************/
+/*                          releaseGEOSGeom()                           */
+/************************************************************************/
+
+void OGRGeometry::releaseGEOSGeom( UNUSED_IF_NO_GEOS GEOSContextHandle_t hGEOSCtxt,
+                                   UNUSED_IF_NO_GEOS GEOSGeom hGeosGeom ) const
+{
+#ifdef HAVE_GEOS
+    if( hGeosGeom == nullptr )
+        return;
+    OGRGEOSContextHolder* pHolder = GetGEOSTLSContextHolder();
+    if( pHolder != nullptr && pHolder->hGEOSCtxt == hGEOSCtxt )
+    {
+        for( const auto& oCached: pHolder->aoCachedGeoms )
+        {
+            if( oCached.second == hGeosGeom )
+                return;
+        }
+    }
+    GEOSGeom_destroy_r( hGEOSCtxt, hGeosGeom );
+#endif
+}
+//! @endcond
+
 #ifdef HAVE_GEOS
 
 /************************************************************************/
@@ -3341,10 +3548,10 @@ double OGRGeometry::Distance( const OGRGeometry *poOtherGeom ) const
 
     #else
 
-        GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
+        GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
         // GEOSGeom is a pointer
-        GEOSGeom hOther = poOtherGeom->exportToGEOS(hGEOSCtxt);
-        GEOSGeom hThis = exportToGEOS(hGEOSCtxt);
+        GEOSGeom hOther = poOtherGeom->acquireGEOSGeom(hGEOSCtxt);
+        GEOSGeom hThis = acquireGEOSGeom(hGEOSCtxt);
 
         int bIsErr = 0;
         double dfDistance = 0.0;
@@ -3354,9 +3561,8 @@ double OGRGeometry::Distance( const OGRGeometry *poOtherGeom ) const
             bIsErr = GEOSDistance_r( hGEOSCtxt, hThis, hOther, &dfDistance );
         }
 
-        GEOSGeom_destroy_r( hGEOSCtxt, hThis );
-        GEOSGeom_destroy_r( hGEOSCtxt, hOther );
-        freeGEOSContext( hGEOSCtxt );
+        releaseGEOSGeom( hGEOSCtxt, hThis );
+        poOtherGeom->releaseGEOSGeom( hGEOSCtxt, hOther );
 
         if ( bIsErr > 0 )
         {
@@ -3570,9 +3776,9 @@ static OGRGeometry* BuildGeometryFromTwoGeoms(
 {
     OGRGeometry *poOGRProduct = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = poSelf->createGEOSContext();
-    GEOSGeom hThisGeosGeom = poSelf->exportToGEOS(hGEOSCtxt);
-    GEOSGeom hOtherGeosGeom = poOtherGeom->exportToGEOS(hGEOSCtxt);
+    GEOSContextHandle_t hGEOSCtxt = OGRGeometry::getThreadGEOSContext();
+    GEOSGeom hThisGeosGeom = poSelf->acquireGEOSGeom(hGEOSCtxt);
+    GEOSGeom hOtherGeosGeom = poOtherGeom->acquireGEOSGeom(hGEOSCtxt);
     if( hThisGeosGeom != nullptr && hOtherGeosGeom != nullptr )
     {
         GEOSGeom hGeosProduct = pfnGEOSFunction_r(
@@ -3581,9 +3787,8 @@ static OGRGeometry* BuildGeometryFromTwoGeoms(
         poOGRProduct = BuildGeometryFromGEOS(hGEOSCtxt, hGeosProduct,
                                              poSelf, poOtherGeom);
     }
-    GEOSGeom_destroy_r( hGEOSCtxt, hThisGeosGeom );
-    GEOSGeom_destroy_r( hGEOSCtxt, hOtherGeosGeom );
-    poSelf->freeGEOSContext( hGEOSCtxt );
+    poSelf->releaseGEOSGeom( hGEOSCtxt, hThisGeosGeom );
+    poOtherGeom->releaseGEOSGeom( hGEOSCtxt, hOtherGeosGeom );
 
     return poOGRProduct;
 }
@@ -3601,16 +3806,15 @@ static OGRBoolean OGRGEOSBooleanPredicate(
 {
     OGRBoolean bResult = FALSE;
 
-    GEOSContextHandle_t hGEOSCtxt = poSelf->createGEOSContext();
-    GEOSGeom hThisGeosGeom = poSelf->exportToGEOS(hGEOSCtxt);
-    GEOSGeom hOtherGeosGeom = poOtherGeom->exportToGEOS(hGEOSCtxt);
+    GEOSContextHandle_t hGEOSCtxt = OGRGeometry::getThreadGEOSContext();
+    GEOSGeom hThisGeosGeom = poSelf->acquireGEOSGeom(hGEOSCtxt);
+    GEOSGeom hOtherGeosGeom = poOtherGeom->acquireGEOSGeom(hGEOSCtxt);
     if( hThisGeosGeom != nullptr && hOtherGeosGeom != nullptr )
     {
         bResult = pfnGEOSFunction_r( hGEOSCtxt, hThisGeosGeom, hOtherGeosGeom );
     }
-    GEOSGeom_destroy_r( hGEOSCtxt, hThisGeosGeom );
-    GEOSGeom_destroy_r( hGEOSCtxt, hOtherGeosGeom );
-    poSelf->freeGEOSContext( hGEOSCtxt );
+    poSelf->releaseGEOSGeom( hGEOSCtxt, hThisGeosGeom );
+    poOtherGeom->releaseGEOSGeom( hGEOSCtxt, hOtherGeosGeom );
 
     return bResult;
 }
@@ -3709,7 +3913,7 @@ OGRGeometry *OGRGeometry::MakeValid( CSLConstList papszOptions ) const
 
     OGRGeometry *poOGRProduct = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
     GEOSGeom hGeosGeom = exportToGEOS(hGEOSCtxt);
     if( hGeosGeom != nullptr )
     {
@@ -3744,7 +3948,6 @@ OGRGeometry *OGRGeometry::MakeValid( CSLConstList papszOptions ) const
             GEOSGeom_destroy_r( hGEOSCtxt, hGEOSRet);
         }
     }
-    freeGEOSContext( hGEOSCtxt );
 
     return poOGRProduct;
 #endif
@@ -3842,7 +4045,7 @@ OGRGeometry *OGRGeometry::Normalize() const
 #else
     OGRGeometry *poOGRProduct = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
     GEOSGeom hGeosGeom = exportToGEOS(hGEOSCtxt);
     if( hGeosGeom != nullptr )
     {
@@ -3860,7 +4063,6 @@ OGRGeometry *OGRGeometry::Normalize() const
         }
 
     }
-    freeGEOSContext( hGEOSCtxt );
 
     return poOGRProduct;
 #endif
@@ -3959,17 +4161,16 @@ OGRGeometry *OGRGeometry::ConvexHull() const
 
         OGRGeometry *poOGRProduct = nullptr;
 
-        GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
-        GEOSGeom hGeosGeom = exportToGEOS(hGEOSCtxt);
+        GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
+        GEOSGeom hGeosGeom = acquireGEOSGeom(hGEOSCtxt);
         if( hGeosGeom != nullptr )
         {
             GEOSGeom hGeosHull = GEOSConvexHull_r( hGEOSCtxt, hGeosGeom );
-            GEOSGeom_destroy_r( hGEOSCtxt, hGeosGeom );
+            releaseGEOSGeom( hGEOSCtxt, hGeosGeom );
 
             poOGRProduct = BuildGeometryFromGEOS(hGEOSCtxt, hGeosHull,
                                                  this, nullptr);
         }
-        freeGEOSContext( hGEOSCtxt );
 
         return poOGRProduct;
 
@@ -4055,17 +4256,16 @@ OGRGeometry *OGRGeometry::ConcaveHull(double dfRatio, bool bAllowHoles) const
 #else
     OGRGeometry *poOGRProduct = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
-    GEOSGeom hGeosGeom = exportToGEOS(hGEOSCtxt);
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
+    GEOSGeom hGeosGeom = acquireGEOSGeom(hGEOSCtxt);
     if( hGeosGeom != nullptr )
     {
         GEOSGeom hGeosHull = GEOSConcaveHull_r( hGEOSCtxt, hGeosGeom, dfRatio, bAllowHoles );
-        GEOSGeom_destroy_r( hGEOSCtxt, hGeosGeom );
+        releaseGEOSGeom( hGEOSCtxt, hGeosGeom );
 
         poOGRProduct = BuildGeometryFromGEOS(hGEOSCtxt, hGeosHull,
                                              this, nullptr);
     }
-    freeGEOSContext( hGEOSCtxt );
 
     return poOGRProduct;
 #endif /* HAVE_GEOS */
@@ -4146,17 +4346,16 @@ OGRGeometry *OGRGeometry::Boundary() const
 
     OGRGeometry *poOGRProduct = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
-    GEOSGeom hGeosGeom = exportToGEOS(hGEOSCtxt);
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
+    GEOSGeom hGeosGeom = acquireGEOSGeom(hGEOSCtxt);
     if( hGeosGeom != nullptr )
     {
         GEOSGeom hGeosProduct = GEOSBoundary_r( hGEOSCtxt, hGeosGeom );
-        GEOSGeom_destroy_r( hGEOSCtxt, hGeosGeom );
+        releaseGEOSGeom( hGEOSCtxt, hGeosGeom );
 
         poOGRProduct = BuildGeometryFromGEOS(hGEOSCtxt, hGeosProduct,
                                              this, nullptr);
     }
-    freeGEOSContext( hGEOSCtxt );
 
     return poOGRProduct;
 
@@ -4274,18 +4473,17 @@ OGRGeometry *OGRGeometry::Buffer( UNUSED_IF_NO_GEOS double dfDist,
 
     OGRGeometry *poOGRProduct = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
-    GEOSGeom hGeosGeom = exportToGEOS(hGEOSCtxt);
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
+    GEOSGeom hGeosGeom = acquireGEOSGeom(hGEOSCtxt);
     if( hGeosGeom != nullptr )
     {
         GEOSGeom hGeosProduct =
             GEOSBuffer_r( hGEOSCtxt, hGeosGeom, dfDist, nQuadSegs );
-        GEOSGeom_destroy_r( hGEOSCtxt, hGeosGeom );
+        releaseGEOSGeom( hGEOSCtxt, hGeosGeom );
 
         poOGRProduct = BuildGeometryFromGEOS(hGEOSCtxt, hGeosProduct,
                                              this, nullptr);
     }
-    freeGEOSContext(hGEOSCtxt);
 
     return poOGRProduct;
 
@@ -4619,17 +4817,16 @@ OGRGeometry *OGRGeometry::UnionCascaded() const
 #endif
     OGRGeometry *poOGRProduct = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
-    GEOSGeom hThisGeosGeom = exportToGEOS(hGEOSCtxt);
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
+    GEOSGeom hThisGeosGeom = acquireGEOSGeom(hGEOSCtxt);
     if( hThisGeosGeom != nullptr )
     {
         GEOSGeom hGeosProduct = GEOSUnionCascaded_r(hGEOSCtxt, hThisGeosGeom);
-        GEOSGeom_destroy_r( hGEOSCtxt, hThisGeosGeom );
+        releaseGEOSGeom( hGEOSCtxt, hThisGeosGeom );
 
         poOGRProduct = BuildGeometryFromGEOS(hGEOSCtxt, hGeosProduct,
                                              this, nullptr);
     }
-    freeGEOSContext( hGEOSCtxt );
 
     return poOGRProduct;
 
@@ -5491,7 +5688,7 @@ OGRErr OGRGeometry::Centroid( OGRPoint *poPoint ) const
 
 #else
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
     GEOSGeom hThisGeosGeom = exportToGEOS(hGEOSCtxt);
 
     if( hThisGeosGeom != nullptr )
@@ -5501,7 +5698,6 @@ OGRErr OGRGeometry::Centroid( OGRPoint *poPoint ) const
 
         if( hOtherGeosGeom == nullptr )
         {
-            freeGEOSContext( hGEOSCtxt );
             return OGRERR_FAILURE;
         }
 
@@ -5512,13 +5708,11 @@ OGRErr OGRGeometry::Centroid( OGRPoint *poPoint ) const
 
         if( poCentroidGeom == nullptr )
         {
-            freeGEOSContext( hGEOSCtxt );
             return OGRERR_FAILURE;
         }
         if( wkbFlatten(poCentroidGeom->getGeometryType()) != wkbPoint )
         {
             delete poCentroidGeom;
-            freeGEOSContext( hGEOSCtxt );
             return OGRERR_FAILURE;
         }
 
@@ -5539,12 +5733,10 @@ OGRErr OGRGeometry::Centroid( OGRPoint *poPoint ) const
 
         delete poCentroidGeom;
 
-        freeGEOSContext( hGEOSCtxt );
         return OGRERR_NONE;
     }
     else
     {
-        freeGEOSContext( hGEOSCtxt );
         return OGRERR_FAILURE;
     }
 
@@ -5633,7 +5825,7 @@ OGRGeometryH OGR_G_PointOnSurface( OGRGeometryH hGeom )
 
     OGRGeometry* poThis = OGRGeometry::FromHandle(hGeom);
 
-    GEOSContextHandle_t hGEOSCtxt = OGRGeometry::createGEOSContext();
+    GEOSContextHandle_t hGEOSCtxt = OGRGeometry::getThreadGEOSContext();
     GEOSGeom hThisGeosGeom = poThis->exportToGEOS(hGEOSCtxt);
 
     if( hThisGeosGeom != nullptr )
@@ -5644,7 +5836,6 @@ OGRGeometryH OGR_G_PointOnSurface( OGRGeometryH hGeom )
 
         if( hOtherGeosGeom == nullptr )
         {
-            OGRGeometry::freeGEOSContext( hGEOSCtxt );
             return nullptr;
         }
 
@@ -5655,13 +5846,11 @@ OGRGeometryH OGR_G_PointOnSurface( OGRGeometryH hGeom )
 
         if( poInsidePointGeom == nullptr )
         {
-            OGRGeometry::freeGEOSContext( hGEOSCtxt );
             return nullptr;
         }
         if( wkbFlatten(poInsidePointGeom->getGeometryType()) != wkbPoint )
         {
             delete poInsidePointGeom;
-            OGRGeometry::freeGEOSContext( hGEOSCtxt );
             return nullptr;
         }
 
@@ -5669,11 +5858,9 @@ OGRGeometryH OGR_G_PointOnSurface( OGRGeometryH hGeom )
             poInsidePointGeom->
                 assignSpatialReference(poThis->getSpatialReference());
 
-        OGRGeometry::freeGEOSContext( hGEOSCtxt );
         return OGRGeometry::ToHandle(poInsidePointGeom);
     }
 
-    OGRGeometry::freeGEOSContext( hGEOSCtxt );
     return nullptr;
 #endif
 }
@@ -5744,17 +5931,16 @@ OGRGeometry *OGRGeometry::Simplify( UNUSED_IF_NO_GEOS double dTolerance ) const
 #else
     OGRGeometry *poOGRProduct = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
-    GEOSGeom hThisGeosGeom = exportToGEOS(hGEOSCtxt);
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
+    GEOSGeom hThisGeosGeom = acquireGEOSGeom(hGEOSCtxt);
     if( hThisGeosGeom != nullptr )
     {
         GEOSGeom hGeosProduct =
             GEOSSimplify_r( hGEOSCtxt, hThisGeosGeom, dTolerance );
-        GEOSGeom_destroy_r( hGEOSCtxt, hThisGeosGeom );
+        releaseGEOSGeom( hGEOSCtxt, hThisGeosGeom );
         poOGRProduct = BuildGeometryFromGEOS(hGEOSCtxt, hGeosProduct,
                                              this, nullptr);
     }
-    freeGEOSContext( hGEOSCtxt );
     return poOGRProduct;
 
 #endif  // HAVE_GEOS
@@ -5824,18 +6010,17 @@ OGRGeometry *OGRGeometry::SimplifyPreserveTopology(
 #else
     OGRGeometry *poOGRProduct = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
-    GEOSGeom hThisGeosGeom = exportToGEOS(hGEOSCtxt);
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
+    GEOSGeom hThisGeosGeom = acquireGEOSGeom(hGEOSCtxt);
     if( hThisGeosGeom != nullptr )
     {
         GEOSGeom hGeosProduct =
             GEOSTopologyPreserveSimplify_r( hGEOSCtxt, hThisGeosGeom,
                                             dTolerance );
-        GEOSGeom_destroy_r( hGEOSCtxt, hThisGeosGeom );
+        releaseGEOSGeom( hGEOSCtxt, hThisGeosGeom );
         poOGRProduct = BuildGeometryFromGEOS(hGEOSCtxt, hGeosProduct,
                                              this, nullptr);
     }
-    freeGEOSContext( hGEOSCtxt );
     return poOGRProduct;
 
 #endif  // HAVE_GEOS
@@ -5920,7 +6105,7 @@ OGRGeometry *OGRGeometry::DelaunayTriangulation( double dfTolerance,
 {
     OGRGeometry *poOGRProduct = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
     GEOSGeom hThisGeosGeom = exportToGEOS(hGEOSCtxt);
     if( hThisGeosGeom != nullptr )
     {
@@ -5931,7 +6116,6 @@ OGRGeometry *OGRGeometry::DelaunayTriangulation( double dfTolerance,
         poOGRProduct = BuildGeometryFromGEOS(hGEOSCtxt, hGeosProduct,
                                              this, nullptr);
     }
-    freeGEOSContext( hGEOSCtxt );
     return poOGRProduct;
 }
 #endif
@@ -6026,7 +6210,7 @@ OGRGeometry *OGRGeometry::Polygonize() const
     OGRGeometry *poPolygsOGRGeom = nullptr;
     bool bError = false;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
 
     GEOSGeom* pahGeosGeomList = new GEOSGeom [nCount];
     for( int ig = 0; ig < nCount; ig++ )
@@ -6061,7 +6245,6 @@ OGRGeometry *OGRGeometry::Polygonize() const
             GEOSGeom_destroy_r( hGEOSCtxt, hGeosGeom );
     }
     delete [] pahGeosGeomList;
-    freeGEOSContext( hGEOSCtxt );
 
     return poPolygsOGRGeom;
 
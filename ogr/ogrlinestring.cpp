@@ -2034,16 +2034,15 @@ double OGRSimpleCurve::Project(const OGRPoint *
     GEOSGeom hThisGeosGeom = nullptr;
     GEOSGeom hPointGeosGeom = nullptr;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
-    hThisGeosGeom = exportToGEOS(hGEOSCtxt);
-    hPointGeosGeom = poPoint->exportToGEOS(hGEOSCtxt);
+    GEOSContextHandle_t hGEOSCtxt = getThreadGEOSContext();
+    hThisGeosGeom = acquireGEOSGeom(hGEOSCtxt);
+    hPointGeosGeom = poPoint->acquireGEOSGeom(hGEOSCtxt);
     if( hThisGeosGeom != nullptr && hPointGeosGeom != nullptr )
     {
         dfResult = GEOSProject_r(hGEOSCtxt, hThisGeosGeom, hPointGeosGeom);
     }
-    GEOSGeom_destroy_r(hGEOSCtxt, hThisGeosGeom);
-    GEOSGeom_destroy_r(hGEOSCtxt, hPointGeosGeom);
-    freeGEOSContext(hGEOSCtxt);
+    releaseGEOSGeom(hGEOSCtxt, hThisGeosGeom);
+    poPoint->releaseGEOSGeom(hGEOSCtxt, hPointGeosGeom);
 
     return dfResult;
 
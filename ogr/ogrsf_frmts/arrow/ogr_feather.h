@@ -154,6 +154,7 @@ class OGRFeatherWriterLayer final: public OGRArrowWriterLayer
         virtual void            PerformStepsBeforeFinalFlushGroup() override;
 
         virtual bool            FlushGroup() override;
+        virtual bool            WriteRecordBatch(const std::shared_ptr<arrow::RecordBatch>& poBatch) override;
 
         virtual std::string GetDriverUCName() const override { return ARROW_DRIVER_NAME_UC; }
 
@@ -188,6 +188,8 @@ bool OGRFeatherWriterLayer::SetOptions(const std::string& osFilename,
         }
     }
 
+    InitFlushJobQueue(papszOptions);
+
     m_bInitializationOK = true;
     return true;
 }
@@ -454,3 +456,20 @@ bool OGRFeatherWriterLayer::FlushGroup()
     m_apoBuilders.clear();
     return ret;
 }
+
+/************************************************************************/
+/*                         WriteRecordBatch()                           */
+/************************************************************************/
+
+bool OGRFeatherWriterLayer::WriteRecordBatch(
+                        const std::shared_ptr<arrow::RecordBatch>& poBatch)
+{
+    auto status = m_poFileWriter->WriteRecordBatch(*poBatch);
+    if( !status.ok() )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+             "WriteRecordBatch() failed with %s", status.message().c_str());
+        return false;
+    }
+    return true;
+}
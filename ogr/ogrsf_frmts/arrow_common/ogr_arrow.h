@@ -31,9 +31,14 @@
 
 #include "gdal_pam.h"
 #include "ogrsf_frmts.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <set>
+#include <vector>
 
 #include "ogr_include_arrow.h"
 
@@ -256,6 +261,19 @@ protected:
         std::vector<OGREnvelope>                    m_aoEnvelopes{}; // size: GetGeomFieldCount()
         std::vector<std::set<OGRwkbGeometryType>>   m_oSetWrittenGeometryTypes{}; // size: GetGeomFieldCount()
 
+        // Background writing of row groups built by ICreateFeature().
+        // Only created when NUM_THREADS allows for more than one thread.
+        std::unique_ptr<CPLJobQueue>                m_poFlushJobQueue{};
+        std::shared_ptr<arrow::RecordBatch>         m_poPendingBatch{};
+        std::atomic<bool>                           m_bPendingFlushOK{true};
+        std::vector<CPLErrorHandlerAccumulatorStruct> m_aoPendingFlushErrors{};
+
+        // WKB geometry columns of the batch being written by
+        // WriteArrowBatch() through ICreateFeature(), which are copied
+        // as they are. Empty, or of size GetGeomFieldCount().
+        std::vector<const struct ArrowArray*>       m_apsWKBPassthroughArrays{};
+        int64_t                                     m_nWKBPassthroughRow = 0;
+
         static OGRArrowGeomEncoding GetPreciseArrowGeomEncoding(
                                                     OGRwkbGeometryType eGType);
         static const char*      GetGeomEncodingAsString(
@@ -276,11 +294,21 @@ protected:
 
         void                    CreateArrayBuilders();
         virtual bool            FlushGroup() = 0;
+        virtual bool            WriteRecordBatch(const std::shared_ptr<arrow::RecordBatch>& poBatch) = 0;
         void                    FinalizeWriting();
+        void                    InitFlushJobQueue(CSLConstList papszOptions);
+        bool                    FlushCurrentGroup();
+        static void             FlushJob(void* pData);
+        bool                    WaitPendingFlush();
+        bool                    WriteArrowBatchWithWKBPassthrough(
+                                        const struct ArrowSchema* schema,
+                                        struct ArrowArray* array,
+                                        CSLConstList papszOptions);
         bool                    WriteArrays(std::function<bool(const std::shared_ptr<arrow::Field>&,
                                                                const std::shared_ptr<arrow::Array>&)> postProcessArray);
 
         virtual void            FixupGeometryBeforeWriting(OGRGeometry* /* poGeom */ ) {}
+        virtual bool            HasGeometryFixup() const { return false; }
         virtual bool            IsSRSRequired() const = 0;
 
 public:
@@ -302,6 +330,9 @@ public:
         OGRErr          CreateField( OGRFieldDefn *poField, int bApproxOK = TRUE ) override;
         OGRErr          CreateGeomField( OGRGeomFieldDefn *poField, int bApproxOK = TRUE ) override;
         GIntBig         GetFeatureCount(int bForce) override;
+        bool            WriteArrowBatch(const struct ArrowSchema* schema,
+                                        struct ArrowArray* array,
+                                        CSLConstList papszOptions = nullptr) override;
 
 protected:
         OGRErr          ICreateFeature( OGRFeature* poFeature ) override;
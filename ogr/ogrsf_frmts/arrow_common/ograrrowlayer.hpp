@@ -2709,8 +2709,8 @@ OGRFeature* OGRArrowLayer::GetNextRawFeature()
             return nullptr;
     }
 
-    // Evaluate spatial filter by computing the bounding box of each geometry
-    // but without creating a OGRGeometry
+    // Evaluate spatial filter directly on the WKB of each geometry, without
+    // creating a OGRGeometry when possible
     if( m_poFilterGeom )
     {
         int iCol;
@@ -2740,8 +2740,7 @@ OGRFeature* OGRArrowLayer::GetNextRawFeature()
                 {
                     int out_length = 0;
                     const uint8_t* data = castArray->GetValue(m_nIdxInBatch, &out_length);
-                    if( ReadWKBBoundingBox(data, out_length, sEnvelope) &&
-                        !m_sFilterEnvelope.Intersects(sEnvelope) )
+                    if( !FilterWKBGeometry(data, out_length, false, sEnvelope) )
                     {
                         bSkipToNextFeature = true;
                     }
@@ -31,6 +31,8 @@
 
 #include "cpl_json.h"
 #include "cpl_time.h"
+#include "gdal_thread_pool.h"
+#include "ogr_wkb.h"
 
 #include <cinttypes>
 #include <limits>
@@ -53,6 +55,51 @@ static constexpr int                        TZFLAG_MIXED = -2;
 #define OGR_ARROW_RETURN_OGRERR_NOT_OK(status) \
       OGR_ARROW_RETURN_NOT_OK(status, OGRERR_FAILURE)
 
+/************************************************************************/
+/*                          IsArrowValueNull()                          */
+/************************************************************************/
+
+static inline bool IsArrowValueNull(const struct ArrowArray* psArray,
+                                    int64_t nIdx)
+{
+    const uint8_t* pabyValidity = static_cast<const uint8_t*>(psArray->buffers[0]);
+    return psArray->null_count != 0 && pabyValidity != nullptr &&
+           (pabyValidity[nIdx / 8] & (1 << (nIdx % 8))) == 0;
+}
+
+/************************************************************************/
+/*                         GetPassthroughWKB()                          */
+/************************************************************************/
+
+// Returns whether the value at nIdx of a WKB (binary) array can be written
+// as it is in a geometry column of type eColumnGType, that is whether it is
+// what ICreateFeature() would write: well-formed little-endian ISO WKB,
+// without M values if the column has none.
+// Null values are accepted, and returned with pabyWKB == nullptr. The
+// envelope is not initialized for null and empty geometries.
+static bool GetPassthroughWKB(const struct ArrowArray* psArray, int64_t nIdx,
+                              OGRwkbGeometryType eColumnGType,
+                              const GByte*& pabyWKB, size_t& nWKBSize,
+                              OGREnvelope& oEnvelope,
+                              OGRwkbGeometryType& eGType)
+{
+    pabyWKB = nullptr;
+    nWKBSize = 0;
+    oEnvelope = OGREnvelope();
+    eGType = wkbNone;
+    if( IsArrowValueNull(psArray, nIdx) )
+        return true;
+
+    const int32_t* panOffsets = static_cast<const int32_t*>(psArray->buffers[1]);
+    pabyWKB = static_cast<const GByte*>(psArray->buffers[2]) + panOffsets[nIdx];
+    nWKBSize = static_cast<size_t>(panOffsets[nIdx + 1] - panOffsets[nIdx]);
+    OGRWKBGeometryView oView(pabyWKB, nWKBSize);
+    eGType = oView.GetGeometryType();
+    return oView.IsValidISO() && pabyWKB[0] == wkbNDR &&
+           (!OGR_GT_HasM(eGType) || OGR_GT_HasM(eColumnGType)) &&
+           oView.GetEnvelope(oEnvelope);
+}
+
 /************************************************************************/
 /*                      OGRArrowWriterLayer()                           */
 /************************************************************************/
@@ -86,6 +133,25 @@ OGRArrowWriterLayer::~OGRArrowWriterLayer()
     m_poFeatureDefn->Release();
 }
 
+/************************************************************************/
+/*                         InitFlushJobQueue()                          */
+/************************************************************************/
+
+// Row groups built by ICreateFeature() are encoded, compressed and written
+// by a worker thread, while the next one is being built, when the
+// NUM_THREADS layer creation option allows for more than one thread.
+inline
+void OGRArrowWriterLayer::InitFlushJobQueue(CSLConstList papszOptions)
+{
+    const int nNumThreads = GDALGetNumThreads(papszOptions, "NUM_THREADS");
+    if( nNumThreads > 1 )
+    {
+        CPLWorkerThreadPool* poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+        if( poThreadPool )
+            m_poFlushJobQueue = poThreadPool->CreateJobQueue();
+    }
+}
+
 /************************************************************************/
 /*                         FinalizeWriting()                            */
 /************************************************************************/
@@ -99,6 +165,8 @@ void OGRArrowWriterLayer::FinalizeWriting()
     }
     if( IsFileWriterCreated() )
     {
+        WaitPendingFlush();
+
         PerformStepsBeforeFinalFlushGroup();
 
         if( !m_apoBuilders.empty() )
@@ -108,6 +176,80 @@ void OGRArrowWriterLayer::FinalizeWriting()
     }
 }
 
+/************************************************************************/
+/*                         FlushCurrentGroup()                          */
+/************************************************************************/
+
+// Flushes the row group built by ICreateFeature(). When background writing
+// is enabled, the builders are only finished here, and the resulting record
+// batch is written by a job, after the previous one has completed.
+inline
+bool OGRArrowWriterLayer::FlushCurrentGroup()
+{
+    if( !m_poFlushJobQueue )
+        return FlushGroup();
+
+    const int64_t nRows = m_apoBuilders[0]->length();
+    std::vector<std::shared_ptr<arrow::Array>> columns;
+    const bool bRet = WriteArrays(
+        [&columns](const std::shared_ptr<arrow::Field>&,
+                   const std::shared_ptr<arrow::Array>& array)
+    {
+        columns.emplace_back(array);
+        return true;
+    });
+    m_apoBuilders.clear();
+
+    if( !WaitPendingFlush() || !bRet )
+        return false;
+
+    m_poPendingBatch = arrow::RecordBatch::Make(m_poSchema, nRows, columns);
+    return m_poFlushJobQueue->SubmitJob(FlushJob, this);
+}
+
+/************************************************************************/
+/*                             FlushJob()                               */
+/************************************************************************/
+
+inline
+void OGRArrowWriterLayer::FlushJob(void* pData)
+{
+    auto poLayer = static_cast<OGRArrowWriterLayer*>(pData);
+
+    CPLInstallErrorHandlerAccumulator(poLayer->m_aoPendingFlushErrors);
+    CPLSetCurrentErrorHandlerCatchDebug( FALSE );
+
+    poLayer->m_bPendingFlushOK =
+        poLayer->WriteRecordBatch(poLayer->m_poPendingBatch);
+    poLayer->m_poPendingBatch.reset();
+
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                         WaitPendingFlush()                           */
+/************************************************************************/
+
+// Waits for the row group being written in the background, if any, and
+// re-emits the errors it may have raised.
+inline
+bool OGRArrowWriterLayer::WaitPendingFlush()
+{
+    if( !m_poFlushJobQueue )
+        return true;
+
+    m_poFlushJobQueue->WaitCompletion();
+    for( const auto& oError: m_aoPendingFlushErrors )
+    {
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    }
+    m_aoPendingFlushErrors.clear();
+
+    const bool bRet = m_bPendingFlushOK;
+    m_bPendingFlushOK = true;
+    return bRet;
+}
+
 /************************************************************************/
 /*                       CreateSchemaCommon()                           */
 /************************************************************************/
@@ -815,6 +957,14 @@ OGRErr OGRArrowWriterLayer::ICreateFeature( OGRFeature* poFeature )
         CreateArrayBuilders();
     }
 
+    // Report the failure of the row group being written in the background
+    // as soon as it is known.
+    if( !m_bPendingFlushOK )
+    {
+        WaitPendingFlush();
+        return OGRERR_FAILURE;
+    }
+
     // First pass to check not-null constraints as Arrow doesn't seem
     // to do that on the writing side. But such files can't be read.
     const int nFieldCount = m_poFeatureDefn->GetFieldCount();
@@ -834,7 +984,12 @@ OGRErr OGRArrowWriterLayer::ICreateFeature( OGRFeature* poFeature )
     for( int i = 0; i < nGeomFieldCount; ++i )
     {
         const auto poGeomFieldDefn = m_poFeatureDefn->GetGeomFieldDefn(i);
-        if( !poGeomFieldDefn->IsNullable() && poFeature->GetGeomFieldRef(i) == nullptr )
+        const bool bIsNull = m_apsWKBPassthroughArrays.empty() ?
+            poFeature->GetGeomFieldRef(i) == nullptr :
+            IsArrowValueNull(m_apsWKBPassthroughArrays[i],
+                             m_nWKBPassthroughRow +
+                             m_apsWKBPassthroughArrays[i]->offset);
+        if( !poGeomFieldDefn->IsNullable() && bIsNull )
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Null value found in non-nullable geometry field %s",
@@ -1150,6 +1305,40 @@ OGRErr OGRArrowWriterLayer::ICreateFeature( OGRFeature* poFeature )
     for( int i = 0; i < nGeomFieldCount; ++i, ++nArrowIdx )
     {
         auto poBuilder = m_apoBuilders[nArrowIdx].get();
+
+        // WKB geometry column of the batch passed to WriteArrowBatch(),
+        // which has been checked to be suitable as it is.
+        if( !m_apsWKBPassthroughArrays.empty() )
+        {
+            const struct ArrowArray* psArray = m_apsWKBPassthroughArrays[i];
+            const GByte* pabyWKB = nullptr;
+            size_t nWKBSize = 0;
+            OGREnvelope oEnvelope;
+            OGRwkbGeometryType eWKBGType = wkbNone;
+            if( !GetPassthroughWKB(psArray,
+                                   m_nWKBPassthroughRow + psArray->offset,
+                                   m_poFeatureDefn->GetGeomFieldDefn(i)->GetType(),
+                                   pabyWKB, nWKBSize, oEnvelope, eWKBGType) )
+            {
+                // Should not happen: checked by WriteArrowBatchWithWKBPassthrough()
+                CPLError(CE_Failure, CPLE_AppDefined, "Invalid WKB geometry");
+                return OGRERR_FAILURE;
+            }
+            if( pabyWKB == nullptr )
+            {
+                OGR_ARROW_RETURN_OGRERR_NOT_OK(poBuilder->AppendNull());
+                continue;
+            }
+            if( oEnvelope.IsInit() )
+            {
+                m_aoEnvelopes[i].Merge(oEnvelope);
+                m_oSetWrittenGeometryTypes[i].insert(eWKBGType);
+            }
+            OGR_ARROW_RETURN_OGRERR_NOT_OK(static_cast<arrow::BinaryBuilder*>(poBuilder)->Append(
+                pabyWKB, static_cast<int32_t>(nWKBSize)));
+            continue;
+        }
+
         OGRGeometry* poGeom = poFeature->GetGeomFieldRef(i);
         const auto eGType = poGeom ? poGeom->getGeometryType() : wkbNone;
         const auto eColumnGType = m_poFeatureDefn->GetGeomFieldDefn(i)->GetType();
@@ -1392,6 +1581,8 @@ OGRErr OGRArrowWriterLayer::ICreateFeature( OGRFeature* poFeature )
     }
 
     m_nFeatureCount ++;
+    if( !m_apsWKBPassthroughArrays.empty() )
+        m_nWKBPassthroughRow ++;
 
     // Flush the current row group if reaching the limit of rows per group.
     if( !m_apoBuilders.empty() && m_apoBuilders[0]->length() == m_nRowGroupSize )
@@ -1403,7 +1594,7 @@ OGRErr OGRArrowWriterLayer::ICreateFeature( OGRFeature* poFeature )
                 return OGRERR_FAILURE;
         }
 
-        if( !FlushGroup() )
+        if( !FlushCurrentGroup() )
             return OGRERR_FAILURE;
     }
 
@@ -1424,6 +1615,284 @@ GIntBig OGRArrowWriterLayer::GetFeatureCount(int bForce)
     return OGRLayer::GetFeatureCount(bForce);
 }
 
+/************************************************************************/
+/*                       IsSameArrowFormat()                            */
+/************************************************************************/
+
+// Compares the format of two Arrow C schemas, and recursively the one of
+// their children and dictionary, but not their names.
+static inline bool IsSameArrowFormat(const struct ArrowSchema* psA,
+                              const struct ArrowSchema* psB)
+{
+    if( strcmp(psA->format, psB->format) != 0 ||
+        psA->n_children != psB->n_children ||
+        (psA->dictionary == nullptr) != (psB->dictionary == nullptr) )
+        return false;
+    if( psA->dictionary && !IsSameArrowFormat(psA->dictionary, psB->dictionary) )
+        return false;
+    for( int64_t i = 0; i < psA->n_children; ++i )
+    {
+        if( !IsSameArrowFormat(psA->children[i], psB->children[i]) )
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         WriteArrowBatch()                            */
+/************************************************************************/
+
+inline
+bool OGRArrowWriterLayer::WriteArrowBatch(const struct ArrowSchema* schema,
+                                          struct ArrowArray* array,
+                                          CSLConstList papszOptions)
+{
+    if( m_poSchema == nullptr )
+    {
+        CreateSchema();
+    }
+
+    const int nArrowIdxFirstGeomField =
+        (m_osFIDColumn.empty() ? 0 : 1) + m_poFeatureDefn->GetFieldCount();
+    const char* pszFIDName = CSLFetchNameValue(papszOptions, "FID");
+    const char* pszGeomName = CSLFetchNameValue(papszOptions, "GEOMETRY_NAME");
+
+    // The array can be directly appended to the file if its columns are
+    // exactly the ones of the layer schema, and if no per-feature
+    // processing of ICreateFeature() is needed.
+    bool bDirectWrite =
+        m_oMapFieldDomainToStringArray.empty() && !HasGeometryFixup() &&
+        array->n_children == schema->n_children;
+    for( const auto eGeomEncoding: m_aeGeomEncoding )
+    {
+        if( eGeomEncoding != OGRArrowGeomEncoding::WKB )
+            bDirectWrite = false;
+    }
+    if( bDirectWrite && !IsFileWriterCreated() )
+    {
+        // The timestamp types are only finalized at writer creation
+        for( int i = 0; i < m_poFeatureDefn->GetFieldCount(); ++i )
+        {
+            if( m_poFeatureDefn->GetFieldDefn(i)->GetType() == OFTDateTime )
+                bDirectWrite = false;
+        }
+    }
+
+    if( bDirectWrite )
+    {
+        struct ArrowSchema sLayerSchema;
+        if( !arrow::ExportSchema(*m_poSchema, &sLayerSchema).ok() )
+        {
+            bDirectWrite = false;
+        }
+        else
+        {
+            bDirectWrite = IsSameArrowFormat(schema, &sLayerSchema);
+            for( int64_t i = 0; bDirectWrite && i < schema->n_children; ++i )
+            {
+                const auto psLayerChild = sLayerSchema.children[i];
+                const char* pszName = schema->children[i]->name;
+                // The FID and first geometry column may be renamed with the
+                // FID and GEOMETRY_NAME options, as in the generic
+                // implementation.
+                const bool bNameOK = pszName != nullptr &&
+                    (strcmp(pszName, psLayerChild->name) == 0 ||
+                     (i == 0 && !m_osFIDColumn.empty() && pszFIDName &&
+                      strcmp(pszName, pszFIDName) == 0) ||
+                     (i == nArrowIdxFirstGeomField && pszGeomName &&
+                      strcmp(pszName, pszGeomName) == 0));
+                if( !bNameOK ||
+                    ((psLayerChild->flags & ARROW_FLAG_NULLABLE) == 0 &&
+                     array->children[i]->null_count != 0) )
+                {
+                    bDirectWrite = false;
+                }
+            }
+            sLayerSchema.release(&sLayerSchema);
+        }
+    }
+
+    // Collect the extent and geometry types, that are written in the
+    // file metadata, and check that the WKB is suitable as it is.
+    std::vector<OGREnvelope> aoEnvelopes(m_aoEnvelopes);
+    std::vector<std::set<OGRwkbGeometryType>> oSetWrittenGeometryTypes(
+                                                m_oSetWrittenGeometryTypes);
+    for( int i = 0; bDirectWrite && i < m_poFeatureDefn->GetGeomFieldCount(); ++i )
+    {
+        const auto eColumnGType = m_poFeatureDefn->GetGeomFieldDefn(i)->GetType();
+        const struct ArrowArray* psChild = array->children[nArrowIdxFirstGeomField + i];
+        for( int64_t iRow = 0; iRow < array->length; ++iRow )
+        {
+            const GByte* pabyWKB = nullptr;
+            size_t nWKBSize = 0;
+            OGREnvelope oEnvelope;
+            OGRwkbGeometryType eWKBGType = wkbNone;
+            if( !GetPassthroughWKB(psChild,
+                                   array->offset + iRow + psChild->offset,
+                                   eColumnGType, pabyWKB, nWKBSize,
+                                   oEnvelope, eWKBGType) )
+            {
+                bDirectWrite = false;
+                break;
+            }
+            if( oEnvelope.IsInit() )
+            {
+                aoEnvelopes[i].Merge(oEnvelope);
+                oSetWrittenGeometryTypes[i].insert(eWKBGType);
+            }
+        }
+    }
+
+    if( !bDirectWrite )
+    {
+        if( !WaitPendingFlush() )
+            return false;
+        return WriteArrowBatchWithWKBPassthrough(schema, array, papszOptions);
+    }
+
+    if( !IsFileWriterCreated() )
+    {
+        CreateWriter();
+        if( !IsFileWriterCreated() )
+            return false;
+    }
+
+    // Flush features previously created with CreateFeature(), to keep the
+    // row order.
+    if( !WaitPendingFlush() )
+        return false;
+    if( !m_apoBuilders.empty() && m_apoBuilders[0]->length() > 0 )
+    {
+        if( !FlushGroup() )
+            return false;
+    }
+
+    // Takes ownership of the array content
+    auto result = arrow::ImportRecordBatch(array, m_poSchema);
+    if( !result.ok() )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "ImportRecordBatch() failed with %s",
+                 result.status().message().c_str());
+        return false;
+    }
+    const auto poBatch = *result;
+    if( poBatch->num_rows() == 0 )
+        return true;
+    if( !WriteRecordBatch(poBatch) )
+        return false;
+
+    m_aoEnvelopes = std::move(aoEnvelopes);
+    m_oSetWrittenGeometryTypes = std::move(oSetWrittenGeometryTypes);
+    m_nFeatureCount += poBatch->num_rows();
+    return true;
+}
+
+/************************************************************************/
+/*                  WriteArrowBatchWithWKBPassthrough()                 */
+/************************************************************************/
+
+// Used when the batch cannot be written directly. The attribute columns go
+// through the generic implementation, which calls ICreateFeature() for each
+// row, but WKB geometry columns that are suitable as they are are copied by
+// ICreateFeature(), instead of being decoded and re-encoded.
+inline
+bool OGRArrowWriterLayer::WriteArrowBatchWithWKBPassthrough(
+                                        const struct ArrowSchema* schema,
+                                        struct ArrowArray* array,
+                                        CSLConstList papszOptions)
+{
+    const int nGeomFieldCount = m_poFeatureDefn->GetGeomFieldCount();
+    const char* pszGeomName = CSLFetchNameValue(papszOptions, "GEOMETRY_NAME");
+
+    // All geometry fields must be matched by name with a valid WKB column,
+    // otherwise the generic implementation could map the remaining binary
+    // columns to other geometry fields.
+    std::vector<const struct ArrowArray*> apsWKBArrays(nGeomFieldCount);
+    std::vector<bool> abIsWKBColumn(static_cast<size_t>(schema->n_children));
+    bool bPassthrough = nGeomFieldCount > 0 && !HasGeometryFixup() &&
+                        schema->n_children == array->n_children;
+    for( int i = 0; bPassthrough && i < nGeomFieldCount; ++i )
+    {
+        if( m_aeGeomEncoding[i] != OGRArrowGeomEncoding::WKB )
+        {
+            bPassthrough = false;
+            break;
+        }
+        const auto poGeomFieldDefn = m_poFeatureDefn->GetGeomFieldDefn(i);
+        for( int64_t j = 0; j < schema->n_children; ++j )
+        {
+            const struct ArrowSchema* psChildSchema = schema->children[j];
+            const char* pszName = psChildSchema->name ? psChildSchema->name : "";
+            if( !abIsWKBColumn[j] &&
+                psChildSchema->dictionary == nullptr &&
+                strcmp(psChildSchema->format, "z") == 0 &&
+                m_poFeatureDefn->GetFieldIndex(pszName) < 0 &&
+                (strcmp(pszName, poGeomFieldDefn->GetNameRef()) == 0 ||
+                 (i == 0 && pszGeomName && strcmp(pszName, pszGeomName) == 0)) )
+            {
+                abIsWKBColumn[j] = true;
+                apsWKBArrays[i] = array->children[j];
+                break;
+            }
+        }
+        const struct ArrowArray* psChild = apsWKBArrays[i];
+        if( psChild == nullptr )
+        {
+            bPassthrough = false;
+            break;
+        }
+
+        const auto eColumnGType = poGeomFieldDefn->GetType();
+        for( int64_t iRow = 0; iRow < array->length; ++iRow )
+        {
+            const GByte* pabyWKB = nullptr;
+            size_t nWKBSize = 0;
+            OGREnvelope oEnvelope;
+            OGRwkbGeometryType eWKBGType = wkbNone;
+            if( !GetPassthroughWKB(psChild,
+                                   array->offset + iRow + psChild->offset,
+                                   eColumnGType, pabyWKB, nWKBSize,
+                                   oEnvelope, eWKBGType) )
+            {
+                bPassthrough = false;
+                break;
+            }
+        }
+    }
+
+    if( !bPassthrough )
+        return OGRLayer::WriteArrowBatch(schema, array, papszOptions);
+
+    // Shallow copies of the schema and array, without the WKB columns,
+    // that remain owned by the caller.
+    std::vector<struct ArrowSchema*> apsSchemaChildren;
+    std::vector<struct ArrowArray*> apsArrayChildren;
+    for( int64_t j = 0; j < schema->n_children; ++j )
+    {
+        if( !abIsWKBColumn[j] )
+        {
+            apsSchemaChildren.push_back(schema->children[j]);
+            apsArrayChildren.push_back(array->children[j]);
+        }
+    }
+    struct ArrowSchema sSchema = *schema;
+    sSchema.n_children = static_cast<int64_t>(apsSchemaChildren.size());
+    sSchema.children = apsSchemaChildren.data();
+    sSchema.release = nullptr;
+    struct ArrowArray sArray = *array;
+    sArray.n_children = static_cast<int64_t>(apsArrayChildren.size());
+    sArray.children = apsArrayChildren.data();
+    sArray.release = nullptr;
+
+    m_apsWKBPassthroughArrays = std::move(apsWKBArrays);
+    m_nWKBPassthroughRow = array->offset;
+    const bool bRet = OGRLayer::WriteArrowBatch(&sSchema, &sArray, papszOptions);
+    m_apsWKBPassthroughArrays.clear();
+    m_nWKBPassthroughRow = 0;
+    return bRet;
+}
+
 /************************************************************************/
 /*                         TestCapability()                             */
 /************************************************************************/
@@ -1443,6 +1912,19 @@ int OGRArrowWriterLayer::TestCapability(const char* pszCap)
     if( EQUAL(pszCap, OLCMeasuredGeometries) )
         return true;
 
+    if( EQUAL(pszCap, OLCFastWriteArrowBatch) )
+    {
+        // Same conditions as the direct path of WriteArrowBatch()
+        if( !m_oMapFieldDomainToStringArray.empty() || HasGeometryFixup() )
+            return false;
+        for( const auto eGeomEncoding: m_aeGeomEncoding )
+        {
+            if( eGeomEncoding != OGRArrowGeomEncoding::WKB )
+                return false;
+        }
+        return true;
+    }
+
     return false;
 }
 
@@ -33,7 +33,11 @@
 
 #include "ogrsf_frmts.h"
 
+#include <deque>
+#include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 #if defined(_MSC_VER) && _MSC_VER <= 1600 // MSVC <= 2010
 # define GDAL_OVERRIDE
@@ -94,6 +98,43 @@ class OGRCSVLayer final: public OGRLayer
     bool                bHasFieldNames;
 
     OGRFeature         *GetNextUnfilteredFeature();
+    OGRFeature         *TranslateRecord( char **papszTokens, int nFID,
+                                         bool &bWarningBadTypeOrWidthInOut,
+                                         CPLString &osWarning ) const;
+
+    // Blocks of the file are split at record boundaries into chunks, that
+    // worker threads tokenize and translate, and whose features are queued
+    // in file order. Used when m_nNumThreads > 1.
+    struct ReadChunk;
+    int                 m_nNumThreads = 1;
+    std::string         m_osPendingBytes{};  // Read, but not yet parsed.
+    bool                m_bReadEOF = false;
+    std::deque<std::unique_ptr<OGRFeature>> m_apoPendingFeatures{};
+
+    OGRFeature         *GetNextQueuedFeature();
+    bool                FillFeatureQueue();
+    void                ClearFeatureQueue();
+    static void         TokenizeChunkJob( void *pData );
+    static void         TranslateChunkJob( void *pData );
+
+    // Sidecar index of record offsets, enabled with the OFFSET_INDEX open
+    // option. m_anRecordOffsets[i] is the offset of the record of FID
+    // 1 + i * m_nOffsetIndexInterval. It is filled while reading
+    // sequentially, and saved once the end of file is reached.
+    bool                m_bUseOffsetIndex = false;
+    bool                m_bOffsetIndexComplete = false;
+    int                 m_nOffsetIndexInterval = 1000;
+    int                 m_nOffsetIndexNextFID = 1;
+    std::vector<vsi_l_offset> m_anRecordOffsets{};
+
+    CPLString           GetOffsetIndexFilename() const;
+    bool                LoadOffsetIndex();
+    void                SaveOffsetIndex();
+    void                OffsetIndexAddRecord( int nFID, vsi_l_offset nOffset );
+    void                OffsetIndexReachedEOF( int nFID, GUInt32 nErrorCounter );
+    bool                SeekWithOffsetIndex( int nFID );
+    char              **GetNextRecordTokens();
+    bool                SkipToFID( int nFID );
 
     bool                bNew;
     bool                bInWriteMode;
@@ -175,6 +216,7 @@ class OGRCSVLayer final: public OGRLayer
     void                ResetReading() override;
     OGRFeature         *GetNextFeature() override;
     virtual OGRFeature *GetFeature( GIntBig nFID ) override;
+    virtual OGRErr      SetNextByIndex( GIntBig nIndex ) override;
 
     OGRFeatureDefn     *GetLayerDefn() override { return poFeatureDefn; }
 
@@ -389,6 +389,8 @@ void RegisterOGRCSV()
 "  </Option>"
 "  <Option name='EMPTY_STRING_AS_NULL' type='boolean' description='Whether to consider empty strings as null fields on reading' default='NO'/>"
 "  <Option name='MAX_LINE_SIZE' type='int' description='Maximum number of bytes for a line (-1=unlimited)' default='" STRINGIFY(OGR_CSV_DEFAULT_MAX_LINE_SIZE) "'/>"
+"  <Option name='OFFSET_INDEX' type='boolean' description='Whether to use, or create after a full scan, a .fidx sidecar file with record offsets, to speed up random access' default='NO'/>"
+"  <Option name='NUM_THREADS' type='string' description='Number of worker threads used to parse and translate records (integer or ALL_CPUS). Defaults to GDAL_NUM_THREADS, or 1'/>"
 "</OpenOptionList>");
 
     poDriver->SetMetadataItem(GDAL_DCAP_VIRTUALIO, "YES");
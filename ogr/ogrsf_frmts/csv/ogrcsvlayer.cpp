@@ -47,8 +47,12 @@
 #include "cpl_conv.h"
 #include "cpl_csv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
+#include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -178,6 +182,11 @@ void OGRCSVLayer::BuildFeatureDefn( const char *pszNfdcGeomField,
     bEmptyStringNull =
         CPLFetchBool(papszOpenOptions, "EMPTY_STRING_AS_NULL", false);
 
+    m_nNumThreads = bNew ? 1 : GDALGetNumThreads(papszOpenOptions);
+    if( m_nNumThreads > 1 )
+        CPLDebug("CSV", "Using %d threads to read %s",
+                 m_nNumThreads, pszFilename);
+
     // If this is not a new file, read ahead to establish if it is
     // already in CRLF (DOS) mode, or just a normal unix CR mode.
     if( !bNew && bInWriteMode )
@@ -889,6 +898,11 @@ void OGRCSVLayer::BuildFeatureDefn( const char *pszNfdcGeomField,
 
     CSLDestroy(papszTokens);
     CSLDestroy(papszFieldTypes);
+
+    m_bUseOffsetIndex = !bNew && !bInWriteMode && fpCSV != nullptr &&
+                        CPLFetchBool(papszOpenOptions, "OFFSET_INDEX", false);
+    if( m_bUseOffsetIndex )
+        LoadOffsetIndex();
 }
 
 /************************************************************************/
@@ -1318,6 +1332,8 @@ void OGRCSVLayer::ResetReading()
     bNeedRewindBeforeRead = false;
 
     nNextFID = 1;
+
+    ClearFeatureQueue();
 }
 
 /************************************************************************/
@@ -1348,41 +1364,330 @@ char **OGRCSVLayer::GetNextLineTokens()
 }
 
 /************************************************************************/
-/*                             GetFeature()                             */
+/*                        GetNextRecordTokens()                         */
+/*                                                                      */
+/*      GetNextLineTokens() for the record of FID nNextFID, recording   */
+/*      its offset in the offset index when it is being built.          */
 /************************************************************************/
 
-OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
+char **OGRCSVLayer::GetNextRecordTokens()
 {
-    if( nFID < 1 || fpCSV == nullptr )
-        return nullptr;
-    if( nFID < nNextFID || bNeedRewindBeforeRead )
+    if( !m_bUseOffsetIndex || m_bOffsetIndexComplete )
+        return GetNextLineTokens();
+
+    const vsi_l_offset nOffset = VSIFTellL(fpCSV);
+    const GUInt32 nErrorCounter = CPLGetErrorCounter();
+    char **papszTokens = GetNextLineTokens();
+    if( papszTokens != nullptr )
+        OffsetIndexAddRecord(nNextFID, nOffset);
+    else
+        OffsetIndexReachedEOF(nNextFID, nErrorCounter);
+    return papszTokens;
+}
+
+/************************************************************************/
+/*                            SkipToFID()                               */
+/*                                                                      */
+/*      Position the reading so that the next record read is the one   */
+/*      of FID nFID.                                                    */
+/************************************************************************/
+
+bool OGRCSVLayer::SkipToFID( int nFID )
+{
+    // The file position is ahead of nNextFID when features are queued.
+    if( !SeekWithOffsetIndex(nFID) &&
+        (nFID < nNextFID || bNeedRewindBeforeRead ||
+         !m_apoPendingFeatures.empty() || !m_osPendingBytes.empty()) )
+    {
         ResetReading();
+    }
     while( nNextFID < nFID )
     {
-        char **papszTokens = GetNextLineTokens();
+        char **papszTokens = GetNextRecordTokens();
         if( papszTokens == nullptr )
-            return nullptr;
+            return false;
         CSLDestroy(papszTokens);
         nNextFID++;
     }
+    return true;
+}
+
+/************************************************************************/
+/*                             GetFeature()                             */
+/************************************************************************/
+
+OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
+{
+    if( nFID < 1 || nFID > INT_MAX || fpCSV == nullptr )
+        return nullptr;
+    if( m_bOffsetIndexComplete && nFID > nTotalFeatures )
+        return nullptr;
+    if( !SkipToFID(static_cast<int>(nFID)) )
+        return nullptr;
     return GetNextUnfilteredFeature();
 }
 
 /************************************************************************/
-/*                      GetNextUnfilteredFeature()                      */
+/*                           SetNextByIndex()                           */
 /************************************************************************/
 
-OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
+OGRErr OGRCSVLayer::SetNextByIndex( GIntBig nIndex )
+{
+    if( m_poFilterGeom != nullptr || m_poAttrQuery != nullptr ||
+        nIndex < 0 || nIndex >= INT_MAX || fpCSV == nullptr )
+    {
+        return OGRLayer::SetNextByIndex(nIndex);
+    }
+    if( m_bOffsetIndexComplete && nIndex >= nTotalFeatures )
+        return OGRERR_FAILURE;
+    return SkipToFID(static_cast<int>(nIndex) + 1) ? OGRERR_NONE :
+                                                     OGRERR_FAILURE;
+}
 
+/************************************************************************/
+/*                      GetOffsetIndexFilename()                        */
+/************************************************************************/
+
+CPLString OGRCSVLayer::GetOffsetIndexFilename() const
 {
-    if( fpCSV == nullptr )
-        return nullptr;
+    return CPLString(pszFilename) + ".fidx";
+}
 
-    // Read the CSV record.
-    char **papszTokens = GetNextLineTokens();
-    if( papszTokens == nullptr )
-        return nullptr;
+// Layout of the offset index file, all values being little endian:
+//  0: magic
+//  8: uint64 size of the CSV file
+// 16: int64 modification time of the CSV file
+// 24: uint8 delimiter
+// 25: uint8 whether strings are honoured
+// 26: uint8 whether consecutive delimiters are merged
+// 27: uint8 reserved
+// 28: uint32 interval between indexed records
+// 32: uint64 number of records
+// 40: uint64 number of offsets
+// 48: uint64 offsets
+constexpr const char OFFSET_INDEX_MAGIC[] = "OGRCSVI1";
+constexpr int OFFSET_INDEX_HEADER_SIZE = 48;
+
+/************************************************************************/
+/*                          LoadOffsetIndex()                           */
+/************************************************************************/
+
+bool OGRCSVLayer::LoadOffsetIndex()
+{
+    VSIStatBufL sStat;
+    if( VSIStatL(pszFilename, &sStat) != 0 )
+        return false;
+
+    const CPLString osIndexFilename(GetOffsetIndexFilename());
+    VSILFILE *fp = VSIFOpenL(osIndexFilename, "rb");
+    if( fp == nullptr )
+        return false;
+
+    const auto ReadUInt64 = [](const GByte *pabyData)
+    {
+        uint64_t nVal;
+        memcpy(&nVal, pabyData, sizeof(nVal));
+        CPL_LSBPTR64(&nVal);
+        return nVal;
+    };
+
+    GByte abyHeader[OFFSET_INDEX_HEADER_SIZE];
+    bool bOK = VSIFReadL(abyHeader, 1, sizeof(abyHeader), fp) ==
+                   sizeof(abyHeader) &&
+               memcmp(abyHeader, OFFSET_INDEX_MAGIC, 8) == 0;
+    if( bOK )
+    {
+        uint32_t nInterval;
+        memcpy(&nInterval, abyHeader + 28, sizeof(nInterval));
+        CPL_LSBPTR32(&nInterval);
+        const uint64_t nRecords = ReadUInt64(abyHeader + 32);
+        const uint64_t nOffsets = ReadUInt64(abyHeader + 40);
+
+        // Check that the index matches the CSV file and the way it is
+        // split into records.
+        bOK = ReadUInt64(abyHeader + 8) == static_cast<uint64_t>(sStat.st_size) &&
+              static_cast<int64_t>(ReadUInt64(abyHeader + 16)) ==
+                  static_cast<int64_t>(sStat.st_mtime) &&
+              abyHeader[24] == static_cast<GByte>(szDelimiter[0]) &&
+              abyHeader[25] == static_cast<GByte>(bHonourStrings) &&
+              abyHeader[26] == static_cast<GByte>(bMergeDelimiter) &&
+              nInterval > 0 && nInterval <= INT_MAX &&
+              nRecords < static_cast<uint64_t>(INT_MAX) &&
+              nOffsets == (nRecords + nInterval - 1) / nInterval;
+        if( bOK )
+        {
+            try
+            {
+                m_anRecordOffsets.resize(static_cast<size_t>(nOffsets));
+            }
+            catch( const std::exception & )
+            {
+                bOK = false;
+            }
+        }
+        if( bOK && nOffsets > 0 )
+        {
+            bOK = VSIFReadL(m_anRecordOffsets.data(), sizeof(uint64_t),
+                            static_cast<size_t>(nOffsets), fp) == nOffsets;
+#ifdef CPL_MSB
+            for( auto &nOffset: m_anRecordOffsets )
+                CPL_LSBPTR64(&nOffset);
+#endif
+        }
+        if( bOK )
+        {
+            m_nOffsetIndexInterval = static_cast<int>(nInterval);
+            m_nOffsetIndexNextFID = static_cast<int>(nRecords) + 1;
+            m_bOffsetIndexComplete = true;
+            nTotalFeatures = static_cast<GIntBig>(nRecords);
+        }
+    }
+    VSIFCloseL(fp);
+
+    if( !bOK )
+    {
+        m_anRecordOffsets.clear();
+        CPLDebug("CSV", "Ignoring %s which does not match %s",
+                 osIndexFilename.c_str(), pszFilename);
+    }
+    return bOK;
+}
+
+/************************************************************************/
+/*                          SaveOffsetIndex()                           */
+/************************************************************************/
+
+void OGRCSVLayer::SaveOffsetIndex()
+{
+    VSIStatBufL sStat;
+    if( VSIStatL(pszFilename, &sStat) != 0 )
+        return;
+
+    const auto WriteUInt64 = [](GByte *pabyData, uint64_t nVal)
+    {
+        CPL_LSBPTR64(&nVal);
+        memcpy(pabyData, &nVal, sizeof(nVal));
+    };
+
+    GByte abyHeader[OFFSET_INDEX_HEADER_SIZE] = {};
+    memcpy(abyHeader, OFFSET_INDEX_MAGIC, 8);
+    WriteUInt64(abyHeader + 8, static_cast<uint64_t>(sStat.st_size));
+    WriteUInt64(abyHeader + 16, static_cast<uint64_t>(sStat.st_mtime));
+    abyHeader[24] = static_cast<GByte>(szDelimiter[0]);
+    abyHeader[25] = static_cast<GByte>(bHonourStrings);
+    abyHeader[26] = static_cast<GByte>(bMergeDelimiter);
+    uint32_t nInterval = static_cast<uint32_t>(m_nOffsetIndexInterval);
+    CPL_LSBPTR32(&nInterval);
+    memcpy(abyHeader + 28, &nInterval, sizeof(nInterval));
+    WriteUInt64(abyHeader + 32, static_cast<uint64_t>(nTotalFeatures));
+    WriteUInt64(abyHeader + 40, m_anRecordOffsets.size());
+
+    // The index is an optimization: do not complain if the directory is
+    // read-only.
+    const CPLString osIndexFilename(GetOffsetIndexFilename());
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    VSILFILE *fp = VSIFOpenL(osIndexFilename, "wb");
+    CPLPopErrorHandler();
+    if( fp == nullptr )
+    {
+        CPLDebug("CSV", "Cannot create %s", osIndexFilename.c_str());
+        return;
+    }
+
+    bool bOK = VSIFWriteL(abyHeader, 1, sizeof(abyHeader), fp) ==
+               sizeof(abyHeader);
+    for( size_t i = 0; bOK && i < m_anRecordOffsets.size(); ++i )
+    {
+        GByte abyOffset[sizeof(uint64_t)];
+        WriteUInt64(abyOffset, m_anRecordOffsets[i]);
+        bOK = VSIFWriteL(abyOffset, 1, sizeof(abyOffset), fp) ==
+              sizeof(abyOffset);
+    }
+    if( VSIFCloseL(fp) != 0 )
+        bOK = false;
+    if( !bOK )
+    {
+        CPLDebug("CSV", "Cannot write %s", osIndexFilename.c_str());
+        VSIUnlink(osIndexFilename);
+    }
+}
+
+/************************************************************************/
+/*                        OffsetIndexAddRecord()                        */
+/************************************************************************/
+
+void OGRCSVLayer::OffsetIndexAddRecord( int nFID, vsi_l_offset nOffset )
+{
+    // Only records read in sequence since the first one are indexed.
+    if( nFID != m_nOffsetIndexNextFID )
+        return;
+    if( (nFID - 1) % m_nOffsetIndexInterval == 0 )
+        m_anRecordOffsets.push_back(nOffset);
+    m_nOffsetIndexNextFID++;
+}
+
+/************************************************************************/
+/*                       OffsetIndexReachedEOF()                        */
+/************************************************************************/
+
+void OGRCSVLayer::OffsetIndexReachedEOF( int nFID, GUInt32 nErrorCounter )
+{
+    // Do not save an index truncated by a read error.
+    if( nFID != m_nOffsetIndexNextFID ||
+        CPLGetErrorCounter() != nErrorCounter )
+        return;
+    m_bOffsetIndexComplete = true;
+    nTotalFeatures = nFID - 1;
+    SaveOffsetIndex();
+}
+
+/************************************************************************/
+/*                        SeekWithOffsetIndex()                         */
+/*                                                                      */
+/*      Seek to the closest indexed record before nFID, unless the      */
+/*      current position is already between it and nFID.                */
+/************************************************************************/
+
+bool OGRCSVLayer::SeekWithOffsetIndex( int nFID )
+{
+    if( !m_bUseOffsetIndex || m_anRecordOffsets.empty() )
+        return false;
+
+    const size_t nIdx = std::min(
+        static_cast<size_t>((nFID - 1) / m_nOffsetIndexInterval),
+        m_anRecordOffsets.size() - 1);
+    const int nIndexedFID =
+        1 + static_cast<int>(nIdx) * m_nOffsetIndexInterval;
+    if( !bNeedRewindBeforeRead && m_apoPendingFeatures.empty() &&
+        m_osPendingBytes.empty() &&
+        nNextFID >= nIndexedFID && nNextFID <= nFID )
+    {
+        return true;
+    }
+
+    if( VSIFSeekL(fpCSV, m_anRecordOffsets[nIdx], SEEK_SET) != 0 )
+        return false;
+    ClearFeatureQueue();
+    bNeedRewindBeforeRead = false;
+    nNextFID = nIndexedFID;
+    return true;
+}
+
+/************************************************************************/
+/*                          TranslateRecord()                           */
+/*                                                                      */
+/*      Builds a feature from the tokens of a record, which are         */
+/*      freed. Does not modify the layer state, so that it can be       */
+/*      called from worker threads: the warning about a bad value       */
+/*      type or width, emitted only once, is returned in osWarning      */
+/*      when bWarningBadTypeOrWidthInOut is switched on.                */
+/************************************************************************/
+
+OGRFeature *OGRCSVLayer::TranslateRecord( char **papszTokens, int nFID,
+                                          bool &bWarningBadTypeOrWidthInOut,
+                                          CPLString &osWarning ) const
 
+{
     // Create the OGR feature.
     OGRFeature *poFeature = new OGRFeature(poFeatureDefn);
 
@@ -1466,14 +1771,13 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                 {
                     poFeature->SetField(iOGRField, 0);
                 }
-                else if( !bWarningBadTypeOrWidth )
+                else if( !bWarningBadTypeOrWidthInOut )
                 {
-                    bWarningBadTypeOrWidth = true;
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
+                    bWarningBadTypeOrWidthInOut = true;
+                    osWarning.Printf(
                         "Invalid value type found in record %d for field %s. "
                         "This warning will no longer be emitted",
-                        nNextFID, poFieldDefn->GetNameRef());
+                        nFID, poFieldDefn->GetNameRef());
                 }
             }
         }
@@ -1492,31 +1796,31 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                 if( eType == CPL_VALUE_INTEGER || eType == CPL_VALUE_REAL )
                 {
                     poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                    if( !bWarningBadTypeOrWidth &&
+                    if( !bWarningBadTypeOrWidthInOut &&
                         (eFieldType == OFTInteger ||
                          eFieldType == OFTInteger64) &&
                         eType == CPL_VALUE_REAL )
                     {
-                        bWarningBadTypeOrWidth = true;
-                        CPLError(CE_Warning, CPLE_AppDefined,
-                                 "Invalid value type found in record %d for "
-                                 "field %s. "
-                                 "This warning will no longer be emitted",
-                                 nNextFID, poFieldDefn->GetNameRef());
+                        bWarningBadTypeOrWidthInOut = true;
+                        osWarning.Printf(
+                            "Invalid value type found in record %d for "
+                            "field %s. "
+                            "This warning will no longer be emitted",
+                            nFID, poFieldDefn->GetNameRef());
                     }
-                    else if( !bWarningBadTypeOrWidth &&
+                    else if( !bWarningBadTypeOrWidthInOut &&
                              poFieldDefn->GetWidth() > 0 &&
                              static_cast<int>(strlen(papszTokens[iAttr])) >
                                  poFieldDefn->GetWidth() )
                     {
-                        bWarningBadTypeOrWidth = true;
-                        CPLError(CE_Warning, CPLE_AppDefined,
-                                 "Value with a width greater than field width "
-                                 "found in record %d for field %s. "
-                                 "This warning will no longer be emitted",
-                                 nNextFID, poFieldDefn->GetNameRef());
+                        bWarningBadTypeOrWidthInOut = true;
+                        osWarning.Printf(
+                            "Value with a width greater than field width "
+                            "found in record %d for field %s. "
+                            "This warning will no longer be emitted",
+                            nFID, poFieldDefn->GetNameRef());
                     }
-                    else if( !bWarningBadTypeOrWidth &&
+                    else if( !bWarningBadTypeOrWidthInOut &&
                              eType == CPL_VALUE_REAL &&
                              poFieldDefn->GetWidth() > 0)
                     {
@@ -1527,26 +1831,25 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                                 : 0;
                         if( nPrecision > poFieldDefn->GetPrecision() )
                         {
-                            bWarningBadTypeOrWidth = true;
-                            CPLError(CE_Warning, CPLE_AppDefined,
-                                     "Value with a precision greater than "
-                                     "field precision found in record %d for "
-                                     "field %s. "
-                                     "This warning will no longer be emitted",
-                                     nNextFID, poFieldDefn->GetNameRef());
+                            bWarningBadTypeOrWidthInOut = true;
+                            osWarning.Printf(
+                                "Value with a precision greater than "
+                                "field precision found in record %d for "
+                                "field %s. "
+                                "This warning will no longer be emitted",
+                                nFID, poFieldDefn->GetNameRef());
                         }
                     }
                 }
                 else
                 {
-                    if( !bWarningBadTypeOrWidth )
+                    if( !bWarningBadTypeOrWidthInOut )
                     {
-                        bWarningBadTypeOrWidth = true;
-                        CPLError(
-                            CE_Warning, CPLE_AppDefined,
+                        bWarningBadTypeOrWidthInOut = true;
+                        osWarning.Printf(
                             "Invalid value type found in record %d for field "
                             "%s. This warning will no longer be emitted.",
-                            nNextFID, poFieldDefn->GetNameRef());
+                            nFID, poFieldDefn->GetNameRef());
                     }
                 }
             }
@@ -1556,15 +1859,14 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
             if( papszTokens[iAttr][0] != '\0' && !poFieldDefn->IsIgnored() )
             {
                 poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                if( !bWarningBadTypeOrWidth &&
+                if( !bWarningBadTypeOrWidthInOut &&
                     !poFeature->IsFieldSetAndNotNull(iOGRField) )
                 {
-                    bWarningBadTypeOrWidth = true;
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
+                    bWarningBadTypeOrWidthInOut = true;
+                    osWarning.Printf(
                         "Invalid value type found in record %d for field %s. "
                         "This warning will no longer be emitted",
-                        nNextFID, poFieldDefn->GetNameRef());
+                        nFID, poFieldDefn->GetNameRef());
                 }
             }
         }
@@ -1577,16 +1879,16 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
             else
             {
                 poFeature->SetField(iOGRField, papszTokens[iAttr]);
-                if( !bWarningBadTypeOrWidth && poFieldDefn->GetWidth() > 0 &&
+                if( !bWarningBadTypeOrWidthInOut && poFieldDefn->GetWidth() > 0 &&
                     static_cast<int>(strlen(papszTokens[iAttr])) >
                         poFieldDefn->GetWidth() )
                 {
-                    bWarningBadTypeOrWidth = true;
-                    CPLError(CE_Warning, CPLE_AppDefined,
-                             "Value with a width greater than field width "
-                             "found in record %d for field %s. "
-                             "This warning will no longer be emitted",
-                             nNextFID, poFieldDefn->GetNameRef());
+                    bWarningBadTypeOrWidthInOut = true;
+                    osWarning.Printf(
+                        "Value with a width greater than field width "
+                        "found in record %d for field %s. "
+                        "This warning will no longer be emitted",
+                        nFID, poFieldDefn->GetNameRef());
                 }
             }
         }
@@ -1704,8 +2006,358 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
 
     CSLDestroy(papszTokens);
 
-    // Translate the record id.
-    poFeature->SetFID(nNextFID++);
+    poFeature->SetFID(nFID);
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                      GetNextUnfilteredFeature()                      */
+/************************************************************************/
+
+OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
+
+{
+    if( fpCSV == nullptr )
+        return nullptr;
+
+    // Read the CSV record.
+    char **papszTokens = GetNextRecordTokens();
+    if( papszTokens == nullptr )
+        return nullptr;
+
+    CPLString osWarning;
+    OGRFeature *poFeature =
+        TranslateRecord(papszTokens, nNextFID, bWarningBadTypeOrWidth,
+                        osWarning);
+    if( !osWarning.empty() )
+        CPLError(CE_Warning, CPLE_AppDefined, "%s", osWarning.c_str());
+
+    nNextFID++;
+
+    m_nFeaturesRead++;
+
+    return poFeature;
+}
+
+/************************************************************************/
+/*                        OGRCSVLayer::ReadChunk                        */
+/************************************************************************/
+
+struct OGRCSVLayer::ReadChunk
+{
+    const OGRCSVLayer *poLayer = nullptr;
+    const char *pszData = nullptr;
+    size_t nSize = 0;
+    std::vector<char **> apapszRecords{};
+    int nFirstFID = 0;
+    bool bWarningBadTypeOrWidth = false;
+    CPLString osWarning{};
+    size_t nWarningErrorIdx = 0;
+    std::vector<std::unique_ptr<OGRFeature>> apoFeatures{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+
+    ReadChunk() = default;
+    ReadChunk(const ReadChunk&) = delete;
+    ReadChunk& operator=(const ReadChunk&) = delete;
+
+    ~ReadChunk()
+    {
+        for( char **papszTokens: apapszRecords )
+            CSLDestroy(papszTokens);
+    }
+
+    bool HasFailure() const
+    {
+        for( const auto &oError: aoErrors )
+        {
+            if( oError.type == CE_Failure || oError.type == CE_Fatal )
+                return true;
+        }
+        return false;
+    }
+};
+
+/************************************************************************/
+/*                         TokenizeChunkJob()                           */
+/************************************************************************/
+
+void OGRCSVLayer::TokenizeChunkJob( void *pData )
+{
+    ReadChunk *psChunk = static_cast<ReadChunk *>(pData);
+    const OGRCSVLayer *poLayer = psChunk->poLayer;
+
+    CPLInstallErrorHandlerAccumulator(psChunk->aoErrors);
+    CPLSetCurrentErrorHandlerCatchDebug( FALSE );
+
+    // Parse the chunk with the same function as GetNextLineTokens(), so
+    // that records are split identically.
+    const CPLString osTmpFilename(
+        CPLSPrintf("/vsimem/ogrcsv_chunk_%p", psChunk));
+    VSILFILE *fp = VSIFileFromMemBuffer(
+        osTmpFilename,
+        reinterpret_cast<GByte *>(const_cast<char *>(psChunk->pszData)),
+        psChunk->nSize, FALSE);
+    if( fp != nullptr )
+    {
+        while( true )
+        {
+            char **papszTokens = CSVReadParseLine3L( fp,
+                                    poLayer->m_nMaxLineSize,
+                                    poLayer->szDelimiter,
+                                    poLayer->bHonourStrings,
+                                    false, // bKeepLeadingAndClosingQuotes
+                                    poLayer->bMergeDelimiter,
+                                    true // bSkipBOM
+                                  );
+            if( papszTokens == nullptr )
+                break;
+            if( papszTokens[0] == nullptr )
+            {
+                CSLDestroy(papszTokens);
+                continue;
+            }
+            psChunk->apapszRecords.push_back(papszTokens);
+        }
+        VSIFCloseL(fp);
+        VSIUnlink(osTmpFilename);
+    }
+
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                         TranslateChunkJob()                          */
+/************************************************************************/
+
+void OGRCSVLayer::TranslateChunkJob( void *pData )
+{
+    ReadChunk *psChunk = static_cast<ReadChunk *>(pData);
+
+    CPLInstallErrorHandlerAccumulator(psChunk->aoErrors);
+    CPLSetCurrentErrorHandlerCatchDebug( FALSE );
+
+    int nFID = psChunk->nFirstFID;
+    for( char **papszTokens: psChunk->apapszRecords )
+    {
+        CPLString osWarning;
+        psChunk->apoFeatures.emplace_back(
+            psChunk->poLayer->TranslateRecord(papszTokens, nFID,
+                                              psChunk->bWarningBadTypeOrWidth,
+                                              osWarning));
+        if( !osWarning.empty() )
+        {
+            psChunk->osWarning = std::move(osWarning);
+            psChunk->nWarningErrorIdx = psChunk->aoErrors.size();
+        }
+        nFID++;
+    }
+    // Tokens are freed by TranslateRecord()
+    psChunk->apapszRecords.clear();
+
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                         ClearFeatureQueue()                          */
+/************************************************************************/
+
+void OGRCSVLayer::ClearFeatureQueue()
+{
+    m_apoPendingFeatures.clear();
+    m_osPendingBytes.clear();
+    m_bReadEOF = false;
+}
+
+/************************************************************************/
+/*                         FillFeatureQueue()                           */
+/*                                                                      */
+/*      Reads the next block of the file, splits it into chunks of      */
+/*      whole records, and translates them on worker threads. Record    */
+/*      boundaries are found with a sequential scan that tracks the     */
+/*      quoting state, as a record may span several lines when a       */
+/*      quoted value contains a newline.                                */
+/************************************************************************/
+
+bool OGRCSVLayer::FillFeatureQueue()
+{
+    // Size in bytes of the chunk given to each thread. Lowering it with
+    // OGR_CSV_CHUNK_SIZE lets tests exercise records straddling chunks.
+    const size_t nChunkSize = static_cast<size_t>(std::max(1, atoi(
+        CPLGetConfigOption("OGR_CSV_CHUNK_SIZE", "1048576"))));
+    const size_t nBlockSize = nChunkSize * m_nNumThreads;
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(m_nNumThreads);
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if( !poQueue )
+        return false;
+
+    while( m_apoPendingFeatures.empty() )
+    {
+        if( m_bReadEOF && m_osPendingBytes.empty() )
+            return false;
+
+        // Read data until at least one record is complete.
+        std::string &osData = m_osPendingBytes;
+        std::vector<size_t> anChunkEnds;
+        size_t nLastRecordEnd = 0;
+        size_t nScanPos = 0;
+        bool bInQuotes = false;
+        while( true )
+        {
+            if( !m_bReadEOF )
+            {
+                const size_t nOldSize = osData.size();
+                try
+                {
+                    osData.resize(nOldSize + nBlockSize);
+                }
+                catch( const std::exception &e )
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory, "%s", e.what());
+                    return false;
+                }
+                const size_t nRead =
+                    VSIFReadL(&osData[nOldSize], 1, nBlockSize, fpCSV);
+                osData.resize(nOldSize + nRead);
+                if( nRead < nBlockSize )
+                    m_bReadEOF = true;
+            }
+
+            const size_t nSize = osData.size();
+            size_t i = nScanPos;
+            for( ; i < nSize; ++i )
+            {
+                const char ch = osData[i];
+                if( ch == '"' && bHonourStrings )
+                {
+                    bInQuotes = !bInQuotes;
+                }
+                else if( (ch == '\n' || ch == '\r') && !bInQuotes )
+                {
+                    // Same end-of-line sequences as CPLReadLine3L().
+                    size_t nRecordEnd = i + 1;
+                    if( i + 1 == nSize )
+                    {
+                        if( !m_bReadEOF )
+                            break;
+                    }
+                    else if( (ch == '\r' && osData[i + 1] == '\n') ||
+                             (ch == '\n' && osData[i + 1] == '\r') )
+                    {
+                        nRecordEnd = i + 2;
+                        ++i;
+                    }
+                    nLastRecordEnd = nRecordEnd;
+                    if( nRecordEnd >= (anChunkEnds.empty() ? 0 :
+                                       anChunkEnds.back()) + nChunkSize )
+                    {
+                        anChunkEnds.push_back(nRecordEnd);
+                    }
+                }
+            }
+            nScanPos = i;
+
+            if( m_bReadEOF )
+            {
+                nLastRecordEnd = nSize;
+                break;
+            }
+            if( nLastRecordEnd > 0 )
+                break;
+        }
+
+        // The last chunk ends with the last complete record. Merge it into
+        // the previous one if it is small.
+        if( !anChunkEnds.empty() &&
+            nLastRecordEnd - anChunkEnds.back() < nChunkSize / 2 )
+        {
+            anChunkEnds.back() = nLastRecordEnd;
+        }
+        else if( anChunkEnds.empty() || anChunkEnds.back() != nLastRecordEnd )
+        {
+            anChunkEnds.push_back(nLastRecordEnd);
+        }
+
+        std::vector<std::unique_ptr<ReadChunk>> apoChunks;
+        size_t nChunkStart = 0;
+        for( const size_t nChunkEnd: anChunkEnds )
+        {
+            std::unique_ptr<ReadChunk> poChunk(new ReadChunk());
+            poChunk->poLayer = this;
+            poChunk->pszData = osData.data() + nChunkStart;
+            poChunk->nSize = nChunkEnd - nChunkStart;
+            nChunkStart = nChunkEnd;
+            poQueue->SubmitJob(TokenizeChunkJob, poChunk.get());
+            apoChunks.emplace_back(std::move(poChunk));
+        }
+        poQueue->WaitCompletion();
+
+        // Assign FIDs, and stop after a chunk with a parsing error, as
+        // GetNextLineTokens() would. The errors of a chunk must be checked
+        // before it is submitted, as the worker appends to them.
+        int nFID = nNextFID;
+        for( size_t i = 0; i < apoChunks.size(); ++i )
+        {
+            auto &poChunk = apoChunks[i];
+            poChunk->nFirstFID = nFID;
+            poChunk->bWarningBadTypeOrWidth = bWarningBadTypeOrWidth;
+            nFID += static_cast<int>(poChunk->apapszRecords.size());
+            const bool bTokenizeFailure = poChunk->HasFailure();
+            poQueue->SubmitJob(TranslateChunkJob, poChunk.get());
+            if( bTokenizeFailure )
+            {
+                apoChunks.resize(i + 1);
+                m_bReadEOF = true;
+                nLastRecordEnd = osData.size();
+                break;
+            }
+        }
+        poQueue->WaitCompletion();
+
+        for( auto &poChunk: apoChunks )
+        {
+            for( size_t i = 0; i <= poChunk->aoErrors.size(); ++i )
+            {
+                if( i == poChunk->nWarningErrorIdx &&
+                    !poChunk->osWarning.empty() && !bWarningBadTypeOrWidth )
+                {
+                    bWarningBadTypeOrWidth = true;
+                    CPLError(CE_Warning, CPLE_AppDefined, "%s",
+                             poChunk->osWarning.c_str());
+                }
+                if( i < poChunk->aoErrors.size() )
+                {
+                    const auto &oError = poChunk->aoErrors[i];
+                    CPLError(oError.type, oError.no, "%s",
+                             oError.msg.c_str());
+                }
+            }
+            for( auto &poFeature: poChunk->apoFeatures )
+                m_apoPendingFeatures.emplace_back(std::move(poFeature));
+        }
+
+        osData.erase(0, nLastRecordEnd);
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                        GetNextQueuedFeature()                        */
+/************************************************************************/
+
+OGRFeature *OGRCSVLayer::GetNextQueuedFeature()
+{
+    if( fpCSV == nullptr )
+        return nullptr;
+
+    if( m_apoPendingFeatures.empty() && !FillFeatureQueue() )
+        return nullptr;
+
+    OGRFeature *poFeature = m_apoPendingFeatures.front().release();
+    m_apoPendingFeatures.pop_front();
+    nNextFID = static_cast<int>(poFeature->GetFID()) + 1;
 
     m_nFeaturesRead++;
 
@@ -1726,7 +2378,8 @@ OGRFeature *OGRCSVLayer::GetNextFeature()
     // spatial criteria.
     while( true )
     {
-        OGRFeature *poFeature = GetNextUnfilteredFeature();
+        OGRFeature *poFeature = m_nNumThreads > 1 ? GetNextQueuedFeature() :
+                                                    GetNextUnfilteredFeature();
         if( poFeature == nullptr )
             return nullptr;
 
@@ -1755,6 +2408,10 @@ int OGRCSVLayer::TestCapability( const char *pszCap )
                eGeometryFormat == OGR_CSV_GEOM_AS_WKT;
     else if( EQUAL(pszCap, OLCIgnoreFields) )
         return TRUE;
+    else if( EQUAL(pszCap, OLCFastFeatureCount) ||
+             EQUAL(pszCap, OLCFastSetNextByIndex) )
+        return m_bOffsetIndexComplete && m_poFilterGeom == nullptr &&
+               m_poAttrQuery == nullptr;
     else if( EQUAL(pszCap, OLCCurveGeometries) )
         return TRUE;
     else if( EQUAL(pszCap, OLCMeasuredGeometries) )
@@ -2490,7 +3147,7 @@ GIntBig OGRCSVLayer::GetFeatureCount( int bForce )
 
     ResetReading();
 
-    if( szDelimiter[0] == '\t' && !bHonourStrings )
+    if( szDelimiter[0] == '\t' && !bHonourStrings && !m_bUseOffsetIndex )
     {
         const int nBufSize = 4096;
         char szBuffer[nBufSize + 1] = {};
@@ -2523,17 +3180,19 @@ GIntBig OGRCSVLayer::GetFeatureCount( int bForce )
     }
     else
     {
-        nTotalFeatures = 0;
+        GIntBig nCount = 0;
         while( true )
         {
-            char **papszTokens = GetNextLineTokens();
+            char **papszTokens = GetNextRecordTokens();
             if( papszTokens == nullptr )
                 break;
 
-            nTotalFeatures++;
+            nCount++;
+            nNextFID++;
 
             CSLDestroy(papszTokens);
         }
+        nTotalFeatures = nCount;
     }
 
     ResetReading();
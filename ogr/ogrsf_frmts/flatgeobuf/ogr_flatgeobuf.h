@@ -32,11 +32,13 @@
 #include "ogrsf_frmts.h"
 #include "ogr_p.h"
 #include "ogreditablelayer.h"
+#include "cpl_virtualmem.h"
 
 #include "header_generated.h"
 #include "feature_generated.h"
 #include "packedrtree.h"
 
+#include <functional>
 #include <limits>
 
 class OGRFlatGeobufDataset;
@@ -72,6 +74,12 @@ class OGRFlatGeobufLayer final : public OGRLayer, public OGRFlatGeobufBaseLayerI
         VSILFILE *m_poFp = nullptr;
         vsi_l_offset m_nFileSize = 0;
 
+        // memory mapping of the file, when m_poFp is a /vsimem/ or local file
+        bool m_bMappingTried = false;
+        CPLVirtualMem *m_psVirtualMem = nullptr;
+        const GByte *m_pabyMapped = nullptr;
+        vsi_l_offset m_nMappedSize = 0;
+
         const FlatGeobuf::Header *m_poHeader = nullptr;
         GByte *m_headerBuf = nullptr;
         OGRwkbGeometryType m_eGType;
@@ -87,6 +95,7 @@ class OGRFlatGeobufLayer final : public OGRLayer, public OGRFlatGeobufBaseLayerI
 
         // iteration
         bool m_bEOF = false;
+        bool m_bReadEOF = false; // end of file reached by readFeatureData()
         size_t m_featuresPos = 0; // current iteration position
         uint64_t m_offset = 0; // current read offset
         uint64_t m_offsetFeatures = 0; // offset of feature data
@@ -97,7 +106,12 @@ class OGRFlatGeobufLayer final : public OGRLayer, public OGRFlatGeobufBaseLayerI
 
         // creation
         bool m_create = false;
-        std::vector<std::shared_ptr<FlatGeobuf::Item>> m_featureItems; // feature item description used to create spatial index
+        std::vector<FeatureItem> m_featureItems; // feature item description used to create spatial index
+        size_t m_maxFeatureItemsInMemory = 0; // above that, m_featureItems is spilled to m_poFpItems
+        VSILFILE *m_poFpItems = nullptr; // temporary file of feature items, sorted by runs on close
+        std::string m_osItemsTempFile;
+        uint64_t m_spilledItemsCount = 0;
+        FlatGeobuf::NodeItem m_sortExtent = FlatGeobuf::NodeItem::create(0);
         bool m_bCreateSpatialIndexAtClose = true;
         bool m_bVerifyBuffers = true;
         VSILFILE *m_poFpWrite = nullptr;
@@ -114,6 +128,8 @@ class OGRFlatGeobufLayer final : public OGRLayer, public OGRFlatGeobufBaseLayerI
         // deserialize
         void ensurePadfBuffers(size_t count);
         OGRErr ensureFeatureBuf(uint32_t featureSize);
+        bool mapFile();
+        OGRErr readFeatureData(bool seek, const GByte *&pabyFeature, uint32_t &featureSize);
         OGRErr parseFeature(OGRFeature *poFeature);
         const std::vector<flatbuffers::Offset<FlatGeobuf::Column>> writeColumns(flatbuffers::FlatBufferBuilder &fbb);
         void readColumns();
@@ -121,6 +137,9 @@ class OGRFlatGeobufLayer final : public OGRLayer, public OGRFlatGeobufBaseLayerI
         OGRErr readFeatureOffset(uint64_t index, uint64_t &featureOffset);
 
         // serialize
+        bool spillFeatureItems();
+        bool sortFeatureItems(const FlatGeobuf::NodeItem &extent);
+        bool forEachSortedFeatureItem(const std::function<bool(const FeatureItem &)> &func);
         void Create();
         void writeHeader(VSILFILE *poFp, uint64_t featuresCount, std::vector<double> *extentVector);
 
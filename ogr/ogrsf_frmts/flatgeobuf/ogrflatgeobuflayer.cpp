@@ -32,6 +32,7 @@
 #include "cpl_json.h"
 #include "cpl_http.h"
 #include "cpl_time.h"
+#include "cpl_virtualmem.h"
 #include "ogr_p.h"
 #include "ograrrowarrayhelper.h"
 #include "ogr_recordbatch.h"
@@ -40,10 +41,13 @@
 #include "cplerrors.h"
 #include "geometryreader.h"
 #include "geometrywriter.h"
+#include "gdal_thread_pool.h"
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <new>
+#include <queue>
 #include <stdexcept>
 
 using namespace flatbuffers;
@@ -402,6 +406,249 @@ static bool SupportsSeekWhileWriting(const std::string& osFilename)
            STARTS_WITH(osFilename.c_str(), "/vsimem/");
 }
 
+/************************************************************************/
+/*                       HilbertSortFeatureItems()                      */
+/************************************************************************/
+
+namespace {
+// Items are sorted by decreasing Hilbert value, and then by increasing offset
+// in the temporary file, which gives the same order whether the items are
+// sorted in memory or in several runs.
+typedef std::pair<uint32_t, size_t> HilbertKey;
+
+struct HilbertSortJob
+{
+    const std::vector<FeatureItem> *items = nullptr;
+    std::vector<HilbertKey> *keys = nullptr;
+    const NodeItem *extent = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+};
+}
+
+static uint32_t GetHilbertSortKey(const NodeItem &item, const NodeItem &extent)
+{
+    constexpr uint32_t hilbertMax = (1 << 16) - 1;
+    return std::numeric_limits<uint32_t>::max() -
+        hilbert(item, hilbertMax, extent.minX, extent.minY, extent.width(), extent.height());
+}
+
+static void HilbertSortJobFunc(void *pData)
+{
+    const auto psJob = static_cast<HilbertSortJob*>(pData);
+    auto &keys = *(psJob->keys);
+    for (size_t i = psJob->begin; i < psJob->end; i++)
+        keys[i] = HilbertKey(GetHilbertSortKey((*psJob->items)[i].nodeItem, *psJob->extent), i);
+    std::sort(keys.begin() + psJob->begin, keys.begin() + psJob->end);
+}
+
+// Hilbert values are computed and sorted by chunks on the global thread pool,
+// and the sorted chunks are then merged.
+static void HilbertSortFeatureItems(std::vector<FeatureItem> &items, const NodeItem &extent)
+{
+    const size_t n = items.size();
+    std::vector<HilbertKey> keys(n);
+
+    constexpr size_t MIN_ITEMS_PER_THREAD = 100 * 1000;
+    const int nThreads = static_cast<int>(std::min(
+        static_cast<size_t>(GDALGetNumThreads(nullptr)),
+        std::max(static_cast<size_t>(1), n / MIN_ITEMS_PER_THREAD)));
+    CPLWorkerThreadPool *poThreadPool = nThreads > 1 ? GDALGetGlobalThreadPool(nThreads) : nullptr;
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+
+    std::vector<HilbertSortJob> jobs(poQueue ? nThreads : 1);
+    const size_t perJob = (n + jobs.size() - 1) / jobs.size();
+    for (size_t i = 0; i < jobs.size(); i++) {
+        jobs[i].items = &items;
+        jobs[i].keys = &keys;
+        jobs[i].extent = &extent;
+        jobs[i].begin = std::min(n, i * perJob);
+        jobs[i].end = std::min(n, jobs[i].begin + perJob);
+    }
+    if (poQueue) {
+        for (auto &job : jobs)
+            poQueue->SubmitJob(HilbertSortJobFunc, &job);
+        poQueue->WaitCompletion();
+        for (size_t step = 1; step < jobs.size(); step *= 2) {
+            for (size_t i = 0; i + step < jobs.size(); i += 2 * step) {
+                const size_t end = jobs[std::min(jobs.size() - 1, i + 2 * step - 1)].end;
+                std::inplace_merge(keys.begin() + jobs[i].begin,
+                                   keys.begin() + jobs[i + step].begin,
+                                   keys.begin() + end);
+            }
+        }
+    } else {
+        HilbertSortJobFunc(&jobs[0]);
+    }
+
+    std::vector<FeatureItem> sortedItems;
+    sortedItems.reserve(n);
+    for (const auto &key : keys)
+        sortedItems.push_back(items[key.second]);
+    items = std::move(sortedItems);
+}
+
+/************************************************************************/
+/*                         spillFeatureItems()                          */
+/************************************************************************/
+
+// Appends the feature items in memory to the items temporary file, when
+// they exceed the memory budget of the spatial index creation.
+bool OGRFlatGeobufLayer::spillFeatureItems()
+{
+    if (m_poFpItems == nullptr) {
+        m_osItemsTempFile = m_osTempFile + "_items.tmp";
+        m_poFpItems = VSIFOpenL(m_osItemsTempFile.c_str(), "w+b");
+        if (m_poFpItems == nullptr) {
+            CPLError(CE_Failure, CPLE_OpenFailed, "Failed to create %s",
+                     m_osItemsTempFile.c_str());
+            return false;
+        }
+        // Unlink it now to avoid stale temporary file if killing the process
+        // (only works on Unix)
+        VSIUnlink(m_osItemsTempFile.c_str());
+        CPLDebug("FlatGeobuf", "Spilling spatial index items to %s",
+                 m_osItemsTempFile.c_str());
+    }
+    if (VSIFSeekL(m_poFpItems, m_spilledItemsCount * sizeof(FeatureItem), SEEK_SET) != 0 ||
+        VSIFWriteL(m_featureItems.data(), sizeof(FeatureItem), m_featureItems.size(), m_poFpItems) != m_featureItems.size()) {
+        CPLErrorIO("writing spatial index items");
+        return false;
+    }
+    m_spilledItemsCount += m_featureItems.size();
+    m_featureItems.clear();
+    return true;
+}
+
+/************************************************************************/
+/*                          sortFeatureItems()                          */
+/************************************************************************/
+
+// Sorts the feature items along the Hilbert curve. When items have been
+// spilled to the items temporary file, each chunk of m_maxFeatureItemsInMemory
+// items of that file is sorted in place, and forEachSortedFeatureItem() merges
+// those sorted runs.
+bool OGRFlatGeobufLayer::sortFeatureItems(const NodeItem &extent)
+{
+    try {
+        if (m_poFpItems == nullptr) {
+            HilbertSortFeatureItems(m_featureItems, extent);
+            return true;
+        }
+
+        if (!m_featureItems.empty() && !spillFeatureItems())
+            return false;
+
+        for (uint64_t start = 0; start < m_spilledItemsCount; start += m_maxFeatureItemsInMemory) {
+            const size_t count = static_cast<size_t>(std::min(
+                static_cast<uint64_t>(m_maxFeatureItemsInMemory), m_spilledItemsCount - start));
+            m_featureItems.resize(count);
+            if (VSIFSeekL(m_poFpItems, start * sizeof(FeatureItem), SEEK_SET) != 0 ||
+                VSIFReadL(m_featureItems.data(), sizeof(FeatureItem), count, m_poFpItems) != count) {
+                CPLErrorIO("reading spatial index items");
+                return false;
+            }
+            HilbertSortFeatureItems(m_featureItems, extent);
+            if (VSIFSeekL(m_poFpItems, start * sizeof(FeatureItem), SEEK_SET) != 0 ||
+                VSIFWriteL(m_featureItems.data(), sizeof(FeatureItem), count, m_poFpItems) != count) {
+                CPLErrorIO("writing spatial index items");
+                return false;
+            }
+        }
+        m_featureItems.clear();
+        m_featureItems.shrink_to_fit();
+        m_sortExtent = extent;
+    } catch (const std::bad_alloc &) {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Not enough memory to sort spatial index items. "
+                 "Try lowering OGR_FLATGEOBUF_SORT_MAX_MEMORY");
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                      forEachSortedFeatureItem()                      */
+/************************************************************************/
+
+// Calls func on each feature item, in Hilbert order, until it returns false.
+bool OGRFlatGeobufLayer::forEachSortedFeatureItem(const std::function<bool(const FeatureItem &)> &func)
+{
+    if (m_poFpItems == nullptr) {
+        for (const auto &item : m_featureItems) {
+            if (!func(item))
+                return false;
+        }
+        return true;
+    }
+
+    // K-way merge of the sorted runs, with a read buffer per run
+    struct Run
+    {
+        uint64_t next = 0; // index of the next item to read from file
+        uint64_t end = 0;
+        std::vector<FeatureItem> buffer{};
+        size_t bufferPos = 0;
+    };
+    const size_t numRuns = static_cast<size_t>(
+        (m_spilledItemsCount + m_maxFeatureItemsInMemory - 1) / m_maxFeatureItemsInMemory);
+    const size_t bufferSize = std::max(static_cast<size_t>(1024), m_maxFeatureItemsInMemory / numRuns);
+    std::vector<Run> runs(numRuns);
+
+    const auto fillBuffer = [this, bufferSize](Run &run) {
+        const size_t count = static_cast<size_t>(std::min(
+            static_cast<uint64_t>(bufferSize), run.end - run.next));
+        run.buffer.resize(count);
+        run.bufferPos = 0;
+        if (count == 0)
+            return true;
+        if (VSIFSeekL(m_poFpItems, run.next * sizeof(FeatureItem), SEEK_SET) != 0 ||
+            VSIFReadL(run.buffer.data(), sizeof(FeatureItem), count, m_poFpItems) != count) {
+            CPLErrorIO("reading spatial index items");
+            return false;
+        }
+        run.next += count;
+        return true;
+    };
+
+    typedef std::pair<std::pair<uint32_t, uint64_t>, size_t> HeapEntry; // ((key, offset), run index)
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap;
+    const auto pushHead = [this, &heap, &runs](size_t iRun) {
+        const auto &item = runs[iRun].buffer[runs[iRun].bufferPos];
+        heap.push(HeapEntry(std::make_pair(GetHilbertSortKey(item.nodeItem, m_sortExtent), item.offset), iRun));
+    };
+
+    try {
+        for (size_t i = 0; i < numRuns; i++) {
+            runs[i].next = i * static_cast<uint64_t>(m_maxFeatureItemsInMemory);
+            runs[i].end = std::min(m_spilledItemsCount, runs[i].next + m_maxFeatureItemsInMemory);
+            if (!fillBuffer(runs[i]))
+                return false;
+            pushHead(i);
+        }
+
+        while (!heap.empty()) {
+            const size_t iRun = heap.top().second;
+            heap.pop();
+            Run &run = runs[iRun];
+            if (!func(run.buffer[run.bufferPos]))
+                return false;
+            run.bufferPos++;
+            if (run.bufferPos == run.buffer.size()) {
+                if (!fillBuffer(run))
+                    return false;
+            }
+            if (run.bufferPos < run.buffer.size())
+                pushHead(iRun);
+        }
+    } catch (const std::bad_alloc &) {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Not enough memory to merge spatial index items");
+        return false;
+    }
+    return true;
+}
+
 void OGRFlatGeobufLayer::Create() {
     // no spatial index requested, we are (almost) done
     if (!m_bCreateSpatialIndexAtClose)
@@ -457,26 +704,87 @@ void OGRFlatGeobufLayer::Create() {
         return;
     }
 
-    NodeItem extent = calcExtent(m_featureItems);
+    NodeItem extent { m_sExtent.MinX, m_sExtent.MinY, m_sExtent.MaxX, m_sExtent.MaxY, 0 };
     auto extentVector = extent.toVector();
 
     writeHeader(m_poFp, m_featuresCount, &extentVector);
 
     CPLDebugOnly("FlatGeobuf", "Sorting items for Packed R-tree");
-    hilbertSort(m_featureItems);
-    CPLDebugOnly("FlatGeobuf", "Calc new feature offsets");
-    uint64_t featureOffset = 0;
-    for (auto& item : m_featureItems) {
-        auto featureItem = std::static_pointer_cast<FeatureItem>(item);
-        featureItem->nodeItem.offset = featureOffset;
-        featureOffset += featureItem->size;
-    }
+    if (!sortFeatureItems(extent))
+        return;
+
     CPLDebugOnly("FlatGeobuf", "Creating Packed R-tree");
     c = 0;
     try {
-        PackedRTree tree(m_featureItems, extent);
+        // Only the non-leaf nodes are kept in memory. The leaf nodes, which
+        // are the sorted feature items, are streamed to the output file.
+        const auto levelBounds = PackedRTree::generateLevelBounds(m_featuresCount, m_indexNodeSize);
+        const uint64_t leafStart = levelBounds.front().first;
+        std::vector<NodeItem> nonLeafNodes(static_cast<size_t>(leafStart));
+
+        uint64_t i = 0;
+        const auto parentStart = levelBounds[1].first;
+        bool ok = forEachSortedFeatureItem([this, &i, &nonLeafNodes, leafStart, parentStart](const FeatureItem &item) {
+            auto &parent = nonLeafNodes[static_cast<size_t>(parentStart + i / m_indexNodeSize)];
+            if ((i % m_indexNodeSize) == 0)
+                parent = NodeItem::create(leafStart + i);
+            parent.expand(item.nodeItem);
+            i++;
+            return true;
+        });
+        if (!ok)
+            return;
+        for (size_t level = 1; level + 1 < levelBounds.size(); level++) {
+            auto pos = levelBounds[level].first;
+            const auto end = levelBounds[level].second;
+            auto newpos = levelBounds[level + 1].first;
+            while (pos < end) {
+                NodeItem node = NodeItem::create(pos);
+                for (uint32_t j = 0; j < m_indexNodeSize && pos < end; j++)
+                    node.expand(nonLeafNodes[static_cast<size_t>(pos++)]);
+                nonLeafNodes[static_cast<size_t>(newpos++)] = node;
+            }
+        }
         CPLDebugOnly("FlatGeobuf", "PackedRTree extent %f, %f, %f, %f", extentVector[0], extentVector[1], extentVector[2], extentVector[3]);
-        tree.streamWrite([this, &c] (uint8_t *data, size_t size) { c += VSIFWriteL(data, 1, size, m_poFp); });
+
+        std::vector<NodeItem> nodeBuffer;
+        constexpr size_t NODE_BUFFER_SIZE = 4096;
+        nodeBuffer.reserve(NODE_BUFFER_SIZE);
+        const auto flushNodes = [this, &c, &nodeBuffer]() {
+#if !CPL_IS_LSB
+            for (auto &node : nodeBuffer) {
+                CPL_LSBPTR64(&node.minX);
+                CPL_LSBPTR64(&node.minY);
+                CPL_LSBPTR64(&node.maxX);
+                CPL_LSBPTR64(&node.maxY);
+                CPL_LSBPTR64(&node.offset);
+            }
+#endif
+            const size_t nBytes = nodeBuffer.size() * sizeof(NodeItem);
+            c += VSIFWriteL(nodeBuffer.data(), 1, nBytes, m_poFp);
+            nodeBuffer.clear();
+        };
+        for (const auto &node : nonLeafNodes) {
+            nodeBuffer.push_back(node);
+            if (nodeBuffer.size() == NODE_BUFFER_SIZE)
+                flushNodes();
+        }
+        flushNodes();
+        nonLeafNodes.clear();
+        nonLeafNodes.shrink_to_fit();
+
+        uint64_t featureOffset = 0;
+        ok = forEachSortedFeatureItem([&featureOffset, &nodeBuffer, &flushNodes](const FeatureItem &item) {
+            nodeBuffer.push_back(item.nodeItem);
+            nodeBuffer.back().offset = featureOffset;
+            featureOffset += item.size;
+            if (nodeBuffer.size() == NODE_BUFFER_SIZE)
+                flushNodes();
+            return true;
+        });
+        if (!ok)
+            return;
+        flushNodes();
     } catch (const std::exception& e) {
         CPLError(CE_Failure, CPLE_AppDefined, "Create: %s", e.what());
         return;
@@ -503,7 +811,8 @@ void OGRFlatGeobufLayer::Create() {
         uint32_t offsetInBuffer = 0;
         struct BatchItem
         {
-            size_t   featureIdx; // index of m_featureItems[]
+            uint64_t offset; // offset in the temporary file
+            uint32_t size;
             uint32_t offsetInBuffer;
         };
         std::vector<BatchItem> batch;
@@ -513,26 +822,21 @@ void OGRFlatGeobufLayer::Create() {
             // Sort by increasing source offset
             std::sort(
                 batch.begin(), batch.end(),
-                [this](const BatchItem& a, const BatchItem& b)
+                [](const BatchItem& a, const BatchItem& b)
                 {
-                    return std::static_pointer_cast<FeatureItem>(
-                                m_featureItems[a.featureIdx])->offset
-                           < std::static_pointer_cast<FeatureItem>(
-                                m_featureItems[b.featureIdx])->offset;
+                    return a.offset < b.offset;
                 }
             );
 
             // Read source features
             for( const auto& batchItem: batch )
             {
-                const auto item = std::static_pointer_cast<FeatureItem>(
-                    m_featureItems[batchItem.featureIdx]);
-                if (VSIFSeekL(m_poFpWrite, item->offset, SEEK_SET) == -1) {
+                if (VSIFSeekL(m_poFpWrite, batchItem.offset, SEEK_SET) == -1) {
                     CPLErrorIO("seeking to temp feature location");
                     return false;
                 }
                 if (VSIFReadL(m_featureBuf + batchItem.offsetInBuffer, 1,
-                              item->size, m_poFpWrite) != item->size) {
+                              batchItem.size, m_poFpWrite) != batchItem.size) {
                     CPLErrorIO("reading temp feature");
                     return false;
                 }
@@ -551,28 +855,29 @@ void OGRFlatGeobufLayer::Create() {
             return true;
         };
 
-        for (size_t i = 0; i < m_featuresCount; i++)
+        const bool ok = forEachSortedFeatureItem([this, &c, &batch, &offsetInBuffer, &flushBatch](const FeatureItem &item)
         {
-            const auto featureItem = std::static_pointer_cast<FeatureItem>(m_featureItems[i]);
-            const auto featureSize = featureItem->size;
+            const auto featureSize = item.size;
 
             if( offsetInBuffer + featureSize > m_featureBufSize )
             {
                 if( !flushBatch() )
                 {
-                    return;
+                    return false;
                 }
             }
 
             BatchItem bachItem;
+            bachItem.offset = item.offset;
+            bachItem.size = featureSize;
             bachItem.offsetInBuffer = offsetInBuffer;
-            bachItem.featureIdx = i;
             batch.emplace_back(bachItem);
             offsetInBuffer += featureSize;
             c += featureSize;
-        }
+            return true;
+        });
 
-        if( !flushBatch() )
+        if( !ok || !flushBatch() )
         {
             return;
         }
@@ -583,26 +888,28 @@ void OGRFlatGeobufLayer::Create() {
         if (err != OGRERR_NONE)
             return;
 
-        for (const std::shared_ptr<FlatGeobuf::Item>& item: m_featureItems) {
-            const auto featureItem = std::static_pointer_cast<FeatureItem>(item);
-            const auto featureSize = featureItem->size;
+        const bool ok = forEachSortedFeatureItem([this, &c](const FeatureItem &item) {
+            const auto featureSize = item.size;
 
             //CPLDebugOnly("FlatGeobuf", "featureItem->offset: %lu", static_cast<long unsigned int>(featureItem->offset));
             //CPLDebugOnly("FlatGeobuf", "featureSize: %d", featureSize);
-            if (VSIFSeekL(m_poFpWrite, featureItem->offset, SEEK_SET) == -1) {
+            if (VSIFSeekL(m_poFpWrite, item.offset, SEEK_SET) == -1) {
                 CPLErrorIO("seeking to temp feature location");
-                return;
+                return false;
             }
             if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFpWrite) != featureSize) {
                 CPLErrorIO("reading temp feature");
-                return;
+                return false;
             }
             if( VSIFWriteL(m_featureBuf, 1, featureSize, m_poFp) != featureSize ) {
                 CPLErrorIO("writing feature");
-                return;
+                return false;
             }
             c += featureSize;
-        }
+            return true;
+        });
+        if (!ok)
+            return;
     }
 
     CPLDebugOnly("FlatGeobuf", "Wrote feature buffers (%lu bytes)", static_cast<long unsigned int>(c));
@@ -616,6 +923,9 @@ OGRFlatGeobufLayer::~OGRFlatGeobufLayer()
     if (m_create)
         Create();
 
+    if (m_psVirtualMem)
+        CPLVirtualMemFree(m_psVirtualMem);
+
     if (m_poFp)
         VSIFCloseL(m_poFp);
 
@@ -625,6 +935,12 @@ OGRFlatGeobufLayer::~OGRFlatGeobufLayer()
     if (!m_osTempFile.empty())
         VSIUnlink(m_osTempFile.c_str());
 
+    if (m_poFpItems)
+        VSIFCloseL(m_poFpItems);
+
+    if (!m_osItemsTempFile.empty())
+        VSIUnlink(m_osItemsTempFile.c_str());
+
     if (m_poFeatureDefn)
         m_poFeatureDefn->Release();
 
@@ -646,10 +962,16 @@ OGRErr OGRFlatGeobufLayer::readFeatureOffset(uint64_t index, uint64_t &featureOf
         const auto bottomLevelOffset = m_offset - treeSize + (levelBounds.front().first * sizeof(NodeItem));
         const auto nodeItemOffset = bottomLevelOffset + (index * sizeof(NodeItem));
         const auto featureOffsetOffset = nodeItemOffset + (sizeof(double) * 4);
-        if (VSIFSeekL(m_poFp, featureOffsetOffset, SEEK_SET) == -1)
-            return CPLErrorIO("seeking feature offset");
-        if (VSIFReadL(&featureOffset, sizeof(uint64_t), 1, m_poFp) != 1)
-            return CPLErrorIO("reading feature offset");
+        if (mapFile()) {
+            if (featureOffsetOffset + sizeof(uint64_t) > m_nMappedSize)
+                return CPLErrorIO("reading feature offset");
+            memcpy(&featureOffset, m_pabyMapped + featureOffsetOffset, sizeof(uint64_t));
+        } else {
+            if (VSIFSeekL(m_poFp, featureOffsetOffset, SEEK_SET) == -1)
+                return CPLErrorIO("seeking feature offset");
+            if (VSIFReadL(&featureOffset, sizeof(uint64_t), 1, m_poFp) != 1)
+                return CPLErrorIO("reading feature offset");
+        }
         #if !CPL_IS_LSB
             CPL_LSBPTR64(&featureOffset);
         #endif
@@ -705,11 +1027,17 @@ OGRErr OGRFlatGeobufLayer::readIndex()
     if (featuresCount == 0)
         return OGRERR_NONE;
 
-    if (VSIFSeekL(m_poFp, sizeof(magicbytes), SEEK_SET) == -1) // skip magic bytes
-        return CPLErrorIO("seeking past magic bytes");
     uoffset_t headerSize;
-    if (VSIFReadL(&headerSize, sizeof(uoffset_t), 1, m_poFp) != 1)
-        return CPLErrorIO("reading header size");
+    if (mapFile()) {
+        if (sizeof(magicbytes) + sizeof(uoffset_t) > m_nMappedSize)
+            return CPLErrorIO("reading header size");
+        memcpy(&headerSize, m_pabyMapped + sizeof(magicbytes), sizeof(uoffset_t));
+    } else {
+        if (VSIFSeekL(m_poFp, sizeof(magicbytes), SEEK_SET) == -1) // skip magic bytes
+            return CPLErrorIO("seeking past magic bytes");
+        if (VSIFReadL(&headerSize, sizeof(uoffset_t), 1, m_poFp) != 1)
+            return CPLErrorIO("reading header size");
+    }
     CPL_LSBPTR32(&headerSize);
 
     try {
@@ -722,6 +1050,12 @@ OGRErr OGRFlatGeobufLayer::readIndex()
             CPLDebugOnly("FlatGeobuf", "Spatial index search on %f,%f,%f,%f", env.MinX, env.MinY, env.MaxX, env.MaxY);
             const auto treeOffset = sizeof(magicbytes) + sizeof(uoffset_t) + headerSize;
             const auto readNode = [this, treeOffset] (uint8_t *buf, size_t i, size_t s) {
+                if (m_pabyMapped) {
+                    if (treeOffset + i + s > m_nMappedSize)
+                        throw std::runtime_error("I/O read file");
+                    memcpy(buf, m_pabyMapped + treeOffset + i, s);
+                    return;
+                }
                 if (VSIFSeekL(m_poFp, treeOffset + i, SEEK_SET) == -1)
                     throw std::runtime_error("I/O seek failure");
                 if (VSIFReadL(buf, 1, s, m_poFp) != s)
@@ -785,7 +1119,7 @@ OGRFeature *OGRFlatGeobufLayer::GetNextFeature()
             return nullptr;
         }
 
-        if (VSIFEofL(m_poFp)) {
+        if (m_bReadEOF) {
             CPLDebug("FlatGeobuf", "GetNextFeature: iteration end due to EOF");
             return nullptr;
         }
@@ -819,80 +1153,173 @@ OGRErr OGRFlatGeobufLayer::ensureFeatureBuf(uint32_t featureSize) {
     return OGRERR_NONE;
 }
 
-OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature) {
-    GIntBig fid;
-    auto seek = false;
-    if (m_queriedSpatialIndex && !m_ignoreSpatialFilter) {
-        const auto item = m_foundItems[m_featuresPos];
-        m_offset = m_offsetFeatures + item.offset;
-        fid = item.index;
-        seek = true;
-    } else {
-        fid = m_featuresPos;
-    }
-    poFeature->SetFID(fid);
-
+/************************************************************************/
+/*                              mapFile()                               */
+/************************************************************************/
 
-    //CPLDebugOnly("FlatGeobuf", "m_featuresPos: %lu", static_cast<long unsigned int>(m_featuresPos));
+// Maps the whole file in memory when it is a /vsimem/ or local file, so that
+// features and index nodes are accessed in place rather than through
+// VSIFReadL() and a copy to m_featureBuf.
+bool OGRFlatGeobufLayer::mapFile()
+{
+    if (m_bMappingTried)
+        return m_pabyMapped != nullptr;
+    m_bMappingTried = true;
 
-    if (m_featuresPos == 0)
-        seek = true;
+    if (m_create || m_poFp == nullptr ||
+        !CPLTestBool(CPLGetConfigOption("OGR_FLATGEOBUF_USE_MMAP", "YES")))
+        return false;
 
-    if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1) {
-        if (VSIFEofL(m_poFp))
-            return OGRERR_NONE;
-        return CPLErrorIO("seeking to feature location");
+    if (STARTS_WITH(m_osFilename.c_str(), "/vsimem/")) {
+        vsi_l_offset nDataLength = 0;
+        m_pabyMapped = VSIGetMemFileBuffer(m_osFilename.c_str(), &nDataLength, FALSE);
+        m_nMappedSize = nDataLength;
+    } else {
+        if (!CPLIsVirtualMemFileMapAvailable() ||
+            VSIFGetNativeFileDescriptorL(m_poFp) == nullptr ||
+            VSIFSeekL(m_poFp, 0, SEEK_END) != 0)
+            return false;
+        const vsi_l_offset nLength = VSIFTellL(m_poFp);
+        if (nLength == 0 || static_cast<size_t>(nLength) != nLength)
+            return false;
+        m_psVirtualMem = CPLVirtualMemFileMapNew(
+            m_poFp, 0, nLength, VIRTUALMEM_READONLY, nullptr, nullptr);
+        if (m_psVirtualMem == nullptr)
+            return false;
+        m_pabyMapped = static_cast<const GByte *>(CPLVirtualMemGetAddr(m_psVirtualMem));
+        m_nMappedSize = nLength;
     }
-    uint32_t featureSize;
-    if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1) {
-        if (VSIFEofL(m_poFp))
-            return OGRERR_NONE;
-        return CPLErrorIO("reading feature size");
+    if (m_pabyMapped) {
+        CPLDebugOnly("FlatGeobuf", "Using memory mapping of %s", m_osFilename.c_str());
     }
-    CPL_LSBPTR32(&featureSize);
+    return m_pabyMapped != nullptr;
+}
 
-    // Sanity check to avoid allocated huge amount of memory on corrupted
-    // feature
-    if (featureSize > 100 * 1024 * 1024 )
-    {
+/************************************************************************/
+/*                          readFeatureData()                           */
+/************************************************************************/
+
+// Sets pabyFeature to the content of the feature at m_offset, and advances
+// m_offset to the next feature. pabyFeature points either to the memory
+// mapping of the file, or to m_featureBuf. It is left to nullptr, and
+// m_bReadEOF is set, when the end of file is reached.
+OGRErr OGRFlatGeobufLayer::readFeatureData(bool seek, const GByte *&pabyFeature,
+                                           uint32_t &featureSize) {
+    pabyFeature = nullptr;
+    featureSize = 0;
+
+    if (mapFile()) {
+        if (m_offset + sizeof(featureSize) > m_nMappedSize) {
+            m_bReadEOF = true;
+            return OGRERR_NONE;
+        }
+        memcpy(&featureSize, m_pabyMapped + m_offset, sizeof(featureSize));
+        CPL_LSBPTR32(&featureSize);
         if (featureSize > feature_max_buffer_size)
             return CPLErrorInvalidSize("feature");
+        if (m_offset + sizeof(featureSize) + featureSize > m_nMappedSize)
+            return CPLErrorIO("reading feature");
+        pabyFeature = m_pabyMapped + m_offset + sizeof(featureSize);
+#ifdef CPL_CPU_REQUIRES_ALIGNED_ACCESS
+        // Flatbuffers accessors dereference scalars in place
+        if ((reinterpret_cast<uintptr_t>(pabyFeature) % sizeof(double)) != 0) {
+            const auto err = ensureFeatureBuf(featureSize);
+            if (err != OGRERR_NONE)
+                return err;
+            memcpy(m_featureBuf, pabyFeature, featureSize);
+            pabyFeature = m_featureBuf;
+        }
+#endif
+    } else {
+        if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1) {
+            if (VSIFEofL(m_poFp)) {
+                m_bReadEOF = true;
+                return OGRERR_NONE;
+            }
+            return CPLErrorIO("seeking to feature location");
+        }
+        if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1) {
+            if (VSIFEofL(m_poFp)) {
+                m_bReadEOF = true;
+                return OGRERR_NONE;
+            }
+            return CPLErrorIO("reading feature size");
+        }
+        CPL_LSBPTR32(&featureSize);
 
-        if( m_nFileSize == 0 )
+        // Sanity check to avoid allocated huge amount of memory on corrupted
+        // feature
+        if (featureSize > 100 * 1024 * 1024 )
         {
-            VSIStatBufL sStatBuf;
-            if( VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0 )
+            if (featureSize > feature_max_buffer_size)
+                return CPLErrorInvalidSize("feature");
+
+            if( m_nFileSize == 0 )
             {
-                m_nFileSize = sStatBuf.st_size;
+                VSIStatBufL sStatBuf;
+                if( VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0 )
+                {
+                    m_nFileSize = sStatBuf.st_size;
+                }
+            }
+            if( m_offset + featureSize > m_nFileSize )
+            {
+                return CPLErrorIO("reading feature size");
             }
         }
-        if( m_offset + featureSize > m_nFileSize )
-        {
-            return CPLErrorIO("reading feature size");
-        }
-    }
 
-    const auto err = ensureFeatureBuf(featureSize);
-    if (err != OGRERR_NONE)
-        return err;
-    if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
-        return CPLErrorIO("reading feature");
+        const auto err = ensureFeatureBuf(featureSize);
+        if (err != OGRERR_NONE)
+            return err;
+        if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
+            return CPLErrorIO("reading feature");
+        pabyFeature = m_featureBuf;
+    }
     m_offset += featureSize + sizeof(featureSize);
 
     if (m_bVerifyBuffers) {
-        const auto vBuf = const_cast<const uint8_t *>(reinterpret_cast<uint8_t *>(m_featureBuf));
-        Verifier v(vBuf, featureSize);
+        Verifier v(pabyFeature, featureSize);
         const auto ok = VerifyFeatureBuffer(v);
         if (!ok) {
             CPLError(CE_Failure, CPLE_AppDefined, "Buffer verification failed");
             CPLDebugOnly("FlatGeobuf", "m_offset: %lu", static_cast<long unsigned int>(m_offset));
             CPLDebugOnly("FlatGeobuf", "m_featuresPos: %lu", static_cast<long unsigned int>(m_featuresPos));
             CPLDebugOnly("FlatGeobuf", "featureSize: %d", featureSize);
+            pabyFeature = nullptr;
             return OGRERR_CORRUPT_DATA;
         }
     }
+    return OGRERR_NONE;
+}
+
+OGRErr OGRFlatGeobufLayer::parseFeature(OGRFeature *poFeature) {
+    GIntBig fid;
+    auto seek = false;
+    if (m_queriedSpatialIndex && !m_ignoreSpatialFilter) {
+        const auto item = m_foundItems[m_featuresPos];
+        m_offset = m_offsetFeatures + item.offset;
+        fid = item.index;
+        seek = true;
+    } else {
+        fid = m_featuresPos;
+    }
+    poFeature->SetFID(fid);
+
+
+    //CPLDebugOnly("FlatGeobuf", "m_featuresPos: %lu", static_cast<long unsigned int>(m_featuresPos));
+
+    if (m_featuresPos == 0)
+        seek = true;
+
+    const GByte *pabyFeature = nullptr;
+    uint32_t featureSize = 0;
+    const auto err = readFeatureData(seek, pabyFeature, featureSize);
+    if (err != OGRERR_NONE)
+        return err;
+    if (pabyFeature == nullptr)
+        return OGRERR_NONE;
 
-    const auto feature = GetRoot<Feature>(m_featureBuf);
+    const auto feature = GetRoot<Feature>(pabyFeature);
     const auto geometry = feature->geometry();
     if (!m_poFeatureDefn->IsGeometryIgnored() && geometry != nullptr) {
         auto geometryType = m_geometryType;
@@ -1170,7 +1597,7 @@ int OGRFlatGeobufLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
                                            struct ArrowArray* out_array)
 {
     if( m_poAttrQuery != nullptr ||
-        (m_poFilterGeom != nullptr && !(m_poHeader != nullptr && m_poHeader->index_node_size() > 0)) ||
+        (m_poFilterGeom != nullptr && m_poFeatureDefn->IsGeometryIgnored()) ||
         CPLTestBool(CPLGetConfigOption("OGR_FLATGEOBUF_STREAM_BASE_IMPL", "NO")) )
     {
         return OGRLayer::GetNextArrowArray(stream, out_array);
@@ -1236,68 +1663,16 @@ int OGRFlatGeobufLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
         if (m_featuresPos == 0)
             seek = true;
 
-        if (seek && VSIFSeekL(m_poFp, m_offset, SEEK_SET) == -1) {
-            break;
-        }
-        uint32_t featureSize;
-        if (VSIFReadL(&featureSize, sizeof(featureSize), 1, m_poFp) != 1) {
-            if (VSIFEofL(m_poFp))
-                break;
-            CPLErrorIO("reading feature size");
-            goto error;
-        }
-        CPL_LSBPTR32(&featureSize);
-
-        // Sanity check to avoid allocated huge amount of memory on corrupted
-        // feature
-        if (featureSize > 100 * 1024 * 1024 )
-        {
-            if (featureSize > feature_max_buffer_size)
-            {
-                CPLErrorInvalidSize("feature");
-                goto error;
-            }
-
-            if( m_nFileSize == 0 )
-            {
-                VSIStatBufL sStatBuf;
-                if( VSIStatL(m_osFilename.c_str(), &sStatBuf) == 0 )
-                {
-                    m_nFileSize = sStatBuf.st_size;
-                }
-            }
-            if( m_offset + featureSize > m_nFileSize )
-            {
-                CPLErrorIO("reading feature size");
-                goto error;
-            }
-        }
-
-        const auto err = ensureFeatureBuf(featureSize);
-        if (err != OGRERR_NONE)
-            goto error;
-        if (VSIFReadL(m_featureBuf, 1, featureSize, m_poFp) != featureSize)
-        {
-            CPLErrorIO("reading feature");
+        const GByte *pabyFeature = nullptr;
+        uint32_t featureSize = 0;
+        if (readFeatureData(seek, pabyFeature, featureSize) != OGRERR_NONE)
             goto error;
-        }
-        m_offset += featureSize + sizeof(featureSize);
-
-        if (m_bVerifyBuffers) {
-            const auto vBuf = const_cast<const uint8_t *>(reinterpret_cast<uint8_t *>(m_featureBuf));
-            Verifier v(vBuf, featureSize);
-            const auto ok = VerifyFeatureBuffer(v);
-            if (!ok) {
-                CPLError(CE_Failure, CPLE_AppDefined, "Buffer verification failed");
-                CPLDebugOnly("FlatGeobuf", "m_offset: %lu", static_cast<long unsigned int>(m_offset));
-                CPLDebugOnly("FlatGeobuf", "m_featuresPos: %lu", static_cast<long unsigned int>(m_featuresPos));
-                CPLDebugOnly("FlatGeobuf", "featureSize: %d", featureSize);
-                goto error;
-            }
-        }
+        if (pabyFeature == nullptr)
+            break;
 
-        const auto feature = GetRoot<Feature>(m_featureBuf);
+        const auto feature = GetRoot<Feature>(pabyFeature);
         const auto geometry = feature->geometry();
+        const bool bEvaluateSpatialFilter = m_poFilterGeom != nullptr && !m_ignoreSpatialFilter;
         if (!m_poFeatureDefn->IsGeometryIgnored() && geometry != nullptr) {
             auto geometryType = m_geometryType;
             if (geometryType == GeometryType::Unknown)
@@ -1317,6 +1692,22 @@ int OGRFlatGeobufLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
                 goto error;
             }
             poOGRGeometry->exportToWkb(wkbNDR, outPtr, wkbVariantIso);
+
+            // The spatial index only filters on the bounding box. Refine
+            // with the exported WKB, which avoids GEOS for rectangular
+            // filters.
+            OGREnvelope sEnvelope;
+            if (bEvaluateSpatialFilter && !FilterWKBGeometry(outPtr, nWKBSize, false, sEnvelope)) {
+                // Reuse the current slot for the next feature
+                m_featuresPos++;
+                iFeat--;
+                continue;
+            }
+        }
+        else if (bEvaluateSpatialFilter) {
+            m_featuresPos++;
+            iFeat--;
+            continue;
         }
 
         abSetFields.clear();
@@ -1622,7 +2013,7 @@ int OGRFlatGeobufLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
             }
         }
 
-        if (VSIFEofL(m_poFp)) {
+        if (m_bReadEOF) {
             CPLDebug("FlatGeobuf", "GetNextFeature: iteration end due to EOF");
             break;
         }
@@ -1634,6 +2025,13 @@ int OGRFlatGeobufLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
     if( bEOFOrError && m_featuresCount > 0 )
         m_bEOF = true;
 
+    if( iFeat == 0 )
+    {
+        // All remaining features have been discarded by the spatial filter:
+        // signal end of stream rather than returning an empty batch.
+        sHelper.ClearArray();
+        return 0;
+    }
     sHelper.Shrink(iFeat);
     return 0;
 
@@ -1876,24 +2274,33 @@ OGRErr OGRFlatGeobufLayer::ICreateFeature(OGRFeature *poNewFeature)
         if (c == 0)
             return CPLErrorIO("writing feature");
         if (m_bCreateSpatialIndexAtClose) {
-            const auto item = std::make_shared<FeatureItem>();
-#if defined(__MINGW32__) && __GNUC__ >= 7
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wnull-dereference"
-#endif
-            item->size = static_cast<uint32_t>(fbb.GetSize());
-            item->offset = m_writeOffset;
-            item->nodeItem = {
+            if (m_maxFeatureItemsInMemory == 0) {
+                // Memory budget for the items used to create the spatial
+                // index, which are sorted by runs when it is exceeded.
+                // Sorting requires about twice the size of the items,
+                // plus their sort keys.
+                const char *pszMaxMemory = CPLGetConfigOption("OGR_FLATGEOBUF_SORT_MAX_MEMORY", nullptr);
+                const GIntBig nMaxMemory = pszMaxMemory ?
+                    CPLAtoGIntBig(pszMaxMemory) : CPLGetUsablePhysicalRAM() / 4;
+                const GIntBig nBytesPerItem = 2 * sizeof(FeatureItem) + sizeof(std::pair<uint32_t, size_t>);
+                m_maxFeatureItemsInMemory = static_cast<size_t>(std::max(
+                    static_cast<GIntBig>(1),
+                    std::min(static_cast<GIntBig>(std::numeric_limits<size_t>::max() / nBytesPerItem),
+                             nMaxMemory / nBytesPerItem)));
+            }
+            FeatureItem item;
+            item.size = static_cast<uint32_t>(fbb.GetSize());
+            item.offset = m_writeOffset;
+            item.nodeItem = {
                 psEnvelope.MinX,
                 psEnvelope.MinY,
                 psEnvelope.MaxX,
                 psEnvelope.MaxY,
                 0
             };
-#if defined(__MINGW32__) && __GNUC__ >= 7
-#pragma GCC diagnostic pop
-#endif
             m_featureItems.push_back(item);
+            if (m_featureItems.size() == m_maxFeatureItemsInMemory && !spillFeatureItems())
+                return OGRERR_FAILURE;
         }
         m_writeOffset += c;
 
@@ -1954,6 +2361,7 @@ void OGRFlatGeobufLayer::ResetReading()
     CPLDebugOnly("FlatGeobuf", "ResetReading");
     m_offset = m_offsetFeatures;
     m_bEOF = false;
+    m_bReadEOF = false;
     m_featuresPos = 0;
     m_foundItems.clear();
     m_featuresCount = m_poHeader ? m_poHeader->features_count() : 0;
@@ -91,7 +91,7 @@ public:
     inline static void SetBoolOn(struct ArrowArray* psArray, int iFeat)
     {
         static_cast<uint8_t*>(const_cast<void*>(
-            psArray->buffers[1]))[iFeat / 8] |= static_cast<uint8_t>(1 << (iFeat / 8));
+            psArray->buffers[1]))[iFeat / 8] |= static_cast<uint8_t>(1 << (iFeat % 8));
     }
 
     inline static void SetInt8(struct ArrowArray* psArray, int iFeat, int8_t nVal)
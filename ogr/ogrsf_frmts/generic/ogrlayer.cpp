@@ -35,10 +35,18 @@
 #include "ograpispy.h"
 #include "ogr_recordbatch.h"
 #include "ograrrowarrayhelper.h"
+#include "ogr_wkb.h"
+#include "cpl_quad_tree.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #include "cpl_time.h"
 #include <cassert>
+#include <algorithm>
+#include <climits>
 #include <limits>
+#include <memory>
+#include <vector>
 
 
 struct OGRLayer::Private
@@ -1544,6 +1552,69 @@ int OGRLayer::FilterGeometry( OGRGeometry *poGeometry )
             return TRUE;
     }
 }
+
+/************************************************************************/
+/*                         FilterWKBGeometry()                          */
+/************************************************************************/
+
+/** Same as FilterGeometry(), but on a WKB geometry.
+ *
+ * When the spatial filter is a rectangle and the geometry has no circular
+ * arcs, the test is done directly on the WKB buffer, without instantiating
+ * a OGRGeometry.
+ *
+ * @param pabyWKB WKB geometry.
+ * @param nWKBSize size of pabyWKB in bytes.
+ * @param bEnvelopeAlreadySet whether sEnvelope is already set with the
+ *                            envelope of the geometry (for example from a
+ *                            GeoPackage geometry header).
+ * @param sEnvelope envelope of the geometry. Computed by the method if
+ *                  bEnvelopeAlreadySet is false.
+ */
+bool OGRLayer::FilterWKBGeometry( const GByte* pabyWKB, size_t nWKBSize,
+                                  bool bEnvelopeAlreadySet,
+                                  OGREnvelope& sEnvelope )
+{
+    if( m_poFilterGeom == nullptr )
+        return true;
+
+    OGRWKBGeometryView oView(pabyWKB, nWKBSize);
+    if( !oView.IsValid() )
+        return false;
+
+    if( bEnvelopeAlreadySet || oView.GetEnvelope(sEnvelope) )
+    {
+        if( !sEnvelope.IsInit() || !m_sFilterEnvelope.Intersects(sEnvelope) )
+            return false;
+
+        if( m_bFilterIsEnvelope )
+        {
+            if( sEnvelope.MinX >= m_sFilterEnvelope.MinX &&
+                sEnvelope.MinY >= m_sFilterEnvelope.MinY &&
+                sEnvelope.MaxX <= m_sFilterEnvelope.MaxX &&
+                sEnvelope.MaxY <= m_sFilterEnvelope.MaxY )
+            {
+                return true;
+            }
+            if( !oView.HasCurve() )
+                return oView.IntersectsEnvelope(m_sFilterEnvelope);
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Fallback to the OGRGeometry based test.                         */
+/* -------------------------------------------------------------------- */
+    OGRGeometry* poGeom = nullptr;
+    if( OGRGeometryFactory::createFromWkb(pabyWKB, nullptr, &poGeom,
+                                          nWKBSize) != OGRERR_NONE )
+    {
+        delete poGeom;
+        return false;
+    }
+    const bool bRet = CPL_TO_BOOL(FilterGeometry(poGeom));
+    delete poGeom;
+    return bRet;
+}
 //! @endcond
 
 /************************************************************************/
@@ -2129,6 +2200,494 @@ static OGRGeometry* promote_to_multi(OGRGeometry* poGeom)
         return poGeom;
 }
 
+/************************************************************************/
+/*                      OGRLayerOverlayIndex                            */
+/************************************************************************/
+
+// In-memory spatial index over the features of one of the layers of an
+// overlay operation. This avoids re-reading that layer with a new spatial
+// filter for each feature of the other layer. The index is read-only once
+// built, so it may be queried concurrently from several threads.
+
+namespace {
+
+class OGRLayerOverlayIndex
+{
+    struct Entry
+    {
+        OGRFeatureUniquePtr poFeature{};
+        CPLRectObj sBounds{0, 0, 0, 0};
+    };
+
+    std::vector<Entry> m_aoEntries{};
+    CPLQuadTree* m_hTree = nullptr;
+    bool m_bUsePreparedGeometries = false;
+
+    OGRLayerOverlayIndex(const OGRLayerOverlayIndex&) = delete;
+    OGRLayerOverlayIndex& operator=(const OGRLayerOverlayIndex&) = delete;
+
+  public:
+    explicit OGRLayerOverlayIndex(bool bUsePreparedGeometries):
+        m_bUsePreparedGeometries(bUsePreparedGeometries) {}
+    ~OGRLayerOverlayIndex();
+
+    void Build(OGRLayer* poLayer);
+    void Select(const OGRGeometry* poFilter,
+                std::vector<OGRFeature*>& apoSelected) const;
+};
+
+OGRLayerOverlayIndex::~OGRLayerOverlayIndex()
+{
+    if( m_hTree )
+        CPLQuadTreeDestroy(m_hTree);
+}
+
+/************************************************************************/
+/*                               Build()                                */
+/************************************************************************/
+
+// Load the features of poLayer that have a non-empty geometry, honouring
+// its current spatial and attribute filters.
+void OGRLayerOverlayIndex::Build(OGRLayer* poLayer)
+{
+    CPLRectObj sGlobalBounds;
+    sGlobalBounds.minx = std::numeric_limits<double>::max();
+    sGlobalBounds.miny = std::numeric_limits<double>::max();
+    sGlobalBounds.maxx = -std::numeric_limits<double>::max();
+    sGlobalBounds.maxy = -std::numeric_limits<double>::max();
+
+    for( auto&& poFeature: poLayer )
+    {
+        const OGRGeometry* poGeom = poFeature->GetGeometryRef();
+        if( poGeom == nullptr || poGeom->IsEmpty() )
+            continue;
+        OGREnvelope sEnvelope;
+        poGeom->getEnvelope(&sEnvelope);
+        Entry oEntry;
+        oEntry.sBounds.minx = sEnvelope.MinX;
+        oEntry.sBounds.miny = sEnvelope.MinY;
+        oEntry.sBounds.maxx = sEnvelope.MaxX;
+        oEntry.sBounds.maxy = sEnvelope.MaxY;
+        oEntry.poFeature = std::move(poFeature);
+        sGlobalBounds.minx = std::min(sGlobalBounds.minx, sEnvelope.MinX);
+        sGlobalBounds.miny = std::min(sGlobalBounds.miny, sEnvelope.MinY);
+        sGlobalBounds.maxx = std::max(sGlobalBounds.maxx, sEnvelope.MaxX);
+        sGlobalBounds.maxy = std::max(sGlobalBounds.maxy, sEnvelope.MaxY);
+        m_aoEntries.emplace_back(std::move(oEntry));
+    }
+    if( m_aoEntries.empty() )
+        return;
+
+    m_hTree = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+    CPLQuadTreeSetMaxDepth(m_hTree,
+        CPLQuadTreeGetAdvisedMaxDepth(static_cast<int>(
+            std::min<size_t>(m_aoEntries.size(), INT_MAX))));
+    for( auto& oEntry: m_aoEntries )
+        CPLQuadTreeInsertWithBounds(m_hTree, &oEntry, &oEntry.sBounds);
+}
+
+/************************************************************************/
+/*                               Select()                               */
+/************************************************************************/
+
+// Return, in layer order, the features whose geometry intersects poFilter,
+// which is what iterating over the layer with poFilter installed as its
+// spatial filter would have returned.
+void OGRLayerOverlayIndex::Select(const OGRGeometry* poFilter,
+                                  std::vector<OGRFeature*>& apoSelected) const
+{
+    apoSelected.clear();
+    if( m_hTree == nullptr || poFilter == nullptr || poFilter->IsEmpty() )
+        return;
+
+    OGREnvelope sEnvelope;
+    poFilter->getEnvelope(&sEnvelope);
+    CPLRectObj sAoi;
+    sAoi.minx = sEnvelope.MinX;
+    sAoi.miny = sEnvelope.MinY;
+    sAoi.maxx = sEnvelope.MaxX;
+    sAoi.maxy = sEnvelope.MaxY;
+    int nCount = 0;
+    void** papEntries = CPLQuadTreeSearch(m_hTree, &sAoi, &nCount);
+    if( nCount == 0 )
+    {
+        CPLFree(papEntries);
+        return;
+    }
+
+    // Entries are stored contiguously, so address order is layer order.
+    std::sort(papEntries, papEntries + nCount);
+
+    OGRPreparedGeometryUniquePtr poPreparedFilter;
+    if( m_bUsePreparedGeometries && nCount > 1 )
+        poPreparedFilter.reset(OGRCreatePreparedGeometry(
+            OGRGeometry::ToHandle(const_cast<OGRGeometry*>(poFilter))));
+
+    for( int i = 0; i < nCount; i++ )
+    {
+        const Entry* psEntry = static_cast<const Entry*>(papEntries[i]);
+        OGRGeometry* poGeom = psEntry->poFeature->GetGeometryRef();
+        const bool bIntersects = poPreparedFilter ?
+            CPL_TO_BOOL(OGRPreparedGeometryIntersects(
+                poPreparedFilter.get(), OGRGeometry::ToHandle(poGeom))) :
+            CPL_TO_BOOL(poFilter->Intersects(poGeom));
+        if( bIntersects )
+            apoSelected.push_back(psEntry->poFeature.get());
+    }
+    CPLFree(papEntries);
+}
+
+/************************************************************************/
+/*                    OGRLayerOverlayCandidates                         */
+/************************************************************************/
+
+// Iterates over the features of a layer that may interact with the geometry
+// of a feature of the other layer of an overlay operation. They are taken
+// from an OGRLayerOverlayIndex when one is available, or otherwise read from
+// the layer itself after installing a spatial filter on it.
+
+class OGRLayerOverlayCandidates
+{
+    OGRLayer* m_poLayer = nullptr;
+    const OGRLayerOverlayIndex* m_poIndex = nullptr;
+    std::vector<OGRFeature*> m_apoSelected{};
+    size_t m_iNext = 0;
+    OGRFeatureUniquePtr m_poCurrent{};
+
+    OGRLayerOverlayCandidates(const OGRLayerOverlayCandidates&) = delete;
+    OGRLayerOverlayCandidates& operator=(const OGRLayerOverlayCandidates&) = delete;
+
+  public:
+    OGRLayerOverlayCandidates(OGRLayer* poLayer,
+                              const OGRLayerOverlayIndex* poIndex):
+        m_poLayer(poLayer), m_poIndex(poIndex) {}
+
+    void SetIndex(const OGRLayerOverlayIndex* poIndex) { m_poIndex = poIndex; }
+    OGRGeometry* SetFilterFrom(OGRGeometry* pGeometryExistingFilter,
+                               OGRFeature* pFeature);
+    OGRFeature* GetNext();
+};
+
+/************************************************************************/
+/*                           SetFilterFrom()                            */
+/************************************************************************/
+
+// Same semantics as set_filter_from().
+OGRGeometry* OGRLayerOverlayCandidates::SetFilterFrom(
+    OGRGeometry *pGeometryExistingFilter, OGRFeature *pFeature)
+{
+    m_apoSelected.clear();
+    m_iNext = 0;
+    m_poCurrent.reset();
+    if( m_poIndex == nullptr )
+    {
+        OGRGeometry* geom = set_filter_from(m_poLayer, pGeometryExistingFilter, pFeature);
+        if( geom )
+            m_poLayer->ResetReading();
+        return geom;
+    }
+
+    OGRGeometry *geom = pFeature->GetGeometryRef();
+    if (!geom) return nullptr;
+    if (pGeometryExistingFilter) {
+        if (!geom->Intersects(pGeometryExistingFilter)) return nullptr;
+        OGRGeometryUniquePtr intersection(geom->Intersection(pGeometryExistingFilter));
+        if (!intersection) return nullptr;
+        m_poIndex->Select(intersection.get(), m_apoSelected);
+    } else {
+        m_poIndex->Select(geom, m_apoSelected);
+    }
+    return geom;
+}
+
+/************************************************************************/
+/*                              GetNext()                               */
+/************************************************************************/
+
+OGRFeature* OGRLayerOverlayCandidates::GetNext()
+{
+    if( m_poIndex == nullptr )
+    {
+        m_poCurrent.reset(m_poLayer->GetNextFeature());
+        return m_poCurrent.get();
+    }
+    if( m_iNext == m_apoSelected.size() )
+        return nullptr;
+    return m_apoSelected[m_iNext++];
+}
+
+} // namespace
+
+/************************************************************************/
+/*                      OGRLayerOverlayContext                          */
+/************************************************************************/
+
+// State shared by the overlay methods that process each feature of the
+// input layer independently (Intersection, Clip and Erase), so that they can
+// be run on several threads.
+
+namespace {
+
+struct OGRLayerOverlayContext
+{
+    OGRLayer* pLayerMethod = nullptr;
+    const OGRLayerOverlayIndex* poIndex = nullptr;
+    OGRGeometry* pGeometryMethodFilter = nullptr;
+    OGRFeatureDefn* poDefnResult = nullptr;
+    const int* mapInput = nullptr;
+    const int* mapMethod = nullptr;
+    bool bSkipFailures = false;
+    bool bPromoteToMulti = false;
+    bool bUsePreparedGeometries = false;
+    bool bPretestContainment = false;
+    bool bKeepLowerDimGeom = false;
+    bool bEnvelopeSet = false;
+    OGREnvelope sEnvelopeMethod{};
+};
+
+// Computes the result features for one feature of the input layer.
+// Returns OGRERR_FAILURE if processing must stop.
+typedef OGRErr (*OGRLayerOverlayFeatureFunc)(
+    const OGRLayerOverlayContext& ctxt,
+    OGRLayerOverlayCandidates& oCandidates,
+    OGRFeature* x,
+    std::vector<OGRFeatureUniquePtr>& apoResults);
+
+struct OGRLayerOverlayJob
+{
+    const OGRLayerOverlayContext* pCtxt = nullptr;
+    OGRLayerOverlayFeatureFunc pfnFunc = nullptr;
+    OGRFeatureUniquePtr x{};
+    std::vector<OGRFeatureUniquePtr> apoResults{};
+    OGRErr eErr = OGRERR_NONE;
+};
+
+} // namespace
+
+static void OGRLayerOverlayJobFunc(void* pData)
+{
+    OGRLayerOverlayJob* psJob = static_cast<OGRLayerOverlayJob*>(pData);
+    OGRLayerOverlayCandidates oCandidates(psJob->pCtxt->pLayerMethod,
+                                          psJob->pCtxt->poIndex);
+    psJob->eErr = psJob->pfnFunc(*(psJob->pCtxt), oCandidates,
+                                 psJob->x.get(), psJob->apoResults);
+}
+
+/************************************************************************/
+/*                         build_overlay_index()                        */
+/************************************************************************/
+
+static std::unique_ptr<OGRLayerOverlayIndex>
+build_overlay_index(OGRLayer* pLayer, const char* const* papszOptions,
+                    bool bUsePreparedGeometries)
+{
+    std::unique_ptr<OGRLayerOverlayIndex> poIndex;
+    if( CPLTestBool(CSLFetchNameValueDef(papszOptions, "USE_SPATIAL_INDEX", "NO")) )
+    {
+        poIndex.reset(new OGRLayerOverlayIndex(bUsePreparedGeometries));
+        poIndex->Build(pLayer);
+    }
+    return poIndex;
+}
+
+/************************************************************************/
+/*                        run_overlay_per_feature()                     */
+/************************************************************************/
+
+// Apply pfnFunc to each feature of pLayerInput and write the results to
+// pLayerResult in the order of the input layer, possibly using a pool of
+// worker threads when ctxt.poIndex is set.
+static OGRErr run_overlay_per_feature(OGRLayer* pLayerInput,
+                                      OGRLayer* pLayerResult,
+                                      const OGRLayerOverlayContext& ctxt,
+                                      OGRLayerOverlayFeatureFunc pfnFunc,
+                                      int nThreads,
+                                      GDALProgressFunc pfnProgress,
+                                      void * pProgressArg)
+{
+    double progress_max = static_cast<double>(pLayerInput->GetFeatureCount(FALSE));
+    double progress_counter = 0;
+    double progress_ticker = 0;
+
+    CPLWorkerThreadPool* poThreadPool = nullptr;
+    if( nThreads > 1 && ctxt.poIndex != nullptr )
+        poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    else if( nThreads > 1 )
+        CPLDebug("OGR", "NUM_THREADS ignored since USE_SPATIAL_INDEX=NO");
+    auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    const size_t nBatchSize = poJobQueue ? static_cast<size_t>(nThreads) * 16 : 1;
+
+    OGRLayerOverlayCandidates oCandidates(ctxt.pLayerMethod, ctxt.poIndex);
+    std::vector<std::unique_ptr<OGRLayerOverlayJob>> apoJobs;
+    pLayerInput->ResetReading();
+    bool bEOF = false;
+    while( !bEOF ) {
+
+        // read a batch of input features
+        apoJobs.clear();
+        while( apoJobs.size() < nBatchSize ) {
+            OGRFeatureUniquePtr x(pLayerInput->GetNextFeature());
+            if( !x ) {
+                bEOF = true;
+                break;
+            }
+            std::unique_ptr<OGRLayerOverlayJob> psJob(new OGRLayerOverlayJob());
+            psJob->pCtxt = &ctxt;
+            psJob->pfnFunc = pfnFunc;
+            psJob->x = std::move(x);
+            apoJobs.emplace_back(std::move(psJob));
+        }
+
+        if( poJobQueue ) {
+            for( auto& psJob: apoJobs )
+                poJobQueue->SubmitJob(OGRLayerOverlayJobFunc, psJob.get());
+            poJobQueue->WaitCompletion();
+        }
+
+        for( auto& psJob: apoJobs ) {
+
+            if (pfnProgress) {
+                double p = progress_counter/progress_max;
+                if (p > progress_ticker) {
+                    if (!pfnProgress(p, "", pProgressArg)) {
+                        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                        return OGRERR_FAILURE;
+                    }
+                }
+                progress_counter += 1.0;
+            }
+
+            if( !poJobQueue )
+                psJob->eErr = pfnFunc(ctxt, oCandidates, psJob->x.get(), psJob->apoResults);
+            if( psJob->eErr != OGRERR_NONE )
+                return psJob->eErr;
+
+            for( auto& z: psJob->apoResults ) {
+                OGRErr ret = pLayerResult->CreateFeature(z.get());
+                if (ret != OGRERR_NONE) {
+                    if (!ctxt.bSkipFailures) {
+                        return ret;
+                    } else {
+                        CPLErrorReset();
+                    }
+                }
+            }
+        }
+    }
+    if (pfnProgress && !pfnProgress(1.0, "", pProgressArg)) {
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return OGRERR_FAILURE;
+    }
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                      intersection_of_feature()                       */
+/************************************************************************/
+
+static OGRErr intersection_of_feature(const OGRLayerOverlayContext& ctxt,
+                                      OGRLayerOverlayCandidates& oCandidates,
+                                      OGRFeature* x,
+                                      std::vector<OGRFeatureUniquePtr>& apoResults)
+{
+    // is it worth to proceed?
+    if (ctxt.bEnvelopeSet) {
+        OGRGeometry *x_geom = x->GetGeometryRef();
+        if (x_geom) {
+            OGREnvelope x_env;
+            x_geom->getEnvelope(&x_env);
+            if (x_env.MaxX < ctxt.sEnvelopeMethod.MinX
+                || x_env.MaxY < ctxt.sEnvelopeMethod.MinY
+                || ctxt.sEnvelopeMethod.MaxX < x_env.MinX
+                || ctxt.sEnvelopeMethod.MaxY < x_env.MinY) {
+                return OGRERR_NONE;
+            }
+        } else {
+            return OGRERR_NONE;
+        }
+    }
+
+    // set up the filter for method layer
+    CPLErrorReset();
+    OGRGeometry *x_geom = oCandidates.SetFilterFrom(ctxt.pGeometryMethodFilter, x);
+    if (CPLGetLastErrorType() != CE_None) {
+        if (!ctxt.bSkipFailures) {
+            return OGRERR_FAILURE;
+        } else {
+            CPLErrorReset();
+        }
+    }
+    if (!x_geom) {
+        return OGRERR_NONE;
+    }
+
+    OGRPreparedGeometryUniquePtr x_prepared_geom;
+    if (ctxt.bUsePreparedGeometries) {
+        x_prepared_geom.reset(OGRCreatePreparedGeometry(OGRGeometry::ToHandle(x_geom)));
+        if (!x_prepared_geom) {
+            return OGRERR_NONE;
+        }
+    }
+    // x_geom is intersected with each candidate, so convert it to GEOS once
+    OGRGeometryGEOSCache oGEOSCache(x_geom);
+
+    while( OGRFeature* y = oCandidates.GetNext() ) {
+        OGRGeometry *y_geom = y->GetGeometryRef();
+        if (!y_geom) continue;
+        OGRGeometryUniquePtr z_geom;
+
+        if (x_prepared_geom) {
+            CPLErrorReset();
+            if (ctxt.bPretestContainment && OGRPreparedGeometryContains(x_prepared_geom.get(), OGRGeometry::ToHandle(y_geom)))
+            {
+                if (CPLGetLastErrorType() == CE_None)
+                    z_geom.reset(y_geom->clone());
+            }
+            else if (!(OGRPreparedGeometryIntersects(x_prepared_geom.get(), OGRGeometry::ToHandle(y_geom))))
+            {
+                if (CPLGetLastErrorType() == CE_None) {
+                    continue;
+                }
+            }
+            if (CPLGetLastErrorType() != CE_None) {
+                if (!ctxt.bSkipFailures) {
+                    return OGRERR_FAILURE;
+                } else {
+                    CPLErrorReset();
+                    continue;
+                }
+            }
+        }
+        if (!z_geom) {
+            CPLErrorReset();
+            z_geom.reset(x_geom->Intersection(y_geom));
+            if (CPLGetLastErrorType() != CE_None || z_geom == nullptr) {
+                if (!ctxt.bSkipFailures) {
+                    return OGRERR_FAILURE;
+                } else {
+                    CPLErrorReset();
+                    continue;
+                }
+            }
+            if (z_geom->IsEmpty() ||
+                (!ctxt.bKeepLowerDimGeom &&
+                 (x_geom->getDimension() == y_geom->getDimension() &&
+                  z_geom->getDimension() < x_geom->getDimension())))
+            {
+                continue;
+            }
+        }
+        OGRFeatureUniquePtr z(new OGRFeature(ctxt.poDefnResult));
+        z->SetFieldsFrom(x, ctxt.mapInput);
+        z->SetFieldsFrom(y, ctxt.mapMethod);
+        if (ctxt.bPromoteToMulti)
+            z_geom.reset(promote_to_multi(z_geom.release()));
+        z->SetGeometryDirectly(z_geom.release());
+        apoResults.emplace_back(std::move(z));
+    }
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                          Intersection()                              */
 /************************************************************************/
@@ -2174,6 +2733,8 @@ static OGRGeometry* promote_to_multi(OGRGeometry* poGeom)
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO and NUM_THREADS=number/ALL_CPUS
+ *     (GDAL >= 3.7). See \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Intersection().
@@ -2208,21 +2769,17 @@ OGRErr OGRLayer::Intersection( OGRLayer *pLayerMethod,
     OGRErr ret = OGRERR_NONE;
     OGRFeatureDefn *poDefnInput = GetLayerDefn();
     OGRFeatureDefn *poDefnMethod = pLayerMethod->GetLayerDefn();
-    OGRFeatureDefn *poDefnResult = nullptr;
     OGRGeometry *pGeometryMethodFilter = nullptr;
     int *mapInput = nullptr;
     int *mapMethod = nullptr;
-    OGREnvelope sEnvelopeMethod;
-    GBool bEnvelopeSet;
-    double progress_max = static_cast<double>(GetFeatureCount(FALSE));
-    double progress_counter = 0;
-    double progress_ticker = 0;
-    int bSkipFailures = CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_FAILURES", "NO"));
-    int bPromoteToMulti = CPLTestBool(CSLFetchNameValueDef(papszOptions, "PROMOTE_TO_MULTI", "NO"));
-    int bUsePreparedGeometries = CPLTestBool(CSLFetchNameValueDef(papszOptions, "USE_PREPARED_GEOMETRIES", "YES"));
-    if (bUsePreparedGeometries) bUsePreparedGeometries = OGRHasPreparedGeometrySupport();
-    int bPretestContainment = CPLTestBool(CSLFetchNameValueDef(papszOptions, "PRETEST_CONTAINMENT", "NO"));
-    int bKeepLowerDimGeom = CPLTestBool(CSLFetchNameValueDef(papszOptions, "KEEP_LOWER_DIMENSION_GEOMETRIES", "YES"));
+    std::unique_ptr<OGRLayerOverlayIndex> poIndex;
+    OGRLayerOverlayContext ctxt;
+    ctxt.bSkipFailures = CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_FAILURES", "NO"));
+    ctxt.bPromoteToMulti = CPLTestBool(CSLFetchNameValueDef(papszOptions, "PROMOTE_TO_MULTI", "NO"));
+    ctxt.bUsePreparedGeometries = CPLTestBool(CSLFetchNameValueDef(papszOptions, "USE_PREPARED_GEOMETRIES", "YES"));
+    if (ctxt.bUsePreparedGeometries) ctxt.bUsePreparedGeometries = CPL_TO_BOOL(OGRHasPreparedGeometrySupport());
+    ctxt.bPretestContainment = CPLTestBool(CSLFetchNameValueDef(papszOptions, "PRETEST_CONTAINMENT", "NO"));
+    ctxt.bKeepLowerDimGeom = CPLTestBool(CSLFetchNameValueDef(papszOptions, "KEEP_LOWER_DIMENSION_GEOMETRIES", "YES"));
 
     // check for GEOS
     if (!OGRGeometryFactory::haveGEOS()) {
@@ -2238,153 +2795,34 @@ OGRErr OGRLayer::Intersection( OGRLayer *pLayerMethod,
     if (ret != OGRERR_NONE) goto done;
     ret = set_result_schema(pLayerResult, poDefnInput, poDefnMethod, mapInput, mapMethod, true, papszOptions);
     if (ret != OGRERR_NONE) goto done;
-    poDefnResult = pLayerResult->GetLayerDefn();
-    bEnvelopeSet = pLayerMethod->GetExtent(&sEnvelopeMethod, 1) == OGRERR_NONE;
-    if (bKeepLowerDimGeom) {
+    ctxt.bEnvelopeSet = pLayerMethod->GetExtent(&ctxt.sEnvelopeMethod, 1) == OGRERR_NONE;
+    if (ctxt.bKeepLowerDimGeom) {
         // require that the result layer is of geom type unknown
         if (pLayerResult->GetGeomType() != wkbUnknown) {
             CPLDebug("OGR", "Resetting KEEP_LOWER_DIMENSION_GEOMETRIES to NO since the result layer does not allow it.");
-            bKeepLowerDimGeom = FALSE;
+            ctxt.bKeepLowerDimGeom = false;
         }
     }
-
-    for( auto&& x: this ) {
-
-        if (pfnProgress) {
-            double p = progress_counter/progress_max;
-            if (p > progress_ticker) {
-                if (!pfnProgress(p, "", pProgressArg)) {
-                    CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                    ret = OGRERR_FAILURE;
-                    goto done;
-                }
-            }
-            progress_counter += 1.0;
-        }
-
-        // is it worth to proceed?
-        if (bEnvelopeSet) {
-            OGRGeometry *x_geom = x->GetGeometryRef();
-            if (x_geom) {
-                OGREnvelope x_env;
-                x_geom->getEnvelope(&x_env);
-                if (x_env.MaxX < sEnvelopeMethod.MinX
-                    || x_env.MaxY < sEnvelopeMethod.MinY
-                    || sEnvelopeMethod.MaxX < x_env.MinX
-                    || sEnvelopeMethod.MaxY < x_env.MinY) {
-                    continue;
-                }
-            } else {
-                continue;
-            }
-        }
-
-        // set up the filter for method layer
-        CPLErrorReset();
-        OGRGeometry *x_geom = set_filter_from(pLayerMethod, pGeometryMethodFilter, x.get());
-        if (CPLGetLastErrorType() != CE_None) {
-            if (!bSkipFailures) {
-                ret = OGRERR_FAILURE;
-                goto done;
-            } else {
-                CPLErrorReset();
-                ret = OGRERR_NONE;
-            }
-        }
-        if (!x_geom) {
-            continue;
-        }
-
-        OGRPreparedGeometryUniquePtr x_prepared_geom;
-        if (bUsePreparedGeometries) {
-            x_prepared_geom.reset(OGRCreatePreparedGeometry(OGRGeometry::ToHandle(x_geom)));
-            if (!x_prepared_geom) {
-                goto done;
-            }
-        }
-
-        for( auto&& y: pLayerMethod ) {
-            OGRGeometry *y_geom = y->GetGeometryRef();
-            if (!y_geom) continue;
-            OGRGeometryUniquePtr z_geom;
-
-            if (x_prepared_geom) {
-                CPLErrorReset();
-                ret = OGRERR_NONE;
-                if (bPretestContainment && OGRPreparedGeometryContains(x_prepared_geom.get(), OGRGeometry::ToHandle(y_geom)))
-                {
-                    if (CPLGetLastErrorType() == CE_None)
-                        z_geom.reset(y_geom->clone());
-                }
-                else if (!(OGRPreparedGeometryIntersects(x_prepared_geom.get(), OGRGeometry::ToHandle(y_geom))))
-                {
-                    if (CPLGetLastErrorType() == CE_None) {
-                        continue;
-                    }
-                }
-                if (CPLGetLastErrorType() != CE_None) {
-                    if (!bSkipFailures) {
-                        ret = OGRERR_FAILURE;
-                        goto done;
-                    } else {
-                        CPLErrorReset();
-                        ret = OGRERR_NONE;
-                        continue;
-                    }
-                }
-            }
-            if (!z_geom) {
-                CPLErrorReset();
-                z_geom.reset(x_geom->Intersection(y_geom));
-                if (CPLGetLastErrorType() != CE_None || z_geom == nullptr) {
-                    if (!bSkipFailures) {
-                        ret = OGRERR_FAILURE;
-                        goto done;
-                    } else {
-                        CPLErrorReset();
-                        ret = OGRERR_NONE;
-                        continue;
-                    }
-                }
-                if (z_geom->IsEmpty() ||
-                    (!bKeepLowerDimGeom &&
-                     (x_geom->getDimension() == y_geom->getDimension() &&
-                      z_geom->getDimension() < x_geom->getDimension())))
-                {
-                    continue;
-                }
-            }
-            OGRFeatureUniquePtr z(new OGRFeature(poDefnResult));
-            z->SetFieldsFrom(x.get(), mapInput);
-            z->SetFieldsFrom(y.get(), mapMethod);
-            if (bPromoteToMulti)
-                z_geom.reset(promote_to_multi(z_geom.release()));
-            z->SetGeometryDirectly(z_geom.release());
-            ret = pLayerResult->CreateFeature(z.get());
-
-            if (ret != OGRERR_NONE) {
-                if (!bSkipFailures) {
-                    goto done;
-                } else {
-                    CPLErrorReset();
-                    ret = OGRERR_NONE;
-                }
-            }
-        }
-    }
-    if (pfnProgress && !pfnProgress(1.0, "", pProgressArg)) {
-      CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-      ret = OGRERR_FAILURE;
-      goto done;
-    }
-done:
-    // release resources
-    pLayerMethod->SetSpatialFilter(pGeometryMethodFilter);
-    if (pGeometryMethodFilter) delete pGeometryMethodFilter;
-    if (mapInput) VSIFree(mapInput);
-    if (mapMethod) VSIFree(mapMethod);
-    return ret;
-}
+    poIndex = build_overlay_index(pLayerMethod, papszOptions, ctxt.bUsePreparedGeometries);
+
+    ctxt.pLayerMethod = pLayerMethod;
+    ctxt.poIndex = poIndex.get();
+    ctxt.pGeometryMethodFilter = pGeometryMethodFilter;
+    ctxt.poDefnResult = pLayerResult->GetLayerDefn();
+    ctxt.mapInput = mapInput;
+    ctxt.mapMethod = mapMethod;
+    ret = run_overlay_per_feature(this, pLayerResult, ctxt,
+                                  intersection_of_feature,
+                                  GDALGetNumThreads(papszOptions),
+                                  pfnProgress, pProgressArg);
+done:
+    // release resources
+    pLayerMethod->SetSpatialFilter(pGeometryMethodFilter);
+    if (pGeometryMethodFilter) delete pGeometryMethodFilter;
+    if (mapInput) VSIFree(mapInput);
+    if (mapMethod) VSIFree(mapMethod);
+    return ret;
+}
 
 /************************************************************************/
 /*                       OGR_L_Intersection()                           */
@@ -2431,6 +2869,8 @@ done:
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO and NUM_THREADS=number/ALL_CPUS
+ *     (GDAL >= 3.7). See \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Intersection().
@@ -2520,6 +2960,8 @@ OGRErr OGR_L_Intersection( OGRLayerH pLayerInput,
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO (GDAL >= 3.7). See
+ *     \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Union().
@@ -2559,6 +3001,10 @@ OGRErr OGRLayer::Union( OGRLayer *pLayerMethod,
     OGRGeometry *pGeometryInputFilter = nullptr;
     int *mapInput = nullptr;
     int *mapMethod = nullptr;
+    std::unique_ptr<OGRLayerOverlayIndex> poMethodIndex;
+    std::unique_ptr<OGRLayerOverlayIndex> poInputIndex;
+    OGRLayerOverlayCandidates oMethodCandidates(pLayerMethod, nullptr);
+    OGRLayerOverlayCandidates oInputCandidates(this, nullptr);
     double progress_max = static_cast<double>(GetFeatureCount(FALSE)) + static_cast<double>(pLayerMethod->GetFeatureCount(FALSE));
     double progress_counter = 0;
     double progress_ticker = 0;
@@ -2585,6 +3031,8 @@ OGRErr OGRLayer::Union( OGRLayer *pLayerMethod,
     ret = set_result_schema(pLayerResult, poDefnInput, poDefnMethod, mapInput, mapMethod, true, papszOptions);
     if (ret != OGRERR_NONE) goto done;
     poDefnResult = pLayerResult->GetLayerDefn();
+    poMethodIndex = build_overlay_index(pLayerMethod, papszOptions, CPL_TO_BOOL(bUsePreparedGeometries));
+    oMethodCandidates.SetIndex(poMethodIndex.get());
     if (bKeepLowerDimGeom) {
         // require that the result layer is of geom type unknown
         if (pLayerResult->GetGeomType() != wkbUnknown) {
@@ -2610,7 +3058,7 @@ OGRErr OGRLayer::Union( OGRLayer *pLayerMethod,
 
         // set up the filter on method layer
         CPLErrorReset();
-        OGRGeometry *x_geom = set_filter_from(pLayerMethod, pGeometryMethodFilter, x.get());
+        OGRGeometry *x_geom = oMethodCandidates.SetFilterFrom(pGeometryMethodFilter, x.get());
         if (CPLGetLastErrorType() != CE_None) {
             if (!bSkipFailures) {
                 ret = OGRERR_FAILURE;
@@ -2631,9 +3079,11 @@ OGRErr OGRLayer::Union( OGRLayer *pLayerMethod,
                 goto done;
             }
         }
+        // x_geom is intersected with each candidate, so convert it to GEOS once
+        OGRGeometryGEOSCache oGEOSCache(x_geom);
 
         OGRGeometryUniquePtr x_geom_diff(x_geom->clone()); // this will be the geometry of the result feature
-        for( auto&& y: pLayerMethod) {
+        while( OGRFeature* y = oMethodCandidates.GetNext() ) {
             OGRGeometry *y_geom = y->GetGeometryRef();
             if (!y_geom) { continue;}
 
@@ -2676,7 +3126,7 @@ OGRErr OGRLayer::Union( OGRLayer *pLayerMethod,
             {
                 OGRFeatureUniquePtr z(new OGRFeature(poDefnResult));
                 z->SetFieldsFrom(x.get(), mapInput);
-                z->SetFieldsFrom(y.get(), mapMethod);
+                z->SetFieldsFrom(y, mapMethod);
                 if( bPromoteToMulti )
                     poIntersection.reset(promote_to_multi(poIntersection.release()));
                 z->SetGeometryDirectly(poIntersection.release());
@@ -2734,6 +3184,8 @@ OGRErr OGRLayer::Union( OGRLayer *pLayerMethod,
 
     // restore filter on method layer and add features based on it
     pLayerMethod->SetSpatialFilter(pGeometryMethodFilter);
+    poInputIndex = build_overlay_index(this, papszOptions, CPL_TO_BOOL(bUsePreparedGeometries));
+    oInputCandidates.SetIndex(poInputIndex.get());
     for( auto&& x: pLayerMethod ) {
 
         if (pfnProgress) {
@@ -2750,7 +3202,7 @@ OGRErr OGRLayer::Union( OGRLayer *pLayerMethod,
 
         // set up the filter on input layer
         CPLErrorReset();
-        OGRGeometry *x_geom = set_filter_from(this, pGeometryInputFilter, x.get());
+        OGRGeometry *x_geom = oInputCandidates.SetFilterFrom(pGeometryInputFilter, x.get());
         if (CPLGetLastErrorType() != CE_None) {
             if (!bSkipFailures) {
                 ret = OGRERR_FAILURE;
@@ -2765,7 +3217,7 @@ OGRErr OGRLayer::Union( OGRLayer *pLayerMethod,
         }
 
         OGRGeometryUniquePtr x_geom_diff(x_geom->clone()); // this will be the geometry of the result feature
-        for( auto&& y: this ) {
+        while( OGRFeature* y = oInputCandidates.GetNext() ) {
             OGRGeometry *y_geom = y->GetGeometryRef();
             if (!y_geom) { continue;}
 
@@ -2868,6 +3320,8 @@ done:
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO (GDAL >= 3.7). See
+ *     \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Union().
@@ -2950,6 +3404,8 @@ OGRErr OGR_L_Union( OGRLayerH pLayerInput,
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO (GDAL >= 3.7). See
+ *     \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This method is the same as the C function OGR_L_SymDifference().
@@ -2989,6 +3445,10 @@ OGRErr OGRLayer::SymDifference( OGRLayer *pLayerMethod,
     OGRGeometry *pGeometryInputFilter = nullptr;
     int *mapInput = nullptr;
     int *mapMethod = nullptr;
+    std::unique_ptr<OGRLayerOverlayIndex> poMethodIndex;
+    std::unique_ptr<OGRLayerOverlayIndex> poInputIndex;
+    OGRLayerOverlayCandidates oMethodCandidates(pLayerMethod, nullptr);
+    OGRLayerOverlayCandidates oInputCandidates(this, nullptr);
     double progress_max = static_cast<double>(GetFeatureCount(FALSE)) + static_cast<double>(pLayerMethod->GetFeatureCount(FALSE));
     double progress_counter = 0;
     double progress_ticker = 0;
@@ -3012,6 +3472,8 @@ OGRErr OGRLayer::SymDifference( OGRLayer *pLayerMethod,
     ret = set_result_schema(pLayerResult, poDefnInput, poDefnMethod, mapInput, mapMethod, true, papszOptions);
     if (ret != OGRERR_NONE) goto done;
     poDefnResult = pLayerResult->GetLayerDefn();
+    poMethodIndex = build_overlay_index(pLayerMethod, papszOptions, CPL_TO_BOOL(OGRHasPreparedGeometrySupport()));
+    oMethodCandidates.SetIndex(poMethodIndex.get());
 
     // add features based on input layer
     for( auto&& x: this ) {
@@ -3030,7 +3492,7 @@ OGRErr OGRLayer::SymDifference( OGRLayer *pLayerMethod,
 
         // set up the filter on method layer
         CPLErrorReset();
-        OGRGeometry *x_geom = set_filter_from(pLayerMethod, pGeometryMethodFilter, x.get());
+        OGRGeometry *x_geom = oMethodCandidates.SetFilterFrom(pGeometryMethodFilter, x.get());
         if (CPLGetLastErrorType() != CE_None) {
             if (!bSkipFailures) {
                 ret = OGRERR_FAILURE;
@@ -3045,7 +3507,7 @@ OGRErr OGRLayer::SymDifference( OGRLayer *pLayerMethod,
         }
 
         OGRGeometryUniquePtr geom(x_geom->clone()); // this will be the geometry of the result feature
-        for( auto&& y: pLayerMethod ) {
+        while( OGRFeature* y = oMethodCandidates.GetNext() ) {
             OGRGeometry *y_geom = y->GetGeometryRef();
             if (!y_geom) {continue;}
             if (geom) {
@@ -3086,6 +3548,8 @@ OGRErr OGRLayer::SymDifference( OGRLayer *pLayerMethod,
 
     // restore filter on method layer and add features based on it
     pLayerMethod->SetSpatialFilter(pGeometryMethodFilter);
+    poInputIndex = build_overlay_index(this, papszOptions, CPL_TO_BOOL(OGRHasPreparedGeometrySupport()));
+    oInputCandidates.SetIndex(poInputIndex.get());
     for( auto&& x: pLayerMethod ) {
 
         if (pfnProgress) {
@@ -3102,7 +3566,7 @@ OGRErr OGRLayer::SymDifference( OGRLayer *pLayerMethod,
 
         // set up the filter on input layer
         CPLErrorReset();
-        OGRGeometry *x_geom = set_filter_from(this, pGeometryInputFilter, x.get());
+        OGRGeometry *x_geom = oInputCandidates.SetFilterFrom(pGeometryInputFilter, x.get());
         if (CPLGetLastErrorType() != CE_None) {
             if (!bSkipFailures) {
                 ret = OGRERR_FAILURE;
@@ -3117,7 +3581,7 @@ OGRErr OGRLayer::SymDifference( OGRLayer *pLayerMethod,
         }
 
         OGRGeometryUniquePtr geom(x_geom->clone()); // this will be the geometry of the result feature
-        for( auto&& y: this ) {
+        while( OGRFeature* y = oInputCandidates.GetNext() ) {
             OGRGeometry *y_geom = y->GetGeometryRef();
             if (!y_geom) continue;
             if (geom) {
@@ -3208,6 +3672,8 @@ done:
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO (GDAL >= 3.7). See
+ *     \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::SymDifference().
@@ -3295,6 +3761,8 @@ OGRErr OGR_L_SymDifference( OGRLayerH pLayerInput,
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO (GDAL >= 3.7). See
+ *     \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Identity().
@@ -3333,6 +3801,8 @@ OGRErr OGRLayer::Identity( OGRLayer *pLayerMethod,
     OGRGeometry *pGeometryMethodFilter = nullptr;
     int *mapInput = nullptr;
     int *mapMethod = nullptr;
+    std::unique_ptr<OGRLayerOverlayIndex> poMethodIndex;
+    OGRLayerOverlayCandidates oMethodCandidates(pLayerMethod, nullptr);
     double progress_max = static_cast<double>(GetFeatureCount(FALSE));
     double progress_counter = 0;
     double progress_ticker = 0;
@@ -3364,6 +3834,8 @@ OGRErr OGRLayer::Identity( OGRLayer *pLayerMethod,
     ret = set_result_schema(pLayerResult, poDefnInput, poDefnMethod, mapInput, mapMethod, true, papszOptions);
     if (ret != OGRERR_NONE) goto done;
     poDefnResult = pLayerResult->GetLayerDefn();
+    poMethodIndex = build_overlay_index(pLayerMethod, papszOptions, CPL_TO_BOOL(bUsePreparedGeometries));
+    oMethodCandidates.SetIndex(poMethodIndex.get());
 
     // split the features in input layer to the result layer
     for( auto&& x: this ) {
@@ -3382,7 +3854,7 @@ OGRErr OGRLayer::Identity( OGRLayer *pLayerMethod,
 
         // set up the filter on method layer
         CPLErrorReset();
-        OGRGeometry *x_geom = set_filter_from(pLayerMethod, pGeometryMethodFilter, x.get());
+        OGRGeometry *x_geom = oMethodCandidates.SetFilterFrom(pGeometryMethodFilter, x.get());
         if (CPLGetLastErrorType() != CE_None) {
             if (!bSkipFailures) {
                 ret = OGRERR_FAILURE;
@@ -3403,9 +3875,11 @@ OGRErr OGRLayer::Identity( OGRLayer *pLayerMethod,
                 goto done;
             }
         }
+        // x_geom is intersected with each candidate, so convert it to GEOS once
+        OGRGeometryGEOSCache oGEOSCache(x_geom);
 
         OGRGeometryUniquePtr x_geom_diff(x_geom->clone()); // this will be the geometry of the result feature
-        for( auto&& y: pLayerMethod ) {
+        while( OGRFeature* y = oMethodCandidates.GetNext() ) {
             OGRGeometry *y_geom = y->GetGeometryRef();
             if (!y_geom)
                 continue;
@@ -3448,7 +3922,7 @@ OGRErr OGRLayer::Identity( OGRLayer *pLayerMethod,
             {
                 OGRFeatureUniquePtr z(new OGRFeature(poDefnResult));
                 z->SetFieldsFrom(x.get(), mapInput);
-                z->SetFieldsFrom(y.get(), mapMethod);
+                z->SetFieldsFrom(y, mapMethod);
                 if( bPromoteToMulti )
                     poIntersection.reset(promote_to_multi(poIntersection.release()));
                 z->SetGeometryDirectly(poIntersection.release());
@@ -3558,6 +4032,8 @@ done:
  *     result features with lower dimension geometry that would
  *     otherwise be added to the result layer. The default is to add
  *     but only if the result layer has an unknown geometry type.
+ * <li>USE_SPATIAL_INDEX=YES/NO (GDAL >= 3.7). See
+ *     \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Identity().
@@ -3640,6 +4116,8 @@ OGRErr OGR_L_Identity( OGRLayerH pLayerInput,
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO (GDAL >= 3.7). See
+ *     \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Update().
@@ -3678,6 +4156,8 @@ OGRErr OGRLayer::Update( OGRLayer *pLayerMethod,
     OGRGeometry *pGeometryMethodFilter = nullptr;
     int *mapInput = nullptr;
     int *mapMethod = nullptr;
+    std::unique_ptr<OGRLayerOverlayIndex> poMethodIndex;
+    OGRLayerOverlayCandidates oMethodCandidates(pLayerMethod, nullptr);
     double progress_max = static_cast<double>(GetFeatureCount(FALSE)) + static_cast<double>(pLayerMethod->GetFeatureCount(FALSE));
     double progress_counter = 0;
     double progress_ticker = 0;
@@ -3699,6 +4179,8 @@ OGRErr OGRLayer::Update( OGRLayer *pLayerMethod,
     ret = set_result_schema(pLayerResult, poDefnInput, poDefnMethod, mapInput, mapMethod, false, papszOptions);
     if (ret != OGRERR_NONE) goto done;
     poDefnResult = pLayerResult->GetLayerDefn();
+    poMethodIndex = build_overlay_index(pLayerMethod, papszOptions, CPL_TO_BOOL(OGRHasPreparedGeometrySupport()));
+    oMethodCandidates.SetIndex(poMethodIndex.get());
 
     // add clipped features from the input layer
     for( auto&& x: this ) {
@@ -3717,7 +4199,7 @@ OGRErr OGRLayer::Update( OGRLayer *pLayerMethod,
 
         // set up the filter on method layer
         CPLErrorReset();
-        OGRGeometry *x_geom = set_filter_from(pLayerMethod, pGeometryMethodFilter, x.get());
+        OGRGeometry *x_geom = oMethodCandidates.SetFilterFrom(pGeometryMethodFilter, x.get());
         if (CPLGetLastErrorType() != CE_None) {
             if (!bSkipFailures) {
                 ret = OGRERR_FAILURE;
@@ -3732,7 +4214,7 @@ OGRErr OGRLayer::Update( OGRLayer *pLayerMethod,
         }
 
         OGRGeometryUniquePtr x_geom_diff(x_geom->clone()); //this will be the geometry of a result feature
-        for( auto&& y: pLayerMethod ) {
+        while( OGRFeature* y = oMethodCandidates.GetNext() ) {
             OGRGeometry *y_geom = y->GetGeometryRef();
             if (!y_geom) continue;
             if (x_geom_diff) {
@@ -3857,6 +4339,8 @@ done:
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO (GDAL >= 3.7). See
+ *     \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Update().
@@ -3902,6 +4386,75 @@ OGRErr OGR_L_Update( OGRLayerH pLayerInput,
         papszOptions, pfnProgress, pProgressArg );
 }
 
+/************************************************************************/
+/*                          clip_of_feature()                           */
+/************************************************************************/
+
+static OGRErr clip_of_feature(const OGRLayerOverlayContext& ctxt,
+                              OGRLayerOverlayCandidates& oCandidates,
+                              OGRFeature* x,
+                              std::vector<OGRFeatureUniquePtr>& apoResults)
+{
+    // set up the filter on method layer
+    CPLErrorReset();
+    OGRGeometry *x_geom = oCandidates.SetFilterFrom(ctxt.pGeometryMethodFilter, x);
+    if (CPLGetLastErrorType() != CE_None) {
+        if (!ctxt.bSkipFailures) {
+            return OGRERR_FAILURE;
+        } else {
+            CPLErrorReset();
+        }
+    }
+    if (!x_geom) {
+        return OGRERR_NONE;
+    }
+
+    OGRGeometryUniquePtr geom; // this will be the geometry of the result feature
+    // incrementally add area from y to geom
+    while( OGRFeature* y = oCandidates.GetNext() ) {
+        OGRGeometry *y_geom = y->GetGeometryRef();
+        if (!y_geom) continue;
+        if (!geom) {
+            geom.reset(y_geom->clone());
+        } else {
+            CPLErrorReset();
+            OGRGeometryUniquePtr geom_new(geom->Union(y_geom));
+            if (CPLGetLastErrorType() != CE_None || geom_new == nullptr) {
+                if (!ctxt.bSkipFailures) {
+                    return OGRERR_FAILURE;
+                } else {
+                    CPLErrorReset();
+                }
+            } else {
+                geom.swap(geom_new);
+            }
+        }
+    }
+
+    // possibly add a new feature with area x intersection sum of y
+    if (geom) {
+        CPLErrorReset();
+        OGRGeometryUniquePtr poIntersection(x_geom->Intersection(geom.get()));
+        if (CPLGetLastErrorType() != CE_None || poIntersection == nullptr) {
+            if (!ctxt.bSkipFailures) {
+                return OGRERR_FAILURE;
+            } else {
+                CPLErrorReset();
+            }
+        }
+        else if( !poIntersection->IsEmpty() )
+        {
+            OGRFeatureUniquePtr z(new OGRFeature(ctxt.poDefnResult));
+            z->SetFieldsFrom(x, ctxt.mapInput);
+            if( ctxt.bPromoteToMulti )
+                poIntersection.reset(promote_to_multi(poIntersection.release()));
+            z->SetGeometryDirectly(poIntersection.release());
+            apoResults.emplace_back(std::move(z));
+        }
+    }
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                              Clip()                                  */
 /************************************************************************/
@@ -3932,6 +4485,8 @@ OGRErr OGR_L_Update( OGRLayerH pLayerInput,
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO and NUM_THREADS=number/ALL_CPUS
+ *     (GDAL >= 3.7). See \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Clip().
@@ -3965,14 +4520,12 @@ OGRErr OGRLayer::Clip( OGRLayer *pLayerMethod,
 {
     OGRErr ret = OGRERR_NONE;
     OGRFeatureDefn *poDefnInput = GetLayerDefn();
-    OGRFeatureDefn *poDefnResult = nullptr;
     OGRGeometry *pGeometryMethodFilter = nullptr;
     int *mapInput = nullptr;
-    double progress_max = static_cast<double>(GetFeatureCount(FALSE));
-    double progress_counter = 0;
-    double progress_ticker = 0;
-    int bSkipFailures = CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_FAILURES", "NO"));
-    int bPromoteToMulti = CPLTestBool(CSLFetchNameValueDef(papszOptions, "PROMOTE_TO_MULTI", "NO"));
+    std::unique_ptr<OGRLayerOverlayIndex> poIndex;
+    OGRLayerOverlayContext ctxt;
+    ctxt.bSkipFailures = CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_FAILURES", "NO"));
+    ctxt.bPromoteToMulti = CPLTestBool(CSLFetchNameValueDef(papszOptions, "PROMOTE_TO_MULTI", "NO"));
 
     // check for GEOS
     if (!OGRGeometryFactory::haveGEOS()) {
@@ -3985,99 +4538,17 @@ OGRErr OGRLayer::Clip( OGRLayer *pLayerMethod,
     if (ret != OGRERR_NONE) goto done;
     ret = set_result_schema(pLayerResult, poDefnInput, nullptr, mapInput, nullptr, false, papszOptions);
     if (ret != OGRERR_NONE) goto done;
-
-    poDefnResult = pLayerResult->GetLayerDefn();
-    for( auto&& x: this ) {
-
-        if (pfnProgress) {
-            double p = progress_counter/progress_max;
-            if (p > progress_ticker) {
-                if (!pfnProgress(p, "", pProgressArg)) {
-                    CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                    ret = OGRERR_FAILURE;
-                    goto done;
-                }
-            }
-            progress_counter += 1.0;
-        }
-
-        // set up the filter on method layer
-        CPLErrorReset();
-        OGRGeometry *x_geom = set_filter_from(pLayerMethod, pGeometryMethodFilter, x.get());
-        if (CPLGetLastErrorType() != CE_None) {
-            if (!bSkipFailures) {
-                ret = OGRERR_FAILURE;
-                goto done;
-            } else {
-                CPLErrorReset();
-                ret = OGRERR_NONE;
-            }
-        }
-        if (!x_geom) {
-            continue;
-        }
-
-        OGRGeometryUniquePtr geom; // this will be the geometry of the result feature
-        // incrementally add area from y to geom
-        for( auto&& y: pLayerMethod ) {
-            OGRGeometry *y_geom = y->GetGeometryRef();
-            if (!y_geom) continue;
-            if (!geom) {
-                geom.reset(y_geom->clone());
-            } else {
-                CPLErrorReset();
-                OGRGeometryUniquePtr geom_new(geom->Union(y_geom));
-                if (CPLGetLastErrorType() != CE_None || geom_new == nullptr) {
-                    if (!bSkipFailures) {
-                        ret = OGRERR_FAILURE;
-                        goto done;
-                    } else {
-                        CPLErrorReset();
-                        ret = OGRERR_NONE;
-                    }
-                } else {
-                    geom.swap(geom_new);
-                }
-            }
-        }
-
-        // possibly add a new feature with area x intersection sum of y
-        if (geom) {
-            CPLErrorReset();
-            OGRGeometryUniquePtr poIntersection(x_geom->Intersection(geom.get()));
-            if (CPLGetLastErrorType() != CE_None || poIntersection == nullptr) {
-                if (!bSkipFailures) {
-                    ret = OGRERR_FAILURE;
-                    goto done;
-                } else {
-                    CPLErrorReset();
-                    ret = OGRERR_NONE;
-                }
-            }
-            else if( !poIntersection->IsEmpty() )
-            {
-                OGRFeatureUniquePtr z(new OGRFeature(poDefnResult));
-                z->SetFieldsFrom(x.get(), mapInput);
-                if( bPromoteToMulti )
-                    poIntersection.reset(promote_to_multi(poIntersection.release()));
-                z->SetGeometryDirectly(poIntersection.release());
-                ret = pLayerResult->CreateFeature(z.get());
-                if (ret != OGRERR_NONE) {
-                    if (!bSkipFailures) {
-                        goto done;
-                    } else {
-                        CPLErrorReset();
-                        ret = OGRERR_NONE;
-                    }
-                }
-            }
-        }
-    }
-    if (pfnProgress && !pfnProgress(1.0, "", pProgressArg)) {
-      CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-      ret = OGRERR_FAILURE;
-      goto done;
-    }
+    poIndex = build_overlay_index(pLayerMethod, papszOptions, CPL_TO_BOOL(OGRHasPreparedGeometrySupport()));
+
+    ctxt.pLayerMethod = pLayerMethod;
+    ctxt.poIndex = poIndex.get();
+    ctxt.pGeometryMethodFilter = pGeometryMethodFilter;
+    ctxt.poDefnResult = pLayerResult->GetLayerDefn();
+    ctxt.mapInput = mapInput;
+    ret = run_overlay_per_feature(this, pLayerResult, ctxt,
+                                  clip_of_feature,
+                                  GDALGetNumThreads(papszOptions),
+                                  pfnProgress, pProgressArg);
 done:
     // release resources
     pLayerMethod->SetSpatialFilter(pGeometryMethodFilter);
@@ -4116,6 +4587,8 @@ done:
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO and NUM_THREADS=number/ALL_CPUS
+ *     (GDAL >= 3.7). See \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Clip().
@@ -4161,6 +4634,63 @@ OGRErr OGR_L_Clip( OGRLayerH pLayerInput,
         papszOptions, pfnProgress, pProgressArg );
 }
 
+/************************************************************************/
+/*                          erase_of_feature()                          */
+/************************************************************************/
+
+static OGRErr erase_of_feature(const OGRLayerOverlayContext& ctxt,
+                               OGRLayerOverlayCandidates& oCandidates,
+                               OGRFeature* x,
+                               std::vector<OGRFeatureUniquePtr>& apoResults)
+{
+    // set up the filter on the method layer
+    CPLErrorReset();
+    OGRGeometry *x_geom = oCandidates.SetFilterFrom(ctxt.pGeometryMethodFilter, x);
+    if (CPLGetLastErrorType() != CE_None) {
+        if (!ctxt.bSkipFailures) {
+            return OGRERR_FAILURE;
+        } else {
+            CPLErrorReset();
+        }
+    }
+    if (!x_geom) {
+        return OGRERR_NONE;
+    }
+
+    OGRGeometryUniquePtr geom(x_geom->clone()); // this will be the geometry of the result feature
+    // incrementally erase y from geom
+    while( OGRFeature* y = oCandidates.GetNext() ) {
+        OGRGeometry *y_geom = y->GetGeometryRef();
+        if (!y_geom) continue;
+        CPLErrorReset();
+        OGRGeometryUniquePtr geom_new(geom->Difference(y_geom));
+        if (CPLGetLastErrorType() != CE_None || geom_new == nullptr) {
+            if (!ctxt.bSkipFailures) {
+                return OGRERR_FAILURE;
+            } else {
+                CPLErrorReset();
+            }
+        } else {
+            geom.swap(geom_new);
+            if (geom->IsEmpty())
+            {
+                break;
+            }
+        }
+    }
+
+    // add a new feature if there is remaining area
+    if (!geom->IsEmpty()) {
+        OGRFeatureUniquePtr z(new OGRFeature(ctxt.poDefnResult));
+        z->SetFieldsFrom(x, ctxt.mapInput);
+        if( ctxt.bPromoteToMulti )
+            geom.reset(promote_to_multi(geom.release()));
+        z->SetGeometryDirectly(geom.release());
+        apoResults.emplace_back(std::move(z));
+    }
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                              Erase()                                 */
 /************************************************************************/
@@ -4191,6 +4721,8 @@ OGRErr OGR_L_Clip( OGRLayerH pLayerInput,
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO and NUM_THREADS=number/ALL_CPUS
+ *     (GDAL >= 3.7). See \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This method is the same as the C function OGR_L_Erase().
@@ -4224,14 +4756,12 @@ OGRErr OGRLayer::Erase( OGRLayer *pLayerMethod,
 {
     OGRErr ret = OGRERR_NONE;
     OGRFeatureDefn *poDefnInput = GetLayerDefn();
-    OGRFeatureDefn *poDefnResult = nullptr;
     OGRGeometry *pGeometryMethodFilter = nullptr;
     int *mapInput = nullptr;
-    double progress_max = static_cast<double>(GetFeatureCount(FALSE));
-    double progress_counter = 0;
-    double progress_ticker = 0;
-    int bSkipFailures = CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_FAILURES", "NO"));
-    int bPromoteToMulti = CPLTestBool(CSLFetchNameValueDef(papszOptions, "PROMOTE_TO_MULTI", "NO"));
+    std::unique_ptr<OGRLayerOverlayIndex> poIndex;
+    OGRLayerOverlayContext ctxt;
+    ctxt.bSkipFailures = CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_FAILURES", "NO"));
+    ctxt.bPromoteToMulti = CPLTestBool(CSLFetchNameValueDef(papszOptions, "PROMOTE_TO_MULTI", "NO"));
 
     // check for GEOS
     if (!OGRGeometryFactory::haveGEOS()) {
@@ -4245,96 +4775,28 @@ OGRErr OGRLayer::Erase( OGRLayer *pLayerMethod,
     if (ret != OGRERR_NONE) goto done;
     ret = set_result_schema(pLayerResult, poDefnInput, nullptr, mapInput, nullptr, false, papszOptions);
     if (ret != OGRERR_NONE) goto done;
-    poDefnResult = pLayerResult->GetLayerDefn();
-
-    for( auto&& x: this ) {
+    poIndex = build_overlay_index(pLayerMethod, papszOptions, CPL_TO_BOOL(OGRHasPreparedGeometrySupport()));
+
+    ctxt.pLayerMethod = pLayerMethod;
+    ctxt.poIndex = poIndex.get();
+    ctxt.pGeometryMethodFilter = pGeometryMethodFilter;
+    ctxt.poDefnResult = pLayerResult->GetLayerDefn();
+    ctxt.mapInput = mapInput;
+    ret = run_overlay_per_feature(this, pLayerResult, ctxt,
+                                  erase_of_feature,
+                                  GDALGetNumThreads(papszOptions),
+                                  pfnProgress, pProgressArg);
+done:
+    // release resources
+    pLayerMethod->SetSpatialFilter(pGeometryMethodFilter);
+    if (pGeometryMethodFilter) delete pGeometryMethodFilter;
+    if (mapInput) VSIFree(mapInput);
+    return ret;
+}
 
-        if (pfnProgress) {
-            double p = progress_counter/progress_max;
-            if (p > progress_ticker) {
-                if (!pfnProgress(p, "", pProgressArg)) {
-                    CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                    ret = OGRERR_FAILURE;
-                    goto done;
-                }
-            }
-            progress_counter += 1.0;
-        }
-
-        // set up the filter on the method layer
-        CPLErrorReset();
-        OGRGeometry *x_geom = set_filter_from(pLayerMethod, pGeometryMethodFilter, x.get());
-        if (CPLGetLastErrorType() != CE_None) {
-            if (!bSkipFailures) {
-                ret = OGRERR_FAILURE;
-                goto done;
-            } else {
-                CPLErrorReset();
-                ret = OGRERR_NONE;
-            }
-        }
-        if (!x_geom) {
-            continue;
-        }
-
-        OGRGeometryUniquePtr geom(x_geom->clone()); // this will be the geometry of the result feature
-        // incrementally erase y from geom
-        for( auto&& y: pLayerMethod ) {
-            OGRGeometry *y_geom = y->GetGeometryRef();
-            if (!y_geom) continue;
-            CPLErrorReset();
-            OGRGeometryUniquePtr geom_new(geom->Difference(y_geom));
-            if (CPLGetLastErrorType() != CE_None || geom_new == nullptr) {
-                if (!bSkipFailures) {
-                    ret = OGRERR_FAILURE;
-                    goto done;
-                } else {
-                    CPLErrorReset();
-                    ret = OGRERR_NONE;
-                }
-            } else {
-                geom.swap(geom_new);
-                if (geom->IsEmpty())
-                {
-                    break;
-                }
-            }
-        }
-
-        // add a new feature if there is remaining area
-        if (!geom->IsEmpty()) {
-            OGRFeatureUniquePtr z(new OGRFeature(poDefnResult));
-            z->SetFieldsFrom(x.get(), mapInput);
-            if( bPromoteToMulti )
-                geom.reset(promote_to_multi(geom.release()));
-            z->SetGeometryDirectly(geom.release());
-            ret = pLayerResult->CreateFeature(z.get());
-            if (ret != OGRERR_NONE) {
-                if (!bSkipFailures) {
-                    goto done;
-                } else {
-                    CPLErrorReset();
-                    ret = OGRERR_NONE;
-                }
-            }
-        }
-    }
-    if (pfnProgress && !pfnProgress(1.0, "", pProgressArg)) {
-      CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-      ret = OGRERR_FAILURE;
-      goto done;
-    }
-done:
-    // release resources
-    pLayerMethod->SetSpatialFilter(pGeometryMethodFilter);
-    if (pGeometryMethodFilter) delete pGeometryMethodFilter;
-    if (mapInput) VSIFree(mapInput);
-    return ret;
-}
-
-/************************************************************************/
-/*                           OGR_L_Erase()                              */
-/************************************************************************/
+/************************************************************************/
+/*                           OGR_L_Erase()                              */
+/************************************************************************/
 
 /**
  * \brief Remove areas that are covered by the method layer.
@@ -4362,6 +4824,8 @@ done:
  *     will be created from the fields of the input layer.
  * <li>METHOD_PREFIX=string. Set a prefix for the field names that
  *     will be created from the fields of the method layer.
+ * <li>USE_SPATIAL_INDEX=YES/NO and NUM_THREADS=number/ALL_CPUS
+ *     (GDAL >= 3.7). See \ref OGRLayer_overlay_options.
  * </ul>
  *
  * This function is the same as the C++ method OGRLayer::Erase().
@@ -6338,6 +6802,708 @@ bool OGR_L_GetArrowStream(OGRLayerH hLayer,
     return OGRLayer::FromHandle(hLayer)->GetArrowStream(out_stream, papszOptions);
 }
 
+/************************************************************************/
+/*                     GetArrowExtensionName()                          */
+/************************************************************************/
+
+// Returns the value of the ARROW:extension:name key of a schema metadata,
+// or an empty string.
+static std::string GetArrowExtensionName(const char* pabyMetadata)
+{
+    if( pabyMetadata == nullptr )
+        return std::string();
+    int32_t nKeys = 0;
+    memcpy(&nKeys, pabyMetadata, sizeof(int32_t));
+    size_t nOffset = sizeof(int32_t);
+    for( int32_t i = 0; i < nKeys; ++i )
+    {
+        int32_t nKeyLen = 0;
+        memcpy(&nKeyLen, pabyMetadata + nOffset, sizeof(int32_t));
+        nOffset += sizeof(int32_t);
+        if( nKeyLen < 0 )
+            break;
+        const std::string osKey(pabyMetadata + nOffset, nKeyLen);
+        nOffset += nKeyLen;
+        int32_t nValueLen = 0;
+        memcpy(&nValueLen, pabyMetadata + nOffset, sizeof(int32_t));
+        nOffset += sizeof(int32_t);
+        if( nValueLen < 0 )
+            break;
+        if( osKey == "ARROW:extension:name" )
+            return std::string(pabyMetadata + nOffset, nValueLen);
+        nOffset += nValueLen;
+    }
+    return std::string();
+}
+
+/************************************************************************/
+/*                       Arrow value accessors                          */
+/************************************************************************/
+
+// In all the following functions, nIdx is the index of the value in the
+// buffers of the array, that is it already includes psArray->offset.
+
+static inline bool IsArrowNull(const struct ArrowArray* psArray, int64_t nIdx)
+{
+    const uint8_t* pabyValidity =
+        static_cast<const uint8_t*>(psArray->buffers[0]);
+    return psArray->null_count != 0 && pabyValidity != nullptr &&
+           (pabyValidity[nIdx / 8] & (1 << (nIdx % 8))) == 0;
+}
+
+template<class T> static inline T GetArrowValue(
+                            const struct ArrowArray* psArray, int64_t nIdx)
+{
+    return static_cast<const T*>(psArray->buffers[1])[nIdx];
+}
+
+static bool IsArrowIntegerFormat(const char* pszFormat)
+{
+    return pszFormat[0] != '\0' && pszFormat[1] == '\0' &&
+           strchr("bcCsSiIlL", pszFormat[0]) != nullptr;
+}
+
+static bool IsArrowRealFormat(const char* pszFormat)
+{
+    return (pszFormat[0] == 'f' || pszFormat[0] == 'g') &&
+           pszFormat[1] == '\0';
+}
+
+static bool IsArrowBinaryFormat(const char* pszFormat)
+{
+    return ((pszFormat[0] == 'u' || pszFormat[0] == 'U' ||
+             pszFormat[0] == 'z' || pszFormat[0] == 'Z') &&
+            pszFormat[1] == '\0') ||
+           (pszFormat[0] == 'w' && pszFormat[1] == ':');
+}
+
+static bool IsArrowTemporalFormat(const char* pszFormat)
+{
+    return strcmp(pszFormat, "tdD") == 0 ||
+           strcmp(pszFormat, "tdm") == 0 ||
+           strcmp(pszFormat, "tts") == 0 ||
+           strcmp(pszFormat, "ttm") == 0 ||
+           strcmp(pszFormat, "ttu") == 0 ||
+           strcmp(pszFormat, "ttn") == 0 ||
+           (pszFormat[0] == 't' && pszFormat[1] == 's' &&
+            pszFormat[2] != '\0' && strchr("smun", pszFormat[2]) != nullptr &&
+            pszFormat[3] == ':');
+}
+
+static bool IsArrowListFormat(const char* pszFormat)
+{
+    return strcmp(pszFormat, "+l") == 0 || strcmp(pszFormat, "+L") == 0 ||
+           STARTS_WITH(pszFormat, "+w:");
+}
+
+static GIntBig GetArrowIntegerValue(const char* pszFormat,
+                                    const struct ArrowArray* psArray,
+                                    int64_t nIdx)
+{
+    switch( pszFormat[0] )
+    {
+        case 'b':
+        {
+            const uint8_t* pabyData =
+                static_cast<const uint8_t*>(psArray->buffers[1]);
+            return (pabyData[nIdx / 8] & (1 << (nIdx % 8))) != 0 ? 1 : 0;
+        }
+        case 'c': return GetArrowValue<int8_t>(psArray, nIdx);
+        case 'C': return GetArrowValue<uint8_t>(psArray, nIdx);
+        case 's': return GetArrowValue<int16_t>(psArray, nIdx);
+        case 'S': return GetArrowValue<uint16_t>(psArray, nIdx);
+        case 'i': return GetArrowValue<int32_t>(psArray, nIdx);
+        case 'I': return GetArrowValue<uint32_t>(psArray, nIdx);
+        case 'l': return GetArrowValue<int64_t>(psArray, nIdx);
+        case 'L':
+        {
+            const uint64_t nVal = GetArrowValue<uint64_t>(psArray, nIdx);
+            return nVal > static_cast<uint64_t>(
+                            std::numeric_limits<GIntBig>::max()) ?
+                std::numeric_limits<GIntBig>::max() :
+                static_cast<GIntBig>(nVal);
+        }
+        default:
+            break;
+    }
+    return 0;
+}
+
+static double GetArrowRealValue(const char* pszFormat,
+                                const struct ArrowArray* psArray,
+                                int64_t nIdx)
+{
+    if( pszFormat[0] == 'f' )
+        return GetArrowValue<float>(psArray, nIdx);
+    return GetArrowValue<double>(psArray, nIdx);
+}
+
+static const GByte* GetArrowBinaryValue(const char* pszFormat,
+                                        const struct ArrowArray* psArray,
+                                        int64_t nIdx,
+                                        size_t& nLen)
+{
+    if( pszFormat[0] == 'w' )
+    {
+        nLen = static_cast<size_t>(atoi(pszFormat + 2));
+        return static_cast<const GByte*>(psArray->buffers[1]) + nIdx * nLen;
+    }
+    const GByte* pabyData = static_cast<const GByte*>(psArray->buffers[2]);
+    if( pszFormat[0] == 'U' || pszFormat[0] == 'Z' )
+    {
+        const int64_t* panOffsets =
+            static_cast<const int64_t*>(psArray->buffers[1]);
+        nLen = static_cast<size_t>(panOffsets[nIdx + 1] - panOffsets[nIdx]);
+        return pabyData + panOffsets[nIdx];
+    }
+    const int32_t* panOffsets =
+        static_cast<const int32_t*>(psArray->buffers[1]);
+    nLen = static_cast<size_t>(panOffsets[nIdx + 1] - panOffsets[nIdx]);
+    return pabyData + panOffsets[nIdx];
+}
+
+static void GetArrowListRange(const char* pszFormat,
+                              const struct ArrowArray* psArray,
+                              int64_t nIdx,
+                              int64_t& nStart, int64_t& nEnd)
+{
+    if( pszFormat[1] == 'w' )
+    {
+        const int64_t nWidth = atoi(pszFormat + 3);
+        nStart = nIdx * nWidth;
+        nEnd = nStart + nWidth;
+    }
+    else if( pszFormat[1] == 'L' )
+    {
+        const int64_t* panOffsets =
+            static_cast<const int64_t*>(psArray->buffers[1]);
+        nStart = panOffsets[nIdx];
+        nEnd = panOffsets[nIdx + 1];
+    }
+    else
+    {
+        const int32_t* panOffsets =
+            static_cast<const int32_t*>(psArray->buffers[1]);
+        nStart = panOffsets[nIdx];
+        nEnd = panOffsets[nIdx + 1];
+    }
+}
+
+/************************************************************************/
+/*                     SetFieldFromArrowTemporal()                      */
+/************************************************************************/
+
+static void SetFieldFromArrowTemporal(OGRFeature* poFeature, int iField,
+                                      const char* pszFormat,
+                                      const struct ArrowArray* psArray,
+                                      int64_t nIdx)
+{
+    // Split the value in seconds since epoch (or midnight) and milliseconds
+    int64_t nVal = 0;
+    int64_t nUnitsPerSec = 1;
+    bool bDate = false;
+    bool bTime = false;
+    if( pszFormat[1] == 'd' )
+    {
+        bDate = true;
+        if( pszFormat[2] == 'D' )
+            nVal = static_cast<int64_t>(
+                        GetArrowValue<int32_t>(psArray, nIdx)) * 86400;
+        else
+        {
+            nVal = GetArrowValue<int64_t>(psArray, nIdx);
+            nUnitsPerSec = 1000;
+        }
+    }
+    else
+    {
+        bTime = pszFormat[1] == 't';
+        switch( pszFormat[2] )
+        {
+            case 'm': nUnitsPerSec = 1000; break;
+            case 'u': nUnitsPerSec = 1000 * 1000; break;
+            case 'n': nUnitsPerSec = 1000 * 1000 * 1000; break;
+            default: break;
+        }
+        if( bTime && nUnitsPerSec <= 1000 )
+            nVal = GetArrowValue<int32_t>(psArray, nIdx);
+        else
+            nVal = GetArrowValue<int64_t>(psArray, nIdx);
+    }
+
+    int nTZFlag = 0;
+    if( !bDate && !bTime )
+    {
+        const char* pszTZ = pszFormat + 4;
+        if( pszTZ[0] != '\0' )
+        {
+            nTZFlag = 100;
+            if( (pszTZ[0] == '+' || pszTZ[0] == '-') &&
+                strlen(pszTZ) == 6 && pszTZ[3] == ':' )
+            {
+                // Express the timestamp in its time zone.
+                const int nOffsetMin = (pszTZ[0] == '-' ? -1 : 1) *
+                    (atoi(pszTZ + 1) * 60 + atoi(pszTZ + 4));
+                nTZFlag += nOffsetMin / 15;
+                nVal += static_cast<int64_t>(nOffsetMin) * 60 * nUnitsPerSec;
+            }
+        }
+    }
+
+    int64_t nSecs = nVal / nUnitsPerSec;
+    int64_t nRemainder = nVal % nUnitsPerSec;
+    if( nRemainder < 0 )
+    {
+        nSecs --;
+        nRemainder += nUnitsPerSec;
+    }
+    const double dfFracSec =
+        static_cast<double>(nRemainder) / static_cast<double>(nUnitsPerSec);
+
+    if( bTime )
+    {
+        poFeature->SetField(iField, 0, 0, 0,
+                            static_cast<int>(nSecs / 3600),
+                            static_cast<int>((nSecs / 60) % 60),
+                            static_cast<float>(
+                                static_cast<double>(nSecs % 60) + dfFracSec));
+        return;
+    }
+
+    struct tm brokenDown;
+    CPLUnixTimeToYMDHMS(nSecs, &brokenDown);
+    if( bDate && nUnitsPerSec == 1 )
+    {
+        poFeature->SetField(iField, brokenDown.tm_year + 1900,
+                            brokenDown.tm_mon + 1, brokenDown.tm_mday);
+        return;
+    }
+    poFeature->SetField(iField, brokenDown.tm_year + 1900,
+                        brokenDown.tm_mon + 1, brokenDown.tm_mday,
+                        brokenDown.tm_hour, brokenDown.tm_min,
+                        static_cast<float>(brokenDown.tm_sec + dfFracSec),
+                        nTZFlag);
+}
+
+/************************************************************************/
+/*                        SetFieldFromArrowList()                       */
+/************************************************************************/
+
+static void SetFieldFromArrowList(OGRFeature* poFeature, int iField,
+                                  const struct ArrowSchema* psSchema,
+                                  const struct ArrowArray* psArray,
+                                  int64_t nIdx)
+{
+    int64_t nStart = 0;
+    int64_t nEnd = 0;
+    GetArrowListRange(psSchema->format, psArray, nIdx, nStart, nEnd);
+    const struct ArrowSchema* psItemSchema = psSchema->children[0];
+    const struct ArrowArray* psItemArray = psArray->children[0];
+    const char* pszItemFormat = psItemSchema->format;
+    const int nCount = static_cast<int>(nEnd - nStart);
+    nStart += psItemArray->offset;
+
+    const auto eType = poFeature->GetFieldDefnRef(iField)->GetType();
+    if( IsArrowIntegerFormat(pszItemFormat) )
+    {
+        if( eType == OFTIntegerList )
+        {
+            std::vector<int> anValues;
+            anValues.reserve(nCount);
+            for( int64_t i = nStart; i < nStart + nCount; ++i )
+                anValues.push_back(static_cast<int>(
+                    GetArrowIntegerValue(pszItemFormat, psItemArray, i)));
+            poFeature->SetField(iField, nCount, anValues.data());
+        }
+        else
+        {
+            std::vector<GIntBig> anValues;
+            anValues.reserve(nCount);
+            for( int64_t i = nStart; i < nStart + nCount; ++i )
+                anValues.push_back(
+                    GetArrowIntegerValue(pszItemFormat, psItemArray, i));
+            poFeature->SetField(iField, nCount, anValues.data());
+        }
+    }
+    else if( IsArrowRealFormat(pszItemFormat) )
+    {
+        std::vector<double> adfValues;
+        adfValues.reserve(nCount);
+        for( int64_t i = nStart; i < nStart + nCount; ++i )
+            adfValues.push_back(
+                GetArrowRealValue(pszItemFormat, psItemArray, i));
+        poFeature->SetField(iField, nCount, adfValues.data());
+    }
+    else
+    {
+        CPLStringList aosValues;
+        for( int64_t i = nStart; i < nStart + nCount; ++i )
+        {
+            size_t nLen = 0;
+            const GByte* pabyData =
+                GetArrowBinaryValue(pszItemFormat, psItemArray, i, nLen);
+            aosValues.AddString(std::string(
+                reinterpret_cast<const char*>(pabyData), nLen).c_str());
+        }
+        poFeature->SetField(iField, aosValues.List());
+    }
+}
+
+/************************************************************************/
+/*                      SetFieldFromArrowValue()                        */
+/************************************************************************/
+
+static void SetFieldFromArrowValue(OGRFeature* poFeature, int iField,
+                                   const struct ArrowSchema* psSchema,
+                                   const struct ArrowArray* psArray,
+                                   int64_t nIdx)
+{
+    const char* pszFormat = psSchema->format;
+    const auto eType = poFeature->GetFieldDefnRef(iField)->GetType();
+
+    if( psSchema->dictionary != nullptr )
+    {
+        // Integer fields, typically with a coded field domain, get the
+        // index. Other fields get the value it points to.
+        const GIntBig nDictIdx =
+            GetArrowIntegerValue(pszFormat, psArray, nIdx);
+        if( eType == OFTInteger || eType == OFTInteger64 )
+        {
+            poFeature->SetField(iField, nDictIdx);
+            return;
+        }
+        const struct ArrowArray* psDict = psArray->dictionary;
+        const int64_t nDictValueIdx = nDictIdx + psDict->offset;
+        if( IsArrowNull(psDict, nDictValueIdx) )
+        {
+            poFeature->SetFieldNull(iField);
+            return;
+        }
+        pszFormat = psSchema->dictionary->format;
+        psArray = psDict;
+        nIdx = nDictValueIdx;
+    }
+
+    if( IsArrowIntegerFormat(pszFormat) )
+    {
+        poFeature->SetField(iField,
+                            GetArrowIntegerValue(pszFormat, psArray, nIdx));
+    }
+    else if( IsArrowRealFormat(pszFormat) )
+    {
+        poFeature->SetField(iField,
+                            GetArrowRealValue(pszFormat, psArray, nIdx));
+    }
+    else if( IsArrowBinaryFormat(pszFormat) )
+    {
+        size_t nLen = 0;
+        const GByte* pabyData =
+            GetArrowBinaryValue(pszFormat, psArray, nIdx, nLen);
+        if( eType == OFTBinary )
+        {
+            poFeature->SetField(iField, static_cast<int>(nLen), pabyData);
+        }
+        else
+        {
+            poFeature->SetField(iField, std::string(
+                reinterpret_cast<const char*>(pabyData), nLen).c_str());
+        }
+    }
+    else if( IsArrowTemporalFormat(pszFormat) )
+    {
+        SetFieldFromArrowTemporal(poFeature, iField, pszFormat, psArray, nIdx);
+    }
+    else
+    {
+        CPLAssert(IsArrowListFormat(pszFormat));
+        SetFieldFromArrowList(poFeature, iField, psSchema, psArray, nIdx);
+    }
+}
+
+/************************************************************************/
+/*                    IsSupportedArrowFieldSchema()                     */
+/************************************************************************/
+
+static bool IsSupportedArrowFieldSchema(const struct ArrowSchema* psSchema)
+{
+    const char* pszFormat = psSchema->format;
+    if( psSchema->dictionary != nullptr )
+    {
+        const char* pszDictFormat = psSchema->dictionary->format;
+        return IsArrowIntegerFormat(pszFormat) &&
+               (IsArrowIntegerFormat(pszDictFormat) ||
+                IsArrowRealFormat(pszDictFormat) ||
+                IsArrowBinaryFormat(pszDictFormat));
+    }
+    if( IsArrowListFormat(pszFormat) )
+    {
+        if( psSchema->n_children != 1 )
+            return false;
+        const char* pszItemFormat = psSchema->children[0]->format;
+        return psSchema->children[0]->dictionary == nullptr &&
+               (IsArrowIntegerFormat(pszItemFormat) ||
+                IsArrowRealFormat(pszItemFormat) ||
+                IsArrowBinaryFormat(pszItemFormat));
+    }
+    return IsArrowIntegerFormat(pszFormat) ||
+           IsArrowRealFormat(pszFormat) ||
+           IsArrowBinaryFormat(pszFormat) ||
+           IsArrowTemporalFormat(pszFormat);
+}
+
+/************************************************************************/
+/*                     OGRLayer::WriteArrowBatch()                      */
+/************************************************************************/
+
+/** Write a batch of rows from an ArrowArray.
+ *
+ * This is semantically close to calling CreateFeature() with multiple
+ * features at once.
+ *
+ * The ArrowArray must be of type struct (format=+s), and its children
+ * generally map to a OGR attribute or geometry field, by name. The
+ * layer schema must have been set prior to calling this method (typically
+ * with CreateField() and CreateGeomField()): this method does not create
+ * fields.
+ *
+ * A child of the ArrowArray that is the FID column (see the FID option) sets
+ * the FID of the created features. Geometry fields must be encoded as WKB,
+ * with a binary Arrow format. A binary child is recognized as a geometry
+ * field when its name matches the name of a OGR geometry field, or when it
+ * has a ARROW:extension:name=ogc.wkb metadata item, in which case it is
+ * assigned to the first geometry field that is not already mapped.
+ *
+ * The array passed by the caller remains owned by it, and it must release
+ * it after this method returns. Drivers with a specialized implementation
+ * may however decide to take ownership of its content, in which case they
+ * set array->release to NULL, as mandated by the Arrow C data interface
+ * "move" semantics. Drivers that have a specialized implementation should
+ * advertise the OLCFastWriteArrowBatch capability.
+ *
+ * The default implementation builds a OGRFeature for each row and calls
+ * CreateFeature() on it. It recognizes the following options:
+ * <ul>
+ * <li>FID=name. Name of the Arrow column that contains the FID. Defaults to
+ *     the FID column name of the layer, or OGC_FID if the layer has no
+ *     FID column name and no attribute field of that name.</li>
+ * <li>GEOMETRY_NAME=name. Name of the Arrow column to use as the first
+ *     geometry field, when it does not match the name of a OGR geometry
+ *     field.</li>
+ * </ul>
+ *
+ * This method and CreateFeature() are mutually exclusive in the same session.
+ *
+ * This method is the same as the C function OGR_L_WriteArrowBatch().
+ *
+ * @param schema Schema of array. Must *not* be NULL.
+ * @param array Array of type struct. Must *not* be NULL.
+ * @param papszOptions NULL terminated list of key=value options.
+ * @return true in case of success.
+ * @since GDAL 3.7
+ */
+bool OGRLayer::WriteArrowBatch(const struct ArrowSchema* schema,
+                               struct ArrowArray* array,
+                               CSLConstList papszOptions)
+{
+    if( strcmp(schema->format, "+s") != 0 )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "WriteArrowBatch(): schema format is '%s' whereas '+s' "
+                 "is expected", schema->format);
+        return false;
+    }
+    if( schema->n_children != array->n_children )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "WriteArrowBatch(): schema and array have a different "
+                 "number of children");
+        return false;
+    }
+
+    auto poLayerDefn = GetLayerDefn();
+    const char* pszFIDName = CSLFetchNameValue(papszOptions, "FID");
+    if( pszFIDName == nullptr )
+    {
+        pszFIDName = GetFIDColumn();
+        if( pszFIDName[0] == '\0' &&
+            poLayerDefn->GetFieldIndex("OGC_FID") < 0 )
+            pszFIDName = "OGC_FID";
+    }
+    const char* pszGeomName = CSLFetchNameValue(papszOptions, "GEOMETRY_NAME");
+
+    struct Column
+    {
+        const struct ArrowSchema* psSchema = nullptr;
+        const struct ArrowArray* psArray = nullptr;
+        int iField = -1;
+        int iGeomField = -1;
+    };
+    std::vector<Column> aoColumns;
+    const struct ArrowArray* psFIDArray = nullptr;
+    const char* pszFIDFormat = nullptr;
+    std::vector<bool> abGeomFieldMapped(poLayerDefn->GetGeomFieldCount());
+
+    for( int64_t i = 0; i < schema->n_children; ++i )
+    {
+        const struct ArrowSchema* psChildSchema = schema->children[i];
+        const struct ArrowArray* psChildArray = array->children[i];
+        const char* pszName = psChildSchema->name ? psChildSchema->name : "";
+        const char* pszFormat = psChildSchema->format;
+
+        if( pszFIDName[0] != '\0' && strcmp(pszName, pszFIDName) == 0 &&
+            psChildSchema->dictionary == nullptr &&
+            IsArrowIntegerFormat(pszFormat) )
+        {
+            psFIDArray = psChildArray;
+            pszFIDFormat = pszFormat;
+            continue;
+        }
+
+        Column oColumn;
+        oColumn.psSchema = psChildSchema;
+        oColumn.psArray = psChildArray;
+
+        const bool bIsBinary = psChildSchema->dictionary == nullptr &&
+            (strcmp(pszFormat, "z") == 0 || strcmp(pszFormat, "Z") == 0);
+        if( bIsBinary )
+        {
+            oColumn.iGeomField = poLayerDefn->GetGeomFieldIndex(pszName);
+            if( oColumn.iGeomField < 0 &&
+                poLayerDefn->GetFieldIndex(pszName) < 0 &&
+                ((pszGeomName && strcmp(pszName, pszGeomName) == 0) ||
+                 GetArrowExtensionName(psChildSchema->metadata) == "ogc.wkb") )
+            {
+                for( int j = 0; j < poLayerDefn->GetGeomFieldCount(); ++j )
+                {
+                    if( !abGeomFieldMapped[j] )
+                    {
+                        oColumn.iGeomField = j;
+                        break;
+                    }
+                }
+            }
+            if( oColumn.iGeomField >= 0 )
+            {
+                if( abGeomFieldMapped[oColumn.iGeomField] )
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "WriteArrowBatch(): several Arrow columns map "
+                             "to geometry field %s",
+                             poLayerDefn->GetGeomFieldDefn(
+                                oColumn.iGeomField)->GetNameRef());
+                    return false;
+                }
+                abGeomFieldMapped[oColumn.iGeomField] = true;
+                aoColumns.push_back(oColumn);
+                continue;
+            }
+        }
+
+        oColumn.iField = poLayerDefn->GetFieldIndex(pszName);
+        if( oColumn.iField < 0 )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "WriteArrowBatch(): cannot find OGR field for "
+                     "Arrow column %s", pszName);
+            return false;
+        }
+        if( !IsSupportedArrowFieldSchema(psChildSchema) )
+        {
+            CPLError(CE_Failure, CPLE_NotSupported,
+                     "WriteArrowBatch(): Arrow column %s has unsupported "
+                     "format '%s'", pszName, pszFormat);
+            return false;
+        }
+        aoColumns.push_back(oColumn);
+    }
+
+    OGRFeatureUniquePtr poFeature(new OGRFeature(poLayerDefn));
+    for( int64_t iRow = 0; iRow < array->length; ++iRow )
+    {
+        const int64_t nRow = array->offset + iRow;
+        poFeature->Reset();
+        if( psFIDArray )
+        {
+            const int64_t nIdx = nRow + psFIDArray->offset;
+            if( !IsArrowNull(psFIDArray, nIdx) )
+            {
+                poFeature->SetFID(
+                    GetArrowIntegerValue(pszFIDFormat, psFIDArray, nIdx));
+            }
+        }
+
+        for( const auto& oColumn: aoColumns )
+        {
+            const int64_t nIdx = nRow + oColumn.psArray->offset;
+            if( oColumn.iGeomField >= 0 )
+            {
+                if( IsArrowNull(oColumn.psArray, nIdx) )
+                    continue;
+                size_t nLen = 0;
+                const GByte* pabyWKB = GetArrowBinaryValue(
+                    oColumn.psSchema->format, oColumn.psArray, nIdx, nLen);
+                OGRGeometry* poGeom = nullptr;
+                if( OGRGeometryFactory::createFromWkb(
+                        pabyWKB, nullptr, &poGeom, nLen, wkbVariantIso)
+                                                            != OGRERR_NONE )
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "WriteArrowBatch(): invalid WKB geometry at "
+                             "row " CPL_FRMT_GIB, static_cast<GIntBig>(iRow));
+                    return false;
+                }
+                poGeom->assignSpatialReference(
+                    poLayerDefn->GetGeomFieldDefn(oColumn.iGeomField)
+                                                        ->GetSpatialRef());
+                poFeature->SetGeomFieldDirectly(oColumn.iGeomField, poGeom);
+            }
+            else if( IsArrowNull(oColumn.psArray, nIdx) )
+            {
+                poFeature->SetFieldNull(oColumn.iField);
+            }
+            else
+            {
+                SetFieldFromArrowValue(poFeature.get(), oColumn.iField,
+                                       oColumn.psSchema, oColumn.psArray,
+                                       nIdx);
+            }
+        }
+
+        if( CreateFeature(poFeature.get()) != OGRERR_NONE )
+            return false;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                       OGR_L_WriteArrowBatch()                        */
+/************************************************************************/
+
+/** Write a batch of rows from an ArrowArray.
+ *
+ * See OGRLayer::WriteArrowBatch() for the details.
+ *
+ * @param hLayer Layer.
+ * @param schema Schema of array. Must *not* be NULL.
+ * @param array Array of type struct. Must *not* be NULL.
+ * @param papszOptions NULL terminated list of key=value options.
+ * @return true in case of success.
+ * @since GDAL 3.7
+ */
+bool OGR_L_WriteArrowBatch(OGRLayerH hLayer,
+                           const struct ArrowSchema* schema,
+                           struct ArrowArray* array,
+                           char** papszOptions)
+{
+    VALIDATE_POINTER1( hLayer, "OGR_L_WriteArrowBatch", false );
+    VALIDATE_POINTER1( schema, "OGR_L_WriteArrowBatch", false );
+    VALIDATE_POINTER1( array, "OGR_L_WriteArrowBatch", false );
+
+    return OGRLayer::FromHandle(hLayer)->WriteArrowBatch(schema, array,
+                                                         papszOptions);
+}
+
 /************************************************************************/
 /*                     OGRLayer::GetGeometryTypes()                     */
 /************************************************************************/
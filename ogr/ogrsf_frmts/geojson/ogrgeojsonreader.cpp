@@ -41,6 +41,8 @@
 #include "cpl_json_streaming_parser.h"
 #include "ogr_api.h"
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 
 static
@@ -108,10 +110,33 @@ class OGRGeoJSONReaderStreamingParser: public CPLJSonStreamingParser
         std::vector<std::unique_ptr<OGRFieldDefn>> m_apoFieldDefn{};
         gdal::DirectedAcyclicGraph<int, std::string> m_dag{};
 
+        // When reading features (second pass), the members of the
+        // "properties" object are directly translated to the fields of
+        // m_poCurFeature, instead of being ingested in the json-c object
+        // of the feature.
+        bool m_bDirectProperties = false;
+        bool m_bInDirectProperties = false;
+        OGRFeature* m_poCurFeature = nullptr;
+        CPLString m_osCurPropName{};
+        int m_nCurPropField = -1;
+        // Index of the current member in "properties", and field indices
+        // of the members of the previous feature, since features generally
+        // have their properties in the same order.
+        size_t m_nCurPropIdx = 0;
+        std::vector<int> m_anPrevPropFields{};
+        // Root of the value of the current member of "properties", when it
+        // is an object or an array.
+        json_object* m_poCurPropValue = nullptr;
+
         void AppendObject(json_object* poNewObj);
         void AnalyzeFeature();
         void TooComplex();
 
+        inline bool IsAtPropertyValue() const
+            { return m_bInDirectProperties && m_nDepth == 4; }
+        void SetPropertyValue(json_object* poVal);
+        bool SetPropertyNumber(const char* pszValue);
+
         CPL_DISALLOW_COPY_ASSIGN(OGRGeoJSONReaderStreamingParser)
 
     public:
@@ -330,6 +355,10 @@ OGRGeoJSONReaderStreamingParser::OGRGeoJSONReaderStreamingParser(
 {
     const double dfTmp = CPLAtof(CPLGetConfigOption("OGR_GEOJSON_MAX_OBJ_SIZE", "200"));
     m_nMaxObjectSize = dfTmp > 0 ? static_cast<size_t>(dfTmp * 1024 * 1024) : 0;
+
+    m_bDirectProperties = !m_bFirstPass &&
+                          !m_oReader.IsGeocouchSpatiallistFormat() &&
+        CPLTestBool(CPLGetConfigOption("OGR_GEOJSON_DIRECT_PROPERTIES", "YES"));
 }
 
 /************************************************************************/
@@ -342,6 +371,9 @@ OGRGeoJSONReaderStreamingParser::~OGRGeoJSONReaderStreamingParser()
         json_object_put(m_poRootObj);
     if( m_poCurObj && m_poCurObj != m_poRootObj )
         json_object_put(m_poCurObj);
+    if( m_poCurPropValue )
+        json_object_put(m_poCurPropValue);
+    delete m_poCurFeature;
     for(size_t i = 0; i < m_apoFeatures.size(); i++ )
         delete m_apoFeatures[i];
 }
@@ -399,6 +431,102 @@ void OGRGeoJSONReaderStreamingParser::AppendObject(json_object* poNewObj)
     }
 }
 
+/************************************************************************/
+/*                         IsNumericFieldType()                         */
+/************************************************************************/
+
+static bool IsNumericFieldType(OGRFieldType eType)
+{
+    return eType == OFTInteger || eType == OFTInteger64 || eType == OFTReal ||
+           eType == OFTIntegerList || eType == OFTInteger64List ||
+           eType == OFTRealList;
+}
+
+/************************************************************************/
+/*                         SetPropertyValue()                           */
+/************************************************************************/
+
+// Translate the value of the current member of "properties" to the
+// corresponding field of m_poCurFeature. Takes ownership of poVal.
+void OGRGeoJSONReaderStreamingParser::SetPropertyValue(json_object* poVal)
+{
+    if( !m_oReader.bAttributesSkip_ )
+    {
+        if( m_nCurPropField < 0 &&
+            !( m_oReader.bFlattenNestedAttributes_ && poVal != nullptr &&
+               json_object_get_type(poVal) == json_type_object) )
+        {
+            CPLDebug("GeoJSON", "Cannot find field %s",
+                     m_osCurPropName.c_str());
+        }
+        else
+        {
+            OGRGeoJSONReaderSetField(m_poLayer, m_poCurFeature,
+                                     m_nCurPropField,
+                                     m_osCurPropName.c_str(), poVal,
+                                     m_oReader.bFlattenNestedAttributes_,
+                                     m_oReader.chNestedAttributeSeparator_);
+        }
+    }
+    if( poVal )
+        json_object_put(poVal);
+}
+
+/************************************************************************/
+/*                         SetPropertyNumber()                          */
+/************************************************************************/
+
+// Fast path of SetPropertyValue() for a number value and a numeric field.
+// Returns false if the generic path must be used.
+bool OGRGeoJSONReaderStreamingParser::SetPropertyNumber(const char* pszValue)
+{
+    if( m_oReader.bAttributesSkip_ )
+        return true;
+    if( m_nCurPropField < 0 )
+        return false;
+
+    const OGRFieldDefn* poFieldDefn =
+        m_poCurFeature->GetFieldDefnRef(m_nCurPropField);
+    const OGRFieldType eType = poFieldDefn->GetType();
+    const CPLValueType eValueType = CPLGetValueType(pszValue);
+    if( eType == OFTReal && eValueType == CPL_VALUE_REAL )
+    {
+        m_poCurFeature->SetField(m_nCurPropField, CPLAtof(pszValue));
+    }
+    else if( eValueType != CPL_VALUE_INTEGER )
+    {
+        return false;
+    }
+    else if( eType == OFTReal )
+    {
+        m_poCurFeature->SetField(m_nCurPropField,
+                                 static_cast<double>(CPLAtoGIntBig(pszValue)));
+    }
+    else if( eType == OFTInteger || eType == OFTInteger64 )
+    {
+        GIntBig nVal = CPLAtoGIntBig(pszValue);
+        if( eType == OFTInteger )
+        {
+            // Same clamping as json_object_get_int()
+            nVal = std::max<GIntBig>(std::numeric_limits<int>::min(),
+                       std::min<GIntBig>(std::numeric_limits<int>::max(), nVal));
+            m_poCurFeature->SetField(m_nCurPropField, static_cast<int>(nVal));
+        }
+        else
+        {
+            m_poCurFeature->SetField(m_nCurPropField, nVal);
+        }
+
+        if( EQUAL( poFieldDefn->GetNameRef(), m_poLayer->GetFIDColumn() ) )
+            m_poCurFeature->SetFID(nVal);
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                          AnalyzeFeature()                            */
 /************************************************************************/
@@ -447,9 +575,25 @@ void OGRGeoJSONReaderStreamingParser::StartObject()
 
         m_nCurObjMemEstimate += ESTIMATE_OBJECT_SIZE;
 
-        json_object* poNewObj = json_object_new_object();
-        AppendObject( poNewObj );
-        m_apoCurObj.push_back( poNewObj );
+        if( m_bDirectProperties && m_bInFeaturesArray && m_nDepth == 3 &&
+            m_bKeySet && m_osCurKey == "properties" )
+        {
+            m_osCurKey.clear();
+            m_bKeySet = false;
+            m_bInDirectProperties = true;
+            m_nCurPropIdx = 0;
+            if( m_poCurFeature == nullptr )
+                m_poCurFeature = new OGRFeature(m_poLayer->GetLayerDefn());
+        }
+        else
+        {
+            json_object* poNewObj = json_object_new_object();
+            if( IsAtPropertyValue() )
+                m_poCurPropValue = poNewObj;
+            else
+                AppendObject( poNewObj );
+            m_apoCurObj.push_back( poNewObj );
+        }
     }
     else if( m_bFirstPass && m_nDepth == 0 )
     {
@@ -502,7 +646,9 @@ void OGRGeoJSONReaderStreamingParser::EndObject()
         else
         {
             OGRFeature* poFeat = m_oReader.ReadFeature(m_poLayer, m_poCurObj,
-                                                       m_osJson.c_str());
+                                                       m_osJson.c_str(),
+                                                       m_poCurFeature);
+            m_poCurFeature = nullptr;
             if( poFeat )
             {
                 m_apoFeatures.push_back( poFeat );
@@ -527,7 +673,20 @@ void OGRGeoJSONReaderStreamingParser::EndObject()
             m_osJson += "}";
         }
 
-        m_apoCurObj.pop_back();
+        if( m_bInDirectProperties && m_nDepth == 3 )
+        {
+            m_bInDirectProperties = false;
+        }
+        else
+        {
+            m_apoCurObj.pop_back();
+            if( IsAtPropertyValue() )
+            {
+                json_object* poVal = m_poCurPropValue;
+                m_poCurPropValue = nullptr;
+                SetPropertyValue(poVal);
+            }
+        }
     }
     else if( m_nDepth == 1 )
     {
@@ -602,8 +761,33 @@ void OGRGeoJSONReaderStreamingParser::StartObjectMember(const char* pszKey,
         }
 
         m_nCurObjMemEstimate += ESTIMATE_OBJECT_ELT_SIZE;
-        m_osCurKey.assign(pszKey, nKeyLen);
-        m_bKeySet = true;
+        if( IsAtPropertyValue() )
+        {
+            m_osCurPropName.assign(pszKey, nKeyLen);
+            const OGRFeatureDefn* poFDefn = m_poCurFeature->GetDefnRef();
+            if( m_nCurPropIdx < m_anPrevPropFields.size() &&
+                m_anPrevPropFields[m_nCurPropIdx] >= 0 &&
+                strcmp(poFDefn->GetFieldDefn(
+                        m_anPrevPropFields[m_nCurPropIdx])->GetNameRef(),
+                       pszKey) == 0 )
+            {
+                m_nCurPropField = m_anPrevPropFields[m_nCurPropIdx];
+            }
+            else
+            {
+                m_nCurPropField =
+                    poFDefn->GetFieldIndexCaseSensitive(m_osCurPropName);
+                if( m_nCurPropIdx >= m_anPrevPropFields.size() )
+                    m_anPrevPropFields.resize(m_nCurPropIdx + 1);
+                m_anPrevPropFields[m_nCurPropIdx] = m_nCurPropField;
+            }
+            m_nCurPropIdx ++;
+        }
+        else
+        {
+            m_osCurKey.assign(pszKey, nKeyLen);
+            m_bKeySet = true;
+        }
     }
 }
 
@@ -634,7 +818,10 @@ void OGRGeoJSONReaderStreamingParser::StartArray()
         m_nCurObjMemEstimate += ESTIMATE_ARRAY_SIZE;
 
         json_object* poNewObj = json_object_new_array();
-        AppendObject(poNewObj);
+        if( IsAtPropertyValue() )
+            m_poCurPropValue = poNewObj;
+        else
+            AppendObject(poNewObj);
         m_apoCurObj.push_back( poNewObj );
     }
     m_nDepth ++;
@@ -685,6 +872,12 @@ void OGRGeoJSONReaderStreamingParser::EndArray()
         }
 
         m_apoCurObj.pop_back();
+        if( IsAtPropertyValue() )
+        {
+            json_object* poVal = m_poCurPropValue;
+            m_poCurPropValue = nullptr;
+            SetPropertyValue(poVal);
+        }
     }
 }
 
@@ -719,7 +912,28 @@ void OGRGeoJSONReaderStreamingParser::String(const char* pszValue, size_t nLen)
         {
             m_osJson += CPLJSonStreamingParser::GetSerializedString(pszValue);
         }
-        AppendObject(json_object_new_string(pszValue));
+        if( IsAtPropertyValue() )
+        {
+            if( m_oReader.bAttributesSkip_ )
+            {
+                // nothing to do
+            }
+            else if( m_nCurPropField >= 0 &&
+                     !IsNumericFieldType(m_poCurFeature->
+                            GetFieldDefnRef(m_nCurPropField)->GetType()) )
+            {
+                // Same as OGRGeoJSONReaderSetField() for a string value
+                m_poCurFeature->SetField(m_nCurPropField, pszValue);
+            }
+            else
+            {
+                SetPropertyValue(json_object_new_string(pszValue));
+            }
+        }
+        else
+        {
+            AppendObject(json_object_new_string(pszValue));
+        }
     }
 }
 
@@ -754,29 +968,38 @@ void OGRGeoJSONReaderStreamingParser::Number(const char* pszValue, size_t nLen)
             m_osJson.append(pszValue, nLen);
         }
 
+        if( IsAtPropertyValue() && SetPropertyNumber(pszValue) )
+            return;
+
+        json_object* poNewObj;
         if( CPLGetValueType(pszValue) == CPL_VALUE_REAL )
         {
-            AppendObject(json_object_new_double(CPLAtof(pszValue)));
+            poNewObj = json_object_new_double(CPLAtof(pszValue));
         }
         else if( nLen == strlen("Infinity") && EQUAL(pszValue, "Infinity") )
         {
-            AppendObject(json_object_new_double(
-                std::numeric_limits<double>::infinity()));
+            poNewObj = json_object_new_double(
+                std::numeric_limits<double>::infinity());
         }
         else if( nLen == strlen("-Infinity") && EQUAL(pszValue, "-Infinity") )
         {
-            AppendObject(json_object_new_double(
-                -std::numeric_limits<double>::infinity()));
+            poNewObj = json_object_new_double(
+                -std::numeric_limits<double>::infinity());
         }
         else if( nLen == strlen("NaN") && EQUAL(pszValue, "NaN") )
         {
-            AppendObject(json_object_new_double(
-                std::numeric_limits<double>::quiet_NaN()));
+            poNewObj = json_object_new_double(
+                std::numeric_limits<double>::quiet_NaN());
         }
         else
         {
-            AppendObject(json_object_new_int64(CPLAtoGIntBig(pszValue)));
+            poNewObj = json_object_new_int64(CPLAtoGIntBig(pszValue));
         }
+
+        if( IsAtPropertyValue() )
+            SetPropertyValue(poNewObj);
+        else
+            AppendObject(poNewObj);
     }
 }
 
@@ -806,7 +1029,10 @@ void OGRGeoJSONReaderStreamingParser::Boolean(bool bVal)
             m_osJson += bVal ? "true": "false";
         }
 
-        AppendObject( json_object_new_boolean(bVal) );
+        if( IsAtPropertyValue() )
+            SetPropertyValue( json_object_new_boolean(bVal) );
+        else
+            AppendObject( json_object_new_boolean(bVal) );
     }
 }
 
@@ -830,7 +1056,10 @@ void OGRGeoJSONReaderStreamingParser::Null()
         }
 
         m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
-        AppendObject( nullptr );
+        if( IsAtPropertyValue() )
+            SetPropertyValue( nullptr );
+        else
+            AppendObject( nullptr );
     }
 }
 
@@ -2630,12 +2859,17 @@ void OGRGeoJSONReaderSetField( OGRLayer* poLayer,
 
 OGRFeature* OGRGeoJSONBaseReader::ReadFeature( OGRLayer* poLayer,
                                            json_object* poObj,
-                                           const char* pszSerializedObj )
+                                           const char* pszSerializedObj,
+                                           OGRFeature* poFeatureWithAttributes )
 {
     CPLAssert( nullptr != poObj );
 
     OGRFeatureDefn* poFDefn = poLayer->GetLayerDefn();
-    OGRFeature* poFeature = new OGRFeature( poFDefn );
+    // If poFeatureWithAttributes is provided, the members of "properties"
+    // have already been translated to it by the streaming parser, and
+    // "properties" is not present in poObj.
+    OGRFeature* poFeature = poFeatureWithAttributes ?
+                    poFeatureWithAttributes : new OGRFeature( poFDefn );
 
     if( bStoreNativeData_ )
     {
@@ -2649,7 +2883,8 @@ OGRFeature* OGRGeoJSONBaseReader::ReadFeature( OGRLayer* poLayer,
 /* -------------------------------------------------------------------- */
     CPLAssert( nullptr != poFeature );
 
-    json_object* poObjProps = OGRGeoJSONFindMemberByName( poObj, "properties" );
+    json_object* poObjProps = poFeatureWithAttributes ? nullptr :
+                        OGRGeoJSONFindMemberByName( poObj, "properties" );
     if( !bAttributesSkip_ && nullptr != poObjProps &&
         json_object_get_type(poObjProps) == json_type_object )
     {
@@ -2697,7 +2932,8 @@ OGRFeature* OGRGeoJSONBaseReader::ReadFeature( OGRLayer* poLayer,
         }
     }
 
-    if( !bAttributesSkip_ && nullptr == poObjProps )
+    if( !bAttributesSkip_ && nullptr == poObjProps &&
+        nullptr == poFeatureWithAttributes )
     {
         json_object_iter it;
         it.key = nullptr;
@@ -2775,10 +3011,10 @@ OGRFeature* OGRGeoJSONBaseReader::ReadFeature( OGRLayer* poLayer,
     }
     else
     {
-        static bool bWarned = false;
-        if( !bWarned )
+        // May be called concurrently by the GeoJSONSeq worker threads.
+        static std::atomic<bool> bWarned{false};
+        if( !bWarned.exchange(true) )
         {
-            bWarned = true;
             CPLDebug(
                 "GeoJSON",
                 "Non conformant Feature object. Missing \'geometry\' member.");
@@ -112,7 +112,11 @@ class OGRGeoJSONBaseReader
 
     OGRGeometry* ReadGeometry( json_object* poObj, OGRSpatialReference* poLayerSRS );
     OGRFeature* ReadFeature( OGRLayer* poLayer, json_object* poObj,
-                             const char* pszSerializedObj );
+                             const char* pszSerializedObj,
+                             OGRFeature* poFeatureWithAttributes = nullptr );
+
+    bool IsGeocouchSpatiallistFormat() const { return bIsGeocouchSpatiallistFormat; }
+
   protected:
     bool bGeometryPreserve_ = true;
     bool bAttributesSkip_ = false;
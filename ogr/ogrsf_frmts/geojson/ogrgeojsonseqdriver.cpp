@@ -30,13 +30,19 @@
 #include "cpl_vsi_virtual.h"
 #include "cpl_http.h"
 #include "cpl_vsi_error.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
 
 #include "ogr_geojson.h"
 #include "ogrgeojsonreader.h"
 #include "ogrgeojsonwriter.h"
 
 #include <algorithm>
+#include <deque>
 #include <memory>
+#include <string>
+#include <vector>
 
 
 constexpr char RS = '\x1e';
@@ -55,6 +61,7 @@ class OGRGeoJSONSeqDataSource final: public GDALDataset
         bool m_bSupportsRead = true;
         bool m_bAtEOF = false;
         bool m_bIsRSSeparated = false;
+        int m_nNumThreads = 1;
 
     public:
         OGRGeoJSONSeqDataSource();
@@ -102,7 +109,22 @@ class OGRGeoJSONSeqLayer final: public OGRLayer
         OGRGeometryFactory::TransformWithOptionsCache m_oTransformCache;
         OGRGeoJSONWriteOptions m_oWriteOptions;
 
+        bool GetNextRecord();
         json_object* GetNextObject(bool bLooseIdentification);
+        OGRFeature* TranslateObject(json_object* poObject,
+                                    const char* pszSerializedObj);
+        OGRFeature* GetNextUnfilteredFeature();
+
+        // When m_poDS->m_nNumThreads > 1, records are parsed by worker
+        // threads, both for the first pass that establishes the layer
+        // definition and for sequential reading.
+        struct ReadChunk;
+        std::deque<std::unique_ptr<OGRFeature>> m_apoPendingFeatures{};
+
+        static void ParseChunkJob(void* pData);
+        bool ParseNextChunks(bool bTranslate,
+                             std::vector<std::unique_ptr<ReadChunk>>& apoChunks);
+        OGRFeature* GetNextQueuedFeature();
 
     public:
         OGRGeoJSONSeqLayer(OGRGeoJSONSeqDataSource* poDS,
@@ -129,6 +151,32 @@ class OGRGeoJSONSeqLayer final: public OGRLayer
         OGRErr CreateField( OGRFieldDefn*, int ) override;
 };
 
+/************************************************************************/
+/*                              ReadChunk                               */
+/************************************************************************/
+
+struct OGRGeoJSONSeqLayer::ReadChunk
+{
+    OGRGeoJSONSeqLayer* poLayer = nullptr;
+    // Whether to translate records to features, or just parse them.
+    bool bTranslate = true;
+    std::vector<std::string> aosRecords{};
+    size_t nSize = 0;
+    std::vector<json_object*> apoObjects{};
+    std::vector<std::unique_ptr<OGRFeature>> apoFeatures{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+
+    ReadChunk() = default;
+    ReadChunk(const ReadChunk&) = delete;
+    ReadChunk& operator=(const ReadChunk&) = delete;
+
+    ~ReadChunk()
+    {
+        for( json_object* poObject: apoObjects )
+            json_object_put(poObject);
+    }
+};
+
 /************************************************************************/
 /*                       OGRGeoJSONSeqDataSource()                      */
 /************************************************************************/
@@ -325,27 +373,54 @@ bool OGRGeoJSONSeqLayer::Init(bool bLooseIdentification, bool bEstablishLayerDef
     gdal::DirectedAcyclicGraph<int, std::string> dag;
     bool bOK = false;
 
-    while( true )
+    if( bEstablishLayerDefn && !bLooseIdentification &&
+        m_poDS->m_nNumThreads > 1 )
     {
-        auto poObject = GetNextObject(bLooseIdentification);
-        if( !poObject )
-            break;
-        const auto eObjectType = OGRGeoJSONGetType(poObject);
-        if( bEstablishLayerDefn &&
-            eObjectType == GeoJSONObject::eFeature )
+        // Parse records on worker threads, and feed the resulting objects
+        // in order to GenerateFeatureDefn().
+        std::vector<std::unique_ptr<ReadChunk>> apoChunks;
+        while( ParseNextChunks(/* bTranslate = */ false, apoChunks) )
         {
-            m_oReader.GenerateFeatureDefn(oMapFieldNameToIdx,
-                                          apoFieldDefn,
-                                          dag,
-                                          this, poObject);
+            for( const auto& poChunk: apoChunks )
+            {
+                for( json_object* poObject: poChunk->apoObjects )
+                {
+                    if( OGRGeoJSONGetType(poObject) == GeoJSONObject::eFeature )
+                    {
+                        m_oReader.GenerateFeatureDefn(oMapFieldNameToIdx,
+                                                      apoFieldDefn,
+                                                      dag,
+                                                      this, poObject);
+                    }
+                    m_nTotalFeatures ++;
+                }
+            }
         }
-        json_object_put(poObject);
-        if( !bEstablishLayerDefn )
+    }
+    else
+    {
+        while( true )
         {
-            bOK = (eObjectType == GeoJSONObject::eFeature);
-            break;
+            auto poObject = GetNextObject(bLooseIdentification);
+            if( !poObject )
+                break;
+            const auto eObjectType = OGRGeoJSONGetType(poObject);
+            if( bEstablishLayerDefn &&
+                eObjectType == GeoJSONObject::eFeature )
+            {
+                m_oReader.GenerateFeatureDefn(oMapFieldNameToIdx,
+                                              apoFieldDefn,
+                                              dag,
+                                              this, poObject);
+            }
+            json_object_put(poObject);
+            if( !bEstablishLayerDefn )
+            {
+                bOK = (eObjectType == GeoJSONObject::eFeature);
+                break;
+            }
+            m_nTotalFeatures ++;
         }
-        m_nTotalFeatures ++;
     }
 
     if( bEstablishLayerDefn )
@@ -391,16 +466,20 @@ void OGRGeoJSONSeqLayer::ResetReading()
             static_cast<size_t>(100 * 1000 * 1000) : nBufferSize;
     m_osBuffer.resize(nBufferSizeValidated);
     m_osFeatureBuffer.clear();
+    m_apoPendingFeatures.clear();
     m_nPosInBuffer = nBufferSizeValidated;
     m_nBufferValidSize = nBufferSizeValidated;
     m_nNextFID = 0;
 }
 
 /************************************************************************/
-/*                           GetNextObject()                            */
+/*                           GetNextRecord()                            */
+/*                                                                      */
+/*      Extracts the text of the next non-empty record into             */
+/*      m_osFeatureBuffer.                                              */
 /************************************************************************/
 
-json_object* OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
+bool OGRGeoJSONSeqLayer::GetNextRecord()
 {
     m_osFeatureBuffer.clear();
     while( true )
@@ -410,7 +489,7 @@ json_object* OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
         {
             if( m_nBufferValidSize < m_osBuffer.size() )
             {
-                return nullptr;
+                return false;
             }
             m_nBufferValidSize = VSIFReadL(&m_osBuffer[0], 1,
                                            m_osBuffer.size(), m_poDS->m_fp);
@@ -434,7 +513,7 @@ json_object* OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
             }
             if( m_nPosInBuffer >= m_nBufferValidSize )
             {
-                return nullptr;
+                return false;
             }
         }
 
@@ -460,7 +539,7 @@ json_object* OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
                          "a value in megabytes (larger than %u) to allow "
                          "for larger features, or 0 to remove any size limit.",
                          static_cast<unsigned>(m_osFeatureBuffer.size() / 1024 / 1024));
-                return nullptr;
+                return false;
             }
             m_nPosInBuffer = m_nBufferValidSize;
             if( m_nBufferValidSize == m_osBuffer.size() )
@@ -477,72 +556,236 @@ json_object* OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
         }
         if( !m_osFeatureBuffer.empty() )
         {
-            json_object* poObject = nullptr;
-            CPL_IGNORE_RET_VAL(
-                OGRJSonParse(m_osFeatureBuffer.c_str(), &poObject));
-            m_osFeatureBuffer.clear();
-            if( json_object_get_type(poObject) == json_type_object )
-            {
-                return poObject;
-            }
-            json_object_put(poObject);
-            if( bLooseIdentification )
-            {
-                return nullptr;
-            }
+            return true;
         }
     }
 }
 
 /************************************************************************/
-/*                           GetNextFeature()                           */
+/*                           GetNextObject()                            */
 /************************************************************************/
 
-OGRFeature* OGRGeoJSONSeqLayer::GetNextFeature()
+json_object* OGRGeoJSONSeqLayer::GetNextObject(bool bLooseIdentification)
 {
-    if( !m_poDS->m_bSupportsRead )
+    while( GetNextRecord() )
+    {
+        // m_osFeatureBuffer is kept until the next record is read, as the
+        // serialized form of the returned object.
+        json_object* poObject = nullptr;
+        CPL_IGNORE_RET_VAL(
+            OGRJSonParse(m_osFeatureBuffer.c_str(), &poObject));
+        if( json_object_get_type(poObject) == json_type_object )
+        {
+            return poObject;
+        }
+        json_object_put(poObject);
+        if( bLooseIdentification )
+        {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                          TranslateObject()                           */
+/*                                                                      */
+/*      Returns nullptr for objects that must be skipped. This may be   */
+/*      called concurrently from several threads once the layer         */
+/*      definition is established.                                      */
+/************************************************************************/
+
+OGRFeature* OGRGeoJSONSeqLayer::TranslateObject(json_object* poObject,
+                                                const char* pszSerializedObj)
+{
+    const auto type = OGRGeoJSONGetType(poObject);
+    if( type == GeoJSONObject::eFeature )
+    {
+        return m_oReader.ReadFeature(this, poObject, pszSerializedObj);
+    }
+    if( type == GeoJSONObject::eFeatureCollection ||
+        type == GeoJSONObject::eUnknown )
     {
         return nullptr;
     }
-    if( m_bWriteOnlyLayer && m_poDS->m_apoLayers.size() > 1 )
+    OGRGeometry* poGeom = m_oReader.ReadGeometry(poObject, GetSpatialRef());
+    if( !poGeom )
     {
-        CPLError(CE_Failure, CPLE_NotSupported,
-                 "GetNextFeature() not supported when appending a new layer");
         return nullptr;
     }
+    OGRFeature* poFeature = new OGRFeature(m_poFeatureDefn);
+    poFeature->SetGeometryDirectly(poGeom);
+    return poFeature;
+}
 
-    GetLayerDefn(); // force scan if not already done
+/************************************************************************/
+/*                      GetNextUnfilteredFeature()                      */
+/************************************************************************/
+
+OGRFeature* OGRGeoJSONSeqLayer::GetNextUnfilteredFeature()
+{
     while( true )
     {
         auto poObject = GetNextObject(false);
         if( !poObject )
             return nullptr;
-        OGRFeature* poFeature;
-        auto type = OGRGeoJSONGetType(poObject);
-        if( type == GeoJSONObject::eFeature )
+        OGRFeature* poFeature =
+            TranslateObject(poObject, m_osFeatureBuffer.c_str());
+        json_object_put(poObject);
+        if( poFeature )
+            return poFeature;
+    }
+}
+
+/************************************************************************/
+/*                          ParseChunkJob()                             */
+/************************************************************************/
+
+void OGRGeoJSONSeqLayer::ParseChunkJob(void* pData)
+{
+    ReadChunk* psChunk = static_cast<ReadChunk*>(pData);
+
+    CPLInstallErrorHandlerAccumulator(psChunk->aoErrors);
+    CPLSetCurrentErrorHandlerCatchDebug( FALSE );
+
+    for( const std::string& osRecord: psChunk->aosRecords )
+    {
+        json_object* poObject = nullptr;
+        CPL_IGNORE_RET_VAL(OGRJSonParse(osRecord.c_str(), &poObject));
+        if( json_object_get_type(poObject) != json_type_object )
         {
-            poFeature = m_oReader.ReadFeature(
-                this, poObject, m_osFeatureBuffer.c_str() );
             json_object_put(poObject);
+            continue;
         }
-        else if( type == GeoJSONObject::eFeatureCollection ||
-                 type == GeoJSONObject::eUnknown )
+        if( psChunk->bTranslate )
         {
+            std::unique_ptr<OGRFeature> poFeature(
+                psChunk->poLayer->TranslateObject(poObject,
+                                                  osRecord.c_str()));
             json_object_put(poObject);
-            continue;
+            if( poFeature )
+                psChunk->apoFeatures.emplace_back(std::move(poFeature));
         }
         else
         {
-            OGRGeometry* poGeom = m_oReader.ReadGeometry(poObject,
-                                                         GetSpatialRef());
-            json_object_put(poObject);
-            if( !poGeom )
+            psChunk->apoObjects.push_back(poObject);
+        }
+    }
+    psChunk->aosRecords.clear();
+
+    CPLUninstallErrorHandlerAccumulator();
+}
+
+/************************************************************************/
+/*                          ParseNextChunks()                           */
+/*                                                                      */
+/*      Reads the next records, groups them in chunks of about          */
+/*      OGR_GEOJSONSEQ_THREAD_CHUNK_SIZE bytes, one per thread, and     */
+/*      parses them on worker threads. Chunks are submitted as soon as  */
+/*      they are complete, so that reading overlaps parsing. Errors     */
+/*      emitted by the workers are re-emitted in record order.          */
+/************************************************************************/
+
+bool OGRGeoJSONSeqLayer::ParseNextChunks(
+                        bool bTranslate,
+                        std::vector<std::unique_ptr<ReadChunk>>& apoChunks)
+{
+    apoChunks.clear();
+
+    // OGR_GEOJSONSEQ_THREAD_CHUNK_SIZE is only meant for tests, so that
+    // small files span several chunks.
+    const size_t nChunkSize = static_cast<size_t>(std::max(1, atoi(
+        CPLGetConfigOption("OGR_GEOJSONSEQ_THREAD_CHUNK_SIZE", "1048576"))));
+    const int nNumThreads = m_poDS->m_nNumThreads;
+
+    CPLWorkerThreadPool* poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if( !poQueue )
+        return false;
+
+    bool bEOF = false;
+    while( !bEOF && static_cast<int>(apoChunks.size()) < nNumThreads )
+    {
+        std::unique_ptr<ReadChunk> poChunk(new ReadChunk());
+        poChunk->poLayer = this;
+        poChunk->bTranslate = bTranslate;
+        while( poChunk->nSize < nChunkSize )
+        {
+            if( !GetNextRecord() )
             {
-                continue;
+                bEOF = true;
+                break;
             }
-            poFeature = new OGRFeature(m_poFeatureDefn);
-            poFeature->SetGeometryDirectly(poGeom);
+            poChunk->nSize += m_osFeatureBuffer.size();
+            poChunk->aosRecords.emplace_back(std::move(m_osFeatureBuffer));
+            m_osFeatureBuffer.clear();
         }
+        if( poChunk->aosRecords.empty() )
+            break;
+        poQueue->SubmitJob(ParseChunkJob, poChunk.get());
+        apoChunks.emplace_back(std::move(poChunk));
+    }
+    poQueue->WaitCompletion();
+
+    for( auto& poChunk: apoChunks )
+    {
+        for( const auto& oError: poChunk->aoErrors )
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+        poChunk->aoErrors.clear();
+    }
+
+    return !apoChunks.empty();
+}
+
+/************************************************************************/
+/*                        GetNextQueuedFeature()                        */
+/************************************************************************/
+
+OGRFeature* OGRGeoJSONSeqLayer::GetNextQueuedFeature()
+{
+    while( m_apoPendingFeatures.empty() )
+    {
+        std::vector<std::unique_ptr<ReadChunk>> apoChunks;
+        if( !ParseNextChunks(/* bTranslate = */ true, apoChunks) )
+            return nullptr;
+        for( auto& poChunk: apoChunks )
+        {
+            for( auto& poFeature: poChunk->apoFeatures )
+                m_apoPendingFeatures.emplace_back(std::move(poFeature));
+        }
+    }
+
+    OGRFeature* poFeature = m_apoPendingFeatures.front().release();
+    m_apoPendingFeatures.pop_front();
+    return poFeature;
+}
+
+/************************************************************************/
+/*                           GetNextFeature()                           */
+/************************************************************************/
+
+OGRFeature* OGRGeoJSONSeqLayer::GetNextFeature()
+{
+    if( !m_poDS->m_bSupportsRead )
+    {
+        return nullptr;
+    }
+    if( m_bWriteOnlyLayer && m_poDS->m_apoLayers.size() > 1 )
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "GetNextFeature() not supported when appending a new layer");
+        return nullptr;
+    }
+
+    GetLayerDefn(); // force scan if not already done
+    while( true )
+    {
+        OGRFeature* poFeature = m_poDS->m_nNumThreads > 1 ?
+            GetNextQueuedFeature() : GetNextUnfilteredFeature();
+        if( !poFeature )
+            return nullptr;
 
         if( poFeature->GetFID() == OGRNullFID )
         {
@@ -780,6 +1023,12 @@ bool OGRGeoJSONSeqDataSource::Open( GDALOpenInfo* poOpenInfo,
     {
         return false;
     }
+    m_nNumThreads = poOpenInfo->eAccess == GA_Update ? 1 :
+                        GDALGetNumThreads(poOpenInfo->papszOpenOptions);
+    if( m_nNumThreads > 1 )
+        CPLDebug("GeoJSONSeq", "Using %d threads to read %s",
+                 m_nNumThreads, poOpenInfo->pszFilename);
+
     SetDescription( poOpenInfo->pszFilename );
     auto poLayer = new OGRGeoJSONSeqLayer(this, osLayerName.c_str());
     const bool bLooseIdentification =
@@ -946,6 +1195,11 @@ void RegisterOGRGeoJSONSeq()
 "  </Option>"
 "</LayerCreationOptionList>");
 
+    poDriver->SetMetadataItem( GDAL_DMD_OPENOPTIONLIST,
+"<OpenOptionList>"
+"  <Option name='NUM_THREADS' type='string' description='Number of worker threads used to parse and translate records (integer or ALL_CPUS). Defaults to GDAL_NUM_THREADS, or 1'/>"
+"</OpenOptionList>");
+
     poDriver->SetMetadataItem( GDAL_DCAP_VIRTUALIO, "YES" );
     poDriver->SetMetadataItem( GDAL_DMD_CREATIONFIELDDATATYPES,
                                "Integer Integer64 Real String IntegerList "
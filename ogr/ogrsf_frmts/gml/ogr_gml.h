@@ -36,6 +36,7 @@
 #include "gmlreader.h"
 #include "gmlutils.h"
 
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -73,6 +74,24 @@ class OGRGMLLayer final: public OGRLayer
 
     bool                bFaceHoleNegative;
 
+    // When the data source has several threads, GML features are still
+    // parsed on the calling thread, but converted to OGR features by worker
+    // threads. The results are queued here in document order.
+    struct TranslateChunk;
+    std::deque<std::unique_ptr<OGRFeature>> m_apoPendingFeatures{};
+
+    GIntBig             GetNextFID( const char *pszGML_FID );
+    OGRFeature         *TranslateGMLFeature( const GMLFeature *poGMLFeature,
+                                             GIntBig nFID,
+                                             const char *pszSRSName,
+                                             void *hCacheSRSIn,
+                                             bool bApplySpatialFilter,
+                                             bool &bStop,
+                                             const std::vector<GMLPropertyType>*
+                                                paeFieldTypes = nullptr );
+    static void         TranslateChunkJob( void *pData );
+    bool                TranslateNextChunks();
+
   public:
                         OGRGMLLayer( const char * pszName,
                                      bool bWriter,
@@ -159,6 +178,8 @@ class OGRGMLDataSource final: public OGRDataSource
 
     bool                bEmptyAsNull;
 
+    int                 m_nNumThreads = 1;
+
     OGRSpatialReference m_oStandaloneGeomSRS{};
     std::unique_ptr<OGRGeometry> m_poStandaloneGeom{};
 
@@ -212,6 +233,7 @@ class OGRGMLDataSource final: public OGRDataSource
     bool                GetSecondaryGeometryOption() const { return m_bGetSecondaryGeometryOption; }
 
     ReadMode            GetReadMode() const { return eReadMode; }
+    int                 GetNumThreads() const { return m_nNumThreads; }
     void                SetStoredGMLFeature(GMLFeature* poStoredGMLFeatureIn) { poStoredGMLFeature = poStoredGMLFeatureIn; }
     GMLFeature*         PeekStoredGMLFeature() const { return  poStoredGMLFeature; }
 
@@ -44,6 +44,7 @@
 #include "cpl_http.h"
 #include "cpl_string.h"
 #include "cpl_vsi_error.h"
+#include "gdal_thread_pool.h"
 #include "gmlreaderp.h"
 #include "gmlregistry.h"
 #include "gmlutils.h"
@@ -597,6 +598,11 @@ bool OGRGMLDataSource::Open( GDALOpenInfo *poOpenInfo )
                  "Unrecognized value for GML_READ_MODE configuration option.");
     }
 
+    m_nNumThreads = GDALGetNumThreads(poOpenInfo->papszOpenOptions);
+    if( m_nNumThreads > 1 )
+        CPLDebug("GML", "Using %d threads to read %s",
+                 m_nNumThreads, pszFilename);
+
     m_bInvertAxisOrderIfLatLong = CPLTestBool(CSLFetchNameValueDef(
         poOpenInfo->papszOpenOptions, "INVERT_AXIS_ORDER_IF_LAT_LONG",
         CPLGetConfigOption("GML_INVERT_AXIS_ORDER_IF_LAT_LONG", "YES")));
@@ -191,6 +191,7 @@ void RegisterOGRGML()
 "  </Option>"
 "  <Option name='DOWNLOAD_SCHEMA' type='boolean' description='Whether to download the remote application schema if needed (only for WFS currently)' default='YES'/>"
 "  <Option name='REGISTRY' type='string' description='Filename of the registry with application schemas.'/>"
+"  <Option name='NUM_THREADS' type='string' description='Number of worker threads used to build geometries and translate features (integer or ALL_CPUS). Defaults to GDAL_NUM_THREADS, or 1'/>"
 "</OpenOptionList>" );
 
     poDriver->SetMetadataItem( GDAL_DMD_CREATIONOPTIONLIST,
@@ -34,6 +34,11 @@
 #include "cpl_string.h"
 #include "ogr_p.h"
 #include "ogr_api.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
+#include "gdal_thread_pool.h"
+
+#include <algorithm>
 
 
 /************************************************************************/
@@ -107,6 +112,7 @@ void OGRGMLLayer::ResetReading()
     }
 
     iNextGMLId = 0;
+    m_apoPendingFeatures.clear();
     poDS->GetReader()->ResetReading();
     CPLDebug("GML", "ResetReading()");
     if ( poDS->GetLayerCount() > 1 && poDS->GetReadMode() == STANDARD )
@@ -131,435 +137,644 @@ static GIntBig Increment(GIntBig nVal)
 }
 
 /************************************************************************/
-/*                           GetNextFeature()                           */
+/*                              GetNextFID()                            */
+/*                                                                      */
+/*      Extract the fid:                                                */
+/*      -Assumes the fids are non-negative integers with an optional    */
+/*       prefix                                                         */
+/*      -If a prefix differs from the prefix of the first feature from  */
+/*       the poDS then the fids from the poDS are ignored and are       */
+/*       assigned serially thereafter                                   */
 /************************************************************************/
 
-OGRFeature *OGRGMLLayer::GetNextFeature()
-
+GIntBig OGRGMLLayer::GetNextFID( const char *pszGML_FID )
 {
-    if (bWriter)
+    GIntBig nFID = -1;
+    if( bInvalidFIDFound )
     {
-        CPLError(CE_Failure, CPLE_NotSupported,
-                 "Cannot read features when writing a GML file");
-        return nullptr;
+        nFID = iNextGMLId;
+        iNextGMLId = Increment(iNextGMLId);
     }
-
-    if( poDS->GetLastReadLayer() != this )
+    else if( pszGML_FID == nullptr )
     {
-        if( poDS->GetReadMode() != INTERLEAVED_LAYERS )
-            ResetReading();
-        poDS->SetLastReadLayer(this);
+        bInvalidFIDFound = true;
+        nFID = iNextGMLId;
+        iNextGMLId = Increment(iNextGMLId);
     }
-
-/* ==================================================================== */
-/*      Loop till we find and translate a feature meeting all our       */
-/*      requirements.                                                   */
-/* ==================================================================== */
-    while( true )
+    else if( iNextGMLId == 0 )
     {
-        GMLFeature *poGMLFeature = poDS->PeekStoredGMLFeature();
-        if (poGMLFeature != nullptr)
+        int j = 0;
+        int i = static_cast<int>(strlen(pszGML_FID)) - 1;
+        while( i >= 0 && pszGML_FID[i] >= '0'
+                      && pszGML_FID[i] <= '9' && j < 20)
         {
-            poDS->SetStoredGMLFeature(nullptr);
+            i--;
+            j++;
         }
-        else
+        // i points the last character of the fid.
+        if( i >= 0 && j < 20 && pszFIDPrefix == nullptr)
         {
-            poGMLFeature = poDS->GetReader()->NextFeature();
-            if( poGMLFeature == nullptr )
-                return nullptr;
-
-            // We count reading low level GML features as a feature read for
-            // work checking purposes, though at least we didn't necessary
-            // have to turn it into an OGRFeature.
-            m_nFeaturesRead++;
+            pszFIDPrefix = static_cast<char *>(CPLMalloc(i + 2));
+            pszFIDPrefix[i + 1] = '\0';
+            strncpy(pszFIDPrefix, pszGML_FID, i + 1);
         }
-
-/* -------------------------------------------------------------------- */
-/*      Is it of the proper feature class?                              */
-/* -------------------------------------------------------------------- */
-
-        if( poGMLFeature->GetClass() != poFClass )
+        // pszFIDPrefix now contains the prefix or NULL if no prefix is
+        // found.
+        if( j < 20 && sscanf(pszGML_FID + i + 1, CPL_FRMT_GIB, &nFID) == 1)
         {
-            if( poDS->GetReadMode() == INTERLEAVED_LAYERS ||
-                (poDS->GetReadMode() == SEQUENTIAL_LAYERS && iNextGMLId != 0) )
-            {
-                CPLAssert(poDS->PeekStoredGMLFeature() == nullptr);
-                poDS->SetStoredGMLFeature(poGMLFeature);
-                return nullptr;
-            }
-            else
-            {
-                delete poGMLFeature;
-                continue;
-            }
+            if( iNextGMLId <= nFID )
+                iNextGMLId = Increment(nFID);
         }
-
-/* -------------------------------------------------------------------- */
-/*      Extract the fid:                                                */
-/*      -Assumes the fids are non-negative integers with an optional    */
-/*       prefix                                                         */
-/*      -If a prefix differs from the prefix of the first feature from  */
-/*       the poDS then the fids from the poDS are ignored and are       */
-/*       assigned serially thereafter                                   */
-/* -------------------------------------------------------------------- */
-        GIntBig nFID = -1;
-        const char *pszGML_FID = poGMLFeature->GetFID();
-        if( bInvalidFIDFound )
+        else
         {
+            bInvalidFIDFound = true;
             nFID = iNextGMLId;
             iNextGMLId = Increment(iNextGMLId);
         }
-        else if( pszGML_FID == nullptr )
+    }
+    else  // if( iNextGMLId != 0 ).
+    {
+        const char *pszFIDPrefix_notnull = pszFIDPrefix;
+        if (pszFIDPrefix_notnull == nullptr) pszFIDPrefix_notnull = "";
+        int nLenPrefix = static_cast<int>(strlen(pszFIDPrefix_notnull));
+
+        if( strncmp(pszGML_FID, pszFIDPrefix_notnull, nLenPrefix) == 0 &&
+            strlen(pszGML_FID + nLenPrefix) < 20 &&
+            sscanf(pszGML_FID + nLenPrefix, CPL_FRMT_GIB, &nFID) == 1 )
         {
+            // fid with the prefix. Using its numerical part.
+            if( iNextGMLId < nFID )
+                iNextGMLId = Increment(nFID);
+        }
+        else
+        {
+            // fid without the aforementioned prefix or a valid numerical
+            // part.
             bInvalidFIDFound = true;
             nFID = iNextGMLId;
             iNextGMLId = Increment(iNextGMLId);
         }
-        else if( iNextGMLId == 0 )
-        {
-            int j = 0;
-            int i = static_cast<int>(strlen(pszGML_FID)) - 1;
-            while( i >= 0 && pszGML_FID[i] >= '0'
-                          && pszGML_FID[i] <= '9' && j < 20)
-            {
-                i--;
-                j++;
-            }
-            // i points the last character of the fid.
-            if( i >= 0 && j < 20 && pszFIDPrefix == nullptr)
-            {
-                pszFIDPrefix = static_cast<char *>(CPLMalloc(i + 2));
-                pszFIDPrefix[i + 1] = '\0';
-                strncpy(pszFIDPrefix, pszGML_FID, i + 1);
-            }
-            // pszFIDPrefix now contains the prefix or NULL if no prefix is
-            // found.
-            if( j < 20 && sscanf(pszGML_FID + i + 1, CPL_FRMT_GIB, &nFID) == 1)
-            {
-                if( iNextGMLId <= nFID )
-                    iNextGMLId = Increment(nFID);
-            }
-            else
-            {
-                bInvalidFIDFound = true;
-                nFID = iNextGMLId;
-                iNextGMLId = Increment(iNextGMLId);
-            }
-        }
-        else  // if( iNextGMLId != 0 ).
-        {
-            const char *pszFIDPrefix_notnull = pszFIDPrefix;
-            if (pszFIDPrefix_notnull == nullptr) pszFIDPrefix_notnull = "";
-            int nLenPrefix = static_cast<int>(strlen(pszFIDPrefix_notnull));
+    }
 
-            if( strncmp(pszGML_FID, pszFIDPrefix_notnull, nLenPrefix) == 0 &&
-                strlen(pszGML_FID + nLenPrefix) < 20 &&
-                sscanf(pszGML_FID + nLenPrefix, CPL_FRMT_GIB, &nFID) == 1 )
-            {
-                // fid with the prefix. Using its numerical part.
-                if( iNextGMLId < nFID )
-                    iNextGMLId = Increment(nFID);
-            }
-            else
-            {
-                // fid without the aforementioned prefix or a valid numerical
-                // part.
-                bInvalidFIDFound = true;
-                nFID = iNextGMLId;
-                iNextGMLId = Increment(iNextGMLId);
-            }
-        }
+    return nFID;
+}
+
+/************************************************************************/
+/*                        TranslateGMLFeature()                         */
+/*                                                                      */
+/*      Builds the geometries and converts the properties of a GML      */
+/*      feature. Returns nullptr if the feature must be skipped, or if  */
+/*      reading must stop, in which case bStop is set. This does not    */
+/*      modify the layer state, so it may be called from worker         */
+/*      threads, provided each thread uses its own SRS cache, the       */
+/*      spatial filter is applied by the caller, and the property types */
+/*      are passed in paeFieldTypes: the GML reader may still update    */
+/*      the feature class while the workers run.                        */
+/************************************************************************/
+
+OGRFeature *OGRGMLLayer::TranslateGMLFeature( const GMLFeature *poGMLFeature,
+                                              GIntBig nFID,
+                                              const char *pszSRSName,
+                                              void *hCacheSRSIn,
+                                              bool bApplySpatialFilter,
+                                              bool &bStop,
+                                              const std::vector<GMLPropertyType>*
+                                                paeFieldTypes )
+{
+    bStop = false;
+    const char *pszGML_FID = poGMLFeature->GetFID();
 
 /* -------------------------------------------------------------------- */
 /*      Does it satisfy the spatial query, if there is one?             */
 /* -------------------------------------------------------------------- */
 
-        OGRGeometry **papoGeometries = nullptr;
-        const CPLXMLNode *const *papsGeometry = poGMLFeature->GetGeometryList();
+    OGRGeometry **papoGeometries = nullptr;
+    const CPLXMLNode *const *papsGeometry = poGMLFeature->GetGeometryList();
 
-        OGRGeometry *poGeom = nullptr;
+    OGRGeometry *poGeom = nullptr;
 
-        if( poFeatureDefn->GetGeomFieldCount() > 1 )
+    if( poFeatureDefn->GetGeomFieldCount() > 1 )
+    {
+        papoGeometries = static_cast<OGRGeometry **>(CPLCalloc(
+            poFeatureDefn->GetGeomFieldCount(), sizeof(OGRGeometry *)));
+        for( int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++ )
         {
-            papoGeometries = static_cast<OGRGeometry **>(CPLCalloc(
-                poFeatureDefn->GetGeomFieldCount(), sizeof(OGRGeometry *)));
-            const char *pszSRSName = poDS->GetGlobalSRSName();
-            for( int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++ )
+            const CPLXMLNode *psGeom = poGMLFeature->GetGeometryRef(i);
+            if( psGeom != nullptr )
             {
-                const CPLXMLNode *psGeom = poGMLFeature->GetGeometryRef(i);
-                if( psGeom != nullptr )
+                const CPLXMLNode *myGeometryList[2] = {psGeom, nullptr};
+                poGeom = GML_BuildOGRGeometryFromList(
+                    myGeometryList, true,
+                    poDS->GetInvertAxisOrderIfLatLong(), pszSRSName,
+                    poDS->GetConsiderEPSGAsURN(),
+                    poDS->GetSwapCoordinates(),
+                    poDS->GetSecondaryGeometryOption(), hCacheSRSIn,
+                    bFaceHoleNegative);
+
+                // Do geometry type changes if needed to match layer
+                // geometry type.
+                if (poGeom != nullptr)
                 {
-                    const CPLXMLNode *myGeometryList[2] = {psGeom, nullptr};
-                    poGeom = GML_BuildOGRGeometryFromList(
-                        myGeometryList, true,
-                        poDS->GetInvertAxisOrderIfLatLong(), pszSRSName,
-                        poDS->GetConsiderEPSGAsURN(),
-                        poDS->GetSwapCoordinates(),
-                        poDS->GetSecondaryGeometryOption(), hCacheSRS,
-                        bFaceHoleNegative);
-
-                    // Do geometry type changes if needed to match layer
-                    // geometry type.
-                    if (poGeom != nullptr)
-                    {
-                        papoGeometries[i] = OGRGeometryFactory::forceTo(
-                            poGeom,
-                            poFeatureDefn->GetGeomFieldDefn(i)->GetType());
-                        poGeom = nullptr;
-                    }
-                    else
+                    papoGeometries[i] = OGRGeometryFactory::forceTo(
+                        poGeom,
+                        poFeatureDefn->GetGeomFieldDefn(i)->GetType());
+                    poGeom = nullptr;
+                }
+                else
+                {
+                    // We assume the createFromGML() function would have
+                    // already reported the error.
+                    for(int j = 0; j < poFeatureDefn->GetGeomFieldCount();
+                        j++)
                     {
-                        // We assume the createFromGML() function would have
-                        // already reported the error.
-                        for(int j = 0; j < poFeatureDefn->GetGeomFieldCount();
-                            j++)
-                        {
-                            delete papoGeometries[j];
-                        }
-                        CPLFree(papoGeometries);
-                        delete poGMLFeature;
-                        return nullptr;
+                        delete papoGeometries[j];
                     }
+                    CPLFree(papoGeometries);
+                    bStop = true;
+                    return nullptr;
                 }
             }
+        }
 
-            if( m_poFilterGeom != nullptr &&
-                m_iGeomFieldFilter >= 0 &&
-                m_iGeomFieldFilter < poFeatureDefn->GetGeomFieldCount() &&
-                papoGeometries[m_iGeomFieldFilter] &&
-                !FilterGeometry( papoGeometries[m_iGeomFieldFilter] ) )
+        if( bApplySpatialFilter && m_poFilterGeom != nullptr &&
+            m_iGeomFieldFilter >= 0 &&
+            m_iGeomFieldFilter < poFeatureDefn->GetGeomFieldCount() &&
+            papoGeometries[m_iGeomFieldFilter] &&
+            !FilterGeometry( papoGeometries[m_iGeomFieldFilter] ) )
+        {
+            for( int j = 0; j < poFeatureDefn->GetGeomFieldCount(); j++ )
             {
-                for( int j = 0; j < poFeatureDefn->GetGeomFieldCount(); j++ )
-                {
-                    delete papoGeometries[j];
-                }
-                CPLFree(papoGeometries);
-                delete poGMLFeature;
-                continue;
+                delete papoGeometries[j];
             }
+            CPLFree(papoGeometries);
+            return nullptr;
         }
-        else if (papsGeometry[0] != nullptr)
+    }
+    else if (papsGeometry[0] != nullptr)
+    {
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        poGeom = GML_BuildOGRGeometryFromList(
+            papsGeometry, true,
+            poDS->GetInvertAxisOrderIfLatLong(),
+            pszSRSName,
+            poDS->GetConsiderEPSGAsURN(),
+            poDS->GetSwapCoordinates(),
+            poDS->GetSecondaryGeometryOption(),
+            hCacheSRSIn,
+            bFaceHoleNegative);
+        CPLPopErrorHandler();
+
+        // Do geometry type changes if needed to match layer geometry type.
+        if (poGeom != nullptr)
         {
-            const char *pszSRSName = poDS->GetGlobalSRSName();
-            CPLPushErrorHandler(CPLQuietErrorHandler);
-            poGeom = GML_BuildOGRGeometryFromList(
-                papsGeometry, true,
-                poDS->GetInvertAxisOrderIfLatLong(),
-                pszSRSName,
-                poDS->GetConsiderEPSGAsURN(),
-                poDS->GetSwapCoordinates(),
-                poDS->GetSecondaryGeometryOption(),
-                hCacheSRS,
-                bFaceHoleNegative);
-            CPLPopErrorHandler();
-
-            // Do geometry type changes if needed to match layer geometry type.
-            if (poGeom != nullptr)
-            {
-                poGeom = OGRGeometryFactory::forceTo(poGeom, GetGeomType());
-            }
-            else
-            {
-                const CPLString osLastErrorMsg(CPLGetLastErrorMsg());
-
-                const bool bGoOn = CPLTestBool(
-                    CPLGetConfigOption("GML_SKIP_CORRUPTED_FEATURES", "NO"));
-
-                CPLError(bGoOn ? CE_Warning : CE_Failure, CPLE_AppDefined,
-                         "Geometry of feature " CPL_FRMT_GIB
-                         " %scannot be parsed: %s%s",
-                         nFID, pszGML_FID ? CPLSPrintf("%s ", pszGML_FID) : "",
-                         osLastErrorMsg.c_str(),
-                         bGoOn ? ". Skipping to next feature.":
-                         ". You may set the GML_SKIP_CORRUPTED_FEATURES "
-                         "configuration option to YES to skip to the next "
-                         "feature");
-                delete poGMLFeature;
-                if( bGoOn )
-                    continue;
-                return nullptr;
-            }
+            poGeom = OGRGeometryFactory::forceTo(poGeom, GetGeomType());
+        }
+        else
+        {
+            const CPLString osLastErrorMsg(CPLGetLastErrorMsg());
+
+            const bool bGoOn = CPLTestBool(
+                CPLGetConfigOption("GML_SKIP_CORRUPTED_FEATURES", "NO"));
+
+            CPLError(bGoOn ? CE_Warning : CE_Failure, CPLE_AppDefined,
+                     "Geometry of feature " CPL_FRMT_GIB
+                     " %scannot be parsed: %s%s",
+                     nFID, pszGML_FID ? CPLSPrintf("%s ", pszGML_FID) : "",
+                     osLastErrorMsg.c_str(),
+                     bGoOn ? ". Skipping to next feature.":
+                     ". You may set the GML_SKIP_CORRUPTED_FEATURES "
+                     "configuration option to YES to skip to the next "
+                     "feature");
+            bStop = !bGoOn;
+            return nullptr;
+        }
 
-            if( m_poFilterGeom != nullptr && !FilterGeometry(poGeom) )
-            {
-                delete poGMLFeature;
-                delete poGeom;
-                continue;
-            }
+        if( bApplySpatialFilter && m_poFilterGeom != nullptr &&
+            !FilterGeometry(poGeom) )
+        {
+            delete poGeom;
+            return nullptr;
         }
+    }
 
 /* -------------------------------------------------------------------- */
 /*      Convert the whole feature into an OGRFeature.                   */
 /* -------------------------------------------------------------------- */
-        int iDstField = 0;
-        OGRFeature *poOGRFeature = new OGRFeature(poFeatureDefn);
+    int iDstField = 0;
+    OGRFeature *poOGRFeature = new OGRFeature(poFeatureDefn);
+
+    poOGRFeature->SetFID(nFID);
+    if (poDS->ExposeId())
+    {
+        if (pszGML_FID)
+            poOGRFeature->SetField(iDstField, pszGML_FID);
+        iDstField++;
+    }
+
+    const int nPropertyCount = paeFieldTypes ?
+        static_cast<int>(paeFieldTypes->size()) : poFClass->GetPropertyCount();
+    for( int iField = 0; iField < nPropertyCount; iField++, iDstField++ )
+    {
+        const GMLProperty *psGMLProperty =
+            poGMLFeature->GetProperty(iField);
+        if( psGMLProperty == nullptr || psGMLProperty->nSubProperties == 0 )
+            continue;
 
-        poOGRFeature->SetFID(nFID);
-        if (poDS->ExposeId())
+        if( EQUAL(psGMLProperty->papszSubProperties[0], OGR_GML_NULL) )
         {
-            if (pszGML_FID)
-                poOGRFeature->SetField(iDstField, pszGML_FID);
-            iDstField++;
+            poOGRFeature->SetFieldNull( iDstField );
+            continue;
         }
 
-        const int nPropertyCount = poFClass->GetPropertyCount();
-        for( int iField = 0; iField < nPropertyCount; iField++, iDstField++ )
+        switch( paeFieldTypes ? (*paeFieldTypes)[iField] :
+                                poFClass->GetProperty(iField)->GetType() )
         {
-            const GMLProperty *psGMLProperty =
-                poGMLFeature->GetProperty(iField);
-            if( psGMLProperty == nullptr || psGMLProperty->nSubProperties == 0 )
-                continue;
-
-            if( EQUAL(psGMLProperty->papszSubProperties[0], OGR_GML_NULL) )
-            {
-                poOGRFeature->SetFieldNull( iDstField );
-                continue;
-            }
-
-            switch( poFClass->GetProperty(iField)->GetType() )
-            {
-              case GMLPT_Real:
+          case GMLPT_Real:
+          {
+              poOGRFeature->SetField(
+                  iDstField, CPLAtof(psGMLProperty->papszSubProperties[0]));
+          }
+          break;
+
+          case GMLPT_IntegerList:
+          {
+              const int nCount = psGMLProperty->nSubProperties;
+              int *panIntList =
+                  static_cast<int *>(CPLMalloc(sizeof(int) * nCount));
+
+              for( int i = 0; i < nCount; i++ )
+                  panIntList[i] =
+                      atoi(psGMLProperty->papszSubProperties[i]);
+
+              poOGRFeature->SetField(iDstField, nCount, panIntList);
+              CPLFree(panIntList);
+          }
+          break;
+
+          case GMLPT_Integer64List:
+          {
+              const int nCount = psGMLProperty->nSubProperties;
+              GIntBig *panIntList = static_cast<GIntBig *>(
+                  CPLMalloc(sizeof(GIntBig) * nCount));
+
+              for( int i = 0; i < nCount; i++ )
+                  panIntList[i] =
+                      CPLAtoGIntBig(psGMLProperty->papszSubProperties[i]);
+
+              poOGRFeature->SetField(iDstField, nCount, panIntList);
+              CPLFree(panIntList);
+          }
+          break;
+
+          case GMLPT_RealList:
+          {
+              const int nCount = psGMLProperty->nSubProperties;
+              double *padfList = static_cast<double *>(
+                  CPLMalloc(sizeof(double) * nCount));
+
+              for( int i = 0; i < nCount; i++ )
+                  padfList[i] =
+                      CPLAtof(psGMLProperty->papszSubProperties[i]);
+
+              poOGRFeature->SetField(iDstField, nCount, padfList);
+              CPLFree(padfList);
+          }
+          break;
+
+          case GMLPT_StringList:
+          case GMLPT_FeaturePropertyList:
+          {
+              poOGRFeature->SetField(iDstField,
+                                     psGMLProperty->papszSubProperties);
+          }
+          break;
+
+          case GMLPT_Boolean:
+          {
+              if( strcmp(psGMLProperty->papszSubProperties[0],
+                         "true") == 0 ||
+                  strcmp(psGMLProperty->papszSubProperties[0], "1") == 0 )
+              {
+                  poOGRFeature->SetField(iDstField, 1);
+              }
+              else if( strcmp(psGMLProperty->papszSubProperties[0],
+                              "false") == 0 ||
+                       strcmp(psGMLProperty->papszSubProperties[0],
+                              "0") == 0 )
+              {
+                  poOGRFeature->SetField(iDstField, 0);
+              }
+              else
               {
                   poOGRFeature->SetField(
-                      iDstField, CPLAtof(psGMLProperty->papszSubProperties[0]));
+                      iDstField, psGMLProperty->papszSubProperties[0]);
               }
               break;
+          }
 
-              case GMLPT_IntegerList:
+          case GMLPT_BooleanList:
+          {
+              const int nCount = psGMLProperty->nSubProperties;
+              int *panIntList =
+                  static_cast<int *>(CPLMalloc(sizeof(int) * nCount));
+
+              for( int i = 0; i < nCount; i++ )
               {
-                  const int nCount = psGMLProperty->nSubProperties;
-                  int *panIntList =
-                      static_cast<int *>(CPLMalloc(sizeof(int) * nCount));
+                  panIntList[i] = (
+                      strcmp(psGMLProperty->papszSubProperties[i],
+                             "true") == 0 ||
+                      strcmp(psGMLProperty->papszSubProperties[i],
+                             "1") == 0 );
+              }
 
-                  for( int i = 0; i < nCount; i++ )
-                      panIntList[i] =
-                          atoi(psGMLProperty->papszSubProperties[i]);
+              poOGRFeature->SetField(iDstField, nCount, panIntList);
+              CPLFree(panIntList);
+              break;
+          }
 
-                  poOGRFeature->SetField(iDstField, nCount, panIntList);
-                  CPLFree(panIntList);
-              }
+          default:
+              poOGRFeature->SetField(iDstField,
+                                     psGMLProperty->papszSubProperties[0]);
               break;
+        }
+    }
 
-              case GMLPT_Integer64List:
-              {
-                  const int nCount = psGMLProperty->nSubProperties;
-                  GIntBig *panIntList = static_cast<GIntBig *>(
-                      CPLMalloc(sizeof(GIntBig) * nCount));
+    // Assign the geometry before the attribute filter because
+    // the attribute filter may use a special field like OGR_GEOMETRY.
+    if( papoGeometries != nullptr )
+    {
+        for( int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++ )
+        {
+            poOGRFeature->SetGeomFieldDirectly(i, papoGeometries[i]);
+        }
+        CPLFree(papoGeometries);
+        papoGeometries = nullptr;
+    }
+    else
+    {
+        poOGRFeature->SetGeometryDirectly(poGeom);
+    }
 
-                  for( int i = 0; i < nCount; i++ )
-                      panIntList[i] =
-                          CPLAtoGIntBig(psGMLProperty->papszSubProperties[i]);
+    // Assign SRS.
+    for( int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++ )
+    {
+        poGeom = poOGRFeature->GetGeomFieldRef(i);
+        if( poGeom != nullptr )
+        {
+            OGRSpatialReference *poSRS =
+                poFeatureDefn->GetGeomFieldDefn(i)->GetSpatialRef();
+            if (poSRS != nullptr)
+                poGeom->assignSpatialReference(poSRS);
+        }
+    }
 
-                  poOGRFeature->SetField(iDstField, nCount, panIntList);
-                  CPLFree(panIntList);
-              }
-              break;
+    return poOGRFeature;
+}
 
-              case GMLPT_RealList:
-              {
-                  const int nCount = psGMLProperty->nSubProperties;
-                  double *padfList = static_cast<double *>(
-                      CPLMalloc(sizeof(double) * nCount));
+/************************************************************************/
+/*                            TranslateChunk                            */
+/************************************************************************/
 
-                  for( int i = 0; i < nCount; i++ )
-                      padfList[i] =
-                          CPLAtof(psGMLProperty->papszSubProperties[i]);
+struct OGRGMLLayer::TranslateChunk
+{
+    OGRGMLLayer *poLayer = nullptr;
+    const char *pszSRSName = nullptr;
+    const std::vector<GMLPropertyType> *paeFieldTypes = nullptr;
+    std::vector<std::unique_ptr<GMLFeature>> apoGMLFeatures{};
+    std::vector<GIntBig> anFIDs{};
+    // A null feature means that reading must stop at that point.
+    std::vector<std::unique_ptr<OGRFeature>> apoFeatures{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors{};
+};
 
-                  poOGRFeature->SetField(iDstField, nCount, padfList);
-                  CPLFree(padfList);
-              }
-              break;
+/************************************************************************/
+/*                          TranslateChunkJob()                         */
+/************************************************************************/
 
-              case GMLPT_StringList:
-              case GMLPT_FeaturePropertyList:
-              {
-                  poOGRFeature->SetField(iDstField,
-                                         psGMLProperty->papszSubProperties);
-              }
-              break;
+void OGRGMLLayer::TranslateChunkJob( void *pData )
+{
+    TranslateChunk *psChunk = static_cast<TranslateChunk *>(pData);
 
-              case GMLPT_Boolean:
-              {
-                  if( strcmp(psGMLProperty->papszSubProperties[0],
-                             "true") == 0 ||
-                      strcmp(psGMLProperty->papszSubProperties[0], "1") == 0 )
-                  {
-                      poOGRFeature->SetField(iDstField, 1);
-                  }
-                  else if( strcmp(psGMLProperty->papszSubProperties[0],
-                                  "false") == 0 ||
-                           strcmp(psGMLProperty->papszSubProperties[0],
-                                  "0") == 0 )
-                  {
-                      poOGRFeature->SetField(iDstField, 0);
-                  }
-                  else
-                  {
-                      poOGRFeature->SetField(
-                          iDstField, psGMLProperty->papszSubProperties[0]);
-                  }
-                  break;
-              }
+    CPLInstallErrorHandlerAccumulator(psChunk->aoErrors);
+    CPLSetCurrentErrorHandlerCatchDebug( FALSE );
 
-              case GMLPT_BooleanList:
-              {
-                  const int nCount = psGMLProperty->nSubProperties;
-                  int *panIntList =
-                      static_cast<int *>(CPLMalloc(sizeof(int) * nCount));
-
-                  for( int i = 0; i < nCount; i++ )
-                  {
-                      panIntList[i] = (
-                          strcmp(psGMLProperty->papszSubProperties[i],
-                                 "true") == 0 ||
-                          strcmp(psGMLProperty->papszSubProperties[i],
-                                 "1") == 0 );
-                  }
-
-                  poOGRFeature->SetField(iDstField, nCount, panIntList);
-                  CPLFree(panIntList);
-                  break;
-              }
+    // The SRS cache is not thread-safe, so use one per job.
+    void *hCacheSRSJob = GML_BuildOGRGeometryFromList_CreateCache();
+    for( size_t i = 0; i < psChunk->apoGMLFeatures.size(); i++ )
+    {
+        bool bStop = false;
+        std::unique_ptr<OGRFeature> poOGRFeature(
+            psChunk->poLayer->TranslateGMLFeature(
+                psChunk->apoGMLFeatures[i].get(), psChunk->anFIDs[i],
+                psChunk->pszSRSName, hCacheSRSJob,
+                /* bApplySpatialFilter = */ false, bStop,
+                psChunk->paeFieldTypes));
+        psChunk->apoGMLFeatures[i].reset();
+        if( poOGRFeature || bStop )
+            psChunk->apoFeatures.emplace_back(std::move(poOGRFeature));
+    }
+    GML_BuildOGRGeometryFromList_DestroyCache(hCacheSRSJob);
+    psChunk->apoGMLFeatures.clear();
+
+    CPLUninstallErrorHandlerAccumulator();
+}
 
-              default:
-                  poOGRFeature->SetField(iDstField,
-                                         psGMLProperty->papszSubProperties[0]);
-                  break;
+/************************************************************************/
+/*                         TranslateNextChunks()                        */
+/*                                                                      */
+/*      Reads the next GML features of the layer on the calling thread, */
+/*      groups them in chunks of OGR_GML_THREAD_CHUNK_SIZE features,    */
+/*      one per thread, and translates them on worker threads. Chunks   */
+/*      are submitted as soon as they are complete, so that XML parsing */
+/*      overlaps geometry building. Translated features, and errors     */
+/*      emitted by the workers, are queued in document order.           */
+/************************************************************************/
+
+bool OGRGMLLayer::TranslateNextChunks()
+{
+    // Number of features per chunk. Tests lower it with
+    // OGR_GML_THREAD_CHUNK_SIZE to get many chunks out of small files.
+    const size_t nChunkSize = static_cast<size_t>(std::max(1, atoi(
+        CPLGetConfigOption("OGR_GML_THREAD_CHUNK_SIZE", "256"))));
+    const int nNumThreads = poDS->GetNumThreads();
+
+    CPLWorkerThreadPool *poThreadPool = GDALGetGlobalThreadPool(nNumThreads);
+    auto poQueue = poThreadPool ? poThreadPool->CreateJobQueue() : nullptr;
+    if( !poQueue )
+        return false;
+
+    // When the schema comes from a prescan, it is not locked, and parsing
+    // the next features may add properties to the class or change their
+    // type while the workers run. So give them a snapshot of the property
+    // types, that are the ones the layer definition was built from.
+    std::vector<GMLPropertyType> aeFieldTypes;
+    const int nPropertyCount = std::min(poFClass->GetPropertyCount(),
+        poFeatureDefn->GetFieldCount() - (poDS->ExposeId() ? 1 : 0));
+    for( int i = 0; i < nPropertyCount; i++ )
+        aeFieldTypes.push_back(poFClass->GetProperty(i)->GetType());
+
+    std::vector<std::unique_ptr<TranslateChunk>> apoChunks;
+    bool bEOF = false;
+    while( !bEOF && static_cast<int>(apoChunks.size()) < nNumThreads )
+    {
+        std::unique_ptr<TranslateChunk> poChunk(new TranslateChunk());
+        poChunk->poLayer = this;
+        poChunk->paeFieldTypes = &aeFieldTypes;
+        while( poChunk->apoGMLFeatures.size() < nChunkSize )
+        {
+            std::unique_ptr<GMLFeature> poGMLFeature(
+                poDS->GetReader()->NextFeature());
+            if( poGMLFeature == nullptr )
+            {
+                bEOF = true;
+                break;
             }
+            m_nFeaturesRead++;
+
+            if( poGMLFeature->GetClass() != poFClass )
+                continue;
+
+            poChunk->anFIDs.push_back(GetNextFID(poGMLFeature->GetFID()));
+            poChunk->apoGMLFeatures.emplace_back(std::move(poGMLFeature));
         }
+        if( poChunk->apoGMLFeatures.empty() )
+            break;
+        // The global SRS name is set at most once, while parsing the
+        // top of the document, so it can be safely shared afterwards.
+        poChunk->pszSRSName = poDS->GetGlobalSRSName();
+        poQueue->SubmitJob(TranslateChunkJob, poChunk.get());
+        apoChunks.emplace_back(std::move(poChunk));
+    }
+    poQueue->WaitCompletion();
 
-        delete poGMLFeature;
-        poGMLFeature = nullptr;
+    for( auto &poChunk: apoChunks )
+    {
+        for( const auto &oError: poChunk->aoErrors )
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+        }
+        for( auto &poOGRFeature: poChunk->apoFeatures )
+            m_apoPendingFeatures.emplace_back(std::move(poOGRFeature));
+    }
 
-        // Assign the geometry before the attribute filter because
-        // the attribute filter may use a special field like OGR_GEOMETRY.
-        if( papoGeometries != nullptr )
+    return !apoChunks.empty();
+}
+
+/************************************************************************/
+/*                           GetNextFeature()                           */
+/************************************************************************/
+
+OGRFeature *OGRGMLLayer::GetNextFeature()
+
+{
+    if (bWriter)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Cannot read features when writing a GML file");
+        return nullptr;
+    }
+
+    if( poDS->GetLastReadLayer() != this )
+    {
+        if( poDS->GetReadMode() != INTERLEAVED_LAYERS )
+            ResetReading();
+        poDS->SetLastReadLayer(this);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Multi-threaded translation. Only used in the STANDARD read      */
+/*      mode, where features of other layers are just skipped.          */
+/* -------------------------------------------------------------------- */
+    if( poDS->GetNumThreads() > 1 && poDS->GetReadMode() == STANDARD )
+    {
+        while( true )
         {
-            for( int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++ )
+            if( m_apoPendingFeatures.empty() && !TranslateNextChunks() )
+                return nullptr;
+            if( m_apoPendingFeatures.empty() )
+                continue;
+
+            std::unique_ptr<OGRFeature> poOGRFeature(
+                std::move(m_apoPendingFeatures.front()));
+            m_apoPendingFeatures.pop_front();
+            if( poOGRFeature == nullptr )
+                return nullptr;
+
+            if( m_poFilterGeom != nullptr &&
+                m_iGeomFieldFilter >= 0 &&
+                m_iGeomFieldFilter < poFeatureDefn->GetGeomFieldCount() )
             {
-                poOGRFeature->SetGeomFieldDirectly(i, papoGeometries[i]);
+                OGRGeometry *poGeom =
+                    poOGRFeature->GetGeomFieldRef(m_iGeomFieldFilter);
+                if( poGeom != nullptr && !FilterGeometry(poGeom) )
+                    continue;
             }
-            CPLFree(papoGeometries);
-            papoGeometries = nullptr;
+
+            if( m_poAttrQuery != nullptr &&
+                !m_poAttrQuery->Evaluate(poOGRFeature.get()) )
+                continue;
+
+            return poOGRFeature.release();
+        }
+    }
+
+/* ==================================================================== */
+/*      Loop till we find and translate a feature meeting all our       */
+/*      requirements.                                                   */
+/* ==================================================================== */
+    while( true )
+    {
+        GMLFeature *poGMLFeature = poDS->PeekStoredGMLFeature();
+        if (poGMLFeature != nullptr)
+        {
+            poDS->SetStoredGMLFeature(nullptr);
         }
         else
         {
-            poOGRFeature->SetGeometryDirectly(poGeom);
+            poGMLFeature = poDS->GetReader()->NextFeature();
+            if( poGMLFeature == nullptr )
+                return nullptr;
+
+            // We count reading low level GML features as a feature read for
+            // work checking purposes, though at least we didn't necessary
+            // have to turn it into an OGRFeature.
+            m_nFeaturesRead++;
         }
 
-        // Assign SRS.
-        for( int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++ )
+/* -------------------------------------------------------------------- */
+/*      Is it of the proper feature class?                              */
+/* -------------------------------------------------------------------- */
+
+        if( poGMLFeature->GetClass() != poFClass )
         {
-            poGeom = poOGRFeature->GetGeomFieldRef(i);
-            if( poGeom != nullptr )
+            if( poDS->GetReadMode() == INTERLEAVED_LAYERS ||
+                (poDS->GetReadMode() == SEQUENTIAL_LAYERS && iNextGMLId != 0) )
+            {
+                CPLAssert(poDS->PeekStoredGMLFeature() == nullptr);
+                poDS->SetStoredGMLFeature(poGMLFeature);
+                return nullptr;
+            }
+            else
             {
-                OGRSpatialReference *poSRS =
-                    poFeatureDefn->GetGeomFieldDefn(i)->GetSpatialRef();
-                if (poSRS != nullptr)
-                    poGeom->assignSpatialReference(poSRS);
+                delete poGMLFeature;
+                continue;
             }
         }
 
+        const GIntBig nFID = GetNextFID(poGMLFeature->GetFID());
+
+        bool bStop = false;
+        OGRFeature *poOGRFeature = TranslateGMLFeature(
+            poGMLFeature, nFID, poDS->GetGlobalSRSName(), hCacheSRS,
+            /* bApplySpatialFilter = */ true, bStop);
+        delete poGMLFeature;
+        if( poOGRFeature == nullptr )
+        {
+            if( bStop )
+                return nullptr;
+            continue;
+        }
+
 /* -------------------------------------------------------------------- */
 /*      Test against the attribute query.                               */
 /* -------------------------------------------------------------------- */
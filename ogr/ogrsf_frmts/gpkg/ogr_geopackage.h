@@ -39,6 +39,7 @@
 
 #include <condition_variable>
 #include <mutex>
+#include <queue>
 #include <vector>
 #include <set>
 #include <thread>
@@ -456,6 +457,8 @@ class OGRGeoPackageLayer CPL_NON_FINAL: public OGRLayer, public IOGRSQLiteGetSpa
                                            sqlite3_stmt *hStmt );
 
     OGRFeature*         TranslateFeature(sqlite3_stmt* hStmt);
+    bool                FilterGeometryBlob(sqlite3_stmt* hStmt,
+                                           bool& bPassesFilter);
     bool                ParseDateField(const char* pszTxt,
                                        OGRField* psField,
                                        const OGRFieldDefn* poFieldDefn,
@@ -588,6 +591,7 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     void                StartAsyncRTree();
     void                CancelAsyncRTree();
     void                AsyncRTreeThreadFunction();
+    bool                BuildPackedRTree(std::vector<GPKGRTreeEntry>& aoEntries);
 
     virtual OGRErr      ResetStatement() override;
 
@@ -626,8 +630,23 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
 
     std::thread         m_oThreadNextArrowArray{};
     std::unique_ptr<OGRGPKGTableLayerFillArrowArray> m_poFillArrowArray{};
-    std::unique_ptr<GDALGeoPackageDataset> m_poOtherDS{};
-    struct ArrowArray*  m_psNextArrayArray = nullptr;
+
+    // Fills the Arrow array of a range of feature ids, from a worker thread,
+    // using its own read-only connection to the file.
+    struct ArrowArrayPrefetchTask
+    {
+        std::thread         m_oThread{};
+        std::unique_ptr<GDALGeoPackageDataset> m_poDS{};
+        OGRGeoPackageTableLayer* m_poLayer = nullptr;
+        GIntBig             m_iStartShapeId = 0;
+        std::unique_ptr<struct ArrowArray> m_psArrowArray{};
+    };
+    std::queue<std::unique_ptr<ArrowArrayPrefetchTask>> m_oQueueArrowArrayPrefetchTasks{};
+    // Connections not used by a pending task, kept for the next ones
+    std::vector<std::unique_ptr<GDALGeoPackageDataset>> m_apoArrowArrayPrefetchDS{};
+    // Feature id after which the next prefetch task must start reading
+    GIntBig             m_iNextShapeIdPrefetch = 0;
+    bool                StartArrowArrayPrefetchTask(std::unique_ptr<ArrowArrayPrefetchTask>&& poTask);
     virtual int GetNextArrowArray(struct ArrowArrayStream*,
                                    struct ArrowArray* out_array) override;
     int                 GetNextArrowArrayInternal(struct ArrowArray* out_array);
@@ -662,6 +681,9 @@ class OGRGeoPackageTableLayer final : public OGRGeoPackageLayer
     OGRErr              ICreateFeature( OGRFeature *poFeature ) override;
     OGRErr              ISetFeature( OGRFeature *poFeature ) override;
     OGRErr              IUpsertFeature( OGRFeature* poFeature ) override;
+    bool                WriteArrowBatch(const struct ArrowSchema* schema,
+                                        struct ArrowArray* array,
+                                        CSLConstList papszOptions = nullptr) override;
     OGRErr              DeleteFeature(GIntBig nFID) override;
     virtual void        SetSpatialFilter( OGRGeometry * ) override;
     virtual void        SetSpatialFilter( int iGeomField, OGRGeometry *poGeom ) override
@@ -142,9 +142,23 @@ OGRFeature *OGRGeoPackageLayer::GetNextFeature()
             bDoStep = true;
         }
 
+        // Evaluate the spatial filter directly on the GeoPackage geometry
+        // blob, so that we do not build features that would be discarded.
+        bool bSpatialFilterEvaluated = false;
+        if( m_poFilterGeom != nullptr && iGeomCol >= 0 )
+        {
+            bool bPassesFilter = false;
+            if( FilterGeometryBlob(m_poQueryStatement, bPassesFilter) )
+            {
+                if( !bPassesFilter )
+                    continue;
+                bSpatialFilterEvaluated = true;
+            }
+        }
+
         OGRFeature *poFeature = TranslateFeature(m_poQueryStatement);
 
-        if( (m_poFilterGeom == nullptr
+        if( (m_poFilterGeom == nullptr || bSpatialFilterEvaluated
             || FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) ) )
             && (m_poAttrQuery == nullptr
                 || m_poAttrQuery->Evaluate( poFeature )) )
@@ -154,6 +168,54 @@ OGRFeature *OGRGeoPackageLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                        FilterGeometryBlob()                          */
+/************************************************************************/
+
+/** Evaluates the spatial filter on the geometry of the current row of hStmt,
+ * without building a OGRGeometry when possible.
+ *
+ * Returns false if the geometry is not a GeoPackage geometry blob (for
+ * example a SpatiaLite one), in which case bPassesFilter is not set.
+ */
+bool OGRGeoPackageLayer::FilterGeometryBlob(sqlite3_stmt* hStmt,
+                                            bool& bPassesFilter)
+{
+    if( sqlite3_column_type(hStmt, iGeomCol) == SQLITE_NULL )
+    {
+        bPassesFilter = false;
+        return true;
+    }
+
+    const int nGpkgSize = sqlite3_column_bytes(hStmt, iGeomCol);
+    // coverity[tainted_data_return]
+    const GByte *pabyGpkg = static_cast<const GByte *>(sqlite3_column_blob(hStmt, iGeomCol));
+    GPkgHeader oHeader;
+    if( pabyGpkg == nullptr ||
+        GPkgHeaderFromWKB(pabyGpkg, nGpkgSize, &oHeader) != OGRERR_NONE )
+    {
+        return false;
+    }
+    if( oHeader.bEmpty )
+    {
+        bPassesFilter = false;
+        return true;
+    }
+
+    OGREnvelope sEnvelope;
+    if( oHeader.bExtentHasXY )
+    {
+        sEnvelope.MinX = oHeader.MinX;
+        sEnvelope.MinY = oHeader.MinY;
+        sEnvelope.MaxX = oHeader.MaxX;
+        sEnvelope.MaxY = oHeader.MaxY;
+    }
+    bPassesFilter = FilterWKBGeometry(pabyGpkg + oHeader.nHeaderLen,
+                                      nGpkgSize - oHeader.nHeaderLen,
+                                      oHeader.bExtentHasXY, sEnvelope);
+    return true;
+}
+
 /************************************************************************/
 /*                         ParseDateField()                             */
 /************************************************************************/
@@ -609,15 +671,23 @@ int OGRGeoPackageLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
             auto psArray = out_array->children[iArrowField];
 
             size_t nWKBSize = 0;
-            if ( sqlite3_column_type(hStmt, iGeomCol) != SQLITE_NULL )
+            if ( sqlite3_column_type(hStmt, iGeomCol) == SQLITE_NULL )
+            {
+                if( m_poFilterGeom != nullptr )
+                {
+                    // Reuse the current slot for the next row
+                    iFeat --;
+                    continue;
+                }
+            }
+            else
             {
                 std::unique_ptr<OGRGeometry> poGeom;
                 const GByte *pabyWkb = nullptr;
                 const int iGpkgSize = sqlite3_column_bytes(hStmt, iGeomCol);
                 // coverity[tainted_data_return]
                 const GByte *pabyGpkg = static_cast<const GByte *>(sqlite3_column_blob(hStmt, iGeomCol));
-                if( m_poFilterGeom == nullptr &&
-                    iGpkgSize >= 8 && pabyGpkg && pabyGpkg[0] == 'G' && pabyGpkg[1] == 'P' )
+                if( iGpkgSize >= 8 && pabyGpkg && pabyGpkg[0] == 'G' && pabyGpkg[1] == 'P' )
                 {
                     GPkgHeader oHeader;
 
@@ -628,6 +698,27 @@ int OGRGeoPackageLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
                         /* WKB pointer */
                         pabyWkb = pabyGpkg + oHeader.nHeaderLen;
                         nWKBSize = iGpkgSize - oHeader.nHeaderLen;
+
+                        if( m_poFilterGeom != nullptr )
+                        {
+                            OGREnvelope sEnvelope;
+                            if( oHeader.bExtentHasXY )
+                            {
+                                sEnvelope.MinX = oHeader.MinX;
+                                sEnvelope.MinY = oHeader.MinY;
+                                sEnvelope.MaxX = oHeader.MaxX;
+                                sEnvelope.MaxY = oHeader.MaxY;
+                            }
+                            if( oHeader.bEmpty ||
+                                !FilterWKBGeometry(pabyWkb, nWKBSize,
+                                                   oHeader.bExtentHasXY,
+                                                   sEnvelope) )
+                            {
+                                // Reuse the current slot for the next row
+                                iFeat --;
+                                continue;
+                            }
+                        }
                     }
                 }
                 else
@@ -651,6 +742,8 @@ int OGRGeoPackageLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
                     if( m_poFilterGeom != nullptr &&
                         !FilterGeometry( poGeom.get() ) )
                     {
+                        // Reuse the current slot for the next row
+                        iFeat --;
                         continue;
                     }
                 }
@@ -829,6 +922,13 @@ int OGRGeoPackageLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
         }
     }
 
+    if( iFeat == 0 )
+    {
+        // All rows have been discarded by the spatial filter: signal end of
+        // stream rather than returning an empty batch.
+        sHelper.ClearArray();
+        return 0;
+    }
     sHelper.Shrink(iFeat);
 
     return 0;
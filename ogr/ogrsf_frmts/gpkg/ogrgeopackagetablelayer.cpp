@@ -1237,8 +1237,6 @@ OGRGeoPackageTableLayer::~OGRGeoPackageTableLayer()
         sqlite3_finalize(m_poGetFeatureStatement);
 
    CancelAsyncNextArrowArray();
-
-    delete m_psNextArrayArray;
 }
 
 /************************************************************************/
@@ -1261,10 +1259,14 @@ void OGRGeoPackageTableLayer::CancelAsyncNextArrowArray()
 
     m_poFillArrowArray.reset();
 
-    if( m_psNextArrayArray )
+    while( !m_oQueueArrowArrayPrefetchTasks.empty() )
     {
-        if( m_psNextArrayArray->release )
-            m_psNextArrayArray->release(m_psNextArrayArray);
+        auto poTask = std::move(m_oQueueArrowArrayPrefetchTasks.front());
+        m_oQueueArrowArrayPrefetchTasks.pop();
+        poTask->m_oThread.join();
+        if( poTask->m_psArrowArray->release )
+            poTask->m_psArrowArray->release(poTask->m_psArrowArray.get());
+        m_apoArrowArrayPrefetchDS.emplace_back(std::move(poTask->m_poDS));
     }
 }
 
@@ -2197,6 +2199,30 @@ OGRErr OGRGeoPackageTableLayer::ICreateFeature( OGRFeature *poFeature )
     return CreateOrUpsertFeature(poFeature, /* bUpsert=*/ false);
 }
 
+/************************************************************************/
+/*                          WriteArrowBatch()                           */
+/************************************************************************/
+
+bool OGRGeoPackageTableLayer::WriteArrowBatch(const struct ArrowSchema* schema,
+                                              struct ArrowArray* array,
+                                              CSLConstList papszOptions)
+{
+    // Insert the whole batch in a single transaction, so that the prepared
+    // INSERT statement is reused for all rows, and the spatial index update
+    // is deferred, instead of committing each row.
+    if( m_poDS->IsInTransaction() )
+        return OGRGeoPackageLayer::WriteArrowBatch(schema, array, papszOptions);
+
+    if( StartTransaction() != OGRERR_NONE )
+        return false;
+    if( !OGRGeoPackageLayer::WriteArrowBatch(schema, array, papszOptions) )
+    {
+        CPL_IGNORE_RET_VAL(RollbackTransaction());
+        return false;
+    }
+    return CommitTransaction() == OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                  SetDeferredSpatialIndexCreation()                   */
 /************************************************************************/
@@ -2206,7 +2232,13 @@ void OGRGeoPackageTableLayer::SetDeferredSpatialIndexCreation( bool bFlag )
     m_bDeferredSpatialIndexCreation = bFlag;
     if( bFlag )
     {
+        // When OGR_GPKG_PACKED_RTREE is set, a packed RTree is built by
+        // CreateSpatialIndex() once all features have been inserted, instead
+        // of inserting them in a RTree in a background thread.
+        const bool bPackedRTree =
+            CPLTestBool(CPLGetConfigOption("OGR_GPKG_PACKED_RTREE", "NO"));
         m_bAllowedRTreeThread =
+            !bPackedRTree &&
             sqlite3_threadsafe() != 0 &&
             CPLGetNumCPUs() >= 2 &&
             CPLTestBool(CPLGetConfigOption("OGR_GPKG_ALLOW_THREADED_RTREE", "YES"));
@@ -3410,6 +3442,250 @@ void OGRGeoPackageTableLayer::CreateSpatialIndexIfNecessary()
     }
 }
 
+/************************************************************************/
+/*                          BuildPackedRTree()                          */
+/************************************************************************/
+
+// Writes the nodes of a R-tree holding aoEntries directly into the shadow
+// tables (_node, _rowid and _parent) of the empty m_osRTreeName virtual table,
+// using the Sort-Tile-Recursive (STR) packing algorithm. This is much faster
+// than inserting entries one at a time, and results in fully packed nodes with
+// little overlap. The tree is built bottom-up, and the root node is node 1 as
+// expected by the SQLite R*Tree module, which stores the tree depth in its
+// first 2 bytes. Each cell is made of a 64 bit identifier and 4 floats,
+// all in big endian order.
+
+bool OGRGeoPackageTableLayer::BuildPackedRTree(std::vector<GPKGRTreeEntry>& aoEntries)
+{
+    if( aoEntries.empty() )
+        return true;
+
+    sqlite3* hDB = m_poDS->GetDB();
+
+    char* pszSQL = sqlite3_mprintf(
+        "SELECT length(data) FROM \"%w_node\" WHERE nodeno = 1",
+        m_osRTreeName.c_str());
+    OGRErr err = OGRERR_NONE;
+    const int nNodeSize = SQLGetInteger(hDB, pszSQL, &err);
+    sqlite3_free(pszSQL);
+    constexpr int CELL_SIZE = 8 + 4 * 4;
+    const int nMaxCells = (nNodeSize - 4) / CELL_SIZE;
+    if( err != OGRERR_NONE || nMaxCells < 2 )
+        return false;
+
+    // Nodes of each level, starting with the leaves. For a leaf, nFirstChild
+    // indexes aoEntries, otherwise the nodes of the level below.
+    struct PackedNode
+    {
+        size_t nFirstChild;
+        size_t nChildCount;
+        GPKGRTreeEntry sBBox;
+        GIntBig nNodeNo;
+    };
+    std::vector<std::vector<PackedNode>> aaoLevels;
+
+    // Sorts aoItems by the X center, cut them into vertical slices of
+    // nSliceSize items, sorts each slice by the Y center, and returns the
+    // nodes made of runs of nMaxCells consecutive items.
+    const auto PackLevel = [nMaxCells](std::vector<GPKGRTreeEntry>& aoItems)
+    {
+        const size_t nItems = aoItems.size();
+        const size_t nNodeCount = (nItems + nMaxCells - 1) / nMaxCells;
+        const size_t nSliceCount = static_cast<size_t>(
+            std::ceil(std::sqrt(static_cast<double>(nNodeCount))));
+        const size_t nSliceSize =
+            ((nNodeCount + nSliceCount - 1) / nSliceCount) * nMaxCells;
+
+        std::sort(aoItems.begin(), aoItems.end(),
+                  [](const GPKGRTreeEntry& a, const GPKGRTreeEntry& b)
+                  { return a.fMinX + a.fMaxX < b.fMinX + b.fMaxX; });
+        for( size_t i = 0; i < nItems; i += nSliceSize )
+        {
+            std::sort(aoItems.begin() + i,
+                      aoItems.begin() + std::min(nItems, i + nSliceSize),
+                      [](const GPKGRTreeEntry& a, const GPKGRTreeEntry& b)
+                      { return a.fMinY + a.fMaxY < b.fMinY + b.fMaxY; });
+        }
+
+        std::vector<PackedNode> aoNodes;
+        aoNodes.reserve(nNodeCount);
+        for( size_t i = 0; i < nItems; i += nMaxCells )
+        {
+            PackedNode sNode;
+            sNode.nFirstChild = i;
+            sNode.nChildCount = std::min(nItems - i, static_cast<size_t>(nMaxCells));
+            sNode.sBBox = aoItems[i];
+            for( size_t j = i + 1; j < i + sNode.nChildCount; ++j )
+            {
+                sNode.sBBox.fMinX = std::min(sNode.sBBox.fMinX, aoItems[j].fMinX);
+                sNode.sBBox.fMinY = std::min(sNode.sBBox.fMinY, aoItems[j].fMinY);
+                sNode.sBBox.fMaxX = std::max(sNode.sBBox.fMaxX, aoItems[j].fMaxX);
+                sNode.sBBox.fMaxY = std::max(sNode.sBBox.fMaxY, aoItems[j].fMaxY);
+            }
+            sNode.nNodeNo = 0;
+            aoNodes.push_back(sNode);
+        }
+        return aoNodes;
+    };
+
+    // Upper levels are packed from the bounding boxes of the nodes below,
+    // whose nId holds their index in the level, so that the level can be
+    // reordered to match the packing.
+    aaoLevels.emplace_back(PackLevel(aoEntries));
+    while( aaoLevels.back().size() > 1 )
+    {
+        const auto& aoChildren = aaoLevels.back();
+        std::vector<GPKGRTreeEntry> aoItems;
+        aoItems.reserve(aoChildren.size());
+        for( size_t i = 0; i < aoChildren.size(); ++i )
+        {
+            GPKGRTreeEntry sItem = aoChildren[i].sBBox;
+            sItem.nId = static_cast<GIntBig>(i);
+            aoItems.push_back(sItem);
+        }
+        auto aoParents = PackLevel(aoItems);
+
+        std::vector<PackedNode> aoReorderedChildren;
+        aoReorderedChildren.reserve(aoChildren.size());
+        for( const auto& sItem: aoItems )
+            aoReorderedChildren.push_back(aoChildren[static_cast<size_t>(sItem.nId)]);
+        aaoLevels.back() = std::move(aoReorderedChildren);
+        aaoLevels.emplace_back(std::move(aoParents));
+    }
+
+    // Node numbers: 1 for the root, and then level by level downwards.
+    GIntBig nNodeNo = 1;
+    for( size_t iLevel = aaoLevels.size(); iLevel > 0; )
+    {
+        --iLevel;
+        for( auto& sNode: aaoLevels[iLevel] )
+            sNode.nNodeNo = nNodeNo++;
+    }
+
+    pszSQL = sqlite3_mprintf("DELETE FROM \"%w_node\"", m_osRTreeName.c_str());
+    err = SQLCommand(hDB, pszSQL);
+    sqlite3_free(pszSQL);
+    if( err != OGRERR_NONE )
+        return false;
+
+    sqlite3_stmt* hInsertNodeStmt = nullptr;
+    sqlite3_stmt* hInsertRowidStmt = nullptr;
+    sqlite3_stmt* hInsertParentStmt = nullptr;
+    const auto Prepare = [hDB](const char* pszFormat, const std::string& osRTreeName,
+                               sqlite3_stmt** phStmt)
+    {
+        char* pszStmtSQL = sqlite3_mprintf(pszFormat, osRTreeName.c_str());
+        const bool bOK = sqlite3_prepare_v2(hDB, pszStmtSQL, -1, phStmt,
+                                            nullptr) == SQLITE_OK;
+        if( !bOK )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "failed to prepare SQL: %s: %s", pszStmtSQL,
+                      sqlite3_errmsg(hDB));
+        }
+        sqlite3_free(pszStmtSQL);
+        return bOK;
+    };
+    bool bRet =
+        Prepare("INSERT INTO \"%w_node\" (nodeno, data) VALUES (?,?)",
+                m_osRTreeName, &hInsertNodeStmt) &&
+        Prepare("INSERT INTO \"%w_rowid\" (rowid, nodeno) VALUES (?,?)",
+                m_osRTreeName, &hInsertRowidStmt) &&
+        Prepare("INSERT INTO \"%w_parent\" (nodeno, parentnode) VALUES (?,?)",
+                m_osRTreeName, &hInsertParentStmt);
+
+    const auto Step = [hDB](sqlite3_stmt* hStmt)
+    {
+        const int sqlite_err = sqlite3_step(hStmt);
+        sqlite3_reset(hStmt);
+        if( sqlite_err != SQLITE_OK && sqlite_err != SQLITE_DONE )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "failed to execute insertion in RTree : %s",
+                      sqlite3_errmsg(hDB) );
+            return false;
+        }
+        return true;
+    };
+
+    const auto WriteCell = [](GByte* pabyCell, GIntBig nId,
+                              const GPKGRTreeEntry& sBBox)
+    {
+        GUInt64 nVal = static_cast<GUInt64>(nId);
+        for( int i = 7; i >= 0; --i )
+        {
+            pabyCell[i] = static_cast<GByte>(nVal & 0xff);
+            nVal >>= 8;
+        }
+        const float afCoords[] = { sBBox.fMinX, sBBox.fMaxX,
+                                   sBBox.fMinY, sBBox.fMaxY };
+        for( int i = 0; i < 4; ++i )
+        {
+            GUInt32 nBits;
+            memcpy(&nBits, &afCoords[i], sizeof(nBits));
+            CPL_MSBPTR32(&nBits);
+            memcpy(pabyCell + 8 + 4 * i, &nBits, sizeof(nBits));
+        }
+    };
+
+    std::vector<GByte> abyNode(nNodeSize);
+    const int nDepth = static_cast<int>(aaoLevels.size()) - 1;
+    for( size_t iLevel = 0; bRet && iLevel < aaoLevels.size(); ++iLevel )
+    {
+        for( const auto& sNode: aaoLevels[iLevel] )
+        {
+            std::fill(abyNode.begin(), abyNode.end(), static_cast<GByte>(0));
+            if( sNode.nNodeNo == 1 )
+            {
+                abyNode[0] = static_cast<GByte>(nDepth >> 8);
+                abyNode[1] = static_cast<GByte>(nDepth & 0xff);
+            }
+            abyNode[2] = static_cast<GByte>(sNode.nChildCount >> 8);
+            abyNode[3] = static_cast<GByte>(sNode.nChildCount & 0xff);
+            for( size_t i = 0; bRet && i < sNode.nChildCount; ++i )
+            {
+                GByte* pabyCell = abyNode.data() + 4 + i * CELL_SIZE;
+                if( iLevel == 0 )
+                {
+                    const auto& sEntry = aoEntries[sNode.nFirstChild + i];
+                    WriteCell(pabyCell, sEntry.nId, sEntry);
+                    sqlite3_bind_int64(hInsertRowidStmt, 1, sEntry.nId);
+                    sqlite3_bind_int64(hInsertRowidStmt, 2, sNode.nNodeNo);
+                    bRet = Step(hInsertRowidStmt);
+                }
+                else
+                {
+                    const auto& sChild = aaoLevels[iLevel-1][sNode.nFirstChild + i];
+                    WriteCell(pabyCell, sChild.nNodeNo, sChild.sBBox);
+                    sqlite3_bind_int64(hInsertParentStmt, 1, sChild.nNodeNo);
+                    sqlite3_bind_int64(hInsertParentStmt, 2, sNode.nNodeNo);
+                    bRet = Step(hInsertParentStmt);
+                }
+            }
+            if( !bRet )
+                break;
+            sqlite3_bind_int64(hInsertNodeStmt, 1, sNode.nNodeNo);
+            sqlite3_bind_blob(hInsertNodeStmt, 2, abyNode.data(), nNodeSize,
+                              SQLITE_STATIC);
+            bRet = Step(hInsertNodeStmt);
+            if( !bRet )
+                break;
+        }
+    }
+
+    sqlite3_finalize(hInsertNodeStmt);
+    sqlite3_finalize(hInsertRowidStmt);
+    sqlite3_finalize(hInsertParentStmt);
+
+    if( bRet )
+    {
+        CPLDebug("GPKG", CPL_FRMT_GUIB " entries written into packed %s of depth %d",
+                 static_cast<GUIntBig>(aoEntries.size()),
+                 m_osRTreeName.c_str(), nDepth);
+    }
+    return bRet;
+}
+
 /************************************************************************/
 /*                       CreateSpatialIndex()                           */
 /************************************************************************/
@@ -3578,15 +3854,26 @@ bool OGRGeoPackageTableLayer::CreateSpatialIndex(const char* pszTableName)
         }
         sqlite3_free(pszSQL);
 
-        // Insert entries in RTree by chunks of 500K features
+        // Collect all entries to build a packed RTree, as long as they
+        // fit in a quarter of the RAM. Otherwise insert them in the RTree by
+        // chunks of 500K features
         std::vector<GPKGRTreeEntry> aoEntries;
         GUIntBig nEntryCount = 0;
         constexpr size_t nChunkSize = 500 * 1000;
+        bool bPackedRTree =
+            CPLTestBool(CPLGetConfigOption("OGR_GPKG_PACKED_RTREE", "NO"));
+        const GIntBig nUsableRAM = CPLGetUsablePhysicalRAM();
+        const size_t nMaxPackedEntries = nUsableRAM > 0 ?
+            static_cast<size_t>(std::min<GUIntBig>(
+                std::numeric_limits<size_t>::max() / sizeof(GPKGRTreeEntry),
+                static_cast<GUIntBig>(nUsableRAM) / 4 / sizeof(GPKGRTreeEntry))) :
+            nChunkSize;
 #ifdef ENABLE_GPKG_OGR_CONTENTS
         if( m_nTotalFeatureCount > 0 )
         {
             aoEntries.reserve(static_cast<size_t>(
-                std::min(m_nTotalFeatureCount, static_cast<GIntBig>(nChunkSize))));
+                std::min(m_nTotalFeatureCount, static_cast<GIntBig>(
+                    bPackedRTree ? nMaxPackedEntries : nChunkSize))));
         }
 #endif
         while( true )
@@ -3619,7 +3906,30 @@ bool OGRGeoPackageTableLayer::CreateSpatialIndex(const char* pszTableName)
                 return false;
             }
 
-            if( aoEntries.size() == nChunkSize || bFinished )
+            if( bPackedRTree && aoEntries.size() > nMaxPackedEntries )
+            {
+                CPLDebug("GPKG", "Too many features to build a packed RTree "
+                         "in memory. Inserting them progressively");
+                bPackedRTree = false;
+            }
+
+            if( bPackedRTree )
+            {
+                if( bFinished )
+                {
+                    sqlite3_finalize(hIterStmt);
+                    sqlite3_finalize(hInsertStmt);
+                    hIterStmt = nullptr;
+                    hInsertStmt = nullptr;
+                    if( !BuildPackedRTree(aoEntries) )
+                    {
+                        m_poDS->SoftRollbackTransaction();
+                        return false;
+                    }
+                    break;
+                }
+            }
+            else if( aoEntries.size() >= nChunkSize || bFinished )
             {
                 for( size_t i = 0; i < aoEntries.size(); ++i )
                 {
@@ -6545,6 +6855,28 @@ OGR_GPKG_FillArrowArray_Step(sqlite3_context* pContext, int /*argc*/, sqlite3_va
                     /* WKB pointer */
                     pabyWkb = pabyGpkg + oHeader.nHeaderLen;
                     nWKBSize = iGpkgSize - oHeader.nHeaderLen;
+
+                    // The R-Tree only filters on the bounding box. Refine
+                    // with the actual geometry, without instantiating it.
+                    auto poLayer = psFillArrowArray->poLayer;
+                    if( poLayer->m_poFilterGeom != nullptr )
+                    {
+                        OGREnvelope sEnvelope;
+                        if( oHeader.bExtentHasXY )
+                        {
+                            sEnvelope.MinX = oHeader.MinX;
+                            sEnvelope.MinY = oHeader.MinY;
+                            sEnvelope.MaxX = oHeader.MaxX;
+                            sEnvelope.MaxY = oHeader.MaxY;
+                        }
+                        if( oHeader.bEmpty ||
+                            !poLayer->FilterWKBGeometry(pabyWkb, nWKBSize,
+                                                        oHeader.bExtentHasXY,
+                                                        sEnvelope) )
+                        {
+                            return;
+                        }
+                    }
                 }
             }
 
@@ -6990,23 +7322,44 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
 
     // CPLDebug("GPKG", "iNextShapeId = " CPL_FRMT_GIB, iNextShapeId);
 
-    if( m_oThreadNextArrowArray.joinable() )
+    const int nMaxBatchSize = OGRArrowArrayHelper::GetMaxFeaturesInBatch(
+                                                m_aosArrowArrayStreamOptions);
+
+    // Batches are filled by worker threads, each one reading a range of
+    // feature ids with its own connection, and returned in order.
+    if( !m_oQueueArrowArrayPrefetchTasks.empty() )
     {
-        m_oThreadNextArrowArray.join();
-        if( m_psNextArrayArray->release )
-        {
-            iNextShapeId += m_psNextArrayArray->length;
-            memcpy(out_array, m_psNextArrayArray, sizeof(*m_psNextArrayArray));
+        auto poTask = std::move(m_oQueueArrowArrayPrefetchTasks.front());
+        m_oQueueArrowArrayPrefetchTasks.pop();
+        poTask->m_oThread.join();
 
-            memset(m_psNextArrayArray, 0, sizeof(*m_psNextArrayArray));
+        if( poTask->m_psArrowArray->release )
+        {
+            iNextShapeId = poTask->m_iStartShapeId + poTask->m_psArrowArray->length;
+            memcpy(out_array, poTask->m_psArrowArray.get(), sizeof(*out_array));
+            memset(poTask->m_psArrowArray.get(), 0, sizeof(*out_array));
 
+            // Reuse the connection of this task for the next range.
+            if( m_iNextShapeIdPrefetch < m_nTotalFeatureCount )
+            {
+                poTask->m_iStartShapeId = m_iNextShapeIdPrefetch;
+                if( StartArrowArrayPrefetchTask(std::move(poTask)) )
+                    m_iNextShapeIdPrefetch += nMaxBatchSize;
+            }
+            else
+            {
+                m_apoArrowArrayPrefetchDS.emplace_back(std::move(poTask->m_poDS));
+            }
             return 0;
         }
-    }
 
-    // Try to fetch the next ArrowArray in another thread
-    const int nMaxBatchSize = OGRArrowArrayHelper::GetMaxFeaturesInBatch(
-                                                m_aosArrowArrayStreamOptions);
+        // The worker failed. Cancel the other tasks, and read that range
+        // from the main connection.
+        iNextShapeId = poTask->m_iStartShapeId;
+        m_apoArrowArrayPrefetchDS.emplace_back(std::move(poTask->m_poDS));
+        CancelAsyncNextArrowArray();
+        return GetNextArrowArrayInternal(out_array);
+    }
 
     const auto GetThreadsAvailable = []()
     {
@@ -7016,70 +7369,105 @@ int OGRGeoPackageTableLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
         return atoi(pszMaxThreads);
     };
 
+    int nThreads;
     if( m_poDS->GetAccess() == GA_ReadOnly &&
         iNextShapeId + 2 * static_cast<GIntBig>(nMaxBatchSize) <= m_nTotalFeatureCount &&
-        (m_poOtherDS != nullptr ||
-         (sqlite3_threadsafe() != 0 && GetThreadsAvailable() >= 2)) )
+        sqlite3_threadsafe() != 0 &&
+        (nThreads = GetThreadsAvailable()) >= 2 )
+    {
+        // The calling thread reads the first batch, while nThreads - 1
+        // workers read the following ones.
+        const GIntBig nRemainingBatches =
+            (m_nTotalFeatureCount - iNextShapeId - 1) / nMaxBatchSize;
+        const int nTasks = static_cast<int>(
+            std::min<GIntBig>(nThreads - 1, nRemainingBatches));
+        m_iNextShapeIdPrefetch = iNextShapeId + nMaxBatchSize;
+        for( int i = 0; i < nTasks; ++i )
+        {
+            auto poTask = cpl::make_unique<ArrowArrayPrefetchTask>();
+            poTask->m_iStartShapeId = m_iNextShapeIdPrefetch;
+            if( !StartArrowArrayPrefetchTask(std::move(poTask)) )
+                break;
+            m_iNextShapeIdPrefetch += nMaxBatchSize;
+        }
+    }
+
+    return GetNextArrowArrayInternal(out_array);
+}
+
+/************************************************************************/
+/*                    StartArrowArrayPrefetchTask()                     */
+/************************************************************************/
+
+bool OGRGeoPackageTableLayer::StartArrowArrayPrefetchTask(
+                        std::unique_ptr<ArrowArrayPrefetchTask>&& poTask)
+{
+    if( poTask->m_poDS == nullptr )
     {
-        if( m_poOtherDS == nullptr )
+        if( !m_apoArrowArrayPrefetchDS.empty() )
         {
-            m_poOtherDS = cpl::make_unique<GDALGeoPackageDataset>();
+            poTask->m_poDS = std::move(m_apoArrowArrayPrefetchDS.back());
+            m_apoArrowArrayPrefetchDS.pop_back();
+        }
+        else
+        {
+            auto poOtherDS = cpl::make_unique<GDALGeoPackageDataset>();
             GDALOpenInfo oOpenInfo(m_poDS->GetDescription(), GA_ReadOnly);
             oOpenInfo.papszOpenOptions = m_poDS->GetOpenOptions();
             oOpenInfo.nOpenFlags = GDAL_OF_VECTOR;
-            // avoid coverity scan false positive about nullptr dereference
-            assert(m_poOtherDS);
-            if( !m_poOtherDS->Open(&oOpenInfo) )
-            {
-                m_poOtherDS.reset();
-            }
+            if( !poOtherDS->Open(&oOpenInfo) )
+                return false;
+            poTask->m_poDS = std::move(poOtherDS);
         }
-        if( m_poOtherDS != nullptr )
-        {
-            auto poOtherLayer = dynamic_cast<OGRGeoPackageTableLayer*>(
-                                        m_poOtherDS->GetLayerByName(GetName()));
-            if( poOtherLayer &&
-                poOtherLayer->GetLayerDefn()->GetFieldCount() == m_poFeatureDefn->GetFieldCount() )
-            {
-                if( m_psNextArrayArray == nullptr )
-                {
-                    m_psNextArrayArray = new struct ArrowArray;
-                    memset(m_psNextArrayArray, 0, sizeof(*m_psNextArrayArray));
 
-                    poOtherLayer->m_nTotalFeatureCount = m_nTotalFeatureCount;
-                    poOtherLayer->m_aosArrowArrayStreamOptions = m_aosArrowArrayStreamOptions;
-                    auto poOtherFDefn = poOtherLayer->GetLayerDefn();
-                    for( int i = 0; i < m_poFeatureDefn->GetGeomFieldCount(); ++i )
-                    {
-                        poOtherFDefn->GetGeomFieldDefn(i)->SetIgnored(
-                            m_poFeatureDefn->GetGeomFieldDefn(i)->IsIgnored());
-                    }
-                    for( int i = 0; i < m_poFeatureDefn->GetFieldCount(); ++i )
-                    {
-                        poOtherFDefn->GetFieldDefn(i)->SetIgnored(
-                            m_poFeatureDefn->GetFieldDefn(i)->IsIgnored());
-                    }
-                }
+        auto poOtherLayer = dynamic_cast<OGRGeoPackageTableLayer*>(
+                                poTask->m_poDS->GetLayerByName(GetName()));
+        if( poOtherLayer == nullptr ||
+            poOtherLayer->GetLayerDefn()->GetFieldCount() != m_poFeatureDefn->GetFieldCount() )
+        {
+            return false;
+        }
 
-                CPLAssert( m_psNextArrayArray->release == nullptr );
-                poOtherLayer->iNextShapeId = iNextShapeId + nMaxBatchSize;
-                try
-                {
-                    m_oThreadNextArrowArray = std::thread([this, poOtherLayer]()
-                    {
-                        poOtherLayer->GetNextArrowArrayInternal(m_psNextArrayArray);
-                    });
-                }
-                catch( const std::exception &e )
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "Cannot start worker thread: %s", e.what());
-                }
-            }
+        poOtherLayer->m_nTotalFeatureCount = m_nTotalFeatureCount;
+        poOtherLayer->m_aosArrowArrayStreamOptions = m_aosArrowArrayStreamOptions;
+        auto poOtherFDefn = poOtherLayer->GetLayerDefn();
+        for( int i = 0; i < m_poFeatureDefn->GetGeomFieldCount(); ++i )
+        {
+            poOtherFDefn->GetGeomFieldDefn(i)->SetIgnored(
+                m_poFeatureDefn->GetGeomFieldDefn(i)->IsIgnored());
         }
+        for( int i = 0; i < m_poFeatureDefn->GetFieldCount(); ++i )
+        {
+            poOtherFDefn->GetFieldDefn(i)->SetIgnored(
+                m_poFeatureDefn->GetFieldDefn(i)->IsIgnored());
+        }
+        poTask->m_poLayer = poOtherLayer;
     }
 
-    return GetNextArrowArrayInternal(out_array);
+    if( poTask->m_psArrowArray == nullptr )
+        poTask->m_psArrowArray.reset(new struct ArrowArray);
+    memset(poTask->m_psArrowArray.get(), 0, sizeof(struct ArrowArray));
+    poTask->m_poLayer->iNextShapeId = poTask->m_iStartShapeId;
+
+    auto poTaskPtr = poTask.get();
+    try
+    {
+        poTask->m_oThread = std::thread([poTaskPtr]()
+        {
+            poTaskPtr->m_poLayer->GetNextArrowArrayInternal(
+                                            poTaskPtr->m_psArrowArray.get());
+        });
+    }
+    catch( const std::exception &e )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot start worker thread: %s", e.what());
+        m_apoArrowArrayPrefetchDS.emplace_back(std::move(poTask->m_poDS));
+        return false;
+    }
+
+    m_oQueueArrowArrayPrefetchTasks.push(std::move(poTask));
+    return true;
 }
 
 /************************************************************************/
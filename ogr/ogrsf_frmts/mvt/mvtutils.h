@@ -62,6 +62,11 @@
         "'Whether to deflate-compress tiles' default='YES'/>" \
 "  <Option name='TEMPORARY_DB' scope='vector' type='string' description='" \
         "Filename with path for the temporary database'/>" \
+"  <Option name='TEMPORARY_STORAGE' scope='vector' type='string-select' " \
+        "description='Storage for temporary tile features' default='SQLITE'>" \
+"    <Value>SQLITE</Value>" \
+"    <Value>FILES</Value>" \
+"  </Option>" \
 "  <Option name='MAX_SIZE' scope='vector' type='unsigned int' min='100' default='500000' " \
         "description='Maximum size of a tile in bytes'/>" \
 "  <Option name='MAX_FEATURES' scope='vector' type='unsigned int' min='1' default='200000' " \
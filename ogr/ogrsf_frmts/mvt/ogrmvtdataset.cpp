@@ -3211,6 +3211,79 @@ struct OGRMVTFeatureContent
     GIntBig nFID;
 };
 
+/************************************************************************/
+/*                        OGRMVTTempTileReader                          */
+/************************************************************************/
+
+// Iterates over the temporary features, grouped by tile, from which the
+// final tiles are built.
+class OGRMVTTempTileReader
+{
+    public:
+        virtual ~OGRMVTTempTileReader() = default;
+
+        // Advances to the next tile, in (z, x, y) order.
+        virtual bool GetNextTile(int& nZ, int& nX, int& nY) = 0;
+
+        // Iterates over the layers of the current tile, in name order, and
+        // the features of the current layer, in insertion order.
+        virtual void ResetLayerReading() = 0;
+        virtual const char* GetNextLayer() = 0;
+        virtual bool GetNextFeature(const void*& pabyBlob,
+                                    int& nBlobSize) = 0;
+
+        // Iterates over the nLimit features of the current tile with the
+        // largest area or length, in decreasing order.
+        virtual bool StartLargestFeaturesReading(unsigned nLimit) = 0;
+        virtual bool GetNextLargestFeature(const char*& pszLayerName,
+                                           const void*& pabyBlob,
+                                           int& nBlobSize) = 0;
+
+        virtual bool HasError() const { return false; }
+};
+
+/************************************************************************/
+/*                         MVTSpillRecordHeader                         */
+/************************************************************************/
+
+// Header of a record of a spill file, followed by the layer name and the
+// compressed feature blob.
+struct MVTSpillRecordHeader
+{
+    int nZ;
+    int nX;
+    int nY;
+    int nGeomType;
+    GIntBig nSerial;
+    double dfAreaOrLength;
+    GUInt32 nLayerNameSize;
+    GUInt32 nBlobSize;
+};
+
+/************************************************************************/
+/*                         MVTSpillRecordLess()                         */
+/************************************************************************/
+
+static bool MVTSpillRecordLess(const MVTSpillRecordHeader& sA,
+                               const char* pszLayerNameA,
+                               const MVTSpillRecordHeader& sB,
+                               const char* pszLayerNameB)
+{
+    if( sA.nZ != sB.nZ )
+        return sA.nZ < sB.nZ;
+    if( sA.nX != sB.nX )
+        return sA.nX < sB.nX;
+    if( sA.nY != sB.nY )
+        return sA.nY < sB.nY;
+    const int nCmp = memcmp(pszLayerNameA, pszLayerNameB,
+                            std::min(sA.nLayerNameSize, sB.nLayerNameSize));
+    if( nCmp != 0 )
+        return nCmp < 0;
+    if( sA.nLayerNameSize != sB.nLayerNameSize )
+        return sA.nLayerNameSize < sB.nLayerNameSize;
+    return sA.nSerial < sB.nSerial;
+}
+
 class OGRMVTWriterDataset final: public GDALDataset
 {
         class MVTFieldProperties
@@ -3245,6 +3318,13 @@ class OGRMVTWriterDataset final: public GDALDataset
         sqlite3_vfs                           *m_pMyVFS = nullptr;
         sqlite3                               *m_hDB = nullptr;
         sqlite3_stmt                          *m_hInsertStmt = nullptr;
+        bool                                   m_bUseSpillFiles = false;
+        CPLString                              m_osSpillFilePrefix;
+        size_t                                 m_nSpillBufferMaxSize = 100 * 1024 * 1024;
+        mutable std::vector<GByte>             m_abySpillBuffer;
+        mutable std::vector<size_t>            m_anSpillRecordOffsets;
+        mutable std::mutex                     m_oSpillFilesMutex;
+        mutable std::vector<std::pair<CPLString, VSILFILE*>> m_aoSpillFiles;
         int                                    m_nMinZoom = 0;
         int                                    m_nMaxZoom = 5;
         double                                 m_dfSimplification = 0.0;
@@ -3286,6 +3366,9 @@ class OGRMVTWriterDataset final: public GDALDataset
 
         static void         WriterTaskFunc(void* pParam);
 
+        bool                WriteSpillFile(std::vector<GByte>& abyBuffer,
+                                           std::vector<size_t>& anOffsets) const;
+
         OGRErr              PreGenerateForTileReal(int nZ, int nX, int nY,
                                                const CPLString& osTargetName,
                                                bool bIsMaxZoomForLayer,
@@ -3347,8 +3430,7 @@ class OGRMVTWriterDataset final: public GDALDataset
 
         std::string EncodeTile(
                         int nZ, int nX, int nY,
-                        sqlite3_stmt* hStmtLayer,
-                        sqlite3_stmt* hStmtRows,
+                        OGRMVTTempTileReader& oReader,
                         std::map<CPLString, MVTLayerProperties>& oMapLayerProps,
                         std::set<CPLString>& oSetLayers,
                         GIntBig& nTempTilesRead);
@@ -3356,8 +3438,7 @@ class OGRMVTWriterDataset final: public GDALDataset
         std::string RecodeTileLowerResolution(
                                 int nZ, int nX, int nY,
                                 int nExtent,
-                                sqlite3_stmt* hStmtLayer,
-                                sqlite3_stmt* hStmtRows);
+                                OGRMVTTempTileReader& oReader);
 
         bool                CreateOutput();
 
@@ -3540,6 +3621,14 @@ OGRMVTWriterDataset::~OGRMVTWriterDataset()
     {
         sqlite3_close(m_hDBMBTILES);
     }
+    for( const auto& oSpillFile: m_aoSpillFiles )
+    {
+        if( oSpillFile.second )
+            VSIFCloseL(oSpillFile.second);
+        if( CPLTestBool(
+                CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")) )
+            VSIUnlink(oSpillFile.first);
+    }
     if( !m_osTempDB.empty() &&
         !m_bReuseTempFile &&
         CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")) )
@@ -4361,6 +4450,55 @@ OGRErr OGRMVTWriterDataset::PreGenerateForTileReal(
     oBuffer.assign( static_cast<char*>(pCompressed), nCompressedSize );
     CPLFree(pCompressed);
 
+    if( m_bUseSpillFiles )
+    {
+        // Append the record to the in-memory buffer, and when it is full,
+        // sort it and write it to a new spill file without holding the
+        // lock, so that other workers can continue filling a new buffer.
+        MVTSpillRecordHeader sHeader;
+        sHeader.nZ = nZ;
+        sHeader.nX = nTileX;
+        sHeader.nY = nTileY;
+        sHeader.nGeomType = static_cast<int>(poGPBFeature->getType());
+        sHeader.nSerial = nSerial;
+        sHeader.dfAreaOrLength = dfAreaOrLength;
+        sHeader.nLayerNameSize = static_cast<GUInt32>(osTargetName.size());
+        sHeader.nBlobSize = static_cast<GUInt32>(oBuffer.size());
+
+        std::vector<GByte> abyFullBuffer;
+        std::vector<size_t> anFullOffsets;
+
+        if( m_bThreadPoolOK )
+            m_oDBMutex.lock();
+
+        m_nTempTiles ++;
+        const size_t nOffset = m_abySpillBuffer.size();
+        m_anSpillRecordOffsets.push_back(nOffset);
+        m_abySpillBuffer.resize(nOffset + sizeof(sHeader) +
+                                osTargetName.size() + oBuffer.size());
+        GByte* pabyDst = m_abySpillBuffer.data() + nOffset;
+        memcpy(pabyDst, &sHeader, sizeof(sHeader));
+        pabyDst += sizeof(sHeader);
+        memcpy(pabyDst, osTargetName.data(), osTargetName.size());
+        pabyDst += osTargetName.size();
+        memcpy(pabyDst, oBuffer.data(), oBuffer.size());
+        if( m_abySpillBuffer.size() >= m_nSpillBufferMaxSize )
+        {
+            std::swap(abyFullBuffer, m_abySpillBuffer);
+            std::swap(anFullOffsets, m_anSpillRecordOffsets);
+        }
+
+        if( m_bThreadPoolOK )
+            m_oDBMutex.unlock();
+
+        if( !anFullOffsets.empty() &&
+            !WriteSpillFile(abyFullBuffer, anFullOffsets) )
+        {
+            return OGRERR_FAILURE;
+        }
+        return OGRERR_NONE;
+    }
+
     if( m_bThreadPoolOK )
         m_oDBMutex.lock();
 
@@ -4390,6 +4528,78 @@ OGRErr OGRMVTWriterDataset::PreGenerateForTileReal(
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                          WriteSpillFile()                            */
+/************************************************************************/
+
+// Sorts the records of abyBuffer by (z, x, y, layer, serial) and writes
+// them in a new spill file, that is later merged with the other ones by
+// OGRMVTSpillFilesReader.
+bool OGRMVTWriterDataset::WriteSpillFile(std::vector<GByte>& abyBuffer,
+                                         std::vector<size_t>& anOffsets) const
+{
+    const GByte* pabyBuffer = abyBuffer.data();
+    std::sort(anOffsets.begin(), anOffsets.end(),
+        [pabyBuffer](size_t nOffsetA, size_t nOffsetB)
+        {
+            MVTSpillRecordHeader sA;
+            MVTSpillRecordHeader sB;
+            memcpy(&sA, pabyBuffer + nOffsetA, sizeof(sA));
+            memcpy(&sB, pabyBuffer + nOffsetB, sizeof(sB));
+            return MVTSpillRecordLess(
+                sA, reinterpret_cast<const char*>(pabyBuffer + nOffsetA + sizeof(sA)),
+                sB, reinterpret_cast<const char*>(pabyBuffer + nOffsetB + sizeof(sB)));
+        });
+
+    CPLString osFilename;
+    {
+        std::lock_guard<std::mutex> oLock(m_oSpillFilesMutex);
+        osFilename = CPLSPrintf("%s%d.bin", m_osSpillFilePrefix.c_str(),
+                                static_cast<int>(m_aoSpillFiles.size()));
+        m_aoSpillFiles.emplace_back(osFilename, nullptr);
+    }
+
+    VSILFILE* fp = VSIFOpenL(osFilename, "wb+");
+    if( fp == nullptr )
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                 osFilename.c_str());
+        return false;
+    }
+    // For Unix
+    if( CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")) )
+        VSIUnlink(osFilename);
+
+    bool bOK = true;
+    for( const size_t nOffset: anOffsets )
+    {
+        MVTSpillRecordHeader sHeader;
+        memcpy(&sHeader, pabyBuffer + nOffset, sizeof(sHeader));
+        const size_t nSize = sizeof(sHeader) + sHeader.nLayerNameSize +
+                             sHeader.nBlobSize;
+        if( VSIFWriteL(pabyBuffer + nOffset, 1, nSize, fp) != nSize )
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot write in %s",
+                     osFilename.c_str());
+            bOK = false;
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(m_oSpillFilesMutex);
+        for( auto& oSpillFile: m_aoSpillFiles )
+        {
+            if( oSpillFile.first == osFilename )
+                oSpillFile.second = fp;
+        }
+    }
+
+    abyBuffer.clear();
+    anOffsets.clear();
+    return bOK;
+}
+
 /************************************************************************/
 /*                           MVTWriterTask()                            */
 /************************************************************************/
@@ -5003,32 +5213,23 @@ void OGRMVTWriterDataset::EncodeFeature(
 
 std::string OGRMVTWriterDataset::EncodeTile(
                         int nZ, int nX, int nY,
-                        sqlite3_stmt* hStmtLayer,
-                        sqlite3_stmt* hStmtRows,
+                        OGRMVTTempTileReader& oReader,
                         std::map<CPLString, MVTLayerProperties>& oMapLayerProps,
                         std::set<CPLString>& oSetLayers,
                         GIntBig& nTempTilesRead)
 {
     MVTTile oTargetTile;
 
-    sqlite3_bind_int(hStmtLayer, 1, nZ);
-    sqlite3_bind_int(hStmtLayer, 2, nX);
-    sqlite3_bind_int(hStmtLayer, 3, nY);
+    oReader.ResetLayerReading();
 
     unsigned nFeaturesInTile = 0;
     const GIntBig nProgressStep = std::max( static_cast<GIntBig>(1),
                                             m_nTempTiles / 10 );
 
+    const char* pszLayerName = nullptr;
     while( nFeaturesInTile < m_nMaxFeatures &&
-           sqlite3_step(hStmtLayer) == SQLITE_ROW )
+           (pszLayerName = oReader.GetNextLayer()) != nullptr )
     {
-        const char* pszLayerName = reinterpret_cast<const char*>(
-            sqlite3_column_text(hStmtLayer, 0));
-        sqlite3_bind_int(hStmtRows, 1, nZ);
-        sqlite3_bind_int(hStmtRows, 2, nX);
-        sqlite3_bind_int(hStmtRows, 3, nY);
-        sqlite3_bind_text(hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
-
         auto oIterMapLayerProps = oMapLayerProps.find(pszLayerName);
         MVTLayerProperties* poLayerProperties = nullptr;
         if( oIterMapLayerProps == oMapLayerProps.end() )
@@ -5067,12 +5268,11 @@ std::string OGRMVTWriterDataset::EncodeTile(
         std::map<CPLString, GUInt32> oMapKeyToIdx;
         std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
 
+        const void* pabyBlob = nullptr;
+        int nBlobSize = 0;
         while( nFeaturesInTile < m_nMaxFeatures &&
-               sqlite3_step(hStmtRows) == SQLITE_ROW )
+               oReader.GetNextFeature(pabyBlob, nBlobSize) )
         {
-            int nBlobSize = sqlite3_column_bytes(hStmtRows, 0);
-            const void* pabyBlob = sqlite3_column_blob(hStmtRows, 0);
-
             EncodeFeature(pabyBlob, nBlobSize, poTargetLayer,
                           oMapKeyToIdx, oMapValueToIdx,
                           poLayerProperties, m_nExtent, nFeaturesInTile);
@@ -5086,11 +5286,8 @@ std::string OGRMVTWriterDataset::EncodeTile(
                 CPLDebug("MVT", "%d%%...", nPct);
             }
         }
-        sqlite3_reset(hStmtRows);
     }
 
-    sqlite3_reset(hStmtLayer);
-
     std::string oTileBuffer(oTargetTile.write());
     size_t nSizeBefore = oTileBuffer.size();
     if( m_bGZip)
@@ -5111,7 +5308,7 @@ std::string OGRMVTWriterDataset::EncodeTile(
         nExtent /= 2;
         nSizeBefore = oTileBuffer.size();
         oTileBuffer = RecodeTileLowerResolution(nZ, nX, nY, nExtent,
-                                                hStmtLayer, hStmtRows);
+                                                oReader);
         bTooBigTile = oTileBuffer.size() > m_nMaxTileSize;
         CPLDebug("MVT", "Recoding tile %d/%d/%d with extent = %u. "
                  "From %u to %u bytes",
@@ -5141,16 +5338,7 @@ std::string OGRMVTWriterDataset::EncodeTile(
 
         const unsigned nTotalFeaturesInTile =
                                 std::min(m_nMaxFeatures, nFeaturesInTile);
-        char* pszSQL = sqlite3_mprintf(
-            "SELECT layer, feature FROM temp "
-            "WHERE z = %d AND x = %d AND y = %d ORDER BY "
-            "area_or_length DESC LIMIT %d",
-            nZ, nX, nY, nTotalFeaturesInTile);
-        sqlite3_stmt* hTmpStmt = nullptr;
-        CPL_IGNORE_RET_VAL(
-            sqlite3_prepare_v2( m_hDB, pszSQL, -1, &hTmpStmt, nullptr) );
-        sqlite3_free(pszSQL);
-        if( !hTmpStmt )
+        if( !oReader.StartLargestFeaturesReading(nTotalFeaturesInTile) )
             return std::string();
 
         class TargetTileLayerProps
@@ -5166,12 +5354,11 @@ std::string OGRMVTWriterDataset::EncodeTile(
 
         nFeaturesInTile = 0;
         const unsigned nCheckStep = std::max(1U, nTotalFeaturesInTile / 100);
-        while( sqlite3_step(hTmpStmt) == SQLITE_ROW )
+        const void* pabyBlob = nullptr;
+        int nBlobSize = 0;
+        while( oReader.GetNextLargestFeature(pszLayerName,
+                                             pabyBlob, nBlobSize) )
         {
-            const char* pszLayerName = reinterpret_cast<const char*>(
-                sqlite3_column_text(hTmpStmt, 0));
-            int nBlobSize = sqlite3_column_bytes(hTmpStmt, 1);
-            const void* pabyBlob = sqlite3_column_blob(hTmpStmt, 1);
 
             std::shared_ptr<MVTTileLayer> poTargetLayer;
             std::map<CPLString, GUInt32>* poMapKeyToIdx;
@@ -5225,8 +5412,6 @@ std::string OGRMVTWriterDataset::EncodeTile(
                      nZ, nX, nY,
                      static_cast<unsigned>(oTileBuffer.size()));
         }
-
-        sqlite3_finalize(hTmpStmt);
     }
 
     return oTileBuffer;
@@ -5239,26 +5424,17 @@ std::string OGRMVTWriterDataset::EncodeTile(
 std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
                                             int nZ, int nX, int nY,
                                             int nExtent,
-                                            sqlite3_stmt* hStmtLayer,
-                                            sqlite3_stmt* hStmtRows)
+                                            OGRMVTTempTileReader& oReader)
 {
     MVTTile oTargetTile;
 
-    sqlite3_bind_int(hStmtLayer, 1, nZ);
-    sqlite3_bind_int(hStmtLayer, 2, nX);
-    sqlite3_bind_int(hStmtLayer, 3, nY);
+    oReader.ResetLayerReading();
 
     unsigned nFeaturesInTile = 0;
+    const char* pszLayerName = nullptr;
     while( nFeaturesInTile < m_nMaxFeatures &&
-           sqlite3_step(hStmtLayer) == SQLITE_ROW )
+           (pszLayerName = oReader.GetNextLayer()) != nullptr )
     {
-        const char* pszLayerName = reinterpret_cast<const char*>(
-            sqlite3_column_text(hStmtLayer, 0));
-        sqlite3_bind_int(hStmtRows, 1, nZ);
-        sqlite3_bind_int(hStmtRows, 2, nX);
-        sqlite3_bind_int(hStmtRows, 3, nY);
-        sqlite3_bind_text(hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
-
         std::shared_ptr<MVTTileLayer> poTargetLayer(new MVTTileLayer());
         oTargetTile.addLayer(poTargetLayer);
         poTargetLayer->setName(pszLayerName);
@@ -5268,22 +5444,18 @@ std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
         std::map<CPLString, GUInt32> oMapKeyToIdx;
         std::map<MVTTileLayerValue, GUInt32> oMapValueToIdx;
 
+        const void* pabyBlob = nullptr;
+        int nBlobSize = 0;
         while( nFeaturesInTile < m_nMaxFeatures &&
-               sqlite3_step(hStmtRows) == SQLITE_ROW )
+               oReader.GetNextFeature(pabyBlob, nBlobSize) )
         {
-            int nBlobSize = sqlite3_column_bytes(hStmtRows, 0);
-            const void* pabyBlob = sqlite3_column_blob(hStmtRows, 0);
-
             EncodeFeature(pabyBlob, nBlobSize, poTargetLayer,
                           oMapKeyToIdx, oMapValueToIdx,
                           nullptr, nExtent, nFeaturesInTile);
 
         }
-        sqlite3_reset(hStmtRows);
     }
 
-    sqlite3_reset(hStmtLayer);
-
     std::string oTileBuffer(oTargetTile.write());
     if( m_bGZip)
         GZIPCompress(oTileBuffer);
@@ -5292,60 +5464,422 @@ std::string OGRMVTWriterDataset::RecodeTileLowerResolution(
 }
 
 /************************************************************************/
-/*                            CreateOutput()                            */
+/*                        OGRMVTSQLiteTileReader                        */
 /************************************************************************/
 
-bool OGRMVTWriterDataset::CreateOutput()
+// Reads the temporary features from the temporary SQLite database.
+class OGRMVTSQLiteTileReader final: public OGRMVTTempTileReader
 {
-    if( m_bThreadPoolOK )
-        m_oThreadPool.WaitCompletion();
+        sqlite3      *m_hDB = nullptr;
+        sqlite3_stmt *m_hStmtZXY = nullptr;
+        sqlite3_stmt *m_hStmtLayer = nullptr;
+        sqlite3_stmt *m_hStmtRows = nullptr;
+        sqlite3_stmt *m_hStmtLargest = nullptr;
+        int           m_nZ = 0;
+        int           m_nX = 0;
+        int           m_nY = 0;
 
-    std::map<CPLString, MVTLayerProperties> oMapLayerProps;
-    std::set<CPLString> oSetLayers;
+        CPL_DISALLOW_COPY_ASSIGN(OGRMVTSQLiteTileReader)
 
-    if( !m_oEnvelope.IsInit() )
-    {
-        return GenerateMetadata(0, oMapLayerProps);
-    }
+    public:
+        explicit OGRMVTSQLiteTileReader(sqlite3* hDB): m_hDB(hDB) {}
+        ~OGRMVTSQLiteTileReader() override;
+
+        bool Init();
+
+        bool GetNextTile(int& nZ, int& nX, int& nY) override;
+        void ResetLayerReading() override;
+        const char* GetNextLayer() override;
+        bool GetNextFeature(const void*& pabyBlob, int& nBlobSize) override;
+        bool StartLargestFeaturesReading(unsigned nLimit) override;
+        bool GetNextLargestFeature(const char*& pszLayerName,
+                                   const void*& pabyBlob,
+                                   int& nBlobSize) override;
+};
 
-    CPLDebug("MVT", "Building output file from temporary database...");
+OGRMVTSQLiteTileReader::~OGRMVTSQLiteTileReader()
+{
+    sqlite3_finalize(m_hStmtZXY);
+    sqlite3_finalize(m_hStmtLayer);
+    sqlite3_finalize(m_hStmtRows);
+    sqlite3_finalize(m_hStmtLargest);
+}
 
-    sqlite3_stmt* hStmtZXY = nullptr;
+bool OGRMVTSQLiteTileReader::Init()
+{
     CPL_IGNORE_RET_VAL(
         sqlite3_prepare_v2( m_hDB,
             "SELECT DISTINCT z, x, y FROM temp ORDER BY z, x, y",
-            -1, &hStmtZXY, nullptr) );
-    if( hStmtZXY == nullptr )
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-        return false;
-    }
-
-    sqlite3_stmt* hStmtLayer = nullptr;
+            -1, &m_hStmtZXY, nullptr) );
     CPL_IGNORE_RET_VAL(
         sqlite3_prepare_v2( m_hDB,
             "SELECT DISTINCT layer FROM temp "
             "WHERE z = ? AND x = ? AND y = ? ORDER BY layer",
-            -1, &hStmtLayer, nullptr) );
-    if( hStmtLayer == nullptr )
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-        sqlite3_finalize(hStmtZXY);
-        return false;
-    }
-    sqlite3_stmt* hStmtRows = nullptr;
+            -1, &m_hStmtLayer, nullptr) );
     CPL_IGNORE_RET_VAL(
         sqlite3_prepare_v2( m_hDB,
             "SELECT feature FROM temp "
             "WHERE z = ? AND x = ? AND y = ? AND layer = ? ORDER BY idx",
-            -1, &hStmtRows, nullptr) );
-    if( hStmtRows == nullptr )
+            -1, &m_hStmtRows, nullptr) );
+    if( m_hStmtZXY == nullptr || m_hStmtLayer == nullptr ||
+        m_hStmtRows == nullptr )
     {
         CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-        sqlite3_finalize(hStmtZXY);
-        sqlite3_finalize(hStmtLayer);
         return false;
     }
+    return true;
+}
+
+bool OGRMVTSQLiteTileReader::GetNextTile(int& nZ, int& nX, int& nY)
+{
+    if( sqlite3_step(m_hStmtZXY) != SQLITE_ROW )
+        return false;
+    m_nZ = nZ = sqlite3_column_int(m_hStmtZXY, 0);
+    m_nX = nX = sqlite3_column_int(m_hStmtZXY, 1);
+    m_nY = nY = sqlite3_column_int(m_hStmtZXY, 2);
+    return true;
+}
+
+void OGRMVTSQLiteTileReader::ResetLayerReading()
+{
+    sqlite3_reset(m_hStmtRows);
+    sqlite3_reset(m_hStmtLayer);
+    sqlite3_bind_int(m_hStmtLayer, 1, m_nZ);
+    sqlite3_bind_int(m_hStmtLayer, 2, m_nX);
+    sqlite3_bind_int(m_hStmtLayer, 3, m_nY);
+}
+
+const char* OGRMVTSQLiteTileReader::GetNextLayer()
+{
+    sqlite3_reset(m_hStmtRows);
+    if( sqlite3_step(m_hStmtLayer) != SQLITE_ROW )
+        return nullptr;
+    const char* pszLayerName = reinterpret_cast<const char*>(
+        sqlite3_column_text(m_hStmtLayer, 0));
+    sqlite3_bind_int(m_hStmtRows, 1, m_nZ);
+    sqlite3_bind_int(m_hStmtRows, 2, m_nX);
+    sqlite3_bind_int(m_hStmtRows, 3, m_nY);
+    sqlite3_bind_text(m_hStmtRows, 4, pszLayerName, -1, SQLITE_STATIC);
+    return pszLayerName;
+}
+
+bool OGRMVTSQLiteTileReader::GetNextFeature(const void*& pabyBlob,
+                                            int& nBlobSize)
+{
+    if( sqlite3_step(m_hStmtRows) != SQLITE_ROW )
+        return false;
+    nBlobSize = sqlite3_column_bytes(m_hStmtRows, 0);
+    pabyBlob = sqlite3_column_blob(m_hStmtRows, 0);
+    return true;
+}
+
+bool OGRMVTSQLiteTileReader::StartLargestFeaturesReading(unsigned nLimit)
+{
+    sqlite3_finalize(m_hStmtLargest);
+    m_hStmtLargest = nullptr;
+    char* pszSQL = sqlite3_mprintf(
+        "SELECT layer, feature FROM temp "
+        "WHERE z = %d AND x = %d AND y = %d ORDER BY "
+        "area_or_length DESC LIMIT %d",
+        m_nZ, m_nX, m_nY, static_cast<int>(nLimit));
+    CPL_IGNORE_RET_VAL(
+        sqlite3_prepare_v2( m_hDB, pszSQL, -1, &m_hStmtLargest, nullptr) );
+    sqlite3_free(pszSQL);
+    return m_hStmtLargest != nullptr;
+}
+
+bool OGRMVTSQLiteTileReader::GetNextLargestFeature(const char*& pszLayerName,
+                                                   const void*& pabyBlob,
+                                                   int& nBlobSize)
+{
+    if( sqlite3_step(m_hStmtLargest) != SQLITE_ROW )
+        return false;
+    pszLayerName = reinterpret_cast<const char*>(
+        sqlite3_column_text(m_hStmtLargest, 0));
+    nBlobSize = sqlite3_column_bytes(m_hStmtLargest, 1);
+    pabyBlob = sqlite3_column_blob(m_hStmtLargest, 1);
+    return true;
+}
+
+/************************************************************************/
+/*                        OGRMVTSpillFilesReader                        */
+/************************************************************************/
+
+// Merges the spill files, each of them being sorted by
+// (z, x, y, layer, serial), and groups their records by tile. At most
+// nMaxFeatures records are retained per tile, both in the order of the
+// layers and in decreasing area or length order.
+class OGRMVTSpillFilesReader final: public OGRMVTTempTileReader
+{
+        struct Record
+        {
+            MVTSpillRecordHeader sHeader;
+            std::string          osLayerName;
+            std::string          osBlob;
+        };
+
+        struct SpillFile
+        {
+            VSILFILE               *fp;
+            std::shared_ptr<Record> poCur;
+        };
+
+        std::vector<SpillFile>  m_asFiles;
+        std::vector<int>        m_anHeap; // heap of indices of m_asFiles
+        unsigned                m_nMaxFeatures;
+        bool                    m_bError = false;
+
+        std::vector<std::shared_ptr<Record>> m_apoFeatures;
+        std::vector<std::shared_ptr<Record>> m_apoLargest;
+        size_t                  m_iNextFeature = 0;
+        const char*             m_pszCurLayerName = nullptr;
+        size_t                  m_iNextLargest = 0;
+        size_t                  m_nLargestLimit = 0;
+
+        bool ReadRecord(SpillFile& sFile);
+
+        bool FileGreater(int iA, int iB) const
+        {
+            const Record* psA = m_asFiles[iA].poCur.get();
+            const Record* psB = m_asFiles[iB].poCur.get();
+            return MVTSpillRecordLess(psB->sHeader, psB->osLayerName.data(),
+                                      psA->sHeader, psA->osLayerName.data());
+        }
+
+        static bool AreaGreater(const std::shared_ptr<Record>& poA,
+                                const std::shared_ptr<Record>& poB)
+        {
+            return poA->sHeader.dfAreaOrLength > poB->sHeader.dfAreaOrLength;
+        }
+
+    public:
+        OGRMVTSpillFilesReader(const std::vector<VSILFILE*>& apoFiles,
+                               unsigned nMaxFeatures);
+
+        bool GetNextTile(int& nZ, int& nX, int& nY) override;
+        void ResetLayerReading() override;
+        const char* GetNextLayer() override;
+        bool GetNextFeature(const void*& pabyBlob, int& nBlobSize) override;
+        bool StartLargestFeaturesReading(unsigned nLimit) override;
+        bool GetNextLargestFeature(const char*& pszLayerName,
+                                   const void*& pabyBlob,
+                                   int& nBlobSize) override;
+        bool HasError() const override { return m_bError; }
+};
+
+OGRMVTSpillFilesReader::OGRMVTSpillFilesReader(
+                                    const std::vector<VSILFILE*>& apoFiles,
+                                    unsigned nMaxFeatures):
+    m_nMaxFeatures(nMaxFeatures)
+{
+    const auto oGreater = [this](int iA, int iB)
+                                    { return FileGreater(iA, iB); };
+    for( VSILFILE* fp: apoFiles )
+    {
+        SpillFile sFile;
+        sFile.fp = fp;
+        VSIFSeekL(fp, 0, SEEK_SET);
+        if( ReadRecord(sFile) )
+        {
+            m_asFiles.push_back(sFile);
+            m_anHeap.push_back(static_cast<int>(m_asFiles.size()) - 1);
+            std::push_heap(m_anHeap.begin(), m_anHeap.end(), oGreater);
+        }
+    }
+}
+
+bool OGRMVTSpillFilesReader::ReadRecord(SpillFile& sFile)
+{
+    auto poRecord = std::make_shared<Record>();
+    const size_t nRead =
+        VSIFReadL(&poRecord->sHeader, 1, sizeof(poRecord->sHeader), sFile.fp);
+    if( nRead == 0 )
+    {
+        sFile.poCur.reset();
+        return false;
+    }
+    bool bOK = nRead == sizeof(poRecord->sHeader);
+    if( bOK )
+    {
+        poRecord->osLayerName.resize(poRecord->sHeader.nLayerNameSize);
+        poRecord->osBlob.resize(poRecord->sHeader.nBlobSize);
+        bOK = VSIFReadL(&poRecord->osLayerName[0], 1,
+                        poRecord->osLayerName.size(), sFile.fp) ==
+                                        poRecord->osLayerName.size() &&
+              VSIFReadL(&poRecord->osBlob[0], 1,
+                        poRecord->osBlob.size(), sFile.fp) ==
+                                        poRecord->osBlob.size();
+    }
+    if( !bOK )
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Error while reading spill file");
+        m_bError = true;
+        sFile.poCur.reset();
+        return false;
+    }
+    sFile.poCur = std::move(poRecord);
+    return true;
+}
+
+bool OGRMVTSpillFilesReader::GetNextTile(int& nZ, int& nX, int& nY)
+{
+    m_apoFeatures.clear();
+    m_apoLargest.clear();
+    if( m_anHeap.empty() || m_bError )
+        return false;
+
+    const auto oGreater = [this](int iA, int iB)
+                                    { return FileGreater(iA, iB); };
+    const MVTSpillRecordHeader& sFirst =
+                                m_asFiles[m_anHeap.front()].poCur->sHeader;
+    nZ = sFirst.nZ;
+    nX = sFirst.nX;
+    nY = sFirst.nY;
+
+    while( !m_anHeap.empty() )
+    {
+        SpillFile& sFile = m_asFiles[m_anHeap.front()];
+        const MVTSpillRecordHeader& sHeader = sFile.poCur->sHeader;
+        if( sHeader.nZ != nZ || sHeader.nX != nX || sHeader.nY != nY )
+            break;
+
+        std::pop_heap(m_anHeap.begin(), m_anHeap.end(), oGreater);
+        std::shared_ptr<Record> poRecord = std::move(sFile.poCur);
+
+        if( m_apoFeatures.size() < m_nMaxFeatures )
+            m_apoFeatures.push_back(poRecord);
+
+        if( m_apoLargest.size() < m_nMaxFeatures )
+        {
+            m_apoLargest.push_back(poRecord);
+            std::push_heap(m_apoLargest.begin(), m_apoLargest.end(),
+                           AreaGreater);
+        }
+        else if( AreaGreater(poRecord, m_apoLargest.front()) )
+        {
+            std::pop_heap(m_apoLargest.begin(), m_apoLargest.end(),
+                          AreaGreater);
+            m_apoLargest.back() = poRecord;
+            std::push_heap(m_apoLargest.begin(), m_apoLargest.end(),
+                           AreaGreater);
+        }
+
+        if( ReadRecord(sFile) )
+            std::push_heap(m_anHeap.begin(), m_anHeap.end(), oGreater);
+        else
+            m_anHeap.pop_back();
+    }
+
+    return !m_bError;
+}
+
+void OGRMVTSpillFilesReader::ResetLayerReading()
+{
+    m_iNextFeature = 0;
+    m_pszCurLayerName = nullptr;
+}
+
+const char* OGRMVTSpillFilesReader::GetNextLayer()
+{
+    while( m_pszCurLayerName != nullptr &&
+           m_iNextFeature < m_apoFeatures.size() &&
+           m_apoFeatures[m_iNextFeature]->osLayerName == m_pszCurLayerName )
+    {
+        m_iNextFeature ++;
+    }
+    if( m_iNextFeature == m_apoFeatures.size() )
+    {
+        m_pszCurLayerName = nullptr;
+        return nullptr;
+    }
+    m_pszCurLayerName = m_apoFeatures[m_iNextFeature]->osLayerName.c_str();
+    return m_pszCurLayerName;
+}
+
+bool OGRMVTSpillFilesReader::GetNextFeature(const void*& pabyBlob,
+                                            int& nBlobSize)
+{
+    if( m_pszCurLayerName == nullptr ||
+        m_iNextFeature == m_apoFeatures.size() ||
+        m_apoFeatures[m_iNextFeature]->osLayerName != m_pszCurLayerName )
+    {
+        return false;
+    }
+    const std::string& osBlob = m_apoFeatures[m_iNextFeature]->osBlob;
+    pabyBlob = osBlob.data();
+    nBlobSize = static_cast<int>(osBlob.size());
+    m_iNextFeature ++;
+    return true;
+}
+
+bool OGRMVTSpillFilesReader::StartLargestFeaturesReading(unsigned nLimit)
+{
+    std::sort(m_apoLargest.begin(), m_apoLargest.end(), AreaGreater);
+    m_nLargestLimit = std::min(static_cast<size_t>(nLimit),
+                               m_apoLargest.size());
+    m_iNextLargest = 0;
+    return true;
+}
+
+bool OGRMVTSpillFilesReader::GetNextLargestFeature(const char*& pszLayerName,
+                                                   const void*& pabyBlob,
+                                                   int& nBlobSize)
+{
+    if( m_iNextLargest == m_nLargestLimit )
+        return false;
+    const Record* psRecord = m_apoLargest[m_iNextLargest].get();
+    pszLayerName = psRecord->osLayerName.c_str();
+    pabyBlob = psRecord->osBlob.data();
+    nBlobSize = static_cast<int>(psRecord->osBlob.size());
+    m_iNextLargest ++;
+    return true;
+}
+
+/************************************************************************/
+/*                            CreateOutput()                            */
+/************************************************************************/
+
+bool OGRMVTWriterDataset::CreateOutput()
+{
+    if( m_bThreadPoolOK )
+        m_oThreadPool.WaitCompletion();
+
+    std::map<CPLString, MVTLayerProperties> oMapLayerProps;
+    std::set<CPLString> oSetLayers;
+
+    if( !m_oEnvelope.IsInit() )
+    {
+        return GenerateMetadata(0, oMapLayerProps);
+    }
+
+    std::unique_ptr<OGRMVTTempTileReader> poReader;
+    if( m_bUseSpillFiles )
+    {
+        if( !m_anSpillRecordOffsets.empty() &&
+            !WriteSpillFile(m_abySpillBuffer, m_anSpillRecordOffsets) )
+        {
+            return false;
+        }
+
+        std::vector<VSILFILE*> apoFiles;
+        for( const auto& oSpillFile: m_aoSpillFiles )
+        {
+            if( oSpillFile.second == nullptr )
+                return false;
+            apoFiles.push_back(oSpillFile.second);
+        }
+        CPLDebug("MVT", "Building output file from %d spill files...",
+                 static_cast<int>(apoFiles.size()));
+        poReader.reset(new OGRMVTSpillFilesReader(apoFiles, m_nMaxFeatures));
+    }
+    else
+    {
+        CPLDebug("MVT", "Building output file from temporary database...");
+        auto poSQLiteReader = new OGRMVTSQLiteTileReader(m_hDB);
+        poReader.reset(poSQLiteReader);
+        if( !poSQLiteReader->Init() )
+            return false;
+    }
 
     sqlite3_stmt* hInsertStmt = nullptr;
     if( m_hDBMBTILES )
@@ -5358,9 +5892,6 @@ bool OGRMVTWriterDataset::CreateOutput()
         if( hInsertStmt == nullptr )
         {
             CPLError(CE_Failure, CPLE_AppDefined, "Prepared statement failed");
-            sqlite3_finalize(hStmtZXY);
-            sqlite3_finalize(hStmtLayer);
-            sqlite3_finalize(hStmtRows);
             return false;
         }
     }
@@ -5370,16 +5901,14 @@ bool OGRMVTWriterDataset::CreateOutput()
     bool bRet = true;
     GIntBig nTempTilesRead = 0;
 
-    while( sqlite3_step(hStmtZXY) == SQLITE_ROW )
+    int nZ = 0;
+    int nX = 0;
+    int nY = 0;
+    while( poReader->GetNextTile(nZ, nX, nY) )
     {
-        int nZ = sqlite3_column_int(hStmtZXY, 0);
-        int nX = sqlite3_column_int(hStmtZXY, 1);
-        int nY = sqlite3_column_int(hStmtZXY, 2);
-
         std::string oTileBuffer(
             EncodeTile(nZ, nX, nY,
-                       hStmtLayer,
-                       hStmtRows,
+                       *poReader,
                        oMapLayerProps,
                        oSetLayers,
                        nTempTilesRead));
@@ -5442,9 +5971,8 @@ bool OGRMVTWriterDataset::CreateOutput()
             break;
         }
     }
-    sqlite3_finalize(hStmtZXY);
-    sqlite3_finalize(hStmtLayer);
-    sqlite3_finalize(hStmtRows);
+    if( poReader->HasError() )
+        bRet = false;
     if( hInsertStmt )
         sqlite3_finalize(hInsertStmt);
 
@@ -6138,61 +6666,74 @@ GDALDataset* OGRMVTWriterDataset::Create( const char * pszFilename,
     CPLString osTempDB =
         CSLFetchNameValueDef(papszOptions, "TEMPORARY_DB",
                              osTempDBDefault.c_str());
-    if( !bReuseTempFile )
-        VSIUnlink(osTempDB);
-
-    sqlite3* hDB = nullptr;
-    CPL_IGNORE_RET_VAL(sqlite3_open_v2(osTempDB, &hDB,
-                    SQLITE_OPEN_READWRITE |
-                    (bReuseTempFile ? 0 : SQLITE_OPEN_CREATE) |
-                    SQLITE_OPEN_NOMUTEX,
-                    poDS->m_pMyVFS->zName));
-    if( hDB == nullptr )
+    const char* pszTempStorage =
+        CSLFetchNameValueDef(papszOptions, "TEMPORARY_STORAGE", "SQLITE");
+    if( EQUAL(pszTempStorage, "FILES") && !bReuseTempFile )
     {
-        CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
-                 osTempDB.c_str());
-        delete poDS;
-        return nullptr;
-    }
-    poDS->m_osTempDB = osTempDB;
-    poDS->m_hDB = hDB;
-    poDS->m_bReuseTempFile = bReuseTempFile;
-
-    // For Unix
-    if( !poDS->m_bReuseTempFile &&
-        CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")) )
-    {
-        VSIUnlink(osTempDB);
-    }
-
-    if( poDS->m_bReuseTempFile )
-    {
-        poDS->m_nTempTiles = SQLGetInteger64(
-            hDB, "SELECT COUNT(*) FROM temp", nullptr );
+        poDS->m_bUseSpillFiles = true;
+        poDS->m_osSpillFilePrefix = CPLResetExtension(osTempDB, "");
+        poDS->m_nSpillBufferMaxSize = static_cast<size_t>(std::max(1.0,
+            CPLAtof(CPLGetConfigOption("OGR_MVT_SPILL_BUFFER_SIZE_MB",
+                                       "100")) * 1024 * 1024));
     }
     else
     {
-        CPL_IGNORE_RET_VAL(SQLCommand(hDB,
-            "PRAGMA page_size = 4096;" // 4096: default since sqlite 3.12
-            "PRAGMA synchronous = OFF;"
-            "PRAGMA journal_mode = OFF;"
-            "PRAGMA temp_store = MEMORY;"
-            "CREATE TABLE temp(z INTEGER, x INTEGER, y INTEGER, layer TEXT, "
-            "idx INTEGER, feature BLOB, geomtype INTEGER, area_or_length DOUBLE);"
-            "CREATE INDEX temp_index ON temp (z, x, y, layer, idx);"));
-    }
+        if( !bReuseTempFile )
+            VSIUnlink(osTempDB);
 
-    sqlite3_stmt* hInsertStmt = nullptr;
-    CPL_IGNORE_RET_VAL(sqlite3_prepare_v2( hDB,
-        "INSERT INTO temp (z,x,y,layer,idx,feature,geomtype,area_or_length) "
-        "VALUES (?,?,?,?,?,?,?,?)",
-        -1, &hInsertStmt, nullptr) );
-    if( hInsertStmt == nullptr )
-    {
-        delete poDS;
-        return nullptr;
+        sqlite3* hDB = nullptr;
+        CPL_IGNORE_RET_VAL(sqlite3_open_v2(osTempDB, &hDB,
+                        SQLITE_OPEN_READWRITE |
+                        (bReuseTempFile ? 0 : SQLITE_OPEN_CREATE) |
+                        SQLITE_OPEN_NOMUTEX,
+                        poDS->m_pMyVFS->zName));
+        if( hDB == nullptr )
+        {
+            CPLError(CE_Failure, CPLE_FileIO, "Cannot create %s",
+                     osTempDB.c_str());
+            delete poDS;
+            return nullptr;
+        }
+        poDS->m_osTempDB = osTempDB;
+        poDS->m_hDB = hDB;
+        poDS->m_bReuseTempFile = bReuseTempFile;
+
+        // For Unix
+        if( !poDS->m_bReuseTempFile &&
+            CPLTestBool(CPLGetConfigOption("OGR_MVT_REMOVE_TEMP_FILE", "YES")) )
+        {
+            VSIUnlink(osTempDB);
+        }
+
+        if( poDS->m_bReuseTempFile )
+        {
+            poDS->m_nTempTiles = SQLGetInteger64(
+                hDB, "SELECT COUNT(*) FROM temp", nullptr );
+        }
+        else
+        {
+            CPL_IGNORE_RET_VAL(SQLCommand(hDB,
+                "PRAGMA page_size = 4096;" // 4096: default since sqlite 3.12
+                "PRAGMA synchronous = OFF;"
+                "PRAGMA journal_mode = OFF;"
+                "PRAGMA temp_store = MEMORY;"
+                "CREATE TABLE temp(z INTEGER, x INTEGER, y INTEGER, layer TEXT, "
+                "idx INTEGER, feature BLOB, geomtype INTEGER, area_or_length DOUBLE);"
+                "CREATE INDEX temp_index ON temp (z, x, y, layer, idx);"));
+        }
+
+        sqlite3_stmt* hInsertStmt = nullptr;
+        CPL_IGNORE_RET_VAL(sqlite3_prepare_v2( hDB,
+            "INSERT INTO temp (z,x,y,layer,idx,feature,geomtype,area_or_length) "
+            "VALUES (?,?,?,?,?,?,?,?)",
+            -1, &hInsertStmt, nullptr) );
+        if( hInsertStmt == nullptr )
+        {
+            delete poDS;
+            return nullptr;
+        }
+        poDS->m_hInsertStmt = hInsertStmt;
     }
-    poDS->m_hInsertStmt = hInsertStmt;
 
     poDS->m_nMinZoom = atoi(CSLFetchNameValueDef(papszOptions, "MINZOOM",
                                         CPLSPrintf("%d",poDS->m_nMinZoom)));
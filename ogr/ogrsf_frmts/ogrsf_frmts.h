@@ -56,6 +56,8 @@ class OGRLayerAttrIndex;
 class OGRSFDriver;
 
 struct ArrowArrayStream;
+struct ArrowSchema;
+struct ArrowArray;
 
 /************************************************************************/
 /*                               OGRLayer                               */
@@ -64,6 +66,23 @@ struct ArrowArrayStream;
 /**
  * This class represents a layer of simple features, with access methods.
  *
+ * \anchor OGRLayer_overlay_options
+ * <b>Options common to the overlay methods.</b> Intersection(), Union(),
+ * SymDifference(), Identity(), Update(), Clip() and Erase() recognize the
+ * following options, in addition to their own ones (GDAL >= 3.7):
+ * <ul>
+ * <li>USE_SPATIAL_INDEX=YES/NO. Set to YES to load the features of the
+ *     method layer (and, for Union() and SymDifference(), of this layer
+ *     too) in a temporary in-memory spatial index, instead of setting a
+ *     spatial filter on that layer for each feature of the other one. This
+ *     is much faster with most drivers, but requires those features to fit
+ *     in memory. Defaults to NO.
+ * <li>NUM_THREADS=number/ALL_CPUS. Only used by Intersection(), Clip() and
+ *     Erase() when USE_SPATIAL_INDEX=YES. Number of threads used to process
+ *     the features of this layer. Defaults to the value of the
+ *     GDAL_NUM_THREADS configuration option, or 1. The result features are
+ *     written in the same order as with a single thread.
+ * </ul>
  */
 
 /* Note: any virtual method added to this class must also be added in the */
@@ -106,6 +125,9 @@ class CPL_DLL OGRLayer : public GDALMajorObject
 
     int          FilterGeometry( OGRGeometry * );
     //int          FilterGeometry( OGRGeometry *, OGREnvelope* psGeometryEnvelope);
+    bool         FilterWKBGeometry( const GByte* pabyWKB, size_t nWKBSize,
+                                    bool bEnvelopeAlreadySet,
+                                    OGREnvelope& sEnvelope );
     int          InstallFilter( OGRGeometry * );
 
     OGRErr       GetExtentInternal(int iGeomField, OGREnvelope *psExtent, int bForce );
@@ -178,6 +200,9 @@ class CPL_DLL OGRLayer : public GDALMajorObject
     virtual GDALDataset* GetDataset();
     virtual bool         GetArrowStream(struct ArrowArrayStream* out_stream,
                                         CSLConstList papszOptions = nullptr);
+    virtual bool         WriteArrowBatch(const struct ArrowSchema* schema,
+                                         struct ArrowArray* array,
+                                         CSLConstList papszOptions = nullptr);
 
     OGRErr      SetFeature( OGRFeature *poFeature )  CPL_WARN_UNUSED_RESULT;
     OGRErr      CreateFeature( OGRFeature *poFeature ) CPL_WARN_UNUSED_RESULT;
@@ -1370,6 +1370,28 @@ int FileGDBTable::SelectRow(int iRow)
     const int errorRetValue = FALSE;
     returnErrorAndCleanupIf(iRow < 0 || iRow >= m_nTotalRecordCount, m_nCurRow = -1 );
 
+    if( m_nCurRow != iRow && !m_oMapPrefetchedRows.empty() )
+    {
+        auto oIter = m_oMapPrefetchedRows.find(iRow);
+        if( oIter != m_oMapPrefetchedRows.end() )
+        {
+            std::swap(m_abyBuffer, oIter->second);
+            m_oMapPrefetchedRows.erase(oIter);
+            m_nRowBlobLength = static_cast<GUInt32>(
+                m_abyBuffer.size() - ZEROES_AFTER_END_OF_BUFFER);
+            m_nRowBufferMaxSize = std::max(m_nRowBufferMaxSize, m_nRowBlobLength);
+            m_bIsDeleted = FALSE;
+
+            m_nCurRow = iRow;
+            m_nLastCol = -1;
+            m_pabyIterVals = m_abyBuffer.data() + m_nNullableFieldsSizeInBytes;
+            m_iAccNullable = 0;
+            m_bError = FALSE;
+            m_nChSaved = -1;
+            return TRUE;
+        }
+    }
+
     if( m_nCurRow != iRow )
     {
         vsi_l_offset nOffsetTable = GetOffsetInTableForRow(iRow);
@@ -1447,6 +1469,89 @@ int FileGDBTable::SelectRow(int iRow)
     return TRUE;
 }
 
+/************************************************************************/
+/*                            PrefetchRows()                            */
+/*                                                                      */
+/*      Reads the blobs of the passed rows in increasing order of their */
+/*      offset in the .gdbtable, so that rows selected through an       */
+/*      index, and thus sorted by FID, are read with near-sequential    */
+/*      I/O. A later SelectRow() on one of those rows then uses the     */
+/*      prefetched blob. This is a best effort: rows that cannot be     */
+/*      prefetched are read as usual by SelectRow(), which reports      */
+/*      errors. The caller must call ClearPrefetchedRows() before the   */
+/*      table is modified.                                              */
+/************************************************************************/
+
+void FileGDBTable::PrefetchRows(const std::vector<int>& anRows)
+{
+    m_oMapPrefetchedRows.clear();
+    if( m_bHasDeletedFeaturesListed || anRows.size() < 2 )
+        return;
+
+    std::vector<std::pair<vsi_l_offset, int>> anOffsetAndRows;
+    anOffsetAndRows.reserve(anRows.size());
+    for( const int iRow: anRows )
+    {
+        if( iRow < 0 || iRow >= m_nTotalRecordCount )
+            continue;
+        const vsi_l_offset nOffset = GetOffsetInTableForRow(iRow);
+        if( m_bError )
+        {
+            m_bError = FALSE;
+            return;
+        }
+        if( nOffset != 0 && !m_bIsDeleted )
+            anOffsetAndRows.emplace_back(nOffset, iRow);
+    }
+    m_bIsDeleted = FALSE;
+    std::sort(anOffsetAndRows.begin(), anOffsetAndRows.end());
+
+    // Do not keep more than that in memory. Remaining rows will be read
+    // by SelectRow().
+    constexpr size_t MAX_PREFETCHED_BYTES = 100 * 1024 * 1024;
+    size_t nTotalSize = 0;
+    for( const auto& oOffsetAndRow: anOffsetAndRows )
+    {
+        const vsi_l_offset nOffset = oOffsetAndRow.first;
+        GByte abyBuffer[4];
+        if( VSIFSeekL(m_fpTable, nOffset, SEEK_SET) != 0 ||
+            VSIFReadL(abyBuffer, 4, 1, m_fpTable) != 1 )
+        {
+            break;
+        }
+        const GUInt32 nRowBlobLength = GetUInt32(abyBuffer, 0);
+        // Zero-length rows are left to SelectRow(), which does not read
+        // them through a blob.
+        if( nRowBlobLength == 0 )
+            continue;
+        // Same sanity checks as in SelectRow(). Blobs larger than
+        // MAX_PREFETCHED_BYTES are never prefetched, so there is no need for
+        // its check against the file size.
+        if( nRowBlobLength < static_cast<GUInt32>(m_nNullableFieldsSizeInBytes) ||
+            nRowBlobLength > INT_MAX - ZEROES_AFTER_END_OF_BUFFER ||
+            nRowBlobLength > MAX_PREFETCHED_BYTES - nTotalSize )
+        {
+            break;
+        }
+
+        std::vector<GByte> abyBlob;
+        try
+        {
+            abyBlob.resize(nRowBlobLength + ZEROES_AFTER_END_OF_BUFFER);
+        }
+        catch( const std::exception& )
+        {
+            break;
+        }
+        if( VSIFReadL(abyBlob.data(), nRowBlobLength, 1, m_fpTable) != 1 )
+        {
+            break;
+        }
+        nTotalSize += nRowBlobLength;
+        m_oMapPrefetchedRows[oOffsetAndRow.second] = std::move(abyBlob);
+    }
+}
+
 /************************************************************************/
 /*                      FileGDBDoubleDateToOGRDate()                    */
 /************************************************************************/
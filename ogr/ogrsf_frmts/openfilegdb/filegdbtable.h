@@ -35,6 +35,7 @@
 #include "ogr_geometry.h"
 
 #include <limits>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -352,6 +353,10 @@ class FileGDBTable
 
         std::string                 m_osCacheRasterFieldPath{};
 
+        // Row blobs (followed by ZEROES_AFTER_END_OF_BUFFER bytes) read by
+        // PrefetchRows(), indexed by row number.
+        std::map<int, std::vector<GByte>> m_oMapPrefetchedRows{};
+
         GUIntBig                    m_nFilterXMin = 0, m_nFilterXMax = 0, m_nFilterYMin = 0, m_nFilterYMax = 0;
 
         class WholeFileRewriter
@@ -467,6 +472,8 @@ class FileGDBTable
        /* Next call to SelectRow() or GetFieldValue() invalidates previously returned values */
        int                      SelectRow(int iRow);
        int                      GetAndSelectNextNonEmptyRow(int iRow);
+       void                     PrefetchRows(const std::vector<int>& anRows);
+       void                     ClearPrefetchedRows() { m_oMapPrefetchedRows.clear(); }
        int                      HasGotError() const { return m_bError; }
        int                      GetCurRow() const { return m_nCurRow; }
        int                      IsCurRowDeleted() const { return m_bIsDeleted; }
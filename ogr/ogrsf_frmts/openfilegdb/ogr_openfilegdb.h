@@ -86,6 +86,7 @@ constexpr const char* pszDatasetsRelatedThroughUUID = "{725badab-3452-491b-a795-
 class OGROpenFileGDBDataSource;
 class OGROpenFileGDBGeomFieldDefn;
 class OGROpenFileGDBFeatureDefn;
+class OGRArrowArrayHelper;
 
 typedef enum
 {
@@ -130,6 +131,11 @@ class OGROpenFileGDBLayer final: public OGRLayer
     int               BuildLayerDefinition();
     int               BuildGeometryColumnGDBv10(const std::string& osParentDefinition);
     OGRFeature       *GetCurrentFeature();
+    OGRGeometry      *GetGeometryFromField(const OGRField* psField);
+    int               AddCurrentRowToArrowArray(OGRArrowArrayHelper& sHelper,
+                                                struct ArrowArray* out_array,
+                                                int iFeat, int iArrowGeomField,
+                                                struct tm& brokenDown);
 
     std::unique_ptr<FileGDBOGRGeometryConverter> m_poGeomConverter{};
 
@@ -225,6 +231,8 @@ public:
 
   virtual void        ResetReading() override;
   virtual OGRFeature* GetNextFeature() override;
+  virtual int         GetNextArrowArray(struct ArrowArrayStream*,
+                                        struct ArrowArray* out_array) override;
   virtual OGRFeature* GetFeature( GIntBig nFeatureId ) override;
   virtual OGRErr      SetNextByIndex( GIntBig nIndex ) override;
 
@@ -29,6 +29,7 @@
 #include "cpl_port.h"
 #include "ogr_openfilegdb.h"
 
+#include <cerrno>
 #include <cmath>
 #include <cstddef>
 #include <cstdio>
@@ -36,7 +37,9 @@
 #include <cstring>
 #include <cwchar>
 #include <algorithm>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -49,6 +52,7 @@
 #include "ogr_geometry.h"
 #include "ogr_spatialref.h"
 #include "ogr_srs_api.h"
+#include "ograrrowarrayhelper.h"
 #include "ogrsf_frmts.h"
 #include "filegdbtable.h"
 #include "ogr_swq.h"
@@ -1619,6 +1623,39 @@ void OGROpenFileGDBLayer::BuildCombinedIterator()
     }
 }
 
+/***********************************************************************/
+/*                        GetGeometryFromField()                       */
+/***********************************************************************/
+
+OGRGeometry* OGROpenFileGDBLayer::GetGeometryFromField(const OGRField* psField)
+{
+    OGRGeometry* poGeom = m_poGeomConverter->GetAsGeometry(psField);
+    if( poGeom != nullptr )
+    {
+        OGRwkbGeometryType eFlattenType = wkbFlatten(poGeom->getGeometryType());
+        if( eFlattenType == wkbPolygon )
+            poGeom = OGRGeometryFactory::forceToMultiPolygon(poGeom);
+        else if( eFlattenType == wkbCurvePolygon)
+        {
+            OGRMultiSurface* poMS = new OGRMultiSurface();
+            poMS->addGeometryDirectly( poGeom );
+            poGeom = poMS;
+        }
+        else if( eFlattenType == wkbLineString )
+            poGeom = OGRGeometryFactory::forceToMultiLineString(poGeom);
+        else if (eFlattenType == wkbCompoundCurve)
+        {
+            OGRMultiCurve* poMC = new OGRMultiCurve();
+            poMC->addGeometryDirectly( poGeom );
+            poGeom = poMC;
+        }
+
+        poGeom->assignSpatialReference(
+            m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef() );
+    }
+    return poGeom;
+}
+
 /***********************************************************************/
 /*                         GetCurrentFeature()                         */
 /***********************************************************************/
@@ -1667,30 +1704,9 @@ OGRFeature* OGROpenFileGDBLayer::GetCurrentFeature()
                     return nullptr;
                 }
 
-                OGRGeometry* poGeom = m_poGeomConverter->GetAsGeometry(psField);
+                OGRGeometry* poGeom = GetGeometryFromField(psField);
                 if( poGeom != nullptr )
                 {
-                    OGRwkbGeometryType eFlattenType = wkbFlatten(poGeom->getGeometryType());
-                    if( eFlattenType == wkbPolygon )
-                        poGeom = OGRGeometryFactory::forceToMultiPolygon(poGeom);
-                    else if( eFlattenType == wkbCurvePolygon)
-                    {
-                        OGRMultiSurface* poMS = new OGRMultiSurface();
-                        poMS->addGeometryDirectly( poGeom );
-                        poGeom = poMS;
-                    }
-                    else if( eFlattenType == wkbLineString )
-                        poGeom = OGRGeometryFactory::forceToMultiLineString(poGeom);
-                    else if (eFlattenType == wkbCompoundCurve)
-                    {
-                        OGRMultiCurve* poMC = new OGRMultiCurve();
-                        poMC->addGeometryDirectly( poGeom );
-                        poGeom = poMC;
-                    }
-
-                    poGeom->assignSpatialReference(
-                        m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef() );
-
                     if( poFeature == nullptr )
                         poFeature = new OGRFeature(m_poFeatureDefn);
                     poFeature->SetGeometryDirectly( poGeom );
@@ -1844,6 +1860,338 @@ OGRFeature* OGROpenFileGDBLayer::GetNextFeature()
     }
 }
 
+/***********************************************************************/
+/*                     AddCurrentRowToArrowArray()                     */
+/*                                                                     */
+/*      Decodes the currently selected row into slot iFeat of the      */
+/*      Arrow array. Returns 0 if the row was added, -1 if it was      */
+/*      discarded by the spatial filter, or an errno value.            */
+/***********************************************************************/
+
+int OGROpenFileGDBLayer::AddCurrentRowToArrowArray(OGRArrowArrayHelper& sHelper,
+                                                   struct ArrowArray* out_array,
+                                                   int iFeat,
+                                                   int iArrowGeomField,
+                                                   struct tm& brokenDown)
+{
+    const int iRow = m_poLyrTable->GetCurRow();
+
+/* -------------------------------------------------------------------- */
+/*      Geometry first, so that a row discarded by the spatial filter   */
+/*      does not leave attribute values in the slot to reuse.           */
+/* -------------------------------------------------------------------- */
+    if( iArrowGeomField >= 0 )
+    {
+        const OGRField* psField = m_poLyrTable->GetFieldValue(m_iGeomFieldIdx);
+        std::unique_ptr<OGRGeometry> poGeom;
+        if( psField != nullptr )
+        {
+            if( m_eSpatialIndexState == SPI_IN_BUILDING )
+            {
+                OGREnvelope sFeatureEnvelope;
+                if( m_poLyrTable->GetFeatureExtent(psField,
+                                                   &sFeatureEnvelope) )
+                {
+                    CPLRectObj sBounds;
+                    sBounds.minx = sFeatureEnvelope.MinX;
+                    sBounds.miny = sFeatureEnvelope.MinY;
+                    sBounds.maxx = sFeatureEnvelope.MaxX;
+                    sBounds.maxy = sFeatureEnvelope.MaxY;
+                    CPLQuadTreeInsertWithBounds(m_pQuadTree,
+                                                reinterpret_cast<void*>(static_cast<uintptr_t>(iRow)),
+                                                &sBounds);
+                }
+            }
+
+            if( m_poFilterGeom != nullptr &&
+                m_eSpatialIndexState != SPI_COMPLETED &&
+                !m_poLyrTable->DoesGeometryIntersectsFilterEnvelope(psField) )
+            {
+                return -1;
+            }
+
+            poGeom.reset(GetGeometryFromField(psField));
+        }
+
+        if( m_poFilterGeom != nullptr && !FilterGeometry(poGeom.get()) )
+        {
+            return -1;
+        }
+
+        if( poGeom == nullptr )
+        {
+            if( !sHelper.SetNull(iArrowGeomField, iFeat) )
+                return ENOMEM;
+        }
+        else
+        {
+            const size_t nWKBSize = poGeom->WkbSize();
+            GByte* outPtr = sHelper.GetPtrForStringOrBinary(
+                iArrowGeomField, iFeat, nWKBSize);
+            if( outPtr == nullptr )
+                return ENOMEM;
+            poGeom->exportToWkb(wkbNDR, outPtr, wkbVariantIso);
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Attributes, directly from the decoded raw values.               */
+/* -------------------------------------------------------------------- */
+    int iOGRIdx = 0;
+    for( int iGDBIdx = 0; iGDBIdx < m_poLyrTable->GetFieldCount(); iGDBIdx++ )
+    {
+        if( iGDBIdx == m_iGeomFieldIdx ||
+            iGDBIdx == m_poLyrTable->GetObjectIdFieldIdx() )
+        {
+            continue;
+        }
+        const int iArrowField = sHelper.mapOGRFieldToArrowField[iOGRIdx];
+        const OGRFieldDefn* poFieldDefn =
+            m_poFeatureDefn->GetFieldDefnUnsafe(iOGRIdx);
+        iOGRIdx++;
+        if( iArrowField < 0 )
+            continue;
+
+        const OGRField* psField = m_poLyrTable->GetFieldValue(iGDBIdx);
+        if( psField == nullptr )
+        {
+            if( !sHelper.SetNull(iArrowField, iFeat) )
+                return ENOMEM;
+            continue;
+        }
+
+        auto psArray = out_array->children[iArrowField];
+        switch( poFieldDefn->GetType() )
+        {
+            case OFTInteger:
+            {
+                if( poFieldDefn->GetSubType() == OFSTInt16 )
+                {
+                    sHelper.SetInt16(psArray, iFeat,
+                                     static_cast<int16_t>(psField->Integer));
+                }
+                else
+                {
+                    sHelper.SetInt32(psArray, iFeat, psField->Integer);
+                }
+                break;
+            }
+
+            case OFTReal:
+            {
+                if( poFieldDefn->GetSubType() == OFSTFloat32 )
+                {
+                    sHelper.SetFloat(psArray, iFeat,
+                                     static_cast<float>(psField->Real));
+                }
+                else
+                {
+                    sHelper.SetDouble(psArray, iFeat, psField->Real);
+                }
+                break;
+            }
+
+            case OFTString:
+            {
+                const size_t nBytes = strlen(psField->String);
+                GByte* outPtr = sHelper.GetPtrForStringOrBinary(
+                    iArrowField, iFeat, nBytes);
+                if( outPtr == nullptr )
+                    return ENOMEM;
+                memcpy(outPtr, psField->String, nBytes);
+                break;
+            }
+
+            case OFTBinary:
+            {
+                const size_t nBytes = static_cast<size_t>(psField->Binary.nCount);
+                GByte* outPtr = sHelper.GetPtrForStringOrBinary(
+                    iArrowField, iFeat, nBytes);
+                if( outPtr == nullptr )
+                    return ENOMEM;
+                if( nBytes )
+                    memcpy(outPtr, psField->Binary.paData, nBytes);
+                break;
+            }
+
+            case OFTDateTime:
+            {
+                OGRField sField = *psField;
+                sField.Date.TZFlag = m_bTimeInUTC ? 100 : 0;
+                sHelper.SetDateTime(psArray, iFeat, brokenDown, sField);
+                break;
+            }
+
+            default:
+                CPLAssert( false );
+                break;
+        }
+    }
+
+    if( sHelper.panFIDValues )
+        sHelper.panFIDValues[iFeat] = iRow + 1;
+
+    return 0;
+}
+
+/***********************************************************************/
+/*                        GetNextArrowArray()                          */
+/*                                                                     */
+/*      Decodes rows directly into the Arrow columns, without building */
+/*      OGRFeature objects. When rows are selected through an index,   */
+/*      they are fetched by batches in increasing order of their       */
+/*      offset in the .gdbtable, and returned in FID order.            */
+/***********************************************************************/
+
+int OGROpenFileGDBLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
+                                           struct ArrowArray* out_array)
+{
+    if( !BuildLayerDefinition() )
+    {
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    }
+
+    const bool bGeomIgnored =
+        m_iGeomFieldIdx < 0 ||
+        m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored();
+    if( (m_poAttrQuery != nullptr &&
+         !(m_poAttributeIterator != nullptr &&
+           m_bIteratorSufficientToEvaluateFilter)) ||
+        (m_poFilterGeom != nullptr && bGeomIgnored) ||
+        m_poLyrTable->HasDeletedFeaturesListed() ||
+        m_iFieldToReadAsBinary >= 0 ||
+        CPLTestBool(CPLGetConfigOption("OGR_OPENFILEGDB_STREAM_BASE_IMPL", "NO")) )
+    {
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+
+    memset(out_array, 0, sizeof(*out_array));
+    if( m_bEOF )
+        return 0;
+
+    OGRArrowArrayHelper sHelper(m_poDS, m_poFeatureDefn,
+                                m_aosArrowArrayStreamOptions, out_array);
+    if( out_array->release == nullptr )
+    {
+        return ENOMEM;
+    }
+
+    const int iArrowGeomField = (!bGeomIgnored && sHelper.nGeomFieldCount > 0) ?
+                                    sHelper.mapOGRGeomFieldToArrowField[0] : -1;
+    if( iArrowGeomField < 0 && m_eSpatialIndexState == SPI_IN_BUILDING )
+        m_eSpatialIndexState = SPI_INVALID;
+
+    FileGDBIterator* poIterator =
+        m_poCombinedIterator ? m_poCombinedIterator:
+        m_poSpatialIndexIterator ? m_poSpatialIndexIterator:
+        m_poAttributeIterator;
+
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+
+    int iFeat = 0;
+    if( m_nFilteredFeatureCount >= 0 || poIterator != nullptr )
+    {
+        // Collect the row numbers of the next candidate rows, sorted by
+        // FID, and read them in increasing offset order.
+        std::vector<int> anRows;
+        bool bSourceExhausted = false;
+        while( iFeat < sHelper.nMaxBatchSize && !bSourceExhausted )
+        {
+            anRows.clear();
+            while( static_cast<int>(anRows.size()) < sHelper.nMaxBatchSize - iFeat )
+            {
+                int iRow;
+                if( m_nFilteredFeatureCount >= 0 )
+                {
+                    if( m_iCurFeat >= m_nFilteredFeatureCount )
+                    {
+                        bSourceExhausted = true;
+                        break;
+                    }
+                    iRow = static_cast<int>(reinterpret_cast<GUIntptr_t>(
+                                    m_pahFilteredFeatures[m_iCurFeat++]));
+                }
+                else
+                {
+                    iRow = poIterator->GetNextRowSortedByFID();
+                    if( iRow < 0 )
+                    {
+                        bSourceExhausted = true;
+                        break;
+                    }
+                }
+                anRows.push_back(iRow);
+            }
+
+            m_poLyrTable->PrefetchRows(anRows);
+            for( const int iRow: anRows )
+            {
+                if( !m_poLyrTable->SelectRow(iRow) )
+                {
+                    if( m_poLyrTable->HasGotError() )
+                    {
+                        m_bEOF = TRUE;
+                        bSourceExhausted = true;
+                        break;
+                    }
+                    continue;
+                }
+                const int nRet = AddCurrentRowToArrowArray(
+                    sHelper, out_array, iFeat, iArrowGeomField, brokenDown);
+                if( nRet > 0 )
+                {
+                    m_poLyrTable->ClearPrefetchedRows();
+                    sHelper.ClearArray();
+                    return nRet;
+                }
+                if( nRet == 0 )
+                    iFeat++;
+            }
+            m_poLyrTable->ClearPrefetchedRows();
+        }
+    }
+    else
+    {
+        while( iFeat < sHelper.nMaxBatchSize )
+        {
+            if( m_iCurFeat == m_poLyrTable->GetTotalRecordCount() )
+                break;
+            m_iCurFeat = m_poLyrTable->GetAndSelectNextNonEmptyRow(m_iCurFeat);
+            if( m_iCurFeat < 0 )
+            {
+                m_bEOF = TRUE;
+                break;
+            }
+            m_iCurFeat ++;
+            const int nRet = AddCurrentRowToArrowArray(
+                sHelper, out_array, iFeat, iArrowGeomField, brokenDown);
+            if( m_eSpatialIndexState == SPI_IN_BUILDING &&
+                m_iCurFeat == m_poLyrTable->GetTotalRecordCount() )
+            {
+                CPLDebug("OpenFileGDB", "SPI_COMPLETED");
+                m_eSpatialIndexState = SPI_COMPLETED;
+            }
+            if( nRet > 0 )
+            {
+                sHelper.ClearArray();
+                return nRet;
+            }
+            if( nRet == 0 )
+                iFeat++;
+        }
+    }
+
+    if( iFeat == 0 )
+    {
+        sHelper.ClearArray();
+        return 0;
+    }
+    sHelper.Shrink(iFeat);
+    return 0;
+}
+
 /***********************************************************************/
 /*                          GetFeature()                               */
 /***********************************************************************/
@@ -2140,6 +2488,15 @@ int OGROpenFileGDBLayer::TestCapability( const char * pszCap )
         return m_eSpatialIndexState == SPI_COMPLETED || m_poLyrTable->HasSpatialIndex();
     }
 
+    else if( EQUAL(pszCap, OLCFastGetArrowStream) )
+    {
+        return ( m_poAttrQuery == nullptr ||
+                 (m_poAttributeIterator != nullptr &&
+                  m_bIteratorSufficientToEvaluateFilter) ) &&
+               !m_poLyrTable->HasDeletedFeaturesListed() &&
+               m_iFieldToReadAsBinary < 0;
+    }
+
     return FALSE;
 }
 
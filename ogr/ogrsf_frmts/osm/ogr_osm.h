@@ -35,6 +35,7 @@
 
 #include "ogrsf_frmts.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 
 #include <array>
 #include <set>
@@ -275,10 +276,23 @@ typedef struct
     IndexedKVP*         pasTags; /*  point to a sub-array of OGROSMDataSource.pasAccumulatedTags */
     OSMInfo             sInfo;
     OGRFeature         *poFeature;
+    unsigned int        nResolvedRefs; /* set by ResolveWays() */
     bool       bIsArea : 1;
     bool       bAttrFilterAlreadyEvaluated : 1;
 } WayFeaturePair;
 
+/* Members of a multipolygon relation, collected sequentially, whose */
+/* polygon assembly is deferred so that it can run on a worker thread. */
+typedef struct
+{
+    GIntBig                    nRelationID;
+    OGRFeature                *poFeature;
+    bool                       bAttrFilterAlreadyEvaluated;
+    OGRMultiLineString        *poMLS; /* ways that are not closed rings */
+    std::vector<OGRGeometry*>  apoPolygons;
+    OGRGeometry               *poGeom; /* set by AssembleMultiPolygon() */
+} MultiPolygonToAssemble;
+
 #ifdef ENABLE_NODE_LOOKUP_BY_HASHING
 typedef struct
 {
@@ -395,6 +409,12 @@ class OGROSMDataSource final: public OGRDataSource
     int                 nNonRedundantValuesLen = 0;
     WayFeaturePair     *m_pasWayFeaturePairs = nullptr;
     int                 m_nWayFeaturePairs = 0;
+    std::vector<std::vector<GByte>> m_aabyCompressedWays{}; /* indexed like m_pasWayFeaturePairs */
+
+    std::vector<MultiPolygonToAssemble> m_asMultiPolygonsToAssemble{};
+
+    CPLWorkerThreadPool *m_poWTP = nullptr;
+    int                 m_nMinWaysPerJob = 0;
 
     std::vector<KeyDesc*>         m_asKeys{};
     std::map<const char*, KeyDesc*, ConstCharComp> m_aoMapIndexedKeys{}; /* map that is the reverse of asKeys */
@@ -442,15 +462,16 @@ class OGROSMDataSource final: public OGRDataSource
     bool                FlushCurrentSectorNonCompressedCase();
     bool                IndexPointCustom( OSMNode* psNode );
 
-    void                IndexWay(GIntBig nWayID, bool bIsArea,
-                                 unsigned int nTags, IndexedKVP* pasTags,
-                                 LonLat* pasLonLatPairs, int nPairs,
-                                 OSMInfo* psInfo);
+    void                IndexWay(GIntBig nWayID,
+                                 const std::vector<GByte>& abyCompressedWay);
 
     bool                StartTransactionCacheDB();
     bool                CommitTransactionCacheDB();
 
-    int                 FindNode(GIntBig nID);
+    int                 FindNode(GIntBig nID) const;
+    void                ResolveWays(int iFirstPair, int iLastPair,
+                                    std::vector<LonLat>& asLonLatCache);
+    static void         ResolveWaysJob(void* pData);
     void                ProcessWaysBatch();
 
     void                ProcessPolygonsStandalone();
@@ -464,9 +485,12 @@ class OGROSMDataSource final: public OGRDataSource
     unsigned int        LookupWays( std::map< GIntBig, std::pair<int,void*> >& aoMapWays,
                                     OSMRelation* psRelation );
 
-    OGRGeometry*        BuildMultiPolygon(OSMRelation* psRelation,
-                                          unsigned int* pnTags,
-                                          OSMTag* pasTags);
+    bool                CollectMultiPolygonMembers(OSMRelation* psRelation,
+                                                   unsigned int* pnTags,
+                                                   OSMTag* pasTags,
+                                                   MultiPolygonToAssemble& sMP);
+    static void         AssembleMultiPolygon(void* pData);
+    void                ProcessMultiPolygonsBatch();
     OGRGeometry*        BuildGeometryCollection(OSMRelation* psRelation, int bMultiLineString);
 
     bool                TransferToDiskIfNecesserary();
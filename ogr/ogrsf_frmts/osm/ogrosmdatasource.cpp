@@ -146,6 +146,10 @@ constexpr int MAX_NON_REDUNDANT_VALUES = MAX_DELAYED_FEATURES * 10;
 constexpr int MAX_NON_REDUNDANT_KEYS = MAX_DELAYED_FEATURES * 10;
 // Max number of features that are accumulated in panUnsortedReqIds
 constexpr int MAX_ACCUMULATED_NODES = 1000000;
+// Default min number of ways of a batch processed by a worker thread.
+constexpr int MIN_WAYS_PER_JOB = 1000;
+// Max number of multipolygon relations whose assembly is deferred.
+constexpr int MAX_DELAYED_MULTIPOLYGONS = 1000;
 
 #ifdef ENABLE_NODE_LOOKUP_BY_HASHING
 // Size of panHashedIndexes array. Must be in the list at
@@ -284,6 +288,14 @@ OGROSMDataSource::~OGROSMDataSource()
     }
     CPLFree(m_pasWayFeaturePairs);
     CPLFree(m_pasAccumulatedTags);
+    for( auto& sMP: m_asMultiPolygonsToAssemble )
+    {
+        delete sMP.poFeature;
+        delete sMP.poMLS;
+        for( auto poPoly: sMP.apoPolygons )
+            delete poPoly;
+    }
+    delete m_poWTP;
     CPLFree(pabyNonRedundantKeys);
     CPLFree(pabyNonRedundantValues);
 
@@ -1564,28 +1576,17 @@ void OGROSMDataSource::UncompressWay( int nBytes, const GByte* pabyCompressedWay
 /*                              IndexWay()                              */
 /************************************************************************/
 
-void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
-                                unsigned int nTags, IndexedKVP* pasTags,
-                                LonLat* pasLonLatPairs, int nPairs,
-                                OSMInfo* psInfo)
+void OGROSMDataSource::IndexWay(GIntBig nWayID,
+                                const std::vector<GByte>& abyCompressedWay)
 {
     if( !m_bIndexWays )
         return;
 
     sqlite3_bind_int64( m_hInsertWayStmt, 1, nWayID );
 
-    const unsigned nTagsClamped = std::min(nTags, MAX_COUNT_FOR_TAGS_IN_WAY);
-    if( nTagsClamped < nTags )
-    {
-        CPLDebug("OSM", "Too many tags for way " CPL_FRMT_GIB ": %u. "
-                 "Clamping to %u",
-                 nWayID, nTags, nTagsClamped);
-    }
-    CompressWay (bIsArea, nTagsClamped, pasTags, nPairs, pasLonLatPairs, psInfo,
-                 m_abyWayBuffer);
     sqlite3_bind_blob( m_hInsertWayStmt, 2,
-                       m_abyWayBuffer.data(),
-                       static_cast<int>(m_abyWayBuffer.size()),
+                       abyCompressedWay.data(),
+                       static_cast<int>(abyCompressedWay.size()),
                        SQLITE_STATIC );
 
     int rc = sqlite3_step( m_hInsertWayStmt );
@@ -1602,7 +1603,7 @@ void OGROSMDataSource::IndexWay(GIntBig nWayID, bool bIsArea,
 /*                              FindNode()                              */
 /************************************************************************/
 
-int OGROSMDataSource::FindNode(GIntBig nID)
+int OGROSMDataSource::FindNode(GIntBig nID) const
 {
     if( m_nReqIds == 0 )
         return -1;
@@ -1622,22 +1623,28 @@ int OGROSMDataSource::FindNode(GIntBig nID)
 }
 
 /************************************************************************/
-/*                         ProcessWaysBatch()                           */
+/*                            ResolveWays()                             */
+/*                                                                      */
+/*      Resolves the node references of the ways in the                 */
+/*      [iFirstPair, iLastPair[ range, builds their compressed          */
+/*      representation and the geometry of their feature. This only     */
+/*      reads the node lookup arrays, which are not modified until the  */
+/*      next batch, and the pairs of the range, so it can be run        */
+/*      concurrently on disjoint ranges.                                */
 /************************************************************************/
 
-void OGROSMDataSource::ProcessWaysBatch()
+void OGROSMDataSource::ResolveWays(int iFirstPair, int iLastPair,
+                                   std::vector<LonLat>& asLonLatCache)
 {
-    if( m_nWayFeaturePairs == 0 ) return;
-
-    //printf("nodes = %d, features = %d\n", nUnsortedReqIds, nWayFeaturePairs);
-    LookupNodes();
+    const bool bMultiPolygonsInterested =
+        m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested();
 
-    for( int iPair = 0; iPair < m_nWayFeaturePairs; iPair ++)
+    for( int iPair = iFirstPair; iPair < iLastPair; iPair ++)
     {
         WayFeaturePair* psWayFeaturePairs = &m_pasWayFeaturePairs[iPair];
 
         const bool bIsArea = psWayFeaturePairs->bIsArea;
-        m_asLonLatCache.clear();
+        asLonLatCache.clear();
 
 #ifdef ENABLE_NODE_LOOKUP_BY_HASHING
         if( m_bHashedIndexValid )
@@ -1671,7 +1678,7 @@ void OGROSMDataSource::ProcessWaysBatch()
 
                 if( nIdx >= 0 )
                 {
-                    m_asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
+                    asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
                 }
             }
         }
@@ -1694,41 +1701,42 @@ void OGROSMDataSource::ProcessWaysBatch()
                     nIdx = FindNode( psWayFeaturePairs->panNodeRefs[i] );
                 if( nIdx >= 0 )
                 {
-                    m_asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
+                    asLonLatCache.push_back(m_pasLonLatArray[nIdx]);
                 }
             }
         }
 
-        if( !m_asLonLatCache.empty() && bIsArea )
+        if( !asLonLatCache.empty() && bIsArea )
         {
-            m_asLonLatCache.push_back(m_asLonLatCache[0]);
+            asLonLatCache.push_back(asLonLatCache[0]);
         }
 
-        if( m_asLonLatCache.size() < 2 )
-        {
-            CPLDebug("OSM", "Way " CPL_FRMT_GIB " with %d nodes that could be found. Discarding it",
-                    psWayFeaturePairs->nWayID, static_cast<int>(m_asLonLatCache.size()));
-            delete psWayFeaturePairs->poFeature;
-            psWayFeaturePairs->poFeature = nullptr;
-            psWayFeaturePairs->bIsArea = false;
+        psWayFeaturePairs->nResolvedRefs =
+            static_cast<unsigned int>(asLonLatCache.size());
+        if( asLonLatCache.size() < 2 )
             continue;
-        }
 
-        if( bIsArea && m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested() )
+        const int nPoints = static_cast<int>(asLonLatCache.size());
+        if( m_bIndexWays )
         {
-            IndexWay(psWayFeaturePairs->nWayID,
-                     bIsArea != 0,
-                     psWayFeaturePairs->nTags,
-                     psWayFeaturePairs->pasTags,
-                     m_asLonLatCache.data(),
-                     static_cast<int>(m_asLonLatCache.size()),
-                     &psWayFeaturePairs->sInfo);
+            if( bIsArea && bMultiPolygonsInterested )
+            {
+                CompressWay(bIsArea,
+                            std::min(psWayFeaturePairs->nTags,
+                                     MAX_COUNT_FOR_TAGS_IN_WAY),
+                            psWayFeaturePairs->pasTags,
+                            nPoints, asLonLatCache.data(),
+                            &psWayFeaturePairs->sInfo,
+                            m_aabyCompressedWays[iPair]);
+            }
+            else
+            {
+                CompressWay(bIsArea, 0, nullptr,
+                            nPoints, asLonLatCache.data(),
+                            nullptr,
+                            m_aabyCompressedWays[iPair]);
+            }
         }
-        else
-            IndexWay(psWayFeaturePairs->nWayID, bIsArea != 0, 0, nullptr,
-                     m_asLonLatCache.data(),
-                     static_cast<int>(m_asLonLatCache.size()),
-                     nullptr);
 
         if( psWayFeaturePairs->poFeature == nullptr )
         {
@@ -1738,21 +1746,123 @@ void OGROSMDataSource::ProcessWaysBatch()
         OGRLineString* poLS = new OGRLineString();
         OGRGeometry* poGeom = poLS;
 
-        const int nPoints = static_cast<int>(m_asLonLatCache.size());
         poLS->setNumPoints(nPoints);
         for(int i=0;i<nPoints;i++)
         {
             poLS->setPoint(i,
-                        INT_TO_DBL(m_asLonLatCache[i].nLon),
-                        INT_TO_DBL(m_asLonLatCache[i].nLat));
+                        INT_TO_DBL(asLonLatCache[i].nLon),
+                        INT_TO_DBL(asLonLatCache[i].nLat));
         }
 
         psWayFeaturePairs->poFeature->SetGeometryDirectly(poGeom);
+    }
+}
+
+/************************************************************************/
+/*                          ResolveWaysJob()                            */
+/************************************************************************/
+
+typedef struct
+{
+    OGROSMDataSource   *poDS;
+    int                 iFirstPair;
+    int                 iLastPair;
+} ResolveWaysJobDesc;
+
+void OGROSMDataSource::ResolveWaysJob(void* pData)
+{
+    ResolveWaysJobDesc* psJob = static_cast<ResolveWaysJobDesc*>(pData);
+    std::vector<LonLat> asLonLatCache;
+    psJob->poDS->ResolveWays(psJob->iFirstPair, psJob->iLastPair,
+                             asLonLatCache);
+}
+
+/************************************************************************/
+/*                         ProcessWaysBatch()                           */
+/************************************************************************/
+
+void OGROSMDataSource::ProcessWaysBatch()
+{
+    if( m_nWayFeaturePairs == 0 ) return;
+
+    //printf("nodes = %d, features = %d\n", nUnsortedReqIds, nWayFeaturePairs);
+    LookupNodes();
+
+    if( m_aabyCompressedWays.size() <
+                        static_cast<size_t>(m_nWayFeaturePairs) )
+        m_aabyCompressedWays.resize(m_nWayFeaturePairs);
+
+    // Resolving node references, compressing ways and building geometries
+    // is split in contiguous ranges of ways processed by worker threads.
+    // Everything that has side effects (temporary database, layers) is
+    // then done below in the order of the ways, so that the output does not
+    // depend on the number of threads.
+    const int nJobs = m_poWTP == nullptr ? 1 :
+        std::min(m_poWTP->GetThreadCount(),
+                 (m_nWayFeaturePairs + m_nMinWaysPerJob - 1) / m_nMinWaysPerJob);
+    if( nJobs > 1 )
+    {
+        CPLDebug("OSM", "Resolving %d ways with %d jobs",
+                 m_nWayFeaturePairs, nJobs);
+        std::vector<ResolveWaysJobDesc> asJobs(nJobs);
+        std::vector<void*> apJobs;
+        const int nPairsPerJob = (m_nWayFeaturePairs + nJobs - 1) / nJobs;
+        for( int i = 0; i < nJobs; i++ )
+        {
+            asJobs[i].poDS = this;
+            asJobs[i].iFirstPair = i * nPairsPerJob;
+            asJobs[i].iLastPair =
+                std::min(m_nWayFeaturePairs, (i + 1) * nPairsPerJob);
+            apJobs.push_back(&asJobs[i]);
+        }
+        m_poWTP->SubmitJobs(ResolveWaysJob, apJobs);
+        m_poWTP->WaitCompletion();
+    }
+    else
+    {
+        ResolveWays(0, m_nWayFeaturePairs, m_asLonLatCache);
+    }
+
+    const bool bMultiPolygonsInterested =
+        m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested();
+
+    for( int iPair = 0; iPair < m_nWayFeaturePairs; iPair ++)
+    {
+        WayFeaturePair* psWayFeaturePairs = &m_pasWayFeaturePairs[iPair];
+
+        if( psWayFeaturePairs->nResolvedRefs < 2 )
+        {
+            CPLDebug("OSM", "Way " CPL_FRMT_GIB " with %d nodes that could be found. Discarding it",
+                    psWayFeaturePairs->nWayID,
+                    static_cast<int>(psWayFeaturePairs->nResolvedRefs));
+            delete psWayFeaturePairs->poFeature;
+            psWayFeaturePairs->poFeature = nullptr;
+            psWayFeaturePairs->bIsArea = false;
+            continue;
+        }
+
+        if( m_bIndexWays )
+        {
+            if( psWayFeaturePairs->bIsArea && bMultiPolygonsInterested &&
+                psWayFeaturePairs->nTags > MAX_COUNT_FOR_TAGS_IN_WAY )
+            {
+                CPLDebug("OSM", "Too many tags for way " CPL_FRMT_GIB ": %u. "
+                         "Clamping to %u",
+                         psWayFeaturePairs->nWayID, psWayFeaturePairs->nTags,
+                         MAX_COUNT_FOR_TAGS_IN_WAY);
+            }
+            IndexWay(psWayFeaturePairs->nWayID, m_aabyCompressedWays[iPair]);
+        }
+
+        if( psWayFeaturePairs->poFeature == nullptr )
+        {
+            continue;
+        }
 
-        if( m_asLonLatCache.size() != psWayFeaturePairs->nRefs )
+        if( psWayFeaturePairs->nResolvedRefs != psWayFeaturePairs->nRefs )
             CPLDebug("OSM", "For way " CPL_FRMT_GIB ", got only %d nodes instead of %d",
                    psWayFeaturePairs->nWayID,
-                   nPoints,
+                   static_cast<int>(psWayFeaturePairs->nResolvedRefs),
                    psWayFeaturePairs->nRefs);
 
         int bFilteredOut = FALSE;
@@ -1765,7 +1875,7 @@ void OGROSMDataSource::ProcessWaysBatch()
             m_bFeatureAdded = true;
     }
 
-    if( m_papoLayers[IDX_LYR_MULTIPOLYGONS]->IsUserInterested() )
+    if( bMultiPolygonsInterested )
     {
         for( int iPair = 0; iPair < m_nWayFeaturePairs; iPair ++)
         {
@@ -2220,12 +2330,18 @@ unsigned int OGROSMDataSource::LookupWays( std::map< GIntBig,
 }
 
 /************************************************************************/
-/*                          BuildMultiPolygon()                         */
+/*                     CollectMultiPolygonMembers()                     */
+/*                                                                      */
+/*      Fetches the member ways of a multipolygon relation from the     */
+/*      temporary database and sorts them between closed rings and      */
+/*      other edges. The polygon assembly itself is done later by       */
+/*      AssembleMultiPolygon().                                         */
 /************************************************************************/
 
-OGRGeometry* OGROSMDataSource::BuildMultiPolygon(OSMRelation* psRelation,
-                                                 unsigned int* pnTags,
-                                                 OSMTag* pasTags)
+bool OGROSMDataSource::CollectMultiPolygonMembers(OSMRelation* psRelation,
+                                                  unsigned int* pnTags,
+                                                  OSMTag* pasTags,
+                                                  MultiPolygonToAssemble& sMP)
 {
     std::map< GIntBig, std::pair<int,void*> > aoMapWays;
     LookupWays( aoMapWays, psRelation );
@@ -2253,13 +2369,12 @@ OGRGeometry* OGROSMDataSource::BuildMultiPolygon(OSMRelation* psRelation,
         for( oIter = aoMapWays.begin(); oIter != aoMapWays.end(); ++oIter )
             CPLFree(oIter->second.second);
 
-        return nullptr;
+        return false;
     }
 
-    OGRMultiLineString* poMLS = new OGRMultiLineString();
-    OGRGeometry** papoPolygons = static_cast<OGRGeometry**>( CPLMalloc(
-        sizeof(OGRGeometry*) * psRelation->nMembers) );
-    int nPolys = 0;
+    sMP.nRelationID = psRelation->nID;
+    sMP.poMLS = new OGRMultiLineString();
+    sMP.poGeom = nullptr;
 
     if( pnTags != nullptr )
         *pnTags = 0;
@@ -2303,7 +2418,7 @@ OGRGeometry* OGROSMDataSource::BuildMultiPolygon(OSMRelation* psRelation,
                 OGRPolygon* poPoly = new OGRPolygon();
                 OGRLinearRing* poRing = new OGRLinearRing();
                 poPoly->addRingDirectly(poRing);
-                papoPolygons[nPolys ++] = poPoly;
+                sMP.apoPolygons.push_back(poPoly);
                 poLS = poRing;
 
                 if( strcmp(psRelation->pasMembers[i].pszRole, "outer") == 0 )
@@ -2316,7 +2431,7 @@ OGRGeometry* OGROSMDataSource::BuildMultiPolygon(OSMRelation* psRelation,
             else
             {
                 poLS = new OGRLineString();
-                poMLS->addGeometryDirectly(poLS);
+                sMP.poMLS->addGeometryDirectly(poLS);
             }
 
             const int nPoints = static_cast<int>(m_asLonLatCache.size());
@@ -2330,6 +2445,27 @@ OGRGeometry* OGROSMDataSource::BuildMultiPolygon(OSMRelation* psRelation,
         }
     }
 
+    std::map< GIntBig, std::pair<int,void*> >::iterator oIter;
+    for( oIter = aoMapWays.begin(); oIter != aoMapWays.end(); ++oIter )
+        CPLFree(oIter->second.second);
+
+    return true;
+}
+
+/************************************************************************/
+/*                        AssembleMultiPolygon()                        */
+/*                                                                      */
+/*      Builds the multipolygon geometry from the members collected by  */
+/*      CollectMultiPolygonMembers(). Only works on its argument, so    */
+/*      it can be run on a worker thread.                               */
+/************************************************************************/
+
+void OGROSMDataSource::AssembleMultiPolygon(void* pData)
+{
+    MultiPolygonToAssemble* psMP = static_cast<MultiPolygonToAssemble*>(pData);
+    OGRMultiLineString* poMLS = psMP->poMLS;
+    std::vector<OGRGeometry*>& apoPolygons = psMP->apoPolygons;
+
     if( poMLS->getNumGeometries() > 0 )
     {
         OGRGeometryH hPoly = OGRBuildPolygonFromEdges( (OGRGeometryH) poMLS,
@@ -2352,7 +2488,7 @@ OGRGeometry* OGROSMDataSource::BuildMultiPolygon(OSMRelation* psRelation,
                 {
                     OGRPolygon* poPoly = new OGRPolygon();
                     poPoly->addRing( poRing );
-                    papoPolygons[nPolys ++] = poPoly;
+                    apoPolygons.push_back(poPoly);
                 }
             }
         }
@@ -2360,15 +2496,18 @@ OGRGeometry* OGROSMDataSource::BuildMultiPolygon(OSMRelation* psRelation,
         OGR_G_DestroyGeometry(hPoly);
     }
     delete poMLS;
+    psMP->poMLS = nullptr;
 
-    OGRGeometry* poRet = nullptr;
+    psMP->poGeom = nullptr;
 
-    if( nPolys > 0 )
+    if( !apoPolygons.empty() )
     {
         int bIsValidGeometry = FALSE;
         const char* apszOptions[2] = { "METHOD=DEFAULT", nullptr };
         OGRGeometry* poGeom = OGRGeometryFactory::organizePolygons(
-            papoPolygons, nPolys, &bIsValidGeometry, apszOptions );
+            apoPolygons.data(), static_cast<int>(apoPolygons.size()),
+            &bIsValidGeometry, apszOptions );
+        apoPolygons.clear();
 
         if( poGeom != nullptr && poGeom->getGeometryType() == wkbPolygon )
         {
@@ -2379,28 +2518,68 @@ OGRGeometry* OGROSMDataSource::BuildMultiPolygon(OSMRelation* psRelation,
 
         if( poGeom != nullptr && poGeom->getGeometryType() == wkbMultiPolygon )
         {
-            poRet = poGeom;
+            psMP->poGeom = poGeom;
         }
         else
         {
             CPLDebug( "OSM",
                       "Relation " CPL_FRMT_GIB
                       ": Geometry has incompatible type : %s",
-                      psRelation->nID,
+                      psMP->nRelationID,
                       poGeom != nullptr ?
                       OGR_G_GetGeometryName(
                           reinterpret_cast<OGRGeometryH>(poGeom)) : "null" );
             delete poGeom;
         }
     }
+}
 
-    CPLFree(papoPolygons);
+/************************************************************************/
+/*                      ProcessMultiPolygonsBatch()                     */
+/************************************************************************/
 
-    std::map< GIntBig, std::pair<int,void*> >::iterator oIter;
-    for( oIter = aoMapWays.begin(); oIter != aoMapWays.end(); ++oIter )
-        CPLFree(oIter->second.second);
+void OGROSMDataSource::ProcessMultiPolygonsBatch()
+{
+    if( m_asMultiPolygonsToAssemble.empty() )
+        return;
+
+    // Polygon assembly is done on worker threads, and features are then
+    // added in the order of the relations.
+    if( m_poWTP != nullptr && m_asMultiPolygonsToAssemble.size() > 1 )
+    {
+        std::vector<void*> apJobs;
+        for( auto& sMP: m_asMultiPolygonsToAssemble )
+            apJobs.push_back(&sMP);
+        m_poWTP->SubmitJobs(AssembleMultiPolygon, apJobs);
+        m_poWTP->WaitCompletion();
+    }
+    else
+    {
+        for( auto& sMP: m_asMultiPolygonsToAssemble )
+            AssembleMultiPolygon(&sMP);
+    }
 
-    return poRet;
+    for( auto& sMP: m_asMultiPolygonsToAssemble )
+    {
+        if( sMP.poGeom == nullptr )
+        {
+            delete sMP.poFeature;
+            continue;
+        }
+
+        sMP.poFeature->SetGeometryDirectly(sMP.poGeom);
+
+        int bFilteredOut = FALSE;
+        if( !m_papoLayers[IDX_LYR_MULTIPOLYGONS]->AddFeature(
+                                                sMP.poFeature,
+                                                sMP.bAttrFilterAlreadyEvaluated,
+                                                &bFilteredOut,
+                                                !m_bFeatureAdded ) )
+            m_bStopParsing = true;
+        else if( !bFilteredOut )
+            m_bFeatureAdded = true;
+    }
+    m_asMultiPolygonsToAssemble.clear();
 }
 
 /************************************************************************/
@@ -2564,26 +2743,58 @@ void OGROSMDataSource::NotifyRelation (OSMRelation* psRelation)
         }
     }
 
-    OGRGeometry* poGeom = nullptr;
-
-    unsigned int nExtraTags = 0;
-    OSMTag pasExtraTags[1 + MAX_COUNT_FOR_TAGS_IN_WAY];
-
     if( bMultiPolygon )
     {
+        unsigned int nExtraTags = 0;
+        OSMTag pasExtraTags[1 + MAX_COUNT_FOR_TAGS_IN_WAY];
+
+        MultiPolygonToAssemble sMP{};
+        bool bOK;
         if( !bInterestingTagFound )
         {
-            poGeom = BuildMultiPolygon(psRelation, &nExtraTags, pasExtraTags);
+            bOK = CollectMultiPolygonMembers(psRelation, &nExtraTags,
+                                             pasExtraTags, sMP);
             CPLAssert(nExtraTags <= MAX_COUNT_FOR_TAGS_IN_WAY);
             pasExtraTags[nExtraTags].pszK = "type";
             pasExtraTags[nExtraTags].pszV = pszTypeV;
             nExtraTags ++;
         }
         else
-            poGeom = BuildMultiPolygon(psRelation, nullptr, nullptr);
+            bOK = CollectMultiPolygonMembers(psRelation, nullptr, nullptr,
+                                             sMP);
+        if( !bOK )
+        {
+            delete poFeature;
+            return;
+        }
+
+        // The feature is created now since the tags of the relation, or of
+        // its first outer way, are only valid during this call.
+        sMP.bAttrFilterAlreadyEvaluated = true;
+        if( poFeature == nullptr )
+        {
+            poFeature = new OGRFeature(m_papoLayers[iCurLayer]->GetLayerDefn());
+
+            m_papoLayers[iCurLayer]->SetFieldsFromTags(
+                poFeature,
+                psRelation->nID,
+                false,
+                nExtraTags ? nExtraTags : psRelation->nTags,
+                nExtraTags ? pasExtraTags : psRelation->pasTags,
+                &psRelation->sInfo);
+
+            sMP.bAttrFilterAlreadyEvaluated = false;
+        }
+        sMP.poFeature = poFeature;
+
+        m_asMultiPolygonsToAssemble.push_back(std::move(sMP));
+        if( m_asMultiPolygonsToAssemble.size() ==
+                        static_cast<size_t>(MAX_DELAYED_MULTIPOLYGONS) )
+            ProcessMultiPolygonsBatch();
+        return;
     }
-    else
-        poGeom = BuildGeometryCollection(psRelation, bMultiLineString);
+
+    OGRGeometry* poGeom = BuildGeometryCollection(psRelation, bMultiLineString);
 
     if( poGeom != nullptr )
     {
@@ -2596,8 +2807,8 @@ void OGROSMDataSource::NotifyRelation (OSMRelation* psRelation)
                 poFeature,
                 psRelation->nID,
                 false,
-                nExtraTags ? nExtraTags : psRelation->nTags,
-                nExtraTags ? pasExtraTags : psRelation->pasTags,
+                psRelation->nTags,
+                psRelation->pasTags,
                 &psRelation->sInfo);
 
             bAttrFilterAlreadyEvaluated = false;
@@ -2772,6 +2983,27 @@ int OGROSMDataSource::Open( const char * pszFilename,
     if( m_psParser == nullptr )
         return FALSE;
 
+    // Worker threads used to resolve ways and assemble multipolygons.
+    const char* pszNumThreads =
+                CPLGetConfigOption("GDAL_NUM_THREADS", "ALL_CPUS");
+    int nNumCPUs = CPLGetNumCPUs();
+    if( pszNumThreads && !EQUAL(pszNumThreads, "ALL_CPUS") )
+        nNumCPUs = std::max(0, std::min(2 * nNumCPUs, atoi(pszNumThreads)));
+    if( nNumCPUs > 1 )
+    {
+        m_poWTP = new CPLWorkerThreadPool();
+        // coverity[tainted_data]
+        if( !m_poWTP->Setup(nNumCPUs, nullptr, nullptr) )
+        {
+            delete m_poWTP;
+            m_poWTP = nullptr;
+        }
+    }
+    // Tests lower OGR_OSM_MIN_WAYS_PER_JOB to get several jobs out of small
+    // files.
+    m_nMinWaysPerJob = std::max(1, atoi(CPLGetConfigOption(
+        "OGR_OSM_MIN_WAYS_PER_JOB", CPLSPrintf("%d", MIN_WAYS_PER_JOB))));
+
     if( CPLFetchBool(papszOpenOptionsIn, "INTERLEAVED_READING", false) )
         m_bInterleavedReading = TRUE;
 
@@ -3964,6 +4196,7 @@ bool OGROSMDataSource::ParseNextChunk( int nIdxLayer,
 #endif
 
         OSMRetCode eRet = OSM_ProcessBlock(m_psParser);
+        ProcessMultiPolygonsBatch();
         if( pfnProgress != nullptr )
         {
             double dfPct = -1.0;
@@ -84,8 +84,48 @@ class OGRParquetLayer final: public OGRParquetLayerBase
 #endif
         CPLStringList                               m_aosFeatherMetadata{};
 
+        bool                                        m_bRowGroupSelectionValid = false;
+        bool                                        m_bUseRowGroupSelection = false;
+        std::vector<int>                            m_anSelectedRowGroups{}; // only valid when m_bUseRowGroupSelection is set
+        size_t                                      m_iNextSelectedRowGroup = 0;
+        std::vector<int64_t>                        m_anRowGroupFirstRow{};
+
+        struct FieldStatistics
+        {
+            enum class Type
+            {
+                None,
+                Integer,
+                Real,
+                String,
+            };
+            int64_t      nRows = 0;
+            bool         bHasNullCount = false;
+            int64_t      nNullCount = 0;
+            Type         eType = Type::None; // None if min/max are not available
+            int64_t      nMin = 0;
+            int64_t      nMax = 0;
+            double       dfMin = 0;
+            double       dfMax = 0;
+            std::string  osMin{};
+            std::string  osMax{};
+        };
+
         void               EstablishFeatureDefn();
         bool               CreateRecordBatchReader(int iStartingRowGroup);
+        bool               CreateRecordBatchReader(const std::vector<int>& anRowGroups);
+        void               InvalidateRowGroupSelection();
+        void               ComputeRowGroupSelection();
+        bool               StartNextRowGroupRun();
+        bool               GetRowGroupFieldStatistics(int iRowGroup, int iField,
+                                                      FieldStatistics& sStats) const;
+        static bool        StatisticsMayMatch(const FieldStatistics& sStats,
+                                              int nOp, const swq_expr_node* poValue);
+        bool               RowGroupMayMatchAttributeFilter(int iRowGroup,
+                                                           const swq_expr_node* poNode) const;
+        bool               GetBBoxCoveringFields(int iGeomField, int anFields[4]) const;
+        bool               RowGroupMayMatchSpatialFilter(int iRowGroup,
+                                                         const int anBBoxFields[4]) const;
         bool               ReadNextBatch() override;
         OGRwkbGeometryType ComputeGeometryColumnType(int iGeomCol, int iParquetCol) const;
         void               CreateFieldFromSchema(
@@ -116,6 +156,14 @@ public:
                                          const char* pszDomain = "" ) override;
         char**          GetMetadata( const char* pszDomain = "" ) override;
         OGRErr          SetNextByIndex( GIntBig nIndex ) override;
+        OGRErr          SetAttributeFilter( const char* pszFilter ) override;
+        void            SetSpatialFilter( OGRGeometry * poGeom ) override
+                            { SetSpatialFilter(0, poGeom); }
+        void            SetSpatialFilter( int iGeomField, OGRGeometry *poGeom ) override;
+        OGRErr          GetExtent(OGREnvelope *psExtent, int bForce = TRUE) override
+                            { return GetExtent(0, psExtent, bForce); }
+        OGRErr          GetExtent(int iGeomField, OGREnvelope *psExtent,
+                                  int bForce = TRUE) override;
 
         GDALDataset*    GetDataset() override;
         bool            GetArrowStream(struct ArrowArrayStream* out_stream,
@@ -207,12 +255,14 @@ class OGRParquetWriterLayer final: public OGRArrowWriterLayer
         virtual void            PerformStepsBeforeFinalFlushGroup() override;
 
         virtual bool            FlushGroup() override;
+        virtual bool            WriteRecordBatch(const std::shared_ptr<arrow::RecordBatch>& poBatch) override;
 
         virtual std::string GetDriverUCName() const override { return "PARQUET"; }
 
         virtual bool            IsSupportedGeometryType(OGRwkbGeometryType eGType) const override;
 
         virtual void            FixupGeometryBeforeWriting(OGRGeometry* poGeom) override;
+        virtual bool            HasGeometryFixup() const override { return m_bForceCounterClockwiseOrientation; }
         virtual bool            IsSRSRequired() const override { return false; }
 
         std::string             GetGeoMetadata() const;
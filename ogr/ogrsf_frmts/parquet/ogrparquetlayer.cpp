@@ -35,6 +35,7 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <cmath>
 #include <limits>
 #include <map>
 #include <set>
@@ -809,6 +810,10 @@ OGRFeature* OGRParquetLayer::GetFeature(GIntBig nFID)
 
 void OGRParquetLayer::ResetReading()
 {
+    // When row groups are skipped, the first batch does not necessarily
+    // start with the first feature, so it cannot be reused.
+    if( m_bUseRowGroupSelection )
+        m_iRecordBatch = -1;
     if( m_iRecordBatch != 0 )
     {
         m_poRecordBatchReader.reset();
@@ -827,6 +832,11 @@ bool OGRParquetLayer::CreateRecordBatchReader(int iStartingRowGroup)
     anRowGroups.reserve(nNumGroups - iStartingRowGroup);
     for( int i = iStartingRowGroup; i < nNumGroups; ++i )
         anRowGroups.push_back(i);
+    return CreateRecordBatchReader(anRowGroups);
+}
+
+bool OGRParquetLayer::CreateRecordBatchReader(const std::vector<int>& anRowGroups)
+{
     arrow::Status status;
     if( m_bIgnoredFields )
     {
@@ -869,24 +879,43 @@ bool OGRParquetLayer::ReadNextBatch()
 
     if( m_poRecordBatchReader == nullptr )
     {
-        if( !CreateRecordBatchReader(0) )
+        if( !m_bRowGroupSelectionValid )
+            ComputeRowGroupSelection();
+        if( m_bUseRowGroupSelection )
+        {
+            m_iNextSelectedRowGroup = 0;
+            if( !StartNextRowGroupRun() )
+                return false;
+        }
+        else if( !CreateRecordBatchReader(0) )
+        {
             return false;
+        }
     }
 
     ++m_iRecordBatch;
 
     std::shared_ptr<arrow::RecordBatch> poNextBatch;
-    auto status = m_poRecordBatchReader->ReadNext(&poNextBatch);
-    if( !status.ok() )
+    while( true )
     {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "ReadNext() failed: %s",
-                 status.message().c_str());
-        poNextBatch.reset();
+        auto status = m_poRecordBatchReader->ReadNext(&poNextBatch);
+        if( !status.ok() )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "ReadNext() failed: %s",
+                     status.message().c_str());
+            poNextBatch.reset();
+            break;
+        }
+        if( poNextBatch != nullptr || !m_bUseRowGroupSelection ||
+            !StartNextRowGroupRun() )
+        {
+            break;
+        }
     }
     if( poNextBatch == nullptr )
     {
-        if( m_iRecordBatch == 1 )
+        if( m_iRecordBatch == 1 && !m_bUseRowGroupSelection )
         {
             m_iRecordBatch = 0;
             m_bSingleBatch = true;
@@ -948,6 +977,538 @@ bool OGRParquetLayer::ReadNextBatch()
     return true;
 }
 
+/************************************************************************/
+/*                        StartNextRowGroupRun()                        */
+/************************************************************************/
+
+// Creates a record batch reader over the next run of consecutive selected
+// row groups, so that feature indices remain contiguous inside a reader.
+bool OGRParquetLayer::StartNextRowGroupRun()
+{
+    if( m_iNextSelectedRowGroup >= m_anSelectedRowGroups.size() )
+        return false;
+
+    std::vector<int> anRowGroups;
+    do
+    {
+        anRowGroups.push_back(m_anSelectedRowGroups[m_iNextSelectedRowGroup]);
+        ++m_iNextSelectedRowGroup;
+    }
+    while( m_iNextSelectedRowGroup < m_anSelectedRowGroups.size() &&
+           m_anSelectedRowGroups[m_iNextSelectedRowGroup] == anRowGroups.back() + 1 );
+
+    m_nFeatureIdx = m_anRowGroupFirstRow[anRowGroups.front()];
+    return CreateRecordBatchReader(anRowGroups);
+}
+
+/************************************************************************/
+/*                     InvalidateRowGroupSelection()                    */
+/************************************************************************/
+
+void OGRParquetLayer::InvalidateRowGroupSelection()
+{
+    m_bRowGroupSelectionValid = false;
+    m_bUseRowGroupSelection = false;
+    m_anSelectedRowGroups.clear();
+    m_iNextSelectedRowGroup = 0;
+
+    // Full invalidation
+    m_iRecordBatch = -1;
+    m_bSingleBatch = false;
+    ResetReading();
+}
+
+/************************************************************************/
+/*                     ComputeRowGroupSelection()                       */
+/************************************************************************/
+
+// Uses the min/max statistics of the column chunks to find out the row
+// groups that may contain features matching the attribute and spatial
+// filters.
+void OGRParquetLayer::ComputeRowGroupSelection()
+{
+    m_bRowGroupSelectionValid = true;
+    m_bUseRowGroupSelection = false;
+    m_anSelectedRowGroups.clear();
+    m_iNextSelectedRowGroup = 0;
+
+    if( m_poAttrQuery == nullptr && m_poFilterGeom == nullptr )
+        return;
+    if( !CPLTestBool(CPLGetConfigOption("OGR_PARQUET_USE_STATISTICS", "YES")) )
+        return;
+
+    const swq_expr_node* poNode = m_poAttrQuery ?
+        static_cast<const swq_expr_node*>(m_poAttrQuery->GetSWQExpr()) : nullptr;
+    int anBBoxFields[4] = { -1, -1, -1, -1 };
+    const bool bUseBBox = m_poFilterGeom != nullptr &&
+                          GetBBoxCoveringFields(m_iGeomFieldFilter, anBBoxFields);
+    if( poNode == nullptr && !bUseBBox )
+        return;
+
+    const auto metadata = m_poArrowReader->parquet_reader()->metadata();
+    const int nNumGroups = m_poArrowReader->num_row_groups();
+    if( static_cast<int>(m_anRowGroupFirstRow.size()) != nNumGroups )
+    {
+        m_anRowGroupFirstRow.resize(nNumGroups);
+        int64_t nAccRows = 0;
+        for( int iGroup = 0; iGroup < nNumGroups; ++iGroup )
+        {
+            m_anRowGroupFirstRow[iGroup] = nAccRows;
+            nAccRows += metadata->RowGroup(iGroup)->num_rows();
+        }
+    }
+
+    for( int iGroup = 0; iGroup < nNumGroups; ++iGroup )
+    {
+        if( (poNode == nullptr ||
+             RowGroupMayMatchAttributeFilter(iGroup, poNode)) &&
+            (!bUseBBox ||
+             RowGroupMayMatchSpatialFilter(iGroup, anBBoxFields)) )
+        {
+            m_anSelectedRowGroups.push_back(iGroup);
+        }
+    }
+
+    CPLDebug("PARQUET", "%d row group(s) out of %d selected from statistics",
+             static_cast<int>(m_anSelectedRowGroups.size()), nNumGroups);
+    m_bUseRowGroupSelection =
+        static_cast<int>(m_anSelectedRowGroups.size()) < nNumGroups;
+}
+
+/************************************************************************/
+/*                    GetRowGroupFieldStatistics()                      */
+/************************************************************************/
+
+// Returns false if no statistics can be used for the field.
+// sStats.eType is set to None when the min/max values are not usable.
+bool OGRParquetLayer::GetRowGroupFieldStatistics(int iRowGroup, int iField,
+                                                 FieldStatistics& sStats) const
+{
+    if( iField < 0 || iField >= m_poFeatureDefn->GetFieldCount() )
+        return false;
+    const int iParquetCol = m_anMapFieldIndexToParquetColumn[iField];
+    if( iParquetCol < 0 )
+        return false;
+
+    const auto metadata = m_poArrowReader->parquet_reader()->metadata();
+    const auto poDescr = metadata->schema()->Column(iParquetCol);
+    if( poDescr->max_repetition_level() > 0 )
+        return false;
+
+    try
+    {
+        const auto poRowGroup = metadata->RowGroup(iRowGroup);
+        const auto poColumn = poRowGroup->ColumnChunk(iParquetCol);
+        if( !poColumn->is_stats_set() )
+            return false;
+        const auto stats = poColumn->statistics();
+        if( stats == nullptr )
+            return false;
+
+        sStats.nRows = poRowGroup->num_rows();
+        sStats.bHasNullCount = stats->HasNullCount();
+        sStats.nNullCount = stats->null_count();
+        sStats.eType = FieldStatistics::Type::None;
+        if( !stats->HasMinMax() )
+            return true;
+
+        const auto eFieldType = m_poFeatureDefn->GetFieldDefn(iField)->GetType();
+        const auto& logicalType = poDescr->logical_type();
+        const auto ePhysicalType = poDescr->physical_type();
+        // Excludes unsigned integers, decimals, timestamps, etc.
+        const bool bSignedNumber =
+            poDescr->sort_order() == parquet::SortOrder::SIGNED &&
+            (logicalType->is_none() || logicalType->is_int());
+        if( (eFieldType == OFTInteger || eFieldType == OFTInteger64) &&
+            bSignedNumber && ePhysicalType == parquet::Type::INT32 )
+        {
+            const auto typedStats = dynamic_cast<parquet::Int32Statistics*>(stats.get());
+            if( typedStats )
+            {
+                sStats.eType = FieldStatistics::Type::Integer;
+                sStats.nMin = typedStats->min();
+                sStats.nMax = typedStats->max();
+            }
+        }
+        else if( (eFieldType == OFTInteger || eFieldType == OFTInteger64) &&
+                 bSignedNumber && ePhysicalType == parquet::Type::INT64 )
+        {
+            const auto typedStats = dynamic_cast<parquet::Int64Statistics*>(stats.get());
+            if( typedStats )
+            {
+                sStats.eType = FieldStatistics::Type::Integer;
+                sStats.nMin = typedStats->min();
+                sStats.nMax = typedStats->max();
+            }
+        }
+        else if( eFieldType == OFTReal && bSignedNumber &&
+                 ePhysicalType == parquet::Type::FLOAT )
+        {
+            const auto typedStats = dynamic_cast<parquet::FloatStatistics*>(stats.get());
+            if( typedStats )
+            {
+                sStats.eType = FieldStatistics::Type::Real;
+                sStats.dfMin = typedStats->min();
+                sStats.dfMax = typedStats->max();
+            }
+        }
+        else if( eFieldType == OFTReal && bSignedNumber &&
+                 ePhysicalType == parquet::Type::DOUBLE )
+        {
+            const auto typedStats = dynamic_cast<parquet::DoubleStatistics*>(stats.get());
+            if( typedStats )
+            {
+                sStats.eType = FieldStatistics::Type::Real;
+                sStats.dfMin = typedStats->min();
+                sStats.dfMax = typedStats->max();
+            }
+        }
+        else if( eFieldType == OFTString && logicalType->is_string() &&
+                 ePhysicalType == parquet::Type::BYTE_ARRAY )
+        {
+            const auto typedStats = dynamic_cast<parquet::ByteArrayStatistics*>(stats.get());
+            if( typedStats )
+            {
+                sStats.eType = FieldStatistics::Type::String;
+                sStats.osMin.assign(reinterpret_cast<const char*>(typedStats->min().ptr),
+                                    typedStats->min().len);
+                sStats.osMax.assign(reinterpret_cast<const char*>(typedStats->max().ptr),
+                                    typedStats->max().len);
+            }
+        }
+        if( sStats.eType == FieldStatistics::Type::Real &&
+            (std::isnan(sStats.dfMin) || std::isnan(sStats.dfMax)) )
+        {
+            sStats.eType = FieldStatistics::Type::None;
+        }
+        return true;
+    }
+    catch( const std::exception& )
+    {
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                           RangeMayMatch()                            */
+/************************************************************************/
+
+template<class T> static bool RangeMayMatch(T nMin, T nMax, int nOp, T nValue)
+{
+    switch( nOp )
+    {
+        case SWQ_EQ: return !(nValue < nMin || nValue > nMax);
+        case SWQ_NE: return !(nMin == nValue && nMax == nValue);
+        case SWQ_LT: return nMin < nValue;
+        case SWQ_LE: return nMin <= nValue;
+        case SWQ_GT: return nMax > nValue;
+        case SWQ_GE: return nMax >= nValue;
+        default: break;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                      StatisticsMayMatch()                            */
+/************************************************************************/
+
+// Returns whether "field nOp poValue" may be true for a row of the row group.
+bool OGRParquetLayer::StatisticsMayMatch(const FieldStatistics& sStats,
+                                         int nOp, const swq_expr_node* poValue)
+{
+    if( poValue->is_null )
+        return true;
+    // Comparisons with NULL are always false
+    if( sStats.bHasNullCount && sStats.nNullCount == sStats.nRows )
+        return false;
+
+    const bool bIntegerValue = poValue->field_type == SWQ_INTEGER ||
+                               poValue->field_type == SWQ_INTEGER64;
+    switch( sStats.eType )
+    {
+        case FieldStatistics::Type::None:
+            break;
+
+        case FieldStatistics::Type::Integer:
+        {
+            if( bIntegerValue )
+            {
+                return RangeMayMatch<int64_t>(sStats.nMin, sStats.nMax, nOp,
+                                              poValue->int_value);
+            }
+            break;
+        }
+
+        case FieldStatistics::Type::Real:
+        {
+            // NaN values are not accounted for in statistics
+            if( nOp == SWQ_NE )
+                break;
+            if( bIntegerValue )
+            {
+                return RangeMayMatch<double>(sStats.dfMin, sStats.dfMax, nOp,
+                                     static_cast<double>(poValue->int_value));
+            }
+            if( poValue->field_type == SWQ_FLOAT )
+            {
+                return RangeMayMatch<double>(sStats.dfMin, sStats.dfMax, nOp,
+                                             poValue->float_value);
+            }
+            break;
+        }
+
+        case FieldStatistics::Type::String:
+        {
+            if( nOp == SWQ_EQ && poValue->field_type == SWQ_STRING )
+            {
+                // OGR SQL compares strings in a case insensitive way.
+                // Strings equal to the value, ignoring case, sort between its
+                // upper case and lower case forms.
+                std::string osLow(poValue->string_value);
+                std::string osHigh(osLow);
+                for( size_t i = 0; i < osLow.size(); ++i )
+                {
+                    if( osLow[i] >= 'a' && osLow[i] <= 'z' )
+                        osLow[i] = static_cast<char>(osLow[i] - 'a' + 'A');
+                    if( osHigh[i] >= 'A' && osHigh[i] <= 'Z' )
+                        osHigh[i] = static_cast<char>(osHigh[i] - 'A' + 'a');
+                }
+                return !(sStats.osMax < osLow || sStats.osMin > osHigh);
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                   RowGroupMayMatchAttributeFilter()                  */
+/************************************************************************/
+
+bool OGRParquetLayer::RowGroupMayMatchAttributeFilter(
+                            int iRowGroup, const swq_expr_node* poNode) const
+{
+    if( poNode->eNodeType != SNT_OPERATION )
+        return true;
+
+    if( poNode->nOperation == SWQ_AND && poNode->nSubExprCount == 2 )
+    {
+        return RowGroupMayMatchAttributeFilter(iRowGroup, poNode->papoSubExpr[0]) &&
+               RowGroupMayMatchAttributeFilter(iRowGroup, poNode->papoSubExpr[1]);
+    }
+
+    if( poNode->nOperation == SWQ_OR && poNode->nSubExprCount == 2 )
+    {
+        return RowGroupMayMatchAttributeFilter(iRowGroup, poNode->papoSubExpr[0]) ||
+               RowGroupMayMatchAttributeFilter(iRowGroup, poNode->papoSubExpr[1]);
+    }
+
+    FieldStatistics sStats;
+
+    if( poNode->nOperation == SWQ_ISNULL && poNode->nSubExprCount == 1 )
+    {
+        const swq_expr_node *poColumn = poNode->papoSubExpr[0];
+        return poColumn->eNodeType != SNT_COLUMN ||
+               !GetRowGroupFieldStatistics(iRowGroup, poColumn->field_index, sStats) ||
+               !sStats.bHasNullCount || sStats.nNullCount > 0;
+    }
+
+    if( poNode->nOperation == SWQ_NOT && poNode->nSubExprCount == 1 &&
+        poNode->papoSubExpr[0]->eNodeType == SNT_OPERATION &&
+        poNode->papoSubExpr[0]->nOperation == SWQ_ISNULL &&
+        poNode->papoSubExpr[0]->nSubExprCount == 1 )
+    {
+        const swq_expr_node *poColumn = poNode->papoSubExpr[0]->papoSubExpr[0];
+        return poColumn->eNodeType != SNT_COLUMN ||
+               !GetRowGroupFieldStatistics(iRowGroup, poColumn->field_index, sStats) ||
+               !sStats.bHasNullCount || sStats.nNullCount < sStats.nRows;
+    }
+
+    if( IsComparisonOp(poNode->nOperation) && poNode->nSubExprCount == 2 )
+    {
+        const swq_expr_node *poColumn = GetColumnSubNode(poNode);
+        const swq_expr_node *poValue = GetConstantSubNode(poNode);
+        if( poColumn == nullptr || poValue == nullptr ||
+            !GetRowGroupFieldStatistics(iRowGroup, poColumn->field_index, sStats) )
+        {
+            return true;
+        }
+
+        int nOp = poNode->nOperation;
+        /* If "constant op column", then we must reverse */
+        /* the operator for LE, LT, GE, GT */
+        if( poColumn != poNode->papoSubExpr[0] )
+        {
+            switch( nOp )
+            {
+                case SWQ_LE: nOp = SWQ_GE; break;
+                case SWQ_LT: nOp = SWQ_GT; break;
+                case SWQ_GE: nOp = SWQ_LE; break;
+                case SWQ_GT: nOp = SWQ_LT; break;
+                default: break;
+            }
+        }
+        return StatisticsMayMatch(sStats, nOp, poValue);
+    }
+
+    if( poNode->nOperation == SWQ_IN && poNode->nSubExprCount >= 2 )
+    {
+        const swq_expr_node *poColumn = poNode->papoSubExpr[0];
+        if( poColumn->eNodeType != SNT_COLUMN ||
+            !GetRowGroupFieldStatistics(iRowGroup, poColumn->field_index, sStats) )
+        {
+            return true;
+        }
+        for( int i = 1; i < poNode->nSubExprCount; ++i )
+        {
+            const swq_expr_node *poValue = poNode->papoSubExpr[i];
+            if( poValue->eNodeType != SNT_CONSTANT ||
+                StatisticsMayMatch(sStats, SWQ_EQ, poValue) )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    if( poNode->nOperation == SWQ_BETWEEN && poNode->nSubExprCount == 3 )
+    {
+        const swq_expr_node *poColumn = poNode->papoSubExpr[0];
+        const swq_expr_node *poLow = poNode->papoSubExpr[1];
+        const swq_expr_node *poHigh = poNode->papoSubExpr[2];
+        if( poColumn->eNodeType != SNT_COLUMN ||
+            poLow->eNodeType != SNT_CONSTANT ||
+            poHigh->eNodeType != SNT_CONSTANT ||
+            !GetRowGroupFieldStatistics(iRowGroup, poColumn->field_index, sStats) )
+        {
+            return true;
+        }
+        return StatisticsMayMatch(sStats, SWQ_GE, poLow) &&
+               StatisticsMayMatch(sStats, SWQ_LE, poHigh);
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                       GetBBoxCoveringFields()                        */
+/************************************************************************/
+
+// Finds the fields of the GeoParquet bounding box "covering" of a geometry
+// column, in xmin, ymin, xmax, ymax order.
+bool OGRParquetLayer::GetBBoxCoveringFields(int iGeomField,
+                                            int anFields[4]) const
+{
+    if( iGeomField < 0 || iGeomField >= m_poFeatureDefn->GetGeomFieldCount() )
+        return false;
+    const auto oIter = m_oMapGeometryColumns.find(
+        m_poFeatureDefn->GetGeomFieldDefn(iGeomField)->GetNameRef());
+    if( oIter == m_oMapGeometryColumns.end() )
+        return false;
+    const auto oBBox = oIter->second.GetObj("covering/bbox");
+    if( !oBBox.IsValid() )
+        return false;
+
+    const char* const apszKeys[] = { "xmin", "ymin", "xmax", "ymax" };
+    for( int i = 0; i < 4; ++i )
+    {
+        const auto oPath = oBBox.GetArray(apszKeys[i]);
+        if( !oPath.IsValid() || oPath.Size() == 0 )
+            return false;
+        std::string osName;
+        for( const auto& oPart: oPath )
+        {
+            if( !osName.empty() )
+                osName += '.';
+            osName += oPart.ToString();
+        }
+        anFields[i] = m_poFeatureDefn->GetFieldIndex(osName.c_str());
+        if( anFields[i] < 0 )
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                   RowGroupMayMatchSpatialFilter()                    */
+/************************************************************************/
+
+bool OGRParquetLayer::RowGroupMayMatchSpatialFilter(
+                            int iRowGroup, const int anBBoxFields[4]) const
+{
+    double adfMin[2] = { 0, 0 };
+    double adfMax[2] = { 0, 0 };
+    for( int i = 0; i < 4; ++i )
+    {
+        FieldStatistics sStats;
+        if( !GetRowGroupFieldStatistics(iRowGroup, anBBoxFields[i], sStats) )
+            return true;
+        if( sStats.eType == FieldStatistics::Type::Integer )
+        {
+            sStats.dfMin = static_cast<double>(sStats.nMin);
+            sStats.dfMax = static_cast<double>(sStats.nMax);
+        }
+        else if( sStats.eType != FieldStatistics::Type::Real )
+        {
+            return true;
+        }
+        // Minimum of the xmin/ymin columns, maximum of the xmax/ymax ones
+        if( i < 2 )
+            adfMin[i] = sStats.dfMin;
+        else
+            adfMax[i - 2] = sStats.dfMax;
+    }
+    return !(adfMin[0] > m_sFilterEnvelope.MaxX ||
+             adfMin[1] > m_sFilterEnvelope.MaxY ||
+             adfMax[0] < m_sFilterEnvelope.MinX ||
+             adfMax[1] < m_sFilterEnvelope.MinY);
+}
+
+/************************************************************************/
+/*                        SetAttributeFilter()                          */
+/************************************************************************/
+
+OGRErr OGRParquetLayer::SetAttributeFilter( const char* pszFilter )
+{
+    const OGRErr eErr = OGRParquetLayerBase::SetAttributeFilter(pszFilter);
+    InvalidateRowGroupSelection();
+    return eErr;
+}
+
+/************************************************************************/
+/*                         SetSpatialFilter()                           */
+/************************************************************************/
+
+void OGRParquetLayer::SetSpatialFilter( int iGeomField, OGRGeometry *poGeomIn )
+{
+    OGRParquetLayerBase::SetSpatialFilter(iGeomField, poGeomIn);
+    InvalidateRowGroupSelection();
+}
+
+/************************************************************************/
+/*                            GetExtent()                               */
+/************************************************************************/
+
+OGRErr OGRParquetLayer::GetExtent(int iGeomField, OGREnvelope *psExtent,
+                                  int bForce)
+{
+    if( !m_bRowGroupSelectionValid )
+        ComputeRowGroupSelection();
+    if( !m_bUseRowGroupSelection )
+        return OGRParquetLayerBase::GetExtent(iGeomField, psExtent, bForce);
+
+    // The extent must be computed from all row groups, whatever the filters
+    m_bUseRowGroupSelection = false;
+    m_iRecordBatch = -1;
+    ResetReading();
+    const OGRErr eErr = OGRParquetLayerBase::GetExtent(iGeomField, psExtent, bForce);
+    m_iRecordBatch = -1;
+    m_bSingleBatch = false;
+    ResetReading();
+    m_bUseRowGroupSelection = true;
+    return eErr;
+}
+
 /************************************************************************/
 /*                        SetIgnoredFields()                            */
 /************************************************************************/
@@ -1250,6 +1811,8 @@ OGRErr OGRParquetLayer::SetNextByIndex( GIntBig nIndex )
     m_iRecordBatch = -1;
     ResetReading();
     m_iRecordBatch = 0;
+    // Reading goes on with all the following row groups
+    m_iNextSelectedRowGroup = m_anSelectedRowGroups.size();
     for( int iGroup = 0; iGroup < nNumGroups; ++iGroup )
     {
         const int64_t nNextAccRows = nAccRows + metadata->RowGroup(iGroup)->num_rows();
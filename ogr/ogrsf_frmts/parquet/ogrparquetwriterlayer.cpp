@@ -206,6 +206,8 @@ bool OGRParquetWriterLayer::SetOptions(CSLConstList papszOptions,
     m_bEdgesSpherical = EQUAL(
         CSLFetchNameValueDef(papszOptions, "EDGES", "PLANAR"), "SPHERICAL");
 
+    InitFlushJobQueue(papszOptions);
+
     m_bInitializationOK = true;
     return true;
 }
@@ -665,6 +667,41 @@ bool OGRParquetWriterLayer::FlushGroup()
     return ret;
 }
 
+/************************************************************************/
+/*                         WriteRecordBatch()                           */
+/************************************************************************/
+
+bool OGRParquetWriterLayer::WriteRecordBatch(
+                        const std::shared_ptr<arrow::RecordBatch>& poBatch)
+{
+    // Split the batch in row groups of at most m_nRowGroupSize rows.
+    for( int64_t nOffset = 0; nOffset < poBatch->num_rows();
+         nOffset += m_nRowGroupSize )
+    {
+        const auto poSlice = poBatch->Slice(nOffset, m_nRowGroupSize);
+        auto status = m_poFileWriter->NewRowGroup(poSlice->num_rows());
+        if( !status.ok() )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "NewRowGroup() failed with %s", status.message().c_str());
+            return false;
+        }
+        for( int i = 0; i < poSlice->num_columns(); ++i )
+        {
+            status = m_poFileWriter->WriteColumnChunk(*(poSlice->column(i)));
+            if( !status.ok() )
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                     "WriteColumnChunk() failed for field %s: %s",
+                     poSlice->schema()->field(i)->name().c_str(),
+                     status.message().c_str());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                     FixupGeometryBeforeWriting()                     */
 /************************************************************************/
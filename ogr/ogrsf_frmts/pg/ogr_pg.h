@@ -339,6 +339,33 @@ class OGRPGTableLayer final: public OGRPGLayer
 
     void                UpdateSequenceIfNeeded();
 
+    // State of the COPY ... TO STDOUT (FORMAT binary) statement used by
+    // GetNextArrowArray()
+    enum class CopyOutState
+    {
+        NONE,
+        ACTIVE,
+        FINISHED,
+        INTERRUPTED,
+        BASE_IMPL
+    };
+    CopyOutState        m_eCopyOutState = CopyOutState::NONE;
+    bool                m_bCopyOutCanCancel = false;
+    std::vector<GByte>  m_abyCopyOut{};
+    size_t              m_nCopyOutOffset = 0;
+    std::vector<Oid>    m_anCopyOutColumnTypes{};
+    bool                m_bCopyOutHasFID = false;
+
+    bool                IsCompatOfCopyOutArrowArray();
+    bool                StartCopyOut( bool& bFallbackToBaseImpl );
+    bool                ReadCopyOut( size_t nBytes );
+    bool                TerminateCopyOut( bool bCancel );
+    int                 GetNextArrowArrayFromCopyOut( struct ArrowArray* out_array );
+
+protected:
+    virtual int         GetNextArrowArray(struct ArrowArrayStream*,
+                                          struct ArrowArray* out_array) override;
+
 public:
                         OGRPGTableLayer( OGRPGDataSource *,
                                          CPLString& osCurrentSchema,
@@ -407,6 +434,7 @@ public:
 
     OGRErr              StartCopy();
     OGRErr              EndCopy();
+    void                EndCopyOut( bool bInterrupted );
 
     int                 ReadTableDefinition();
     int                 HasGeometryInformation() { return bGeometryInformationSet; }
@@ -520,6 +548,7 @@ class OGRPGDataSource final: public OGRDataSource
     OGRSpatialReference **papoSRS = nullptr;
 
     OGRPGTableLayer     *poLayerInCopyMode = nullptr;
+    OGRPGTableLayer     *poLayerInCopyOutMode = nullptr;
 
     static void                OGRPGDecodeVersionString(PGver* psVersion, const char* pszVer);
 
@@ -613,6 +642,8 @@ class OGRPGDataSource final: public OGRDataSource
     int                 UseCopy();
     void                StartCopy( OGRPGTableLayer *poPGLayer );
     OGRErr              EndCopy( );
+    void                StartCopyOut( OGRPGTableLayer *poPGLayer );
+    void                ReleaseCopyOut( OGRPGTableLayer *poPGLayer );
 };
 
 #endif /* ndef OGR_PG_H_INCLUDED */
@@ -3152,6 +3152,11 @@ void OGRPGDataSource::StartCopy( OGRPGTableLayer *poPGLayer )
 
 OGRErr OGRPGDataSource::EndCopy( )
 {
+    // A COPY ... TO STDOUT of GetNextArrowArray() must be terminated before
+    // any other command can be issued on the connection.
+    if( poLayerInCopyOutMode != nullptr )
+        poLayerInCopyOutMode->EndCopyOut( /* bInterrupted = */ true );
+
     if( poLayerInCopyMode != nullptr )
     {
         OGRErr result = poLayerInCopyMode->EndCopy();
@@ -3162,3 +3167,22 @@ OGRErr OGRPGDataSource::EndCopy( )
     else
         return OGRERR_NONE;
 }
+
+/************************************************************************/
+/*                            StartCopyOut()                            */
+/************************************************************************/
+
+void OGRPGDataSource::StartCopyOut( OGRPGTableLayer *poPGLayer )
+{
+    poLayerInCopyOutMode = poPGLayer;
+}
+
+/************************************************************************/
+/*                           ReleaseCopyOut()                           */
+/************************************************************************/
+
+void OGRPGDataSource::ReleaseCopyOut( OGRPGTableLayer *poPGLayer )
+{
+    if( poLayerInCopyOutMode == poPGLayer )
+        poLayerInCopyOutMode = nullptr;
+}
@@ -125,6 +125,8 @@ void OGRPGLayer::CloseCursor()
     {
         OGRPGClearResult( hCursorResult );
 
+        poDS->EndCopy();
+
         CPLString    osCommand;
         osCommand.Printf("CLOSE %s", pszCursorName );
 
@@ -1424,6 +1426,11 @@ void OGRPGLayer::SetInitialQueryCursor()
 
     CPLAssert( pszQueryStatement != nullptr );
 
+    // Result layers, and SetNextByIndex(), do not go through
+    // OGRPGTableLayer::GetNextFeature(), so an active COPY on the
+    // connection must be ended here too.
+    poDS->EndCopy();
+
     poDS->SoftStartTransaction();
 
 #if defined(BINARY_CURSOR_ENABLED)
@@ -1506,6 +1513,8 @@ OGRFeature *OGRPGLayer::GetNextRawFeature()
     {
         OGRPGClearResult( hCursorResult );
 
+        poDS->EndCopy();
+
         osCommand.Printf( "FETCH %d in %s", nCursorPage, pszCursorName );
         hCursorResult = OGRPG_PQexec(hPGConn, osCommand );
 
@@ -1578,6 +1587,8 @@ OGRErr OGRPGLayer::SetNextByIndex( GIntBig nIndex )
 
     OGRPGClearResult( hCursorResult );
 
+    poDS->EndCopy();
+
     osCommand.Printf( "FETCH ABSOLUTE " CPL_FRMT_GIB " in %s", nIndex+1, pszCursorName );
     hCursorResult = OGRPG_PQexec(hPGConn, osCommand );
 
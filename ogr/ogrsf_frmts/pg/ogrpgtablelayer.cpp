@@ -33,9 +33,11 @@
 #include "cpl_string.h"
 #include "cpl_error.h"
 #include "ogr_p.h"
+#include "ograrrowarrayhelper.h"
 
 #include <chrono>
 #include <condition_variable>
+#include <limits>
 #include <mutex>
 #include <thread>
 
@@ -195,6 +197,7 @@ OGRPGTableLayer::~OGRPGTableLayer()
 {
     if( bDeferredCreation ) RunDeferredCreationIfNecessary();
     if( bCopyActive ) EndCopy();
+    EndCopyOut( /* bInterrupted = */ false );
     UpdateSequenceIfNeeded();
 
     CPLFree( pszSqlTableName );
@@ -897,6 +900,7 @@ void OGRPGTableLayer::ResetReading()
 
     if( bDeferredCreation ) RunDeferredCreationIfNecessary();
     poDS->EndCopy();
+    EndCopyOut( /* bInterrupted = */ false );
     bUseCopyByDefault = FALSE;
 
     BuildFullQueryStatement();
@@ -952,6 +956,932 @@ OGRFeature *OGRPGTableLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                     IsCompatOfCopyOutArrowArray()                    */
+/************************************************************************/
+
+// Returns whether GetNextArrowArray() can decode the result of a
+// COPY ... TO STDOUT (FORMAT binary) of the layer, rather than going through
+// OGRFeature.
+bool OGRPGTableLayer::IsCompatOfCopyOutArrowArray()
+{
+    if( CPLTestBool(CPLGetConfigOption("OGR_PG_STREAM_BASE_IMPL", "NO")) )
+        return false;
+
+    // Parenthesized options of COPY appeared in PostgreSQL 9.0
+    if( poDS->sPostgreSQLVersion.nMajor < 9 )
+        return false;
+
+    // The FID would need to be copied into a regular field
+    if( iFIDAsRegularColumnIndex >= 0 )
+        return false;
+
+    const int nGeomFieldCount = poFeatureDefn->GetGeomFieldCount();
+    if( m_poFilterGeom != nullptr && m_iGeomFieldFilter < nGeomFieldCount )
+    {
+        // The spatial filter must be entirely evaluated by the WHERE clause
+        const OGRPGGeomFieldDefn* poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(m_iGeomFieldFilter);
+        if( poGeomFieldDefn->ePostgisType != GEOM_TYPE_GEOMETRY &&
+            poGeomFieldDefn->ePostgisType != GEOM_TYPE_GEOGRAPHY )
+            return false;
+    }
+
+    for( int i = 0; i < nGeomFieldCount; i++ )
+    {
+        const OGRPGGeomFieldDefn* poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(i);
+        if( poGeomFieldDefn->IsIgnored() )
+            continue;
+        if( poDS->sPostGISVersion.nMajor < 2 ||
+            (poGeomFieldDefn->ePostgisType != GEOM_TYPE_GEOMETRY &&
+             poGeomFieldDefn->ePostgisType != GEOM_TYPE_GEOGRAPHY) )
+            return false;
+    }
+
+    const int nFieldCount = poFeatureDefn->GetFieldCount();
+    for( int i = 0; i < nFieldCount; i++ )
+    {
+        const OGRFieldDefn* poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        if( poFieldDefn->IsIgnored() )
+            continue;
+        switch( poFieldDefn->GetType() )
+        {
+            case OFTInteger:
+            case OFTInteger64:
+            case OFTReal:
+            case OFTString:
+            case OFTBinary:
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                      GetCopyOutColumnCast()                          */
+/************************************************************************/
+
+// Determines how a column of type nTypeOID is transmitted in the binary
+// COPY for a field of type poFieldDefn. Returns false if the combination
+// isn't handled, otherwise sets pszCast to the SQL cast to apply to the
+// column (possibly empty), and nCopyTypeOID to the resulting type.
+static bool GetCopyOutColumnCast( const OGRFieldDefn* poFieldDefn,
+                                  Oid nTypeOID,
+                                  const char*& pszCast,
+                                  Oid& nCopyTypeOID )
+{
+    pszCast = "";
+    nCopyTypeOID = nTypeOID;
+    switch( poFieldDefn->GetType() )
+    {
+        case OFTInteger:
+        case OFTInteger64:
+        {
+            if( nTypeOID == BOOLOID || nTypeOID == INT2OID ||
+                nTypeOID == INT4OID || nTypeOID == INT8OID )
+                return true;
+            if( nTypeOID == NUMERICOID )
+            {
+                pszCast = "::int8";
+                nCopyTypeOID = INT8OID;
+                return true;
+            }
+            return false;
+        }
+
+        case OFTReal:
+        {
+            if( nTypeOID == FLOAT4OID || nTypeOID == FLOAT8OID ||
+                nTypeOID == INT2OID || nTypeOID == INT4OID ||
+                nTypeOID == INT8OID )
+                return true;
+            if( nTypeOID == NUMERICOID )
+            {
+                pszCast = "::float8";
+                nCopyTypeOID = FLOAT8OID;
+                return true;
+            }
+            return false;
+        }
+
+        case OFTString:
+        {
+            if( nTypeOID == TEXTOID || nTypeOID == VARCHAROID ||
+                nTypeOID == BPCHAROID || nTypeOID == NAMEOID ||
+                nTypeOID == JSONOID || nTypeOID == JSONBOID ||
+                nTypeOID == UUIDOID )
+                return true;
+            // Use the text output of other types, as the text cursor does
+            pszCast = "::text";
+            nCopyTypeOID = TEXTOID;
+            return true;
+        }
+
+        case OFTBinary:
+            return nTypeOID == BYTEAOID;
+
+        case OFTDate:
+            return nTypeOID == DATEOID;
+
+        case OFTTime:
+            return nTypeOID == TIMEOID;
+
+        case OFTDateTime:
+        {
+            if( nTypeOID == TIMESTAMPOID )
+                return true;
+            if( nTypeOID == TIMESTAMPTZOID )
+            {
+                // The text cursor returns the wall clock time in the time
+                // zone of the session, and the Arrow stream ignores the
+                // time zone.
+                pszCast = "::timestamp";
+                nCopyTypeOID = TIMESTAMPOID;
+                return true;
+            }
+            return false;
+        }
+
+        default:
+            break;
+    }
+    return false;
+}
+
+/************************************************************************/
+/*                            StartCopyOut()                            */
+/************************************************************************/
+
+bool OGRPGTableLayer::StartCopyOut( bool& bFallbackToBaseImpl )
+{
+    PGconn *hPGConn = poDS->GetPGConn();
+    bFallbackToBaseImpl = true;
+
+/* -------------------------------------------------------------------- */
+/*      Columns are selected in the order of the Arrow schema: FID,     */
+/*      fields and geometry fields.                                     */
+/* -------------------------------------------------------------------- */
+    std::vector<CPLString> aosColumns;
+    if( pszFIDColumn != nullptr )
+        aosColumns.push_back(OGRPGEscapeColumnName(pszFIDColumn));
+    const int nFieldCount = poFeatureDefn->GetFieldCount();
+    std::vector<const OGRFieldDefn*> apoFieldDefns;
+    for( int i = 0; i < nFieldCount; i++ )
+    {
+        const OGRFieldDefn* poFieldDefn = poFeatureDefn->GetFieldDefn(i);
+        if( poFieldDefn->IsIgnored() )
+            continue;
+        aosColumns.push_back(OGRPGEscapeColumnName(poFieldDefn->GetNameRef()));
+        apoFieldDefns.push_back(poFieldDefn);
+    }
+    const int nGeomFieldCount = poFeatureDefn->GetGeomFieldCount();
+    for( int i = 0; i < nGeomFieldCount; i++ )
+    {
+        const OGRPGGeomFieldDefn* poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(i);
+        if( poGeomFieldDefn->IsIgnored() )
+            continue;
+        aosColumns.push_back(CPLSPrintf("ST_AsBinary(%s, 'NDR')",
+            OGRPGEscapeColumnName(poGeomFieldDefn->GetNameRef()).c_str()));
+    }
+    if( aosColumns.empty() )
+        return false;
+
+/* -------------------------------------------------------------------- */
+/*      Fetch the type of the columns to decide which ones need a cast. */
+/* -------------------------------------------------------------------- */
+    CPLString osColumns;
+    for( const auto& osColumn: aosColumns )
+    {
+        if( !osColumns.empty() )
+            osColumns += ", ";
+        osColumns += osColumn;
+    }
+
+    CPLString osCommand;
+    osCommand.Printf("SELECT %s FROM %s LIMIT 0",
+                     osColumns.c_str(), pszSqlTableName);
+    PGresult* hResult = OGRPG_PQexec(hPGConn, osCommand);
+    if( !hResult || PQresultStatus(hResult) != PGRES_TUPLES_OK ||
+        PQnfields(hResult) != static_cast<int>(aosColumns.size()) )
+    {
+        OGRPGClearResult(hResult);
+        return false;
+    }
+
+    m_bCopyOutHasFID = pszFIDColumn != nullptr;
+    m_anCopyOutColumnTypes.clear();
+    osColumns.clear();
+    int iCol = 0;
+    if( m_bCopyOutHasFID )
+    {
+        const Oid nTypeOID = PQftype(hResult, iCol);
+        if( nTypeOID == INT2OID || nTypeOID == INT4OID || nTypeOID == INT8OID )
+        {
+            osColumns = aosColumns[iCol];
+            m_anCopyOutColumnTypes.push_back(nTypeOID);
+        }
+        else
+        {
+            osColumns = aosColumns[iCol] + "::int8";
+            m_anCopyOutColumnTypes.push_back(INT8OID);
+        }
+        ++iCol;
+    }
+    for( const OGRFieldDefn* poFieldDefn: apoFieldDefns )
+    {
+        const char* pszCast = "";
+        Oid nCopyTypeOID = 0;
+        if( !GetCopyOutColumnCast(poFieldDefn, PQftype(hResult, iCol),
+                                  pszCast, nCopyTypeOID) )
+        {
+            CPLDebug("PG", "Field %s: unhandled OID %d in binary COPY",
+                     poFieldDefn->GetNameRef(),
+                     static_cast<int>(PQftype(hResult, iCol)));
+            OGRPGClearResult(hResult);
+            m_anCopyOutColumnTypes.clear();
+            return false;
+        }
+        if( !osColumns.empty() )
+            osColumns += ", ";
+        osColumns += aosColumns[iCol];
+        osColumns += pszCast;
+        m_anCopyOutColumnTypes.push_back(nCopyTypeOID);
+        ++iCol;
+    }
+    for( ; iCol < static_cast<int>(aosColumns.size()); ++iCol )
+    {
+        if( PQftype(hResult, iCol) != BYTEAOID )
+        {
+            OGRPGClearResult(hResult);
+            m_anCopyOutColumnTypes.clear();
+            return false;
+        }
+        if( !osColumns.empty() )
+            osColumns += ", ";
+        osColumns += aosColumns[iCol];
+        m_anCopyOutColumnTypes.push_back(BYTEAOID);
+    }
+    OGRPGClearResult(hResult);
+
+/* -------------------------------------------------------------------- */
+/*      Issue the COPY.                                                 */
+/* -------------------------------------------------------------------- */
+    bFallbackToBaseImpl = false;
+
+    // Outside of a transaction, the COPY runs in its own implicit
+    // transaction and can be safely cancelled if the stream is not
+    // consumed up to its end.
+    m_bCopyOutCanCancel = PQtransactionStatus(hPGConn) == PQTRANS_IDLE;
+
+    osCommand.Printf("COPY (SELECT %s FROM %s %s) TO STDOUT (FORMAT binary)",
+                     osColumns.c_str(), pszSqlTableName, osWHERE.c_str());
+    hResult = OGRPG_PQexec(hPGConn, osCommand);
+    if( !hResult || PQresultStatus(hResult) != PGRES_COPY_OUT )
+    {
+        OGRPGClearResult(hResult);
+        return false;
+    }
+    OGRPGClearResult(hResult);
+
+    m_abyCopyOut.clear();
+    m_nCopyOutOffset = 0;
+    m_eCopyOutState = CopyOutState::ACTIVE;
+    poDS->StartCopyOut(this);
+
+/* -------------------------------------------------------------------- */
+/*      Check the file header: 11-byte signature, 32-bit flags field    */
+/*      and header extension area.                                      */
+/* -------------------------------------------------------------------- */
+    static const GByte abySignature[] =
+        { 'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xFF, '\r', '\n', '\0' };
+    constexpr size_t HEADER_SIZE = sizeof(abySignature) + 2 * sizeof(GInt32);
+    if( !ReadCopyOut(HEADER_SIZE) ||
+        memcmp(m_abyCopyOut.data(), abySignature, sizeof(abySignature)) != 0 )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Invalid header in binary COPY data");
+        TerminateCopyOut(/* bCancel = */ true);
+        m_eCopyOutState = CopyOutState::FINISHED;
+        return false;
+    }
+    GInt32 nExtensionLength = 0;
+    memcpy(&nExtensionLength,
+           m_abyCopyOut.data() + sizeof(abySignature) + sizeof(GInt32),
+           sizeof(GInt32));
+    CPL_MSBPTR32(&nExtensionLength);
+    m_nCopyOutOffset = HEADER_SIZE;
+    if( nExtensionLength < 0 ||
+        !ReadCopyOut(static_cast<size_t>(nExtensionLength)) )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Invalid header in binary COPY data");
+        TerminateCopyOut(/* bCancel = */ true);
+        m_eCopyOutState = CopyOutState::FINISHED;
+        return false;
+    }
+    m_nCopyOutOffset += static_cast<size_t>(nExtensionLength);
+
+    return true;
+}
+
+/************************************************************************/
+/*                            ReadCopyOut()                             */
+/************************************************************************/
+
+// Makes sure that at least nBytes are available in m_abyCopyOut after
+// m_nCopyOutOffset, fetching more COPY data messages from the server as
+// needed. Values may span several messages.
+bool OGRPGTableLayer::ReadCopyOut( size_t nBytes )
+{
+    while( m_abyCopyOut.size() - m_nCopyOutOffset < nBytes )
+    {
+        if( m_nCopyOutOffset > 0 )
+        {
+            m_abyCopyOut.erase(m_abyCopyOut.begin(),
+                               m_abyCopyOut.begin() + m_nCopyOutOffset);
+            m_nCopyOutOffset = 0;
+        }
+
+        char* pabyBuffer = nullptr;
+        const int nRet = PQgetCopyData(poDS->GetPGConn(), &pabyBuffer, 0);
+        if( nRet <= 0 )
+        {
+            if( pabyBuffer )
+                PQfreemem(pabyBuffer);
+            return false;
+        }
+        try
+        {
+            m_abyCopyOut.insert(m_abyCopyOut.end(),
+                                reinterpret_cast<GByte*>(pabyBuffer),
+                                reinterpret_cast<GByte*>(pabyBuffer) + nRet);
+        }
+        catch( const std::bad_alloc& )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Out of memory in binary COPY data");
+            PQfreemem(pabyBuffer);
+            return false;
+        }
+        PQfreemem(pabyBuffer);
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                          TerminateCopyOut()                          */
+/************************************************************************/
+
+// Consumes the remaining COPY data and the final result of the COPY, so
+// that the connection can be used again. Returns false if the server reported
+// an error.
+bool OGRPGTableLayer::TerminateCopyOut( bool bCancel )
+{
+    PGconn *hPGConn = poDS->GetPGConn();
+
+    if( bCancel && m_bCopyOutCanCancel )
+    {
+        PGcancel* hCancel = PQgetCancel(hPGConn);
+        if( hCancel )
+        {
+            char szErrBuf[256] = {};
+            PQcancel(hCancel, szErrBuf, sizeof(szErrBuf));
+            PQfreeCancel(hCancel);
+        }
+    }
+
+    while( true )
+    {
+        char* pabyBuffer = nullptr;
+        const int nRet = PQgetCopyData(hPGConn, &pabyBuffer, 0);
+        if( pabyBuffer )
+            PQfreemem(pabyBuffer);
+        if( nRet < 0 )
+            break;
+    }
+
+    bool bRet = true;
+    PGresult* hResult = nullptr;
+    while( (hResult = PQgetResult(hPGConn)) != nullptr )
+    {
+        if( PQresultStatus(hResult) != PGRES_COMMAND_OK )
+        {
+            bRet = false;
+            if( !bCancel )
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "%s",
+                         PQresultErrorMessage(hResult));
+            }
+        }
+        PQclear(hResult);
+    }
+
+    m_abyCopyOut.clear();
+    m_nCopyOutOffset = 0;
+    poDS->ReleaseCopyOut(this);
+
+    return bRet;
+}
+
+/************************************************************************/
+/*                             EndCopyOut()                             */
+/************************************************************************/
+
+void OGRPGTableLayer::EndCopyOut( bool bInterrupted )
+{
+    if( m_eCopyOutState == CopyOutState::ACTIVE )
+    {
+        TerminateCopyOut(/* bCancel = */ true);
+        m_eCopyOutState = bInterrupted ? CopyOutState::INTERRUPTED :
+                                         CopyOutState::NONE;
+    }
+    else if( !bInterrupted )
+    {
+        m_eCopyOutState = CopyOutState::NONE;
+    }
+}
+
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/************************************************************************/
+
+int OGRPGTableLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
+                                       struct ArrowArray* out_array)
+{
+    if( m_eCopyOutState == CopyOutState::NONE )
+    {
+        if( bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE )
+        {
+            memset(out_array, 0, sizeof(*out_array));
+            return EIO;
+        }
+        poDS->EndCopy();
+        GetLayerDefn()->GetFieldCount();
+
+        bool bFallbackToBaseImpl = true;
+        if( !IsCompatOfCopyOutArrowArray() ||
+            !StartCopyOut(bFallbackToBaseImpl) )
+        {
+            if( !bFallbackToBaseImpl )
+            {
+                memset(out_array, 0, sizeof(*out_array));
+                return EIO;
+            }
+            m_eCopyOutState = CopyOutState::BASE_IMPL;
+        }
+    }
+
+    switch( m_eCopyOutState )
+    {
+        case CopyOutState::ACTIVE:
+            return GetNextArrowArrayFromCopyOut(out_array);
+
+        case CopyOutState::INTERRUPTED:
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Arrow stream has been interrupted by another operation "
+                     "on the connection. ResetReading() must be explicitly "
+                     "called to restart reading");
+            memset(out_array, 0, sizeof(*out_array));
+            return EIO;
+
+        case CopyOutState::FINISHED:
+            memset(out_array, 0, sizeof(*out_array));
+            return 0;
+
+        default:
+            break;
+    }
+    return OGRPGLayer::GetNextArrowArray(stream, out_array);
+}
+
+/************************************************************************/
+/*                    GetNextArrowArrayFromCopyOut()                    */
+/************************************************************************/
+
+static inline GInt16 CopyOutInt16( const GByte* pabyData )
+{
+    GInt16 nVal;
+    memcpy(&nVal, pabyData, sizeof(nVal));
+    CPL_MSBPTR16(&nVal);
+    return nVal;
+}
+
+static inline GInt32 CopyOutInt32( const GByte* pabyData )
+{
+    GInt32 nVal;
+    memcpy(&nVal, pabyData, sizeof(nVal));
+    CPL_MSBPTR32(&nVal);
+    return nVal;
+}
+
+static inline GInt64 CopyOutInt64( const GByte* pabyData )
+{
+    GInt64 nVal;
+    memcpy(&nVal, pabyData, sizeof(nVal));
+    CPL_MSBPTR64(&nVal);
+    return nVal;
+}
+
+// Decodes a binary value of an integer or floating-point column
+static bool CopyOutNumber( Oid nTypeOID, const GByte* pabyData, int nLen,
+                           GInt64& nVal, double& dfVal )
+{
+    switch( nTypeOID )
+    {
+        case BOOLOID:
+            if( nLen != 1 )
+                return false;
+            nVal = pabyData[0] != 0;
+            dfVal = static_cast<double>(nVal);
+            return true;
+
+        case INT2OID:
+            if( nLen != 2 )
+                return false;
+            nVal = CopyOutInt16(pabyData);
+            dfVal = static_cast<double>(nVal);
+            return true;
+
+        case INT4OID:
+            if( nLen != 4 )
+                return false;
+            nVal = CopyOutInt32(pabyData);
+            dfVal = static_cast<double>(nVal);
+            return true;
+
+        case INT8OID:
+            if( nLen != 8 )
+                return false;
+            nVal = CopyOutInt64(pabyData);
+            dfVal = static_cast<double>(nVal);
+            return true;
+
+        case FLOAT4OID:
+        {
+            if( nLen != 4 )
+                return false;
+            float fVal;
+            memcpy(&fVal, pabyData, sizeof(fVal));
+            CPL_MSBPTR32(&fVal);
+            dfVal = fVal;
+            nVal = 0;
+            return true;
+        }
+
+        case FLOAT8OID:
+            if( nLen != 8 )
+                return false;
+            memcpy(&dfVal, pabyData, sizeof(dfVal));
+            CPL_MSBPTR64(&dfVal);
+            nVal = 0;
+            return true;
+
+        default:
+            break;
+    }
+    return false;
+}
+
+int OGRPGTableLayer::GetNextArrowArrayFromCopyOut( struct ArrowArray* out_array )
+{
+    OGRArrowArrayHelper sHelper(poDS, poFeatureDefn,
+                                m_aosArrowArrayStreamOptions,
+                                out_array);
+    if( out_array->release == nullptr )
+    {
+        return ENOMEM;
+    }
+
+    // Difference between the PostgreSQL epoch (2000-01-01) and the Unix one
+    constexpr int DAYS_2000_SINCE_1970 = 10957;
+    constexpr GInt64 SECONDS_2000_SINCE_1970 =
+        static_cast<GInt64>(DAYS_2000_SINCE_1970) * 86400;
+
+    const int nColumns = static_cast<int>(m_anCopyOutColumnTypes.size());
+    const GByte* pabyData = nullptr;
+    int nLen = 0;
+    bool bTruncated = false;
+
+    // Reads the next value of the current tuple. nLen is set to -1 for NULL
+    const auto ReadValue = [this, &pabyData, &nLen, &bTruncated]()
+    {
+        if( !ReadCopyOut(sizeof(GInt32)) )
+        {
+            bTruncated = true;
+            return false;
+        }
+        nLen = CopyOutInt32(m_abyCopyOut.data() + m_nCopyOutOffset);
+        m_nCopyOutOffset += sizeof(GInt32);
+        if( nLen < 0 )
+        {
+            pabyData = nullptr;
+            return true;
+        }
+        if( !ReadCopyOut(static_cast<size_t>(nLen)) )
+        {
+            bTruncated = true;
+            return false;
+        }
+        pabyData = m_abyCopyOut.data() + m_nCopyOutOffset;
+        m_nCopyOutOffset += static_cast<size_t>(nLen);
+        return true;
+    };
+
+    int iFeat = 0;
+    for( ; iFeat < sHelper.nMaxBatchSize; iFeat++ )
+    {
+        if( !ReadCopyOut(sizeof(GInt16)) )
+        {
+            bTruncated = true;
+            goto error;
+        }
+        const int nTupleFields =
+            CopyOutInt16(m_abyCopyOut.data() + m_nCopyOutOffset);
+        m_nCopyOutOffset += sizeof(GInt16);
+
+        // File trailer
+        if( nTupleFields == -1 )
+        {
+            const bool bOK = TerminateCopyOut(/* bCancel = */ false);
+            m_eCopyOutState = CopyOutState::FINISHED;
+            if( !bOK )
+            {
+                sHelper.ClearArray();
+                return EIO;
+            }
+            break;
+        }
+        if( nTupleFields != nColumns )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unexpected number of columns in binary COPY data");
+            goto error;
+        }
+
+        int iCol = 0;
+        GIntBig nFID = iNextShapeId;
+        if( m_bCopyOutHasFID )
+        {
+            if( !ReadValue() )
+                goto error;
+            GInt64 nVal = 0;
+            double dfVal = 0;
+            if( nLen >= 0 )
+            {
+                if( !CopyOutNumber(m_anCopyOutColumnTypes[iCol], pabyData,
+                                   nLen, nVal, dfVal) )
+                    goto invalid_value;
+                nFID = nVal;
+            }
+            ++iCol;
+        }
+        if( sHelper.panFIDValues )
+            sHelper.panFIDValues[iFeat] = nFID;
+        iNextShapeId++;
+        m_nFeaturesRead++;
+
+        for( int iField = 0; iField < sHelper.nFieldCount; iField++ )
+        {
+            const int iArrowField = sHelper.mapOGRFieldToArrowField[iField];
+            if( iArrowField < 0 )
+                continue;
+            const Oid nTypeOID = m_anCopyOutColumnTypes[iCol];
+            ++iCol;
+            if( !ReadValue() )
+                goto error;
+            if( nLen < 0 )
+            {
+                if( !sHelper.SetNull(iArrowField, iFeat) )
+                    goto error_oom;
+                continue;
+            }
+
+            const OGRFieldDefn *poFieldDefn = poFeatureDefn->GetFieldDefn(iField);
+            auto psArray = out_array->children[iArrowField];
+            switch( poFieldDefn->GetType() )
+            {
+                case OFTInteger:
+                case OFTInteger64:
+                case OFTReal:
+                {
+                    GInt64 nVal = 0;
+                    double dfVal = 0;
+                    if( !CopyOutNumber(nTypeOID, pabyData, nLen, nVal, dfVal) )
+                        goto invalid_value;
+                    if( poFieldDefn->GetType() == OFTReal )
+                    {
+                        if( poFieldDefn->GetSubType() == OFSTFloat32 )
+                            sHelper.SetFloat(psArray, iFeat,
+                                             static_cast<float>(dfVal));
+                        else
+                            sHelper.SetDouble(psArray, iFeat, dfVal);
+                    }
+                    else if( poFieldDefn->GetType() == OFTInteger64 )
+                    {
+                        sHelper.SetInt64(psArray, iFeat, nVal);
+                    }
+                    else if( poFieldDefn->GetSubType() == OFSTBoolean )
+                    {
+                        if( nVal != 0 )
+                            sHelper.SetBoolOn(psArray, iFeat);
+                    }
+                    else if( poFieldDefn->GetSubType() == OFSTInt16 )
+                    {
+                        sHelper.SetInt16(psArray, iFeat,
+                                         static_cast<int16_t>(nVal));
+                    }
+                    else
+                    {
+                        sHelper.SetInt32(psArray, iFeat,
+                                         static_cast<int32_t>(nVal));
+                    }
+                    break;
+                }
+
+                case OFTString:
+                {
+                    if( nTypeOID == UUIDOID )
+                    {
+                        if( nLen != 16 )
+                            goto invalid_value;
+                        constexpr int UUID_STR_LEN = 36;
+                        GByte* outPtr = sHelper.GetPtrForStringOrBinary(
+                            iArrowField, iFeat, UUID_STR_LEN);
+                        if( outPtr == nullptr )
+                            goto error_oom;
+                        char szUUID[UUID_STR_LEN + 1];
+                        snprintf(szUUID, sizeof(szUUID),
+                                 "%02x%02x%02x%02x-%02x%02x-%02x%02x-"
+                                 "%02x%02x-%02x%02x%02x%02x%02x%02x",
+                                 pabyData[0], pabyData[1], pabyData[2],
+                                 pabyData[3], pabyData[4], pabyData[5],
+                                 pabyData[6], pabyData[7], pabyData[8],
+                                 pabyData[9], pabyData[10], pabyData[11],
+                                 pabyData[12], pabyData[13], pabyData[14],
+                                 pabyData[15]);
+                        memcpy(outPtr, szUUID, UUID_STR_LEN);
+                        break;
+                    }
+                    if( nTypeOID == JSONBOID )
+                    {
+                        // Skip the version number of the jsonb format
+                        if( nLen < 1 || pabyData[0] != 1 )
+                            goto invalid_value;
+                        ++pabyData;
+                        --nLen;
+                    }
+                    CPL_FALLTHROUGH
+                }
+
+                case OFTBinary:
+                {
+                    if( nLen > 0 )
+                    {
+                        GByte* outPtr = sHelper.GetPtrForStringOrBinary(
+                            iArrowField, iFeat, nLen);
+                        if( outPtr == nullptr )
+                            goto error_oom;
+                        memcpy(outPtr, pabyData, nLen);
+                    }
+                    else
+                    {
+                        sHelper.SetEmptyStringOrBinary(psArray, iFeat);
+                    }
+                    break;
+                }
+
+                case OFTDate:
+                {
+                    if( nLen != 4 )
+                        goto invalid_value;
+                    const GInt32 nDays = CopyOutInt32(pabyData);
+                    // 'infinity' and '-infinity'
+                    if( nDays == std::numeric_limits<GInt32>::max() ||
+                        nDays == std::numeric_limits<GInt32>::min() )
+                    {
+                        if( !sHelper.SetNull(iArrowField, iFeat) )
+                            goto error_oom;
+                        break;
+                    }
+                    sHelper.SetInt32(psArray, iFeat,
+                                     nDays + DAYS_2000_SINCE_1970);
+                    break;
+                }
+
+                case OFTTime:
+                {
+                    if( nLen != 8 )
+                        goto invalid_value;
+                    // Microseconds since midnight
+                    const GInt64 nMicroSec = CopyOutInt64(pabyData);
+                    sHelper.SetInt32(psArray, iFeat,
+                                     static_cast<int32_t>((nMicroSec + 500) / 1000));
+                    break;
+                }
+
+                case OFTDateTime:
+                {
+                    if( nLen != 8 )
+                        goto invalid_value;
+                    // Microseconds since 2000-01-01
+                    const GInt64 nMicroSec = CopyOutInt64(pabyData);
+                    // 'infinity' and '-infinity'
+                    if( nMicroSec == std::numeric_limits<GInt64>::max() ||
+                        nMicroSec == std::numeric_limits<GInt64>::min() )
+                    {
+                        if( !sHelper.SetNull(iArrowField, iFeat) )
+                            goto error_oom;
+                        break;
+                    }
+                    GInt64 nSec = nMicroSec / 1000000;
+                    GInt64 nFracMicroSec = nMicroSec % 1000000;
+                    if( nFracMicroSec < 0 )
+                    {
+                        nSec --;
+                        nFracMicroSec += 1000000;
+                    }
+                    // Same rounding of milliseconds as SetDateTime()
+                    sHelper.SetInt64(psArray, iFeat,
+                                     (nSec + SECONDS_2000_SINCE_1970) * 1000 +
+                                     ((nFracMicroSec + 500) / 1000) % 1000);
+                    break;
+                }
+
+                default:
+                    break;
+            }
+        }
+
+        for( int iGeomField = 0; iGeomField < sHelper.nGeomFieldCount; iGeomField++ )
+        {
+            const int iArrowField = sHelper.mapOGRGeomFieldToArrowField[iGeomField];
+            if( iArrowField < 0 )
+                continue;
+            ++iCol;
+            if( !ReadValue() )
+                goto error;
+            if( nLen <= 0 )
+            {
+                if( !sHelper.SetNull(iArrowField, iFeat) )
+                    goto error_oom;
+                continue;
+            }
+            GByte* outPtr = sHelper.GetPtrForStringOrBinary(
+                iArrowField, iFeat, nLen);
+            if( outPtr == nullptr )
+                goto error_oom;
+            memcpy(outPtr, pabyData, nLen);
+        }
+    }
+
+    if( iFeat == 0 )
+    {
+        sHelper.ClearArray();
+        return 0;
+    }
+    sHelper.Shrink(iFeat);
+
+    return 0;
+
+invalid_value:
+    CPLError(CE_Failure, CPLE_AppDefined,
+             "Invalid value in binary COPY data");
+    goto error;
+
+error_oom:
+    sHelper.ClearArray();
+    TerminateCopyOut(/* bCancel = */ true);
+    m_eCopyOutState = CopyOutState::FINISHED;
+    return ENOMEM;
+
+error:
+    sHelper.ClearArray();
+    if( bTruncated )
+    {
+        // The server may have reported an error in the middle of the COPY
+        if( TerminateCopyOut(/* bCancel = */ false) )
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unexpected end of binary COPY data");
+        }
+    }
+    else
+    {
+        TerminateCopyOut(/* bCancel = */ true);
+    }
+    m_eCopyOutState = CopyOutState::FINISHED;
+    return EIO;
+}
+
 /************************************************************************/
 /*                            BuildFields()                             */
 /*                                                                      */
@@ -2085,6 +3015,12 @@ int OGRPGTableLayer::TestCapability( const char * pszCap )
     else if( EQUAL(pszCap,OLCTransactions) )
         return TRUE;
 
+    else if( EQUAL(pszCap,OLCFastGetArrowStream) )
+    {
+        GetLayerDefn()->GetFieldCount();
+        return IsCompatOfCopyOutArrowArray();
+    }
+
     else if( EQUAL(pszCap,OLCFastGetExtent) )
     {
         OGRPGGeomFieldDefn* poGeomFieldDefn = nullptr;
@@ -40,7 +40,9 @@
 #include "shapefil.h"
 #include "shp_vsi.h"
 #include "ogrlayerpool.h"
+#include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
 /* Was limited to 255 until OGR 1.10, but 254 seems to be a more */
@@ -56,6 +58,9 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                                OGRFeatureDefn * poDefn, int iShape,
                                SHPObject *psShape, const char *pszSHPEncoding );
 OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape );
+void SHPReadOGRObjectAsWKB( SHPHandle hSHP, int iShape, SHPObject *psShape,
+                            OGRwkbGeometryType eLayerGeomType,
+                            std::vector<GByte>& abyWKB );
 OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
                                        SHPHandle hSHP, DBFHandle hDBF,
                                        const char *pszSHPEncoding,
@@ -101,6 +106,37 @@ class OGRShapeGeomFieldDefn final: public OGRGeomFieldDefn
         void SetPrjFilename(const std::string& osFilename) { osPrjFile = osFilename; }
 };
 
+/************************************************************************/
+/*                         OGRShapePackedRTree                          */
+/************************************************************************/
+
+// Static packed Hilbert R-tree stored in a .hrt sidecar file.
+class OGRShapePackedRTree
+{
+    CPL_DISALLOW_COPY_ASSIGN(OGRShapePackedRTree)
+
+    VSILFILE           *m_fp = nullptr;
+    int                 m_nNodeSize = 0;
+    uint64_t            m_nNumItems = 0;
+    int                 m_nRecords = 0;  // Of the .shp
+    // [begin, end[ node indices of each level, leaf level first.
+    std::vector<std::pair<uint64_t, uint64_t>> m_aoLevelBounds{};
+
+                        OGRShapePackedRTree() = default;
+
+  public:
+    static constexpr int DEFAULT_NODE_SIZE = 16;
+
+                        ~OGRShapePackedRTree();
+
+    static std::unique_ptr<OGRShapePackedRTree> Open( const char* pszFilename,
+                                                      SHPHandle hSHP );
+    static bool         Create( SHPHandle hSHP, const char* pszFilename,
+                                int nNodeSize = DEFAULT_NODE_SIZE );
+
+    int                *Search( const OGREnvelope& oEnv, int* pnCount ) const;
+};
+
 /************************************************************************/
 /*                            OGRShapeLayer                             */
 /************************************************************************/
@@ -148,6 +184,13 @@ class OGRShapeLayer final: public OGRAbstractProxiedLayer
     SBNSearchHandle     hSBN;
     bool                CheckForSBN();
 
+    bool                m_bCheckedForHRT = false;
+    std::unique_ptr<OGRShapePackedRTree> m_poHRT{};
+    bool                CheckForHRT();
+
+    bool                HasSpatialIndex()
+        { return CheckForHRT() || CheckForQIX() || CheckForSBN(); }
+
     bool                bSbnSbxDeleted;
 
     CPLString           ConvertCodePage( const char * );
@@ -167,6 +210,8 @@ class OGRShapeLayer final: public OGRAbstractProxiedLayer
     } FileDescriptorState;
     FileDescriptorState eFileDescriptorsState;
 
+    std::vector<GByte>  m_abyArrowWKB{};  // Temporary buffer of GetNextArrowArray()
+
     bool                TouchLayer();
     bool                ReopenFileDescriptors();
 
@@ -175,6 +220,7 @@ class OGRShapeLayer final: public OGRAbstractProxiedLayer
     void                TruncateDBF();
 
     bool                bCreateSpatialIndexAtClose;
+    bool                m_bHilbertSpatialIndex = false;
     bool                bRewindOnWrite;
 
     bool                m_bAutoRepack;
@@ -199,6 +245,7 @@ class OGRShapeLayer final: public OGRAbstractProxiedLayer
 
   public:
     OGRErr              CreateSpatialIndex( int nMaxDepth );
+    OGRErr              CreateHilbertSpatialIndex();
     OGRErr              DropSpatialIndex();
     OGRErr              Repack();
     OGRErr              RecomputeExtent();
@@ -225,6 +272,8 @@ class OGRShapeLayer final: public OGRAbstractProxiedLayer
     void                ResetReading() override;
     OGRFeature *        GetNextFeature() override;
     OGRErr              SetNextByIndex( GIntBig nIndex ) override;
+    int                 GetNextArrowArray(struct ArrowArrayStream*,
+                                          struct ArrowArray* out_array) override;
 
     OGRFeature         *GetFeature( GIntBig nFeatureId ) override;
     OGRErr              ISetFeature( OGRFeature *poFeature ) override;
@@ -263,6 +312,8 @@ class OGRShapeLayer final: public OGRAbstractProxiedLayer
     void                AddToFileList( CPLStringList& oFileList );
     void                CreateSpatialIndexAtClose( int bFlag )
         { bCreateSpatialIndexAtClose = CPL_TO_BOOL(bFlag); }
+    void                SetHilbertSpatialIndex( bool bFlag )
+        { m_bHilbertSpatialIndex = bFlag; }
     void                SetModificationDate( const char* pszStr );
     void                SetAutoRepack(bool b) { m_bAutoRepack = b; }
     void                SetWriteDBFEOFChar(bool b);
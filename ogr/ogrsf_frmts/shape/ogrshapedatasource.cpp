@@ -948,6 +948,9 @@ OGRShapeDataSource::ICreateLayer( const char * pszLayerName,
         CPLFetchBool( papszOptions, "RESIZE", false ) );
     poLayer->CreateSpatialIndexAtClose(
         CPLFetchBool( papszOptions, "SPATIAL_INDEX", false ) );
+    poLayer->SetHilbertSpatialIndex(
+        EQUAL(CSLFetchNameValueDef(papszOptions, "SPATIAL_INDEX_TYPE", "QIX"),
+              "HILBERT") );
     poLayer->SetModificationDate(
         CSLFetchNameValue( papszOptions, "DBF_DATE_LAST_UPDATE" ) );
     poLayer->SetAutoRepack(
@@ -1103,6 +1106,7 @@ OGRLayer *OGRShapeDataSource::GetLayerByName( const char * pszLayerNameIn )
 /*      SPATIAL INDEX commands.  Support forms are:                     */
 /*                                                                      */
 /*        CREATE SPATIAL INDEX ON layer_name [DEPTH n]                  */
+/*        CREATE SPATIAL INDEX ON layer_name TYPE HILBERT               */
 /*        DROP SPATIAL INDEX ON layer_name                              */
 /*        REPACK layer_name                                             */
 /*        RECOMPUTE EXTENT ON layer_name                                */
@@ -1246,23 +1250,30 @@ OGRLayer * OGRShapeDataSource::ExecuteSQL( const char *pszStatement,
         || !EQUAL(papszTokens[2],"INDEX")
         || !EQUAL(papszTokens[3],"ON")
         || CSLCount(papszTokens) > 7
-        || (CSLCount(papszTokens) == 7 && !EQUAL(papszTokens[5],"DEPTH")) )
+        || (CSLCount(papszTokens) == 7 && !EQUAL(papszTokens[5],"DEPTH") &&
+            !(EQUAL(papszTokens[5],"TYPE") &&
+              (EQUAL(papszTokens[6],"QIX") ||
+               EQUAL(papszTokens[6],"HILBERT")))) )
     {
         CSLDestroy( papszTokens );
         CPLError( CE_Failure, CPLE_AppDefined,
                   "Syntax error in CREATE SPATIAL INDEX command.\n"
                   "Was '%s'\n"
                   "Should be of form 'CREATE SPATIAL INDEX ON <table> "
-                  "[DEPTH <n>]'",
+                  "[DEPTH <n>|TYPE QIX|TYPE HILBERT]'",
                   pszStatement );
         return nullptr;
     }
 
 /* -------------------------------------------------------------------- */
-/*      Get depth if provided.                                          */
+/*      Get depth or index type if provided.                            */
 /* -------------------------------------------------------------------- */
+    const bool bHilbert = CSLCount(papszTokens) == 7 &&
+                          EQUAL(papszTokens[5],"TYPE") &&
+                          EQUAL(papszTokens[6],"HILBERT");
     const int nDepth =
-        CSLCount(papszTokens) == 7 ? atoi(papszTokens[6]) : 0;
+        CSLCount(papszTokens) == 7 && EQUAL(papszTokens[5],"DEPTH") ?
+            atoi(papszTokens[6]) : 0;
 
 /* -------------------------------------------------------------------- */
 /*      What layer are we operating on.                                 */
@@ -1281,7 +1292,10 @@ OGRLayer * OGRShapeDataSource::ExecuteSQL( const char *pszStatement,
 
     CSLDestroy( papszTokens );
 
-    poLayer->CreateSpatialIndex( nDepth );
+    if( bHilbert )
+        poLayer->CreateHilbertSpatialIndex();
+    else
+        poLayer->CreateSpatialIndex( nDepth );
     return nullptr;
 }
 
@@ -1293,7 +1307,7 @@ const char* const* OGRShapeDataSource::GetExtensionsForDeletion()
 {
     static const char * const apszExtensions[] =
         { "shp", "shx", "dbf", "sbn", "sbx", "prj", "idm", "ind",
-          "qix", "cpg",
+          "qix", "hrt", "cpg",
           "qpj", // QGIS projection file
           nullptr };
     return apszExtensions;
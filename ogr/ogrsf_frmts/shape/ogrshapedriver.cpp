@@ -387,6 +387,10 @@ void RegisterOGRShape()
 "  <Option name='ENCODING' type='string' description='DBF encoding' default='LDID/87'/>"
 "  <Option name='RESIZE' type='boolean' description='To resize fields to their optimal size.' default='NO'/>"
 "  <Option name='SPATIAL_INDEX' type='boolean' description='To create a spatial index.' default='NO'/>"
+"  <Option name='SPATIAL_INDEX_TYPE' type='string-select' description='Type of spatial index created when SPATIAL_INDEX=YES' default='QIX'>"
+"    <Value>QIX</Value>"
+"    <Value>HILBERT</Value>"
+"  </Option>"
 "  <Option name='DBF_DATE_LAST_UPDATE' type='string' description='Modification date to write in DBF header with YYYY-MM-DD format'/>"
 "  <Option name='AUTO_REPACK' type='boolean' description='Whether the shapefile should be automatically repacked when needed' default='YES'/>"
 "  <Option name='DBF_EOF_CHAR' type='boolean' description='Whether to write the 0x1A end-of-file character in DBF files' default='YES'/>"
@@ -52,6 +52,7 @@
 #include "ogr_p.h"
 #include "ogr_spatialref.h"
 #include "ogr_srs_api.h"
+#include "ograrrowarrayhelper.h"
 #include "ogrlayerpool.h"
 #include "ogrsf_frmts.h"
 #include "shapefil.h"
@@ -271,7 +272,10 @@ OGRShapeLayer::~OGRShapeLayer()
     }
     if( bCreateSpatialIndexAtClose && hSHP != nullptr )
     {
-        CreateSpatialIndex(0);
+        if( m_bHilbertSpatialIndex )
+            CreateHilbertSpatialIndex();
+        else
+            CreateSpatialIndex(0);
     }
 
     if( m_nFeaturesRead > 0 && poFeatureDefn != nullptr )
@@ -530,6 +534,27 @@ bool OGRShapeLayer::CheckForSBN()
     return hSBN != nullptr;
 }
 
+/************************************************************************/
+/*                            CheckForHRT()                             */
+/************************************************************************/
+
+bool OGRShapeLayer::CheckForHRT()
+
+{
+    if( m_bCheckedForHRT )
+        return m_poHRT != nullptr;
+
+    if( hSHP != nullptr )
+    {
+        const char *pszHRTFilename = CPLResetExtension( pszFullName, "hrt" );
+        m_poHRT = OGRShapePackedRTree::Open( pszHRTFilename, hSHP );
+    }
+
+    m_bCheckedForHRT = true;
+
+    return m_poHRT != nullptr;
+}
+
 /************************************************************************/
 /*                            ScanIndices()                             */
 /*                                                                      */
@@ -593,16 +618,19 @@ bool OGRShapeLayer::ScanIndices()
 
     if( bTryQIXorSBN )
     {
-        if( !bCheckedForQIX )
+        if( !m_bCheckedForHRT )
+            CPL_IGNORE_RET_VAL(CheckForHRT());
+        if( m_poHRT == nullptr && !bCheckedForQIX )
             CPL_IGNORE_RET_VAL(CheckForQIX());
-        if( hQIX == nullptr && !bCheckedForSBN )
+        if( m_poHRT == nullptr && hQIX == nullptr && !bCheckedForSBN )
             CPL_IGNORE_RET_VAL(CheckForSBN());
     }
 
 /* -------------------------------------------------------------------- */
 /*      Compute spatial index if appropriate.                           */
 /* -------------------------------------------------------------------- */
-    if( bTryQIXorSBN && (hQIX != nullptr || hSBN != nullptr) &&
+    if( bTryQIXorSBN &&
+        (m_poHRT != nullptr || hQIX != nullptr || hSBN != nullptr) &&
         panSpatialFIDs == nullptr )
     {
         double adfBoundsMin[4] = {
@@ -616,7 +644,10 @@ bool OGRShapeLayer::ScanIndices()
             0.0,
             0.0 };
 
-        if( hQIX != nullptr )
+        if( m_poHRT != nullptr )
+            panSpatialFIDs = m_poHRT->Search( oSpatialFilterEnvelope,
+                                              &nSpatialFIDCount );
+        else if( hQIX != nullptr )
             panSpatialFIDs = SHPSearchDiskTreeEx( hQIX,
                                                   adfBoundsMin, adfBoundsMax,
                                                   &nSpatialFIDCount );
@@ -964,6 +995,302 @@ OGRFeature *OGRShapeLayer::GetFeature( GIntBig nFeatureId )
     return poFeature;
 }
 
+/************************************************************************/
+/*                         GetDBFTrimmedValue()                         */
+/*                                                                      */
+/*      Extract a field of a raw DBF record like DBFReadAttribute()     */
+/*      does: stop at the first nul character, and remove leading and   */
+/*      trailing spaces.                                                */
+/************************************************************************/
+
+static void GetDBFTrimmedValue( const char* pszRecord, int nOffset, int nSize,
+                                std::string& osValue )
+{
+    const char* pszStart = pszRecord + nOffset;
+    const char* pszEnd = static_cast<const char*>(memchr(pszStart, 0, nSize));
+    if( pszEnd == nullptr )
+        pszEnd = pszStart + nSize;
+    while( pszStart < pszEnd && *pszStart == ' ' )
+        ++pszStart;
+    while( pszEnd > pszStart && pszEnd[-1] == ' ' )
+        --pszEnd;
+    osValue.assign(pszStart, pszEnd - pszStart);
+}
+
+/************************************************************************/
+/*                        GetNextArrowArray()                           */
+/*                                                                      */
+/*      Decodes .shp records directly into WKB, and .dbf fixed-width    */
+/*      records directly into Arrow columns, without building           */
+/*      OGRFeature objects.                                             */
+/************************************************************************/
+
+int OGRShapeLayer::GetNextArrowArray(struct ArrowArrayStream* stream,
+                                     struct ArrowArray* out_array)
+{
+    if( !TouchLayer() )
+    {
+        memset(out_array, 0, sizeof(*out_array));
+        return EIO;
+    }
+
+    if( m_poAttrQuery != nullptr ||
+        (m_poFilterGeom != nullptr && poFeatureDefn->IsGeometryIgnored()) ||
+        CPLTestBool(CPLGetConfigOption("OGR_SHAPE_STREAM_BASE_IMPL", "NO")) )
+    {
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+
+    memset(out_array, 0, sizeof(*out_array));
+
+    if( m_poFilterGeom != nullptr
+        && iNextShapeId == 0 && panMatchingFIDs == nullptr )
+    {
+        ScanIndices();
+    }
+
+    OGRArrowArrayHelper sHelper(nullptr, // dataset pointer. only used for field domains (not used by Shapefile)
+                                poFeatureDefn, m_aosArrowArrayStreamOptions,
+                                out_array);
+    if( out_array->release == nullptr )
+    {
+        return ENOMEM;
+    }
+
+    const int iArrowGeomField = (hSHP != nullptr &&
+                                 !poFeatureDefn->IsGeometryIgnored() &&
+                                 sHelper.nGeomFieldCount > 0) ?
+                            sHelper.mapOGRGeomFieldToArrowField[0] : -1;
+    const OGRwkbGeometryType eLayerGeomType = poFeatureDefn->GetGeomType();
+
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+
+    std::string osValue;
+    int iFeat = 0;
+    while( iFeat < sHelper.nMaxBatchSize )
+    {
+        int iShapeId;
+        if( panMatchingFIDs != nullptr )
+        {
+            if( panMatchingFIDs[iMatchingFID] == OGRNullFID )
+                break;
+            iShapeId = static_cast<int>(panMatchingFIDs[iMatchingFID]);
+            iMatchingFID++;
+        }
+        else
+        {
+            if( iNextShapeId >= nTotalShapeCount )
+                break;
+            iShapeId = iNextShapeId;
+            iNextShapeId++;
+        }
+
+        if( (hSHP != nullptr && iShapeId >= hSHP->nRecords) ||
+            (hDBF != nullptr && iShapeId >= hDBF->nRecords) )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "Attempt to read shape with feature id (%d) out of "
+                      "available range.", iShapeId );
+            continue;
+        }
+
+        if( hDBF )
+        {
+            if( DBFIsRecordDeleted( hDBF, iShapeId ) )
+                continue;
+            if( panMatchingFIDs == nullptr &&
+                VSIFEofL(VSI_SHP_GetVSIL(hDBF->fp)) )
+                break;  // I/O error.
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Geometry.                                                       */
+/* -------------------------------------------------------------------- */
+        if( m_poFilterGeom != nullptr && iArrowGeomField < 0 )
+        {
+            // No geometry can match the spatial filter.
+            m_nFeaturesRead++;
+            continue;
+        }
+
+        if( iArrowGeomField >= 0 )
+        {
+            SHPObject *psShape = SHPReadObject( hSHP, iShapeId );
+
+            // Same bounding box test as FetchShape(), not trusting
+            // degenerate bounds on non-point geometries.
+            if( m_poFilterGeom != nullptr && psShape != nullptr
+                && psShape->nSHPType != SHPT_NULL
+                && (psShape->nSHPType == SHPT_POINT
+                    || psShape->nSHPType == SHPT_POINTZ
+                    || psShape->nSHPType == SHPT_POINTM
+                    || (psShape->dfXMin != psShape->dfXMax
+                        && psShape->dfYMin != psShape->dfYMax))
+                && (m_sFilterEnvelope.MaxX < psShape->dfXMin
+                    || m_sFilterEnvelope.MaxY < psShape->dfYMin
+                    || psShape->dfXMax  < m_sFilterEnvelope.MinX
+                    || psShape->dfYMax < m_sFilterEnvelope.MinY) )
+            {
+                SHPDestroyObject(psShape);
+                continue;
+            }
+
+            SHPReadOGRObjectAsWKB( hSHP, iShapeId, psShape, eLayerGeomType,
+                                   m_abyArrowWKB );
+
+            m_nFeaturesRead++;
+
+            OGREnvelope sEnvelope;
+            if( m_poFilterGeom != nullptr &&
+                (m_abyArrowWKB.empty() ||
+                 !FilterWKBGeometry(m_abyArrowWKB.data(), m_abyArrowWKB.size(),
+                                    false, sEnvelope)) )
+            {
+                continue;
+            }
+
+            if( m_abyArrowWKB.empty() )
+            {
+                sHelper.SetNull(iArrowGeomField, iFeat);
+            }
+            else
+            {
+                GByte* outPtr = sHelper.GetPtrForStringOrBinary(
+                    iArrowGeomField, iFeat, m_abyArrowWKB.size());
+                if( outPtr == nullptr )
+                {
+                    sHelper.ClearArray();
+                    return ENOMEM;
+                }
+                memcpy(outPtr, m_abyArrowWKB.data(), m_abyArrowWKB.size());
+            }
+        }
+        else
+        {
+            m_nFeaturesRead++;
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Attributes, decoded from the raw record.                        */
+/* -------------------------------------------------------------------- */
+        const char* pszRecord = hDBF != nullptr && sHelper.nFieldCount > 0 ?
+                                DBFReadTuple( hDBF, iShapeId ) : nullptr;
+        for( int iField = 0; pszRecord != nullptr &&
+                             iField < sHelper.nFieldCount; iField++ )
+        {
+            const int iArrowField = sHelper.mapOGRFieldToArrowField[iField];
+            if( iArrowField < 0 )
+                continue;
+            auto psArray = out_array->children[iArrowField];
+
+            GetDBFTrimmedValue(pszRecord, hDBF->panFieldOffset[iField],
+                               hDBF->panFieldSize[iField], osValue);
+
+            const OGRFieldDefn* poFieldDefn =
+                poFeatureDefn->GetFieldDefnUnsafe(iField);
+            const OGRFieldType eType = poFieldDefn->GetType();
+            if( eType == OFTString )
+            {
+                if( osValue.empty() )
+                {
+                    sHelper.SetNull(iArrowField, iFeat);
+                    continue;
+                }
+                if( !osEncoding.empty() )
+                {
+                    char* pszUTF8 = CPLRecode(osValue.c_str(),
+                                              osEncoding.c_str(), CPL_ENC_UTF8);
+                    osValue = pszUTF8;
+                    CPLFree(pszUTF8);
+                }
+                GByte* outPtr = sHelper.GetPtrForStringOrBinary(
+                    iArrowField, iFeat, osValue.size());
+                if( outPtr == nullptr )
+                {
+                    sHelper.ClearArray();
+                    return ENOMEM;
+                }
+                memcpy(outPtr, osValue.data(), osValue.size());
+                continue;
+            }
+
+            // Use the same null rules as SHPReadOGRFeature(), which depend
+            // on the shapelib version.
+            if( DBFIsAttributeNULL(hDBF, iShapeId, iField) ||
+                (eType == OFTDate && osValue.empty()) )
+            {
+                sHelper.SetNull(iArrowField, iFeat);
+                continue;
+            }
+
+            switch( eType )
+            {
+                case OFTInteger:
+                {
+                    const long long nVal64 =
+                        std::strtoll(osValue.c_str(), nullptr, 10);
+                    sHelper.SetInt32(psArray, iFeat,
+                        nVal64 > INT_MAX ? INT_MAX :
+                        nVal64 < INT_MIN ? INT_MIN :
+                                           static_cast<int>(nVal64));
+                    break;
+                }
+
+                case OFTInteger64:
+                    sHelper.SetInt64(psArray, iFeat,
+                        CPLAtoGIntBigEx(osValue.c_str(), FALSE, nullptr));
+                    break;
+
+                case OFTReal:
+                    sHelper.SetDouble(psArray, iFeat,
+                                      CPLStrtod(osValue.c_str(), nullptr));
+                    break;
+
+                case OFTDate:
+                {
+                    // Same parsing as SHPReadOGRFeature()
+                    const char* pszDateValue = osValue.c_str();
+                    OGRField sFld;
+                    memset( &sFld, 0, sizeof(sFld) );
+                    if( osValue.size() >= 10 &&
+                        pszDateValue[2] == '/' && pszDateValue[5] == '/' )
+                    {
+                        sFld.Date.Month = static_cast<GByte>(atoi(pszDateValue + 0));
+                        sFld.Date.Day   = static_cast<GByte>(atoi(pszDateValue + 3));
+                        sFld.Date.Year  = static_cast<GInt16>(atoi(pszDateValue + 6));
+                    }
+                    else
+                    {
+                        const int nFullDate = atoi(pszDateValue);
+                        sFld.Date.Year = static_cast<GInt16>(nFullDate / 10000);
+                        sFld.Date.Month = static_cast<GByte>((nFullDate / 100) % 100);
+                        sFld.Date.Day = static_cast<GByte>(nFullDate % 100);
+                    }
+                    sHelper.SetDate(psArray, iFeat, brokenDown, sFld);
+                    break;
+                }
+
+                default:
+                    CPLAssert( false );
+                    break;
+            }
+        }
+
+        if( sHelper.panFIDValues )
+            sHelper.panFIDValues[iFeat] = iShapeId;
+        iFeat++;
+    }
+
+    if( iFeat == 0 )
+    {
+        sHelper.ClearArray();
+        return 0;
+    }
+    sHelper.Shrink(iFeat);
+    return 0;
+}
+
 /************************************************************************/
 /*                             StartUpdate()                            */
 /************************************************************************/
@@ -1006,7 +1333,7 @@ OGRErr OGRShapeLayer::ISetFeature( OGRFeature *poFeature )
     }
 
     bHeaderDirty = true;
-    if( CheckForQIX() || CheckForSBN() )
+    if( HasSpatialIndex() )
         DropSpatialIndex();
 
     unsigned int nOffset = 0;
@@ -1082,7 +1409,7 @@ OGRErr OGRShapeLayer::DeleteFeature( GIntBig nFID )
         return OGRERR_FAILURE;
 
     bHeaderDirty = true;
-    if( CheckForQIX() || CheckForSBN() )
+    if( HasSpatialIndex() )
         DropSpatialIndex();
     m_eNeedRepack = YES;
 
@@ -1106,7 +1433,7 @@ OGRErr OGRShapeLayer::ICreateFeature( OGRFeature *poFeature )
     }
 
     bHeaderDirty = true;
-    if( CheckForQIX() || CheckForSBN() )
+    if( HasSpatialIndex() )
         DropSpatialIndex();
 
     poFeature->SetFID( OGRNullFID );
@@ -1629,7 +1956,7 @@ int OGRShapeLayer::TestCapability( const char * pszCap )
 
     if( EQUAL(pszCap,OLCFastFeatureCount) )
     {
-        if( !(m_poFilterGeom == nullptr || CheckForQIX() || CheckForSBN()) )
+        if( !(m_poFilterGeom == nullptr || HasSpatialIndex()) )
             return FALSE;
 
         if( m_poAttrQuery != nullptr )
@@ -1644,7 +1971,7 @@ int OGRShapeLayer::TestCapability( const char * pszCap )
         return bUpdateAccess;
 
     if( EQUAL(pszCap,OLCFastSpatialFilter) )
-        return CheckForQIX() || CheckForSBN();
+        return HasSpatialIndex();
 
     if( EQUAL(pszCap,OLCFastGetExtent) )
         return TRUE;
@@ -1671,6 +1998,9 @@ int OGRShapeLayer::TestCapability( const char * pszCap )
     if( EQUAL(pszCap,OLCIgnoreFields) )
         return TRUE;
 
+    if( EQUAL(pszCap,OLCFastGetArrowStream) )
+        return m_poAttrQuery == nullptr && m_poFilterGeom == nullptr;
+
     if( EQUAL(pszCap,OLCStringsAsUTF8) )
     {
         // No encoding defined: we don't know.
@@ -2439,7 +2769,7 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
     if( !StartUpdate("DropSpatialIndex") )
         return OGRERR_FAILURE;
 
-    if( !CheckForQIX() && !CheckForSBN() )
+    if( !HasSpatialIndex() )
     {
         CPLError( CE_Warning, CPLE_AppDefined,
                   "Layer %s has no spatial index, DROP SPATIAL INDEX failed.",
@@ -2447,8 +2777,12 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
         return OGRERR_FAILURE;
     }
 
+    const bool bHadHRT = m_poHRT != nullptr;
     const bool bHadQIX = hQIX != nullptr;
 
+    m_poHRT.reset();
+    m_bCheckedForHRT = false;
+
     SHPCloseDiskTree( hQIX );
     hQIX = nullptr;
     bCheckedForQIX = false;
@@ -2472,6 +2806,21 @@ OGRErr OGRShapeLayer::DropSpatialIndex()
         }
     }
 
+    if( bHadHRT )
+    {
+        const char *pszHRTFilename =
+            CPLResetExtension( pszFullName, "hrt" );
+        CPLDebug( "SHAPE", "Unlinking index file %s", pszHRTFilename );
+
+        if( VSIUnlink( pszHRTFilename ) != 0 )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "Failed to delete file %s.\n%s",
+                      pszHRTFilename, VSIStrerror( errno ) );
+            return OGRERR_FAILURE;
+        }
+    }
+
     if( !bSbnSbxDeleted )
     {
         const char papszExt[2][4] = { "sbn", "sbx" };
@@ -2510,7 +2859,7 @@ OGRErr OGRShapeLayer::CreateSpatialIndex( int nMaxDepth )
 /* -------------------------------------------------------------------- */
 /*      If we have an existing spatial index, blow it away first.       */
 /* -------------------------------------------------------------------- */
-    if( CheckForQIX() )
+    if( CheckForHRT() || CheckForQIX() )
         DropSpatialIndex();
 
     bCheckedForQIX = false;
@@ -2555,6 +2904,40 @@ OGRErr OGRShapeLayer::CreateSpatialIndex( int nMaxDepth )
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                     CreateHilbertSpatialIndex()                      */
+/************************************************************************/
+
+OGRErr OGRShapeLayer::CreateHilbertSpatialIndex()
+
+{
+    if( !StartUpdate("CreateSpatialIndex") )
+        return OGRERR_FAILURE;
+
+/* -------------------------------------------------------------------- */
+/*      If we have an existing spatial index, blow it away first.       */
+/* -------------------------------------------------------------------- */
+    if( CheckForHRT() || CheckForQIX() )
+        DropSpatialIndex();
+
+    m_bCheckedForHRT = false;
+
+/* -------------------------------------------------------------------- */
+/*      Write the packed R-tree to the .hrt file.                       */
+/* -------------------------------------------------------------------- */
+    OGRShapeLayer::SyncToDisk();
+
+    const std::string osHRTFilename = CPLResetExtension( pszFullName, "hrt" );
+    CPLDebug( "SHAPE", "Creating index file %s", osHRTFilename.c_str() );
+
+    if( !OGRShapePackedRTree::Create( hSHP, osHRTFilename.c_str() ) )
+        return OGRERR_FAILURE;
+
+    CPL_IGNORE_RET_VAL(CheckForHRT());
+
+    return OGRERR_NONE;
+}
+
 /************************************************************************/
 /*                       CheckFileDeletion()                            */
 /************************************************************************/
@@ -2756,7 +3139,7 @@ OGRErr OGRShapeLayer::Repack()
 /*      Cleanup any existing spatial index.  It will become             */
 /*      meaningless when the fids change.                               */
 /* -------------------------------------------------------------------- */
-    if( CheckForQIX() || CheckForSBN() )
+    if( HasSpatialIndex() )
         DropSpatialIndex();
 
 /* -------------------------------------------------------------------- */
@@ -3492,6 +3875,9 @@ void OGRShapeLayer::CloseUnderlyingLayer()
     hSBN = nullptr;
     bCheckedForSBN = false;
 
+    m_poHRT.reset();
+    m_bCheckedForHRT = false;
+
     eFileDescriptorsState = FD_CLOSED;
 }
 
@@ -3537,6 +3923,12 @@ void OGRShapeLayer::AddToFileList( CPLStringList& oFileList )
                 cpl::down_cast<OGRShapeGeomFieldDefn*>(GetLayerDefn()->GetGeomFieldDefn(0));
             oFileList.AddString(poGeomFieldDefn->GetPrjFilename());
         }
+        if( CheckForHRT() )
+        {
+            const char* pszHRTFilename =
+                CPLResetExtension( pszFullName, "hrt" );
+            oFileList.AddString(pszHRTFilename);
+        }
         if( CheckForQIX() )
         {
             const char* pszQIXFilename =
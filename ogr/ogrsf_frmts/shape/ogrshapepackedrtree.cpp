@@ -0,0 +1,516 @@
+/******************************************************************************
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  Implements OGRShapePackedRTree class: packed Hilbert R-tree
+ *           stored in a .hrt sidecar file of a shapefile.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2023, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogrshape.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+/* -------------------------------------------------------------------- */
+/*      File layout (all values are little-endian):                     */
+/*                                                                      */
+/*      Header (40 bytes):                                              */
+/*        0: magic "GDALHRT\0"                                          */
+/*        8: uint32 version (1)                                         */
+/*       12: uint16 node size (maximum number of children of a node)    */
+/*       14: uint16 reserved                                            */
+/*       16: uint64 number of indexed shapes                            */
+/*       24: uint32 number of records of the .shp when indexed          */
+/*       28: uint32 reserved                                            */
+/*       32: uint64 size of the .shp when indexed                       */
+/*                                                                      */
+/*      Followed by the nodes, from the root level to the leaf level,   */
+/*      each one made of 4 doubles (minx, miny, maxx, maxy) and a       */
+/*      uint64 which is the shape id for leaves, or the index of the    */
+/*      first child node otherwise. Shapes are sorted along the Hilbert */
+/*      curve of their bounding box center, so that nodes of a same     */
+/*      area are stored next to each other.                            */
+/* -------------------------------------------------------------------- */
+
+constexpr const char HRT_MAGIC[] = "GDALHRT";
+constexpr int HRT_VERSION = 1;
+constexpr int HRT_HEADER_SIZE = 40;
+constexpr int HRT_NODE_ITEM_SIZE = 4 * 8 + 8;
+
+/************************************************************************/
+/*                              Hilbert()                               */
+/************************************************************************/
+
+// Based on public domain code at https://github.com/rawrunprotected/hilbert_curves
+static uint32_t Hilbert(uint32_t x, uint32_t y)
+{
+    uint32_t a = x ^ y;
+    uint32_t b = 0xFFFF ^ a;
+    uint32_t c = 0xFFFF ^ (x | y);
+    uint32_t d = x & (y ^ 0xFFFF);
+
+    uint32_t A = a | (b >> 1);
+    uint32_t B = (a >> 1) ^ a;
+    uint32_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+    uint32_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+    a = A; b = B; c = C; d = D;
+    A = ((a & (a >> 2)) ^ (b & (b >> 2)));
+    B = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+    C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+    D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+    a = A; b = B; c = C; d = D;
+    A = ((a & (a >> 4)) ^ (b & (b >> 4)));
+    B = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+    C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+    D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+    a = A; b = B; c = C; d = D;
+    C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+    D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+    a = C ^ (C >> 1);
+    b = D ^ (D >> 1);
+
+    uint32_t i0 = x ^ y;
+    uint32_t i1 = b | (0xFFFF ^ (i0 | a));
+
+    i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+    i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+    i0 = (i0 | (i0 << 2)) & 0x33333333;
+    i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+    i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+    i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+    i1 = (i1 | (i1 << 2)) & 0x33333333;
+    i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+    return (i1 << 1) | i0;
+}
+
+/************************************************************************/
+/*                           GetLevelBounds()                           */
+/************************************************************************/
+
+// Returns the [begin, end[ node indices of each level, starting with the
+// leaf level, which is stored at the end of the file.
+static std::vector<std::pair<uint64_t, uint64_t>>
+GetLevelBounds(uint64_t nNumItems, int nNodeSize)
+{
+    std::vector<uint64_t> anLevelCounts;
+    uint64_t n = nNumItems;
+    do
+    {
+        anLevelCounts.push_back(n);
+        n = (n + nNodeSize - 1) / nNodeSize;
+    } while( anLevelCounts.back() > 1 );
+
+    uint64_t nTotal = 0;
+    for( const auto nCount: anLevelCounts )
+        nTotal += nCount;
+
+    std::vector<std::pair<uint64_t, uint64_t>> aoLevelBounds;
+    uint64_t nEnd = nTotal;
+    for( const auto nCount: anLevelCounts )
+    {
+        aoLevelBounds.emplace_back(nEnd - nCount, nEnd);
+        nEnd -= nCount;
+    }
+    return aoLevelBounds;
+}
+
+/************************************************************************/
+/*                        ~OGRShapePackedRTree()                        */
+/************************************************************************/
+
+OGRShapePackedRTree::~OGRShapePackedRTree()
+{
+    if( m_fp )
+        VSIFCloseL(m_fp);
+}
+
+/************************************************************************/
+/*                                Open()                                */
+/************************************************************************/
+
+std::unique_ptr<OGRShapePackedRTree>
+OGRShapePackedRTree::Open(const char* pszFilename, SHPHandle hSHP)
+{
+    VSILFILE* fp = VSIFOpenL(pszFilename, "rb");
+    if( fp == nullptr )
+        return nullptr;
+
+    std::unique_ptr<OGRShapePackedRTree> poTree(new OGRShapePackedRTree());
+    poTree->m_fp = fp;
+
+    GByte abyHeader[HRT_HEADER_SIZE];
+    if( VSIFReadL(abyHeader, 1, sizeof(abyHeader), fp) != sizeof(abyHeader) ||
+        memcmp(abyHeader, HRT_MAGIC, sizeof(HRT_MAGIC)) != 0 )
+    {
+        CPLDebug("SHAPE", "%s is not a valid spatial index", pszFilename);
+        return nullptr;
+    }
+
+    uint32_t nVersion;
+    memcpy(&nVersion, abyHeader + 8, sizeof(nVersion));
+    CPL_LSBPTR32(&nVersion);
+    uint16_t nNodeSize;
+    memcpy(&nNodeSize, abyHeader + 12, sizeof(nNodeSize));
+    CPL_LSBPTR16(&nNodeSize);
+    uint64_t nNumItems;
+    memcpy(&nNumItems, abyHeader + 16, sizeof(nNumItems));
+    CPL_LSBPTR64(&nNumItems);
+    uint32_t nRecords;
+    memcpy(&nRecords, abyHeader + 24, sizeof(nRecords));
+    CPL_LSBPTR32(&nRecords);
+    uint64_t nSHPSize;
+    memcpy(&nSHPSize, abyHeader + 32, sizeof(nSHPSize));
+    CPL_LSBPTR64(&nSHPSize);
+
+    if( nVersion != HRT_VERSION || nNodeSize < 2 ||
+        nNumItems > static_cast<uint64_t>(std::numeric_limits<int>::max()) )
+    {
+        CPLDebug("SHAPE", "%s: unsupported spatial index", pszFilename);
+        return nullptr;
+    }
+
+    // The index is meaningless if the .shp has been modified by software
+    // that does not know about it.
+    if( nRecords != static_cast<uint32_t>(hSHP->nRecords) ||
+        nSHPSize != hSHP->nFileSize )
+    {
+        CPLDebug("SHAPE", "%s is out of date with the .shp file. Ignoring it",
+                 pszFilename);
+        return nullptr;
+    }
+
+    // Each shape is indexed at most once.
+    if( nNumItems > nRecords )
+    {
+        CPLDebug("SHAPE", "%s: invalid number of items", pszFilename);
+        return nullptr;
+    }
+
+    poTree->m_nNodeSize = nNodeSize;
+    poTree->m_nNumItems = nNumItems;
+    poTree->m_nRecords = hSHP->nRecords;
+    if( nNumItems > 0 )
+        poTree->m_aoLevelBounds = GetLevelBounds(nNumItems, nNodeSize);
+
+    // Check that the file holds exactly the nodes the header implies, so
+    // that Search() never reads, or allocates for, nodes that do not exist.
+    const uint64_t nTotalNodes =
+        nNumItems > 0 ? poTree->m_aoLevelBounds.front().second : 0;
+    if( VSIFSeekL(fp, 0, SEEK_END) != 0 ||
+        VSIFTellL(fp) != HRT_HEADER_SIZE + nTotalNodes * HRT_NODE_ITEM_SIZE )
+    {
+        CPLDebug("SHAPE", "%s: file size inconsistent with its header",
+                 pszFilename);
+        return nullptr;
+    }
+    return poTree;
+}
+
+/************************************************************************/
+/*                               Search()                               */
+/************************************************************************/
+
+// Returns the sorted ids of the shapes whose bounding box intersects oEnv,
+// in an array to be freed with free(), or nullptr in case of error.
+// Nodes are read level by level, with one read per run of consecutive
+// nodes, which minimizes the number of requests on network file systems.
+int* OGRShapePackedRTree::Search(const OGREnvelope& oEnv, int* pnCount) const
+{
+    *pnCount = 0;
+    std::vector<int> anIds;
+
+    if( m_nNumItems > 0 )
+    {
+        // Ranges of node indices to read in the current level
+        std::vector<std::pair<uint64_t, uint64_t>> aoRanges{
+            m_aoLevelBounds.back() };
+        std::vector<GByte> abyBuffer;
+
+        for( size_t iLevel = m_aoLevelBounds.size(); iLevel > 0; )
+        {
+            --iLevel;
+            const bool bIsLeaf = iLevel == 0;
+            std::vector<std::pair<uint64_t, uint64_t>> aoNextRanges;
+            for( const auto& oRange: aoRanges )
+            {
+                const size_t nCount =
+                    static_cast<size_t>(oRange.second - oRange.first);
+                try
+                {
+                    abyBuffer.resize(nCount * HRT_NODE_ITEM_SIZE);
+                }
+                catch( const std::exception& )
+                {
+                    CPLError(CE_Failure, CPLE_OutOfMemory,
+                             "Out of memory in spatial index search");
+                    return nullptr;
+                }
+                if( VSIFSeekL(m_fp, HRT_HEADER_SIZE +
+                                    oRange.first * HRT_NODE_ITEM_SIZE,
+                              SEEK_SET) != 0 ||
+                    VSIFReadL(abyBuffer.data(), HRT_NODE_ITEM_SIZE, nCount, m_fp) != nCount )
+                {
+                    CPLError(CE_Failure, CPLE_FileIO,
+                             "Cannot read nodes of spatial index");
+                    return nullptr;
+                }
+
+                for( size_t i = 0; i < nCount; ++i )
+                {
+                    const GByte* pabyNode = abyBuffer.data() + i * HRT_NODE_ITEM_SIZE;
+                    double adfBBox[4];
+                    memcpy(adfBBox, pabyNode, sizeof(adfBBox));
+                    for( double& dfVal: adfBBox )
+                        CPL_LSBPTR64(&dfVal);
+                    if( adfBBox[0] > oEnv.MaxX || adfBBox[1] > oEnv.MaxY ||
+                        adfBBox[2] < oEnv.MinX || adfBBox[3] < oEnv.MinY )
+                    {
+                        continue;
+                    }
+                    uint64_t nOffset;
+                    memcpy(&nOffset, pabyNode + 32, sizeof(nOffset));
+                    CPL_LSBPTR64(&nOffset);
+                    if( bIsLeaf )
+                    {
+                        if( nOffset >= static_cast<uint64_t>(m_nRecords) )
+                        {
+                            CPLError(CE_Failure, CPLE_AppDefined,
+                                     "Corrupted spatial index");
+                            return nullptr;
+                        }
+                        anIds.push_back(static_cast<int>(nOffset));
+                    }
+                    else
+                    {
+                        const auto& oChildLevel = m_aoLevelBounds[iLevel - 1];
+                        const uint64_t nChildEnd = std::min(
+                            nOffset + m_nNodeSize, oChildLevel.second);
+                        if( nOffset < oChildLevel.first || nOffset >= nChildEnd )
+                        {
+                            CPLError(CE_Failure, CPLE_AppDefined,
+                                     "Corrupted spatial index");
+                            return nullptr;
+                        }
+                        if( !aoNextRanges.empty() &&
+                            aoNextRanges.back().second == nOffset )
+                        {
+                            aoNextRanges.back().second = nChildEnd;
+                        }
+                        else
+                        {
+                            aoNextRanges.emplace_back(nOffset, nChildEnd);
+                        }
+                    }
+                }
+            }
+            aoRanges = std::move(aoNextRanges);
+            if( aoRanges.empty() )
+                break;
+        }
+    }
+
+    std::sort(anIds.begin(), anIds.end());
+
+    int* panIds = static_cast<int*>(malloc(sizeof(int) * std::max<size_t>(1, anIds.size())));
+    if( panIds == nullptr )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory in spatial index search");
+        return nullptr;
+    }
+    if( !anIds.empty() )
+        memcpy(panIds, anIds.data(), sizeof(int) * anIds.size());
+    *pnCount = static_cast<int>(anIds.size());
+    return panIds;
+}
+
+/************************************************************************/
+/*                               Create()                               */
+/************************************************************************/
+
+bool OGRShapePackedRTree::Create(SHPHandle hSHP, const char* pszFilename,
+                                 int nNodeSize)
+{
+    struct NodeItem
+    {
+        double adfBBox[4];
+        uint64_t nOffset;
+    };
+
+    std::vector<NodeItem> aoItems;
+    OGREnvelope oExtent;
+    for( int iShape = 0; iShape < hSHP->nRecords; ++iShape )
+    {
+        SHPObject* psShape = SHPReadObject(hSHP, iShape);
+        if( psShape == nullptr )
+            continue;
+        if( psShape->nSHPType != SHPT_NULL && psShape->nVertices > 0 )
+        {
+            NodeItem sItem;
+            sItem.adfBBox[0] = psShape->dfXMin;
+            sItem.adfBBox[1] = psShape->dfYMin;
+            sItem.adfBBox[2] = psShape->dfXMax;
+            sItem.adfBBox[3] = psShape->dfYMax;
+            sItem.nOffset = static_cast<uint64_t>(iShape);
+            oExtent.Merge(psShape->dfXMin, psShape->dfYMin);
+            oExtent.Merge(psShape->dfXMax, psShape->dfYMax);
+            aoItems.push_back(sItem);
+        }
+        SHPDestroyObject(psShape);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Sort shapes along the Hilbert curve of their bbox center.       */
+/* -------------------------------------------------------------------- */
+    if( !aoItems.empty() )
+    {
+        constexpr uint32_t HILBERT_MAX = (1 << 16) - 1;
+        const double dfWidth = oExtent.MaxX - oExtent.MinX;
+        const double dfHeight = oExtent.MaxY - oExtent.MinY;
+        std::vector<std::pair<uint32_t, size_t>> anHilbert;
+        anHilbert.reserve(aoItems.size());
+        for( size_t i = 0; i < aoItems.size(); ++i )
+        {
+            const auto& sItem = aoItems[i];
+            uint32_t x = 0;
+            uint32_t y = 0;
+            if( dfWidth > 0 )
+                x = static_cast<uint32_t>(std::floor(HILBERT_MAX *
+                    ((sItem.adfBBox[0] + sItem.adfBBox[2]) / 2 - oExtent.MinX) / dfWidth));
+            if( dfHeight > 0 )
+                y = static_cast<uint32_t>(std::floor(HILBERT_MAX *
+                    ((sItem.adfBBox[1] + sItem.adfBBox[3]) / 2 - oExtent.MinY) / dfHeight));
+            anHilbert.emplace_back(Hilbert(x, y), i);
+        }
+        std::sort(anHilbert.begin(), anHilbert.end());
+        std::vector<NodeItem> aoSortedItems;
+        aoSortedItems.reserve(aoItems.size());
+        for( const auto& oPair: anHilbert )
+            aoSortedItems.push_back(aoItems[oPair.second]);
+        aoItems = std::move(aoSortedItems);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Build the nodes bottom-up.                                      */
+/* -------------------------------------------------------------------- */
+    const uint64_t nNumItems = aoItems.size();
+    std::vector<NodeItem> aoNodes;
+    if( nNumItems > 0 )
+    {
+        const auto aoLevelBounds = GetLevelBounds(nNumItems, nNodeSize);
+        aoNodes.resize(static_cast<size_t>(aoLevelBounds.front().second));
+        std::copy(aoItems.begin(), aoItems.end(),
+                  aoNodes.begin() + static_cast<size_t>(aoLevelBounds.front().first));
+        for( size_t iLevel = 1; iLevel < aoLevelBounds.size(); ++iLevel )
+        {
+            const auto& oChildLevel = aoLevelBounds[iLevel - 1];
+            uint64_t nNode = aoLevelBounds[iLevel].first;
+            for( uint64_t nChild = oChildLevel.first; nChild < oChildLevel.second;
+                 nChild += nNodeSize, ++nNode )
+            {
+                NodeItem& sNode = aoNodes[static_cast<size_t>(nNode)];
+                sNode = aoNodes[static_cast<size_t>(nChild)];
+                sNode.nOffset = nChild;
+                const uint64_t nChildEnd = std::min(nChild + nNodeSize,
+                                                    oChildLevel.second);
+                for( uint64_t j = nChild + 1; j < nChildEnd; ++j )
+                {
+                    const auto& sChild = aoNodes[static_cast<size_t>(j)];
+                    sNode.adfBBox[0] = std::min(sNode.adfBBox[0], sChild.adfBBox[0]);
+                    sNode.adfBBox[1] = std::min(sNode.adfBBox[1], sChild.adfBBox[1]);
+                    sNode.adfBBox[2] = std::max(sNode.adfBBox[2], sChild.adfBBox[2]);
+                    sNode.adfBBox[3] = std::max(sNode.adfBBox[3], sChild.adfBBox[3]);
+                }
+            }
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Write the file.                                                 */
+/* -------------------------------------------------------------------- */
+    VSILFILE* fp = VSIFOpenL(pszFilename, "wb");
+    if( fp == nullptr )
+    {
+        CPLError(CE_Failure, CPLE_OpenFailed, "Cannot create %s", pszFilename);
+        return false;
+    }
+
+    GByte abyHeader[HRT_HEADER_SIZE] = {};
+    memcpy(abyHeader, HRT_MAGIC, sizeof(HRT_MAGIC));
+    uint32_t nVersion = HRT_VERSION;
+    CPL_LSBPTR32(&nVersion);
+    memcpy(abyHeader + 8, &nVersion, sizeof(nVersion));
+    uint16_t nNodeSizeLSB = static_cast<uint16_t>(nNodeSize);
+    CPL_LSBPTR16(&nNodeSizeLSB);
+    memcpy(abyHeader + 12, &nNodeSizeLSB, sizeof(nNodeSizeLSB));
+    uint64_t nNumItemsLSB = nNumItems;
+    CPL_LSBPTR64(&nNumItemsLSB);
+    memcpy(abyHeader + 16, &nNumItemsLSB, sizeof(nNumItemsLSB));
+    uint32_t nRecords = static_cast<uint32_t>(hSHP->nRecords);
+    CPL_LSBPTR32(&nRecords);
+    memcpy(abyHeader + 24, &nRecords, sizeof(nRecords));
+    uint64_t nSHPSize = hSHP->nFileSize;
+    CPL_LSBPTR64(&nSHPSize);
+    memcpy(abyHeader + 32, &nSHPSize, sizeof(nSHPSize));
+
+    bool bOK = VSIFWriteL(abyHeader, sizeof(abyHeader), 1, fp) == 1;
+
+    std::vector<GByte> abyBuffer;
+    constexpr size_t BUFFER_NODES = 4096;
+    abyBuffer.reserve(BUFFER_NODES * HRT_NODE_ITEM_SIZE);
+    for( size_t i = 0; bOK && i < aoNodes.size(); ++i )
+    {
+        GByte abyNode[HRT_NODE_ITEM_SIZE];
+        NodeItem sNode = aoNodes[i];
+        for( double& dfVal: sNode.adfBBox )
+            CPL_LSBPTR64(&dfVal);
+        CPL_LSBPTR64(&sNode.nOffset);
+        memcpy(abyNode, sNode.adfBBox, sizeof(sNode.adfBBox));
+        memcpy(abyNode + 32, &sNode.nOffset, sizeof(sNode.nOffset));
+        abyBuffer.insert(abyBuffer.end(), abyNode, abyNode + HRT_NODE_ITEM_SIZE);
+        if( abyBuffer.size() == BUFFER_NODES * HRT_NODE_ITEM_SIZE ||
+            i + 1 == aoNodes.size() )
+        {
+            bOK = VSIFWriteL(abyBuffer.data(), abyBuffer.size(), 1, fp) == 1;
+            abyBuffer.clear();
+        }
+    }
+
+    if( VSIFCloseL(fp) != 0 )
+        bOK = false;
+    if( !bOK )
+    {
+        CPLError(CE_Failure, CPLE_FileIO, "Cannot write %s", pszFilename);
+        VSIUnlink(pszFilename);
+    }
+    return bOK;
+}
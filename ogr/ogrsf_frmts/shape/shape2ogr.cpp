@@ -390,6 +390,236 @@ OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
     return poOGR;
 }
 
+/************************************************************************/
+/*                      SHPSetGeometryDimensions()                      */
+/*                                                                      */
+/*      Set/unset the Z and M flags of a geometry read from a shape     */
+/*      so that they match the geometry type of the layer.              */
+/************************************************************************/
+
+static void SHPSetGeometryDimensions( OGRGeometry* poGeometry,
+                                      OGRwkbGeometryType eLayerGeomType )
+{
+    if( eLayerGeomType == wkbUnknown )
+        return;
+
+    const OGRwkbGeometryType eGeomInType = poGeometry->getGeometryType();
+    if( wkbHasZ(eLayerGeomType) && !wkbHasZ(eGeomInType) )
+    {
+        poGeometry->set3D(TRUE);
+    }
+    else if( !wkbHasZ(eLayerGeomType) && wkbHasZ(eGeomInType) )
+    {
+        poGeometry->set3D(FALSE);
+    }
+    if( wkbHasM(eLayerGeomType) && !wkbHasM(eGeomInType) )
+    {
+        poGeometry->setMeasured(TRUE);
+    }
+    else if( !wkbHasM(eLayerGeomType) && wkbHasM(eGeomInType) )
+    {
+        poGeometry->setMeasured(FALSE);
+    }
+}
+
+/************************************************************************/
+/*                        SHPReadOGRObjectAsWKB()                       */
+/*                                                                      */
+/*      Read an item in a shapefile, and translate it to ISO WKB        */
+/*      (little endian), with the same dimensions as the geometry       */
+/*      SHPReadOGRFeature() would return for a layer of type            */
+/*      eLayerGeomType. Points, multipoints and arcs are encoded        */
+/*      directly from the shape, without building an OGRGeometry.       */
+/*      abyWKB is left empty for a null geometry.                       */
+/*      psShape, if provided, is owned by this function.                */
+/************************************************************************/
+
+void SHPReadOGRObjectAsWKB( SHPHandle hSHP, int iShape, SHPObject *psShape,
+                            OGRwkbGeometryType eLayerGeomType,
+                            std::vector<GByte>& abyWKB )
+{
+    abyWKB.clear();
+
+    if( psShape == nullptr )
+        psShape = SHPReadObject( hSHP, iShape );
+
+    if( psShape == nullptr )
+        return;
+
+    const int nSHPType = psShape->nSHPType;
+    const bool bIsPoint = nSHPType == SHPT_POINT ||
+                          nSHPType == SHPT_POINTZ ||
+                          nSHPType == SHPT_POINTM;
+    const bool bIsMultiPoint = nSHPType == SHPT_MULTIPOINT ||
+                               nSHPType == SHPT_MULTIPOINTZ ||
+                               nSHPType == SHPT_MULTIPOINTM;
+    const bool bIsArc = nSHPType == SHPT_ARC ||
+                        nSHPType == SHPT_ARCZ ||
+                        nSHPType == SHPT_ARCM;
+
+    // Start and number of points of each part of arcs.
+    std::vector<std::pair<int, int>> anPartStartCount;
+    bool bCanEncodeDirectly = eLayerGeomType != wkbUnknown &&
+                              (bIsPoint || bIsMultiPoint || bIsArc) &&
+                              !(bIsPoint && psShape->nVertices < 1);
+    if( bCanEncodeDirectly && bIsArc )
+    {
+        for( int iPart = 0; iPart < psShape->nParts; iPart++ )
+        {
+            int nPartStart = 0;
+            int nPartPoints = psShape->nVertices;
+            // Like SHPReadOGRObject(), ignore the part start of single
+            // part arcs.
+            if( psShape->panPartStart != nullptr && psShape->nParts > 1 )
+            {
+                nPartStart = psShape->panPartStart[iPart];
+                if( iPart == psShape->nParts - 1 )
+                    nPartPoints = psShape->nVertices - nPartStart;
+                else
+                    nPartPoints = psShape->panPartStart[iPart+1] - nPartStart;
+            }
+            if( nPartStart < 0 || nPartPoints < 0 ||
+                nPartPoints > psShape->nVertices - nPartStart )
+            {
+                bCanEncodeDirectly = false;
+                break;
+            }
+            anPartStartCount.emplace_back(nPartStart, nPartPoints);
+        }
+    }
+
+    if( !bCanEncodeDirectly )
+    {
+        // Polygons need to be organized, and multipatches to be converted,
+        // so go through the OGRGeometry representation.
+        OGRGeometry* poGeometry = SHPReadOGRObject( hSHP, iShape, psShape );
+        if( poGeometry )
+        {
+            SHPSetGeometryDimensions(poGeometry, eLayerGeomType);
+            abyWKB.resize(poGeometry->WkbSize());
+            poGeometry->exportToWkb(wkbNDR, abyWKB.data(), wkbVariantIso);
+            delete poGeometry;
+        }
+        return;
+    }
+
+    if( (bIsMultiPoint && psShape->nVertices == 0) ||
+        (bIsArc && psShape->nParts == 0) )
+    {
+        SHPDestroyObject( psShape );
+        return;
+    }
+
+    // Z and M values as SHPReadOGRObject() would set them, and then
+    // SHPSetGeometryDimensions() would add or remove them.
+    const bool bHasZ = CPL_TO_BOOL(wkbHasZ(eLayerGeomType));
+    const bool bHasM = CPL_TO_BOOL(wkbHasM(eLayerGeomType));
+    const double* padfZ =
+        (nSHPType == SHPT_POINTZ || nSHPType == SHPT_MULTIPOINTZ ||
+         nSHPType == SHPT_ARCZ) ? psShape->padfZ : nullptr;
+    const double* padfM =
+        (nSHPType != SHPT_POINT && nSHPType != SHPT_MULTIPOINT &&
+         nSHPType != SHPT_ARC &&
+         !(nSHPType == SHPT_POINTZ && !psShape->bMeasureIsUsed)) ?
+            psShape->padfM : nullptr;
+    const size_t nPointSize = sizeof(double) * (2 + bHasZ + bHasM);
+    const uint32_t nTypeModifier = (bHasZ ? 1000 : 0) + (bHasM ? 2000 : 0);
+
+    const int nParts = bIsArc ? psShape->nParts : 1;
+    size_t nWKBSize = 1 + 4;
+    if( bIsPoint )
+    {
+        nWKBSize += nPointSize;
+    }
+    else if( bIsMultiPoint )
+    {
+        nWKBSize += 4 + static_cast<size_t>(psShape->nVertices) * (1 + 4 + nPointSize);
+    }
+    else
+    {
+        nWKBSize += 4;
+        for( const auto& oPart: anPartStartCount )
+        {
+            if( nParts > 1 )
+                nWKBSize += 1 + 4 + 4;
+            nWKBSize += static_cast<size_t>(oPart.second) * nPointSize;
+        }
+    }
+    abyWKB.resize(nWKBSize);
+
+    GByte* pabyIter = abyWKB.data();
+    const auto WriteHeader = [&pabyIter, nTypeModifier](uint32_t nType)
+    {
+        *pabyIter = wkbNDR;
+        ++pabyIter;
+        nType += nTypeModifier;
+        CPL_LSBPTR32(&nType);
+        memcpy(pabyIter, &nType, sizeof(nType));
+        pabyIter += sizeof(nType);
+    };
+    const auto WriteCount = [&pabyIter](int nCount)
+    {
+        uint32_t nCount32 = static_cast<uint32_t>(nCount);
+        CPL_LSBPTR32(&nCount32);
+        memcpy(pabyIter, &nCount32, sizeof(nCount32));
+        pabyIter += sizeof(nCount32);
+    };
+    const auto WriteDouble = [&pabyIter](double dfVal)
+    {
+        CPL_LSBPTR64(&dfVal);
+        memcpy(pabyIter, &dfVal, sizeof(dfVal));
+        pabyIter += sizeof(dfVal);
+    };
+    const auto WritePoints = [&](int nStart, int nCount)
+    {
+        for( int i = nStart; i < nStart + nCount; ++i )
+        {
+            WriteDouble(psShape->padfX[i]);
+            WriteDouble(psShape->padfY[i]);
+            if( bHasZ )
+                WriteDouble(padfZ ? padfZ[i] : 0.0);
+            if( bHasM )
+                WriteDouble(padfM ? padfM[i] : 0.0);
+        }
+    };
+
+    if( bIsPoint )
+    {
+        WriteHeader(wkbPoint);
+        WritePoints(0, 1);
+    }
+    else if( bIsMultiPoint )
+    {
+        WriteHeader(wkbMultiPoint);
+        WriteCount(psShape->nVertices);
+        for( int i = 0; i < psShape->nVertices; ++i )
+        {
+            WriteHeader(wkbPoint);
+            WritePoints(i, 1);
+        }
+    }
+    else if( nParts == 1 )
+    {
+        WriteHeader(wkbLineString);
+        WriteCount(anPartStartCount[0].second);
+        WritePoints(anPartStartCount[0].first, anPartStartCount[0].second);
+    }
+    else
+    {
+        WriteHeader(wkbMultiLineString);
+        WriteCount(nParts);
+        for( const auto& oPart: anPartStartCount )
+        {
+            WriteHeader(wkbLineString);
+            WriteCount(oPart.second);
+            WritePoints(oPart.first, oPart.second);
+        }
+    }
+    CPLAssert( pabyIter == abyWKB.data() + abyWKB.size() );
+
+    SHPDestroyObject( psShape );
+}
+
 /************************************************************************/
 /*                      CheckNonFiniteCoordinates()                     */
 /************************************************************************/
@@ -1307,31 +1537,9 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
 
             if( poGeometry )
             {
-                // Set/unset flags.
-                const OGRwkbGeometryType eMyGeomType =
-                    poFeature->GetDefnRef()->GetGeomFieldDefn(0)->GetType();
-
-                if( eMyGeomType != wkbUnknown )
-                {
-                    OGRwkbGeometryType eGeomInType =
-                        poGeometry->getGeometryType();
-                    if( wkbHasZ(eMyGeomType) && !wkbHasZ(eGeomInType) )
-                    {
-                        poGeometry->set3D(TRUE);
-                    }
-                    else if( !wkbHasZ(eMyGeomType) && wkbHasZ(eGeomInType) )
-                    {
-                        poGeometry->set3D(FALSE);
-                    }
-                    if( wkbHasM(eMyGeomType) && !wkbHasM(eGeomInType) )
-                    {
-                        poGeometry->setMeasured(TRUE);
-                    }
-                    else if( !wkbHasM(eMyGeomType) && wkbHasM(eGeomInType) )
-                    {
-                        poGeometry->setMeasured(FALSE);
-                    }
-                }
+                SHPSetGeometryDimensions(
+                    poGeometry,
+                    poFeature->GetDefnRef()->GetGeomFieldDefn(0)->GetType());
             }
 
             poFeature->SetGeometryDirectly( poGeometry );
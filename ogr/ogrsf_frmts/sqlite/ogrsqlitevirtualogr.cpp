@@ -29,6 +29,7 @@
 #include "cpl_port.h"
 #include "ogrsqlitevirtualogr.h"
 
+#include <algorithm>
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
@@ -353,6 +354,15 @@ typedef struct
 
     GByte         *pabyGeomBLOB;
     int            nGeomBLOBLen;
+
+    /* Attribute filter last applied by OGR2SQLITE_Filter(), so that */
+    /* it is not recompiled when xFilter is called repeatedly with the */
+    /* same constraint values (typically in joins). NULL if not set yet. */
+    char          *pszAttributeFilter;
+
+    /* Index of the geometry field on which OGR2SQLITE_Filter() has set */
+    /* a spatial filter, or -1 */
+    int            iSpatialFilterGeomField;
 } OGR2SQLITE_vtab_cursor;
 
 /************************************************************************/
@@ -737,6 +747,21 @@ int OGR2SQLITE_ConnectCreate(sqlite3* hDB, void *pAux,
     return SQLITE_OK;
 }
 
+/* Pseudo constraint operator stored in the idxStr built by */
+/* OGR2SQLITE_BestIndex() for IN constraints processed all-at-once */
+constexpr int OGR2SQLITE_INDEX_CONSTRAINT_IN = 1000;
+
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+/* SQLite >= 3.25 */
+/* Constraint operator returned by OGR2SQLITE_FindFunction() for */
+/* ST_Intersects(geometry_column, expr) */
+constexpr int OGR2SQLITE_INDEX_CONSTRAINT_ST_INTERSECTS =
+                                            SQLITE_INDEX_CONSTRAINT_FUNCTION;
+#endif
+
+/* Nominal number of rows of a virtual table, used for cost estimation */
+constexpr double OGR2SQLITE_NOMINAL_ROW_COUNT = 1e6;
+
 /************************************************************************/
 /*                       OGR2SQLITE_IsHandledOp()                       */
 /************************************************************************/
@@ -838,27 +863,86 @@ int OGR2SQLITE_BestIndex(sqlite3_vtab *pVTab, sqlite3_index_info* pIndex)
              osQueryPatternUsable.c_str(), osQueryPatternNotUsable.c_str());
 #endif
 
-    int nConstraints = 0;
+    const int nFieldCount = poFDefn->GetFieldCount();
+#if SQLITE_VERSION_NUMBER >= 3038000L
+    /* SQLite >= 3.38: IN (...) constraints can be passed all-at-once */
+    const bool bCanProcessINAllAtOnce = sqlite3_libversion_number() >= 3038000;
+#endif
+
+    /* Pairs of (column, operator) of the constraints passed to xFilter */
+    std::vector<int> anColOps;
+    double dfSelectivity = 1.0;
+    bool bFIDEquality = false;
     for( int i = 0; i < pIndex->nConstraint; i++ )
     {
-        int iCol = pIndex->aConstraint[i].iColumn;
-        if (pIndex->aConstraint[i].usable &&
-            OGR2SQLITE_IsHandledOp(pIndex->aConstraint[i].op) &&
-            iCol < poFDefn->GetFieldCount() &&
+        pIndex->aConstraintUsage[i].argvIndex = 0;
+        pIndex->aConstraintUsage[i].omit = false;
+        if( !pIndex->aConstraint[i].usable )
+            continue;
+
+        const int iCol = pIndex->aConstraint[i].iColumn;
+        int nOp = pIndex->aConstraint[i].op;
+        if (OGR2SQLITE_IsHandledOp(nOp) &&
+            iCol < nFieldCount &&
             (iCol < 0 || poFDefn->GetFieldDefn(iCol)->GetType() != OFTBinary))
         {
-            pIndex->aConstraintUsage[i].argvIndex = nConstraints + 1;
-            pIndex->aConstraintUsage[i].omit = true;
+            if( nOp == SQLITE_INDEX_CONSTRAINT_EQ )
+            {
+#if SQLITE_VERSION_NUMBER >= 3038000L
+                if( bCanProcessINAllAtOnce &&
+                    sqlite3_vtab_in(pIndex, i, -1) )
+                {
+                    /* Ask to get the whole list of values of the IN */
+                    /* constraint in a single xFilter call, so that we */
+                    /* can translate it as a single OGR SQL IN (...) */
+                    sqlite3_vtab_in(pIndex, i, 1);
+                    nOp = OGR2SQLITE_INDEX_CONSTRAINT_IN;
+                }
+                else
+#endif
+                if( iCol < 0 )
+                {
+                    bFIDEquality = true;
+                }
+                dfSelectivity *= 0.1;
+            }
+            else if( nOp == SQLITE_INDEX_CONSTRAINT_GT ||
+                     nOp == SQLITE_INDEX_CONSTRAINT_GE ||
+                     nOp == SQLITE_INDEX_CONSTRAINT_LT ||
+                     nOp == SQLITE_INDEX_CONSTRAINT_LE )
+            {
+                dfSelectivity *= 0.5;
+            }
+            else
+            {
+                dfSelectivity *= 0.9;
+            }
 
-            nConstraints ++;
+            pIndex->aConstraintUsage[i].omit = true;
+        }
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+        else if( nOp == OGR2SQLITE_INDEX_CONSTRAINT_ST_INTERSECTS &&
+                 iCol > nFieldCount &&
+                 iCol - (nFieldCount + 1) < poFDefn->GetGeomFieldCount() )
+        {
+            /* The constraint is translated as a spatial filter on the */
+            /* envelope of the right operand, which is less selective than */
+            /* ST_Intersects(), so SQLite must still evaluate it. */
+            dfSelectivity *= 0.1;
         }
+#endif
         else
         {
-            pIndex->aConstraintUsage[i].argvIndex = 0;
-            pIndex->aConstraintUsage[i].omit = false;
+            continue;
         }
+
+        anColOps.push_back(iCol);
+        anColOps.push_back(nOp);
+        pIndex->aConstraintUsage[i].argvIndex =
+                                    static_cast<int>(anColOps.size()) / 2;
     }
 
+    const int nConstraints = static_cast<int>(anColOps.size()) / 2;
     int* panConstraints = nullptr;
 
     if( nConstraints )
@@ -866,26 +950,24 @@ int OGR2SQLITE_BestIndex(sqlite3_vtab *pVTab, sqlite3_index_info* pIndex)
         panConstraints = (int*)
                     sqlite3_malloc( (int)sizeof(int) * (1 + 2 * nConstraints) );
         panConstraints[0] = nConstraints;
-
-        nConstraints = 0;
-
-        for( int i = 0; i < pIndex->nConstraint; i++ )
-        {
-            if (pIndex->aConstraintUsage[i].omit)
-            {
-                panConstraints[2 * nConstraints + 1] =
-                                            pIndex->aConstraint[i].iColumn;
-                panConstraints[2 * nConstraints + 2] =
-                                            pIndex->aConstraint[i].op;
-
-                nConstraints++;
-            }
-        }
+        memcpy(panConstraints + 1, anColOps.data(),
+               sizeof(int) * anColOps.size());
     }
 
     pIndex->orderByConsumed = false;
     pIndex->idxNum = 0;
 
+    /* Give SQLite a hint of the benefit of the constraints we handle, */
+    /* so that it can choose the most efficient join order. */
+    const double dfEstimatedRows = bFIDEquality ? 1.0 :
+                    std::max(1.0, OGR2SQLITE_NOMINAL_ROW_COUNT * dfSelectivity);
+    pIndex->estimatedCost = dfEstimatedRows;
+#if SQLITE_VERSION_NUMBER >= 3008002L
+    /* SQLite >= 3.8.2 */
+    if( sqlite3_libversion_number() >= 3008002 )
+        pIndex->estimatedRows = static_cast<sqlite3_int64>(dfEstimatedRows);
+#endif
+
     if (nConstraints != 0)
     {
         pIndex->idxStr = (char *) panConstraints;
@@ -981,6 +1063,9 @@ int OGR2SQLITE_Open(sqlite3_vtab *pVTab, sqlite3_vtab_cursor **ppCursor)
     pCursor->pabyGeomBLOB = nullptr;
     pCursor->nGeomBLOBLen = -1;
 
+    pCursor->pszAttributeFilter = nullptr;
+    pCursor->iSpatialFilterGeomField = -1;
+
     return SQLITE_OK;
 }
 
@@ -999,16 +1084,56 @@ int OGR2SQLITE_Close(sqlite3_vtab_cursor* pCursor)
 #endif
     pMyVTab->nMyRef --;
 
+    if( pMyCursor->iSpatialFilterGeomField >= 0 )
+        pMyCursor->poLayer->SetSpatialFilter(
+                            pMyCursor->iSpatialFilterGeomField, nullptr);
+
     delete pMyCursor->poFeature;
     delete pMyCursor->poDupDataSource;
 
     CPLFree(pMyCursor->pabyGeomBLOB);
+    CPLFree(pMyCursor->pszAttributeFilter);
 
     CPLFree(pCursor);
 
     return SQLITE_OK;
 }
 
+/************************************************************************/
+/*                       OGR2SQLITE_AppendValue()                       */
+/************************************************************************/
+
+static bool OGR2SQLITE_AppendValue(OGR2SQLITE_vtab_cursor* pMyCursor,
+                                   CPLString& osAttributeFilter,
+                                   sqlite3_value* poValue)
+{
+    if (sqlite3_value_type (poValue) == SQLITE_INTEGER)
+    {
+        osAttributeFilter +=
+            CPLSPrintf(CPL_FRMT_GIB, sqlite3_value_int64 (poValue));
+    }
+    else if (sqlite3_value_type (poValue) == SQLITE_FLOAT)
+    { // Insure that only Decimal.Points are used, never local settings such as Decimal.Comma.
+        osAttributeFilter +=
+            CPLSPrintf("%.18g", sqlite3_value_double (poValue));
+    }
+    else if (sqlite3_value_type (poValue) == SQLITE_TEXT)
+    {
+        osAttributeFilter += "'";
+        osAttributeFilter += SQLEscapeLiteral((const char*) sqlite3_value_text (poValue));
+        osAttributeFilter += "'";
+    }
+    else
+    {
+        sqlite3_free(pMyCursor->pVTab->zErrMsg);
+        pMyCursor->pVTab->zErrMsg = sqlite3_mprintf(
+                "Unhandled constraint data type : %d",
+                sqlite3_value_type (poValue));
+        return false;
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                          OGR2SQLITE_Filter()                         */
 /************************************************************************/
@@ -1035,9 +1160,60 @@ int OGR2SQLITE_Filter(sqlite3_vtab_cursor* pCursor,
 
     OGRFeatureDefn* poFDefn = pMyCursor->poLayer->GetLayerDefn();
 
+    /* Set when a constraint can be evaluated to be always false */
+    bool bEmptyResult = false;
+
+    int iSpatialFilterGeomField = -1;
+    OGREnvelope sSpatialFilterEnvelope;
+
     for( int i = 0; i < argc; i++ )
     {
         int nCol = panConstraints[2 * i + 1];
+        const int nOp = panConstraints[2 * i + 2];
+
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+        if( nOp == OGR2SQLITE_INDEX_CONSTRAINT_ST_INTERSECTS )
+        {
+            const int iGeomField = nCol - (poFDefn->GetFieldCount() + 1);
+            if( iGeomField < 0 || iGeomField >= poFDefn->GetGeomFieldCount() )
+                return SQLITE_ERROR;
+
+            /* Only one spatial filter can be set on the layer */
+            if( iSpatialFilterGeomField >= 0 &&
+                iSpatialFilterGeomField != iGeomField )
+                continue;
+
+            OGRGeometry* poGeom = OGR2SQLITE_GetGeom(nullptr, 1, argv + i,
+                                                     nullptr);
+            if( poGeom == nullptr || poGeom->IsEmpty() )
+            {
+                /* ST_Intersects() evaluates to false */
+                delete poGeom;
+                bEmptyResult = true;
+                continue;
+            }
+
+            OGREnvelope sEnvelope;
+            poGeom->getEnvelope(&sEnvelope);
+            delete poGeom;
+
+            if( iSpatialFilterGeomField < 0 )
+            {
+                iSpatialFilterGeomField = iGeomField;
+                sSpatialFilterEnvelope = sEnvelope;
+            }
+            else if( sSpatialFilterEnvelope.Intersects(sEnvelope) )
+            {
+                sSpatialFilterEnvelope.Intersect(sEnvelope);
+            }
+            else
+            {
+                bEmptyResult = true;
+            }
+            continue;
+        }
+#endif
+
         OGRFieldDefn* poFieldDefn = nullptr;
         if( nCol >= 0 )
         {
@@ -1046,7 +1222,7 @@ int OGR2SQLITE_Filter(sqlite3_vtab_cursor* pCursor,
                 return SQLITE_ERROR;
         }
 
-        if( i != 0 )
+        if( !osAttributeFilter.empty() )
             osAttributeFilter += " AND ";
 
         if( poFieldDefn != nullptr )
@@ -1087,8 +1263,37 @@ int OGR2SQLITE_Filter(sqlite3_vtab_cursor* pCursor,
             }
         }
 
+#if SQLITE_VERSION_NUMBER >= 3038000L
+        if( nOp == OGR2SQLITE_INDEX_CONSTRAINT_IN )
+        {
+            /* SQLite >= 3.38: right operand is the list of the values */
+            /* of the IN (...) constraint */
+            osAttributeFilter += " IN (";
+            int nValues = 0;
+            sqlite3_value* poValue = nullptr;
+            for( int rc = sqlite3_vtab_in_first(argv[i], &poValue);
+                 rc == SQLITE_OK && poValue != nullptr;
+                 rc = sqlite3_vtab_in_next(argv[i], &poValue) )
+            {
+                /* NULL never compares equal to anything */
+                if( sqlite3_value_type(poValue) == SQLITE_NULL )
+                    continue;
+                if( nValues > 0 )
+                    osAttributeFilter += ", ";
+                if( !OGR2SQLITE_AppendValue(pMyCursor, osAttributeFilter,
+                                            poValue) )
+                    return SQLITE_ERROR;
+                nValues ++;
+            }
+            osAttributeFilter += ")";
+            if( nValues == 0 )
+                bEmptyResult = true;
+            continue;
+        }
+#endif
+
         bool bExpectRightOperator = true;
-        switch(panConstraints[2 * i + 2])
+        switch(nOp)
         {
             case SQLITE_INDEX_CONSTRAINT_EQ: osAttributeFilter += " = "; break;
             case SQLITE_INDEX_CONSTRAINT_GT: osAttributeFilter += " > "; break;
@@ -1115,37 +1320,15 @@ int OGR2SQLITE_Filter(sqlite3_vtab_cursor* pCursor,
                 sqlite3_free(pMyCursor->pVTab->zErrMsg);
                 pMyCursor->pVTab->zErrMsg = sqlite3_mprintf(
                                         "Unhandled constraint operator : %d",
-                                        panConstraints[2 * i + 2]);
+                                        nOp);
                 return SQLITE_ERROR;
             }
         }
 
         if( bExpectRightOperator )
         {
-            if (sqlite3_value_type (argv[i]) == SQLITE_INTEGER)
-            {
-                osAttributeFilter +=
-                    CPLSPrintf(CPL_FRMT_GIB, sqlite3_value_int64 (argv[i]));
-            }
-            else if (sqlite3_value_type (argv[i]) == SQLITE_FLOAT)
-            { // Insure that only Decimal.Points are used, never local settings such as Decimal.Comma.
-                osAttributeFilter +=
-                    CPLSPrintf("%.18g", sqlite3_value_double (argv[i]));
-            }
-            else if (sqlite3_value_type (argv[i]) == SQLITE_TEXT)
-            {
-                osAttributeFilter += "'";
-                osAttributeFilter += SQLEscapeLiteral((const char*) sqlite3_value_text (argv[i]));
-                osAttributeFilter += "'";
-            }
-            else
-            {
-                sqlite3_free(pMyCursor->pVTab->zErrMsg);
-                pMyCursor->pVTab->zErrMsg = sqlite3_mprintf(
-                        "Unhandled constraint data type : %d",
-                        sqlite3_value_type (argv[i]));
+            if( !OGR2SQLITE_AppendValue(pMyCursor, osAttributeFilter, argv[i]) )
                 return SQLITE_ERROR;
-            }
         }
     }
 
@@ -1154,16 +1337,55 @@ int OGR2SQLITE_Filter(sqlite3_vtab_cursor* pCursor,
              osAttributeFilter.c_str());
 #endif
 
-    if( pMyCursor->poLayer->SetAttributeFilter( !osAttributeFilter.empty() ?
-                            osAttributeFilter.c_str() : nullptr) != OGRERR_NONE )
+    delete pMyCursor->poFeature;
+    pMyCursor->poFeature = nullptr;
+    CPLFree(pMyCursor->pabyGeomBLOB);
+    pMyCursor->pabyGeomBLOB = nullptr;
+    pMyCursor->nGeomBLOBLen = -1;
+
+    pMyCursor->nNextWishedIndex = 0;
+    pMyCursor->nCurFeatureIndex = -1;
+
+    if( bEmptyResult )
     {
-        sqlite3_free(pMyCursor->pVTab->zErrMsg);
-        pMyCursor->pVTab->zErrMsg = sqlite3_mprintf(
-                "Cannot apply attribute filter : %s",
-                osAttributeFilter.c_str());
-        return SQLITE_ERROR;
+        pMyCursor->nFeatureCount = 0;
+        return SQLITE_OK;
+    }
+
+    /* Do not recompile the attribute filter if it has not changed */
+    if( pMyCursor->pszAttributeFilter == nullptr ||
+        osAttributeFilter != pMyCursor->pszAttributeFilter )
+    {
+        CPLFree(pMyCursor->pszAttributeFilter);
+        pMyCursor->pszAttributeFilter = nullptr;
+
+        if( pMyCursor->poLayer->SetAttributeFilter( !osAttributeFilter.empty() ?
+                                osAttributeFilter.c_str() : nullptr) != OGRERR_NONE )
+        {
+            sqlite3_free(pMyCursor->pVTab->zErrMsg);
+            pMyCursor->pVTab->zErrMsg = sqlite3_mprintf(
+                    "Cannot apply attribute filter : %s",
+                    osAttributeFilter.c_str());
+            return SQLITE_ERROR;
+        }
+        pMyCursor->pszAttributeFilter = CPLStrdup(osAttributeFilter);
     }
 
+    if( iSpatialFilterGeomField >= 0 )
+    {
+        pMyCursor->poLayer->SetSpatialFilterRect(iSpatialFilterGeomField,
+                                                 sSpatialFilterEnvelope.MinX,
+                                                 sSpatialFilterEnvelope.MinY,
+                                                 sSpatialFilterEnvelope.MaxX,
+                                                 sSpatialFilterEnvelope.MaxY);
+    }
+    else if( pMyCursor->iSpatialFilterGeomField >= 0 )
+    {
+        pMyCursor->poLayer->SetSpatialFilter(
+                            pMyCursor->iSpatialFilterGeomField, nullptr);
+    }
+    pMyCursor->iSpatialFilterGeomField = iSpatialFilterGeomField;
+
     if( pMyCursor->poLayer->TestCapability(OLCFastFeatureCount) )
         pMyCursor->nFeatureCount = pMyCursor->poLayer->GetFeatureCount();
     else
@@ -1179,9 +1401,6 @@ int OGR2SQLITE_Filter(sqlite3_vtab_cursor* pCursor,
 #endif
     }
 
-    pMyCursor->nNextWishedIndex = 0;
-    pMyCursor->nCurFeatureIndex = -1;
-
     return SQLITE_OK;
 }
 
@@ -1537,23 +1756,64 @@ int OGR2SQLITE_Rename(CPL_UNUSED sqlite3_vtab *pVtab, CPL_UNUSED const char *zNe
     return SQLITE_ERROR;
 }
 
-#if 0
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+
+/************************************************************************/
+/*                     OGR2SQLITE_vtab_ST_Intersects()                  */
+/************************************************************************/
+
+/* Implementation of ST_Intersects() used when its first argument is a */
+/* geometry column of a virtual table. */
+static
+void OGR2SQLITE_vtab_ST_Intersects(sqlite3_context* pContext,
+                                   int argc, sqlite3_value** argv)
+{
+    if( argc != 2 )
+    {
+        sqlite3_result_int(pContext, 0);
+        return;
+    }
+
+    OGRGeometry* poGeom1 = OGR2SQLITE_GetGeom(pContext, 1, argv, nullptr);
+    OGRGeometry* poGeom2 = poGeom1 ?
+        OGR2SQLITE_GetGeom(pContext, 1, argv + 1, nullptr) : nullptr;
+    sqlite3_result_int(pContext,
+                       poGeom2 != nullptr && poGeom1->Intersects(poGeom2));
+    delete poGeom1;
+    delete poGeom2;
+}
+
 /************************************************************************/
 /*                        OGR2SQLITE_FindFunction()                     */
 /************************************************************************/
 
+/* Overloads ST_Intersects(geometry_column, expr) so that SQLite passes it */
+/* as a constraint to OGR2SQLITE_BestIndex(), which translates it as a */
+/* spatial filter on the source layer. */
 static
-int OGR2SQLITE_FindFunction(sqlite3_vtab *pVtab,
+int OGR2SQLITE_FindFunction(sqlite3_vtab * /* pVtab */,
                             int nArg,
                             const char *zName,
                             void (**pxFunc)(sqlite3_context*,int,sqlite3_value**),
                             void **ppArg)
 {
-    CPLDebug("OGR2SQLITE", "FindFunction %s", zName);
+    /* Only SQLite >= 3.25 is aware of SQLITE_INDEX_CONSTRAINT_FUNCTION. */
+    /* And without GEOS, we would not be able to evaluate ST_Intersects() */
+    /* with the same semantics as Spatialite. */
+    if( nArg == 2 &&
+        (EQUAL(zName, "ST_Intersects") || EQUAL(zName, "Intersects")) &&
+        sqlite3_libversion_number() >= 3025000 &&
+        OGRGeometryFactory::haveGEOS() )
+    {
+        *pxFunc = OGR2SQLITE_vtab_ST_Intersects;
+        *ppArg = nullptr;
+        return OGR2SQLITE_INDEX_CONSTRAINT_ST_INTERSECTS;
+    }
 
     return 0;
 }
-#endif
+
+#endif // SQLITE_INDEX_CONSTRAINT_FUNCTION
 
 /************************************************************************/
 /*                     OGR2SQLITE_FeatureFromArgs()                     */
@@ -1748,7 +2008,11 @@ static const struct sqlite3_module sOGR2SQLITEModule =
     nullptr, /* xSync */
     nullptr, /* xCommit */
     nullptr, /* xFindFunctionRollback */
-    nullptr, /* xFindFunction */  // OGR2SQLITE_FindFunction;
+#ifdef SQLITE_INDEX_CONSTRAINT_FUNCTION
+    OGR2SQLITE_FindFunction,
+#else
+    nullptr, /* xFindFunction */
+#endif
     OGR2SQLITE_Rename,
 #if SQLITE_VERSION_NUMBER >= 3007007L /* should be the first version with the below symbols */
     nullptr,  // xSavepoint
@@ -0,0 +1,52 @@
+# SPDX-License-Identifier: MIT
+# Copyright 2023 GDAL contributors
+
+import timeit
+
+from osgeo import gdal, ogr
+
+NFEATURES = 1000 * 1000
+
+src_ds = gdal.GetDriverByName("Memory").Create("", 0, 0, 0, gdal.GDT_Unknown)
+src_lyr = src_ds.CreateLayer("test", geom_type=ogr.wkbPoint)
+for i in range(NFEATURES):
+    f = ogr.Feature(src_lyr.GetLayerDefn())
+    f.SetGeometryDirectly(
+        ogr.CreateGeometryFromWkt(
+            "POINT(%d %d)" % ((i * 7919) % 100000, (i * 104729) % 100000)
+        )
+    )
+    src_lyr.CreateFeature(f)
+
+
+def test(config_options):
+    for key in config_options:
+        gdal.SetConfigOption(key, config_options[key])
+    gdal.VectorTranslate("/vsimem/gpkg_rtree.gpkg", src_ds)
+    for key in config_options:
+        gdal.SetConfigOption(key, None)
+    gdal.Unlink("/vsimem/gpkg_rtree.gpkg")
+
+
+NITERS = 3
+setup = "from __main__ import test"
+print(
+    "packed RTree: %.3f"
+    % timeit.timeit('test({"OGR_GPKG_PACKED_RTREE": "YES"})', setup=setup, number=NITERS)
+)
+print(
+    "background thread RTree: %.3f"
+    % timeit.timeit(
+        'test({"OGR_GPKG_PACKED_RTREE": "NO", "OGR_GPKG_ALLOW_THREADED_RTREE": "YES"})',
+        setup=setup,
+        number=NITERS,
+    )
+)
+print(
+    "RTree built after insertion: %.3f"
+    % timeit.timeit(
+        'test({"OGR_GPKG_PACKED_RTREE": "NO", "OGR_GPKG_ALLOW_THREADED_RTREE": "NO"})',
+        setup=setup,
+        number=NITERS,
+    )
+)
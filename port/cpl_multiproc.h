@@ -229,6 +229,7 @@ class CPL_DLL CPLLockHolder
 #define CTLS_PROJCONTEXTHOLDER          18         /* ogr_proj_p.cpp */
 #define CTLS_GDALDEFAULTOVR_ANTIREC     19         /* gdaldefaultoverviews.cpp */
 #define CTLS_HTTPFETCHCALLBACK          20         /* cpl_http.cpp */
+#define CTLS_GEOSCONTEXTHOLDER          21         /* ogrgeometry.cpp */
 
 #define CTLS_MAX                        32
 
@@ -806,6 +806,7 @@ int VSIStatExL( const char * pszFilename, VSIStatBufL *psStatBuf, int nFlags )
  * The following are supported:
  * <ul>
  * <li>HEADERS: to get HTTP headers for network-like filesystems (/vsicurl/, /vsis3/, /vsgis/, etc)</li>
+ * <li>DISK_CACHE_STATS: for network-like filesystems (/vsicurl/, /vsis3/, etc), process-wide statistics of the persistent disk cache enabled by CPL_VSIL_CURL_DISK_CACHE_DIR (GDAL >= 3.7)</li>
  * <li>TAGS:
  *    <ul>
  *      <li>/vsis3/: to get S3 Object tagging information</li>
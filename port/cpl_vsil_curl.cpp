@@ -35,12 +35,19 @@
 #include <set>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
 
 #include "cpl_aws.h"
 #include "cpl_json.h"
 #include "cpl_json_header.h"
 #include "cpl_minixml.h"
 #include "cpl_multiproc.h"
+#include "cpl_sha256.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
 #include "cpl_vsi.h"
@@ -3095,6 +3102,405 @@ CURLM* VSICurlFilesystemHandlerBase::GetCurlMultiHandleFor(const CPLString& /*os
     return conn.hCurlMultiHandle;
 }
 
+/************************************************************************/
+/*                         VSICurlDiskCache                             */
+/************************************************************************/
+
+// Optional persistent cache of downloaded regions, enabled by setting
+// CPL_VSIL_CURL_DISK_CACHE_DIR. Each region is stored in its own file,
+// named after the SHA256 of a key made of the URL (without its credential
+// query parameters), the validator of the remote file (ETag, or
+// Last-Modified), its size, the chunk size and the offset of the region.
+// Only that hash is stored. Files are written under a temporary name and
+// renamed, so that processes sharing the same directory never see partial
+// content.
+
+namespace {
+
+constexpr const char szDISK_CACHE_MAGIC[] = "GDAL_VSICURL_DISK_CACHE_1\n";
+constexpr GIntBig knDEFAULT_DISK_CACHE_SIZE =
+    static_cast<GIntBig>(1024) * 1024 * 1024;
+
+struct VSICurlDiskCacheStats
+{
+    std::mutex oMutex{};
+    GUIntBig nHits = 0;
+    GUIntBig nMisses = 0;
+    GUIntBig nWrites = 0;
+    GUIntBig nBytesWritten = 0;
+    GUIntBig nEvictions = 0;
+    // Bytes written since the last trimming of the cache directory
+    GUIntBig nBytesWrittenSinceTrim = 0;
+    bool bTrimDone = false;
+};
+
+VSICurlDiskCacheStats& GetDiskCacheStats()
+{
+    static VSICurlDiskCacheStats goStats;
+    return goStats;
+}
+
+std::mutex goDiskCacheTrimMutex;
+
+/************************************************************************/
+/*                       VSICurlDiskCacheGetDir()                       */
+/************************************************************************/
+
+std::string VSICurlDiskCacheGetDir()
+{
+    return CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_DIR", "");
+}
+
+/************************************************************************/
+/*                     VSICurlDiskCacheGetMaxSize()                     */
+/************************************************************************/
+
+GIntBig VSICurlDiskCacheGetMaxSize()
+{
+    const char* pszSize =
+        CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_SIZE", nullptr);
+    if( pszSize == nullptr )
+        return knDEFAULT_DISK_CACHE_SIZE;
+    const GIntBig nSize = CPLAtoGIntBig(pszSize);
+    return nSize > 0 ? nSize : knDEFAULT_DISK_CACHE_SIZE;
+}
+
+/************************************************************************/
+/*              VSICurlDiskCacheIsCredentialQueryParameter()            */
+/************************************************************************/
+
+bool VSICurlDiskCacheIsCredentialQueryParameter( const std::string& osName )
+{
+    // Azure SAS, AWS and Google Cloud signed URLs, CloudFront signed URLs,
+    // and common bearer token parameters.
+    static const char* const apszNames[] = {
+        "sv", "ss", "srt", "sp", "se", "st", "spr", "sig", "sr", "si", "sip",
+        "skoid", "sktid", "skt", "ske", "sks", "skv", "sdd", "saoid", "suoid",
+        "scid", "ses",
+        "AWSAccessKeyId", "GoogleAccessId", "Signature", "Expires", "Policy",
+        "Key-Pair-Id",
+        "access_token", "token", "api_key", "apikey" };
+    for( const char* pszName: apszNames )
+    {
+        if( EQUAL(osName.c_str(), pszName) )
+            return true;
+    }
+    return STARTS_WITH_CI(osName.c_str(), "X-Amz-") ||
+           STARTS_WITH_CI(osName.c_str(), "X-Goog-");
+}
+
+/************************************************************************/
+/*              VSICurlDiskCacheGetURLWithoutCredentials()              */
+/************************************************************************/
+
+// Removes the query parameters that may carry credentials, so that they are
+// not hashed into the key, and do not make it vary between processes.
+std::string VSICurlDiskCacheGetURLWithoutCredentials( const char* pszURL )
+{
+    const char* pszQuery = strchr(pszURL, '?');
+    if( pszQuery == nullptr )
+        return pszURL;
+
+    std::string osURL(pszURL, pszQuery - pszURL);
+    const CPLStringList aosParams(CSLTokenizeString2(pszQuery + 1, "&", 0));
+    char chSep = '?';
+    for( int i = 0; i < aosParams.size(); ++i )
+    {
+        const char* pszParam = aosParams[i];
+        const char* pszEqual = strchr(pszParam, '=');
+        const std::string osName = pszEqual ?
+            std::string(pszParam, pszEqual - pszParam) : std::string(pszParam);
+        if( VSICurlDiskCacheIsCredentialQueryParameter(osName) )
+            continue;
+        osURL += chSep;
+        osURL += pszParam;
+        chSep = '&';
+    }
+    return osURL;
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCacheGetKey()                       */
+/************************************************************************/
+
+// Returns an empty string if the remote file has no known validator, in
+// which case its content cannot be safely reused by another process.
+std::string VSICurlDiskCacheGetKey( const char* pszURL,
+                                    vsi_l_offset nFileOffsetStart )
+{
+    FileProp oFileProp;
+    if( !VSICURLGetCachedFileProp(pszURL, oFileProp) ||
+        oFileProp.eExists != EXIST_YES ||
+        !oFileProp.bHasComputedFileSize )
+    {
+        return std::string();
+    }
+
+    std::string osKey(VSICurlDiskCacheGetURLWithoutCredentials(pszURL));
+    osKey += '\n';
+    if( !oFileProp.ETag.empty() )
+    {
+        osKey += "ETag: ";
+        osKey += oFileProp.ETag;
+    }
+    else if( oFileProp.mTime > 0 )
+    {
+        osKey += CPLSPrintf("Last-Modified: " CPL_FRMT_GIB,
+                            static_cast<GIntBig>(oFileProp.mTime));
+    }
+    else
+    {
+        return std::string();
+    }
+    osKey += CPLSPrintf("\n" CPL_FRMT_GUIB "\n%d\n" CPL_FRMT_GUIB,
+                        static_cast<GUIntBig>(oFileProp.fileSize),
+                        VSICURLGetDownloadChunkSize(),
+                        static_cast<GUIntBig>(nFileOffsetStart));
+    return osKey;
+}
+
+/************************************************************************/
+/*                      VSICurlDiskCacheGetPath()                       */
+/************************************************************************/
+
+std::string VSICurlDiskCacheGetPath( const std::string& osDir,
+                                     const std::string& osKey,
+                                     std::string* posSubDir = nullptr )
+{
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256(osKey.data(), osKey.size(), abyHash);
+    char* pszHex = CPLBinaryToHex(CPL_SHA256_HASH_SIZE, abyHash);
+    const std::string osHex(pszHex);
+    CPLFree(pszHex);
+
+    const std::string osSubDir(
+        CPLFormFilename(osDir.c_str(), osHex.substr(0, 2).c_str(), nullptr));
+    if( posSubDir )
+        *posSubDir = osSubDir;
+    return CPLFormFilename(osSubDir.c_str(), osHex.substr(2).c_str(),
+                           nullptr);
+}
+
+/************************************************************************/
+/*                        VSICurlDiskCacheRead()                        */
+/************************************************************************/
+
+std::shared_ptr<std::string> VSICurlDiskCacheRead( const char* pszURL,
+                                                   vsi_l_offset nFileOffsetStart )
+{
+    const std::string osDir(VSICurlDiskCacheGetDir());
+    if( osDir.empty() )
+        return nullptr;
+    const std::string osKey(VSICurlDiskCacheGetKey(pszURL, nFileOffsetStart));
+    if( osKey.empty() )
+        return nullptr;
+
+    const std::string osPath(VSICurlDiskCacheGetPath(osDir, osKey));
+    std::shared_ptr<std::string> out;
+    GByte* pabyData = nullptr;
+    vsi_l_offset nDataSize = 0;
+    const size_t nHeaderSize = strlen(szDISK_CACHE_MAGIC);
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    const bool bRead = VSIIngestFile(
+        nullptr, osPath.c_str(), &pabyData, &nDataSize,
+        static_cast<GIntBig>(nHeaderSize) + VSICURLGetDownloadChunkSize()) != 0;
+    CPLPopErrorHandler();
+    CPLErrorReset();
+    if( bRead && nDataSize >= nHeaderSize &&
+        memcmp(pabyData, szDISK_CACHE_MAGIC, nHeaderSize) == 0 )
+    {
+        out = std::make_shared<std::string>(
+            reinterpret_cast<const char*>(pabyData) + nHeaderSize,
+            static_cast<size_t>(nDataSize - nHeaderSize));
+    }
+    CPLFree(pabyData);
+
+    auto& oStats = GetDiskCacheStats();
+    std::lock_guard<std::mutex> oLock(oStats.oMutex);
+    if( out )
+        oStats.nHits++;
+    else
+        oStats.nMisses++;
+    return out;
+}
+
+/************************************************************************/
+/*                        VSICurlDiskCacheTrim()                        */
+/************************************************************************/
+
+// Removes the oldest files of the cache directory until its total size is
+// below the configured limit. Several processes may trim concurrently: at
+// worst a bit more than needed is evicted, which is harmless.
+void VSICurlDiskCacheTrim( const std::string& osDir, GIntBig nMaxSize )
+{
+    struct CachedFile
+    {
+        std::string osPath;
+        time_t nMTime;
+        GIntBig nSize;
+    };
+    std::vector<CachedFile> aoFiles;
+    GIntBig nTotalSize = 0;
+    const time_t nNow = time(nullptr);
+
+    const CPLStringList aosSubDirs(VSIReadDir(osDir.c_str()));
+    for( int i = 0; i < aosSubDirs.size(); ++i )
+    {
+        const char* pszSubDir = aosSubDirs[i];
+        if( strlen(pszSubDir) != 2 )
+            continue;
+        const std::string osSubDir(
+            CPLFormFilename(osDir.c_str(), pszSubDir, nullptr));
+        const CPLStringList aosFiles(VSIReadDir(osSubDir.c_str()));
+        for( int j = 0; j < aosFiles.size(); ++j )
+        {
+            const char* pszFile = aosFiles[j];
+            if( pszFile[0] == '.' )
+                continue;
+            const std::string osPath(
+                CPLFormFilename(osSubDir.c_str(), pszFile, nullptr));
+            VSIStatBufL sStat;
+            if( VSIStatL(osPath.c_str(), &sStat) != 0 ||
+                !VSI_ISREG(sStat.st_mode) )
+            {
+                continue;
+            }
+            // Leftover of an interrupted write
+            if( EQUAL(CPLGetExtension(pszFile), "tmp") )
+            {
+                if( nNow - sStat.st_mtime > 3600 )
+                    VSIUnlink(osPath.c_str());
+                continue;
+            }
+            nTotalSize += static_cast<GIntBig>(sStat.st_size);
+            aoFiles.push_back(CachedFile{osPath, sStat.st_mtime,
+                                         static_cast<GIntBig>(sStat.st_size)});
+        }
+    }
+    if( nTotalSize <= nMaxSize )
+        return;
+
+    std::sort(aoFiles.begin(), aoFiles.end(),
+              [](const CachedFile& a, const CachedFile& b)
+              { return a.nMTime < b.nMTime; });
+    GUIntBig nEvictions = 0;
+    for( const auto& oFile: aoFiles )
+    {
+        if( nTotalSize <= nMaxSize )
+            break;
+        // Another process might have removed it already
+        if( VSIUnlink(oFile.osPath.c_str()) == 0 )
+            nEvictions++;
+        nTotalSize -= oFile.nSize;
+    }
+    CPLDebug("VSICURL", "Disk cache %s: " CPL_FRMT_GUIB " file(s) evicted",
+             osDir.c_str(), nEvictions);
+
+    auto& oStats = GetDiskCacheStats();
+    std::lock_guard<std::mutex> oLock(oStats.oMutex);
+    oStats.nEvictions += nEvictions;
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCacheWrite()                        */
+/************************************************************************/
+
+void VSICurlDiskCacheWrite( const char* pszURL,
+                            vsi_l_offset nFileOffsetStart,
+                            size_t nSize,
+                            const char *pData )
+{
+    const std::string osDir(VSICurlDiskCacheGetDir());
+    if( osDir.empty() )
+        return;
+    const std::string osKey(VSICurlDiskCacheGetKey(pszURL, nFileOffsetStart));
+    if( osKey.empty() )
+        return;
+
+    std::string osSubDir;
+    const std::string osPath(VSICurlDiskCacheGetPath(osDir, osKey, &osSubDir));
+    const std::string osTmpPath(osPath + CPLSPrintf(".%d_" CPL_FRMT_GIB ".tmp",
+                                                    CPLGetCurrentProcessID(),
+                                                    CPLGetPID()));
+
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    VSIMkdir(osDir.c_str(), 0700);
+    VSIMkdir(osSubDir.c_str(), 0700);
+    bool bOK = false;
+    VSILFILE* fp = VSIFOpenL(osTmpPath.c_str(), "wb");
+    if( fp )
+    {
+#ifndef _WIN32
+        // Cached content may be private: restrict it to the current user
+        chmod(osTmpPath.c_str(), S_IRUSR | S_IWUSR);
+#endif
+        bOK = VSIFWriteL(szDISK_CACHE_MAGIC, strlen(szDISK_CACHE_MAGIC), 1,
+                         fp) == 1 &&
+              (nSize == 0 || VSIFWriteL(pData, nSize, 1, fp) == 1);
+        bOK = VSIFCloseL(fp) == 0 && bOK;
+        bOK = bOK && VSIRename(osTmpPath.c_str(), osPath.c_str()) == 0;
+        if( !bOK )
+            VSIUnlink(osTmpPath.c_str());
+    }
+    CPLPopErrorHandler();
+    CPLErrorReset();
+    if( !bOK )
+        return;
+
+    const GIntBig nMaxSize = VSICurlDiskCacheGetMaxSize();
+    bool bTrim = false;
+    {
+        auto& oStats = GetDiskCacheStats();
+        std::lock_guard<std::mutex> oLock(oStats.oMutex);
+        oStats.nWrites++;
+        oStats.nBytesWritten += nSize;
+        oStats.nBytesWrittenSinceTrim += nSize;
+        // Scan the directory on the first write of the process, and then
+        // each time a tenth of the maximum size has been written.
+        if( !oStats.bTrimDone ||
+            oStats.nBytesWrittenSinceTrim >
+                static_cast<GUIntBig>(nMaxSize / 10) )
+        {
+            oStats.bTrimDone = true;
+            oStats.nBytesWrittenSinceTrim = 0;
+            bTrim = true;
+        }
+    }
+    if( bTrim )
+    {
+        std::unique_lock<std::mutex> oLock(goDiskCacheTrimMutex,
+                                           std::try_to_lock);
+        if( oLock.owns_lock() )
+        {
+            CPLPushErrorHandler(CPLQuietErrorHandler);
+            VSICurlDiskCacheTrim(osDir, nMaxSize);
+            CPLPopErrorHandler();
+            CPLErrorReset();
+        }
+    }
+}
+
+/************************************************************************/
+/*                     VSICurlDiskCacheGetStats()                       */
+/************************************************************************/
+
+char** VSICurlDiskCacheGetStats()
+{
+    auto& oStats = GetDiskCacheStats();
+    std::lock_guard<std::mutex> oLock(oStats.oMutex);
+    CPLStringList aosStats;
+    aosStats.SetNameValue("HITS", CPLSPrintf(CPL_FRMT_GUIB, oStats.nHits));
+    aosStats.SetNameValue("MISSES", CPLSPrintf(CPL_FRMT_GUIB, oStats.nMisses));
+    aosStats.SetNameValue("WRITES", CPLSPrintf(CPL_FRMT_GUIB, oStats.nWrites));
+    aosStats.SetNameValue("BYTES_WRITTEN",
+                          CPLSPrintf(CPL_FRMT_GUIB, oStats.nBytesWritten));
+    aosStats.SetNameValue("EVICTIONS",
+                          CPLSPrintf(CPL_FRMT_GUIB, oStats.nEvictions));
+    return aosStats.StealList();
+}
+
+} // namespace
+
 /************************************************************************/
 /*                          GetRegionCache()                            */
 /************************************************************************/
@@ -3117,20 +3523,28 @@ std::shared_ptr<std::string>
 VSICurlFilesystemHandlerBase::GetRegion( const char* pszURL,
                                      vsi_l_offset nFileOffsetStart )
 {
-    CPLMutexHolder oHolder( &hMutex );
-
     const int knDOWNLOAD_CHUNK_SIZE = VSICURLGetDownloadChunkSize();
     nFileOffsetStart =
         (nFileOffsetStart / knDOWNLOAD_CHUNK_SIZE) * knDOWNLOAD_CHUNK_SIZE;
 
     std::shared_ptr<std::string> out;
-    if( GetRegionCache()->tryGet(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out) )
     {
-        return out;
+        CPLMutexHolder oHolder( &hMutex );
+        if( GetRegionCache()->tryGet(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out) )
+        {
+            return out;
+        }
     }
 
-    return nullptr;
+    out = VSICurlDiskCacheRead(pszURL, nFileOffsetStart);
+    if( out )
+    {
+        CPLMutexHolder oHolder( &hMutex );
+        GetRegionCache()->insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart), out);
+    }
+    return out;
 }
 
 /************************************************************************/
@@ -3142,13 +3556,17 @@ void VSICurlFilesystemHandlerBase::AddRegion( const char* pszURL,
                                           size_t nSize,
                                           const char *pData )
 {
-    CPLMutexHolder oHolder( &hMutex );
+    {
+        CPLMutexHolder oHolder( &hMutex );
+
+        std::shared_ptr<std::string> value(new std::string());
+        value->assign(pData, nSize);
+        GetRegionCache()->insert(
+            FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
+            value);
+    }
 
-    std::shared_ptr<std::string> value(new std::string());
-    value->assign(pData, nSize);
-    GetRegionCache()->insert(
-        FilenameOffsetPair(std::string(pszURL), nFileOffsetStart),
-        value);
+    VSICurlDiskCacheWrite(pszURL, nFileOffsetStart, nSize, pData);
 }
 
 /************************************************************************/
@@ -3437,6 +3855,12 @@ const char* VSICurlFilesystemHandlerBase::GetActualURL(const char* pszFilename)
     "  <Option name='CPL_VSIL_CURL_CACHE_SIZE' type='integer' " \
         "description='Size in bytes of the global /vsicurl/ cache' " \
         "default='16384000'/>" \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_DIR' type='string' " \
+        "description='Directory where downloaded blocks are persistently " \
+        "cached, and shared between processes'/>" \
+    "  <Option name='CPL_VSIL_CURL_DISK_CACHE_SIZE' type='integer' " \
+        "description='Maximum size in bytes of the persistent disk cache' " \
+        "default='1073741824'/>" \
     "  <Option name='CPL_VSIL_CURL_IGNORE_GLACIER_STORAGE' type='boolean' " \
         "description='Whether to skip files with Glacier storage class in " \
         "directory listing.' default='YES'/>"
@@ -4783,6 +5207,8 @@ char** VSICurlFilesystemHandlerBase::GetFileMetadata( const char* pszFilename,
                                                   const char* pszDomain,
                                                   CSLConstList )
 {
+    if( pszDomain != nullptr && EQUAL(pszDomain, "DISK_CACHE_STATS") )
+        return VSICurlDiskCacheGetStats();
     if( pszDomain == nullptr || !EQUAL(pszDomain, "HEADERS") )
         return nullptr;
     std::unique_ptr<VSICurlHandle> poHandle(CreateFileHandle(pszFilename));